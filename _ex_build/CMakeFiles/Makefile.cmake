@@ -0,0 +1,99 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/share/cmake/nlohmann_json/nlohmann_jsonConfig.cmake"
+  "/root/miniconda/share/cmake/nlohmann_json/nlohmann_jsonConfigVersion.cmake"
+  "/root/miniconda/share/cmake/nlohmann_json/nlohmann_jsonTargets.cmake"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/examples/dump-decls/CMakeLists.txt"
+  "/root/repo/examples/export-columns/CMakeLists.txt"
+  "/root/repo/examples/generate-ifc/CMakeLists.txt"
+  "/root/repo/examples/ifc-codegen/CMakeLists.txt"
+  "/root/repo/examples/ifc-deps/CMakeLists.txt"
+  "/root/repo/examples/ifc-server/CMakeLists.txt"
+  "/root/repo/examples/ifc-warm/CMakeLists.txt"
+  "/root/repo/lib/blob-reader/CMakeLists.txt"
+  "/root/repo/lib/core/CMakeLists.txt"
+  "/root/repo/lib/msvc/CMakeLists.txt"
+  "/root/repo/lib/reflifc/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/Boost-1.74.0/BoostConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/BoostDetectToolset-1.74.0.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_headers-1.74.0/boost_headers-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_iostreams-1.74.0/boost_iostreams-config-version.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_iostreams-1.74.0/boost_iostreams-config.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_iostreams-1.74.0/libboost_iostreams-variant-shared.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/boost_iostreams-1.74.0/libboost_iostreams-variant-static.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindBoost.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/core/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/reflifc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/msvc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "lib/blob-reader/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/dump-decls/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/ifc-codegen/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/export-columns/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/generate-ifc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/ifc-deps/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/ifc-warm/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/ifc-server/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "lib/core/CMakeFiles/ifc-core.dir/DependInfo.cmake"
+  "lib/reflifc/CMakeFiles/reflifc.dir/DependInfo.cmake"
+  "lib/msvc/CMakeFiles/ifc-msvc.dir/DependInfo.cmake"
+  "lib/blob-reader/CMakeFiles/ifc-blob-reader.dir/DependInfo.cmake"
+  "examples/dump-decls/CMakeFiles/dump-decls.dir/DependInfo.cmake"
+  "examples/ifc-codegen/CMakeFiles/ifc-codegen.dir/DependInfo.cmake"
+  "examples/export-columns/CMakeFiles/export-columns.dir/DependInfo.cmake"
+  "examples/generate-ifc/CMakeFiles/generate-ifc.dir/DependInfo.cmake"
+  "examples/ifc-deps/CMakeFiles/ifc-deps.dir/DependInfo.cmake"
+  "examples/ifc-warm/CMakeFiles/ifc-warm.dir/DependInfo.cmake"
+  "examples/ifc-server/CMakeFiles/ifc-server.dir/DependInfo.cmake"
+  )
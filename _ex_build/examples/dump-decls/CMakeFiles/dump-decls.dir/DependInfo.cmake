@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/examples/dump-decls/Presenter.cpp" "examples/dump-decls/CMakeFiles/dump-decls.dir/Presenter.cpp.o" "gcc" "examples/dump-decls/CMakeFiles/dump-decls.dir/Presenter.cpp.o.d"
+  "/root/repo/examples/dump-decls/main.cpp" "examples/dump-decls/CMakeFiles/dump-decls.dir/main.cpp.o" "gcc" "examples/dump-decls/CMakeFiles/dump-decls.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_ex_build/lib/msvc/CMakeFiles/ifc-msvc.dir/DependInfo.cmake"
+  "/root/repo/_ex_build/lib/blob-reader/CMakeFiles/ifc-blob-reader.dir/DependInfo.cmake"
+  "/root/repo/_ex_build/lib/reflifc/CMakeFiles/reflifc.dir/DependInfo.cmake"
+  "/root/repo/_ex_build/lib/core/CMakeFiles/ifc-core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
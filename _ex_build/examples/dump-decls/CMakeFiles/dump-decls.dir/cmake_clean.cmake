@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dump-decls.dir/Presenter.cpp.o"
+  "CMakeFiles/dump-decls.dir/Presenter.cpp.o.d"
+  "CMakeFiles/dump-decls.dir/main.cpp.o"
+  "CMakeFiles/dump-decls.dir/main.cpp.o.d"
+  "dump-decls"
+  "dump-decls.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dump-decls.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/export-columns.dir/ColumnExporter.cpp.o"
+  "CMakeFiles/export-columns.dir/ColumnExporter.cpp.o.d"
+  "CMakeFiles/export-columns.dir/main.cpp.o"
+  "CMakeFiles/export-columns.dir/main.cpp.o.d"
+  "export-columns"
+  "export-columns.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/export-columns.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
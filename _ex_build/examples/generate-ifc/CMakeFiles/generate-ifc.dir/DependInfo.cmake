@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/examples/generate-ifc/IfcGenerator.cpp" "examples/generate-ifc/CMakeFiles/generate-ifc.dir/IfcGenerator.cpp.o" "gcc" "examples/generate-ifc/CMakeFiles/generate-ifc.dir/IfcGenerator.cpp.o.d"
+  "/root/repo/examples/generate-ifc/main.cpp" "examples/generate-ifc/CMakeFiles/generate-ifc.dir/main.cpp.o" "gcc" "examples/generate-ifc/CMakeFiles/generate-ifc.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_ex_build/lib/core/CMakeFiles/ifc-core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/generate-ifc.dir/IfcGenerator.cpp.o"
+  "CMakeFiles/generate-ifc.dir/IfcGenerator.cpp.o.d"
+  "CMakeFiles/generate-ifc.dir/main.cpp.o"
+  "CMakeFiles/generate-ifc.dir/main.cpp.o.d"
+  "generate-ifc"
+  "generate-ifc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/generate-ifc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
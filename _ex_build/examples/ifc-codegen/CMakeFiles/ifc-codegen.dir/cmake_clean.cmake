@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ifc-codegen.dir/main.cpp.o"
+  "CMakeFiles/ifc-codegen.dir/main.cpp.o.d"
+  "ifc-codegen"
+  "ifc-codegen.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ifc-codegen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
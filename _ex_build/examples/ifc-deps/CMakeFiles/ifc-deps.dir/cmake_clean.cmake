@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ifc-deps.dir/main.cpp.o"
+  "CMakeFiles/ifc-deps.dir/main.cpp.o.d"
+  "ifc-deps"
+  "ifc-deps.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ifc-deps.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ifc-server.dir/Numa.cpp.o"
+  "CMakeFiles/ifc-server.dir/Numa.cpp.o.d"
+  "CMakeFiles/ifc-server.dir/QueryServer.cpp.o"
+  "CMakeFiles/ifc-server.dir/QueryServer.cpp.o.d"
+  "CMakeFiles/ifc-server.dir/main.cpp.o"
+  "CMakeFiles/ifc-server.dir/main.cpp.o.d"
+  "ifc-server"
+  "ifc-server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ifc-server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
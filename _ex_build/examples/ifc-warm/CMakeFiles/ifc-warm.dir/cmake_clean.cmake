@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ifc-warm.dir/main.cpp.o"
+  "CMakeFiles/ifc-warm.dir/main.cpp.o.d"
+  "ifc-warm"
+  "ifc-warm.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ifc-warm.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ifc-blob-reader.dir/src/blob_reader.cpp.o"
+  "CMakeFiles/ifc-blob-reader.dir/src/blob_reader.cpp.o.d"
+  "libifc-blob-reader.a"
+  "libifc-blob-reader.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ifc-blob-reader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,40 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/core/src/AllocationCounter.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/AllocationCounter.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/AllocationCounter.cpp.o.d"
+  "/root/repo/lib/core/src/Bundle.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/Bundle.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/Bundle.cpp.o.d"
+  "/root/repo/lib/core/src/CApi.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/CApi.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/CApi.cpp.o.d"
+  "/root/repo/lib/core/src/CApiFields.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/CApiFields.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/CApiFields.cpp.o.d"
+  "/root/repo/lib/core/src/Cancellation.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/Cancellation.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/Cancellation.cpp.o.d"
+  "/root/repo/lib/core/src/Environment.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/Environment.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/Environment.cpp.o.d"
+  "/root/repo/lib/core/src/File.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/File.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/File.cpp.o.d"
+  "/root/repo/lib/core/src/FileDiff.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/FileDiff.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/FileDiff.cpp.o.d"
+  "/root/repo/lib/core/src/FileWatcher.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/FileWatcher.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/FileWatcher.cpp.o.d"
+  "/root/repo/lib/core/src/FileWriter.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/FileWriter.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/FileWriter.cpp.o.d"
+  "/root/repo/lib/core/src/MemoryUsage.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/MemoryUsage.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/MemoryUsage.cpp.o.d"
+  "/root/repo/lib/core/src/ModuleGraph.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/ModuleGraph.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/ModuleGraph.cpp.o.d"
+  "/root/repo/lib/core/src/ModuleGraphSnapshot.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/ModuleGraphSnapshot.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/ModuleGraphSnapshot.cpp.o.d"
+  "/root/repo/lib/core/src/Parallel.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/Parallel.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/Parallel.cpp.o.d"
+  "/root/repo/lib/core/src/PostingLists.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/PostingLists.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/PostingLists.cpp.o.d"
+  "/root/repo/lib/core/src/QueryCache.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/QueryCache.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/QueryCache.cpp.o.d"
+  "/root/repo/lib/core/src/Sha256.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/Sha256.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/Sha256.cpp.o.d"
+  "/root/repo/lib/core/src/SortFilter.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/SortFilter.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/SortFilter.cpp.o.d"
+  "/root/repo/lib/core/src/SymbolTable.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/SymbolTable.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/SymbolTable.cpp.o.d"
+  "/root/repo/lib/core/src/TextSearch.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/TextSearch.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/TextSearch.cpp.o.d"
+  "/root/repo/lib/core/src/Trace.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/Trace.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/Trace.cpp.o.d"
+  "/root/repo/lib/core/src/TrigramIndex.cpp" "lib/core/CMakeFiles/ifc-core.dir/src/TrigramIndex.cpp.o" "gcc" "lib/core/CMakeFiles/ifc-core.dir/src/TrigramIndex.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,53 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ifc-core.dir/src/AllocationCounter.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/AllocationCounter.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/Bundle.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/Bundle.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/CApi.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/CApi.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/CApiFields.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/CApiFields.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/Cancellation.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/Cancellation.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/Environment.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/Environment.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/File.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/File.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/FileDiff.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/FileDiff.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/FileWatcher.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/FileWatcher.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/FileWriter.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/FileWriter.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/MemoryUsage.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/MemoryUsage.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/ModuleGraph.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/ModuleGraph.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/ModuleGraphSnapshot.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/ModuleGraphSnapshot.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/Parallel.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/Parallel.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/PostingLists.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/PostingLists.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/QueryCache.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/QueryCache.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/Sha256.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/Sha256.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/SortFilter.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/SortFilter.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/SymbolTable.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/SymbolTable.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/TextSearch.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/TextSearch.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/Trace.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/Trace.cpp.o.d"
+  "CMakeFiles/ifc-core.dir/src/TrigramIndex.cpp.o"
+  "CMakeFiles/ifc-core.dir/src/TrigramIndex.cpp.o.d"
+  "libifc-core.a"
+  "libifc-core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ifc-core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,122 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/reflifc/src/AbiDiff.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/AbiDiff.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/AbiDiff.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Attribute.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Attribute.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Attribute.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Chart.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Chart.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Chart.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Declaration.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Declaration.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Declaration.cpp.o.d"
+  "/root/repo/lib/reflifc/src/DeclarationQuery.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/DeclarationQuery.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/DeclarationQuery.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Expression.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Expression.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Expression.cpp.o.d"
+  "/root/repo/lib/reflifc/src/JsonWriter.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/JsonWriter.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/JsonWriter.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Layout.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Layout.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Layout.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Macro.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Macro.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Macro.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Mangler.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Mangler.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Mangler.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Name.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Name.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Name.cpp.o.d"
+  "/root/repo/lib/reflifc/src/NameArena.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/NameArena.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/NameArena.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Outline.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Outline.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Outline.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Query.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Query.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Query.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Sentence.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Sentence.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Sentence.cpp.o.d"
+  "/root/repo/lib/reflifc/src/SideTable.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/SideTable.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/SideTable.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Signatures.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Signatures.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Signatures.cpp.o.d"
+  "/root/repo/lib/reflifc/src/StringLiteral.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/StringLiteral.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/StringLiteral.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Subset.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Subset.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Subset.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Syntax.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Syntax.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Syntax.cpp.o.d"
+  "/root/repo/lib/reflifc/src/SyntaxWalker.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/SyntaxWalker.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/SyntaxWalker.cpp.o.d"
+  "/root/repo/lib/reflifc/src/TemplateId.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/TemplateId.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/TemplateId.cpp.o.d"
+  "/root/repo/lib/reflifc/src/TupleView.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/TupleView.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/TupleView.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Type.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Type.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Type.cpp.o.d"
+  "/root/repo/lib/reflifc/src/TypeRenderer.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/TypeRenderer.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/TypeRenderer.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Walk.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Walk.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Walk.cpp.o.d"
+  "/root/repo/lib/reflifc/src/Word.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/Word.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/Word.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/AliasDeclaration.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/AliasDeclaration.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/AliasDeclaration.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/ClassOrStruct.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/ClassOrStruct.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/ClassOrStruct.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/Concept.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Concept.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Concept.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/DeclarationReference.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/DeclarationReference.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/DeclarationReference.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/Enumeration.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Enumeration.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Enumeration.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/Enumerator.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Enumerator.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Enumerator.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/Field.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Field.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Field.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/Function.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Function.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Function.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/Parameter.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Parameter.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Parameter.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/Scope.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Scope.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Scope.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/ScopeDeclaration.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/ScopeDeclaration.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/ScopeDeclaration.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/Specialization.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Specialization.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Specialization.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/TemplateDeclaration.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/TemplateDeclaration.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/TemplateDeclaration.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/UsingDeclaration.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/UsingDeclaration.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/UsingDeclaration.cpp.o.d"
+  "/root/repo/lib/reflifc/src/decl/Variable.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Variable.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/decl/Variable.cpp.o.d"
+  "/root/repo/lib/reflifc/src/expr/Alignof.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Alignof.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Alignof.cpp.o.d"
+  "/root/repo/lib/reflifc/src/expr/Call.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Call.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Call.cpp.o.d"
+  "/root/repo/lib/reflifc/src/expr/Dyad.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Dyad.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Dyad.cpp.o.d"
+  "/root/repo/lib/reflifc/src/expr/Monad.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Monad.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Monad.cpp.o.d"
+  "/root/repo/lib/reflifc/src/expr/Path.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Path.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Path.cpp.o.d"
+  "/root/repo/lib/reflifc/src/expr/ProductValueType.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/ProductValueType.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/ProductValueType.cpp.o.d"
+  "/root/repo/lib/reflifc/src/expr/Read.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Read.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Read.cpp.o.d"
+  "/root/repo/lib/reflifc/src/expr/Sizeof.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Sizeof.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/Sizeof.cpp.o.d"
+  "/root/repo/lib/reflifc/src/expr/UnqualifiedId.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/UnqualifiedId.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/expr/UnqualifiedId.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/AliasResolution.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/AliasResolution.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/AliasResolution.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/AttributeIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/AttributeIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/AttributeIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/BaseLinearization.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/BaseLinearization.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/BaseLinearization.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/ChartParameterIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ChartParameterIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ChartParameterIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/ClassHierarchy.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ClassHierarchy.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ClassHierarchy.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/CompletionIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/CompletionIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/CompletionIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/ConceptChecker.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ConceptChecker.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ConceptChecker.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/ConstantEvaluator.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ConstantEvaluator.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ConstantEvaluator.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/ConstraintIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ConstraintIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ConstraintIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/DeductionGuideIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/DeductionGuideIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/DeductionGuideIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/EnclosingScopeIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/EnclosingScopeIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/EnclosingScopeIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/EntityIdentity.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/EntityIdentity.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/EntityIdentity.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/EnumerationTable.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/EnumerationTable.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/EnumerationTable.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/FlatExpressionCache.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/FlatExpressionCache.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/FlatExpressionCache.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/FriendshipIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/FriendshipIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/FriendshipIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/GlobalSymbolIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/GlobalSymbolIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/GlobalSymbolIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/IdentifierIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/IdentifierIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/IdentifierIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/LineTable.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/LineTable.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/LineTable.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/LiteralTable.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/LiteralTable.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/LiteralTable.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/MacroTable.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/MacroTable.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/MacroTable.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/OverloadSetIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/OverloadSetIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/OverloadSetIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/ParentIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ParentIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ParentIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/PositionIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/PositionIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/PositionIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/QualifiedNameList.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/QualifiedNameList.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/QualifiedNameList.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/QualifiedNameResolver.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/QualifiedNameResolver.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/QualifiedNameResolver.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/Reachability.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/Reachability.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/Reachability.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/ReferenceIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ReferenceIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ReferenceIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/ScopeNameIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ScopeNameIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ScopeNameIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/ScopeSortIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ScopeSortIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/ScopeSortIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/SentenceTextIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/SentenceTextIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/SentenceTextIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/SourceFileIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/SourceFileIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/SourceFileIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/SpecializationIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/SpecializationIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/SpecializationIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/SpecifierTable.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/SpecifierTable.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/SpecifierTable.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/TemplateArgumentIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TemplateArgumentIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TemplateArgumentIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/TemplateSubstitution.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TemplateSubstitution.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TemplateSubstitution.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/TranslationUnitLookup.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TranslationUnitLookup.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TranslationUnitLookup.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/TypeHashIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TypeHashIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TypeHashIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/TypeLayoutIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TypeLayoutIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TypeLayoutIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/TypeStripTable.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TypeStripTable.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TypeStripTable.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/TypeUseIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TypeUseIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/TypeUseIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/UsingResolver.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/UsingResolver.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/UsingResolver.cpp.o.d"
+  "/root/repo/lib/reflifc/src/index/VirtualTableIndex.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/VirtualTableIndex.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/index/VirtualTableIndex.cpp.o.d"
+  "/root/repo/lib/reflifc/src/syntax/TemplateId.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/syntax/TemplateId.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/syntax/TemplateId.cpp.o.d"
+  "/root/repo/lib/reflifc/src/syntax/TypeId.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/syntax/TypeId.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/syntax/TypeId.cpp.o.d"
+  "/root/repo/lib/reflifc/src/syntax/TypeSpecifier.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/syntax/TypeSpecifier.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/syntax/TypeSpecifier.cpp.o.d"
+  "/root/repo/lib/reflifc/src/type/Array.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Array.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Array.cpp.o.d"
+  "/root/repo/lib/reflifc/src/type/Base.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Base.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Base.cpp.o.d"
+  "/root/repo/lib/reflifc/src/type/Expansion.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Expansion.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Expansion.cpp.o.d"
+  "/root/repo/lib/reflifc/src/type/Forall.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Forall.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Forall.cpp.o.d"
+  "/root/repo/lib/reflifc/src/type/Function.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Function.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Function.cpp.o.d"
+  "/root/repo/lib/reflifc/src/type/Placeholder.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Placeholder.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Placeholder.cpp.o.d"
+  "/root/repo/lib/reflifc/src/type/Qualified.cpp" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Qualified.cpp.o" "gcc" "lib/reflifc/CMakeFiles/reflifc.dir/src/type/Qualified.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_ex_build/lib/core/CMakeFiles/ifc-core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,215 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/reflifc.dir/src/AbiDiff.cpp.o"
+  "CMakeFiles/reflifc.dir/src/AbiDiff.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Attribute.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Attribute.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Chart.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Chart.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Declaration.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Declaration.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/DeclarationQuery.cpp.o"
+  "CMakeFiles/reflifc.dir/src/DeclarationQuery.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Expression.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Expression.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/JsonWriter.cpp.o"
+  "CMakeFiles/reflifc.dir/src/JsonWriter.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Layout.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Layout.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Macro.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Macro.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Mangler.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Mangler.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Name.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Name.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/NameArena.cpp.o"
+  "CMakeFiles/reflifc.dir/src/NameArena.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Outline.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Outline.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Query.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Query.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Sentence.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Sentence.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/SideTable.cpp.o"
+  "CMakeFiles/reflifc.dir/src/SideTable.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Signatures.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Signatures.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/StringLiteral.cpp.o"
+  "CMakeFiles/reflifc.dir/src/StringLiteral.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Subset.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Subset.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Syntax.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Syntax.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/SyntaxWalker.cpp.o"
+  "CMakeFiles/reflifc.dir/src/SyntaxWalker.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/TemplateId.cpp.o"
+  "CMakeFiles/reflifc.dir/src/TemplateId.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/TupleView.cpp.o"
+  "CMakeFiles/reflifc.dir/src/TupleView.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Type.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Type.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/TypeRenderer.cpp.o"
+  "CMakeFiles/reflifc.dir/src/TypeRenderer.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Walk.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Walk.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/Word.cpp.o"
+  "CMakeFiles/reflifc.dir/src/Word.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/AliasDeclaration.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/AliasDeclaration.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/ClassOrStruct.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/ClassOrStruct.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/Concept.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/Concept.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/DeclarationReference.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/DeclarationReference.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/Enumeration.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/Enumeration.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/Enumerator.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/Enumerator.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/Field.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/Field.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/Function.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/Function.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/Parameter.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/Parameter.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/Scope.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/Scope.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/ScopeDeclaration.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/ScopeDeclaration.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/Specialization.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/Specialization.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/TemplateDeclaration.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/TemplateDeclaration.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/UsingDeclaration.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/UsingDeclaration.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/decl/Variable.cpp.o"
+  "CMakeFiles/reflifc.dir/src/decl/Variable.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/expr/Alignof.cpp.o"
+  "CMakeFiles/reflifc.dir/src/expr/Alignof.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/expr/Call.cpp.o"
+  "CMakeFiles/reflifc.dir/src/expr/Call.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/expr/Dyad.cpp.o"
+  "CMakeFiles/reflifc.dir/src/expr/Dyad.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/expr/Monad.cpp.o"
+  "CMakeFiles/reflifc.dir/src/expr/Monad.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/expr/Path.cpp.o"
+  "CMakeFiles/reflifc.dir/src/expr/Path.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/expr/ProductValueType.cpp.o"
+  "CMakeFiles/reflifc.dir/src/expr/ProductValueType.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/expr/Read.cpp.o"
+  "CMakeFiles/reflifc.dir/src/expr/Read.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/expr/Sizeof.cpp.o"
+  "CMakeFiles/reflifc.dir/src/expr/Sizeof.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/expr/UnqualifiedId.cpp.o"
+  "CMakeFiles/reflifc.dir/src/expr/UnqualifiedId.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/AliasResolution.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/AliasResolution.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/AttributeIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/AttributeIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/BaseLinearization.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/BaseLinearization.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/ChartParameterIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/ChartParameterIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/ClassHierarchy.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/ClassHierarchy.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/CompletionIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/CompletionIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/ConceptChecker.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/ConceptChecker.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/ConstantEvaluator.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/ConstantEvaluator.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/ConstraintIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/ConstraintIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/DeductionGuideIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/DeductionGuideIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/EnclosingScopeIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/EnclosingScopeIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/EntityIdentity.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/EntityIdentity.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/EnumerationTable.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/EnumerationTable.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/FlatExpressionCache.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/FlatExpressionCache.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/FriendshipIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/FriendshipIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/GlobalSymbolIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/GlobalSymbolIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/IdentifierIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/IdentifierIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/LineTable.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/LineTable.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/LiteralTable.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/LiteralTable.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/MacroTable.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/MacroTable.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/OverloadSetIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/OverloadSetIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/ParentIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/ParentIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/PositionIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/PositionIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/QualifiedNameList.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/QualifiedNameList.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/QualifiedNameResolver.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/QualifiedNameResolver.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/Reachability.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/Reachability.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/ReferenceIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/ReferenceIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/ScopeNameIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/ScopeNameIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/ScopeSortIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/ScopeSortIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/SentenceTextIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/SentenceTextIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/SourceFileIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/SourceFileIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/SpecializationIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/SpecializationIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/SpecifierTable.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/SpecifierTable.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/TemplateArgumentIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/TemplateArgumentIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/TemplateSubstitution.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/TemplateSubstitution.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/TranslationUnitLookup.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/TranslationUnitLookup.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/TypeHashIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/TypeHashIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/TypeLayoutIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/TypeLayoutIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/TypeStripTable.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/TypeStripTable.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/TypeUseIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/TypeUseIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/UsingResolver.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/UsingResolver.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/index/VirtualTableIndex.cpp.o"
+  "CMakeFiles/reflifc.dir/src/index/VirtualTableIndex.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/syntax/TemplateId.cpp.o"
+  "CMakeFiles/reflifc.dir/src/syntax/TemplateId.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/syntax/TypeId.cpp.o"
+  "CMakeFiles/reflifc.dir/src/syntax/TypeId.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/syntax/TypeSpecifier.cpp.o"
+  "CMakeFiles/reflifc.dir/src/syntax/TypeSpecifier.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/type/Array.cpp.o"
+  "CMakeFiles/reflifc.dir/src/type/Array.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/type/Base.cpp.o"
+  "CMakeFiles/reflifc.dir/src/type/Base.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/type/Expansion.cpp.o"
+  "CMakeFiles/reflifc.dir/src/type/Expansion.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/type/Forall.cpp.o"
+  "CMakeFiles/reflifc.dir/src/type/Forall.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/type/Function.cpp.o"
+  "CMakeFiles/reflifc.dir/src/type/Function.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/type/Placeholder.cpp.o"
+  "CMakeFiles/reflifc.dir/src/type/Placeholder.cpp.o.d"
+  "CMakeFiles/reflifc.dir/src/type/Qualified.cpp.o"
+  "CMakeFiles/reflifc.dir/src/type/Qualified.cpp.o.d"
+  "libreflifc.a"
+  "libreflifc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/reflifc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_test_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("lib/core")
+subdirs("lib/reflifc")
+subdirs("lib/msvc")
+subdirs("lib/blob-reader")
+subdirs("tests")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ifc-msvc.dir/src/MSVCEnvironment.cpp.o"
+  "CMakeFiles/ifc-msvc.dir/src/MSVCEnvironment.cpp.o.d"
+  "libifc-msvc.a"
+  "libifc-msvc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ifc-msvc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
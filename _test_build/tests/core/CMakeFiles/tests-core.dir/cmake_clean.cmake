@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests-core.dir/src/c_api.c.o"
+  "CMakeFiles/tests-core.dir/src/c_api.c.o.d"
+  "CMakeFiles/tests-core.dir/src/main.cpp.o"
+  "CMakeFiles/tests-core.dir/src/main.cpp.o.d"
+  "tests-core"
+  "tests-core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/tests-core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
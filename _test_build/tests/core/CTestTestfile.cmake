@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/core
+# Build directory: /root/repo/_test_build/tests/core
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(core "/root/repo/_test_build/tests/core/tests-core" "/root/repo/tests/core/data")
+set_tests_properties(core PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/core/CMakeLists.txt;7;add_test;/root/repo/tests/core/CMakeLists.txt;0;")
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/msvc/src/main.cpp" "tests/msvc/CMakeFiles/tests-msvc.dir/src/main.cpp.o" "gcc" "tests/msvc/CMakeFiles/tests-msvc.dir/src/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_test_build/lib/msvc/CMakeFiles/ifc-msvc.dir/DependInfo.cmake"
+  "/root/repo/_test_build/lib/blob-reader/CMakeFiles/ifc-blob-reader.dir/DependInfo.cmake"
+  "/root/repo/_test_build/lib/reflifc/CMakeFiles/reflifc.dir/DependInfo.cmake"
+  "/root/repo/_test_build/lib/core/CMakeFiles/ifc-core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests-msvc.dir/src/main.cpp.o"
+  "CMakeFiles/tests-msvc.dir/src/main.cpp.o.d"
+  "tests-msvc"
+  "tests-msvc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tests-msvc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/msvc
+# Build directory: /root/repo/_test_build/tests/msvc
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(msvc "/root/repo/_test_build/tests/msvc/tests-msvc" "/root/repo/tests/msvc/data")
+set_tests_properties(msvc PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/msvc/CMakeLists.txt;6;add_test;/root/repo/tests/msvc/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/reflifc-tests.dir/src/main.cpp.o"
+  "CMakeFiles/reflifc-tests.dir/src/main.cpp.o.d"
+  "reflifc-tests"
+  "reflifc-tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/reflifc-tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests/reflifc
+# Build directory: /root/repo/_test_build/tests/reflifc
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(reflifc "/root/repo/_test_build/tests/reflifc/reflifc-tests" "/root/repo/tests/reflifc/data")
+set_tests_properties(reflifc PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/reflifc/CMakeLists.txt;7;add_test;/root/repo/tests/reflifc/CMakeLists.txt;0;")
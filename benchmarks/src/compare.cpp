@@ -0,0 +1,458 @@
+#include <ifc/blob_reader.h>
+#include <ifc/Declaration.h>
+#include <ifc/File.h>
+#include <ifc/Name.h>
+#include <ifc/Type.h>
+#include <reflifc/Module.h>
+#include <reflifc/Name.h>
+#include <reflifc/TupleView.h>
+#include <reflifc/Type.h>
+#include <reflifc/TypeRenderer.h>
+#include <reflifc/decl/ClassOrStruct.h>
+#include <reflifc/decl/Field.h>
+#include <reflifc/decl/Function.h>
+#include <reflifc/decl/Namespace.h>
+#include <reflifc/decl/ScopeDeclaration.h>
+#include <reflifc/decl/Variable.h>
+#include <reflifc/type/Function.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Resource usage of the whole process so far. Peak RSS is a high-water mark, so each backend and workload
+    // is measured in a process of its own (see the `run-comparison` target).
+    struct Usage
+    {
+        long peak_rss_kib = 0;
+        long minor_faults = 0;
+        long major_faults = 0; // Not told apart from minor faults on Windows
+    };
+
+    Usage current_usage()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+        return { static_cast<long>(counters.PeakWorkingSetSize / 1024), static_cast<long>(counters.PageFaultCount), 0 };
+#else
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+        const long peak = usage.ru_maxrss / 1024; // In bytes
+#else
+        const long peak = usage.ru_maxrss;
+#endif
+        return { peak, usage.ru_minflt, usage.ru_majflt };
+#endif
+    }
+
+    struct Input
+    {
+        std::filesystem::path path;
+        ifc::Environment::BlobHolderPtr blob;
+        std::unique_ptr<ifc::File> file;
+    };
+
+    // Like the header units of the test data, which have no declarations to work on.
+    bool has_scopes(ifc::File const& file)
+    {
+        return file.has_partition(ifc::Declaration::PartitionName) && file.has_partition("scope.desc");
+    }
+
+    // Scopes walked by both backends: the global one, namespaces and complete classes and structs.
+    bool is_walked(ifc::File const& file, ifc::DeclIndex decl)
+    {
+        if (decl.sort() != ifc::DeclSort::Scope)
+            return false;
+        auto const & scope = file.scope_declarations()[decl];
+        if (ifc::is_null(scope.initializer))
+            return false;
+        const auto kind = get_kind(scope, file);
+        return kind == ifc::TypeBasis::Namespace || kind == ifc::TypeBasis::Class || kind == ifc::TypeBasis::Struct;
+    }
+
+    // Identifier of the declarations that can be looked up by name, empty for the others.
+    std::string_view identifier(ifc::File const& file, ifc::DeclIndex decl)
+    {
+        auto from_name = [&file](ifc::NameIndex name) {
+            return name.sort() == ifc::NameSort::Identifier ? file.get_string_view(ifc::TextOffset{ name.index }) : std::string_view();
+        };
+        switch (decl.sort())
+        {
+        case ifc::DeclSort::Scope:       return from_name(file.scope_declarations()[decl].name);
+        case ifc::DeclSort::Template:    return from_name(file.template_declarations()[decl].name);
+        case ifc::DeclSort::Function:    return from_name(file.functions()[decl].name);
+        case ifc::DeclSort::Variable:    return from_name(file.variables()[decl].name);
+        case ifc::DeclSort::Enumeration: return file.get_string_view(file.enumerations()[decl].name);
+        case ifc::DeclSort::Alias:       return file.get_string_view(file.alias_declarations()[decl].name);
+        case ifc::DeclSort::Field:       return file.get_string_view(file.fields()[decl].name);
+        default:                         return {};
+        }
+    }
+
+    struct Lookup
+    {
+        ifc::ScopeIndex scope;
+        std::string name;
+    };
+
+    // The workloads, each returning a count to compare the work of the backends by.
+    struct Backend
+    {
+        std::function<size_t(ifc::File const&)> open;
+        std::function<size_t(ifc::File const&)> walk;
+        std::function<size_t(ifc::File const&)> types;
+        std::function<size_t(ifc::File const&, std::vector<Lookup> const&)> lookup;
+    };
+
+    // Direct access to the partitions of ifc::File, what a reader without reflifc's indexes and wrappers does.
+    namespace raw
+    {
+        void walk(ifc::File const& file, ifc::ScopeIndex scope, std::function<void(ifc::ScopeIndex, ifc::DeclIndex)> const& visit)
+        {
+            for (auto member : ifc::get_declarations(file, file.scope_descriptors()[scope]))
+            {
+                visit(scope, member.index);
+                if (is_walked(file, member.index))
+                    walk(file, file.scope_declarations()[member.index].initializer, visit);
+            }
+        }
+
+        // Unmemoized and only as far as the common sorts go, like a reader would write it.
+        void render(ifc::File const& file, ifc::TypeIndex type, std::string& out)
+        {
+            switch (type.sort())
+            {
+            case ifc::TypeSort::Fundamental:
+                out += "fundamental";
+                break;
+            case ifc::TypeSort::Designated:
+            {
+                const auto name = identifier(file, file.designated_types()[type].decl);
+                out += name.empty() ? "(anonymous)" : name;
+                break;
+            }
+            case ifc::TypeSort::Pointer:
+                render(file, file.pointer_types()[type].pointee, out);
+                out += '*';
+                break;
+            case ifc::TypeSort::LvalueReference:
+                render(file, file.lvalue_references()[type].referee, out);
+                out += '&';
+                break;
+            case ifc::TypeSort::RvalueReference:
+                render(file, file.rvalue_references()[type].referee, out);
+                out += "&&";
+                break;
+            case ifc::TypeSort::Qualified:
+                render(file, file.qualified_types()[type].unqualified, out);
+                out += " const";
+                break;
+            case ifc::TypeSort::Tuple:
+            {
+                bool first = true;
+                for (auto element : file.type_heap().slice(file.tuple_types()[type].seq))
+                {
+                    if (!std::exchange(first, false))
+                        out += ',';
+                    render(file, element, out);
+                }
+                break;
+            }
+            case ifc::TypeSort::Function:
+            {
+                auto const & function = file.function_types()[type];
+                render(file, function.target, out);
+                out += '(';
+                render(file, function.source, out);
+                out += ')';
+                break;
+            }
+            default:
+                out += '?';
+                break;
+            }
+        }
+
+        Backend backend()
+        {
+            return {
+                .open = [](ifc::File const& file) {
+                    return static_cast<size_t>(raw_count(file.global_scope().cardinality));
+                },
+                .walk = [](ifc::File const& file) {
+                    size_t count = 0;
+                    raw::walk(file, file.header().global_scope, [&count](ifc::ScopeIndex, ifc::DeclIndex) { ++count; });
+                    return count;
+                },
+                .types = [](ifc::File const& file) {
+                    size_t count = 0;
+                    std::string spelling;
+                    auto render = [&](ifc::TypeIndex type) {
+                        spelling.clear();
+                        raw::render(file, type, spelling);
+                        ++count;
+                    };
+                    raw::walk(file, file.header().global_scope, [&](ifc::ScopeIndex, ifc::DeclIndex decl) {
+                        switch (decl.sort())
+                        {
+                        case ifc::DeclSort::Variable: render(file.variables()[decl].type); break;
+                        case ifc::DeclSort::Field:    render(file.fields()[decl].type); break;
+                        case ifc::DeclSort::Function:
+                        {
+                            const auto type = file.functions()[decl].type;
+                            if (type.sort() != ifc::TypeSort::Function)
+                                break;
+                            auto const & function = file.function_types()[type];
+                            render(function.target);
+                            if (function.source.sort() == ifc::TypeSort::Tuple)
+                            {
+                                for (auto parameter : file.type_heap().slice(file.tuple_types()[function.source].seq))
+                                    render(parameter);
+                            }
+                            else if (!function.source.is_null())
+                            {
+                                render(function.source);
+                            }
+                            break;
+                        }
+                        default:
+                            break;
+                        }
+                    });
+                    return count;
+                },
+                .lookup = [](ifc::File const& file, std::vector<Lookup> const& lookups) {
+                    size_t found = 0;
+                    for (auto const & lookup : lookups)
+                    {
+                        for (auto member : ifc::get_declarations(file, file.scope_descriptors()[lookup.scope]))
+                        {
+                            if (identifier(file, member.index) == lookup.name)
+                            {
+                                ++found;
+                                break;
+                            }
+                        }
+                    }
+                    return found;
+                },
+            };
+        }
+    }
+
+    // The same workloads through reflifc's wrappers and indexes.
+    namespace wrapped
+    {
+        template<typename Visit>
+        void walk(reflifc::Scope scope, Visit const& visit)
+        {
+            if (ifc::is_null(scope.index()))
+                return;
+            for (auto declaration : scope.get_declarations())
+            {
+                visit(declaration);
+                if (!declaration.is_scope())
+                    continue;
+                const auto scope_declaration = declaration.as_scope();
+                if (scope_declaration.is_namespace())
+                {
+                    walk(scope_declaration.as_namespace().scope(), visit);
+                }
+                else if (scope_declaration.is_class_or_struct())
+                {
+                    const auto class_ = scope_declaration.as_class_or_struct();
+                    if (class_.is_complete())
+                        walk(class_.scope(), visit);
+                }
+            }
+        }
+
+        Backend backend()
+        {
+            return {
+                .open = [](ifc::File const& file) {
+                    const auto global = reflifc::Module(&file).global_namespace();
+                    return static_cast<size_t>(std::ranges::distance(global.get_declarations()));
+                },
+                .walk = [](ifc::File const& file) {
+                    size_t count = 0;
+                    wrapped::walk(reflifc::Module(&file).global_namespace(), [&count](reflifc::Declaration) { ++count; });
+                    return count;
+                },
+                .types = [](ifc::File const& file) {
+                    size_t count = 0;
+                    reflifc::TypeRenderer renderer(file);
+                    auto render = [&](reflifc::Type type) {
+                        renderer.spelling(type.index());
+                        ++count;
+                    };
+                    wrapped::walk(reflifc::Module(&file).global_namespace(), [&](reflifc::Declaration declaration) {
+                        if (declaration.is_variable())
+                        {
+                            render(declaration.as_variable().type());
+                        }
+                        else if (declaration.is_field())
+                        {
+                            render(declaration.as_field().type());
+                        }
+                        else if (declaration.is_function() && file.functions()[declaration.index()].type.sort() == ifc::TypeSort::Function)
+                        {
+                            const auto type = declaration.as_function().type();
+                            render(type.return_type());
+                            for (auto parameter : type.parameters())
+                                render(parameter);
+                        }
+                    });
+                    return count;
+                },
+                .lookup = [](ifc::File const& file, std::vector<Lookup> const& lookups) {
+                    size_t found = 0;
+                    for (auto const & lookup : lookups)
+                        found += reflifc::Scope(&file, lookup.scope).find(lookup.name).has_value();
+                    return found;
+                },
+            };
+        }
+    }
+
+    // Every named member of the walked scopes, collected before measuring.
+    std::vector<Lookup> collect_lookups(ifc::File const& file)
+    {
+        std::vector<Lookup> lookups;
+        raw::walk(file, file.header().global_scope, [&](ifc::ScopeIndex scope, ifc::DeclIndex decl) {
+            if (const auto name = identifier(file, decl); !name.empty())
+                lookups.push_back({ scope, std::string(name) });
+        });
+        return lookups;
+    }
+
+    int usage_error()
+    {
+        std::cerr << "expected: <reflifc|raw> <open|walk|types|lookup> [--repeat N] <.ifc file or directory>...\n";
+        return EXIT_FAILURE;
+    }
+}
+
+// Usage: ifc-compare <backend> <workload> [--repeat N] <.ifc file or directory>...
+// Runs one workload with one backend and prints a tab-separated line: backend, workload, wall time per
+// repetition in milliseconds, peak RSS in KiB, minor and major page faults during the workload, and the
+// count the workload computed, the same for both backends.
+int main(int argc, char* argv[])
+{
+    if (argc < 4)
+        return usage_error();
+
+    const std::string_view backend_name = argv[1];
+    const std::string_view workload = argv[2];
+    Backend backend;
+    if (backend_name == "reflifc")
+        backend = wrapped::backend();
+    else if (backend_name == "raw")
+        backend = raw::backend();
+    else
+        return usage_error();
+    if (workload != "open" && workload != "walk" && workload != "types" && workload != "lookup")
+        return usage_error();
+
+    int repeat = 1;
+    std::vector<std::filesystem::path> paths;
+    for (int i = 3; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (argument == "--repeat" && i + 1 < argc)
+        {
+            repeat = std::max(1, std::atoi(argv[++i]));
+            continue;
+        }
+
+        const std::filesystem::path path = argument;
+        if (is_directory(path))
+        {
+            for (auto const & entry : std::filesystem::directory_iterator(path))
+                if (entry.is_regular_file() && entry.path().extension() == ".ifc")
+                    paths.push_back(entry.path());
+        }
+        else if (is_regular_file(path))
+        {
+            paths.push_back(path);
+        }
+        else
+        {
+            std::cerr << path << " is neither a file nor a directory\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (paths.empty())
+        return usage_error();
+    std::ranges::sort(paths);
+
+    // Opening reads the BMIs in the measurement, the other workloads start from open files.
+    std::vector<Input> inputs;
+    std::vector<std::vector<Lookup>> lookups;
+    if (workload != "open")
+    {
+        for (auto const & path : paths)
+        {
+            auto blob = ifc::read_blob(path);
+            auto file = std::make_unique<ifc::File>(blob->view());
+            lookups.push_back(workload == "lookup" && has_scopes(*file) ? collect_lookups(*file) : std::vector<Lookup>());
+            inputs.push_back({ path, std::move(blob), std::move(file) });
+        }
+    }
+
+    size_t result = 0;
+    const auto before = current_usage();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i != repeat; ++i)
+    {
+        result = 0;
+        if (workload == "open")
+        {
+            for (auto const & path : paths)
+            {
+                const auto blob = ifc::read_blob(path);
+                const ifc::File file(blob->view());
+                if (has_scopes(file))
+                    result += backend.open(file);
+            }
+            continue;
+        }
+        for (size_t input = 0; input != inputs.size(); ++input)
+        {
+            auto const & file = *inputs[input].file;
+            if (!has_scopes(file))
+                continue;
+            if (workload == "walk")
+                result += backend.walk(file);
+            else if (workload == "types")
+                result += backend.types(file);
+            else
+                result += backend.lookup(file, lookups[input]);
+        }
+    }
+    const std::chrono::duration<double, std::milli> wall = std::chrono::steady_clock::now() - start;
+    const auto after = current_usage();
+
+    std::cout << backend_name << '\t' << workload << '\t' << wall.count() / repeat << '\t' << after.peak_rss_kib << '\t'
+              << after.minor_faults - before.minor_faults << '\t' << after.major_faults - before.major_faults << '\t' << result << '\n';
+    return EXIT_SUCCESS;
+}
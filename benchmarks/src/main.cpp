@@ -0,0 +1,329 @@
+#include "Presenter.h"
+
+#include <ifc/AllocationCounter.h>
+#include <ifc/blob_reader.h>
+#include <ifc/File.h>
+#include <ifc/MSVCEnvironment.h>
+#include <ifc/PostingLists.h>
+#include <ifc/SortFilter.h>
+#include <ifc/Type.h>
+#include <reflifc/Module.h>
+#include <reflifc/Query.h>
+#include <reflifc/TupleView.h>
+#include <reflifc/Type.h>
+#include <reflifc/decl/Namespace.h>
+#include <reflifc/type/Function.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iterator>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <set>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace std::string_literals;
+
+namespace
+{
+    // Keeps the BMI of a benchmark loaded for the whole run. BMIs with a config next to them (`<path>.d.json`)
+    // are loaded through an Environment, so that declarations from other modules can be presented.
+    struct Input
+    {
+        std::filesystem::path path;
+        std::string config;
+        ifc::Environment::BlobHolderPtr blob;
+        std::unique_ptr<ifc::Environment> environment;
+        ifc::File const* file = nullptr;
+        std::unique_ptr<ifc::File> own_file;
+    };
+
+    Input load(std::filesystem::path const& path)
+    {
+        Input input{ .path = path, .blob = ifc::read_blob(path) };
+        if (const auto config = path.string() + ".d.json"s; std::filesystem::is_regular_file(config))
+        {
+            input.config = config;
+            input.environment = std::make_unique<ifc::Environment>(ifc::read_msvc_config(config, path.parent_path()), ifc::read_blob);
+            input.file = &input.environment->get_module_by_bmi_path(path);
+        }
+        else
+        {
+            input.own_file = std::make_unique<ifc::File>(input.blob->view());
+            input.file = input.own_file.get();
+        }
+        return input;
+    }
+
+    // Discards everything written to it, so that presenting measures the presenter rather than the terminal.
+    class NullBuffer : public std::streambuf
+    {
+    protected:
+        int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+    };
+
+    // Heap allocations per iteration, in builds counting them (see IFC_READER_COUNT_ALLOCATIONS).
+    void report_allocations(benchmark::State& state, ifc::AllocationScope const& scope)
+    {
+        if (ifc::counts_allocations)
+            state.counters["allocations"] = benchmark::Counter(static_cast<double>(scope.count().allocations), benchmark::Counter::kAvgIterations);
+    }
+
+    void walk(reflifc::Scope scope, size_t& count)
+    {
+        if (ifc::is_null(scope.index()))
+            return;
+        for (auto declaration : scope.get_declarations())
+        {
+            ++count;
+            if (declaration.is_scope() && declaration.as_scope().is_namespace())
+                walk(declaration.as_scope().as_namespace().scope(), count);
+        }
+    }
+
+    std::vector<std::string> namespace_names(reflifc::Module module)
+    {
+        std::vector<std::string> names;
+        for (auto declaration : module.global_namespace().get_declarations())
+            if (declaration.is_scope() && declaration.as_scope().is_namespace())
+                if (auto name = declaration.as_scope().name(); name.is_identifier())
+                    names.emplace_back(name.as_identifier());
+        return names;
+    }
+
+    void register_file_benchmarks(Input const& input)
+    {
+        const auto name = input.path.filename().string();
+        auto const & file = *input.file;
+
+        benchmark::RegisterBenchmark(("File/construction/" + name).c_str(), [&input](benchmark::State& state) {
+            for (auto _ : state)
+            {
+                ifc::File file(input.blob->view());
+                benchmark::DoNotOptimize(file.header());
+            }
+        });
+
+        benchmark::RegisterBenchmark(("File/construction_eager/" + name).c_str(), [&input](benchmark::State& state) {
+            for (auto _ : state)
+            {
+                ifc::File file(input.blob->view(), { .eager_partitions = true });
+                benchmark::DoNotOptimize(file.header());
+            }
+        });
+
+        // The remaining benchmarks are about declarations.
+        if (!file.has_partition(ifc::Declaration::PartitionName))
+            return;
+
+        benchmark::RegisterBenchmark(("File/partition_access/" + name).c_str(), [&file](benchmark::State& state) {
+            for (auto _ : state)
+            {
+                benchmark::DoNotOptimize(file.declarations().size());
+                benchmark::DoNotOptimize(file.scope_descriptors().size());
+                benchmark::DoNotOptimize(file.has_partition(ifc::FunctionType::PartitionName));
+            }
+        });
+
+        benchmark::RegisterBenchmark(("Scope/get_declarations/" + name).c_str(), [&file](benchmark::State& state) {
+            const reflifc::Module module(&file);
+            const ifc::AllocationScope allocations;
+            for (auto _ : state)
+            {
+                size_t count = 0;
+                walk(module.global_namespace(), count);
+                benchmark::DoNotOptimize(count);
+            }
+            report_allocations(state, allocations);
+        });
+
+        if (file.has_partition(ifc::FunctionType::PartitionName))
+            benchmark::RegisterBenchmark(("TupleView/function_parameters/" + name).c_str(), [&file](benchmark::State& state) {
+                const ifc::AllocationScope allocations;
+                for (auto _ : state)
+                {
+                    size_t count = 0;
+                    for (auto const & function : file.function_types())
+                        for (auto parameter : reflifc::FunctionType(&file, function).parameters())
+                        {
+                            benchmark::DoNotOptimize(parameter);
+                            ++count;
+                        }
+                    benchmark::DoNotOptimize(count);
+                }
+                report_allocations(state, allocations);
+            });
+
+        if (file.has_partition("heap.type"))
+            benchmark::RegisterBenchmark(("SortFilter/type_heap_pointers/" + name).c_str(), [&file](benchmark::State& state) {
+                std::vector<uint32_t> positions;
+                for (auto _ : state)
+                {
+                    ifc::find_sort(file.type_heap(), ifc::TypeSort::Pointer, positions);
+                    benchmark::DoNotOptimize(positions.data());
+                }
+                state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(file.type_heap().size()));
+            });
+
+        benchmark::RegisterBenchmark(("Query/find_namespace_by_name/" + name).c_str(), [&file](benchmark::State& state) {
+            const reflifc::Module module(&file);
+            auto names = namespace_names(module);
+            if (names.empty())
+                names.push_back("std");
+            for (auto _ : state)
+                for (auto const & namespace_name : names)
+                    benchmark::DoNotOptimize(reflifc::find_namespace_by_name(module.global_namespace(), namespace_name));
+        });
+
+        benchmark::RegisterBenchmark(("Presenter/dump/" + name).c_str(), [&file, environment = input.environment.get()](benchmark::State& state) {
+            NullBuffer buffer;
+            std::ostream out(&buffer);
+            for (auto _ : state)
+            {
+                try
+                {
+                    Presenter(file, environment, out).present_scope_members(file.global_scope());
+                }
+                catch (std::exception const & e)
+                {
+                    // Like declarations from other modules, without a config.
+                    state.SkipWithError(e.what());
+                    break;
+                }
+            }
+        });
+
+        if (!input.config.empty())
+            benchmark::RegisterBenchmark(("Environment/prefetch_transitive/" + name).c_str(), [path = input.path, config = input.config](benchmark::State& state) {
+                for (auto _ : state)
+                {
+                    ifc::Environment environment(ifc::read_msvc_config(config, path.parent_path()), ifc::read_blob);
+                    environment.prefetch_transitive(environment.get_module_by_bmi_path(path));
+                    benchmark::DoNotOptimize(environment.loaded_bytes());
+                }
+            });
+    }
+
+    // Lists shaped like those of a cross-module index (e.g. the users of each type): declarations of a few
+    // dozen of 200 files each, clustered within files, compressed and as plain vectors.
+    void register_posting_list_benchmarks()
+    {
+        struct Lists
+        {
+            std::vector<std::vector<ifc::DeclarationId>> plain;
+            ifc::PostingLists compressed;
+        };
+        static const auto lists = [] {
+            Lists result;
+            std::mt19937 random(1);
+            for (int list = 0; list != 256; ++list)
+            {
+                std::set<ifc::DeclarationId> postings;
+                for (uint32_t file = 0; file != 200; ++file)
+                {
+                    if (random() % 4 != 0)
+                        continue;
+                    const auto base = static_cast<uint32_t>(random() % 50000);
+                    for (auto uses = random() % 64; uses != 0; --uses)
+                        postings.insert({ ifc::FileId{ file }, { .tag = static_cast<uint32_t>(ifc::DeclSort::Function), .index = base + static_cast<uint32_t>(random() % 2000) } });
+                }
+                result.plain.emplace_back(postings.begin(), postings.end());
+                result.compressed.add(result.plain.back());
+            }
+            return result;
+        }();
+
+        auto report_size = [](benchmark::State& state) {
+            state.counters["bytes_per_posting"] = static_cast<double>(lists.compressed.heap_bytes()) / static_cast<double>(lists.compressed.postings());
+        };
+
+        benchmark::RegisterBenchmark("PostingLists/decode", [report_size](benchmark::State& state) {
+            for (auto _ : state)
+            {
+                for (ifc::PostingLists::ListId list = 0; list != lists.compressed.size(); ++list)
+                {
+                    for (ifc::PostingLists::Cursor cursor(lists.compressed, list); !cursor.at_end(); cursor.next())
+                        benchmark::DoNotOptimize(cursor.value());
+                }
+            }
+            state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lists.compressed.postings()));
+            report_size(state);
+        });
+
+        benchmark::RegisterBenchmark("PostingLists/intersect", [report_size](benchmark::State& state) {
+            for (auto _ : state)
+            {
+                for (ifc::PostingLists::ListId list = 0; list + 1 != lists.compressed.size(); ++list)
+                {
+                    const ifc::PostingLists::ListId pair[] = { list, list + 1 };
+                    benchmark::DoNotOptimize(lists.compressed.intersect(pair));
+                }
+            }
+            report_size(state);
+        });
+
+        benchmark::RegisterBenchmark("PostingLists/intersect_uncompressed", [](benchmark::State& state) {
+            for (auto _ : state)
+            {
+                for (size_t list = 0; list + 1 != lists.plain.size(); ++list)
+                {
+                    std::vector<ifc::DeclarationId> both;
+                    std::ranges::set_intersection(lists.plain[list], lists.plain[list + 1], std::back_inserter(both));
+                    benchmark::DoNotOptimize(both);
+                }
+            }
+        });
+    }
+}
+
+// Usage: ifc-benchmarks [benchmark options] <.ifc file or directory of them>...
+int main(int argc, char* argv[])
+{
+    benchmark::Initialize(&argc, argv);
+
+    std::vector<std::filesystem::path> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::filesystem::path path = argv[i];
+        if (is_directory(path))
+        {
+            for (auto const & entry : std::filesystem::directory_iterator(path))
+                if (entry.is_regular_file() && entry.path().extension() == ".ifc")
+                    paths.push_back(entry.path());
+        }
+        else if (is_regular_file(path))
+        {
+            paths.push_back(path);
+        }
+        else
+        {
+            std::cerr << path << " is neither a file nor a directory\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (paths.empty())
+    {
+        std::cerr << "expected: [benchmark options] <.ifc file or directory>...\n";
+        return EXIT_FAILURE;
+    }
+    std::ranges::sort(paths);
+
+    std::vector<Input> inputs;
+    inputs.reserve(paths.size());
+    for (auto const & path : paths)
+        inputs.push_back(load(path));
+    for (auto const & input : inputs)
+        register_file_benchmarks(input);
+    register_posting_list_benchmarks();
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return EXIT_SUCCESS;
+}
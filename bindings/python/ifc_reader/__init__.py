@@ -0,0 +1,233 @@
+"""Partitions of IFC files as read-only NumPy structured arrays over the mapped file.
+
+    import ifc_reader
+
+    with ifc_reader.File("module.ifc") as ifc:
+        functions = ifc.partition("decl.function")    # one record per function, no copy
+        lines = functions["locus.line"]
+        names = ifc.strings                           # the string table as a read-only memoryview
+        print(ifc.string(int(functions["name"][0]) >> 3))
+
+Fields are the members of the structs of the C++ headers (ifc/*.h), members of nested structs by their path
+(e.g. "locus.line"). References (DeclIndex, TypeIndex, ...) are unsigned integers with the sort in the low bits,
+see `File.sort_bits`, `sort_of` and `index_of`. The library is ifc-c, built with BUILD_IFC_READER_PYTHON, found
+next to this file or at the path of the IFC_READER_LIBRARY environment variable.
+"""
+
+import ctypes
+import mmap
+import os
+import sys
+
+import numpy as np
+
+__all__ = ["File", "sort_of", "index_of"]
+
+_IFC_C_API_VERSION = 1
+
+_FIELD_UNSIGNED = 0
+_FIELD_SIGNED = 1
+_FIELD_REFERENCE = 2
+
+_OPEN_VERIFY_CHECKSUM = 1 << 0
+
+
+class _Partition(ctypes.Structure):
+    _fields_ = [
+        ("name", ctypes.c_char_p),
+        ("data", ctypes.c_void_p),
+        ("count", ctypes.c_uint32),
+        ("entry_size", ctypes.c_uint32),
+    ]
+
+
+class _Field(ctypes.Structure):
+    _fields_ = [
+        ("name", ctypes.c_char_p),
+        ("offset", ctypes.c_uint32),
+        ("size", ctypes.c_uint16),
+        ("count", ctypes.c_uint16),
+        ("kind", ctypes.c_uint8),
+        ("sort_bits", ctypes.c_uint8),
+        ("text", ctypes.c_uint8),
+    ]
+
+
+def _library_path():
+    if "IFC_READER_LIBRARY" in os.environ:
+        return os.environ["IFC_READER_LIBRARY"]
+    directory = os.path.dirname(os.path.abspath(__file__))
+    if sys.platform == "win32":
+        return os.path.join(directory, "ifc-c.dll")
+    if sys.platform == "darwin":
+        return os.path.join(directory, "libifc-c.dylib")
+    return os.path.join(directory, "libifc-c.so")
+
+
+def _load_library():
+    library = ctypes.CDLL(_library_path())
+    library.ifc_api_version.restype = ctypes.c_uint32
+    library.ifc_file_open.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_uint32]
+    library.ifc_file_open.restype = ctypes.c_void_p
+    library.ifc_file_close.argtypes = [ctypes.c_void_p]
+    library.ifc_last_error.restype = ctypes.c_char_p
+    library.ifc_partition_count.argtypes = [ctypes.c_void_p]
+    library.ifc_partition_count.restype = ctypes.c_uint32
+    library.ifc_get_partition.argtypes = [ctypes.c_void_p, ctypes.c_uint32, ctypes.POINTER(_Partition)]
+    library.ifc_get_partition.restype = ctypes.c_int
+    library.ifc_find_partition.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(_Partition)]
+    library.ifc_find_partition.restype = ctypes.c_int
+    library.ifc_string_table.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_size_t)]
+    library.ifc_string_table.restype = ctypes.c_void_p
+    library.ifc_partition_fields.argtypes = [ctypes.c_char_p, ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(ctypes.c_uint32)]
+    library.ifc_partition_fields.restype = ctypes.POINTER(_Field)
+    library.ifc_global_scope.argtypes = [ctypes.c_void_p]
+    library.ifc_global_scope.restype = ctypes.c_uint32
+    if library.ifc_api_version() != _IFC_C_API_VERSION:
+        raise ImportError("ifc-c has C API version %d, expected %d" % (library.ifc_api_version(), _IFC_C_API_VERSION))
+    return library
+
+
+_library = _load_library()
+
+# Layouts are static, each partition name is asked for once.
+_layouts = {}
+
+
+def _layout(name):
+    if name not in _layouts:
+        count = ctypes.c_uint32()
+        record_size = ctypes.c_uint32()
+        fields = _library.ifc_partition_fields(name.encode(), ctypes.byref(count), ctypes.byref(record_size))
+        _layouts[name] = None if not fields else [fields[i] for i in range(count.value)]
+    return _layouts[name]
+
+
+def _format(field):
+    kind = "i" if field.kind == _FIELD_SIGNED else "u"
+    element = "<%s%d" % (kind, field.size)
+    return element if field.count == 1 else (element, (field.count,))
+
+
+def sort_of(references, sort_bits):
+    """Sorts of an array of references, e.g. `sort_of(functions["type"], ifc.sort_bits("decl.function", "type"))`."""
+    return references & ((1 << sort_bits) - 1)
+
+
+def index_of(references, sort_bits):
+    """Indexes of an array of references into the partition of their sort."""
+    return references >> sort_bits
+
+
+class File:
+    """An IFC file mapped read-only. Arrays and views returned keep the mapping alive, even once closed."""
+
+    def __init__(self, path, verify_checksum=False):
+        with open(path, "rb") as f:
+            # Copy-on-write, so that ctypes can take its address; nothing writes to it.
+            self._mapping = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_COPY)
+        self._base = ctypes.c_char.from_buffer(self._mapping)
+        self._address = ctypes.addressof(self._base)
+        flags = _OPEN_VERIFY_CHECKSUM if verify_checksum else 0
+        self._file = _library.ifc_file_open(self._address, len(self._mapping), flags)
+        if not self._file:
+            message = _library.ifc_last_error().decode()
+            del self._base
+            self._mapping.close()
+            raise ValueError("%s: %s" % (path, message))
+
+    def close(self):
+        if self._file:
+            _library.ifc_file_close(self._file)
+            self._file = None
+            del self._base
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def __del__(self):
+        if getattr(self, "_file", None):
+            self.close()
+
+    def _check_open(self):
+        if not self._file:
+            raise ValueError("the file is closed")
+
+    def partition_names(self):
+        """Names of the partitions, in the order of the table of contents."""
+        self._check_open()
+        result = []
+        partition = _Partition()
+        for i in range(_library.ifc_partition_count(self._file)):
+            _library.ifc_get_partition(self._file, i, ctypes.byref(partition))
+            result.append(partition.name.decode())
+        return result
+
+    def has_partition(self, name):
+        self._check_open()
+        partition = _Partition()
+        return bool(_library.ifc_find_partition(self._file, name.encode(), ctypes.byref(partition)))
+
+    def dtype(self, name):
+        """Structured dtype of the records of the partition, its itemsize the entry size of this file."""
+        self._check_open()
+        partition = self._find(name)
+        fields = _layout(name)
+        if fields is None:
+            # Unknown records are exposed as raw bytes.
+            return np.dtype((np.void, partition.entry_size))
+        return np.dtype({
+            "names": [field.name.decode() for field in fields],
+            "formats": [_format(field) for field in fields],
+            "offsets": [field.offset for field in fields],
+            "itemsize": partition.entry_size,
+        })
+
+    def sort_bits(self, name, field):
+        """Bits of the sort of a reference field, 0 for fields that are not references."""
+        for f in _layout(name) or []:
+            if f.name.decode() == field:
+                return f.sort_bits if f.kind == _FIELD_REFERENCE else 0
+        raise KeyError(field)
+
+    def partition(self, name):
+        """Read-only structured array over the records of the partition. Raises KeyError if absent."""
+        partition = self._find(name)
+        dtype = self.dtype(name)
+        if partition.count == 0:
+            return np.zeros(0, dtype=dtype)
+        array = np.frombuffer(self._mapping, dtype=dtype, count=partition.count, offset=partition.data - self._address)
+        array.flags.writeable = False
+        return array
+
+    @property
+    def strings(self):
+        """The string table: null-terminated strings back to back, addressed by text offset."""
+        self._check_open()
+        size = ctypes.c_size_t()
+        data = _library.ifc_string_table(self._file, ctypes.byref(size))
+        if not data:
+            return memoryview(b"")
+        start = data - self._address
+        return memoryview(self._mapping)[start:start + size.value].toreadonly()
+
+    def string(self, offset):
+        strings = self.strings
+        end = bytes(strings[offset:]).index(b"\0")
+        return bytes(strings[offset:offset + end]).decode()
+
+    @property
+    def global_scope(self):
+        """Raw ScopeIndex of the global scope, an index into "scope.desc" (1-based, 0 is null)."""
+        self._check_open()
+        return _library.ifc_global_scope(self._file)
+
+    def _find(self, name):
+        self._check_open()
+        partition = _Partition()
+        if not _library.ifc_find_partition(self._file, name.encode(), ctypes.byref(partition)):
+            raise KeyError(name)
+        return partition
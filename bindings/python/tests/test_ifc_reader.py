@@ -0,0 +1,56 @@
+import os
+import sys
+import unittest
+
+import numpy as np
+
+import ifc_reader
+
+DATA = sys.argv.pop(1) if len(sys.argv) > 1 else os.path.join(os.path.dirname(__file__), "..", "..", "..", "tests", "core", "data")
+
+
+class FileTest(unittest.TestCase):
+    def setUp(self):
+        self.ifc = ifc_reader.File(os.path.join(DATA, "attributes.ixx.ifc"))
+
+    def tearDown(self):
+        self.ifc.close()
+
+    def test_partitions(self):
+        names = self.ifc.partition_names()
+        self.assertIn("decl.function", names)
+        self.assertTrue(self.ifc.has_partition("decl.function"))
+        self.assertFalse(self.ifc.has_partition("no.such.partition"))
+        with self.assertRaises(KeyError):
+            self.ifc.partition("no.such.partition")
+
+    def test_records(self):
+        functions = self.ifc.partition("decl.function")
+        self.assertGreater(len(functions), 0)
+        self.assertFalse(functions.flags.writeable)
+        self.assertIn("locus.line", functions.dtype.names)
+
+        # Function names are identifiers, that is text offsets, for the functions of the test BMI.
+        bits = self.ifc.sort_bits("decl.function", "name")
+        self.assertEqual(bits, 3)
+        self.assertTrue(np.all(ifc_reader.sort_of(functions["name"], bits) == 0))
+        names = [self.ifc.string(int(offset)) for offset in ifc_reader.index_of(functions["name"], bits)]
+        self.assertTrue(all(names))
+
+    def test_strings(self):
+        strings = self.ifc.strings
+        self.assertTrue(strings.readonly)
+        self.assertEqual(strings[0], 0)
+
+    def test_arrays_outlive_the_file(self):
+        functions = self.ifc.partition("decl.function")
+        self.ifc.close()
+        self.assertGreater(int(functions["locus.line"].max()), 0)
+
+    def test_invalid_file(self):
+        with self.assertRaises(ValueError):
+            ifc_reader.File(os.path.join(DATA, "attributes.ixx"))
+
+
+if __name__ == "__main__":
+    unittest.main()
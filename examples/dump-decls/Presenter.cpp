@@ -12,6 +12,8 @@
 
 #include <cassert>
 #include <locale>
+#include <sstream>
+#include <vector>
 
 void Presenter::present(ifc::NameIndex name) const
 {
@@ -1095,6 +1097,39 @@ void Presenter::present_scope_members(ifc::Sequence scope) const
     present_range(get_declarations(file_, scope), "\n");
 }
 
+void Presenter::present_scope_members(ifc::Sequence scope, ifc::Executor& executor) const
+{
+    std::vector<ifc::DeclIndex> members;
+    for (auto member : get_declarations(file_, scope))
+        members.push_back(member.index);
+    present_declarations(members, executor);
+}
+
+void Presenter::present_declarations(std::span<ifc::DeclIndex const> declarations) const
+{
+    present_range(declarations, "\n");
+}
+
+void Presenter::present_declarations(std::span<ifc::DeclIndex const> declarations, ifc::Executor& executor) const
+{
+    std::vector<std::ostringstream> buffers(declarations.size());
+    executor.run(declarations.size(), [&](size_t i) {
+        Presenter presenter(file_, env_, buffers[i]);
+        presenter.indent_ = indent_;
+        presenter.present(declarations[i]);
+    });
+
+    bool first = true;
+    for (auto const & buffer : buffers)
+    {
+        if (first)
+            first = false;
+        else
+            out_ << "\n";
+        out_ << buffer.view();
+    }
+}
+
 void Presenter::present(ifc::ScopeDeclaration const& scope, ifc::DeclIndex index) const
 {
     const auto type = scope.type;
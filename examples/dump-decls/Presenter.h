@@ -12,8 +12,10 @@
 #include "ifc/Word.h"
 
 #include "ifc/Environment.h"
+#include "ifc/Parallel.h"
 
 #include <iosfwd>
+#include <span>
 
 class Presenter
 {
@@ -26,6 +28,13 @@ public:
 
     void present_scope_members(ifc::Sequence) const;
 
+    // Each member is presented by its own task, into its own buffer, and the buffers are written out in order.
+    void present_scope_members(ifc::Sequence, ifc::Executor&) const;
+
+    // Same for a selection of declarations, e.g. some members of a scope.
+    void present_declarations(std::span<ifc::DeclIndex const>) const;
+    void present_declarations(std::span<ifc::DeclIndex const>, ifc::Executor&) const;
+
 private:
     void present(ifc::NameIndex)     const;
     void present(ifc::DeclIndex)     const;
@@ -2,44 +2,400 @@
 
 #include "ifc/File.h"
 #include "ifc/MSVCEnvironment.h"
+#include "ifc/SortFilter.h"
 #include "ifc/blob_reader.h"
 
+#include "reflifc/Query.h"
+
+#include <array>
+#include <charconv>
+#include <chrono>
 #include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+struct DumpOptions
+{
+    // Other than 1 presents the members in parallel, 0 means one job per hardware thread.
+    unsigned jobs = 1;
+    bool stats = false;
+    bool deprecations = false;
+    // Dumps every module reachable from the root through imports and exports too, see dump_transitive.
+    bool transitive = false;
+    // Namespace or class whose members are presented, see reflifc::resolve. The global scope if empty.
+    std::string_view scope;
+    // Kinds of the presented members (see declaration_kind), all of them if empty.
+    std::vector<std::string_view> kinds;
+    // Identifiers of the presented members, with `*` and `?` wildcards, all of them if empty.
+    std::string_view name_glob;
+
+    bool filtered() const { return !scope.empty() || !kinds.empty() || !name_glob.empty(); }
+};
+
+static bool matches_glob(std::string_view text, std::string_view glob)
+{
+    // On a mismatch after a `*`, the star absorbs one more character.
+    size_t t = 0, g = 0, star = std::string_view::npos, star_t = 0;
+    while (t != text.size())
+    {
+        if (g != glob.size() && (glob[g] == '?' || glob[g] == text[t]))
+        {
+            ++t;
+            ++g;
+        }
+        else if (g != glob.size() && glob[g] == '*')
+        {
+            star = g++;
+            star_t = t;
+        }
+        else if (star != std::string_view::npos)
+        {
+            g = star + 1;
+            t = ++star_t;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return glob.find_first_not_of('*', g) == std::string_view::npos;
+}
+
+// Name of the kind of the declaration as given to `--kind`.
+static std::string_view declaration_kind(ifc::File const& file, ifc::DeclIndex decl)
+{
+    switch (decl.sort())
+    {
+    case ifc::DeclSort::Scope:
+        switch (get_kind(file.scope_declarations()[decl], file))
+        {
+        case ifc::TypeBasis::Namespace: return "namespace";
+        case ifc::TypeBasis::Class:     return "class";
+        case ifc::TypeBasis::Struct:    return "struct";
+        case ifc::TypeBasis::Union:     return "union";
+        default:                        return "scope";
+        }
+    case ifc::DeclSort::Enumeration:        return "enum";
+    case ifc::DeclSort::Variable:           return "variable";
+    case ifc::DeclSort::Field:
+    case ifc::DeclSort::Bitfield:           return "field";
+    case ifc::DeclSort::Alias:              return "alias";
+    case ifc::DeclSort::Template:           return "template";
+    case ifc::DeclSort::Concept:            return "concept";
+    case ifc::DeclSort::Function:           return "function";
+    case ifc::DeclSort::Method:             return "method";
+    case ifc::DeclSort::Constructor:        return "constructor";
+    case ifc::DeclSort::Destructor:         return "destructor";
+    case ifc::DeclSort::UsingDeclaration:   return "using";
+    default:                                return "other";
+    }
+}
+
+// Members of the scope named by `options.scope` (or the named declaration itself if it has no members) that
+// match the kinds and the glob. Only that scope is read, through the resolver of the file.
+static std::vector<ifc::DeclIndex> select_declarations(ifc::File const& file, DumpOptions const& options)
+{
+    std::vector<ifc::DeclIndex> candidates;
+    auto members = file.global_scope();
+    if (!options.scope.empty())
+    {
+        const auto target = reflifc::resolve(reflifc::Module(&file), options.scope);
+        if (!target)
+            throw std::runtime_error("cannot resolve '" + std::string(options.scope) + "'");
+
+        auto entity = target->index();
+        if (entity.sort() == ifc::DeclSort::Template)
+            entity = file.template_declarations()[entity].entity.decl;
+        if (entity.sort() == ifc::DeclSort::Scope && !ifc::is_null(file.scope_declarations()[entity].initializer))
+            members = file.scope_descriptors()[file.scope_declarations()[entity].initializer];
+        else
+            candidates.push_back(target->index());
+    }
+    if (candidates.empty())
+    {
+        for (auto member : get_declarations(file, members))
+            candidates.push_back(member.index);
+    }
 
-static void dump_ifc(ifc::File const& file, ifc::Environment* env = nullptr)
+    std::erase_if(candidates, [&](ifc::DeclIndex decl) {
+        if (!options.kinds.empty() && std::ranges::find(options.kinds, declaration_kind(file, decl)) == options.kinds.end())
+            return true;
+        if (options.name_glob.empty())
+            return false;
+        const auto identifier = ifc::declaration_identifier(file, decl);
+        return !identifier || !matches_glob(file.get_string_view(*identifier), options.name_glob);
+    });
+    return candidates;
+}
+
+static void dump_ifc(ifc::File const& file, DumpOptions const& options, ifc::Environment* env = nullptr, std::ostream& out = std::cout)
 {
     ifc::FileHeader const & header = file.header();
-    std::cout << "IFC Version: " << header.major_version << "." << header.minor_version << "\n"
+    out << "IFC Version: " << header.major_version << "." << header.minor_version << "\n"
               << "File contains " << raw_count(header.partition_count) << " partitions\n"
               << "Global Scope Index: " << static_cast<int>(header.global_scope) << "\n"
         ;
 
     auto declarations = file.declarations();
-    std::cout << "Total declarations count: " << declarations.size() << "\n";
+    out << "Total declarations count: " << declarations.size() << "\n";
 
     auto scopes = file.scope_descriptors();
-    std::cout << "Scopes count: " << scopes.size() << "\n";
+    out << "Scopes count: " << scopes.size() << "\n";
 
     size_t number_of_decls_from_all_scopes = 0;
     for (auto scope : scopes)
         number_of_decls_from_all_scopes += raw_count(scope.cardinality);
 
-    std::cout << "Count of declarations from all scopes: " << number_of_decls_from_all_scopes << "\n";
+    out << "Count of declarations from all scopes: " << number_of_decls_from_all_scopes << "\n";
 
-    std::cout << "-------------------------------------- Global Scope --------------------------------------\n";
+    Presenter presenter(file, env, out);
+    std::optional<ifc::ThreadPool> pool;
+    if (options.jobs != 1)
+        pool.emplace(options.jobs);
 
-    Presenter presenter(file, env, std::cout);
-    presenter.present_scope_members(file.global_scope());
+    if (options.filtered())
+    {
+        const auto selected = select_declarations(file, options);
+        out << "-------------------------------------- " << (options.scope.empty() ? "Global Scope" : options.scope)
+                  << " --------------------------------------\n";
+        if (pool)
+            presenter.present_declarations(selected, *pool);
+        else
+            presenter.present_declarations(selected);
+        return;
+    }
+
+    out << "-------------------------------------- Global Scope --------------------------------------\n";
+
+    if (pool)
+        presenter.present_scope_members(file.global_scope(), *pool);
+    else
+        presenter.present_scope_members(file.global_scope());
+}
+
+// The root first, then the modules it reaches through imports and exports, breadth first. They are loaded in
+// parallel by Environment::prefetch_transitive, modules missing from the config are skipped.
+static std::vector<ifc::File const*> reachable_modules(ifc::Environment& env, ifc::File const& root, ifc::Executor& executor)
+{
+    env.prefetch_transitive(root, executor);
+    const auto snapshot = env.snapshot();
+
+    std::vector<ifc::File const*> modules{ &root };
+    std::unordered_set<ifc::File const*> visited{ &root };
+    for (size_t i = 0; i != modules.size(); ++i)
+    {
+        auto const & file = *modules[i];
+        for (auto references : { file.imported_modules(), file.exported_modules() })
+        {
+            for (auto reference : references)
+            {
+                if (auto module = snapshot->find_referenced_module(reference, file); module && visited.insert(module).second)
+                    modules.push_back(module);
+            }
+        }
+    }
+    return modules;
+}
+
+// Each module is dumped by its own task into its own buffer, the buffers are written out in the order of
+// reachable_modules. Members of one module are presented sequentially, the modules are the unit of parallelism.
+static void dump_transitive(ifc::Environment& env, ifc::File const& root, DumpOptions const& options)
+{
+    std::optional<ifc::ThreadPool> pool;
+    ifc::InlineExecutor inline_executor;
+    if (options.jobs != 1)
+        pool.emplace(options.jobs);
+    ifc::Executor& executor = pool ? static_cast<ifc::Executor&>(*pool) : inline_executor;
+
+    const auto modules = reachable_modules(env, root, executor);
+    auto module_options = options;
+    module_options.jobs = 1;
+
+    std::vector<std::ostringstream> buffers(modules.size());
+    executor.run(modules.size(), [&](size_t i) {
+        auto const & file = *modules[i];
+        const auto name = ifc::peek_file(file.blob()).unit_name;
+        buffers[i] << "======================================== Module " << (name.empty() ? "<header unit>" : name)
+                   << " ========================================\n";
+        dump_ifc(file, module_options, &env, buffers[i]);
+    });
+
+    for (auto const & buffer : buffers)
+        std::cout << buffer.view();
+    std::cout << "Dumped " << modules.size() << " modules\n";
+}
+
+static constexpr std::string_view decl_sort_names[] = {
+    "VendorExtension", "Enumerator", "Variable", "Parameter", "Field", "Bitfield", "Scope", "Enumeration",
+    "Alias", "Temploid", "Template", "PartialSpecialization", "Specialization", "DefaultArgument", "Concept", "Function",
+    "Method", "Constructor", "InheritedConstructor", "Destructor", "Reference", "UsingDeclaration", "UsingDirective", "Friend",
+    "Expansion", "DeductionGuide", "Barren", "Tuple", "SyntaxTree", "Intrinsic", "Property", "OutputSegment",
+};
+
+static constexpr std::string_view type_sort_names[] = {
+    "VendorExtension", "Fundamental", "Designated", "Tor", "Syntactic", "Expansion", "Pointer", "PointerToMember",
+    "LvalueReference", "RvalueReference", "Function", "Method", "Array", "Typename", "Qualified", "Base",
+    "Decltype", "Placeholder", "Tuple", "Forall", "Unaligned", "SyntaxTree",
+};
+
+template<size_t N>
+static void print_histogram(std::span<size_t const> counts, std::string_view const (&names)[N])
+{
+    for (size_t sort = 0; sort != counts.size(); ++sort)
+    {
+        if (counts[sort] == 0)
+            continue;
+        std::cout << "  " << std::left << std::setw(24) << (sort < N ? names[sort] : std::to_string(sort))
+                  << std::right << std::setw(12) << counts[sort] << "\n";
+    }
+}
+
+// Sizes of the partitions from the table of contents, and sorts of the scope members and of the type heap
+// counted by tag scans, without reading anything else.
+static void dump_stats(ifc::File const& file)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    ifc::FileHeader const & header = file.header();
+    std::cout << "IFC Version: " << header.major_version << "." << header.minor_version << "\n"
+              << "String table: " << raw_count(header.string_table_size) << " bytes\n"
+              << "Partitions:\n";
+    size_t total_bytes = 0;
+    for (auto const & partition : file.table_of_contents())
+    {
+        std::cout << "  " << std::left << std::setw(32) << file.get_string(partition.name)
+                  << std::right << std::setw(12) << raw_count(partition.cardinality)
+                  << std::setw(14) << partition.size_bytes() << " bytes\n";
+        total_bytes += partition.size_bytes();
+    }
+    std::cout << "  " << std::left << std::setw(44) << "total" << std::right << std::setw(14) << total_bytes << " bytes\n";
+
+    if (file.has_partition("scope.member"))
+    {
+        std::array<size_t, ifc::DeclIndex::SortCount> counts{};
+        ifc::count_sorts(file.declarations(), std::span(counts));
+        std::cout << "Scope members per DeclSort:\n";
+        print_histogram(counts, decl_sort_names);
+    }
+
+    if (file.has_partition("heap.type"))
+    {
+        std::array<size_t, ifc::TypeIndex::SortCount> counts{};
+        ifc::count_sorts(file.type_heap(), std::span(counts));
+        std::cout << "Type heap per TypeSort:\n";
+        print_histogram(counts, type_sort_names);
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    std::cout << "Computed in " << elapsed.count() << " ms\n";
+}
+
+// Deprecated declarations with their messages, see reflifc::get_deprecations.
+static void dump_deprecations(ifc::File const& file)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    reflifc::NameArena arena;
+    const auto deprecations = reflifc::get_deprecations(reflifc::Module(&file), arena);
+    for (auto const & deprecation : deprecations)
+    {
+        std::cout << deprecation.qualified_name;
+        if (!deprecation.message.empty())
+            std::cout << ": " << deprecation.message;
+        std::cout << "\n";
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    std::cout << deprecations.size() << " deprecated declarations, listed in " << elapsed.count() << " ms\n";
+}
+
+static std::optional<unsigned> parse_jobs(std::string_view text)
+{
+    unsigned jobs;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), jobs);
+    if (error != std::errc() || end != text.data() + text.size())
+        return std::nullopt;
+    return jobs;
+}
+
+static std::vector<std::string_view> split_kinds(std::string_view text)
+{
+    std::vector<std::string_view> kinds;
+    while (!text.empty())
+    {
+        const auto comma = text.find(',');
+        kinds.push_back(text.substr(0, comma));
+        text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+    }
+    return kinds;
 }
 
 int main(int argc, char* argv[])
 {
-    if (argc != 2)
+    constexpr auto usage = "expected: [--jobs N] [--transitive] [--scope a::b::c] [--kind function,class...] [--name-glob pattern] | [--stats] | [--deprecations] path to .ifc file\n";
+
+    DumpOptions options;
+    int arg = 1;
+    for (; arg + 1 < argc; ++arg)
+    {
+        const std::string_view option = argv[arg];
+        if (option == "--stats")
+        {
+            options.stats = true;
+            continue;
+        }
+        if (option == "--deprecations")
+        {
+            options.deprecations = true;
+            continue;
+        }
+        if (option == "--transitive")
+        {
+            options.transitive = true;
+            continue;
+        }
+        if (arg + 2 >= argc)
+            break;
+
+        const std::string_view value = argv[++arg];
+        if (option == "--jobs")
+        {
+            const auto parsed = parse_jobs(value);
+            if (!parsed)
+            {
+                std::cerr << "expected: number of jobs after --jobs, got '" << value << "'\n";
+                return EXIT_FAILURE;
+            }
+            options.jobs = *parsed;
+        }
+        else if (option == "--scope")
+            options.scope = value;
+        else if (option == "--kind")
+            options.kinds = split_kinds(value);
+        else if (option == "--name-glob")
+            options.name_glob = value;
+        else
+        {
+            std::cerr << "unknown option '" << option << "'\n" << usage;
+            return EXIT_FAILURE;
+        }
+    }
+    const bool report = options.stats || options.deprecations;
+    // Scopes are looked up in the root module only, other modules may not have them.
+    if (arg + 1 != argc || (report && (options.filtered() || options.jobs != 1 || options.transitive)) || (options.stats && options.deprecations)
+        || (options.transitive && !options.scope.empty()))
     {
-        std::cerr << "expected: path to .ifc file\n";
+        std::cerr << usage;
         return EXIT_FAILURE;
     }
+    argv += arg - 1;
 
     const std::filesystem::path path_to_ifc = argv[1];
     if (!is_regular_file(path_to_ifc))
@@ -53,15 +409,33 @@ int main(int argc, char* argv[])
 
     try
     {
-        if (std::filesystem::is_regular_file(path_to_config))
+        if (options.stats)
+        {
+            auto blob = ifc::read_blob(path_to_ifc);
+            dump_stats(ifc::File(blob->view()));
+        }
+        else if (options.deprecations)
+        {
+            auto blob = ifc::read_blob(path_to_ifc);
+            dump_deprecations(ifc::File(blob->view()));
+        }
+        else if (std::filesystem::is_regular_file(path_to_config))
         {
             ifc::Environment env(ifc::read_msvc_config(path_to_config), ifc::read_blob);
-            dump_ifc(env.get_module_by_bmi_path(path_to_ifc), &env);
+            if (options.transitive)
+                dump_transitive(env, env.get_module_by_bmi_path(path_to_ifc), options);
+            else
+                dump_ifc(env.get_module_by_bmi_path(path_to_ifc), options, &env);
+        }
+        else if (options.transitive)
+        {
+            std::cerr << "--transitive needs the modules of " << path_to_config << "\n";
+            return EXIT_FAILURE;
         }
         else
         {
             auto blob = ifc::read_blob(path_to_ifc);
-            dump_ifc(ifc::File(blob->view()));
+            dump_ifc(ifc::File(blob->view()), options);
         }
         return EXIT_SUCCESS;
     }
@@ -0,0 +1,93 @@
+#include "ColumnExporter.h"
+
+#include <stdexcept>
+
+namespace
+{
+    void write_file(std::filesystem::path const& path, std::span<std::byte const> bytes)
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!out)
+            throw std::runtime_error("cannot write " + path.string());
+    }
+}
+
+ColumnExporter::ColumnExporter(ifc::File const& file, std::filesystem::path directory)
+    : file_(file)
+    , directory_(std::move(directory))
+{
+    std::filesystem::create_directories(directory_);
+    schema_ = "{\n  \"tables\": [";
+}
+
+int32_t ColumnExporter::dictionary_index(ifc::TextOffset text) const
+{
+    if (ifc::is_null(text))
+        return -1;
+    const auto symbol = file_.text_symbol(text);
+    return symbol ? static_cast<int32_t>(*symbol) : -1;
+}
+
+void ColumnExporter::begin_table(std::string_view name, size_t rows)
+{
+    table_directory_ = directory_ / name;
+    std::filesystem::create_directories(table_directory_);
+
+    if (schema_.back() == '}')
+        schema_ += ',';
+    schema_ += "\n    { \"name\": \"";
+    schema_ += name;
+    schema_ += "\", \"rows\": ";
+    schema_ += std::to_string(rows);
+    schema_ += ", \"columns\": [";
+    first_column_ = true;
+}
+
+void ColumnExporter::write_column(std::string_view name, std::string_view type, unsigned sort_bits, std::span<std::byte const> bytes)
+{
+    const auto file_name = std::string(name) + ".bin";
+    write_file(table_directory_ / file_name, bytes);
+
+    schema_ += first_column_ ? "\n" : ",\n";
+    schema_ += "        { \"name\": \"";
+    schema_ += name;
+    schema_ += "\", \"type\": \"";
+    schema_ += type;
+    schema_ += '"';
+    if (sort_bits != 0)
+    {
+        schema_ += ", \"sort_bits\": ";
+        schema_ += std::to_string(sort_bits);
+    }
+    schema_ += " }";
+    first_column_ = false;
+}
+
+void ColumnExporter::end_table()
+{
+    schema_ += first_column_ ? "] }" : "\n      ] }";
+}
+
+void ColumnExporter::finish()
+{
+    // Equal strings share a symbol, so the dictionary has each text once.
+    const auto count = file_.text_symbol_count();
+    std::vector<int32_t> offsets;
+    offsets.reserve(count + 1);
+    std::string data;
+    offsets.push_back(0);
+    for (uint32_t symbol = 0; symbol != count; ++symbol)
+    {
+        data += file_.get_string_view(file_.symbol_text(symbol));
+        offsets.push_back(static_cast<int32_t>(data.size()));
+    }
+    write_file(directory_ / "strings.offsets", std::as_bytes(std::span(offsets)));
+    write_file(directory_ / "strings.data", std::as_bytes(std::span(data)));
+
+    schema_ += "\n  ],\n  \"strings\": ";
+    schema_ += std::to_string(count);
+    schema_ += "\n}\n";
+    const auto schema = std::as_bytes(std::span(schema_));
+    write_file(directory_ / "schema.json", schema);
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "ifc/File.h"
+#include "ifc/Name.h"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Writes partitions of a file as columns, one raw little-endian buffer per column, laid out like
+// the data buffers of Arrow arrays, so that a loader wraps them without parsing (e.g. `pyarrow.Array.from_buffers`).
+//
+//   <dir>/strings.offsets, strings.data   the interned strings of the string table, as an Arrow `utf8` array:
+//                                         int32 offsets (count + 1 of them) and the bytes
+//   <dir>/<partition>/<column>.bin        one value per row
+//   <dir>/schema.json                     tables, their row counts and the type of each column
+//
+// Column types are `uint8`, `uint16`, `uint32` and `uint64`, `reference` for abstract references
+// (uint32 with the sort in the low `sort_bits` bits, the index in the others), and `dictionary`
+// for strings: int32 indices into the strings array, -1 for no string. Name columns are followed
+// by a `<name>_text` dictionary column for identifiers.
+class ColumnExporter
+{
+public:
+    ColumnExporter(ifc::File const& file, std::filesystem::path directory);
+
+    template<typename T, typename Index>
+    class Table
+    {
+    public:
+        Table(ColumnExporter & exporter, std::string_view name, ifc::Partition<T, Index> rows)
+            : exporter_(exporter)
+            , rows_(rows)
+        {
+            exporter_.begin_table(name, rows.size());
+        }
+
+        ~Table()
+        {
+            exporter_.end_table();
+        }
+
+        // `projection` is a member pointer or a callable giving the value of the column for a row.
+        template<typename Projection>
+        Table & column(std::string_view name, Projection projection)
+        {
+            using Value = std::remove_cvref_t<std::invoke_result_t<Projection, T const &>>;
+
+            if constexpr (std::is_same_v<Value, ifc::TextOffset>)
+            {
+                std::vector<int32_t> indices;
+                indices.reserve(rows_.size());
+                for (auto const & row : rows_)
+                    indices.push_back(exporter_.dictionary_index(std::invoke(projection, row)));
+                exporter_.write_column(name, "dictionary", 0, std::as_bytes(std::span(indices)));
+            }
+            else
+            {
+                static_assert(std::is_trivially_copyable_v<Value> && sizeof(Value) <= sizeof(uint64_t));
+                std::vector<std::byte> bytes(rows_.size() * sizeof(Value));
+                auto out = bytes.data();
+                for (auto const & row : rows_)
+                {
+                    const Value value = std::invoke(projection, row);
+                    std::memcpy(out, &value, sizeof(Value));
+                    out += sizeof(Value);
+                }
+                exporter_.write_column(name, column_type<Value>(), sort_bits<Value>(), bytes);
+            }
+
+            // Identifiers are the offset of their text, also exported as a dictionary column.
+            if constexpr (std::is_same_v<Value, ifc::NameIndex>)
+            {
+                column(std::string(name) + "_text", [&](T const & row) {
+                    const ifc::NameIndex value = std::invoke(projection, row);
+                    return value.sort() == ifc::NameSort::Identifier ? ifc::TextOffset{ value.index } : ifc::TextOffset{};
+                });
+            }
+            return *this;
+        }
+
+    private:
+        template<typename Value>
+        static constexpr bool is_reference = requires { Value::SortCount; };
+
+        template<typename Value>
+        static std::string_view column_type()
+        {
+            if constexpr (is_reference<Value>)
+                return "reference";
+            else if constexpr (sizeof(Value) == 1)
+                return "uint8";
+            else if constexpr (sizeof(Value) == 2)
+                return "uint16";
+            else if constexpr (sizeof(Value) == 4)
+                return "uint32";
+            else
+                return "uint64";
+        }
+
+        template<typename Value>
+        static unsigned sort_bits()
+        {
+            if constexpr (is_reference<Value>)
+                return static_cast<unsigned>(std::countr_zero(Value::SortCount));
+            else
+                return 0;
+        }
+
+        ColumnExporter & exporter_;
+        ifc::Partition<T, Index> rows_;
+    };
+
+    template<typename T, typename Index>
+    Table<T, Index> table(std::string_view name, ifc::Partition<T, Index> rows)
+    {
+        return { *this, name, rows };
+    }
+
+    // Only partitions present in the file are exported.
+    bool has_partition(std::string_view name) const { return file_.has_partition(name); }
+
+    // Writes the string table and the schema.
+    void finish();
+
+private:
+    int32_t dictionary_index(ifc::TextOffset) const;
+
+    void begin_table(std::string_view name, size_t rows);
+    void write_column(std::string_view name, std::string_view type, unsigned sort_bits, std::span<std::byte const> bytes);
+    void end_table();
+
+    ifc::File const& file_;
+    std::filesystem::path directory_;
+    std::filesystem::path table_directory_;
+    std::string schema_;
+    bool first_column_ = true;
+};
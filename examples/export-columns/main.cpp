@@ -0,0 +1,237 @@
+#include "ColumnExporter.h"
+
+#include "ifc/Declaration.h"
+#include "ifc/Name.h"
+#include "ifc/Type.h"
+#include "ifc/blob_reader.h"
+
+#include <filesystem>
+#include <iostream>
+
+static void export_declarations(ColumnExporter & exporter, ifc::File const& file)
+{
+    auto line = [](auto const& decl) { return decl.locus.line; };
+    auto column = [](auto const& decl) { return decl.locus.column; };
+
+    if (exporter.has_partition(ifc::ScopeDeclaration::PartitionName))
+        exporter.table(ifc::ScopeDeclaration::PartitionName, file.scope_declarations())
+            .column("name", &ifc::ScopeDeclaration::name)
+            .column("line", line)
+            .column("column", column)
+            .column("type", &ifc::ScopeDeclaration::type)
+            .column("base", &ifc::ScopeDeclaration::base)
+            .column("initializer", &ifc::ScopeDeclaration::initializer)
+            .column("home_scope", &ifc::ScopeDeclaration::home_scope)
+            .column("specifiers", &ifc::ScopeDeclaration::specifiers)
+            .column("access", &ifc::ScopeDeclaration::access);
+
+    // Partitions are only read when present, accessors of absent ones throw.
+    auto functions = [&]<typename Function>(ifc::Partition<Function, ifc::DeclIndex> (ifc::File::*partition)() const) {
+        if (exporter.has_partition(Function::PartitionName))
+            exporter.table(Function::PartitionName, (file.*partition)())
+                .column("name", &Function::name)
+                .column("line", line)
+                .column("column", column)
+                .column("type", &Function::type)
+                .column("home_scope", &Function::home_scope)
+                .column("chart", &Function::chart)
+                .column("traits", &Function::traits)
+                .column("specifiers", &Function::specifiers)
+                .column("access", &Function::access);
+    };
+    functions(&ifc::File::functions);
+    functions(&ifc::File::methods);
+
+    if (exporter.has_partition(ifc::VariableDeclaration::PartitionName))
+        exporter.table(ifc::VariableDeclaration::PartitionName, file.variables())
+            .column("name", &ifc::VariableDeclaration::name)
+            .column("line", line)
+            .column("column", column)
+            .column("type", &ifc::VariableDeclaration::type)
+            .column("home_scope", &ifc::VariableDeclaration::home_scope)
+            .column("initializer", &ifc::VariableDeclaration::initializer)
+            .column("traits", &ifc::VariableDeclaration::traits)
+            .column("specifiers", &ifc::VariableDeclaration::specifiers)
+            .column("access", &ifc::VariableDeclaration::access);
+
+    if (exporter.has_partition(ifc::FieldDeclaration::PartitionName))
+        exporter.table(ifc::FieldDeclaration::PartitionName, file.fields())
+            .column("name", &ifc::FieldDeclaration::name)
+            .column("line", line)
+            .column("column", column)
+            .column("type", &ifc::FieldDeclaration::type)
+            .column("home_scope", &ifc::FieldDeclaration::home_scope)
+            .column("traits", &ifc::FieldDeclaration::traits)
+            .column("access", &ifc::FieldDeclaration::access);
+
+    if (exporter.has_partition(ifc::Enumeration::PartitionName))
+        exporter.table(ifc::Enumeration::PartitionName, file.enumerations())
+            .column("name", &ifc::Enumeration::name)
+            .column("line", line)
+            .column("column", column)
+            .column("type", &ifc::Enumeration::type)
+            .column("base", &ifc::Enumeration::base)
+            .column("enumerators_start", [](ifc::Enumeration const& e) { return e.initializer.start; })
+            .column("enumerators_count", [](ifc::Enumeration const& e) { return e.initializer.cardinality; })
+            .column("home_scope", &ifc::Enumeration::home_scope)
+            .column("specifiers", &ifc::Enumeration::specifiers)
+            .column("access", &ifc::Enumeration::access);
+
+    if (exporter.has_partition(ifc::Enumerator::PartitionName))
+        exporter.table(ifc::Enumerator::PartitionName, file.enumerators())
+            .column("name", &ifc::Enumerator::name)
+            .column("type", &ifc::Enumerator::type)
+            .column("initializer", &ifc::Enumerator::initializer)
+            .column("access", &ifc::Enumerator::access);
+
+    if (exporter.has_partition(ifc::AliasDeclaration::PartitionName))
+        exporter.table(ifc::AliasDeclaration::PartitionName, file.alias_declarations())
+            .column("name", &ifc::AliasDeclaration::name)
+            .column("line", line)
+            .column("column", column)
+            .column("home_scope", &ifc::AliasDeclaration::home_scope)
+            .column("aliasee", &ifc::AliasDeclaration::aliasee)
+            .column("specifiers", &ifc::AliasDeclaration::specifiers)
+            .column("access", &ifc::AliasDeclaration::access);
+
+    if (exporter.has_partition(ifc::TemplateDeclaration::PartitionName))
+        exporter.table(ifc::TemplateDeclaration::PartitionName, file.template_declarations())
+            .column("name", &ifc::TemplateDeclaration::name)
+            .column("line", line)
+            .column("column", column)
+            .column("home_scope", &ifc::TemplateDeclaration::home_scope)
+            .column("chart", &ifc::TemplateDeclaration::chart)
+            .column("entity", [](ifc::TemplateDeclaration const& t) { return t.entity.decl; })
+            .column("type", &ifc::TemplateDeclaration::type)
+            .column("specifiers", &ifc::TemplateDeclaration::specifiers)
+            .column("access", &ifc::TemplateDeclaration::access);
+
+    if (exporter.has_partition(ifc::ParameterDeclaration::PartitionName))
+        exporter.table(ifc::ParameterDeclaration::PartitionName, file.parameters())
+            .column("name", &ifc::ParameterDeclaration::name)
+            .column("type", &ifc::ParameterDeclaration::type)
+            .column("level", &ifc::ParameterDeclaration::level)
+            .column("position", &ifc::ParameterDeclaration::position)
+            .column("sort", &ifc::ParameterDeclaration::sort);
+}
+
+static void export_types(ColumnExporter & exporter, ifc::File const& file)
+{
+    if (exporter.has_partition(ifc::FundamentalType::PartitionName))
+        exporter.table(ifc::FundamentalType::PartitionName, file.fundamental_types())
+            .column("basis", &ifc::FundamentalType::basis)
+            .column("precision", &ifc::FundamentalType::precision)
+            .column("sign", &ifc::FundamentalType::sign);
+
+    if (exporter.has_partition(ifc::DesignatedType::PartitionName))
+        exporter.table(ifc::DesignatedType::PartitionName, file.designated_types())
+            .column("decl", &ifc::DesignatedType::decl);
+
+    if (exporter.has_partition(ifc::PointerType::PartitionName))
+        exporter.table(ifc::PointerType::PartitionName, file.pointer_types())
+            .column("pointee", &ifc::PointerType::pointee);
+
+    if (exporter.has_partition(ifc::LvalueReference::PartitionName))
+        exporter.table(ifc::LvalueReference::PartitionName, file.lvalue_references())
+            .column("referee", &ifc::LvalueReference::referee);
+
+    if (exporter.has_partition(ifc::RvalueReference::PartitionName))
+        exporter.table(ifc::RvalueReference::PartitionName, file.rvalue_references())
+            .column("referee", &ifc::RvalueReference::referee);
+
+    if (exporter.has_partition(ifc::QualifiedType::PartitionName))
+        exporter.table(ifc::QualifiedType::PartitionName, file.qualified_types())
+            .column("unqualified", &ifc::QualifiedType::unqualified)
+            .column("qualifiers", &ifc::QualifiedType::qualifiers);
+
+    if (exporter.has_partition(ifc::FunctionType::PartitionName))
+        exporter.table(ifc::FunctionType::PartitionName, file.function_types())
+            .column("target", &ifc::FunctionType::target)
+            .column("source", &ifc::FunctionType::source)
+            .column("convention", &ifc::FunctionType::convention)
+            .column("traits", &ifc::FunctionType::traits);
+
+    if (exporter.has_partition(ifc::MethodType::PartitionName))
+        exporter.table(ifc::MethodType::PartitionName, file.method_types())
+            .column("target", &ifc::MethodType::target)
+            .column("source", &ifc::MethodType::source)
+            .column("scope", &ifc::MethodType::scope)
+            .column("convention", &ifc::MethodType::convention)
+            .column("traits", &ifc::MethodType::traits);
+
+    if (exporter.has_partition(ifc::TupleType::PartitionName))
+        exporter.table(ifc::TupleType::PartitionName, file.tuple_types())
+            .column("start", [](ifc::TupleType const& t) { return t.seq.start; })
+            .column("count", [](ifc::TupleType const& t) { return t.seq.cardinality; });
+
+    if (exporter.has_partition("heap.type"))
+        exporter.table("heap.type", file.type_heap())
+            .column("type", std::identity());
+}
+
+static void export_names(ColumnExporter & exporter, ifc::File const& file)
+{
+    if (exporter.has_partition(ifc::OperatorFunctionName::PartitionName))
+        exporter.table(ifc::OperatorFunctionName::PartitionName, file.operator_names())
+            .column("encoded", &ifc::OperatorFunctionName::encoded)
+            .column("operator", &ifc::OperatorFunctionName::operator_);
+
+    if (exporter.has_partition(ifc::ConversionFunctionName::PartitionName))
+        exporter.table(ifc::ConversionFunctionName::PartitionName, file.conversion_function_names())
+            .column("target", &ifc::ConversionFunctionName::target)
+            .column("encoded", &ifc::ConversionFunctionName::encoded);
+
+    if (exporter.has_partition(ifc::LiteralName::PartitionName))
+        exporter.table(ifc::LiteralName::PartitionName, file.literal_names())
+            .column("encoded", &ifc::LiteralName::encoded);
+
+    if (exporter.has_partition(ifc::TemplateName::PartitionName))
+        exporter.table(ifc::TemplateName::PartitionName, file.template_names())
+            .column("name", &ifc::TemplateName::name);
+
+    if (exporter.has_partition(ifc::SpecializationName::PartitionName))
+        exporter.table(ifc::SpecializationName::PartitionName, file.specialization_names())
+            .column("primary", &ifc::SpecializationName::primary)
+            .column("arguments", &ifc::SpecializationName::arguments);
+
+    // Scope indices start from 1, the row of scope i is i - 1.
+    const auto scopes = file.scope_descriptors();
+    if (exporter.has_partition("scope.desc"))
+        exporter.table("scope.desc", ifc::Partition<ifc::Sequence, ifc::ScopeIndex>(scopes.data(), scopes.size(), scopes.stride()))
+            .column("start", &ifc::Sequence::start)
+            .column("count", &ifc::Sequence::cardinality);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "expected: path to .ifc file, output directory\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path path_to_ifc = argv[1];
+    if (!is_regular_file(path_to_ifc))
+    {
+        std::cerr << path_to_ifc << " is not regular file\n";
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        auto blob = ifc::read_blob(path_to_ifc);
+        const ifc::File file(blob->view());
+
+        ColumnExporter exporter(file, argv[2]);
+        export_declarations(exporter, file);
+        export_types(exporter, file);
+        export_names(exporter, file);
+        exporter.finish();
+        return EXIT_SUCCESS;
+    }
+    catch (std::exception const & e)
+    {
+        std::cerr << e.what();
+        return EXIT_FAILURE;
+    }
+}
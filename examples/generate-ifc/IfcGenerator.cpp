@@ -0,0 +1,299 @@
+#include "IfcGenerator.h"
+
+#include "Sha256.h"
+
+#include "ifc/Attribute.h"
+#include "ifc/Declaration.h"
+#include "ifc/FileHeader.h"
+#include "ifc/Name.h"
+#include "ifc/Partition.h"
+#include "ifc/Trait.h"
+#include "ifc/Type.h"
+#include "ifc/Word.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    constexpr std::array<std::byte, 4> Signature{ std::byte{ 0x54 }, std::byte{ 0x51 }, std::byte{ 0x45 }, std::byte{ 0x1A } };
+
+    ifc::DeclIndex decl(ifc::DeclSort sort, size_t index)
+    {
+        return { .tag = static_cast<uint32_t>(sort), .index = static_cast<uint32_t>(index) };
+    }
+
+    ifc::TypeIndex type(ifc::TypeSort sort, size_t index)
+    {
+        return { .tag = static_cast<uint32_t>(sort), .index = static_cast<uint32_t>(index) };
+    }
+
+    ifc::NameIndex identifier(ifc::TextOffset text)
+    {
+        return { .tag = static_cast<uint32_t>(ifc::NameSort::Identifier), .index = static_cast<uint32_t>(text) };
+    }
+
+    // Fundamental types, by position in `type.fundamental`.
+    enum Fundamental : uint32_t
+    {
+        Void,
+        Int,
+        Double,
+        Char,
+        Bool,
+        NamespaceBasis,
+        StructBasis,
+        FundamentalCount,
+    };
+
+    class Builder
+    {
+    public:
+        Builder()
+        {
+            strings_.push_back('\0'); // Offset 0 is the null text.
+        }
+
+        ifc::TextOffset text(std::string_view text)
+        {
+            const auto offset = static_cast<uint32_t>(strings_.size());
+            strings_ += text;
+            strings_.push_back('\0');
+            return ifc::TextOffset{ offset };
+        }
+
+        template<typename T>
+        void partition(std::vector<T> const& entries, std::string_view name = T::PartitionName)
+        {
+            if (entries.empty())
+                return;
+            auto & partition = partitions_.emplace_back();
+            partition.summary.name = text(name);
+            partition.summary.cardinality = ifc::Cardinality{ static_cast<uint32_t>(entries.size()) };
+            partition.summary.entry_size = ifc::EntitySize{ static_cast<uint32_t>(sizeof(T)) };
+            partition.bytes.resize(entries.size() * sizeof(T));
+            std::memcpy(partition.bytes.data(), entries.data(), partition.bytes.size());
+        }
+
+        // Signature, header, string table, partitions and their summaries, without padding between them:
+        // `ifc::File` checks that the sizes add up to the size of the file.
+        std::vector<std::byte> finish(ifc::FileHeader header)
+        {
+            // Keeps the partitions 4-byte aligned, the padding belongs to the string table.
+            while (strings_.size() % 4 != 0)
+                strings_.push_back('\0');
+
+            size_t offset = Signature.size() + sizeof(ifc::FileHeader);
+            header.string_table_bytes = ifc::ByteOffset{ static_cast<uint32_t>(offset) };
+            header.string_table_size = ifc::Cardinality{ static_cast<uint32_t>(strings_.size()) };
+            offset += strings_.size();
+
+            std::vector<ifc::PartitionSummary> toc;
+            for (auto & partition : partitions_)
+            {
+                partition.summary.offset = ifc::ByteOffset{ static_cast<uint32_t>(offset) };
+                offset += partition.bytes.size();
+                toc.push_back(partition.summary);
+            }
+            header.toc = ifc::ByteOffset{ static_cast<uint32_t>(offset) };
+            header.partition_count = ifc::Cardinality{ static_cast<uint32_t>(toc.size()) };
+            offset += toc.size() * sizeof(ifc::PartitionSummary);
+
+            std::vector<std::byte> blob;
+            blob.reserve(offset);
+            auto append = [&blob](void const* data, size_t size) {
+                auto bytes = static_cast<std::byte const*>(data);
+                blob.insert(blob.end(), bytes, bytes + size);
+            };
+            append(Signature.data(), Signature.size());
+            append(&header, sizeof(header));
+            append(strings_.data(), strings_.size());
+            for (auto const & partition : partitions_)
+                append(partition.bytes.data(), partition.bytes.size());
+            append(toc.data(), toc.size() * sizeof(ifc::PartitionSummary));
+
+            // The checksum covers everything after itself.
+            const auto checksum = ifc::compute_sha256(std::span(blob).subspan(Signature.size() + sizeof(ifc::SHA256)));
+            std::memcpy(blob.data() + Signature.size() + offsetof(ifc::FileHeader, checksum), &checksum, sizeof(checksum));
+            return blob;
+        }
+
+    private:
+        struct Partition
+        {
+            ifc::PartitionSummary summary{};
+            std::vector<std::byte> bytes;
+        };
+
+        std::string strings_;
+        std::vector<Partition> partitions_;
+    };
+
+    struct Scope
+    {
+        uint32_t parent;  // Position of the parent scope + 1, 0 for the global one
+        bool is_struct;
+    };
+}
+
+std::vector<std::byte> generate_ifc(GeneratorOptions const& options)
+{
+    const uint32_t depth = std::max(options.depth, uint32_t{ 1 });
+    const uint32_t type_count = std::max(options.types, uint32_t{ 1 });
+
+    Builder builder;
+    const auto module_name = builder.text("synthetic");
+    const auto deprecated = builder.text("deprecated");
+
+    std::vector<ifc::FundamentalType> fundamentals(FundamentalCount);
+    fundamentals[Void].basis = ifc::TypeBasis::Void;
+    fundamentals[Int].basis = ifc::TypeBasis::Int;
+    fundamentals[Double].basis = ifc::TypeBasis::Double;
+    fundamentals[Char].basis = ifc::TypeBasis::Char;
+    fundamentals[Bool].basis = ifc::TypeBasis::Bool;
+    fundamentals[NamespaceBasis].basis = ifc::TypeBasis::Namespace;
+    fundamentals[StructBasis].basis = ifc::TypeBasis::Struct;
+    auto fundamental = [](Fundamental f) { return type(ifc::TypeSort::Fundamental, f); };
+
+    // `int*`, the type of every variable.
+    const std::vector<ifc::PointerType> pointers{ { fundamental(Int) } };
+
+    // Function type t takes t % 4 parameters, spelled by the next base-4 digits of t.
+    std::vector<ifc::FunctionType> function_types(type_count);
+    std::vector<ifc::TupleType> tuples;
+    std::vector<ifc::TypeIndex> type_heap;
+    for (uint32_t t = 0; t != type_count; ++t)
+    {
+        auto & function = function_types[t];
+        function.target = fundamental(t % 2 == 0 ? Void : Int);
+        const auto parameter_count = t % 4;
+        auto digits = t / 4;
+        std::array<ifc::TypeIndex, 3> parameters;
+        for (uint32_t p = 0; p != parameter_count; ++p, digits /= 4)
+            parameters[p] = fundamental(static_cast<Fundamental>(Int + digits % 4));
+        if (parameter_count == 1)
+        {
+            function.source = parameters[0];
+        }
+        else if (parameter_count > 1)
+        {
+            tuples.push_back({ { ifc::Index{ static_cast<uint32_t>(type_heap.size()) }, ifc::Cardinality{ parameter_count } } });
+            type_heap.insert(type_heap.end(), parameters.begin(), parameters.begin() + parameter_count);
+            function.source = type(ifc::TypeSort::Tuple, tuples.size() - 1);
+        }
+    }
+
+    std::vector<Scope> scopes(options.scopes);
+    for (uint32_t k = 0; k != options.scopes; ++k)
+    {
+        const auto level = k % depth;
+        scopes[k].parent = level == 0 ? 0 : k;
+        scopes[k].is_struct = level == depth - 1 && (k / depth) % 2 == 1;
+    }
+
+    // Members of the global scope (0) and of every generated scope (k + 1).
+    std::vector<std::vector<ifc::DeclIndex>> members(options.scopes + 1);
+    std::vector<ifc::ScopeDeclaration> scope_declarations(options.scopes);
+    for (uint32_t k = 0; k != options.scopes; ++k)
+    {
+        auto & scope = scope_declarations[k];
+        scope.name = identifier(builder.text((scopes[k].is_struct ? "S" : "n") + std::to_string(k)));
+        scope.type = fundamental(scopes[k].is_struct ? StructBasis : NamespaceBasis);
+        scope.initializer = ifc::ScopeIndex{ k + 2 };
+        if (scopes[k].parent != 0)
+            scope.home_scope = decl(ifc::DeclSort::Scope, scopes[k].parent - 1);
+        scope.access = scopes[k].is_struct ? ifc::Access::Public : ifc::Access::None;
+        members[scopes[k].parent].push_back(decl(ifc::DeclSort::Scope, k));
+    }
+
+    std::vector<ifc::FunctionDeclaration> functions;
+    std::vector<ifc::VariableDeclaration> variables;
+    std::vector<ifc::FieldDeclaration> fields;
+    std::vector<ifc::AssociatedTrait<ifc::AttrIndex>> attributes;
+    const ifc::AttrIndex deprecated_attribute{ .tag = static_cast<uint32_t>(ifc::AttrSort::Basic), .index = 0 };
+    for (uint32_t j = 0; j != options.declarations; ++j)
+    {
+        const auto container = j % (options.scopes + 1);
+        const auto home_scope = container == 0 ? ifc::DeclIndex{} : decl(ifc::DeclSort::Scope, container - 1);
+        const ifc::SourceLocation locus{ ifc::LineIndex{ j + 1 }, ifc::Column{ 1 } };
+
+        ifc::DeclIndex member;
+        if (container != 0 && scopes[container - 1].is_struct)
+        {
+            auto & field = fields.emplace_back();
+            field.name = builder.text("m" + std::to_string(j));
+            field.locus = locus;
+            field.type = fundamental(j % 2 == 0 ? Int : Double);
+            field.home_scope = home_scope;
+            field.access = ifc::Access::Public;
+            member = decl(ifc::DeclSort::Field, fields.size() - 1);
+        }
+        else if ((j / (options.scopes + 1)) % 2 == 0)
+        {
+            auto & function = functions.emplace_back();
+            function.name = identifier(builder.text("f" + std::to_string(j)));
+            function.locus = locus;
+            function.type = type(ifc::TypeSort::Function, j % type_count);
+            function.home_scope = home_scope;
+            member = decl(ifc::DeclSort::Function, functions.size() - 1);
+        }
+        else
+        {
+            auto & variable = variables.emplace_back();
+            variable.name = identifier(builder.text("v" + std::to_string(j)));
+            variable.locus = locus;
+            variable.type = type(ifc::TypeSort::Pointer, 0);
+            variable.home_scope = home_scope;
+            member = decl(ifc::DeclSort::Variable, variables.size() - 1);
+        }
+        members[container].push_back(member);
+
+        if (member.sort() != ifc::DeclSort::Field && attributes.size() < options.attributes)
+            attributes.push_back({ member, deprecated_attribute });
+    }
+
+    std::vector<ifc::Declaration> scope_members;
+    std::vector<ifc::Sequence> scope_descriptors;
+    for (auto const & scope : members)
+    {
+        scope_descriptors.push_back({ ifc::Index{ static_cast<uint32_t>(scope_members.size()) }, ifc::Cardinality{ static_cast<uint32_t>(scope.size()) } });
+        for (auto member : scope)
+            scope_members.push_back({ member });
+    }
+
+    std::vector<ifc::AttrBasic> basic_attributes;
+    if (!attributes.empty())
+    {
+        auto & attribute = basic_attributes.emplace_back();
+        attribute.word.index = static_cast<ifc::Index>(deprecated);
+        attribute.word.value = static_cast<uint16_t>(ifc::SourceIdentifier::Plain);
+        attribute.word.sort = ifc::WordSort::Identifier;
+    }
+
+    builder.partition(scope_members);
+    builder.partition(scope_descriptors, "scope.desc");
+    builder.partition(scope_declarations);
+    builder.partition(functions);
+    builder.partition(variables);
+    builder.partition(fields);
+    builder.partition(fundamentals);
+    builder.partition(pointers);
+    builder.partition(function_types);
+    builder.partition(tuples);
+    builder.partition(type_heap, "heap.type");
+    builder.partition(basic_attributes);
+    builder.partition(attributes, ".msvc.trait.decl-attrs");
+
+    ifc::FileHeader header{};
+    header.major_version = ifc::Version{ 0 };
+    header.minor_version = ifc::Version{ 43 };
+    header.arch = ifc::Architecture::X64;
+    header.unit = { .tag = static_cast<uint32_t>(ifc::UnitSort::Primary), .index = static_cast<uint32_t>(module_name) };
+    header.src_path = builder.text("synthetic.ixx");
+    header.global_scope = ifc::ScopeIndex{ 1 };
+    return builder.finish(header);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Shape of a synthetic module, see generate_ifc.
+struct GeneratorOptions
+{
+    // Functions and variables in namespaces, fields in structs, besides the scope declarations themselves.
+    uint32_t declarations = 1000;
+
+    // Namespaces and structs, nested in chains of `depth` scopes below the global one. The innermost scope
+    // of every other chain is a struct.
+    uint32_t scopes = 16;
+
+    // Function types, with 0 to 3 parameters of fundamental types each.
+    uint32_t types = 16;
+
+    uint32_t depth = 1;
+
+    // Number of functions and variables marked `[[deprecated]]`.
+    uint32_t attributes = 0;
+};
+
+// Contents of an .ifc file of a primary module interface `synthetic`: declarations are spread round-robin
+// over the global scope and the generated scopes. Only the partitions the declarations need are written,
+// with the layout (signature, header, string table, partitions, table of contents) and the checksum
+// `ifc::File` checks.
+std::vector<std::byte> generate_ifc(GeneratorOptions const&);
@@ -0,0 +1,63 @@
+#include "IfcGenerator.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+static bool parse_count(std::string_view text, uint32_t & count)
+{
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), count);
+    return error == std::errc() && end == text.data() + text.size();
+}
+
+int main(int argc, char* argv[])
+{
+    GeneratorOptions options;
+    const std::pair<std::string_view, uint32_t GeneratorOptions::*> flags[] = {
+        { "--declarations", &GeneratorOptions::declarations },
+        { "--scopes",       &GeneratorOptions::scopes },
+        { "--types",        &GeneratorOptions::types },
+        { "--depth",        &GeneratorOptions::depth },
+        { "--attributes",   &GeneratorOptions::attributes },
+    };
+
+    int arg = 1;
+    for (; arg + 1 < argc; arg += 2)
+    {
+        const auto flag = std::ranges::find(flags, std::string_view(argv[arg]), &std::pair<std::string_view, uint32_t GeneratorOptions::*>::first);
+        if (flag == std::end(flags))
+            break;
+        if (!parse_count(argv[arg + 1], options.*flag->second))
+        {
+            std::cerr << "expected: a count after " << argv[arg] << ", got '" << argv[arg + 1] << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (arg + 1 != argc)
+    {
+        std::cerr << "expected: [--declarations N] [--scopes N] [--types N] [--depth N] [--attributes N] path to the .ifc file to write\n";
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        const auto blob = generate_ifc(options);
+        const std::filesystem::path path = argv[arg];
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<char const*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        if (!out)
+        {
+            std::cerr << "cannot write " << path << "\n";
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+    catch (std::exception const & e)
+    {
+        std::cerr << e.what();
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,390 @@
+#include "ifc/Environment.h"
+#include "ifc/FileWatcher.h"
+#include "ifc/MSVCEnvironment.h"
+#include "ifc/Parallel.h"
+#include "ifc/blob_reader.h"
+#include "reflifc/AbiDiff.h"
+#include "reflifc/Layout.h"
+#include "reflifc/Module.h"
+#include "reflifc/TypeRenderer.h"
+#include "reflifc/index/AttributeIndex.h"
+#include "reflifc/index/ParentIndex.h"
+
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Generates a header `<output>/<class>.g.h` describing the data members of every exported class of the BMIs
+// that carries an attribute (`codegen::reflect` by default), as a specialization of `codegen::fields`.
+// Classes are found through reflifc::AttributeIndex and their members through reflifc::extract_layouts.
+//
+// Generation is incremental: the manifest `<output>/<BMI file name>.codegen` keeps the reflifc::fingerprint_abi
+// fingerprint each header was generated from, and only the headers of classes whose fingerprint changed are
+// written again, those of classes that lost the attribute are removed. Modules are processed in parallel.
+// With `--watch` the BMIs are then watched (see ifc::FileWatcher) and reloaded as they are rebuilt: modules
+// whose reload reports an identical BMI are skipped without being read.
+
+struct CodegenOptions
+{
+    std::string attribute = "codegen::reflect";
+    // On a pool of that many threads (0 for one per hardware thread) instead of ifc::default_executor.
+    std::optional<unsigned> jobs;
+    bool watch = false;
+    std::filesystem::path output;
+    std::vector<std::filesystem::path> bmis;
+};
+
+// Header generated for a class, by the reflifc::AbiFingerprints key of the class.
+struct Generated
+{
+    uint64_t fingerprint;
+    std::string file_name;
+};
+
+using Manifest = std::unordered_map<uint64_t, Generated>;
+
+struct ModuleResult
+{
+    size_t generated = 0;
+    size_t unchanged = 0;
+    size_t removed = 0;
+    bool skipped = false; // The reload reported an identical BMI
+    std::string error;
+};
+
+static std::optional<unsigned> parse_jobs(std::string_view text)
+{
+    unsigned jobs;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), jobs);
+    if (error != std::errc() || end != text.data() + text.size())
+        return std::nullopt;
+    return jobs;
+}
+
+// Written aside and renamed into place, so a build never includes a partial header.
+static void write_file(std::filesystem::path const& path, std::string_view contents)
+{
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        if (!out.flush())
+            throw std::runtime_error("cannot write " + temporary.string());
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+static std::filesystem::path manifest_path(CodegenOptions const& options, std::filesystem::path const& bmi)
+{
+    return options.output / (bmi.filename().string() + ".codegen");
+}
+
+// One "<key> <fingerprint> <file name>" line per generated header, a missing manifest is empty.
+static Manifest read_manifest(std::filesystem::path const& path)
+{
+    Manifest manifest;
+    std::ifstream in(path);
+    uint64_t key;
+    Generated generated;
+    while (in >> std::hex >> key >> generated.fingerprint >> generated.file_name)
+        manifest.insert_or_assign(key, generated);
+    return manifest;
+}
+
+static void write_manifest(std::filesystem::path const& path, Manifest const& manifest)
+{
+    std::ostringstream out;
+    out << std::hex;
+    for (auto const & [key, generated] : manifest)
+        out << key << ' ' << generated.fingerprint << ' ' << generated.file_name << '\n';
+    write_file(path, out.view());
+}
+
+// `ns::Point` is generated into `ns.Point.g.h`, characters other than letters and digits become '_'.
+static std::string header_name(std::string_view qualified_name)
+{
+    std::string result;
+    for (size_t i = 0; i != qualified_name.size(); ++i)
+    {
+        if (qualified_name.substr(i, 2) == "::")
+        {
+            result += '.';
+            ++i;
+        }
+        else
+        {
+            const auto c = qualified_name[i];
+            result += (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ? c : '_';
+        }
+    }
+    return result + ".g.h";
+}
+
+// Expects the class to be declared where the header is included, e.g. after importing its module.
+static std::string generate_header(ifc::File const& file, reflifc::ClassLayouts const& layouts, size_t i,
+                                   std::string_view qualified_name, std::string_view source, reflifc::TypeRenderer& renderer)
+{
+    std::string out;
+    out += "// Generated by ifc-codegen from ";
+    out += source;
+    out += ", do not edit.\n#pragma once\n\n#include <cstddef>\n#include <string_view>\n\nnamespace codegen\n{\n"
+           "    template<typename T>\n    struct fields;\n\n    template<>\n    struct fields<";
+    out += qualified_name;
+    out += ">\n    {\n";
+
+    const auto first = layouts.member_offsets[i];
+    const auto count = layouts.member_offsets[i + 1] - first;
+    out += "        static constexpr std::size_t size = " + std::to_string(count) + ";\n";
+    if (count != 0)
+    {
+        out += "        static constexpr std::string_view names[] = {";
+        for (auto member = first; member != first + count; ++member)
+        {
+            out += member == first ? " \"" : ", \"";
+            out += file.get_string(layouts.names[member]);
+            out += '"';
+        }
+        out += " };\n        static constexpr std::string_view types[] = {";
+        for (auto member = first; member != first + count; ++member)
+        {
+            out += member == first ? " \"" : ", \"";
+            out += renderer.spelling(layouts.types[member]);
+            out += '"';
+        }
+        out += " };\n";
+    }
+    out += "    };\n}\n";
+    return out;
+}
+
+static ModuleResult generate_module(ifc::Environment& env, ifc::File const& file, std::filesystem::path const& bmi, CodegenOptions const& options)
+{
+    ModuleResult result;
+    const auto path = manifest_path(options, bmi);
+    const auto previous = read_manifest(path);
+    Manifest manifest;
+
+    // In DeclIndex order.
+    const auto annotated = file.get_index<reflifc::AttributeIndex>().find(file, options.attribute);
+    if (!annotated.empty())
+    {
+        const reflifc::Module module(&file);
+        const auto fingerprints = reflifc::fingerprint_abi(module, &env);
+
+        // Layouts and spellings are only computed once a class needs its header generated.
+        std::optional<reflifc::ClassLayouts> layouts;
+        std::optional<reflifc::TypeRenderer> renderer;
+        auto const & parents = file.get_index<reflifc::ParentIndex>();
+        std::string name_buffer;
+
+        for (size_t entry = 0; entry != fingerprints.size(); ++entry)
+        {
+            const auto decl = fingerprints.decls[entry];
+            if (!std::ranges::binary_search(annotated, decl))
+                continue;
+
+            const auto key = fingerprints.keys[entry];
+            const auto fingerprint = fingerprints.fingerprints[entry];
+            if (auto it = previous.find(key); it != previous.end() && it->second.fingerprint == fingerprint
+                && std::filesystem::exists(options.output / it->second.file_name))
+            {
+                manifest.insert_or_assign(key, it->second);
+                ++result.unchanged;
+                continue;
+            }
+
+            if (!layouts)
+                layouts = reflifc::extract_layouts(module);
+            const auto layout = std::ranges::find(layouts->classes, decl);
+            if (layout == layouts->classes.end())
+                continue; // Not a complete class
+
+            if (!renderer)
+                renderer.emplace(file, &env);
+            const auto qualified_name = parents.qualified_name(file, decl, name_buffer);
+            Generated generated{ fingerprint, header_name(qualified_name) };
+            write_file(options.output / generated.file_name,
+                       generate_header(file, *layouts, static_cast<size_t>(layout - layouts->classes.begin()), qualified_name, bmi.filename().string(), *renderer));
+            manifest.insert_or_assign(key, std::move(generated));
+            ++result.generated;
+        }
+    }
+
+    for (auto const & [key, generated] : previous)
+    {
+        if (manifest.contains(key))
+            continue;
+        std::error_code error;
+        if (std::filesystem::remove(options.output / generated.file_name, error))
+            ++result.removed;
+    }
+
+    if (result.generated != 0 || result.removed != 0 || manifest.size() != previous.size())
+        write_manifest(path, manifest);
+    return result;
+}
+
+static void report(std::filesystem::path const& bmi, ModuleResult const& result)
+{
+    if (!result.error.empty())
+        std::cerr << bmi.string() << ": " << result.error << "\n";
+    else if (result.skipped)
+        std::cout << bmi.string() << ": unchanged\n";
+    else
+        std::cout << bmi.string() << ": " << result.generated << " generated, " << result.unchanged << " unchanged, " << result.removed << " removed\n";
+}
+
+// Runs `generate(i)` for every module in parallel, each failure is reported with its module.
+template<typename Generate>
+static bool run_modules(std::span<std::filesystem::path const> bmis, ifc::Executor& executor, Generate generate)
+{
+    std::vector<ModuleResult> results(bmis.size());
+    executor.run(bmis.size(), [&](size_t i) {
+        try
+        {
+            results[i] = generate(i);
+        }
+        catch (std::exception const & e)
+        {
+            results[i].error = e.what();
+        }
+    });
+
+    bool failed = false;
+    for (size_t i = 0; i != bmis.size(); ++i)
+    {
+        report(bmis[i], results[i]);
+        failed = failed || !results[i].error.empty();
+    }
+    std::cout.flush();
+    return !failed;
+}
+
+// Regenerates the modules of the BMIs reported changed, in batches of the changes reported meanwhile.
+// A BMI caught while being rewritten fails to reload and is retried on its next change.
+[[noreturn]] static void watch(ifc::Environment& env, CodegenOptions const& options, ifc::Executor& executor)
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::filesystem::path> changes;
+    ifc::FileWatcher watcher([&](std::filesystem::path const& path) {
+        std::scoped_lock lock(mutex);
+        changes.push_back(path);
+        changed.notify_one();
+    });
+    for (auto const & bmi : options.bmis)
+        watcher.watch(bmi);
+
+    for (;;)
+    {
+        std::vector<std::filesystem::path> batch;
+        {
+            std::unique_lock lock(mutex);
+            changed.wait(lock, [&changes] { return !changes.empty(); });
+            batch.swap(changes);
+        }
+        std::ranges::sort(batch);
+        const auto [last, end] = std::ranges::unique(batch);
+        batch.erase(last, end);
+
+        run_modules(batch, executor, [&](size_t i) {
+            const auto reload = env.reload_module_by_bmi_path(batch[i]);
+            if (reload.reloaded && reload.diff.identical)
+                return ModuleResult{ .skipped = true };
+            return generate_module(env, *reload.module, batch[i], options);
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    constexpr auto usage = "expected: [--attribute name] [--jobs N] [--watch] output directory, paths to .ifc files\n";
+
+    CodegenOptions options;
+    int arg = 1;
+    for (; arg < argc; ++arg)
+    {
+        const std::string_view option = argv[arg];
+        if (!option.starts_with("--"))
+            break;
+        if (option == "--watch")
+        {
+            options.watch = true;
+            continue;
+        }
+        if (arg + 1 == argc)
+        {
+            std::cerr << usage;
+            return EXIT_FAILURE;
+        }
+
+        const std::string_view value = argv[++arg];
+        if (option == "--attribute")
+            options.attribute = value;
+        else if (option == "--jobs")
+        {
+            options.jobs = parse_jobs(value);
+            if (!options.jobs)
+            {
+                std::cerr << "expected: number of jobs after --jobs, got '" << value << "'\n";
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            std::cerr << "unknown option '" << option << "'\n" << usage;
+            return EXIT_FAILURE;
+        }
+    }
+    if (argc - arg < 2)
+    {
+        std::cerr << usage;
+        return EXIT_FAILURE;
+    }
+    options.output = argv[arg++];
+    for (; arg < argc; ++arg)
+        options.bmis.emplace_back(argv[arg]);
+
+    try
+    {
+        std::filesystem::create_directories(options.output);
+
+        // Imported modules are found through the `<file>.d.json` configs next to the BMIs, when there are any.
+        std::vector<std::string> configs;
+        for (auto const & bmi : options.bmis)
+        {
+            auto config = bmi.string() + ".d.json";
+            if (std::filesystem::exists(config))
+                configs.push_back(std::move(config));
+        }
+        ifc::Environment env(ifc::read_msvc_configs(configs), ifc::read_blob);
+
+        std::optional<ifc::ThreadPool> pool;
+        if (options.jobs)
+            pool.emplace(*options.jobs);
+        ifc::Executor& executor = pool ? *pool : ifc::default_executor();
+
+        const bool succeeded = run_modules(options.bmis, executor, [&](size_t i) {
+            return generate_module(env, env.get_module_by_bmi_path(options.bmis[i]), options.bmis[i], options);
+        });
+        if (options.watch)
+            watch(env, options, executor);
+        return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (std::exception const & e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
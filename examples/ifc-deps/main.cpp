@@ -0,0 +1,313 @@
+#include "ifc/File.h"
+#include "ifc/Parallel.h"
+#include "ifc/blob_reader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Prints the unit name, imported modules and exported modules of every BMI given, for build systems to order
+// their compilations by, without opening the BMIs as ifc::File: only the header, the table of contents, the module
+// reference partitions and their strings are read (see ifc::peek_file), the BMIs many at once (see
+// ifc::read_blobs) and peeked in parallel.
+//
+// `--format json` (the default) prints an array of {"bmi", "unit", "imports", "exports"} objects.
+// `--format make` prints a rule `<bmi>: <bmis of its imports and exports>` per BMI, `--format ninja` a dyndep file
+// with a build statement `build <bmi>: dyndep | <bmis of its imports and exports>` per BMI. Both only list the
+// dependencies among the BMIs given, those of the other units are left out. A name provided by several of them
+// (e.g. by BMIs of different configurations) is taken from the first one in path order.
+
+enum class Format
+{
+    Json,
+    Make,
+    Ninja,
+};
+
+struct DepsOptions
+{
+    Format format = Format::Json;
+    // On a pool of that many threads (0 for one per hardware thread) instead of ifc::default_executor.
+    std::optional<unsigned> jobs;
+    std::vector<std::filesystem::path> paths;
+};
+
+struct Unit
+{
+    std::string name; // Empty for other units
+    std::vector<std::string> imports;
+    std::vector<std::string> exports;
+    std::string error;
+};
+
+static std::optional<unsigned> parse_jobs(std::string_view text)
+{
+    unsigned jobs;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), jobs);
+    if (error != std::errc() || end != text.data() + text.size())
+        return std::nullopt;
+    return jobs;
+}
+
+static std::optional<Format> parse_format(std::string_view text)
+{
+    if (text == "json")
+        return Format::Json;
+    if (text == "make")
+        return Format::Make;
+    if (text == "ninja")
+        return Format::Ninja;
+    return std::nullopt;
+}
+
+// The `.ifc` files of the directories, recursively, and the other paths as given.
+static std::vector<std::filesystem::path> collect_bmis(std::vector<std::filesystem::path> const& paths)
+{
+    std::vector<std::filesystem::path> result;
+    for (auto const & path : paths)
+    {
+        if (!std::filesystem::is_directory(path))
+        {
+            result.push_back(path);
+            continue;
+        }
+        for (auto const & entry : std::filesystem::recursive_directory_iterator(path))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".ifc")
+                result.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(result);
+    const auto [last, end] = std::ranges::unique(result);
+    result.erase(last, end);
+    return result;
+}
+
+static void append_json_string(std::string& out, std::string_view text)
+{
+    constexpr char hex[] = "0123456789abcdef";
+    out += '"';
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            out += "\\u00";
+            out += hex[(c >> 4) & 0xf];
+            out += hex[c & 0xf];
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+static void append_json_strings(std::string& out, std::vector<std::string> const& texts)
+{
+    out += '[';
+    for (size_t i = 0; i != texts.size(); ++i)
+    {
+        if (i != 0)
+            out += ',';
+        append_json_string(out, texts[i]);
+    }
+    out += ']';
+}
+
+// Escaped for Make (`\` before spaces, `#` and `:`, `$$`) or Ninja (`$` before spaces, `$` and `:`).
+static void append_path(std::string& out, std::string_view path, Format format)
+{
+    for (char c : path)
+    {
+        if (format == Format::Ninja && (c == ' ' || c == '$' || c == ':'))
+            out += '$';
+        else if (format == Format::Make && (c == ' ' || c == '#' || c == ':'))
+            out += '\\';
+        else if (format == Format::Make && c == '$')
+            out += '$';
+        out += c;
+    }
+}
+
+static std::string format_output(std::vector<std::filesystem::path> const& bmis, std::vector<Unit> const& units, Format format)
+{
+    std::string out;
+    if (format == Format::Json)
+    {
+        out += "[\n";
+        for (size_t i = 0; i != bmis.size(); ++i)
+        {
+            out += "{\"bmi\":";
+            append_json_string(out, bmis[i].string());
+            out += ",\"unit\":";
+            append_json_string(out, units[i].name);
+            out += ",\"imports\":";
+            append_json_strings(out, units[i].imports);
+            out += ",\"exports\":";
+            append_json_strings(out, units[i].exports);
+            out += i + 1 != bmis.size() ? "},\n" : "}\n";
+        }
+        out += "]\n";
+        return out;
+    }
+
+    // The first BMI of a name provides it.
+    std::unordered_map<std::string_view, size_t> providers;
+    for (size_t i = 0; i != units.size(); ++i)
+    {
+        if (!units[i].name.empty())
+            providers.try_emplace(units[i].name, i);
+    }
+
+    if (format == Format::Ninja)
+        out += "ninja_dyndep_version = 1\n";
+    std::vector<size_t> dependencies;
+    for (size_t i = 0; i != bmis.size(); ++i)
+    {
+        dependencies.clear();
+        for (auto const * names : { &units[i].imports, &units[i].exports })
+        {
+            for (auto const & name : *names)
+            {
+                if (auto found = providers.find(name); found != providers.end() && found->second != i)
+                    dependencies.push_back(found->second);
+            }
+        }
+        std::ranges::sort(dependencies);
+        const auto [last, end] = std::ranges::unique(dependencies);
+        dependencies.erase(last, end);
+
+        if (format == Format::Ninja)
+            out += "build ";
+        append_path(out, bmis[i].string(), format);
+        out += format == Format::Ninja ? ": dyndep" : ":";
+        if (format == Format::Ninja && !dependencies.empty())
+            out += " |";
+        for (auto dependency : dependencies)
+        {
+            out += ' ';
+            append_path(out, bmis[dependency].string(), format);
+        }
+        out += '\n';
+    }
+    return out;
+}
+
+int main(int argc, char* argv[])
+{
+    constexpr auto usage = "expected: [--format json|make|ninja] [--jobs N] directories or paths to .ifc files\n";
+
+    DepsOptions options;
+    for (int arg = 1; arg != argc; ++arg)
+    {
+        const std::string_view option = argv[arg];
+        if (option == "--format")
+        {
+            const auto parsed = arg + 1 != argc ? parse_format(argv[++arg]) : std::nullopt;
+            if (!parsed)
+            {
+                std::cerr << "expected: json, make or ninja after --format\n";
+                return EXIT_FAILURE;
+            }
+            options.format = *parsed;
+        }
+        else if (option == "--jobs")
+        {
+            const auto parsed = arg + 1 != argc ? parse_jobs(argv[++arg]) : std::nullopt;
+            if (!parsed)
+            {
+                std::cerr << "expected: number of jobs after --jobs\n";
+                return EXIT_FAILURE;
+            }
+            options.jobs = *parsed;
+        }
+        else if (option.starts_with("--"))
+        {
+            std::cerr << "unknown option '" << option << "'\n" << usage;
+            return EXIT_FAILURE;
+        }
+        else
+        {
+            options.paths.emplace_back(option);
+        }
+    }
+    if (options.paths.empty())
+    {
+        std::cerr << usage;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::filesystem::path> bmis;
+    try
+    {
+        bmis = collect_bmis(options.paths);
+    }
+    catch (std::exception const & e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    // Mapped without read-ahead, only a few pages of each BMI are touched.
+    std::vector<ifc::Environment::BlobHolderPtr> blobs(bmis.size());
+    std::vector<Unit> units(bmis.size());
+    ifc::read_blobs(bmis, [&](ifc::BatchReadResult result) {
+        if (result.error)
+        {
+            try
+            {
+                std::rethrow_exception(result.error);
+            }
+            catch (std::exception const & e)
+            {
+                units[result.index].error = e.what();
+            }
+        }
+        blobs[result.index] = std::move(result.blob);
+    }, { .blob = { .access = ifc::BlobAccess::Random } });
+
+    std::optional<ifc::ThreadPool> pool;
+    if (options.jobs)
+        pool.emplace(*options.jobs);
+    ifc::Executor& executor = pool ? *pool : ifc::default_executor();
+    executor.run(bmis.size(), [&](size_t i) {
+        if (!blobs[i])
+            return;
+        try
+        {
+            auto peek = ifc::peek_file(blobs[i]->view());
+            units[i].name = peek.unit_name;
+            units[i].imports = std::move(peek.imported_modules);
+            units[i].exports = std::move(peek.exported_modules);
+        }
+        catch (std::exception const & e)
+        {
+            units[i].error = e.what();
+        }
+        blobs[i].reset();
+    });
+
+    bool failed = false;
+    for (size_t i = 0; i != bmis.size(); ++i)
+    {
+        if (units[i].error.empty())
+            continue;
+        failed = true;
+        std::cerr << bmis[i].string() << ": " << units[i].error << "\n";
+    }
+
+    std::cout << format_output(bmis, units, options.format);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
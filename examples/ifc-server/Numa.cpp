@@ -0,0 +1,103 @@
+#include "Numa.h"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace numa
+{
+    namespace
+    {
+        // A list like `0-3,8,10-11`.
+        std::vector<unsigned> parse_cpu_list(std::string_view list)
+        {
+            std::vector<unsigned> cpus;
+            while (!list.empty())
+            {
+                const auto comma = list.find(',');
+                const auto range = list.substr(0, comma);
+                list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+
+                unsigned first = 0, last = 0;
+                const auto [end, error] = std::from_chars(range.data(), range.data() + range.size(), first);
+                if (error != std::errc{})
+                    continue;
+                last = first;
+                if (end != range.data() + range.size() && *end == '-')
+                    std::from_chars(end + 1, range.data() + range.size(), last);
+                for (auto cpu = first; cpu <= last; ++cpu)
+                    cpus.push_back(cpu);
+            }
+            return cpus;
+        }
+    }
+
+    std::vector<std::vector<unsigned>> nodes()
+    {
+        std::vector<std::vector<unsigned>> result;
+#ifdef __linux__
+        const std::filesystem::path root = "/sys/devices/system/node";
+        for (unsigned node = 0;; ++node)
+        {
+            std::ifstream file(root / ("node" + std::to_string(node)) / "cpulist");
+            if (!file)
+                break;
+            std::string list;
+            std::getline(file, list);
+            if (auto cpus = parse_cpu_list(list); !cpus.empty())
+                result.push_back(std::move(cpus));
+        }
+#endif
+        if (result.empty())
+            result.emplace_back();
+        return result;
+    }
+
+    void pin_thread(std::span<unsigned const> cpus)
+    {
+#ifdef __linux__
+        if (cpus.empty())
+            return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (auto cpu : cpus)
+        {
+            if (cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+        }
+        // Best effort, e.g. CPUs outside of the cgroup of the process are refused.
+        sched_setaffinity(0, sizeof(set), &set);
+#else
+        (void)cpus;
+#endif
+    }
+
+    void interleave_thread_memory(bool interleave)
+    {
+#ifdef __linux__
+        // All the nodes that have memory, see set_mempolicy(2); without libnuma, which is not always installed.
+        unsigned long mask = 0;
+        for (unsigned node = 0; node != sizeof(mask) * 8; ++node)
+        {
+            if (std::filesystem::exists("/sys/devices/system/node/node" + std::to_string(node)))
+                mask |= 1ul << node;
+        }
+        if (interleave)
+            syscall(SYS_set_mempolicy, MPOL_INTERLEAVE, &mask, sizeof(mask) * 8);
+        else
+            syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+#else
+        (void)interleave;
+#endif
+    }
+}
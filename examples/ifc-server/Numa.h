@@ -0,0 +1,19 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+// NUMA placement of the server on Linux: the nodes of the machine, pinning threads to them and the memory
+// policy of threads. Elsewhere, the machine is one node and placement requests do nothing.
+namespace numa
+{
+    // CPUs of each node with CPUs, from /sys/devices/system/node. One node with no CPUs if it is unknown.
+    std::vector<std::vector<unsigned>> nodes();
+
+    // Runs the calling thread on the CPUs only. Does nothing for no CPUs.
+    void pin_thread(std::span<unsigned const> cpus);
+
+    // Pages the calling thread touches first from now on are spread over all nodes (true), or put on the
+    // node it runs on (false, the default policy).
+    void interleave_thread_memory(bool interleave);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Messages of ifc-server, each a little-endian u32 byte count followed by that many bytes.
+//
+// Request:  u8 Query, then the argument as UTF-8 up to the end of the message, e.g. a qualified name.
+// Response: u8 Status, u32 count, then `count` results of
+//           u32 module (index into the modules given on the command line and their dependencies,
+//           see the `modules` query), u32 declaration (the raw DeclIndex), u32 size, `size` bytes of text.
+namespace protocol
+{
+    enum class Query : uint8_t
+    {
+        Resolve     = 1, // Declarations named by a qualified name
+        FindDerived = 2, // Classes directly or indirectly derived from the classes named by a qualified name
+        FindUses    = 3, // Declarations whose initializers or default arguments name the declarations
+        DumpScope   = 4, // Members of the namespaces or classes named, of the global scopes if the name is empty
+        Modules     = 5, // Loaded modules, with the path of their BMI as text and a null declaration
+        Members     = 6, // Members of the classes named, including the ones of their bases, memoized
+    };
+
+    enum class Status : uint8_t
+    {
+        Ok         = 0,
+        NotFound   = 1,
+        BadRequest = 2,
+        Error      = 3, // The single result is the message of the error
+    };
+
+    struct Result
+    {
+        uint32_t module;
+        uint32_t decl;
+        std::string_view text;
+    };
+
+    inline void put_u32(std::vector<std::byte>& out, uint32_t value)
+    {
+        for (int i = 0; i != 4; ++i)
+            out.push_back(static_cast<std::byte>(value >> (8 * i)));
+    }
+
+    inline uint32_t get_u32(std::span<std::byte const> in)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i != 4; ++i)
+            value |= std::to_integer<uint32_t>(in[i]) << (8 * i);
+        return value;
+    }
+
+    // Response without its length prefix.
+    class ResponseWriter
+    {
+    public:
+        explicit ResponseWriter(Status status)
+        {
+            bytes_.push_back(static_cast<std::byte>(status));
+            put_u32(bytes_, 0);
+        }
+
+        void add(Result result)
+        {
+            put_u32(bytes_, result.module);
+            put_u32(bytes_, result.decl);
+            put_u32(bytes_, static_cast<uint32_t>(result.text.size()));
+            auto const text = std::as_bytes(std::span(result.text));
+            bytes_.insert(bytes_.end(), text.begin(), text.end());
+            ++count_;
+        }
+
+        std::vector<std::byte> finish() &&
+        {
+            for (int i = 0; i != 4; ++i)
+                bytes_[1 + i] = static_cast<std::byte>(count_ >> (8 * i));
+            return std::move(bytes_);
+        }
+
+    private:
+        std::vector<std::byte> bytes_;
+        uint32_t count_ = 0;
+    };
+}
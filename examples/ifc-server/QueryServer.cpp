@@ -0,0 +1,228 @@
+#include "QueryServer.h"
+
+#include "ifc/Declaration.h"
+#include "ifc/File.h"
+
+#include "reflifc/Query.h"
+#include "reflifc/index/ParentIndex.h"
+#include "reflifc/index/QualifiedNameResolver.h"
+#include "reflifc/index/ReferenceIndex.h"
+
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    std::string_view module_name(ifc::File const& file)
+    {
+        auto const & header = file.header();
+        switch (header.unit.sort())
+        {
+        case ifc::UnitSort::Primary:
+        case ifc::UnitSort::Partition:
+        case ifc::UnitSort::Header:
+            return file.get_string_view(ifc::TextOffset{ header.unit.index });
+        default:
+            return file.get_string_view(header.src_path);
+        }
+    }
+
+    uint32_t raw(ifc::DeclIndex decl)
+    {
+        return std::bit_cast<uint32_t>(decl);
+    }
+}
+
+QueryServer::QueryServer(ifc::Environment& environment, std::filesystem::path const& root_bmi, ifc::Executor& executor)
+    : environment_(environment)
+    , graph_(environment, environment.get_module_by_bmi_path(root_bmi))
+    , symbols_(graph_, executor)
+    , hierarchy_(graph_, environment, executor)
+{
+    // Built now rather than by the first query that needs them.
+    graph_.for_each_parallel([this](ifc::ModuleGraph::NodeId node) {
+        auto const & file = graph_.file(node);
+        file.get_index<reflifc::ParentIndex>();
+        file.get_index<reflifc::ReferenceIndex>();
+        file.get_index<reflifc::QualifiedNameResolver>();
+    }, executor);
+}
+
+void QueryServer::add(protocol::ResponseWriter& response, ifc::File const& file, ifc::DeclIndex decl) const
+{
+    std::string buffer;
+    response.add({
+        .module = *graph_.find(file),
+        .decl = raw(decl),
+        .text = reflifc::qualified_name(reflifc::Declaration(&file, decl), buffer),
+    });
+}
+
+std::vector<QueryServer::OwnedResult> QueryServer::members_with_inherited(ifc::QueryCache::Reads& reads, std::string_view name) const
+{
+    std::vector<OwnedResult> result;
+    std::string buffer;
+    for (auto target : symbols_.find(name))
+    {
+        const auto id = hierarchy_.find(*target.file, target.decl);
+        if (!id)
+            continue;
+        auto classes = hierarchy_.all_bases(*id);
+        classes.insert(classes.begin(), *id);
+        for (auto each : classes)
+        {
+            const auto [file, decl] = hierarchy_.get(each);
+            reads.add(*file);
+            const auto type = reflifc::Declaration(file, decl).as_scope().as_class_or_struct();
+            if (!type.is_complete())
+                continue;
+            for (auto member : type.members())
+            {
+                buffer.clear();
+                result.push_back({
+                    .module = *graph_.find(*file),
+                    .decl = raw(member.index()),
+                    .text = std::string(reflifc::qualified_name(reflifc::Declaration(file, member.index()), buffer)),
+                });
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<std::byte> QueryServer::answer(std::span<std::byte const> request) const
+{
+    if (request.empty())
+        return protocol::ResponseWriter(protocol::Status::BadRequest).finish();
+
+    const auto query = static_cast<protocol::Query>(request[0]);
+    const std::string_view argument(reinterpret_cast<char const*>(request.data() + 1), request.size() - 1);
+    try
+    {
+        return answer(query, argument);
+    }
+    catch (std::exception const& e)
+    {
+        protocol::ResponseWriter response(protocol::Status::Error);
+        response.add({ .module = 0, .decl = 0, .text = e.what() });
+        return std::move(response).finish();
+    }
+}
+
+std::vector<std::byte> QueryServer::answer(protocol::Query query, std::string_view argument) const
+{
+    using protocol::Query;
+
+    if (query == Query::Modules)
+    {
+        protocol::ResponseWriter response(protocol::Status::Ok);
+        for (ifc::ModuleGraph::NodeId node = 0; node != graph_.size(); ++node)
+            response.add({ .module = node, .decl = 0, .text = module_name(graph_.file(node)) });
+        return std::move(response).finish();
+    }
+
+    if (query == Query::DumpScope && argument.empty())
+    {
+        protocol::ResponseWriter response(protocol::Status::Ok);
+        for (ifc::ModuleGraph::NodeId node = 0; node != graph_.size(); ++node)
+        {
+            auto const & file = graph_.file(node);
+            // Modules that only re-export others have no scopes at all.
+            if (!file.has_partition("scope.desc"))
+                continue;
+            for (auto member : reflifc::Module(&file).global_namespace().get_declarations())
+                add(response, file, member.index());
+        }
+        return std::move(response).finish();
+    }
+
+    if (query == Query::Members)
+    {
+        const auto members = cache_.get<std::vector<OwnedResult>>("members", argument, [&](ifc::QueryCache::Reads& reads) {
+            return members_with_inherited(reads, argument);
+        });
+        if (members->empty())
+            return protocol::ResponseWriter(protocol::Status::NotFound).finish();
+        protocol::ResponseWriter response(protocol::Status::Ok);
+        for (auto const & member : *members)
+            response.add({ .module = member.module, .decl = member.decl, .text = member.text });
+        return std::move(response).finish();
+    }
+
+    if (query != Query::Resolve && query != Query::FindDerived && query != Query::FindUses && query != Query::DumpScope)
+        return protocol::ResponseWriter(protocol::Status::BadRequest).finish();
+
+    const auto targets = symbols_.find(argument);
+    if (targets.empty())
+        return protocol::ResponseWriter(protocol::Status::NotFound).finish();
+
+    protocol::ResponseWriter response(protocol::Status::Ok);
+    switch (query)
+    {
+    case Query::Resolve:
+        for (auto target : targets)
+            add(response, *target.file, target.decl);
+        break;
+
+    case Query::FindDerived:
+        for (auto target : targets)
+        {
+            if (const auto id = hierarchy_.find(*target.file, target.decl))
+            {
+                for (auto derived : hierarchy_.all_derived(*id))
+                    add(response, *hierarchy_.get(derived).file, hierarchy_.get(derived).decl);
+            }
+        }
+        break;
+
+    case Query::FindUses:
+        for (auto target : targets)
+        {
+            for (auto user : target.file->get_index<reflifc::ReferenceIndex>().referrers(target.decl))
+                add(response, *target.file, user);
+
+            // Uses from other modules go through their references to the target.
+            for (ifc::ModuleGraph::NodeId node = 0; node != graph_.size(); ++node)
+            {
+                auto const & file = graph_.file(node);
+                if (&file == target.file || !file.has_partition(ifc::DeclReference::PartitionName))
+                    continue;
+                for (uint32_t i = 0; i != file.decl_references().size(); ++i)
+                {
+                    const ifc::DeclIndex reference{ static_cast<uint32_t>(ifc::DeclSort::Reference), i };
+                    const auto resolved = environment_.resolve_reference(file, reference);
+                    if (resolved.file != target.file || resolved.decl != target.decl)
+                        continue;
+                    for (auto user : file.get_index<reflifc::ReferenceIndex>().referrers(reference))
+                        add(response, file, user);
+                }
+            }
+        }
+        break;
+
+    case Query::DumpScope:
+        for (auto target : targets)
+        {
+            const reflifc::Declaration declaration(target.file, target.decl);
+            if (!declaration.is_scope())
+                continue;
+            const auto scope = declaration.as_scope();
+            if (scope.is_namespace())
+            {
+                for (auto member : scope.as_namespace().scope().get_declarations())
+                    add(response, *target.file, member.index());
+            }
+            else if (scope.is_class_or_struct() && scope.as_class_or_struct().is_complete())
+            {
+                for (auto member : scope.as_class_or_struct().members())
+                    add(response, *target.file, member.index());
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+    return std::move(response).finish();
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Protocol.h"
+
+#include "ifc/Environment.h"
+#include "ifc/ModuleGraph.h"
+#include "ifc/QueryCache.h"
+
+#include "reflifc/index/ClassHierarchy.h"
+#include "reflifc/index/GlobalSymbolIndex.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+// The modules reachable from a root module, resident with the indexes the queries use, which are built
+// once up front: the global symbol table and the class hierarchy of all modules, and the reference and
+// parent indexes of each. `answer` only reads them and the cache of answers, so it is called from any number of threads at once.
+class QueryServer
+{
+public:
+    QueryServer(ifc::Environment&, std::filesystem::path const& root_bmi, ifc::Executor& = ifc::default_executor());
+
+    // Response to a request, both without their length prefix, see Protocol.h.
+    std::vector<std::byte> answer(std::span<std::byte const> request) const;
+
+    size_t module_count() const { return graph_.size(); }
+    size_t symbol_count() const { return symbols_.size(); }
+
+private:
+    std::vector<std::byte> answer(protocol::Query, std::string_view argument) const;
+    void add(protocol::ResponseWriter&, ifc::File const&, ifc::DeclIndex) const;
+
+    struct OwnedResult
+    {
+        uint32_t module;
+        uint32_t decl;
+        std::string text;
+    };
+
+    std::vector<OwnedResult> members_with_inherited(ifc::QueryCache::Reads&, std::string_view name) const;
+
+    ifc::Environment& environment_;
+    ifc::ModuleGraph graph_;
+    reflifc::GlobalSymbolIndex symbols_;
+    reflifc::ClassHierarchy hierarchy_;
+    // Answers of the slower queries, by the BMIs they read.
+    mutable ifc::QueryCache cache_;
+};
@@ -0,0 +1,453 @@
+#include "Numa.h"
+#include "QueryServer.h"
+
+#include "ifc/MSVCEnvironment.h"
+#include "ifc/Parallel.h"
+#include "ifc/blob_reader.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+static std::optional<unsigned> parse_threads(std::string_view value)
+{
+    unsigned threads = 0;
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), threads);
+    if (error != std::errc{} || end != value.data() + value.size() || threads == 0)
+        return std::nullopt;
+    return threads;
+}
+
+// Where the indexes live on machines with several NUMA nodes.
+enum class Placement
+{
+    Default,
+    Replicate,  // A copy of the modules and their indexes per node, built and served by threads of the node
+    Interleave, // One copy spread over the nodes, served by threads of every node
+};
+
+static std::optional<Placement> parse_placement(std::string_view value)
+{
+    if (value == "replicate")
+        return Placement::Replicate;
+    if (value == "interleave")
+        return Placement::Interleave;
+    return std::nullopt;
+}
+
+static std::system_error socket_error(char const* what)
+{
+    return std::system_error(errno, std::generic_category(), what);
+}
+
+// False on end of stream before the first byte, throws if it ends in the middle.
+static bool read_exactly(int fd, std::span<std::byte> out)
+{
+    size_t done = 0;
+    while (done != out.size())
+    {
+        const auto n = ::read(fd, out.data() + done, out.size() - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            throw socket_error("read");
+        if (n == 0)
+        {
+            if (done == 0)
+                return false;
+            throw std::runtime_error("connection closed in the middle of a request");
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static void write_all(int fd, std::span<std::byte const> bytes)
+{
+    size_t done = 0;
+    while (done != bytes.size())
+    {
+        // No SIGPIPE if the client is gone, the connection just ends.
+        const auto n = ::send(fd, bytes.data() + done, bytes.size() - done, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            throw socket_error("send");
+        done += static_cast<size_t>(n);
+    }
+}
+
+// Answers the next request of the client, false if it disconnected instead.
+static bool answer(QueryServer const& server, int client)
+{
+    // Requests are names, anything bigger is not one.
+    constexpr uint32_t max_request_size = 1 << 20;
+
+    std::array<std::byte, 4> prefix;
+    if (!read_exactly(client, prefix))
+        return false;
+    const auto size = protocol::get_u32(prefix);
+    if (size > max_request_size)
+        throw std::runtime_error("request too big");
+    std::vector<std::byte> request(size);
+    read_exactly(client, request);
+
+    const auto response = server.answer(request);
+    std::vector<std::byte> framed;
+    protocol::put_u32(framed, static_cast<uint32_t>(response.size()));
+    framed.insert(framed.end(), response.begin(), response.end());
+    write_all(client, framed);
+    return true;
+}
+
+// The clients waiting for their next request are watched by a single thread, a client with a request ready
+// is handed to a worker, which answers that request and hands the client back. Idle clients hold no worker,
+// so the workers bound the requests answered at once, not the clients connected.
+class Connections
+{
+public:
+    explicit Connections(int listener)
+        : listener_(listener)
+    {
+        if (::pipe2(wake_, O_CLOEXEC | O_NONBLOCK) != 0)
+            throw socket_error("pipe2");
+    }
+
+    ~Connections()
+    {
+        for (int client : idle_)
+            ::close(client);
+        for (int client : ready_)
+            ::close(client);
+        for (int client : returned_)
+            ::close(client);
+        ::close(wake_[0]);
+        ::close(wake_[1]);
+    }
+
+    // Accepts clients and watches the idle ones until an error, which it throws.
+    void watch()
+    {
+        std::vector<pollfd> fds;
+        std::vector<int> idle;
+        for (;;)
+        {
+            fds.assign({ { listener_, POLLIN, 0 }, { wake_[0], POLLIN, 0 } });
+            for (int client : idle_)
+                fds.push_back({ client, POLLIN, 0 });
+            if (::poll(fds.data(), fds.size(), -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw socket_error("poll");
+            }
+
+            // Readable or hung up, either way a worker reads it.
+            idle.clear();
+            {
+                std::scoped_lock lock(mutex_);
+                for (size_t i = 2; i != fds.size(); ++i)
+                {
+                    if (fds[i].revents != 0)
+                        ready_.push_back(fds[i].fd);
+                    else
+                        idle.push_back(fds[i].fd);
+                }
+                if (fds[1].revents != 0)
+                {
+                    std::array<char, 64> bytes;
+                    while (::read(wake_[0], bytes.data(), bytes.size()) > 0)
+                        ;
+                    idle.insert(idle.end(), returned_.begin(), returned_.end());
+                    returned_.clear();
+                }
+            }
+            has_ready_.notify_all();
+            idle_.swap(idle);
+
+            if (fds[0].revents != 0)
+                accept();
+        }
+    }
+
+    // Blocks until a client has a request ready, null once stopped.
+    std::optional<int> take()
+    {
+        std::unique_lock lock(mutex_);
+        has_ready_.wait(lock, [this] { return stopped_ || !ready_.empty(); });
+        if (stopped_)
+            return std::nullopt;
+        const int client = ready_.front();
+        ready_.pop_front();
+        return client;
+    }
+
+    // Watched again for its next request.
+    void give_back(int client)
+    {
+        {
+            std::scoped_lock lock(mutex_);
+            returned_.push_back(client);
+        }
+        // A full pipe already wakes the watching thread.
+        const char byte = 0;
+        (void)!::write(wake_[1], &byte, 1);
+    }
+
+    void stop()
+    {
+        {
+            std::scoped_lock lock(mutex_);
+            stopped_ = true;
+        }
+        has_ready_.notify_all();
+    }
+
+private:
+    void accept()
+    {
+        const int client = ::accept4(listener_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN)
+                return;
+            throw socket_error("accept");
+        }
+        // A client stalling in the middle of a request, or not reading its response, holds a worker that long.
+        const timeval timeout{ 10, 0 };
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        idle_.push_back(client);
+    }
+
+    int listener_;
+    int wake_[2] = { -1, -1 };
+    std::vector<int> idle_; // Of the watching thread
+    std::mutex mutex_;
+    std::condition_variable has_ready_;
+    std::deque<int> ready_;
+    std::vector<int> returned_;
+    bool stopped_ = false;
+};
+
+static int listen_on(std::string const& socket_path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("socket path too long: " + socket_path);
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw socket_error("socket");
+    // Left behind by a previous run. Anything else at the path is not ours to remove, binding then fails.
+    struct stat status;
+    if (::lstat(socket_path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+        ::unlink(socket_path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0)
+        throw socket_error("bind");
+    if (::listen(fd, SOMAXCONN) != 0)
+        throw socket_error("listen");
+    return fd;
+}
+
+int main(int argc, char* argv[])
+{
+    constexpr auto usage = "expected: [--threads N] [--socket path] [--numa replicate|interleave] path to .ifc file\n";
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string socket_path = "ifc-server.sock";
+    auto placement = Placement::Default;
+    int arg = 1;
+    for (; arg + 2 < argc; arg += 2)
+    {
+        const std::string_view option = argv[arg];
+        const std::string_view value = argv[arg + 1];
+        if (option == "--threads")
+        {
+            const auto parsed = parse_threads(value);
+            if (!parsed)
+            {
+                std::cerr << "expected: positive number of threads after --threads, got '" << value << "'\n";
+                return EXIT_FAILURE;
+            }
+            threads = *parsed;
+        }
+        else if (option == "--socket")
+            socket_path = value;
+        else if (option == "--numa")
+        {
+            const auto parsed = parse_placement(value);
+            if (!parsed)
+            {
+                std::cerr << "expected: replicate or interleave after --numa, got '" << value << "'\n";
+                return EXIT_FAILURE;
+            }
+            placement = *parsed;
+        }
+        else
+        {
+            std::cerr << "unknown option '" << option << "'\n" << usage;
+            return EXIT_FAILURE;
+        }
+    }
+    if (arg + 1 != argc)
+    {
+        std::cerr << usage;
+        return EXIT_FAILURE;
+    }
+    argv += arg - 1;
+
+    const std::filesystem::path path_to_ifc = argv[1];
+    if (!is_regular_file(path_to_ifc))
+    {
+        std::cerr << path_to_ifc << " is not regular file\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace std::string_literals;
+    const auto path_to_config = argv[1] + ".d.json"s;
+
+    try
+    {
+        // Without NUMA placement there is one node with no CPUs, the threads are not pinned.
+        auto nodes = placement == Placement::Default ? std::vector<std::vector<unsigned>>(1) : numa::nodes();
+        struct Replica
+        {
+            std::unique_ptr<ifc::Environment> environment;
+            std::unique_ptr<QueryServer> server;
+        };
+        std::vector<Replica> replicas(placement == Placement::Replicate ? nodes.size() : 1);
+
+        // The modules are read into buffers (rather than mapped, with pages shared by the nodes) and the
+        // indexes are built by threads whose memory policy places them: on the node of a replica, whose
+        // threads are pinned to it, or interleaved over all nodes.
+        const auto build = [&](Replica& replica, std::span<unsigned const> cpus) {
+            numa::pin_thread(cpus);
+            if (placement == Placement::Default)
+            {
+                replica.environment = std::make_unique<ifc::Environment>(ifc::read_msvc_config(path_to_config), ifc::read_blob);
+                replica.server = std::make_unique<QueryServer>(*replica.environment, path_to_ifc);
+                return;
+            }
+            const bool interleave = placement == Placement::Interleave;
+            numa::interleave_thread_memory(interleave);
+            ifc::ThreadPool pool(cpus.empty() ? 0 : static_cast<unsigned>(cpus.size()), [cpus, interleave](unsigned) {
+                numa::pin_thread(cpus);
+                numa::interleave_thread_memory(interleave);
+            });
+            replica.environment = std::make_unique<ifc::Environment>(ifc::read_msvc_config(path_to_config),
+                ifc::blob_reader({ .backing = ifc::BlobBacking::HugePageBuffer }));
+            replica.server = std::make_unique<QueryServer>(*replica.environment, path_to_ifc, pool);
+            numa::interleave_thread_memory(false);
+        };
+        if (placement == Placement::Replicate)
+        {
+            std::vector<std::jthread> builders;
+            std::vector<std::exception_ptr> errors(replicas.size());
+            for (size_t node = 0; node != replicas.size(); ++node)
+            {
+                builders.emplace_back([&, node] {
+                    try
+                    {
+                        build(replicas[node], nodes[node]);
+                    }
+                    catch (...)
+                    {
+                        errors[node] = std::current_exception();
+                    }
+                });
+            }
+            builders.clear();
+            for (auto const & error : errors)
+            {
+                if (error)
+                    std::rethrow_exception(error);
+            }
+        }
+        else
+        {
+            // One copy, built by threads of any node.
+            build(replicas.front(), {});
+        }
+
+        auto const & primary = *replicas.front().server;
+        const int listener = listen_on(socket_path);
+        std::cerr << "serving " << primary.module_count() << " modules, " << primary.symbol_count()
+                  << " qualified names on " << socket_path << " with " << threads << " threads";
+        if (placement != Placement::Default)
+            std::cerr << " on " << nodes.size() << " NUMA nodes" << (placement == Placement::Replicate ? ", replicated" : ", interleaved");
+        std::cerr << '\n';
+
+        // Each worker answers one request of a client at a time, up to `threads` requests are answered at once.
+        // Workers are spread over the nodes and serve from the replica of their node.
+        Connections connections(listener);
+        std::vector<std::jthread> workers;
+        for (unsigned i = 0; i != threads; ++i)
+        {
+            const auto node = i % nodes.size();
+            auto const & server = *replicas[node % replicas.size()].server;
+            std::span<unsigned const> cpus = nodes[node];
+            workers.emplace_back([&server, &connections, cpus] {
+                numa::pin_thread(cpus);
+                while (const auto client = connections.take())
+                {
+                    bool connected = false;
+                    try
+                    {
+                        connected = answer(server, *client);
+                    }
+                    catch (std::exception const & e)
+                    {
+                        std::cerr << e.what() << '\n';
+                    }
+                    if (connected)
+                        connections.give_back(*client);
+                    else
+                        ::close(*client);
+                }
+            });
+        }
+        try
+        {
+            connections.watch();
+        }
+        catch (...)
+        {
+            connections.stop();
+            throw;
+        }
+        return EXIT_SUCCESS;
+    }
+    catch (std::exception const & e)
+    {
+        std::cerr << e.what();
+        return EXIT_FAILURE;
+    }
+}
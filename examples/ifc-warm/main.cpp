@@ -0,0 +1,184 @@
+#include "ifc/File.h"
+#include "ifc/Parallel.h"
+#include "ifc/blob_reader.h"
+#include "reflifc/index/QualifiedNameList.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Writes the side index `<file>.idx` (see BlobReadOptions::side_index) of every BMI given, so that later
+// readers of the BMIs take the string length and interning tables from it instead of building them.
+// Side indexes are written aside and renamed into place, readers never see a partial one.
+// `--names` also writes the qualified names of each BMI (`<file>.names`, see reflifc::QualifiedNameList)
+// for completion indexes to map.
+
+struct WarmOptions
+{
+    // On a pool of that many threads (0 for one per hardware thread) instead of ifc::default_executor.
+    std::optional<unsigned> jobs;
+    // Also publish the side indexes in shared memory, see BlobReadOptions::shared_side_index.
+    bool shared = false;
+    // Also write the qualified name lists.
+    bool names = false;
+    std::vector<std::filesystem::path> paths;
+};
+
+static std::optional<unsigned> parse_jobs(std::string_view text)
+{
+    unsigned jobs;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), jobs);
+    if (error != std::errc() || end != text.data() + text.size())
+        return std::nullopt;
+    return jobs;
+}
+
+// The `.ifc` files of the directories, recursively, and the other paths as given.
+static std::vector<std::filesystem::path> collect_bmis(std::vector<std::filesystem::path> const& paths)
+{
+    std::vector<std::filesystem::path> result;
+    for (auto const & path : paths)
+    {
+        if (!std::filesystem::is_directory(path))
+        {
+            result.push_back(path);
+            continue;
+        }
+        for (auto const & entry : std::filesystem::recursive_directory_iterator(path))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".ifc")
+                result.push_back(entry.path());
+        }
+    }
+    // A BMI given twice would be written twice at once.
+    std::ranges::sort(result);
+    const auto [last, end] = std::ranges::unique(result);
+    result.erase(last, end);
+    return result;
+}
+
+// `<file>.names`, unless the one written before is up to date. Written aside and renamed into place too.
+static void write_names(std::filesystem::path const& bmi, ifc::File const& file)
+{
+    auto path = bmi;
+    path += ".names";
+    if (std::filesystem::exists(path))
+    {
+        try
+        {
+            const auto written = ifc::read_blob(path);
+            const reflifc::QualifiedNameList names(file, written->view());
+            return;
+        }
+        catch (std::runtime_error const &)
+        {
+        }
+    }
+    const auto contents = file.get_index<reflifc::QualifiedNameList>().contents();
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+        if (!output.write(reinterpret_cast<char const*>(contents.data()), static_cast<std::streamsize>(contents.size())))
+            throw std::runtime_error("cannot write " + temporary.string());
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+int main(int argc, char* argv[])
+{
+    constexpr auto usage = "expected: [--jobs N] [--shared] [--names] directories or paths to .ifc files\n";
+
+    WarmOptions options;
+    for (int arg = 1; arg != argc; ++arg)
+    {
+        const std::string_view option = argv[arg];
+        if (option == "--shared")
+        {
+            options.shared = true;
+        }
+        else if (option == "--names")
+        {
+            options.names = true;
+        }
+        else if (option == "--jobs")
+        {
+            const auto parsed = arg + 1 != argc ? parse_jobs(argv[++arg]) : std::nullopt;
+            if (!parsed)
+            {
+                std::cerr << "expected: number of jobs after --jobs\n";
+                return EXIT_FAILURE;
+            }
+            options.jobs = *parsed;
+        }
+        else if (option.starts_with("--"))
+        {
+            std::cerr << "unknown option '" << option << "'\n" << usage;
+            return EXIT_FAILURE;
+        }
+        else
+        {
+            options.paths.emplace_back(option);
+        }
+    }
+    if (options.paths.empty())
+    {
+        std::cerr << usage;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::filesystem::path> bmis;
+    try
+    {
+        bmis = collect_bmis(options.paths);
+    }
+    catch (std::exception const & e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto reader = ifc::blob_reader({ .side_index = true, .shared_side_index = options.shared });
+    std::atomic<size_t> written = 0;
+    std::atomic<size_t> hot = 0;
+    std::atomic<size_t> failed = 0;
+    std::mutex errors;
+
+    std::optional<ifc::ThreadPool> pool;
+    if (options.jobs)
+        pool.emplace(*options.jobs);
+    ifc::Executor& executor = pool ? *pool : ifc::default_executor();
+    executor.run(bmis.size(), [&](size_t i) {
+        try
+        {
+            const auto blob = reader(bmis[i]);
+            const ifc::File file(blob->view(), { .side_index = blob->side_index(), .string_table = blob->string_table() });
+            if (options.names)
+                write_names(bmis[i], file);
+            if (file.has_side_index())
+            {
+                ++hot;
+                return;
+            }
+            // Builds the tables, then writes them.
+            blob->side_index_missing(file);
+            ++written;
+        }
+        catch (std::exception const & e)
+        {
+            ++failed;
+            std::scoped_lock lock(errors);
+            std::cerr << bmis[i].string() << ": " << e.what() << "\n";
+        }
+    });
+
+    std::cout << bmis.size() << " BMIs: " << written << " side indexes written, " << hot << " up to date, " << failed << " failed\n";
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
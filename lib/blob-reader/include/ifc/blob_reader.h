@@ -1,8 +1,131 @@
 #pragma once
 
 #include "ifc/Environment.h"
+#include "ifc/Parallel.h"
+
+#include <exception>
+#include <functional>
+#include <span>
+#include <string>
 
 namespace ifc
 {
+    // Expected access pattern of a mapped file, passed to the OS as a paging hint.
+    enum class BlobAccess
+    {
+        Normal,
+        Sequential, // Aggressive read-ahead
+        Random,     // No read-ahead, for sparse lookups
+        WillNeed,   // Start reading the whole file in right away
+    };
+
+    // Memory backing a blob.
+    enum class BlobBacking
+    {
+        Mapped,          // Memory-mapped file
+        MappedPopulated, // Memory-mapped file with all pages faulted in up front (MAP_POPULATE)
+        HugePageBuffer,  // Whole file read into an anonymous 2 MB aligned buffer, backed by huge pages where available
+        DirectRead,      // Whole file read into a buffer bypassing the page cache (O_DIRECT), for one-shot tools
+    };
+
+    struct BlobReadOptions
+    {
+        BlobAccess access = BlobAccess::Normal; // Only applies to mapped backings
+        BlobBacking backing = BlobBacking::Mapped;
+        // Map the side index `<file>.idx` along with the file (see FileOptions::side_index).
+        // One older than the file is ignored. A missing or stale side index is written
+        // once the Environment has built a File from the blob, failures to write it are ignored.
+        bool side_index = false;
+        // Share the side index between the processes of a machine through a named shared memory segment, keyed
+        // by the file's checksum and size: the first process to load the file publishes the side index it built,
+        // later ones map it read-only. Before a `<file>.idx`, if both are used. Segments outlive the processes
+        // on POSIX systems (until shm_unlink, see remove_shared_side_index) and their last user on Windows.
+        // On POSIX systems, segments are only accessible by their owner, segments of other users are not used,
+        // and a segment that will never be published (its creator crashed while publishing it) is replaced.
+        bool shared_side_index = false;
+    };
+
+    std::filesystem::path side_index_path(std::filesystem::path const & file);
+
+    // Name of the shared memory segment of BlobReadOptions::shared_side_index for the blob.
+    std::string shared_side_index_name(File::BlobView blob);
+
+    // Removes the segment, e.g. to publish a side index again.
+    // Returns false if there was none. Segments go away with their last user on Windows, where this does nothing.
+    bool remove_shared_side_index(File::BlobView blob);
+
+    // Holders returned by the readers implement BlobHolder::prefetch.
     Environment::BlobHolderPtr read_blob(std::filesystem::path const & file);
+
+    // Reader mapping files like read_blob, with the given hints.
+    Environment::FileReader blob_reader(BlobReadOptions options);
+
+    // Reads a zstd compressed file (e.g. `.ifc.zst`), decompressing it into memory.
+    Environment::BlobHolderPtr read_zstd_blob(std::filesystem::path const & file);
+
+    // Reads `out.size()` bytes of a blob from `offset` into `out`, e.g. with an HTTP range request to a remote
+    // artifact store. Throws on failure. Called from any thread, but never concurrently for one blob.
+    using RangeReader = std::function<void(uint64_t offset, std::span<std::byte> out)>;
+
+    struct RangeReadOptions
+    {
+        // Unit of reading and caching, in bytes. Ranges of consecutive missing pages are read at once.
+        size_t page_size = 64 * 1024;
+        // Directory keeping the pages read so far for later holders of the blob, also in other processes,
+        // as `<key>.ifc` (the pages at their offsets) and `<key>.pages` (a byte per page, set once it is written).
+        // Pages are only kept in memory if empty.
+        std::filesystem::path cache_directory;
+        // Name of the blob in the cache directory, e.g. its content hash.
+        std::string key;
+    };
+
+    // Blob of `size` bytes read through `read_range` as a File accesses it (see BlobHolder::fetch): the header,
+    // the table of contents and the string table when the File is constructed, every other partition on its
+    // first access. Pages that were never read take no memory.
+    Environment::BlobHolderPtr read_blob_ranges(uint64_t size, RangeReader read_range, RangeReadOptions options = {});
+
+    // Reads up to `out.size()` bytes of a stream (e.g. a pipe or a socket) into `out` and returns how many,
+    // 0 at its end. Throws on failure.
+    using StreamReader = std::function<size_t(std::span<std::byte> out)>;
+
+    // Blob sent through a stream, returned once its header (and, if they follow it, its string table and table
+    // of contents) was read: the rest is read in offset order by a thread of the holder, into one page aligned
+    // buffer of the blob's final size. Fetching a range (see
+    // BlobHolder::fetch) waits for its bytes, so a File constructed from the holder with FileOptions::fetch reads
+    // each partition as soon as it arrived. Streams of files in FileWriter::Layout::TableOfContentsFirst (see
+    // streaming_layout) make the File constructible before the partitions arrive, with the table of contents
+    // last (as MSVC writes BMIs) constructing it waits for the whole stream. Fetches throw if the stream fails
+    // or ends early. Destroying the holder does not wait for the read in progress: the thread keeps `read` and
+    // the buffer until that read returns, and stops then.
+    Environment::BlobHolderPtr read_blob_stream(StreamReader read);
+
+    // Maps the file on a separate thread.
+    std::future<Environment::BlobHolderPtr> read_blob_async(std::filesystem::path const & file);
+
+    struct BatchReadOptions
+    {
+        BlobReadOptions blob;
+        // Number of files read at once.
+        unsigned queue_depth = 32;
+    };
+
+    struct BatchReadResult
+    {
+        size_t index; // Of the path in the batch
+        Environment::BlobHolderPtr blob; // Null if reading failed
+        std::exception_ptr error;
+    };
+
+    // Reads all files, many of them at once, and hands every result to `on_read` as soon as it is read.
+    // Calls of `on_read` are serialized but come from different threads, in no particular order.
+    void read_blobs(std::span<std::filesystem::path const> paths, std::function<void(BatchReadResult)> const& on_read, BatchReadOptions options = {});
+
+    // Config of the module and header unit BMIs (`*.ifc`) in the directories and their subdirectories, named by
+    // the unit of each BMI, for builds writing no `.ifc.d.json`. Only the header, the table of contents and the
+    // strings of each BMI are read (see peek_file), many BMIs at once. A name found in several directories maps
+    // to its BMI in the first one, a name found twice within one directory throws std::invalid_argument.
+    // BMIs of other units are left out, corrupted ones throw std::runtime_error.
+    // Build one ModuleMap of the result to share among Environments, whose lookups of missing names fail without
+    // touching the file system.
+    Environment::Config discover_bmis(std::span<std::filesystem::path const> directories, Executor& = default_executor());
 }
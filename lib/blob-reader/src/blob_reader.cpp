@@ -1,22 +1,1196 @@
 #include "ifc/blob_reader.h"
 
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 
-struct BlobHolderImpl : ifc::Environment::BlobHolder
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
 {
-    boost::iostreams::mapped_file_source file_mapping;
+    constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+    size_t align_up(size_t size, size_t alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+#if !defined(_WIN32)
+    void advise(std::byte const* data, size_t size, int advice)
+    {
+        // madvise requires a page aligned start.
+        static const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const auto start = reinterpret_cast<uintptr_t>(data) & ~(page_size - 1);
+        const auto end = reinterpret_cast<uintptr_t>(data) + size;
+        // It is only a hint, failures are ignored.
+        madvise(reinterpret_cast<void*>(start), end - start, advice);
+    }
+
+    [[noreturn]] void throw_system_error(std::filesystem::path const& path)
+    {
+        throw std::system_error(errno, std::generic_category(), path.string());
+    }
+
+    class FileDescriptor
+    {
+    public:
+        explicit FileDescriptor(int fd) : fd_(fd) {}
+        ~FileDescriptor() { if (fd_ >= 0) close(fd_); }
+
+        FileDescriptor(FileDescriptor const&) = delete;
+        FileDescriptor& operator=(FileDescriptor const&) = delete;
+
+        int get() const { return fd_; }
+
+    private:
+        int fd_;
+    };
+#endif
+
+    void prefetch_range(ifc::File::BlobView range)
+    {
+        if (range.empty())
+            return;
+#if defined(_WIN32)
+        WIN32_MEMORY_RANGE_ENTRY entry{ const_cast<std::byte*>(range.data()), range.size() };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &entry, 0);
+#else
+        advise(range.data(), range.size(), MADV_WILLNEED);
+#endif
+    }
+
+    void apply_access_hint(ifc::File::BlobView blob, ifc::BlobAccess access)
+    {
+        if (blob.empty())
+            return;
+
+        switch (access)
+        {
+        case ifc::BlobAccess::Normal:
+            break;
+        case ifc::BlobAccess::WillNeed:
+            prefetch_range(blob);
+            break;
+#if !defined(_WIN32)
+        case ifc::BlobAccess::Sequential:
+            advise(blob.data(), blob.size(), MADV_SEQUENTIAL);
+            break;
+        case ifc::BlobAccess::Random:
+            advise(blob.data(), blob.size(), MADV_RANDOM);
+            break;
+#else
+        default:
+            // No equivalent for mapped views.
+            break;
+#endif
+        }
+    }
+
+    struct MappedBlobHolder : ifc::Environment::BlobHolder
+    {
+        boost::iostreams::mapped_file_source file_mapping;
+
+        MappedBlobHolder(std::filesystem::path const& path)
+            : file_mapping(path.string())
+        {}
+
+        ifc::File::BlobView view() const override
+        {
+            return as_bytes(std::span(file_mapping.data(), file_mapping.size()));
+        }
+
+        void prefetch(ifc::File::BlobView range) const override
+        {
+            prefetch_range(range);
+        }
+    };
+
+#if !defined(_WIN32)
+    struct PopulatedBlobHolder : ifc::Environment::BlobHolder
+    {
+        std::byte const* data = nullptr;
+        size_t size = 0;
+
+        PopulatedBlobHolder(std::filesystem::path const& path)
+        {
+            FileDescriptor fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+            if (fd.get() < 0)
+                throw_system_error(path);
+
+            struct stat status;
+            if (fstat(fd.get(), &status) != 0)
+                throw_system_error(path);
+            size = static_cast<size_t>(status.st_size);
+            if (size == 0)
+                return;
+
+            int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+            flags |= MAP_POPULATE;
+#endif
+            auto mapping = mmap(nullptr, size, PROT_READ, flags, fd.get(), 0);
+            if (mapping == MAP_FAILED)
+                throw_system_error(path);
+            data = static_cast<std::byte const*>(mapping);
+        }
+
+        ~PopulatedBlobHolder() override
+        {
+            if (data)
+                munmap(const_cast<std::byte*>(data), size);
+        }
+
+        ifc::File::BlobView view() const override
+        {
+            return { data, size };
+        }
+
+        void prefetch(ifc::File::BlobView range) const override
+        {
+            prefetch_range(range);
+        }
+    };
+#endif
+
+    // A whole file read into memory.
+    class BufferBlobHolder : public ifc::Environment::BlobHolder
+    {
+    public:
+        BufferBlobHolder(std::filesystem::path const& path, ifc::BlobBacking backing)
+        {
+            const auto file_size = static_cast<size_t>(std::filesystem::file_size(path));
+            if (backing == ifc::BlobBacking::HugePageBuffer)
+                allocate_huge_pages(file_size);
+            else
+                allocate(align_up(file_size, DIRECT_IO_ALIGNMENT), DIRECT_IO_ALIGNMENT);
+
+            if (backing == ifc::BlobBacking::DirectRead)
+                read_direct(path, file_size);
+            else
+                read(path, file_size);
+            size_ = file_size;
+        }
+
+        ifc::File::BlobView view() const override
+        {
+            return { buffer_.data, size_ };
+        }
+
+    private:
+        // Freed by its destructor, so that it does not leak when reading the file into it throws.
+        struct Buffer
+        {
+            Buffer() = default;
+            Buffer(Buffer const&) = delete;
+            Buffer& operator=(Buffer const&) = delete;
+
+            ~Buffer()
+            {
+                if (!data)
+                    return;
+#if !defined(_WIN32)
+                if (anonymous_mapping)
+                {
+                    munmap(data, capacity);
+                    return;
+                }
+#endif
+                ::operator delete(data, std::align_val_t{ alignment });
+            }
+
+            std::byte* data = nullptr;
+            size_t capacity = 0;
+            size_t alignment = 0;
+            bool anonymous_mapping = false;
+        };
+
+        void allocate(size_t capacity, size_t alignment)
+        {
+            buffer_.data = static_cast<std::byte*>(::operator new(capacity, std::align_val_t{ alignment }));
+            buffer_.capacity = capacity;
+            buffer_.alignment = alignment;
+        }
+
+        void allocate_huge_pages(size_t size)
+        {
+#if !defined(_WIN32)
+            // Over-allocate to be able to align the start to a huge page, then trim the excess.
+            const auto capacity = align_up(std::max<size_t>(size, 1), HUGE_PAGE_SIZE);
+            auto reserved = mmap(nullptr, capacity + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (reserved == MAP_FAILED)
+                throw std::bad_alloc();
+
+            const auto start = reinterpret_cast<uintptr_t>(reserved);
+            const auto aligned = align_up(start, HUGE_PAGE_SIZE);
+            if (aligned != start)
+                munmap(reserved, aligned - start);
+            if (const auto tail = start + capacity + HUGE_PAGE_SIZE - (aligned + capacity))
+                munmap(reinterpret_cast<void*>(aligned + capacity), tail);
+
+            buffer_.data = reinterpret_cast<std::byte*>(aligned);
+            buffer_.capacity = capacity;
+            buffer_.anonymous_mapping = true;
+#if defined(MADV_HUGEPAGE)
+            madvise(buffer_.data, capacity, MADV_HUGEPAGE);
+#endif
+#else
+            allocate(align_up(size, HUGE_PAGE_SIZE), HUGE_PAGE_SIZE);
+#endif
+        }
+
+        void read(std::filesystem::path const& path, size_t size)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.read(reinterpret_cast<char*>(buffer_.data), static_cast<std::streamsize>(size)))
+                throw std::runtime_error("cannot read '" + path.string() + "'");
+        }
+
+        void read_direct(std::filesystem::path const& path, size_t size)
+        {
+#if !defined(_WIN32) && defined(O_DIRECT)
+            FileDescriptor fd(open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT));
+            if (fd.get() < 0)
+            {
+                // Not every file system supports direct I/O.
+                if (errno == EINVAL)
+                    return read(path, size);
+                throw_system_error(path);
+            }
+
+            // Reads of whole aligned blocks into the aligned buffer, the last one comes back short.
+            size_t done = 0;
+            while (done < size)
+            {
+                const auto result = ::read(fd.get(), buffer_.data + done, buffer_.capacity - done);
+                if (result < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw_system_error(path);
+                }
+                if (result == 0)
+                    break;
+                done += static_cast<size_t>(result);
+            }
+            if (done < size)
+                throw std::runtime_error("cannot read '" + path.string() + "'");
+#else
+            read(path, size);
+#endif
+        }
+
+        Buffer buffer_;
+        size_t size_ = 0;
+    };
+
+    // Decompressed contents of a file.
+    struct DecompressedBlobHolder : ifc::Environment::BlobHolder
+    {
+        std::vector<char> contents;
+
+        DecompressedBlobHolder(std::filesystem::path const& path)
+        {
+            namespace io = boost::iostreams;
+
+            io::mapped_file_source compressed(path.string());
+            io::filtering_istream input;
+            input.push(io::zstd_decompressor());
+            input.push(io::array_source(compressed.data(), compressed.size()));
+
+            io::copy(input, io::back_inserter(contents));
+        }
+
+        ifc::File::BlobView view() const override
+        {
+            return as_bytes(std::span(contents));
+        }
+    };
+
+    // A blob with the side index next to it.
+    class SideIndexedBlobHolder : public ifc::Environment::BlobHolder
+    {
+    public:
+        SideIndexedBlobHolder(ifc::Environment::BlobHolderPtr blob, std::filesystem::path const& file)
+            : blob_(std::move(blob))
+            , side_index_path_(ifc::side_index_path(file))
+        {
+            std::error_code error;
+            const auto side_index_time = std::filesystem::last_write_time(side_index_path_, error);
+            if (error || side_index_time < std::filesystem::last_write_time(file))
+                return;
+
+            try
+            {
+                side_index_.open(side_index_path_.string());
+            }
+            catch (std::exception const&)
+            {
+                // Unreadable side indexes are rewritten.
+            }
+        }
+
+        ifc::File::BlobView view() const override
+        {
+            return blob_->view();
+        }
+
+        void prefetch(ifc::File::BlobView range) const override
+        {
+            blob_->prefetch(range);
+        }
+
+        bool fetches_on_demand() const override
+        {
+            return blob_->fetches_on_demand();
+        }
+
+        void fetch(ifc::File::BlobView range) const override
+        {
+            blob_->fetch(range);
+        }
+
+        std::span<std::byte const> side_index() const override
+        {
+            if (!side_index_.is_open())
+                return {};
+            return as_bytes(std::span(side_index_.data(), side_index_.size()));
+        }
+
+        void side_index_missing(ifc::File const& file) const override
+        {
+            // Written to a temporary file first, so that concurrent readers never see a partial side index.
+            const auto contents = file.side_index();
+            auto temporary = side_index_path_;
+            temporary += "." + std::to_string(reinterpret_cast<uintptr_t>(this)) + ".tmp";
+            {
+                std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+                if (!output.write(reinterpret_cast<char const*>(contents.data()), static_cast<std::streamsize>(contents.size())))
+                    return;
+            }
+
+            std::error_code error;
+            std::filesystem::rename(temporary, side_index_path_, error);
+            if (error)
+                std::filesystem::remove(temporary, error);
+        }
+
+    private:
+        ifc::Environment::BlobHolderPtr blob_;
+        std::filesystem::path side_index_path_;
+        boost::iostreams::mapped_file_source side_index_;
+    };
+
+    // Layout of a shared side index segment: the header, then the side index. The segment is complete
+    // once `state` is Published, its creator sets it last.
+    struct SharedSideIndexHeader
+    {
+        static constexpr uint32_t Published = 1;
+
+        std::atomic<uint32_t> state;
+        int32_t creator; // Process id, 0 until the header is written
+        uint64_t size;
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared side indexes need lock-free atomics");
+
+    // A blob with its side index in shared memory.
+    class SharedSideIndexBlobHolder : public ifc::Environment::BlobHolder
+    {
+    public:
+        explicit SharedSideIndexBlobHolder(ifc::Environment::BlobHolderPtr blob)
+            : blob_(std::move(blob))
+            , name_(ifc::shared_side_index_name(blob_->view()))
+        {
+            attach();
+        }
+
+        ~SharedSideIndexBlobHolder() override
+        {
+#if defined(_WIN32)
+            if (mapping_)
+                UnmapViewOfFile(mapping_);
+            if (published_)
+                UnmapViewOfFile(published_);
+            for (auto handle : { handle_, published_handle_ })
+                if (handle)
+                    CloseHandle(handle);
+#else
+            if (mapping_)
+                munmap(mapping_, mapping_size_);
+#endif
+        }
+
+        SharedSideIndexBlobHolder(SharedSideIndexBlobHolder const&) = delete;
+        SharedSideIndexBlobHolder& operator=(SharedSideIndexBlobHolder const&) = delete;
+
+        ifc::File::BlobView view() const override
+        {
+            return blob_->view();
+        }
+
+        void prefetch(ifc::File::BlobView range) const override
+        {
+            blob_->prefetch(range);
+        }
+
+        bool fetches_on_demand() const override
+        {
+            return blob_->fetches_on_demand();
+        }
+
+        void fetch(ifc::File::BlobView range) const override
+        {
+            blob_->fetch(range);
+        }
+
+        std::span<std::byte const> side_index() const override
+        {
+            return !side_index_.empty() ? side_index_ : blob_->side_index();
+        }
+
+        void side_index_missing(ifc::File const& file) const override
+        {
+            publish(file.side_index());
+            blob_->side_index_missing(file);
+        }
+
+    private:
+        // The published side index, if its segment exists and is complete.
+        void attach()
+        {
+#if defined(_WIN32)
+            handle_ = OpenFileMappingA(FILE_MAP_READ, FALSE, name_.c_str());
+            if (!handle_)
+                return;
+            mapping_ = MapViewOfFile(handle_, FILE_MAP_READ, 0, 0, 0);
+            if (!mapping_)
+                return;
+            MEMORY_BASIC_INFORMATION info;
+            mapping_size_ = VirtualQuery(mapping_, &info, sizeof(info)) ? info.RegionSize : 0;
+#else
+            const FileDescriptor fd(shm_open(name_.c_str(), O_RDONLY, 0));
+            struct stat status;
+            if (fd.get() < 0 || fstat(fd.get(), &status) != 0 || !is_private(status))
+                return;
+            const auto size = static_cast<size_t>(status.st_size);
+            if (size < sizeof(SharedSideIndexHeader))
+                return;
+            auto mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd.get(), 0);
+            if (mapping == MAP_FAILED)
+                return;
+            mapping_ = mapping;
+            mapping_size_ = size;
+#endif
+            if (mapping_size_ < sizeof(SharedSideIndexHeader))
+                return;
+            auto const & header = *static_cast<SharedSideIndexHeader const*>(mapping_);
+            if (header.state.load(std::memory_order_acquire) != SharedSideIndexHeader::Published
+                || header.size > mapping_size_ - sizeof(SharedSideIndexHeader))
+                return;
+            side_index_ = std::span(static_cast<std::byte const*>(mapping_) + sizeof(SharedSideIndexHeader), header.size);
+        }
+
+        // Only the process creating the segment writes it, the others keep building their own tables until it is published.
+        void publish(std::vector<std::byte> const& contents) const
+        {
+            const auto size = sizeof(SharedSideIndexHeader) + contents.size();
+            void* segment = nullptr;
+#if defined(_WIN32)
+            // The creating holder keeps the segment alive, Windows removes it along with its last handle.
+            auto handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                             static_cast<DWORD>(uint64_t{ size } >> 32), static_cast<DWORD>(size), name_.c_str());
+            if (!handle)
+                return;
+            if (GetLastError() == ERROR_ALREADY_EXISTS)
+            {
+                CloseHandle(handle);
+                return;
+            }
+            segment = MapViewOfFile(handle, FILE_MAP_WRITE, 0, 0, size);
+            if (!segment)
+            {
+                CloseHandle(handle);
+                return;
+            }
+            published_handle_ = handle;
+            published_ = segment;
+#else
+            auto created = shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (created < 0 && errno == EEXIST && remove_if_stale())
+                created = shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            const FileDescriptor fd(created);
+            if (fd.get() < 0)
+                return;
+            if (ftruncate(fd.get(), static_cast<off_t>(size)) != 0)
+            {
+                shm_unlink(name_.c_str());
+                return;
+            }
+            segment = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd.get(), 0);
+            if (segment == MAP_FAILED)
+            {
+                shm_unlink(name_.c_str());
+                return;
+            }
+#endif
+            auto header = new (segment) SharedSideIndexHeader{};
+#if !defined(_WIN32)
+            header->creator = static_cast<int32_t>(getpid());
+#endif
+            header->size = contents.size();
+            std::memcpy(static_cast<std::byte*>(segment) + sizeof(SharedSideIndexHeader), contents.data(), contents.size());
+            header->state.store(SharedSideIndexHeader::Published, std::memory_order_release);
+#if !defined(_WIN32)
+            munmap(segment, size);
+#endif
+        }
+
+#if !defined(_WIN32)
+        // Segments of other users could be written by them at any time, they are left alone.
+        static bool is_private(struct stat const& status)
+        {
+            return status.st_uid == geteuid() && (status.st_mode & (S_IRWXG | S_IRWXO)) == 0;
+        }
+
+        // Removes the segment if it will never be attached: its creator crashed before publishing it, it is
+        // corrupted, or others can access it (as older versions created it). Without a header yet, the segment is given a few seconds, its creator writes the header
+        // right after creating it. Two processes removing the same stale segment at once may remove the one
+        // created by the other instead, which is then built again.
+        bool remove_if_stale() const
+        {
+            constexpr time_t HeaderDelay = 10;
+
+            const FileDescriptor fd(shm_open(name_.c_str(), O_RDONLY, 0));
+            struct stat status;
+            if (fd.get() < 0 || fstat(fd.get(), &status) != 0 || status.st_uid != geteuid())
+                return false;
+            if (!is_private(status))
+                return shm_unlink(name_.c_str()) == 0;
 
-    BlobHolderImpl(std::filesystem::path const& path)
-        : file_mapping(path.string())
-    {}
+            bool stale = false;
+            const auto size = static_cast<size_t>(status.st_size);
+            const bool old = time(nullptr) - status.st_ctime > HeaderDelay;
+            if (size < sizeof(SharedSideIndexHeader))
+            {
+                stale = old;
+            }
+            else
+            {
+                auto mapping = mmap(nullptr, sizeof(SharedSideIndexHeader), PROT_READ, MAP_SHARED, fd.get(), 0);
+                if (mapping == MAP_FAILED)
+                    return false;
+                auto const & header = *static_cast<SharedSideIndexHeader const*>(mapping);
+                if (header.state.load(std::memory_order_acquire) == SharedSideIndexHeader::Published)
+                    stale = header.size > size - sizeof(SharedSideIndexHeader);
+                else if (header.creator == 0)
+                    stale = old;
+                else
+                    stale = kill(header.creator, 0) != 0 && errno == ESRCH;
+                munmap(mapping, sizeof(SharedSideIndexHeader));
+            }
+            return stale && shm_unlink(name_.c_str()) == 0;
+        }
+#endif
 
-    ifc::File::BlobView view() const override
+        ifc::Environment::BlobHolderPtr blob_;
+        std::string name_;
+        void* mapping_ = nullptr;
+        size_t mapping_size_ = 0;
+        std::span<std::byte const> side_index_;
+#if defined(_WIN32)
+        HANDLE handle_ = nullptr;
+        mutable HANDLE published_handle_ = nullptr;
+        mutable void* published_ = nullptr;
+#endif
+    };
+
+    // A blob read page by page through a RangeReader as its Files fetch parts of it, into lazily committed
+    // anonymous memory, optionally through a cache directory.
+    class RangeReadBlobHolder : public ifc::Environment::BlobHolder
+    {
+    public:
+        RangeReadBlobHolder(uint64_t size, ifc::RangeReader read_range, ifc::RangeReadOptions options)
+            : read_range_(std::move(read_range))
+            , size_(static_cast<size_t>(size))
+            , page_size_(std::max<size_t>(options.page_size, 1))
+            , page_count_((size_ + page_size_ - 1) / page_size_)
+            , present_(std::make_unique<std::atomic<bool>[]>(page_count_))
+        {
+            if (size_ != 0)
+            {
+#if defined(_WIN32)
+                data_ = static_cast<std::byte*>(VirtualAlloc(nullptr, size_, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+                if (!data_)
+                    throw std::bad_alloc();
+#else
+                auto mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (mapping == MAP_FAILED)
+                    throw std::bad_alloc();
+                data_ = static_cast<std::byte*>(mapping);
+#endif
+            }
+
+            if (!options.cache_directory.empty())
+                open_cache(options.cache_directory, options.key);
+        }
+
+        ~RangeReadBlobHolder() override
+        {
+            if (!data_)
+                return;
+#if defined(_WIN32)
+            VirtualFree(data_, 0, MEM_RELEASE);
+#else
+            munmap(data_, size_);
+#endif
+        }
+
+        RangeReadBlobHolder(RangeReadBlobHolder const&) = delete;
+        RangeReadBlobHolder& operator=(RangeReadBlobHolder const&) = delete;
+
+        ifc::File::BlobView view() const override
+        {
+            return { data_, size_ };
+        }
+
+        void prefetch(ifc::File::BlobView range) const override
+        {
+            try
+            {
+                fetch(range);
+            }
+            catch (std::exception const&)
+            {
+                // Only a hint, the File fetching the range reports the failure.
+            }
+        }
+
+        bool fetches_on_demand() const override
+        {
+            return true;
+        }
+
+        void fetch(ifc::File::BlobView range) const override
+        {
+            if (range.empty())
+                return;
+            const auto offset = static_cast<size_t>(range.data() - data_);
+            const auto first = offset / page_size_;
+            const auto last = (offset + range.size() - 1) / page_size_;
+            if (all_present(first, last))
+                return;
+
+            std::scoped_lock lock(mutex_);
+            for (auto page = first; page <= last;)
+            {
+                if (present_[page].load(std::memory_order_relaxed))
+                {
+                    ++page;
+                    continue;
+                }
+                // A run of missing pages, all in the cache or all to read.
+                const bool cached = is_cached(page);
+                auto end = page + 1;
+                while (end <= last && !present_[end].load(std::memory_order_relaxed) && is_cached(end) == cached)
+                    ++end;
+                read_pages(page, end, cached);
+                for (auto i = page; i != end; ++i)
+                    present_[i].store(true, std::memory_order_release);
+                page = end;
+            }
+        }
+
+    private:
+        bool all_present(size_t first, size_t last) const
+        {
+            for (auto page = first; page <= last; ++page)
+                if (!present_[page].load(std::memory_order_acquire))
+                    return false;
+            return true;
+        }
+
+        bool is_cached(size_t page) const
+        {
+            return page < cached_.size() && cached_[page] != 0;
+        }
+
+        void open_cache(std::filesystem::path const& directory, std::string const& key)
+        {
+            if (key.empty())
+                throw std::invalid_argument("a cache directory needs a key");
+            std::filesystem::create_directories(directory);
+            const auto data_path = directory / (key + ".ifc");
+            const auto pages_path = directory / (key + ".pages");
+            // Created empty if missing, without truncating the contents other holders wrote.
+            for (auto const & path : { data_path, pages_path })
+                std::ofstream(path, std::ios::binary | std::ios::app);
+
+            cache_data_.open(data_path, std::ios::binary | std::ios::in | std::ios::out);
+            cache_pages_.open(pages_path, std::ios::binary | std::ios::in | std::ios::out);
+            if (!cache_data_ || !cache_pages_)
+                throw std::runtime_error("cannot open the cache of '" + key + "' in '" + directory.string() + "'");
+
+            cached_.assign(page_count_, 0);
+            cache_pages_.read(cached_.data(), static_cast<std::streamsize>(cached_.size()));
+            cache_pages_.clear();
+        }
+
+        // Pages [first, end) from the cache or through the reader, which are then written to the cache.
+        void read_pages(size_t first, size_t end, bool cached) const
+        {
+            const auto offset = first * page_size_;
+            const auto size = std::min(end * page_size_, size_) - offset;
+            const std::span<std::byte> out(data_ + offset, size);
+            if (cached)
+            {
+                cache_data_.seekg(static_cast<std::streamoff>(offset));
+                if (cache_data_.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(size)))
+                    return;
+                // Truncated behind our back: read the pages again.
+                cache_data_.clear();
+            }
+
+            read_range_(offset, out);
+            if (!cache_data_.is_open())
+                return;
+
+            // The pages are marked only once they are written, failures just leave them out of the cache.
+            cache_data_.seekp(static_cast<std::streamoff>(offset));
+            if (!cache_data_.write(reinterpret_cast<char const*>(out.data()), static_cast<std::streamsize>(size)).flush())
+            {
+                cache_data_.clear();
+                return;
+            }
+            const std::string marks(end - first, '\1');
+            cache_pages_.seekp(static_cast<std::streamoff>(first));
+            if (!cache_pages_.write(marks.data(), static_cast<std::streamsize>(marks.size())).flush())
+                cache_pages_.clear();
+        }
+
+        ifc::RangeReader read_range_;
+        std::byte* data_ = nullptr;
+        size_t size_;
+        size_t page_size_;
+        size_t page_count_;
+        std::unique_ptr<std::atomic<bool>[]> present_;
+
+        mutable std::mutex mutex_; // Serializes reads, which write the pages
+        std::vector<char> cached_; // Pages the cache had when the holder was created
+        mutable std::fstream cache_data_;
+        mutable std::fstream cache_pages_;
+    };
+
+    // Signature and header, as File reads them.
+    struct FileStructure
+    {
+        std::array<std::byte, 4> signature;
+        ifc::FileHeader header;
+    };
+
+    // Zero-filled pages, unmapped when destroyed.
+    class AnonymousMapping
     {
-        return as_bytes(std::span(file_mapping.data(), file_mapping.size()));
+    public:
+        explicit AnonymousMapping(size_t size)
+            : size_(size)
+        {
+#if defined(_WIN32)
+            data_ = static_cast<std::byte*>(VirtualAlloc(nullptr, size_, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+            if (!data_)
+                throw std::bad_alloc();
+#else
+            auto mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapping == MAP_FAILED)
+                throw std::bad_alloc();
+            data_ = static_cast<std::byte*>(mapping);
+#endif
+        }
+
+        ~AnonymousMapping()
+        {
+#if defined(_WIN32)
+            VirtualFree(data_, 0, MEM_RELEASE);
+#else
+            munmap(data_, size_);
+#endif
+        }
+
+        AnonymousMapping(AnonymousMapping const&) = delete;
+        AnonymousMapping& operator=(AnonymousMapping const&) = delete;
+
+        std::byte* data() const { return data_; }
+        size_t size() const { return size_; }
+
+    private:
+        std::byte* data_ = nullptr;
+        size_t size_;
+    };
+
+    // Blob of a stream, received in offset order into one buffer by a thread of the holder. `received` only
+    // grows, fetches of bytes below it are plain loads. The thread shares the ownership of the reader and of
+    // the buffer, and is detached: a read can block for as long as the stream has nothing to send, so the
+    // holder does not wait for it, the thread stops once its read returns.
+    class StreamBlobHolder : public ifc::Environment::BlobHolder
+    {
+    public:
+        explicit StreamBlobHolder(ifc::StreamReader read)
+        {
+            FileStructure structure;
+            const auto header = std::as_writable_bytes(std::span(&structure, 1));
+            if (read_fully(read, header) != header.size())
+                throw std::runtime_error("stream ended within the header of its BMI");
+
+            // With the table of contents last, it or the string table ends the blob. With both right after the
+            // header (see FileWriter::Layout), they are read first and the partitions they list end it.
+            auto const & file_header = structure.header;
+            const auto toc_end = static_cast<size_t>(file_header.toc) + raw_count(file_header.partition_count) * sizeof(ifc::PartitionSummary);
+            const auto strings_end = static_cast<size_t>(file_header.string_table_bytes) + raw_count(file_header.string_table_size);
+            auto size = std::max({ toc_end, strings_end, header.size() });
+            std::vector<std::byte> tables;
+            if (static_cast<size_t>(file_header.string_table_bytes) == header.size() || static_cast<size_t>(file_header.toc) == header.size())
+            {
+                tables.resize(size - header.size());
+                if (read_fully(read, tables) != tables.size())
+                    throw std::runtime_error("stream ended within the tables of its BMI");
+                const auto toc = std::span(tables).subspan(static_cast<size_t>(file_header.toc) - header.size(), toc_end - static_cast<size_t>(file_header.toc));
+                for (size_t offset = 0; offset != toc.size(); offset += sizeof(ifc::PartitionSummary))
+                {
+                    ifc::PartitionSummary partition;
+                    std::memcpy(&partition, toc.data() + offset, sizeof(partition));
+                    size = std::max(size, static_cast<size_t>(partition.offset) + partition.size_bytes());
+                }
+            }
+
+            stream_ = std::make_shared<Stream>(std::move(read), size);
+            const auto data = stream_->buffer.data();
+            std::memcpy(data, header.data(), header.size());
+            if (!tables.empty())
+                std::memcpy(data + header.size(), tables.data(), tables.size());
+            stream_->received.store(header.size() + tables.size(), std::memory_order_release);
+            std::thread([stream = stream_] { stream->receive(); }).detach();
+        }
+
+        ~StreamBlobHolder() override
+        {
+            stream_->stop.store(true, std::memory_order_relaxed);
+        }
+
+        StreamBlobHolder(StreamBlobHolder const&) = delete;
+        StreamBlobHolder& operator=(StreamBlobHolder const&) = delete;
+
+        ifc::File::BlobView view() const override
+        {
+            return { stream_->buffer.data(), stream_->buffer.size() };
+        }
+
+        bool fetches_on_demand() const override
+        {
+            return true;
+        }
+
+        void fetch(ifc::File::BlobView range) const override
+        {
+            if (range.empty())
+                return;
+            auto & stream = *stream_;
+            const auto end = static_cast<size_t>(range.data() - stream.buffer.data()) + range.size();
+            if (stream.received.load(std::memory_order_acquire) >= end)
+                return;
+
+            std::unique_lock lock(stream.mutex);
+            stream.arrived.wait(lock, [&] { return stream.received.load(std::memory_order_acquire) >= end || stream.done; });
+            if (stream.received.load(std::memory_order_acquire) >= end)
+                return;
+            if (stream.error)
+                std::rethrow_exception(stream.error);
+            throw std::runtime_error("stream ended before the end of its BMI");
+        }
+
+    private:
+        static size_t read_fully(ifc::StreamReader const& read, std::span<std::byte> out)
+        {
+            size_t count = 0;
+            while (count != out.size())
+            {
+                const auto result = read(out.subspan(count));
+                if (result == 0)
+                    break;
+                count += result;
+            }
+            return count;
+        }
+
+        // What the receiving thread shares with the holder.
+        struct Stream
+        {
+            Stream(ifc::StreamReader read, size_t size)
+                : read(std::move(read))
+                , buffer(size)
+            {
+            }
+
+            void receive()
+            {
+                try
+                {
+                    auto received_so_far = received.load(std::memory_order_relaxed);
+                    while (received_so_far != buffer.size() && !stop.load(std::memory_order_relaxed))
+                    {
+                        const auto result = read({ buffer.data() + received_so_far, buffer.size() - received_so_far });
+                        if (result == 0)
+                            break;
+                        received_so_far += result;
+                        {
+                            std::scoped_lock lock(mutex);
+                            received.store(received_so_far, std::memory_order_release);
+                        }
+                        arrived.notify_all();
+                    }
+                }
+                catch (...)
+                {
+                    std::scoped_lock lock(mutex);
+                    error = std::current_exception();
+                }
+                {
+                    std::scoped_lock lock(mutex);
+                    done = true;
+                }
+                arrived.notify_all();
+            }
+
+            ifc::StreamReader read;
+            AnonymousMapping buffer;
+            std::atomic<size_t> received = 0;
+            std::atomic<bool> stop = false;
+
+            std::mutex mutex;
+            std::condition_variable arrived;
+            bool done = false; // Guarded by mutex, as is error
+            std::exception_ptr error;
+        };
+
+        std::shared_ptr<Stream> stream_;
+    };
+
+    ifc::Environment::BlobHolderPtr read_blob_with(std::filesystem::path const& file, ifc::BlobReadOptions options)
+    {
+        if (options.shared_side_index)
+        {
+            options.shared_side_index = false;
+            return std::make_unique<SharedSideIndexBlobHolder>(read_blob_with(file, options));
+        }
+
+        if (options.side_index)
+        {
+            options.side_index = false;
+            return std::make_unique<SideIndexedBlobHolder>(read_blob_with(file, options), file);
+        }
+
+        switch (options.backing)
+        {
+        case ifc::BlobBacking::MappedPopulated:
+#if !defined(_WIN32)
+        {
+            auto holder = std::make_unique<PopulatedBlobHolder>(file);
+            apply_access_hint(holder->view(), options.access);
+            return holder;
+        }
+#else
+            // Windows has no MAP_POPULATE, fault the pages in with a prefetch instead.
+            options.access = ifc::BlobAccess::WillNeed;
+            [[fallthrough]];
+#endif
+        case ifc::BlobBacking::Mapped:
+        {
+            auto holder = std::make_unique<MappedBlobHolder>(file);
+            apply_access_hint(holder->view(), options.access);
+            return holder;
+        }
+        case ifc::BlobBacking::HugePageBuffer:
+        case ifc::BlobBacking::DirectRead:
+            return std::make_unique<BufferBlobHolder>(file, options.backing);
+        }
+        throw std::invalid_argument("unknown blob backing");
     }
-};
+}
 
 ifc::Environment::BlobHolderPtr ifc::read_blob(std::filesystem::path const& file)
 {
-    return std::make_unique<BlobHolderImpl>(file);
+    return std::make_unique<MappedBlobHolder>(file);
+}
+
+std::filesystem::path ifc::side_index_path(std::filesystem::path const& file)
+{
+    auto result = file;
+    result += ".idx";
+    return result;
+}
+
+std::string ifc::shared_side_index_name(File::BlobView blob)
+{
+    // Short enough for the 31 characters macOS allows: the first 8 bytes of the checksum
+    // (which follows the 4-byte signature) and the low 32 bits of the size.
+    constexpr size_t signature_size = 4;
+    char name[32];
+    uint64_t checksum = 0;
+    if (blob.size() >= signature_size + sizeof(checksum))
+        std::memcpy(&checksum, blob.data() + signature_size, sizeof(checksum));
+    std::snprintf(name, sizeof(name), "/ifcx%016llx%08x", static_cast<unsigned long long>(checksum), static_cast<unsigned>(blob.size()));
+#if defined(_WIN32)
+    // Names of the Local\ namespace have no leading slash.
+    return std::string("Local\\") + (name + 1);
+#else
+    return name;
+#endif
+}
+
+bool ifc::remove_shared_side_index(File::BlobView blob)
+{
+#if defined(_WIN32)
+    (void)blob;
+    return false;
+#else
+    return shm_unlink(shared_side_index_name(blob).c_str()) == 0;
+#endif
+}
+
+ifc::Environment::FileReader ifc::blob_reader(BlobReadOptions options)
+{
+    return [options](std::filesystem::path const& file) {
+        return read_blob_with(file, options);
+    };
+}
+
+ifc::Environment::BlobHolderPtr ifc::read_blob_ranges(uint64_t size, RangeReader read_range, RangeReadOptions options)
+{
+    return std::make_unique<RangeReadBlobHolder>(size, std::move(read_range), std::move(options));
+}
+
+ifc::Environment::BlobHolderPtr ifc::read_blob_stream(StreamReader read)
+{
+    return std::make_unique<StreamBlobHolder>(std::move(read));
+}
+
+ifc::Environment::BlobHolderPtr ifc::read_zstd_blob(std::filesystem::path const& file)
+{
+    return std::make_unique<DecompressedBlobHolder>(file);
+}
+
+std::future<ifc::Environment::BlobHolderPtr> ifc::read_blob_async(std::filesystem::path const& file)
+{
+    return std::async(std::launch::async, read_blob, file);
+}
+
+void ifc::read_blobs(std::span<std::filesystem::path const> paths, std::function<void(BatchReadResult)> const& on_read, BatchReadOptions options)
+{
+    // Blocking reads on a pool of their own, so that `queue_depth` reads are in flight
+    // regardless of how busy the default executor is.
+    ThreadPool pool(std::max(1u, options.queue_depth));
+    std::mutex on_read_mutex;
+    pool.run(paths.size(), [&](size_t i) {
+        BatchReadResult result{ .index = i };
+        try
+        {
+            result.blob = read_blob_with(paths[i], options.blob);
+        }
+        catch (...)
+        {
+            result.error = std::current_exception();
+        }
+
+        std::scoped_lock lock(on_read_mutex);
+        on_read(std::move(result));
+    });
+}
+
+ifc::Environment::Config ifc::discover_bmis(std::span<std::filesystem::path const> directories, Executor& executor)
+{
+    struct Candidate
+    {
+        size_t directory;
+        std::filesystem::path bmi;
+        UnitSort sort = UnitSort::Source;
+        std::string name; // Empty for other units
+    };
+
+    std::vector<Candidate> candidates;
+    for (size_t i = 0; i != directories.size(); ++i)
+    {
+        for (auto const & entry : std::filesystem::recursive_directory_iterator(directories[i], std::filesystem::directory_options::skip_permission_denied))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".ifc")
+                candidates.push_back({ .directory = i, .bmi = entry.path() });
+        }
+    }
+    // Deterministic errors and results regardless of the order directories list their entries in.
+    std::ranges::sort(candidates, [](Candidate const & a, Candidate const & b) {
+        return std::tie(a.directory, a.bmi) < std::tie(b.directory, b.bmi);
+    });
+
+    executor.run(candidates.size(), [&](size_t i) {
+        auto & candidate = candidates[i];
+        const auto blob = read_blob_with(candidate.bmi, { .access = BlobAccess::Random });
+        try
+        {
+            const auto peek = peek_file(blob->view());
+            candidate.sort = peek.header.unit.sort();
+            candidate.name = peek.unit_name;
+        }
+        catch (std::exception const & e)
+        {
+            throw std::runtime_error(candidate.bmi.string() + ": " + e.what());
+        }
+    });
+
+    Environment::Config config;
+    std::unordered_map<std::string_view, Candidate const*> found;
+    for (auto const & candidate : candidates)
+    {
+        if (candidate.name.empty())
+            continue;
+        const auto [it, inserted] = found.try_emplace(candidate.name, &candidate);
+        if (inserted)
+        {
+            if (candidate.sort == UnitSort::Header)
+                config.imported_header_units.push_back({ candidate.name, candidate.bmi });
+            else
+                config.imported_modules.push_back({ candidate.name, candidate.bmi });
+        }
+        else if (it->second->directory == candidate.directory)
+        {
+            throw std::invalid_argument("'" + candidate.name + "' is the unit of both " + it->second->bmi.string() + " and " + candidate.bmi.string());
+        }
+    }
+    return config;
 }
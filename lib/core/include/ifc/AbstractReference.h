@@ -1,6 +1,8 @@
 #pragma once
 
+#include <compare>
 #include <type_traits>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 
@@ -11,6 +13,8 @@ namespace ifc
     struct AbstractReference
     {
         using Sort = _Sort;
+        // Number of distinct sorts the tag can hold.
+        static constexpr size_t SortCount = size_t{ 1 } << N;
 
         uint32_t tag    : N;
         uint32_t index  : 32 - N;
@@ -25,7 +29,16 @@ namespace ifc
             return tag == 0 && index == 0;
         }
 
-        auto operator<=>(const AbstractReference& rhs) const = default;
+        // Not defaulted: bit-fields of a defaulted <=> are compared after promotion to int,
+        // which is a narrowing conversion, so the defaulted operator is deleted.
+        std::strong_ordering operator<=>(const AbstractReference& rhs) const
+        {
+            if (auto cmp = static_cast<uint32_t>(tag) <=> static_cast<uint32_t>(rhs.tag); cmp != 0)
+                return cmp;
+            return static_cast<uint32_t>(index) <=> static_cast<uint32_t>(rhs.index);
+        }
+
+        bool operator==(const AbstractReference& rhs) const = default;
     };
 }
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ifc
+{
+    // Heap allocations through the global operator new, counted per thread when the library is built with
+    // IFC_READER_COUNT_ALLOCATIONS (which replaces it), to check that read paths do not allocate.
+    struct AllocationCount
+    {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+#ifdef IFC_COUNT_ALLOCATIONS
+    inline constexpr bool counts_allocations = true;
+#else
+    inline constexpr bool counts_allocations = false;
+#endif
+
+    // Allocations of the calling thread so far, zero unless counts_allocations.
+    AllocationCount thread_allocations();
+
+    // Allocations of the calling thread since construction, e.g. of one API call.
+    class AllocationScope
+    {
+    public:
+        AllocationScope()
+            : start_(thread_allocations())
+        {
+        }
+
+        AllocationCount count() const
+        {
+            const auto now = thread_allocations();
+            return { now.allocations - start_.allocations, now.bytes - start_.bytes };
+        }
+
+    private:
+        AllocationCount start_;
+    };
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Environment.h"
+#include "File.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ifc
+{
+    // Many BMIs packed into one blob, e.g. all header units of a build, so they are opened, mapped and
+    // looked up once: a table of contents of the members sorted by name, the string tables and the members,
+    // each a BMI stored without its string table. Members are read in place, see `file_reader`.
+    // Members share one string table, each distinct string stored once, their text offsets rewritten to it.
+    // Those with partitions of unknown layouts (see ifc_partition_fields) keep the offsets the compiler wrote
+    // and their own table, which they share only with members whose table is equal to it or starts with it.
+    class Bundle
+    {
+    public:
+        struct Member
+        {
+            std::string_view name;
+            File::BlobView blob;
+            std::span<char const> string_table; // See FileOptions::string_table
+        };
+
+        struct Entry
+        {
+            std::string name;
+            File const* file;
+        };
+
+        // Throws std::invalid_argument if two entries have the same name.
+        static std::vector<std::byte> write(std::span<Entry const>);
+
+        // Throws std::runtime_error if the blob is not a bundle.
+        explicit Bundle(Environment::BlobHolderPtr);
+
+        size_t size() const { return members_.size(); }
+
+        // In name order.
+        Member operator[](size_t) const;
+
+        std::optional<Member> find(std::string_view name) const;
+
+        // Reads the member named as the generic form of the path, or the file itself with `fallback`.
+        // Throws std::out_of_range for other paths. The bundle must outlive the Environment.
+        Environment::FileReader file_reader(Environment::FileReader fallback = {}) const;
+
+    private:
+        struct MemberRecord
+        {
+            uint64_t offset;
+            uint64_t size;
+            uint32_t name_offset;
+            uint32_t name_size;
+            uint32_t string_table;
+            uint32_t reserved;
+        };
+
+        struct StringTableRecord
+        {
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        Environment::BlobHolderPtr holder_;
+        File::BlobView blob_;
+        std::span<MemberRecord const> members_;
+        std::span<StringTableRecord const> string_tables_;
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+
+namespace ifc
+{
+    // Thrown by operations whose CancellationToken was cancelled or ran past its deadline.
+    class Cancelled : public std::runtime_error
+    {
+    public:
+        Cancelled()
+            : std::runtime_error("Operation cancelled")
+        {
+        }
+    };
+
+    // Stops a long-running operation, e.g. an editor query superseded by a newer one, either when cancelled
+    // from any thread or once its deadline has passed. Operations check it between chunks of their work
+    // (see CancellationInterval) and throw Cancelled, which bounds their latency to about one chunk.
+    class CancellationToken
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        CancellationToken() = default;
+        explicit CancellationToken(Clock::time_point deadline)
+            : deadline_(deadline)
+        {
+        }
+
+        static CancellationToken after(Clock::duration timeout) { return CancellationToken(Clock::now() + timeout); }
+
+        CancellationToken(CancellationToken const&) = delete;
+        CancellationToken& operator=(CancellationToken const&) = delete;
+
+        void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+        bool cancelled() const
+        {
+            if (cancelled_.load(std::memory_order_relaxed))
+                return true;
+            return deadline_ != Clock::time_point::max() && Clock::now() >= deadline_;
+        }
+
+        void throw_if_cancelled() const
+        {
+            if (cancelled())
+                throw Cancelled();
+        }
+
+    private:
+        std::atomic<bool> cancelled_ = false;
+        Clock::time_point deadline_ = Clock::time_point::max();
+    };
+
+    // Token of the calling thread, checked by work that takes no token of its own, notably the index builds
+    // of File::get_index. Null unless a CancellationScope installed one. for_each_parallel passes it on to
+    // its tasks.
+    CancellationToken const* current_cancellation();
+
+    // Installs a token for the calling thread for its lifetime, null installs none.
+    class CancellationScope
+    {
+    public:
+        explicit CancellationScope(CancellationToken const* token);
+        ~CancellationScope();
+
+        CancellationScope(CancellationScope const&) = delete;
+        CancellationScope& operator=(CancellationScope const&) = delete;
+
+    private:
+        CancellationToken const* outer_;
+    };
+
+    // Throws Cancelled if the token of the calling thread was cancelled.
+    void check_cancellation();
+
+    // Iterations between checks of loops over the elements of a partition, so that checks (reading the
+    // clock for deadlines) stay out of the profile.
+    constexpr size_t CancellationInterval = 1024;
+
+    inline void poll_cancellation(CancellationToken const* token, size_t iteration)
+    {
+        if (token != nullptr && iteration % CancellationInterval == 0)
+            token->throw_if_cancelled();
+    }
+
+    inline void poll_cancellation(size_t iteration)
+    {
+        if (iteration % CancellationInterval == 0)
+            check_cancellation();
+    }
+}
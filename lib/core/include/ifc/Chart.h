@@ -23,9 +23,9 @@ namespace ifc
         PARTITION_SORT(ChartSort::Unilevel);
     };
 
-    struct ChartMultilevel
+    // Charts of each level, outermost first, in `heap.chart`.
+    struct ChartMultilevel : Sequence
     {
-
         PARTITION_NAME("chart.multilevel");
         PARTITION_SORT(ChartSort::Multilevel);
     };
@@ -377,6 +377,23 @@ namespace ifc
         PARTITION_SORT(DeclSort::Field);
     };
 
+    struct BitfieldDeclaration
+    {
+        TextOffset name;
+        SourceLocation locus;
+        TypeIndex type;
+        DeclIndex home_scope;
+        ExprIndex width;
+        ExprIndex initializer;
+        ObjectTraits traits;
+        BasicSpecifiers specifiers;
+        Access access;
+        ReachableProperties properties;
+
+        PARTITION_NAME("decl.bitfield");
+        PARTITION_SORT(DeclSort::Bitfield);
+    };
+
     enum class ParameterSort : uint8_t
     {
         Object,     // Function parameter
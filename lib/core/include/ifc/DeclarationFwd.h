@@ -11,6 +11,7 @@ namespace ifc
     struct DeclReference;
     struct VariableDeclaration;
     struct FieldDeclaration;
+    struct BitfieldDeclaration;
     struct ParameterDeclaration;
     struct ScopeDeclaration;
     struct FunctionDeclaration;
@@ -1,15 +1,104 @@
 #pragma once
 
+#include "Cancellation.h"
 #include "File.h"
+#include "FileDiff.h"
+#include "FileWatcher.h"
+#include "Parallel.h"
+#include "SymbolTable.h"
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace ifc
 {
+    class SharedBMIStore;
+
+    // Dense number of a File within an Environment, see Environment::file_id.
+    enum class FileId : uint32_t {};
+
+    // A declaration of any module of an Environment, in 8 bytes. Ordered by file, then declaration.
+    struct DeclarationId
+    {
+        FileId file{};
+        DeclIndex decl{};
+
+        bool operator==(DeclarationId const&) const = default;
+        std::strong_ordering operator<=>(DeclarationId const&) const = default;
+    };
+
+    static_assert(sizeof(DeclarationId) == 8);
+
+    // Set of FileIds of an Environment, a bit per id.
+    class FileIdSet
+    {
+    public:
+        bool contains(FileId id) const
+        {
+            const auto i = static_cast<uint32_t>(id);
+            return i / 64 < words_.size() && (words_[i / 64] >> (i % 64) & 1) != 0;
+        }
+
+        void insert(FileId id)
+        {
+            const auto i = static_cast<uint32_t>(id);
+            if (i / 64 >= words_.size())
+                words_.resize(i / 64 + 1);
+            words_[i / 64] |= uint64_t{ 1 } << (i % 64);
+        }
+
+        void merge(FileIdSet const& other)
+        {
+            if (other.words_.size() > words_.size())
+                words_.resize(other.words_.size());
+            for (size_t i = 0; i != other.words_.size(); ++i)
+                words_[i] |= other.words_[i];
+        }
+
+        size_t size() const
+        {
+            size_t result = 0;
+            for (auto word : words_)
+                result += static_cast<size_t>(std::popcount(word));
+            return result;
+        }
+
+        // Calls `visit(id)` for every id, in increasing order.
+        template<typename Visit>
+        void for_each(Visit visit) const
+        {
+            for (size_t i = 0; i != words_.size(); ++i)
+            {
+                for (auto word = words_[i]; word != 0; word &= word - 1)
+                    visit(FileId{ static_cast<uint32_t>(i * 64 + static_cast<size_t>(std::countr_zero(word))) });
+            }
+        }
+
+        size_t heap_bytes() const { return words_.capacity() * sizeof(uint64_t); }
+
+    private:
+        std::vector<uint64_t> words_;
+    };
+
+    // Loads BMIs on demand and keeps them loaded for its lifetime, or, with a memory budget,
+    // until they are evicted.
+    // Safe to use from multiple threads: a BMI requested by several threads at once is loaded
+    // only once, while loads of different BMIs run concurrently.
     class Environment
     {
     public:
@@ -17,11 +106,28 @@ namespace ifc
         {
         public:
             virtual File::BlobView view() const = 0;
+            // Hint that a part of the view will be read soon.
+            virtual void prefetch(File::BlobView) const {}
+            // Side index stored with the blob (see FileOptions::side_index), empty if there is none.
+            virtual std::span<std::byte const> side_index() const { return {}; }
+            // Called after a File was constructed from the view without using the side index,
+            // e.g. to store File::side_index for the next process.
+            virtual void side_index_missing(File const&) const {}
+            // String table of a view stored without one (see FileOptions::string_table), e.g. a Bundle member.
+            virtual std::span<char const> string_table() const { return {}; }
+            // Holders of blobs fetched on demand, whose views are readable only where `fetch` made them so,
+            // see FileOptions::fetch. Views of the other holders are readable as a whole.
+            virtual bool fetches_on_demand() const { return false; }
+            virtual void fetch(File::BlobView) const {}
             virtual ~BlobHolder() = default;
         };
 
         using BlobHolderPtr = std::unique_ptr<BlobHolder>;
 
+        using FileReader      = std::function<BlobHolderPtr(std::filesystem::path const &)>;
+        // Starts reading the file and returns without waiting for it.
+        using AsyncFileReader = std::function<std::future<BlobHolderPtr>(std::filesystem::path const &)>;
+
         struct Config
         {
             struct HeaderUnit
@@ -40,12 +146,271 @@ namespace ifc
             std::vector<Module> imported_modules;
         };
 
-        File const& get_module_by_bmi_path(std::filesystem::path const &);
+        // Module and header unit names mapped to their BMIs. Immutable once built, so one map,
+        // e.g. merged from the configs of every translation unit of a project, can be shared by many Environments.
+        class ModuleMap
+        {
+        public:
+            // Module name split into the parts stored in a ModuleReference: "owner:partition",
+            // or just "owner", or "partition" alone for header units and the global module.
+            struct NameParts
+            {
+                std::string_view owner;
+                std::string_view partition;
+            };
+
+            ModuleMap() = default;
+            explicit ModuleMap(Config config);
+
+            // Throws std::invalid_argument if a name is already mapped to a different BMI.
+            void add(Config config);
+
+            // Lookups do not allocate.
+            std::filesystem::path const* find(std::string_view name) const;
+            std::filesystem::path const* find(NameParts name) const;
+            size_t size() const { return bmis_.size(); }
+
+        private:
+            void add(std::string name, std::filesystem::path bmi);
+
+            // Hashes names and name parts alike, as if the parts were joined.
+            struct NameHash
+            {
+                using is_transparent = void;
+
+                size_t operator()(std::string_view) const noexcept;
+                size_t operator()(NameParts) const noexcept;
+            };
+
+            struct NameEqual
+            {
+                using is_transparent = void;
+
+                bool operator()(std::string_view a, std::string_view b) const noexcept { return a == b; }
+                bool operator()(std::string_view, NameParts) const noexcept;
+                bool operator()(NameParts a, std::string_view b) const noexcept { return (*this)(b, a); }
+            };
+
+            std::unordered_map<std::string, std::filesystem::path, NameHash, NameEqual> bmis_;
+        };
+
+        // Loads a caller waits for come first. Speculative loads, like those of prefetch_transitive, neither
+        // read nor parse their BMI while a foreground load is in progress, and a foreground request of a BMI
+        // whose speculative load is still waiting loads it itself. Either way a BMI is loaded once.
+        enum class LoadPriority
+        {
+            Foreground,
+            Speculative,
+        };
+
+        // BMIs returned by reference are pinned: they are never evicted.
+        File const& get_module_by_bmi_path(std::filesystem::path const &, LoadPriority = LoadPriority::Foreground);
+        // Starts loading the BMI (in the background with an AsyncFileReader) and returns a future
+        // that waits for it. Lets loading overlap with processing of already loaded modules.
+        // Speculative loads only start reading once the future is waited for.
+        std::future<File const&> load_module_by_bmi_path(std::filesystem::path const &, LoadPriority = LoadPriority::Foreground);
+        // Throws std::out_of_range if the referenced module is not in the config.
         File const& get_referenced_module(struct ModuleReference, File const&);
+        // Files of the modules into `out` (of the same size), each the one get_referenced_module returns.
+        // Every distinct module is looked up once, and the BMIs not loaded yet are all started before any of
+        // them is waited for, one per task, so a whole import list costs one parallel batch.
+        // Throws std::out_of_range, before loading any of them, if a module is not in the config.
+        void resolve_all(File const&, std::span<struct ModuleReference const> modules, std::span<File const*> out, Executor& = default_executor());
+
+        // Modules of the file's imported_modules() and exported_modules() in partition order,
+        // resolved (and loaded) once per file. Throws std::out_of_range if any of them is not in the config.
+        std::span<File const* const> imported_files(File const&);
+        std::span<File const* const> exported_files(File const&);
+
+        // Modules whose declarations the file makes visible to its importers: the file itself and, transitively,
+        // the modules it re-exports (`export import`), by FileId. Memoized per file, the closures of the re-exported
+        // modules are computed first and merged, so every closure is computed once. Re-exports leading back into
+        // a cycle (invalid input) only contribute their own module. Like imported_files, closures keep the ids of
+        // the versions of the modules they were computed with. Throws std::out_of_range if a re-exported module
+        // is not in the config.
+        FileIdSet const& transitive_exports(File const&);
+
+        struct ResolvedDeclaration
+        {
+            File const* file;
+            DeclIndex decl;
+        };
+
+        // Declaration a "decl.reference" of the file finally refers to, following references to references.
+        // Memoized, repeated resolutions are a single lookup.
+        ResolvedDeclaration resolve_reference(File const&, DeclIndex reference);
+
+        // Declarations of all the "decl.reference"s of the file by index, each the one resolve_reference
+        // returns, resolved together on first use: the references are grouped by module, so that each module is
+        // looked up (and loaded) once, and following a designation into another module is then one array load.
+        // References into modules that are not in the environment have a null file.
+        std::span<ResolvedDeclaration const> resolve_all_references(File const&);
+
+        // Refcounted access to BMIs, a BMI can only be evicted while no handles to it exist.
+        using ModuleHandle = std::shared_ptr<File const>;
+
+        ModuleHandle acquire_module_by_bmi_path(std::filesystem::path const &);
+        ModuleHandle acquire_referenced_module(struct ModuleReference, File const&);
+
+        struct Reload
+        {
+            ModuleHandle module;
+            // False if the BMI was not loaded before, it is just loaded then and `diff` is empty.
+            bool reloaded = false;
+            // Of the version loaded before, equal to the one of `module` if the BMI is unchanged.
+            SHA256 previous_checksum{};
+            FileDiff diff{};
+            // Indexes shared with the previous version, see File::adopt_indexes.
+            size_t adopted_indexes = 0;
+        };
+
+        // Reads the BMI again, e.g. after it was rebuilt. With an unchanged checksum the loaded File is kept,
+        // otherwise the new one is used from now on and shares the indexes of the previous version that only
+        // depend on unchanged partitions. The previous version stays valid while handles to it exist, and for
+        // the lifetime of the Environment if it was returned by reference. Modules that already resolved their
+        // imports to it keep referring to it.
+        Reload reload_module_by_bmi_path(std::filesystem::path const &);
+
+        // Watches the BMIs loaded from now on for changes on disk (see FileWatcher). A changed BMI is dropped
+        // from the cache on the next request of any module and read again when it is requested itself. Versions
+        // dropped this way stay valid like the ones replaced by reload_module_by_bmi_path, but a BMI rewritten
+        // in place (rather than replaced by a rename) may be truncated under them: only use them to release them.
+        // Not synchronized with loads, call it before loading any module.
+        void watch_for_changes();
+
+        // Number of BMIs dropped because they changed on disk so far. Callers keeping Files (or handles) around
+        // can compare it with the value at the time they acquired them to tell whether to acquire them again.
+        uint64_t generation() const;
+
+        // Once the total size of loaded BMIs exceeds the budget, the least recently acquired BMIs
+        // that are neither pinned nor held by handles are unloaded. Unlimited by default.
+        void set_memory_budget(size_t bytes);
+        size_t loaded_bytes() const;
+
+        // Memory of the loaded BMIs (see File::memory_usage) and of the Environment's own resolution caches.
+        // BMIs shared through a SharedBMIStore are counted by every Environment using them.
+        struct MemoryUsage
+        {
+            size_t modules = 0;
+            size_t mapped_bytes = 0;
+            std::optional<size_t> resident_bytes; // Empty if it cannot be queried for some BMI
+            size_t file_heap_bytes = 0;
+            size_t environment_heap_bytes = 0;
+        };
+
+        MemoryUsage memory_usage() const;
+
+        // Trims the loaded BMIs (see File::trim) under memory pressure, least recently acquired first, until their
+        // `file_heap_bytes` (see memory_usage) are at most `heap_bytes`: the BMIs stay loaded, the most recently
+        // used ones keep their indexes the longest. The Environment's own resolution caches are kept.
+        // Returns the heap bytes released. Not safe while other threads use the BMIs, like File::trim.
+        size_t trim(TrimLevel, size_t heap_bytes = 0);
+
+        // Adds the partitions each loaded BMI has accessed so far (see File::accessed_partitions), e.g. at the end
+        // of a run, to prefetch them in the next one through FileOptions::access_profile.
+        void record_access_profile(AccessProfile&) const;
+
+        // Dense ids of Files, numbered from 0: modules get theirs when loaded, Files the Environment did not
+        // load (which must outlive their use) when first asked for. Ids are never reused, the id of an evicted
+        // or dropped module no longer maps to a File. Lookups by id take no locks.
+        FileId file_id(File const&);
+        // Null if the id maps to no File (anymore).
+        File const* file(FileId) const;
+        // Ids so far are [0, file_id_count()).
+        uint32_t file_id_count() const { return file_id_count_.load(std::memory_order_acquire); }
+
+        DeclarationId declaration_id(File const& file, DeclIndex decl) { return { file_id(file), decl }; }
+
+        // Identifiers and other texts of all modules as integers, e.g. `symbols().symbol(file, offset)`.
+        // Tables of modules are built on first use, or ahead with `symbols().intern(files)`, and dropped
+        // with the modules.
+        SymbolTable& symbols() { return symbols_; }
+
+        class Snapshot;
+
+        // The set of loaded modules, shared by every caller until it changes. After a load, reload, drop or
+        // eviction, the next call publishes a new snapshot; older ones keep their modules alive until their
+        // last holder releases them, so readers keep working with them while modules are reloaded.
+        std::shared_ptr<Snapshot const> snapshot();
+
+        // Loads every module reachable from the file through imports and exports, level by level,
+        // with the modules of each level loaded in parallel, as speculative loads. Modules missing from the
+        // config are skipped.
+        // The token (by default the one of the calling thread) is checked before each load, once it is
+        // cancelled the loads in progress finish and Cancelled is thrown, the loaded modules stay loaded.
+        void prefetch_transitive(File const&, Executor& = default_executor(), CancellationToken const* = nullptr);
+
+        struct GlobalIndexOptions
+        {
+            std::vector<std::filesystem::path> bmis;
+            // Validates each File (see File::validate) before indexing it.
+            bool validate = true;
+            // Builds the per-file indexes of a File, e.g. `file.get_index<...>()`, besides its text symbols.
+            // Called concurrently for different Files.
+            std::function<void(File const&)> build_file_indexes;
+            // Merges a File into global indexes of the caller once its symbols are interned (see symbols()).
+            // Calls are serialized.
+            std::function<void(File const&, FileId)> merge;
+            // Files a stage may have finished or have in progress before the next stage takes them,
+            // so that loading does not run ahead of indexing by more than that.
+            size_t queue_capacity = 16;
+            // Tasks of the executor taking part in the pipeline, 0 means one per hardware thread.
+            unsigned workers = 0;
+            Executor* executor = nullptr; // default_executor() if null
+        };
+
+        struct GlobalIndexStats
+        {
+            struct Stage
+            {
+                size_t files = 0;
+                size_t bytes = 0; // Blob sizes of the files
+                std::chrono::nanoseconds busy{}; // Summed over the workers
+                std::chrono::nanoseconds elapsed{}; // From the start of the first file to the end of the last one
+
+                double files_per_second() const { return elapsed.count() == 0 ? 0 : files * 1e9 / static_cast<double>(elapsed.count()); }
+                double bytes_per_second() const { return elapsed.count() == 0 ? 0 : bytes * 1e9 / static_cast<double>(elapsed.count()); }
+            };
+
+            std::vector<File const*> files; // Pinned, by index of GlobalIndexOptions::bmis
+            Stage load;
+            Stage validate;
+            Stage index;
+            Stage merge;
+            std::chrono::nanoseconds elapsed{};
+        };
+
+        // Loads, validates, indexes (text symbols and build_file_indexes) and merges (symbols() and `merge`) the
+        // BMIs as overlapping pipeline stages: each worker of the executor takes a file of the latest stage with
+        // work, so that loads of some files overlap with the indexing of others, and only loads another file while
+        // the next stage's queue has room. Once a stage throws, or the token of the calling thread is cancelled,
+        // the workers stop taking files and the first exception is rethrown.
+        GlobalIndexStats build_global_indexes(GlobalIndexOptions const&);
 
-        Environment(Config, std::function<BlobHolderPtr(std::filesystem::path const &)> file_reader);
+        // Options of the Files of BMIs loaded from now on, e.g. to give each File an arena. The side index
+        // is the one stored with the blob. Not synchronized with loads, set it before loading any module.
+        // BMIs shared through a SharedBMIStore keep the options of the Environment that loaded them first.
+        void set_file_options(FileOptions options);
+
+        // With a store, BMIs loaded by other Environments sharing it are reused, including their indexes.
+        Environment(Config, FileReader file_reader, std::shared_ptr<SharedBMIStore> store = nullptr);
+        Environment(Config, AsyncFileReader file_reader, std::shared_ptr<SharedBMIStore> store = nullptr);
+        Environment(std::shared_ptr<ModuleMap const>, FileReader file_reader, std::shared_ptr<SharedBMIStore> store = nullptr);
+        Environment(std::shared_ptr<ModuleMap const>, AsyncFileReader file_reader, std::shared_ptr<SharedBMIStore> store = nullptr);
 
     private:
+        static std::filesystem::path const* find_bmi_path(ModuleMap const&, struct ModuleReference, File const&);
+        std::filesystem::path const* find_bmi_path(struct ModuleReference, File const&) const;
+
+        static FileOptions with_blob_options(FileOptions options, BlobHolder const& blob)
+        {
+            options.side_index = blob.side_index();
+            options.string_table = blob.string_table();
+            if (blob.fetches_on_demand())
+                options.fetch = [&blob](File::BlobView range) { blob.fetch(range); };
+            return options;
+        }
+
         struct CachedBMI
         {
         private:
@@ -54,15 +419,27 @@ namespace ifc
         public:
             File ifc;
 
-            CachedBMI(BlobHolderPtr blob)
+            CachedBMI(BlobHolderPtr blob, FileOptions options)
                 : blob_(std::move(blob))
-                , ifc(blob_->view())
-            {}
+                , ifc(blob_->view(), with_blob_options(options, *blob_))
+            {
+                if (!ifc.has_side_index())
+                    blob_->side_index_missing(ifc);
+                if (options.access_profile)
+                {
+                    for (auto range : options.access_profile->ranges(ifc))
+                        blob_->prefetch(range);
+                }
+            }
         };
 
+        friend SharedBMIStore;
+
     private:
-        std::function<BlobHolderPtr(std::filesystem::path const &)> file_reader_;
-        std::unordered_map<std::string, std::filesystem::path> module_name_to_bmi_path_;
+        AsyncFileReader file_reader_;
+        std::shared_ptr<SharedBMIStore> store_;
+        std::shared_ptr<ModuleMap const> modules_;
+        FileOptions file_options_;
 
         // See https://cplusplus.github.io/LWG/issue3657
         struct PathHasher
@@ -73,6 +450,189 @@ namespace ifc
             }
         };
 
-        std::unordered_map<std::filesystem::path, CachedBMI, PathHasher> cached_bmis_;
+        // `pinned` and `last_use` are guarded by the shard's mutex.
+        struct CacheEntry
+        {
+            std::future<BlobHolderPtr> pending_blob;
+            std::once_flag loaded;
+            std::shared_ptr<File const> bmi;
+            std::atomic<bool> ready = false; // `bmi` is set
+            bool pinned = false;
+            uint64_t last_use = 0;
+        };
+
+        using CacheEntryPtr = std::shared_ptr<CacheEntry>;
+
+        CacheEntryPtr start_loading(std::filesystem::path const &, bool pin, LoadPriority = LoadPriority::Foreground);
+        File const& finish_loading(CacheEntry&, std::filesystem::path const &, LoadPriority = LoadPriority::Foreground);
+        // Blocks a speculative load until no foreground load is in progress.
+        void wait_for_foreground_loads();
+        void evict_over_budget();
+        // Drops the resolutions and the id of a file that is no longer cached, another file may be loaded at
+        // the same address later.
+        void forget_resolutions(File const*);
+        // Removes a loaded entry from the cache, its File stays valid while referenced.
+        void retire(CacheEntryPtr, bool pinned);
+        // Drops the BMIs the watcher reported as changed.
+        void drop_changed_bmis();
+
+        // Entries are shared with the threads loading them and with module handles,
+        // only entries referenced by the shard alone can be evicted.
+        struct CacheShard
+        {
+            mutable std::mutex mutex;
+            std::unordered_map<std::filesystem::path, CacheEntryPtr, PathHasher> entries;
+        };
+
+        static constexpr size_t CacheShards = 16;
+        std::array<CacheShard, CacheShards> cached_bmis_;
+
+        // Incremented whenever a module is added to or removed from the cache, see snapshot.
+        std::atomic<uint64_t> module_set_version_ = 0;
+        std::mutex snapshot_mutex_;
+        std::atomic<std::shared_ptr<Snapshot const>> snapshot_;
+
+        std::mutex foreground_mutex_;
+        std::condition_variable foreground_idle_;
+        size_t foreground_loads_ = 0;
+
+        // Versions of pinned BMIs replaced by reload_module_by_bmi_path or dropped after changing on disk,
+        // still referenced by callers.
+        std::mutex replaced_mutex_;
+        std::vector<CacheEntryPtr> replaced_bmis_;
+
+        // Changed paths are reported from the watcher's thread and dropped by the next request.
+        std::mutex changed_mutex_;
+        std::vector<std::filesystem::path> changed_bmis_;
+        std::atomic<bool> changes_pending_ = false;
+        std::atomic<uint64_t> generation_ = 0;
+        // Declared last, so that it is stopped before the members its callback uses are destroyed.
+        std::unique_ptr<FileWatcher> watcher_;
+
+        std::atomic<size_t> memory_budget_ = SIZE_MAX;
+        std::atomic<size_t> loaded_bytes_ = 0;
+        std::atomic<uint64_t> use_clock_ = 0;
+        std::mutex eviction_mutex_;
+
+        struct ResolvedReferences
+        {
+            std::once_flag resolved;
+            std::vector<File const*> imported;
+            std::vector<File const*> exported;
+
+            std::once_flag declarations_resolved;
+            std::vector<ResolvedDeclaration> declarations;
+
+            // Set once, guarded by transitive_exports_mutex_ until then.
+            std::atomic<bool> exports_closed = false;
+            FileIdSet transitive_exports;
+        };
+
+        ResolvedReferences& references_of(File const&);
+
+        ResolvedReferences const& resolve_references(File const&);
+
+        struct DeclarationKey
+        {
+            File const* file;
+            DeclIndex decl;
+
+            bool operator==(DeclarationKey const&) const = default;
+        };
+
+        struct DeclarationKeyHasher
+        {
+            size_t operator() (DeclarationKey const & key) const noexcept
+            {
+                return std::hash<File const*>{}(key.file) ^ (std::hash<DeclIndex>{}(key.decl) * 0x9e3779b97f4a7c15);
+            }
+        };
+
+        mutable std::mutex resolved_declarations_mutex_;
+        std::unordered_map<DeclarationKey, ResolvedDeclaration, DeclarationKeyHasher> resolved_declarations_;
+
+        mutable std::mutex resolved_references_mutex_;
+        std::unordered_map<File const*, std::unique_ptr<ResolvedReferences>> resolved_references_;
+        // Taken before resolved_references_mutex_.
+        mutable std::mutex transitive_exports_mutex_;
+
+        // Files by id, in segments that never move once published by file_id_count_.
+        static constexpr uint32_t FileIdSegmentBits = 10;
+        static constexpr uint32_t FileIdSegments = 4096;
+        mutable std::mutex file_ids_mutex_;
+        std::unordered_map<File const*, FileId> file_ids_;
+        std::array<std::unique_ptr<std::atomic<File const*>[]>, FileIdSegments> files_by_id_;
+        std::atomic<uint32_t> file_id_count_ = 0;
+
+        SymbolTable symbols_;
+    };
+
+    // Immutable view of the modules an Environment had loaded at one point, see Environment::snapshot.
+    // Lookups take no locks, and its Files stay valid for its lifetime, even once the Environment has
+    // reloaded, dropped or evicted them.
+    class Environment::Snapshot
+    {
+    public:
+        // Null if the BMI was not loaded.
+        File const* find(std::filesystem::path const &) const;
+        // Null if the referenced module is not in the config or was not loaded.
+        File const* find_referenced_module(struct ModuleReference, File const&) const;
+
+        size_t size() const { return modules_.size(); }
+        // Later snapshots of the Environment have larger versions.
+        uint64_t version() const { return version_; }
+
+    private:
+        friend Environment;
+
+        uint64_t version_ = 0;
+        std::shared_ptr<ModuleMap const> module_map_;
+        std::unordered_map<std::filesystem::path, std::shared_ptr<File const>, PathHasher> modules_;
+    };
+
+    // BMIs shared by several Environments, each distinct BMI is mapped and indexed once while any of them uses it.
+    // BMIs are identified by canonical path, size and modification time, so a rebuilt BMI is loaded anew.
+    class SharedBMIStore
+    {
+    public:
+        // Process-wide store.
+        static std::shared_ptr<SharedBMIStore> global();
+
+        // Concurrent requests of the same BMI wait for a single `read`.
+        std::shared_ptr<File const> get(std::filesystem::path const &, std::function<Environment::BlobHolderPtr()> const& read, FileOptions const& = {});
+
+    private:
+        struct Key
+        {
+            std::string path;
+            uintmax_t size;
+            int64_t modification_time;
+
+            bool operator==(Key const&) const = default;
+        };
+
+        struct KeyHasher
+        {
+            size_t operator() (Key const & key) const noexcept;
+        };
+
+        struct Slot
+        {
+            std::mutex mutex;
+            std::weak_ptr<File const> bmi;
+        };
+
+        std::mutex mutex_;
+        std::unordered_map<Key, std::shared_ptr<Slot>, KeyHasher> slots_;
     };
 }
+
+template<>
+struct std::hash<ifc::DeclarationId>
+{
+    size_t operator()(ifc::DeclarationId id) const noexcept
+    {
+        const auto packed = uint64_t{ static_cast<uint32_t>(id.file) } << 32 | std::bit_cast<uint32_t>(id.decl);
+        return std::hash<uint64_t>{}(packed);
+    }
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FileHeader.h"
+#include "FilePartitionCache.h"
 #include "Partition.h"
 
 #include "AttributeFwd.h"
@@ -8,17 +9,166 @@
 #include "ExpressionFwd.h"
 #include "DeclarationFwd.h"
 #include "Literal.h"
+#include "MacroFwd.h"
 #include "NameFwd.h"
+#include "SourceLocation.h"
 #include "SyntaxTreeFwd.h"
+#include "Trait.h"
 #include "TypeFwd.h"
+#include "WordFwd.h"
 #include "Module.h"
 
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <functional>
+#include <future>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <span>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace ifc
 {
+    class Executor;
+    class File;
+    struct AccessProfile;
+
+    struct FileOptions
+    {
+        // Resolve every known partition in a single pass over the table of contents
+        // while constructing the File, so that partition accessors are plain loads.
+        // Otherwise partitions are resolved on first access.
+        bool eager_partitions = false;
+
+        // Make File::get_string_view find string lengths by a binary search over
+        // a side table of terminator offsets (built on first use) instead of strlen.
+        bool index_string_lengths = false;
+
+        // Check the SHA-256 of the file contents against the checksum in the header
+        // while constructing the File. Reads the whole blob.
+        bool verify_checksum = false;
+
+        // Validate the file (see File::validate) while constructing it, on the default executor.
+        bool validate = false;
+
+        // Validate the file on a thread of its own instead, on the default executor, once constructing it is done:
+        // constructing only checks the signature and the bounds of the partitions, and the result is given by
+        // File::validation_status. Accessors are usable meanwhile. Ignored with `validate`. Destroying the File
+        // waits for the validation.
+        bool validate_in_background = false;
+
+        // The caller vouches for the file, e.g. it was written by the caller's own compiler or FileWriter: the
+        // partitions of its accessors only assert (see Partition). Validating a file does not make it trusted.
+        bool trusted = false;
+
+        // Contents of a side index (see File::side_index) to take the string length and interning
+        // tables from, in place, instead of building them. It must outlive the File and be 4-byte aligned.
+        // It is ignored if it was written for a different file (by size and checksum) or by another version, or
+        // if its offsets are out of the string table.
+        std::span<std::byte const> side_index{};
+
+        // Backs the tables and indexes built from the file (see File::memory_resource), the default resource
+        // if null. Indexes are built from any thread, so the resource must be thread-safe.
+        std::pmr::memory_resource* memory_resource = nullptr;
+
+        // Allocate the tables and indexes from a monotonic arena of the File instead, which draws blocks from
+        // `memory_resource`. Nothing is freed before the File is destroyed, which then releases all of it at once.
+        bool arena = false;
+
+        // Makes bytes of the blob readable before the File reads them, for blobs fetched on demand (see
+        // Environment::BlobHolder::fetch). The header, the table of contents and the string table are fetched
+        // while constructing the File, other partitions on their first access (all of them with
+        // `eager_partitions`, the whole blob with `verify_checksum`). Called from any thread.
+        // File::blob() is only readable where it was fetched.
+        std::function<void(std::span<std::byte const>)> fetch{};
+
+        // String table of a blob stored without one (its header gives it no bytes), e.g. a member of a
+        // Bundle sharing it with other members. It must outlive the File. Ignored if the blob has its own.
+        std::span<char const> string_table{};
+
+        // Partitions an Environment prefetches right after opening the blob (see BlobHolder::prefetch), e.g.
+        // those a previous run of the same workload read. Files constructed directly leave it to their caller,
+        // see AccessProfile::ranges.
+        std::shared_ptr<AccessProfile const> access_profile{};
+    };
+
+    // Which partitions a File was asked for and how long its lazy indexes took to build. Collected only when
+    // ifc-core is built with the IFC_READER_FILE_STATS option (which defines IFC_FILE_STATS), empty otherwise.
+    struct FileStats
+    {
+        struct Partition
+        {
+            std::string_view name;
+            uint64_t accesses;
+            std::chrono::nanoseconds first_access; // Since the File was constructed
+        };
+
+        // Durations include the builds of other indexes needed on the way.
+        struct Build
+        {
+            std::string_view name; // Trait or table name, or `typeid(Index).name()` for File::get_index
+            std::chrono::nanoseconds duration;
+        };
+
+        bool enabled = false;
+        std::vector<Partition> partitions; // Accessed at least once, in the order of their first access
+        std::vector<Build> builds;         // In the order they finished
+    };
+
+    // Memory a File uses: the blob it reads and the tables and indexes built from it.
+    struct FileMemoryUsage
+    {
+        struct Heap
+        {
+            std::string_view name; // Like FileStats::Build::name
+            size_t bytes;
+        };
+
+        size_t mapped_bytes = 0;              // Size of the blob
+        std::optional<size_t> resident_bytes; // Of the blob, where it can be queried (mincore)
+        std::vector<Heap> heap;               // Built tables and indexes, estimated for node-based containers
+
+        size_t heap_bytes() const
+        {
+            size_t result = 0;
+            for (auto const & entry : heap)
+                result += entry.bytes;
+            return result;
+        }
+    };
+
+    // Partitions a workload read, recorded from File::accessed_partitions, to prefetch them when the BMIs are
+    // opened again (see FileOptions::access_profile) rather than faulting them in a page at a time. Kept by
+    // name, so that one profile applies to every BMI of the workload and to rebuilt ones.
+    struct AccessProfile
+    {
+        std::vector<std::string> partitions; // Sorted, without duplicates
+
+        // Adds the partitions the file has accessed so far.
+        void record(File const&);
+
+        // Byte ranges of the profile's partitions in the file, in blob order, adjacent ones merged.
+        std::vector<std::span<std::byte const>> ranges(File const&) const;
+
+        // One partition name per line, e.g. to keep the profile next to the outputs of a build.
+        std::string serialize() const;
+        static AccessProfile parse(std::string_view);
+    };
+
+    // Derived state File::trim drops, each level including the previous ones.
+    enum class TrimLevel
+    {
+        Cold,    // Indexes and trait tables not used since the previous trim
+        Indexes, // Every index of get_index and every trait table
+        All,     // The string length, interning and filter tables too (except those of a side index)
+    };
+
     class File
     {
     public:
@@ -26,10 +176,49 @@ namespace ifc
 
         std::span<PartitionSummary const> table_of_contents() const;
 
+        // The bytes TextOffsets index into: those of the blob, or FileOptions::string_table.
+        std::span<char const> string_table() const;
+
         const char * get_string(TextOffset) const;
+        std::string_view get_string_view(TextOffset) const;
+
+        // Interned strings (the interning table is built on first use).
+        // `find_text` returns the offset of the first string with the given text,
+        // `text_symbol` - a dense id shared by all equal strings, if the offset starts a string,
+        // `symbol_text` - the offset of the first string of a symbol, in [0, text_symbol_count()).
+        std::optional<TextOffset> find_text(std::string_view) const;
+        std::optional<uint32_t>   text_symbol(TextOffset) const;
+        TextOffset                symbol_text(uint32_t symbol) const;
+        uint32_t                  text_symbol_count() const;
+
+        // False only if no string of the string table has the text, e.g. to skip most modules of a global search
+        // after a probe of one cache line. Uses the filter of the side index, or builds one (with the interning
+        // table) on first use. `find_text` consults the filter of a side index first, too.
+        bool may_contain_text(std::string_view) const;
 
         Sequence global_scope() const;
 
+        // Checks, once, that the abstract references of the heaps, of `scope.member` and of `name.guide` are
+        // within the partitions of their sorts (or are null, or of sorts that are not partition indexes), that
+        // scope descriptors are within `scope.member` and that module names are within the string table.
+        // Partitions are checked in parallel, by branchless loops over their words (see references_within).
+        // Throws std::runtime_error naming the first corrupted partition found. The bounds of the partitions
+        // themselves are checked when constructing any File.
+        //
+        // This does not check the references held by the other records, like the type or home scope of
+        // a declaration or the heap sequence of a tuple type, so the partitions of the accessors of a validated
+        // File are still checked (see Partition) unless it is trusted (see FileOptions::trusted): indexes and
+        // slices out of their records throw std::out_of_range instead of reading past them. Validating again is
+        // a no-op.
+        void validate() const;
+        void validate(Executor&) const;
+        bool trusted() const { return trusted_; }
+
+        // Result of the validation started by FileOptions::validate_in_background: ready once it is done, and
+        // rethrowing its std::runtime_error if the file is corrupted. For other Files, ready if the File was
+        // validated, and invalid (`valid()` is false) if not.
+        std::shared_future<void> validation_status() const;
+
         ScopePartition scope_descriptors() const;
 
         std::byte const* get_data_pointer(PartitionSummary const&) const;
@@ -53,6 +242,7 @@ namespace ifc
         Partition<VariableDeclaration, DeclIndex>   variables() const;
         Partition<ParameterDeclaration, DeclIndex>  parameters() const;
         Partition<FieldDeclaration, DeclIndex>      fields() const;
+        Partition<BitfieldDeclaration, DeclIndex>   bitfields() const;
         Partition<FriendDeclaration, DeclIndex>     friends() const;
         Partition<Concept, DeclIndex>               concepts() const;
         Partition<IntrinsicDeclaration, DeclIndex>  intrinsic_declarations() const;
@@ -122,6 +312,7 @@ namespace ifc
         Partition<ExprIndex, Index>     expr_heap() const;
         Partition<AttrIndex, Index>     attr_heap() const;
         Partition<SyntaxIndex, Index>   syntax_heap() const;
+        Partition<ChartIndex, Index>    chart_heap() const;
 
         // Names
         Partition<OperatorFunctionName, NameIndex>      operator_names() const;
@@ -163,36 +354,938 @@ namespace ifc
         Partition<TypeTraitIntrinsicSyntax, SyntaxIndex>   type_trait_intrinsic_syntax_trees() const;
         Partition<TupleSyntax, SyntaxIndex>                tuple_syntax_trees() const;
 
+        // Source tokens
+        // Sentences are indexed by position: SentenceIndex n (0 being null) is sentences()[n - 1].
+        Partition<Word, WordIndex> words() const;
+        Partition<Sentence, Index> sentences() const;
+
+        // Macros of header units and the preprocessing forms of their parameters and replacement lists
+        Partition<ObjectLikeMacro, MacroIndex>  object_like_macros() const;
+        Partition<FunctionLikeMacro, MacroIndex> function_like_macros() const;
+        Partition<IdentifierForm, FormIndex>    identifier_forms() const;
+        Partition<NumberForm, FormIndex>        number_forms() const;
+        Partition<CharacterForm, FormIndex>     character_forms() const;
+        Partition<StringForm, FormIndex>        string_forms() const;
+        Partition<OperatorForm, FormIndex>      operator_forms() const;
+        Partition<KeywordForm, FormIndex>       keyword_forms() const;
+        Partition<WhitespaceForm, FormIndex>    whitespace_forms() const;
+        Partition<ParameterForm, FormIndex>     parameter_forms() const;
+        Partition<StringizeForm, FormIndex>     stringize_forms() const;
+        Partition<CatenateForm, FormIndex>      catenate_forms() const;
+        Partition<PragmaForm, FormIndex>        pragma_forms() const;
+        Partition<HeaderForm, FormIndex>        header_forms() const;
+        Partition<ParenthesizedForm, FormIndex> parenthesized_forms() const;
+        Partition<TupleForm, FormIndex>         tuple_forms() const;
+        Partition<JunkForm, FormIndex>          junk_forms() const;
+        Partition<FormIndex, Index>             form_heap() const;
+
         // Module References
+        // Module references are empty when the partition is absent.
         Partition<ModuleReference, Index> imported_modules() const;
         Partition<ModuleReference, Index> exported_modules() const;
 
         // Deduction guides
         Partition<DeclIndex> deduction_guides() const;
 
+        // Line table, indexed by the LineIndex of source locations.
+        Partition<FileAndLine, LineIndex> lines() const;
+
     public:
         // Traits
         TextOffset                  trait_deprecation_texts     (DeclIndex) const;
         std::span<AttrIndex const>  trait_declaration_attributes(DeclIndex) const;
         Sequence                    trait_friendship_of_class   (DeclIndex) const; // A sequence that indexes into the "scope.member" partition
 
+        // The partitions behind trait_declaration_attributes, unsorted, for passes over every attributed
+        // declaration: `trait.attribute` and `.msvc.trait.decl-attrs`. Empty when absent.
+        Partition<AssociatedTrait<AttrIndex>, Index> attribute_traits() const;
+        Partition<AssociatedTrait<AttrIndex>, Index> msvc_declaration_attribute_traits() const;
+
+        // The partition behind trait_friendship_of_class, for passes over every class with friends:
+        // `trait.friend`. Empty when absent.
+        Partition<AssociatedTrait<Sequence>, Index> friendship_traits() const;
+
+        // The partition behind trait_deprecation_texts, for passes over every deprecated declaration with
+        // a message: `trait.deprecated`. Empty when absent.
+        Partition<AssociatedTrait<TextOffset>, Index> deprecation_traits() const;
+
+    public:
+        // Indexes are data structures derived from the file, built on first request and owned by it.
+        // `Index` must be constructible from `File const&`. Safe for concurrent first use,
+        // every index is built once.
+        //
+        // A build checks the token of the calling thread (see CancellationScope) before it starts, and
+        // builders may poll it (see poll_cancellation). A cancelled build throws Cancelled and leaves the
+        // index unbuilt, the next request builds it again.
+        //
+        // An index may declare the partitions it is derived from, besides the string table, as
+        // `static constexpr std::string_view Partitions[]` (names ending with '.' stand for every partition
+        // of that prefix, see FileDiff::changed). It must then keep no pointers into the blob, so that
+        // a rebuilt version of the file can reuse it, see adopt_indexes.
+        template<typename Index>
+        Index const& get_index() const;
+
+        // Shares the indexes of get_index already built for an older version of the file whose declared
+        // partitions and string table are unchanged, unless this File has built them itself. Indexes of
+        // a `previous` File with an arena are not shared, they are freed along with it. Returns their number.
+        size_t adopt_indexes(File const& previous, struct FileDiff const& diff) const;
+
     public:
         using BlobView = std::span<std::byte const>;
 
-        explicit File(BlobView);
+        BlobView blob() const;
+
+        // Data of every partition whose name starts with the prefix (e.g. "decl." or "name."),
+        // for prefetching them from a mapped file.
+        std::vector<BlobView> partitions_data(std::string_view name_prefix) const;
+
+        // Whether the file has a partition of that name, e.g. `Enumerator::PartitionName`.
+        // Accessors of absent partitions throw.
+        bool has_partition(std::string_view name) const;
+
+        // Partition of any name as records of T, including partitions without an accessor, e.g.
+        // `AssociatedTrait<ExprIndex>` for "trait.alignas". Empty when absent.
+        // Throws std::runtime_error if its entries are smaller than T or it lies out of the blob.
+        template<typename T, typename PartitionIndex = Index>
+        Partition<T, PartitionIndex> get_partition_by_name(std::string_view name) const
+        {
+            const auto resolved = resolve_partition(name, sizeof(T));
+            return { static_cast<T const*>(resolved.data), resolved.size, resolved.stride };
+        }
+
+        // Partition of a record type declaring its `PartitionName` (e.g. with PARTITION_NAME), for partitions without
+        // an accessor such as vendor ones. Each such type is given a cache slot on first use, after which the
+        // partition is a single load away like the built-in ones. Empty when absent.
+        // Throws std::runtime_error as get_partition_by_name does, and std::length_error past MaxUserPartitions types.
+        template<typename T, typename PartitionIndex = Index>
+            requires requires { std::string_view(T::PartitionName); }
+        Partition<T, PartitionIndex> get_partition() const;
+
+        static constexpr size_t MaxUserPartitions = 64;
+
+        // Whether FileOptions::side_index matched the file and is used.
+        bool has_side_index() const;
+
+        // Serialized string length and interning tables, building them if needed,
+        // for FileOptions::side_index of later Files of the same blob.
+        std::vector<std::byte> side_index() const;
+
+        FileStats stats() const;
+
+        // Names of the partitions read through the accessors since the File was constructed, for AccessProfile,
+        // whether or not stats are collected. Sorted. Partitions resolved up front by
+        // FileOptions::eager_partitions or only read by validation are not counted.
+        std::vector<std::string_view> accessed_partitions() const;
+
+        // Indexes of get_index report `sizeof(Index)` plus what their `size_t heap_bytes() const` returns, if any.
+        // Safe to call while other threads use the File, tables in the middle of being built are left out.
+        FileMemoryUsage memory_usage() const;
+
+        // Drops state derived from the file under memory pressure, which is built again on next use: the blob and
+        // its partitions stay as they are. Returns the heap bytes released, as memory_usage counts them (indexes
+        // shared by adopt_indexes are only freed along with their last File). Repeated `Cold` trims keep the state
+        // used in between. With FileOptions::arena nothing could be released, nothing is dropped.
+        // Not safe while other threads use the File: references to dropped indexes and tables (and the spans of
+        // trait lookups) are invalidated.
+        size_t trim(TrimLevel) const;
+
+        // Resource the tables and indexes built from the file allocate from, see FileOptions::memory_resource.
+        // Indexes of get_index are allocated from it too, and can allocate their contents from it.
+        std::pmr::memory_resource* memory_resource() const;
+
+        explicit File(BlobView, FileOptions = {});
         ~File();
 
         File           (File &&) noexcept;
         File& operator=(File &&) noexcept;
 
+    private:
+        using IndexBuilder = std::shared_ptr<void const> (*)(File const&);
+        using IndexHeapBytes = size_t (*)(void const*);
+
+        // Partitions an index declares it is derived from, see get_index.
+        struct IndexPartitions
+        {
+            bool declared = false;
+            std::span<std::string_view const> names;
+        };
+
+        static size_t allocate_index_id();
+        static size_t allocate_partition_slot();
+        void const* get_or_build_index(size_t id, IndexBuilder, IndexHeapBytes, IndexPartitions, const char* name) const;
+
+    private:
+        // `data == nullptr` means the partition has not been resolved yet
+        // (or is absent in the file, which is reported on access).
+        struct CachedPartition
+        {
+            std::atomic<const void*> data = nullptr;
+            std::atomic<size_t>      size = 0;
+            std::atomic<size_t>      stride = 0;
+#ifdef IFC_FILE_STATS
+            std::atomic<uint64_t>    accesses = 0;
+#endif
+        };
+
+        // Inline, so that partition accessors in tight loops are a single load once the partition is resolved.
+        // T may be incomplete here.
+        template<typename T, typename Index>
+        Partition<T, Index> cached_partition(FilePartitionCache cache_type) const
+        {
+            auto & cached = cached_partitions_[(size_t)cache_type];
+#ifdef IFC_FILE_STATS
+            if (cached.accesses.fetch_add(1, std::memory_order_relaxed) == 0)
+                record_first_access(cache_type);
+#endif
+            const bool checked = !trusted_;
+            if (auto data = cached.data.load(std::memory_order_acquire))
+                return { static_cast<T const*>(data), cached.size.load(std::memory_order_relaxed), cached.stride.load(std::memory_order_relaxed), checked };
+
+            const auto resolved = resolve_partition(cache_type);
+            return { static_cast<T const*>(resolved.data), resolved.size, resolved.stride, checked };
+        }
+
+        struct ResolvedPartition
+        {
+            void const* data;
+            size_t      size;
+            size_t      stride;
+        };
+
+        // Throws std::out_of_range if the partition is absent.
+        ResolvedPartition resolve_partition(FilePartitionCache) const;
+        // Empty if the partition is absent, see get_partition_by_name.
+        ResolvedPartition resolve_partition(std::string_view name, size_t entry_size) const;
+        // Caches the result in the user partition slot, see get_partition.
+        ResolvedPartition resolve_partition(size_t slot, std::string_view name, size_t entry_size) const;
+
+#ifdef IFC_FILE_STATS
+        void record_first_access(FilePartitionCache) const;
+#endif
+
     private:
         struct Impl;
         std::unique_ptr<Impl> impl_;
+        CachedPartition* cached_partitions_; // Owned by impl_
+        CachedPartition* user_partitions_;   // Owned by impl_, see get_partition
+        bool trusted_;                       // See FileOptions::trusted
+    };
+
+    inline ScopePartition File::scope_descriptors() const
+    {
+        return cached_partition<Sequence, ScopeIndex>(FilePartitionCache::ScopeDescriptors);
+    }
+
+    inline Partition<Declaration, Index> File::declarations() const
+    {
+        return cached_partition<Declaration, Index>(FilePartitionCache::Declarations);
+    }
+
+    inline Partition<ScopeDeclaration, DeclIndex> File::scope_declarations() const
+    {
+        return cached_partition<ScopeDeclaration, DeclIndex>(FilePartitionCache::ScopeDeclarations);
+    }
+
+    inline Partition<TemplateDeclaration, DeclIndex> File::template_declarations() const
+    {
+        return cached_partition<TemplateDeclaration, DeclIndex>(FilePartitionCache::TemplateDeclarations);
+    }
+
+    inline Partition<PartialSpecialization, DeclIndex> File::partial_specializations() const
+    {
+        return cached_partition<PartialSpecialization, DeclIndex>(FilePartitionCache::PartialSpecializations);
+    }
+
+    inline Partition<Specialization, DeclIndex> File::specializations() const
+    {
+        return cached_partition<Specialization, DeclIndex>(FilePartitionCache::Specializations);
+    }
+
+    inline Partition<UsingDeclaration, DeclIndex> File::using_declarations() const
+    {
+        return cached_partition<UsingDeclaration, DeclIndex>(FilePartitionCache::UsingDeclarations);
+    }
+
+    inline Partition<Enumeration, DeclIndex> File::enumerations() const
+    {
+        return cached_partition<Enumeration, DeclIndex>(FilePartitionCache::Enumerations);
+    }
+
+    inline Partition<Enumerator, DeclIndex> File::enumerators() const
+    {
+        return cached_partition<Enumerator, DeclIndex>(FilePartitionCache::Enumerators);
+    }
+
+    inline Partition<AliasDeclaration, DeclIndex> File::alias_declarations() const
+    {
+        return cached_partition<AliasDeclaration, DeclIndex>(FilePartitionCache::AliasDeclarations);
+    }
+
+    inline Partition<DeclReference, DeclIndex> File::decl_references() const
+    {
+        return cached_partition<DeclReference, DeclIndex>(FilePartitionCache::DeclReferences);
+    }
+
+    inline Partition<FunctionDeclaration, DeclIndex> File::functions() const
+    {
+        return cached_partition<FunctionDeclaration, DeclIndex>(FilePartitionCache::Functions);
+    }
+
+    inline Partition<MethodDeclaration, DeclIndex> File::methods() const
+    {
+        return cached_partition<MethodDeclaration, DeclIndex>(FilePartitionCache::Methods);
+    }
+
+    inline Partition<Constructor, DeclIndex> File::constructors() const
+    {
+        return cached_partition<Constructor, DeclIndex>(FilePartitionCache::Constructors);
+    }
+
+    inline Partition<Destructor, DeclIndex> File::destructors() const
+    {
+        return cached_partition<Destructor, DeclIndex>(FilePartitionCache::Destructors);
+    }
+
+    inline Partition<VariableDeclaration, DeclIndex> File::variables() const
+    {
+        return cached_partition<VariableDeclaration, DeclIndex>(FilePartitionCache::Variables);
+    }
+
+    inline Partition<ParameterDeclaration, DeclIndex> File::parameters() const
+    {
+        return cached_partition<ParameterDeclaration, DeclIndex>(FilePartitionCache::Parameters);
+    }
+
+    inline Partition<FieldDeclaration, DeclIndex> File::fields() const
+    {
+        return cached_partition<FieldDeclaration, DeclIndex>(FilePartitionCache::Fields);
+    }
+
+    inline Partition<BitfieldDeclaration, DeclIndex> File::bitfields() const
+    {
+        return cached_partition<BitfieldDeclaration, DeclIndex>(FilePartitionCache::Bitfields);
+    }
+
+    inline Partition<FriendDeclaration, DeclIndex> File::friends() const
+    {
+        return cached_partition<FriendDeclaration, DeclIndex>(FilePartitionCache::Friends);
+    }
+
+    inline Partition<Concept, DeclIndex> File::concepts() const
+    {
+        return cached_partition<Concept, DeclIndex>(FilePartitionCache::Concepts);
+    }
+
+    inline Partition<IntrinsicDeclaration, DeclIndex> File::intrinsic_declarations() const
+    {
+        return cached_partition<IntrinsicDeclaration, DeclIndex>(FilePartitionCache::IntrinsicDeclarations);
+    }
+
+    inline Partition<SpecializationForm, SpecFormIndex> File::specialization_forms() const
+    {
+        return cached_partition<SpecializationForm, SpecFormIndex>(FilePartitionCache::SpecializationForms);
+    }
+
+    inline Partition<FundamentalType, TypeIndex> File::fundamental_types() const
+    {
+        return cached_partition<FundamentalType, TypeIndex>(FilePartitionCache::FundamentalTypes);
+    }
+
+    inline Partition<DesignatedType, TypeIndex> File::designated_types() const
+    {
+        return cached_partition<DesignatedType, TypeIndex>(FilePartitionCache::DesignatedTypes);
+    }
+
+    inline Partition<TorType, TypeIndex> File::tor_types() const
+    {
+        return cached_partition<TorType, TypeIndex>(FilePartitionCache::TorTypes);
+    }
+
+    inline Partition<SyntacticType, TypeIndex> File::syntactic_types() const
+    {
+        return cached_partition<SyntacticType, TypeIndex>(FilePartitionCache::SyntacticTypes);
+    }
+
+    inline Partition<ExpansionType, TypeIndex> File::expansion_types() const
+    {
+        return cached_partition<ExpansionType, TypeIndex>(FilePartitionCache::ExpansionTypes);
+    }
+
+    inline Partition<PointerType, TypeIndex> File::pointer_types() const
+    {
+        return cached_partition<PointerType, TypeIndex>(FilePartitionCache::PointerTypes);
+    }
+
+    inline Partition<FunctionType, TypeIndex> File::function_types() const
+    {
+        return cached_partition<FunctionType, TypeIndex>(FilePartitionCache::FunctionTypes);
+    }
+
+    inline Partition<MethodType, TypeIndex> File::method_types() const
+    {
+        return cached_partition<MethodType, TypeIndex>(FilePartitionCache::MethodTypes);
+    }
+
+    inline Partition<ArrayType, TypeIndex> File::array_types() const
+    {
+        return cached_partition<ArrayType, TypeIndex>(FilePartitionCache::ArrayTypes);
+    }
+
+    inline Partition<BaseType, TypeIndex> File::base_types() const
+    {
+        return cached_partition<BaseType, TypeIndex>(FilePartitionCache::BaseTypes);
+    }
+
+    inline Partition<TupleType, TypeIndex> File::tuple_types() const
+    {
+        return cached_partition<TupleType, TypeIndex>(FilePartitionCache::TupleTypes);
+    }
+
+    inline Partition<LvalueReference, TypeIndex> File::lvalue_references() const
+    {
+        return cached_partition<LvalueReference, TypeIndex>(FilePartitionCache::LvalueReferences);
+    }
+
+    inline Partition<RvalueReference, TypeIndex> File::rvalue_references() const
+    {
+        return cached_partition<RvalueReference, TypeIndex>(FilePartitionCache::RvalueReferences);
+    }
+
+    inline Partition<QualifiedType, TypeIndex> File::qualified_types() const
+    {
+        return cached_partition<QualifiedType, TypeIndex>(FilePartitionCache::QualifiedTypes);
+    }
+
+    inline Partition<ForallType, TypeIndex> File::forall_types() const
+    {
+        return cached_partition<ForallType, TypeIndex>(FilePartitionCache::ForallTypes);
+    }
+
+    inline Partition<SyntaxType, TypeIndex> File::syntax_types() const
+    {
+        return cached_partition<SyntaxType, TypeIndex>(FilePartitionCache::SyntaxTypes);
+    }
+
+    inline Partition<PlaceholderType, TypeIndex> File::placeholder_types() const
+    {
+        return cached_partition<PlaceholderType, TypeIndex>(FilePartitionCache::PlaceholderTypes);
+    }
+
+    inline Partition<TypenameType, TypeIndex> File::typename_types() const
+    {
+        return cached_partition<TypenameType, TypeIndex>(FilePartitionCache::TypenameTypes);
+    }
+
+    inline Partition<DecltypeType, TypeIndex> File::decltype_types() const
+    {
+        return cached_partition<DecltypeType, TypeIndex>(FilePartitionCache::DecltypeTypes);
+    }
+
+    inline Partition<AttrBasic, AttrIndex> File::basic_attributes() const
+    {
+        return cached_partition<AttrBasic, AttrIndex>(FilePartitionCache::BasicAttributes);
+    }
+
+    inline Partition<AttrScoped, AttrIndex> File::scoped_attributes() const
+    {
+        return cached_partition<AttrScoped, AttrIndex>(FilePartitionCache::ScopedAttributes);
+    }
+
+    inline Partition<AttrLabeled, AttrIndex> File::labeled_attributes() const
+    {
+        return cached_partition<AttrLabeled, AttrIndex>(FilePartitionCache::LabeledAttributes);
+    }
+
+    inline Partition<AttrCalled, AttrIndex> File::called_attributes() const
+    {
+        return cached_partition<AttrCalled, AttrIndex>(FilePartitionCache::CalledAttributes);
+    }
+
+    inline Partition<AttrExpanded, AttrIndex> File::expanded_attributes() const
+    {
+        return cached_partition<AttrExpanded, AttrIndex>(FilePartitionCache::ExpandedAttributes);
+    }
+
+    inline Partition<AttrFactored, AttrIndex> File::factored_attributes() const
+    {
+        return cached_partition<AttrFactored, AttrIndex>(FilePartitionCache::FactoredAttributes);
+    }
+
+    inline Partition<AttrElaborated, AttrIndex> File::elaborated_attributes() const
+    {
+        return cached_partition<AttrElaborated, AttrIndex>(FilePartitionCache::ElaboratedAttributes);
+    }
+
+    inline Partition<AttrTuple, AttrIndex> File::tuple_attributes() const
+    {
+        return cached_partition<AttrTuple, AttrIndex>(FilePartitionCache::TupleAttributes);
+    }
+
+    inline Partition<LiteralExpression, ExprIndex> File::literal_expressions() const
+    {
+        return cached_partition<LiteralExpression, ExprIndex>(FilePartitionCache::LiteralExpressions);
+    }
+
+    inline Partition<TypeExpression, ExprIndex> File::type_expressions() const
+    {
+        return cached_partition<TypeExpression, ExprIndex>(FilePartitionCache::TypeExpressions);
+    }
+
+    inline Partition<NamedDecl, ExprIndex> File::decl_expressions() const
+    {
+        return cached_partition<NamedDecl, ExprIndex>(FilePartitionCache::DeclExpressions);
+    }
+
+    inline Partition<UnqualifiedId, ExprIndex> File::unqualified_id_expressions() const
+    {
+        return cached_partition<UnqualifiedId, ExprIndex>(FilePartitionCache::UnqualifiedIdExpressions);
+    }
+
+    inline Partition<TemplateId, ExprIndex> File::template_ids() const
+    {
+        return cached_partition<TemplateId, ExprIndex>(FilePartitionCache::TemplateIds);
+    }
+
+    inline Partition<TemplateReference, ExprIndex> File::template_references() const
+    {
+        return cached_partition<TemplateReference, ExprIndex>(FilePartitionCache::TemplateReferences);
+    }
+
+    inline Partition<MonadExpression, ExprIndex> File::monad_expressions() const
+    {
+        return cached_partition<MonadExpression, ExprIndex>(FilePartitionCache::MonadExpressions);
+    }
+
+    inline Partition<DyadExpression, ExprIndex> File::dyad_expressions() const
+    {
+        return cached_partition<DyadExpression, ExprIndex>(FilePartitionCache::DyadExpressions);
+    }
+
+    inline Partition<StringExpression, ExprIndex> File::string_expressions() const
+    {
+        return cached_partition<StringExpression, ExprIndex>(FilePartitionCache::StringExpressions);
+    }
+
+    inline Partition<CallExpression, ExprIndex> File::call_expressions() const
+    {
+        return cached_partition<CallExpression, ExprIndex>(FilePartitionCache::CallExpressions);
+    }
+
+    inline Partition<SizeofExpression, ExprIndex> File::sizeof_expressions() const
+    {
+        return cached_partition<SizeofExpression, ExprIndex>(FilePartitionCache::SizeofExpressions);
+    }
+
+    inline Partition<AlignofExpression, ExprIndex> File::alignof_expressions() const
+    {
+        return cached_partition<AlignofExpression, ExprIndex>(FilePartitionCache::AlignofExpressions);
+    }
+
+    inline Partition<RequiresExpression, ExprIndex> File::requires_expressions() const
+    {
+        return cached_partition<RequiresExpression, ExprIndex>(FilePartitionCache::RequiresExpressions);
+    }
+
+    inline Partition<TupleExpression, ExprIndex> File::tuple_expressions() const
+    {
+        return cached_partition<TupleExpression, ExprIndex>(FilePartitionCache::TupleExpressions);
+    }
+
+    inline Partition<PathExpression, ExprIndex> File::path_expressions() const
+    {
+        return cached_partition<PathExpression, ExprIndex>(FilePartitionCache::PathExpressions);
+    }
+
+    inline Partition<ReadExpression, ExprIndex> File::read_expressions() const
+    {
+        return cached_partition<ReadExpression, ExprIndex>(FilePartitionCache::ReadExpressions);
+    }
+
+    inline Partition<SyntaxTreeExpression, ExprIndex> File::syntax_tree_expressions() const
+    {
+        return cached_partition<SyntaxTreeExpression, ExprIndex>(FilePartitionCache::SyntaxTreeExpressions);
+    }
+
+    inline Partition<ExpressionListExpression, ExprIndex> File::expression_lists() const
+    {
+        return cached_partition<ExpressionListExpression, ExprIndex>(FilePartitionCache::ExpressionLists);
+    }
+
+    inline Partition<QualifiedNameExpression, ExprIndex> File::qualified_name_expressions() const
+    {
+        return cached_partition<QualifiedNameExpression, ExprIndex>(FilePartitionCache::QualifiedNameExpressions);
+    }
+
+    inline Partition<PackedTemplateArguments, ExprIndex> File::packed_template_arguments() const
+    {
+        return cached_partition<PackedTemplateArguments, ExprIndex>(FilePartitionCache::PackedTemplateArguments);
+    }
+
+    inline Partition<ProductValueTypeExpression, ExprIndex> File::product_value_type_expressions() const
+    {
+        return cached_partition<ProductValueTypeExpression, ExprIndex>(FilePartitionCache::ProductValueTypeExpressions);
+    }
+
+    inline Partition<SubobjectValueExpression, ExprIndex> File::suboject_value_expressions() const
+    {
+        return cached_partition<SubobjectValueExpression, ExprIndex>(FilePartitionCache::SubojectValueExpressions);
+    }
+
+    inline Partition<StringLiteral, StringIndex> File::string_literal_expressions() const
+    {
+        return cached_partition<StringLiteral, StringIndex>(FilePartitionCache::StringLiteralExpressions);
+    }
+
+    inline Partition<ChartUnilevel, ChartIndex> File::unilevel_charts() const
+    {
+        return cached_partition<ChartUnilevel, ChartIndex>(FilePartitionCache::UnilevelCharts);
+    }
+
+    inline Partition<ChartMultilevel, ChartIndex> File::multilevel_charts() const
+    {
+        return cached_partition<ChartMultilevel, ChartIndex>(FilePartitionCache::MultilevelCharts);
+    }
+
+    inline Partition<IntegerLiteral, LitIndex> File::integer_literals() const
+    {
+        return cached_partition<IntegerLiteral, LitIndex>(FilePartitionCache::IntegerLiterals);
+    }
+
+    inline Partition<FPLiteral, LitIndex> File::fp_literals() const
+    {
+        return cached_partition<FPLiteral, LitIndex>(FilePartitionCache::FpLiterals);
+    }
+
+    inline Partition<SimpleTypeSpecifier, SyntaxIndex> File::simple_type_specifiers() const
+    {
+        return cached_partition<SimpleTypeSpecifier, SyntaxIndex>(FilePartitionCache::SimpleTypeSpecifiers);
+    }
+
+    inline Partition<DecltypeSpecifier, SyntaxIndex> File::decltype_specifiers() const
+    {
+        return cached_partition<DecltypeSpecifier, SyntaxIndex>(FilePartitionCache::DecltypeSpecifiers);
+    }
+
+    inline Partition<TypeSpecifierSeq, SyntaxIndex> File::type_specifier_seq_syntax_trees() const
+    {
+        return cached_partition<TypeSpecifierSeq, SyntaxIndex>(FilePartitionCache::TypeSpecifierSeqSyntaxTrees);
+    }
+
+    inline Partition<DeclSpecifierSeq, SyntaxIndex> File::decl_specifier_seq_syntax_trees() const
+    {
+        return cached_partition<DeclSpecifierSeq, SyntaxIndex>(FilePartitionCache::DeclSpecifierSeqSyntaxTrees);
+    }
+
+    inline Partition<TypeIdSyntax, SyntaxIndex> File::typeid_syntax_trees() const
+    {
+        return cached_partition<TypeIdSyntax, SyntaxIndex>(FilePartitionCache::TypeidSyntaxTrees);
+    }
+
+    inline Partition<DeclaratorSyntax, SyntaxIndex> File::declarator_syntax_trees() const
+    {
+        return cached_partition<DeclaratorSyntax, SyntaxIndex>(FilePartitionCache::DeclaratorSyntaxTrees);
+    }
+
+    inline Partition<PointerDeclaratorSyntax, SyntaxIndex> File::pointer_declarator_syntax_trees() const
+    {
+        return cached_partition<PointerDeclaratorSyntax, SyntaxIndex>(FilePartitionCache::PointerDeclaratorSyntaxTrees);
+    }
+
+    inline Partition<FunctionDeclaratorSyntax, SyntaxIndex> File::function_declarator_syntax_trees() const
+    {
+        return cached_partition<FunctionDeclaratorSyntax, SyntaxIndex>(FilePartitionCache::FunctionDeclaratorSyntaxTrees);
+    }
+
+    inline Partition<ParameterDeclaratorSyntax, SyntaxIndex> File::parameter_declarator_syntax_trees() const
+    {
+        return cached_partition<ParameterDeclaratorSyntax, SyntaxIndex>(FilePartitionCache::ParameterDeclaratorSyntaxTrees);
+    }
+
+    inline Partition<ExpressionSyntax, SyntaxIndex> File::expression_syntax_trees() const
+    {
+        return cached_partition<ExpressionSyntax, SyntaxIndex>(FilePartitionCache::ExpressionSyntaxTrees);
+    }
+
+    inline Partition<RequiresClauseSyntax, SyntaxIndex> File::requires_clause_syntax_trees() const
+    {
+        return cached_partition<RequiresClauseSyntax, SyntaxIndex>(FilePartitionCache::RequiresClauseSyntaxTrees);
+    }
+
+    inline Partition<SimpleRequirementSyntax, SyntaxIndex> File::simple_requirement_syntax_trees() const
+    {
+        return cached_partition<SimpleRequirementSyntax, SyntaxIndex>(FilePartitionCache::SimpleRequirementSyntaxTrees);
+    }
+
+    inline Partition<TypeRequirementSyntax, SyntaxIndex> File::type_requirement_syntax_trees() const
+    {
+        return cached_partition<TypeRequirementSyntax, SyntaxIndex>(FilePartitionCache::TypeRequirementSyntaxTrees);
+    }
+
+    inline Partition<NestedRequirementSyntax, SyntaxIndex> File::nested_requirement_syntax_trees() const
+    {
+        return cached_partition<NestedRequirementSyntax, SyntaxIndex>(FilePartitionCache::NestedRequirementSyntaxTrees);
+    }
+
+    inline Partition<CompoundRequirementSyntax, SyntaxIndex> File::compound_requirement_syntax_trees() const
+    {
+        return cached_partition<CompoundRequirementSyntax, SyntaxIndex>(FilePartitionCache::CompoundRequirementSyntaxTrees);
+    }
+
+    inline Partition<RequirementBodySyntax, SyntaxIndex> File::requirement_body_syntax_trees() const
+    {
+        return cached_partition<RequirementBodySyntax, SyntaxIndex>(FilePartitionCache::RequirementBodySyntaxTrees);
+    }
+
+    inline Partition<TypeTemplateArgumentSyntax, SyntaxIndex> File::type_template_argument_syntax_trees() const
+    {
+        return cached_partition<TypeTemplateArgumentSyntax, SyntaxIndex>(FilePartitionCache::TypeTemplateArgumentSyntaxTrees);
+    }
+
+    inline Partition<TemplateArgumentListSyntax, SyntaxIndex> File::template_argument_list_syntax_trees() const
+    {
+        return cached_partition<TemplateArgumentListSyntax, SyntaxIndex>(FilePartitionCache::TemplateArgumentListSyntaxTrees);
+    }
+
+    inline Partition<TemplateIdSyntax, SyntaxIndex> File::templateid_syntax_trees() const
+    {
+        return cached_partition<TemplateIdSyntax, SyntaxIndex>(FilePartitionCache::TemplateidSyntaxTrees);
+    }
+
+    inline Partition<TypeTraitIntrinsicSyntax, SyntaxIndex> File::type_trait_intrinsic_syntax_trees() const
+    {
+        return cached_partition<TypeTraitIntrinsicSyntax, SyntaxIndex>(FilePartitionCache::TypeTraitIntrinsicSyntaxTrees);
+    }
+
+    inline Partition<TupleSyntax, SyntaxIndex> File::tuple_syntax_trees() const
+    {
+        return cached_partition<TupleSyntax, SyntaxIndex>(FilePartitionCache::TupleSyntaxTrees);
+    }
+
+    inline Partition<Word, WordIndex> File::words() const
+    {
+        return cached_partition<Word, WordIndex>(FilePartitionCache::Words);
+    }
+
+    inline Partition<Sentence, Index> File::sentences() const
+    {
+        return cached_partition<Sentence, Index>(FilePartitionCache::Sentences);
+    }
+
+    inline Partition<ObjectLikeMacro, MacroIndex> File::object_like_macros() const
+    {
+        return cached_partition<ObjectLikeMacro, MacroIndex>(FilePartitionCache::ObjectLikeMacros);
+    }
+
+    inline Partition<FunctionLikeMacro, MacroIndex> File::function_like_macros() const
+    {
+        return cached_partition<FunctionLikeMacro, MacroIndex>(FilePartitionCache::FunctionLikeMacros);
+    }
+
+    inline Partition<IdentifierForm, FormIndex> File::identifier_forms() const
+    {
+        return cached_partition<IdentifierForm, FormIndex>(FilePartitionCache::IdentifierForms);
+    }
+
+    inline Partition<NumberForm, FormIndex> File::number_forms() const
+    {
+        return cached_partition<NumberForm, FormIndex>(FilePartitionCache::NumberForms);
+    }
+
+    inline Partition<CharacterForm, FormIndex> File::character_forms() const
+    {
+        return cached_partition<CharacterForm, FormIndex>(FilePartitionCache::CharacterForms);
+    }
+
+    inline Partition<StringForm, FormIndex> File::string_forms() const
+    {
+        return cached_partition<StringForm, FormIndex>(FilePartitionCache::StringForms);
+    }
+
+    inline Partition<OperatorForm, FormIndex> File::operator_forms() const
+    {
+        return cached_partition<OperatorForm, FormIndex>(FilePartitionCache::OperatorForms);
+    }
+
+    inline Partition<KeywordForm, FormIndex> File::keyword_forms() const
+    {
+        return cached_partition<KeywordForm, FormIndex>(FilePartitionCache::KeywordForms);
+    }
+
+    inline Partition<WhitespaceForm, FormIndex> File::whitespace_forms() const
+    {
+        return cached_partition<WhitespaceForm, FormIndex>(FilePartitionCache::WhitespaceForms);
+    }
+
+    inline Partition<ParameterForm, FormIndex> File::parameter_forms() const
+    {
+        return cached_partition<ParameterForm, FormIndex>(FilePartitionCache::ParameterForms);
+    }
+
+    inline Partition<StringizeForm, FormIndex> File::stringize_forms() const
+    {
+        return cached_partition<StringizeForm, FormIndex>(FilePartitionCache::StringizeForms);
+    }
+
+    inline Partition<CatenateForm, FormIndex> File::catenate_forms() const
+    {
+        return cached_partition<CatenateForm, FormIndex>(FilePartitionCache::CatenateForms);
+    }
+
+    inline Partition<PragmaForm, FormIndex> File::pragma_forms() const
+    {
+        return cached_partition<PragmaForm, FormIndex>(FilePartitionCache::PragmaForms);
+    }
+
+    inline Partition<HeaderForm, FormIndex> File::header_forms() const
+    {
+        return cached_partition<HeaderForm, FormIndex>(FilePartitionCache::HeaderForms);
+    }
+
+    inline Partition<ParenthesizedForm, FormIndex> File::parenthesized_forms() const
+    {
+        return cached_partition<ParenthesizedForm, FormIndex>(FilePartitionCache::ParenthesizedForms);
+    }
+
+    inline Partition<TupleForm, FormIndex> File::tuple_forms() const
+    {
+        return cached_partition<TupleForm, FormIndex>(FilePartitionCache::TupleForms);
+    }
+
+    inline Partition<JunkForm, FormIndex> File::junk_forms() const
+    {
+        return cached_partition<JunkForm, FormIndex>(FilePartitionCache::JunkForms);
+    }
+
+    inline Partition<FormIndex, Index> File::form_heap() const
+    {
+        return cached_partition<FormIndex, Index>(FilePartitionCache::FormHeap);
+    }
+
+    inline Partition<OperatorFunctionName, NameIndex> File::operator_names() const
+    {
+        return cached_partition<OperatorFunctionName, NameIndex>(FilePartitionCache::OperatorNames);
+    }
+
+    inline Partition<LiteralName, NameIndex> File::literal_names() const
+    {
+        return cached_partition<LiteralName, NameIndex>(FilePartitionCache::LiteralNames);
+    }
+
+    inline Partition<SpecializationName, NameIndex> File::specialization_names() const
+    {
+        return cached_partition<SpecializationName, NameIndex>(FilePartitionCache::SpecializationNames);
+    }
+
+    inline Partition<TypeIndex, Index> File::type_heap() const
+    {
+        return cached_partition<TypeIndex, Index>(FilePartitionCache::TypeHeap);
+    }
+
+    inline Partition<ExprIndex, Index> File::expr_heap() const
+    {
+        return cached_partition<ExprIndex, Index>(FilePartitionCache::ExprHeap);
+    }
+
+    inline Partition<AttrIndex, Index> File::attr_heap() const
+    {
+        return cached_partition<AttrIndex, Index>(FilePartitionCache::AttrHeap);
+    }
+
+    inline Partition<SyntaxIndex, Index> File::syntax_heap() const
+    {
+        return cached_partition<SyntaxIndex, Index>(FilePartitionCache::SyntaxHeap);
+    }
+
+    inline Partition<ChartIndex, Index> File::chart_heap() const
+    {
+        return cached_partition<ChartIndex, Index>(FilePartitionCache::ChartHeap);
+    }
+
+    inline Partition<DeclIndex> File::deduction_guides() const
+    {
+        return cached_partition<DeclIndex, uint32_t>(FilePartitionCache::DeductionGuides);
+    }
+
+    inline Partition<FileAndLine, LineIndex> File::lines() const
+    {
+        return cached_partition<FileAndLine, LineIndex>(FilePartitionCache::Lines);
+    }
+
+    inline Partition<ConversionFunctionName, NameIndex> File::conversion_function_names() const
+    {
+        return cached_partition<ConversionFunctionName, NameIndex>(FilePartitionCache::ConversionNames);
+    }
+
+    inline Partition<TemplateName, NameIndex> File::template_names() const
+    {
+        return cached_partition<TemplateName, NameIndex>(FilePartitionCache::TemplateNames);
+    }
+
+    inline Partition<SourceFileName, NameIndex> File::source_file_names() const
+    {
+        return cached_partition<SourceFileName, NameIndex>(FilePartitionCache::SourceFileNames);
+    }
+
+    inline Partition<DeductionGuideName, NameIndex> File::deduction_guide_names() const
+    {
+        return cached_partition<DeductionGuideName, NameIndex>(FilePartitionCache::DeductionGuideNames);
+    }
+
+    template<typename T, typename PartitionIndex>
+        requires requires { std::string_view(T::PartitionName); }
+    Partition<T, PartitionIndex> File::get_partition() const
+    {
+        static const size_t slot = allocate_partition_slot();
+        auto & cached = user_partitions_[slot];
+        const bool checked = !trusted_;
+        if (auto data = cached.data.load(std::memory_order_acquire))
+            return { static_cast<T const*>(data), cached.size.load(std::memory_order_relaxed), cached.stride.load(std::memory_order_relaxed), checked };
+
+        const auto resolved = resolve_partition(slot, T::PartitionName, sizeof(T));
+        return { static_cast<T const*>(resolved.data), resolved.size, resolved.stride, checked };
+    }
+
+    template<typename Index>
+    Index const& File::get_index() const
+    {
+        static const size_t id = allocate_index_id();
+        const IndexBuilder build = [](File const& file) -> std::shared_ptr<void const> {
+            return std::allocate_shared<Index>(std::pmr::polymorphic_allocator<Index>(file.memory_resource()), file);
+        };
+        const IndexHeapBytes heap_bytes = [](void const* index) -> size_t {
+            if constexpr (requires(Index const& i) { { i.heap_bytes() } -> std::convertible_to<size_t>; })
+                return sizeof(Index) + static_cast<Index const*>(index)->heap_bytes();
+            else
+                return sizeof(Index);
+        };
+        IndexPartitions partitions;
+        if constexpr (requires { std::span<std::string_view const>(Index::Partitions); })
+            partitions = { true, Index::Partitions };
+        return *static_cast<Index const*>(get_or_build_index(id, build, heap_bytes, partitions, typeid(Index).name()));
+    }
+
+    // Identity and dependencies of a module, see peek_file.
+    struct FilePeek
+    {
+        FileHeader header;
+        std::string_view unit_name; // Module, partition or header unit name, empty for other units
+        // Names as they appear in Environment::Config, e.g. "M:part" for partitions.
+        std::vector<std::string> imported_modules;
+        std::vector<std::string> exported_modules;
     };
 
+    // Reads just the header, the table of contents, the module reference partitions and
+    // the strings they refer to, without validating or touching the rest of the blob.
+    // Throws on a corrupted signature or on offsets leading out of the blob.
+    FilePeek peek_file(File::BlobView);
+
     ScopeDeclaration const &        get_scope       (File const&, DeclIndex);
     Partition<Declaration, Index>   get_declarations(File const&, Sequence);
     Partition<ExprIndex, Index>     get_tuple_expression_elements(File const&, TupleExpression const&);
 
     Partition<ExprIndex, Index>     get_qualified_name_parts(File const& ifc, QualifiedNameExpression const&);
+
+    // Identifier naming the declaration, if it is named by an identifier at all
+    // (operators, conversion functions, specializations etc. are not).
+    std::optional<TextOffset>       declaration_identifier(File const&, DeclIndex);
 }
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "DeclarationFwd.h"
+#include "FileFwd.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ifc
+{
+    // Differences between two versions of the same BMI, e.g. before and after a rebuild, see diff_files.
+    struct FileDiff
+    {
+        // Same header checksum, nothing else was compared.
+        bool identical = false;
+
+        bool strings_changed = false;
+
+        // Partitions whose contents differ, or which are present in only one of the files, by name.
+        std::vector<std::string> changed_partitions;
+
+        // Declarations whose records differ byte-wise or which are present in only one of the files,
+        // by their index in the newer file (or the older one for the removed ones), in DeclIndex order.
+        // Records refer to names and types by offset and index, so a change of the string table or of
+        // other partitions can mark declarations whose meaning is the same.
+        std::vector<DeclIndex> changed_declarations;
+
+        // Whether the partition changed. Names ending with '.' stand for every partition of that prefix
+        // (e.g. "decl."), and the empty name for the string table.
+        bool changed(std::string_view partition) const;
+    };
+
+    // Compares the files partition by partition: both are mapped, so partitions of the same size are compared
+    // byte-wise, which is exact where hashes of them would only tell that they probably are equal.
+    FileDiff diff_files(File const& before, File const& after);
+}
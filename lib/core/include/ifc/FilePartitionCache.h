@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ifc
+{
+    // Slots of the partitions a File resolves (and caches) by name, see File::cached_partition.
+    enum class FilePartitionCache : uint32_t
+    {
+        Declarations,
+        ScopeDeclarations,
+        TemplateDeclarations,
+        PartialSpecializations,
+        Specializations,
+        UsingDeclarations,
+        Enumerations,
+        Enumerators,
+        AliasDeclarations,
+        DeclReferences,
+        Functions,
+        Methods,
+        Constructors,
+        Destructors,
+        Variables,
+        Parameters,
+        Fields,
+        Bitfields,
+        Friends,
+        Concepts,
+        IntrinsicDeclarations,
+        SpecializationForms,
+        FundamentalTypes,
+        DesignatedTypes,
+        TorTypes,
+        SyntacticTypes,
+        ExpansionTypes,
+        PointerTypes,
+        FunctionTypes,
+        MethodTypes,
+        ArrayTypes,
+        BaseTypes,
+        TupleTypes,
+        LvalueReferences,
+        RvalueReferences,
+        QualifiedTypes,
+        ForallTypes,
+        SyntaxTypes,
+        PlaceholderTypes,
+        TypenameTypes,
+        DecltypeTypes,
+        BasicAttributes,
+        ScopedAttributes,
+        LabeledAttributes,
+        CalledAttributes,
+        ExpandedAttributes,
+        FactoredAttributes,
+        ElaboratedAttributes,
+        TupleAttributes,
+        LiteralExpressions,
+        TypeExpressions,
+        DeclExpressions,
+        UnqualifiedIdExpressions,
+        TemplateIds,
+        TemplateReferences,
+        MonadExpressions,
+        DyadExpressions,
+        StringExpressions,
+        CallExpressions,
+        SizeofExpressions,
+        AlignofExpressions,
+        RequiresExpressions,
+        TupleExpressions,
+        PathExpressions,
+        ReadExpressions,
+        SyntaxTreeExpressions,
+        ExpressionLists,
+        QualifiedNameExpressions,
+        PackedTemplateArguments,
+        ProductValueTypeExpressions,
+        SubojectValueExpressions,
+        StringLiteralExpressions,
+        TypeHeap,
+        ExprHeap,
+        AttrHeap,
+        SyntaxHeap,
+        ChartHeap,
+        OperatorNames,
+        ConversionNames,
+        LiteralNames,
+        TemplateNames,
+        SpecializationNames,
+        SourceFileNames,
+        DeductionGuideNames,
+        UnilevelCharts,
+        MultilevelCharts,
+        IntegerLiterals,
+        FpLiterals,
+        SimpleTypeSpecifiers,
+        DecltypeSpecifiers,
+        TypeSpecifierSeqSyntaxTrees,
+        DeclSpecifierSeqSyntaxTrees,
+        TypeidSyntaxTrees,
+        DeclaratorSyntaxTrees,
+        PointerDeclaratorSyntaxTrees,
+        FunctionDeclaratorSyntaxTrees,
+        ParameterDeclaratorSyntaxTrees,
+        ExpressionSyntaxTrees,
+        RequiresClauseSyntaxTrees,
+        SimpleRequirementSyntaxTrees,
+        TypeRequirementSyntaxTrees,
+        NestedRequirementSyntaxTrees,
+        CompoundRequirementSyntaxTrees,
+        RequirementBodySyntaxTrees,
+        TypeTemplateArgumentSyntaxTrees,
+        TemplateArgumentListSyntaxTrees,
+        TemplateidSyntaxTrees,
+        TypeTraitIntrinsicSyntaxTrees,
+        TupleSyntaxTrees,
+        Words,
+        Sentences,
+        ObjectLikeMacros,
+        FunctionLikeMacros,
+        IdentifierForms,
+        NumberForms,
+        CharacterForms,
+        StringForms,
+        OperatorForms,
+        KeywordForms,
+        WhitespaceForms,
+        ParameterForms,
+        StringizeForms,
+        CatenateForms,
+        PragmaForms,
+        HeaderForms,
+        ParenthesizedForms,
+        TupleForms,
+        JunkForms,
+        FormHeap,
+        ImportedModules,
+        ExportedModules,
+        DeductionGuides,
+        ScopeDescriptors,
+        TraitAttributes,
+        MsvcTraitDeclAttributes,
+        TraitDeprecated,
+        TraitFriend,
+        Lines,
+
+        Num,
+    };
+}
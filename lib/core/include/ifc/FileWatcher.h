@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+namespace ifc
+{
+    // Reports changes of watched files from a background thread: writes, truncation, replacement by a rename
+    // and removal. Built on inotify on Linux and ReadDirectoryChangesW on Windows, which watch the directories
+    // of the files, elsewhere on polling the size and modification time of the files every `poll_interval`.
+    // On Linux, the files of a directory that was removed or moved are reported, and the directory is watched
+    // again once it exists again, checked every `poll_interval`. A single change may be reported more than once.
+    class FileWatcher
+    {
+    public:
+        using Callback = std::function<void(std::filesystem::path const &)>;
+
+        // Called with the path as it was passed to `watch`, never concurrently with itself.
+        explicit FileWatcher(Callback on_change, std::chrono::milliseconds poll_interval = std::chrono::milliseconds(500));
+        // Waits for a callback in progress.
+        ~FileWatcher();
+
+        FileWatcher(FileWatcher const&) = delete;
+        FileWatcher& operator=(FileWatcher const&) = delete;
+
+        // Watching a file twice has no effect. Throws std::system_error if the file's directory cannot be watched.
+        void watch(std::filesystem::path const &);
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "FileFwd.h"
+#include "FileHeader.h"
+#include "Partition.h"
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ifc
+{
+    // Serializes a BMI in the layout File reads: the signature and the header, the partitions in the order
+    // they were added, the string table and the table of contents, with the checksum of the result.
+    // Used to write subsets and rewrites of existing files, so the string table starts as a copy of theirs.
+    class FileWriter
+    {
+    public:
+        enum class Layout
+        {
+            TableOfContentsLast,  // Like MSVC writes BMIs
+            TableOfContentsFirst, // The string table and the table of contents before the partitions, see read_blob_stream
+        };
+
+        // Header fields other than the layout (string table, table of contents) and the checksum are kept.
+        FileWriter(FileHeader const& header, std::span<char const> string_table);
+
+        // Appends the string to the string table.
+        TextOffset add_string(std::string_view);
+
+        void add_partition(TextOffset name, std::span<std::byte const> entries, size_t entry_size);
+
+        template<typename T>
+        void add_partition(TextOffset name, std::span<T const> entries)
+        {
+            add_partition(name, std::as_bytes(entries), sizeof(T));
+        }
+
+        std::vector<std::byte> write(Layout = Layout::TableOfContentsLast) const;
+
+    private:
+        FileHeader header_;
+        std::vector<char> string_table_;
+        std::vector<PartitionSummary> toc_;
+        std::vector<std::byte> partitions_;
+    };
+
+    // Copy of the file with its string table and table of contents first (and a checksum of its own), so that
+    // a reader of a stream of it can construct a File before the partitions arrive, see read_blob_stream.
+    std::vector<std::byte> streaming_layout(File const&);
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "MacroFwd.h"
+
+#include "Operator.h"
+#include "SourceLocation.h"
+#include "common_types.h"
+
+namespace ifc
+{
+    // Macros defined at the end of a header unit.
+    enum class MacroSort
+    {
+        ObjectLike   = 0x00,
+        FunctionLike = 0x01,
+    };
+
+    struct ObjectLikeMacro
+    {
+        SourceLocation locus;
+        TextOffset name;
+        FormIndex body;
+
+        PARTITION_NAME("macro.object-like");
+        PARTITION_SORT(MacroSort::ObjectLike);
+    };
+
+    struct FunctionLikeMacro
+    {
+        SourceLocation locus;
+        TextOffset name;
+        FormIndex parameters; // Parameter forms, a tuple if there are several
+        FormIndex body;
+        uint32_t arity : 31;
+        uint32_t variadic : 1; // The last parameter is `...`
+
+        PARTITION_NAME("macro.function-like");
+        PARTITION_SORT(MacroSort::FunctionLike);
+    };
+
+    // Preprocessing forms: the tokens of the replacement lists of macros, as trees.
+    enum class FormSort
+    {
+        Identifier    = 0x00,
+        Number        = 0x01,
+        Character     = 0x02,
+        String        = 0x03,
+        Operator      = 0x04,
+        Keyword       = 0x05,
+        Whitespace    = 0x06,
+        Parameter     = 0x07,
+        Stringize     = 0x08, // `#x`
+        Catenate      = 0x09, // `x ## y`
+        Pragma        = 0x0A, // `_Pragma(x)`
+        Header        = 0x0B, // `<name>` in `#include`
+        Parenthesized = 0x0C,
+        Tuple         = 0x0D,
+        Junk          = 0x0E, // Invalid tokens, kept as spelled
+    };
+
+    // A token as spelled in the source.
+    struct SpelledForm
+    {
+        SourceLocation locus;
+        TextOffset spelling;
+    };
+
+    struct IdentifierForm : SpelledForm
+    {
+        PARTITION_NAME("pp.ident");
+        PARTITION_SORT(FormSort::Identifier);
+    };
+
+    struct NumberForm : SpelledForm
+    {
+        PARTITION_NAME("pp.num");
+        PARTITION_SORT(FormSort::Number);
+    };
+
+    struct CharacterForm : SpelledForm
+    {
+        PARTITION_NAME("pp.char");
+        PARTITION_SORT(FormSort::Character);
+    };
+
+    struct StringForm : SpelledForm
+    {
+        PARTITION_NAME("pp.string");
+        PARTITION_SORT(FormSort::String);
+    };
+
+    struct OperatorForm : SpelledForm
+    {
+        Operator value;
+
+        PARTITION_NAME("pp.op");
+        PARTITION_SORT(FormSort::Operator);
+    };
+
+    struct KeywordForm : SpelledForm
+    {
+        PARTITION_NAME("pp.key");
+        PARTITION_SORT(FormSort::Keyword);
+    };
+
+    struct WhitespaceForm
+    {
+        SourceLocation locus;
+
+        PARTITION_NAME("pp.space");
+        PARTITION_SORT(FormSort::Whitespace);
+    };
+
+    struct ParameterForm : SpelledForm
+    {
+        PARTITION_NAME("pp.param");
+        PARTITION_SORT(FormSort::Parameter);
+    };
+
+    struct StringizeForm
+    {
+        SourceLocation locus;
+        FormIndex operand;
+
+        PARTITION_NAME("pp.to-string");
+        PARTITION_SORT(FormSort::Stringize);
+    };
+
+    struct CatenateForm
+    {
+        SourceLocation locus;
+        FormIndex first;
+        FormIndex second;
+
+        PARTITION_NAME("pp.catenate");
+        PARTITION_SORT(FormSort::Catenate);
+    };
+
+    struct PragmaForm
+    {
+        SourceLocation locus;
+        FormIndex operand;
+
+        PARTITION_NAME("pp.pragma");
+        PARTITION_SORT(FormSort::Pragma);
+    };
+
+    struct HeaderForm : SpelledForm
+    {
+        PARTITION_NAME("pp.header");
+        PARTITION_SORT(FormSort::Header);
+    };
+
+    struct ParenthesizedForm
+    {
+        SourceLocation locus;
+        FormIndex operand;
+
+        PARTITION_NAME("pp.paren");
+        PARTITION_SORT(FormSort::Parenthesized);
+    };
+
+    // Forms of the tuple, in `heap.form`.
+    struct TupleForm : Sequence
+    {
+        PARTITION_NAME("pp.tuple");
+        PARTITION_SORT(FormSort::Tuple);
+    };
+
+    struct JunkForm : SpelledForm
+    {
+        PARTITION_NAME("pp.junk");
+        PARTITION_SORT(FormSort::Junk);
+    };
+}
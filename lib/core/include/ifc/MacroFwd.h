@@ -0,0 +1,31 @@
+#pragma once
+
+#include "AbstractReference.h"
+
+namespace ifc
+{
+    enum class MacroSort;
+    using MacroIndex = AbstractReference<1, MacroSort>;
+
+    enum class FormSort;
+    using FormIndex = AbstractReference<4, FormSort>;
+
+    struct ObjectLikeMacro;
+    struct FunctionLikeMacro;
+
+    struct IdentifierForm;
+    struct NumberForm;
+    struct CharacterForm;
+    struct StringForm;
+    struct OperatorForm;
+    struct KeywordForm;
+    struct WhitespaceForm;
+    struct ParameterForm;
+    struct StringizeForm;
+    struct CatenateForm;
+    struct PragmaForm;
+    struct HeaderForm;
+    struct ParenthesizedForm;
+    struct TupleForm;
+    struct JunkForm;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "File.h"
+#include "MemoryUsage.h"
+
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace ifc
+{
+    // Contiguous copy of a field of every record of a partition (a column of a structure of arrays), for
+    // repeated scans of that field that should not load the rest of the records. Opt-in and built on first
+    // use through File::get_index, e.g.
+    // `file.get_index<MaterializedColumn<&File::functions, &FunctionDeclaration::name>>().values()`.
+    // Values are in the order of the records, empty if the partition is absent.
+    template<auto Accessor, auto Member>
+    class MaterializedColumn
+    {
+        template<typename> struct MemberOf;
+        template<typename T, typename M> struct MemberOf<M T::*>
+        {
+            using Value = M;
+        };
+
+        using Record = std::ranges::range_value_t<decltype((std::declval<File const&>().*Accessor)())>;
+        using Value = typename MemberOf<decltype(Member)>::Value;
+
+    public:
+        explicit MaterializedColumn(File const& file)
+            : values_(file.memory_resource())
+        {
+            if constexpr (requires { Record::PartitionName; })
+            {
+                if (!file.has_partition(Record::PartitionName))
+                    return;
+            }
+            const auto column = (file.*Accessor)().column(Member);
+            values_.assign(column.begin(), column.end());
+        }
+
+        std::span<Value const> values() const { return values_; }
+
+        size_t heap_bytes() const { return ifc::heap_bytes(values_); }
+
+    private:
+        std::pmr::vector<Value> values_;
+    };
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ifc
+{
+    // Heap bytes owned by standard containers, for the `heap_bytes()` of indexes (see File::memory_usage).
+    // Node-based containers are estimated: one allocation per element holding the element,
+    // the link to the next node and the cached hash, besides the bucket array.
+    template<typename T, typename Allocator>
+    size_t heap_bytes(std::vector<T, Allocator> const& vector)
+    {
+        return vector.capacity() * sizeof(T);
+    }
+
+    template<typename Char, typename Traits, typename Allocator>
+    size_t heap_bytes(std::basic_string<Char, Traits, Allocator> const& string)
+    {
+        // Short strings are stored inline.
+        const auto inline_capacity = std::basic_string<Char, Traits, Allocator>().capacity();
+        return string.capacity() > inline_capacity ? (string.capacity() + 1) * sizeof(Char) : 0;
+    }
+
+    template<typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+    size_t heap_bytes(std::unordered_map<Key, Value, Hash, Equal, Allocator> const& map)
+    {
+        using Map = std::unordered_map<Key, Value, Hash, Equal, Allocator>;
+        return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(typename Map::value_type) + sizeof(void*) + sizeof(size_t));
+    }
+
+    // Bytes of the range that are resident in physical memory, by `mincore` on POSIX systems.
+    // Empty where that cannot be queried.
+    std::optional<size_t> resident_bytes(std::span<std::byte const>);
+}
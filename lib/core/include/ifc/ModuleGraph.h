@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Environment.h"
+#include "File.h"
+#include "Parallel.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace ifc
+{
+    // Modules reachable from a root file through imports and exports, with dense node ids.
+    // The root is node 0.
+    class ModuleGraph
+    {
+    public:
+        using NodeId = uint32_t;
+
+        // Loads every reachable module. Throws std::out_of_range if one is not in the environment's config.
+        ModuleGraph(Environment&, File const& root);
+
+        size_t size() const { return files_.size(); }
+
+        File const& file(NodeId node) const { return *files_[node]; }
+        std::optional<NodeId> find(File const&) const;
+
+        // Imported and exported modules of the node, without duplicates.
+        std::span<NodeId const> dependencies(NodeId node) const
+        {
+            return std::span(edges_).subspan(edge_offsets_[node], edge_offsets_[node + 1] - edge_offsets_[node]);
+        }
+
+        // Every node after its dependencies. Dependencies on a module being visited lead back into
+        // a cycle (invalid input) and are ignored, so cycles do not prevent an order.
+        std::span<NodeId const> topological_order() const { return order_; }
+
+        // Calls `visit(node)` for every node in topological order. Nodes with no dependencies
+        // on each other (of the same depth) are visited in parallel.
+        void for_each_parallel(std::function<void(NodeId)> const& visit, Executor& = default_executor()) const;
+
+    private:
+        std::vector<File const*> files_;
+        std::unordered_map<File const*, NodeId> ids_;
+
+        // Dependencies of node i are edges_[edge_offsets_[i]..edge_offsets_[i + 1]).
+        std::vector<uint32_t> edge_offsets_;
+        std::vector<NodeId> edges_;
+
+        // Topological order grouped by depth, depth d are order_[depth_offsets_[d]..depth_offsets_[d + 1]).
+        std::vector<NodeId> order_;
+        std::vector<uint32_t> depth_offsets_;
+    };
+}
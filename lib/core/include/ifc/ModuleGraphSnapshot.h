@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Environment.h"
+#include "FileHeader.h"
+#include "ModuleGraph.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ifc
+{
+    // A ModuleGraph saved to a blob and read in place, e.g. mapped with read_blob, so that tools start with the
+    // whole import graph without opening any BMI: the nodes with their BMI paths, unit names and checksums,
+    // the dependencies and the topological order, under the same node ids. Each node also keeps the size and
+    // modification time its BMI had when the snapshot was written, to tell on first use whether it is current.
+    class ModuleGraphSnapshot
+    {
+    public:
+        using NodeId = ModuleGraph::NodeId;
+
+        // BMI paths by node. Throws std::invalid_argument if their number is not the graph's size,
+        // and std::filesystem::filesystem_error if one of them cannot be read.
+        static std::vector<std::byte> write(ModuleGraph const&, std::span<std::filesystem::path const> paths);
+
+        // Throws std::runtime_error if the blob is not a snapshot.
+        explicit ModuleGraphSnapshot(Environment::BlobHolderPtr);
+
+        size_t size() const { return nodes_.size(); }
+
+        std::string_view path(NodeId) const;
+        // Module, partition or header unit name, empty for other units.
+        std::string_view unit_name(NodeId) const;
+        SHA256 checksum(NodeId node) const { return nodes_[node].checksum; }
+
+        // By path as written.
+        std::optional<NodeId> find(std::string_view path) const;
+
+        std::span<NodeId const> dependencies(NodeId node) const
+        {
+            return edges_.subspan(edge_offsets_[node], edge_offsets_[node + 1] - edge_offsets_[node]);
+        }
+
+        // See ModuleGraph::topological_order.
+        std::span<NodeId const> topological_order() const { return order_; }
+
+        // Whether the BMI of the node still has the size and modification time it had when the snapshot
+        // was written. Checked on first call per node, later calls return the same answer.
+        bool is_current(NodeId) const;
+        // Whether every node is current.
+        bool is_current() const;
+
+    private:
+        struct NodeRecord
+        {
+            SHA256 checksum;
+            uint64_t size;
+            int64_t modification_time;
+            uint32_t path_offset;
+            uint32_t path_size;
+            uint32_t unit_name_offset;
+            uint32_t unit_name_size;
+        };
+
+        enum class Validity : uint8_t
+        {
+            Unchecked,
+            Current,
+            Stale,
+        };
+
+        Environment::BlobHolderPtr holder_;
+        std::string_view strings_;
+        std::span<NodeRecord const> nodes_;
+        std::span<uint32_t const> edge_offsets_;
+        std::span<NodeId const> edges_;
+        std::span<NodeId const> order_;
+        std::span<NodeId const> by_path_;
+        std::unique_ptr<std::atomic<Validity>[]> validity_;
+    };
+}
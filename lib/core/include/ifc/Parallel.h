@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Cancellation.h"
+#include "File.h"
+#include "Partition.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <numeric>
+
+namespace ifc
+{
+    // Runs the tasks of a parallel loop.
+    class Executor
+    {
+    public:
+        // Calls `task(i)` for every i in [0, count), possibly concurrently, and returns once all of them are done.
+        // If tasks throw, the remaining tasks are not started and the first exception is rethrown.
+        virtual void run(size_t count, std::function<void(size_t)> const& task) = 0;
+        virtual ~Executor() = default;
+    };
+
+    // Executor running the tasks one after the other on the calling thread, e.g. to keep a library embedded
+    // in a multi-threaded server from starting threads of its own.
+    class InlineExecutor final : public Executor
+    {
+    public:
+        void run(size_t count, std::function<void(size_t)> const& task) override;
+    };
+
+    // Executor with a fixed set of worker threads, the calling thread takes part in every run.
+    // Each thread starts with a contiguous range of the tasks and, once it is done, steals the upper half
+    // of the remaining range of another thread, so idle workers pick up the remaining work of slow ones
+    // while neighbouring tasks mostly run on the same thread. Runs from different threads are serialized,
+    // runs from a task of the pool (e.g. a parallel walk inside a parallel index build) run inline.
+    class ThreadPool final : public Executor
+    {
+    public:
+        // 0 means one thread per hardware thread (including the calling one).
+        // `on_start(i)` is called first on each worker thread i (from 1, the calling thread is 0), e.g. to pin
+        // the workers of a pool to the CPUs of one NUMA node or to set their memory policy.
+        explicit ThreadPool(unsigned threads = 0, std::function<void(unsigned)> on_start = {});
+        ~ThreadPool() override;
+
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        void run(size_t count, std::function<void(size_t)> const& task) override;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+
+    // Executor used when none is given: the one set by set_default_executor, or a process-wide ThreadPool.
+    Executor& default_executor();
+
+    // Makes every parallel feature use the executor (e.g. an adapter of the application's own thread pool)
+    // when not given one, null restores the process-wide pool. The executor must outlive its use.
+    void set_default_executor(Executor*);
+
+    // Calls `fn(element)` for every element of the partition, in chunks spanning whole cache lines.
+    // Each chunk checks the token of the calling thread first, and runs with it installed.
+    template<typename T, typename Index, typename Fn>
+    void for_each_parallel(Partition<T, Index> partition, Fn const& fn, Executor& executor = default_executor())
+    {
+        constexpr size_t cache_line = 64;
+        constexpr size_t min_chunk_bytes = 16 * 1024;
+        constexpr size_t elements_per_line_group = cache_line / std::gcd(cache_line, sizeof(T));
+        constexpr size_t chunk_size = std::max<size_t>(1, min_chunk_bytes / (elements_per_line_group * sizeof(T))) * elements_per_line_group;
+
+        const size_t chunks = (partition.size() + chunk_size - 1) / chunk_size;
+        const auto cancellation = current_cancellation();
+        executor.run(chunks, [&](size_t chunk) {
+            const CancellationScope scope(cancellation);
+            check_cancellation();
+            const auto first = partition.begin() + chunk * chunk_size;
+            const auto last = partition.begin() + std::min(partition.size(), (chunk + 1) * chunk_size);
+            std::for_each(first, last, fn);
+        });
+    }
+
+    template<typename Fn>
+    void for_each_declaration_parallel(File const& file, Fn const& fn, Executor& executor = default_executor())
+    {
+        for_each_parallel(file.declarations(), fn, executor);
+    }
+}
@@ -5,7 +5,12 @@
 #include "common_types.h"
 
 #include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
 #include <ranges>
+#include <stdexcept>
+#include <string>
 
 namespace ifc
 {
@@ -41,44 +46,214 @@ namespace ifc
         { index.sort() };
     };
 
+    // The slow path of checked partitions, out of line of their accessors.
+    [[noreturn]] inline void throw_out_of_partition(size_t index, size_t size)
+    {
+        throw std::out_of_range("index " + std::to_string(index) + " is out of a partition of " + std::to_string(size) + " records");
+    }
+
+    // Random access over records `stride` bytes apart, see Partition.
+    template<typename T>
+    class StridedIterator
+    {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using reference = T const&;
+        using pointer = T const*;
+        using difference_type = std::ptrdiff_t;
+
+        StridedIterator() = default;
+
+        StridedIterator(T const* record, size_t stride)
+            : record_(reinterpret_cast<std::byte const*>(record))
+            , stride_(static_cast<difference_type>(stride))
+        {}
+
+        T const& operator*() const { return *get(); }
+        T const* operator->() const { return get(); }
+        T const& operator[](difference_type n) const { return *(*this + n); }
+
+        // The record, valid for dereferenceable iterators.
+        T const* get() const { return reinterpret_cast<T const*>(record_); }
+
+        StridedIterator& operator++() { record_ += stride_; return *this; }
+        StridedIterator& operator--() { record_ -= stride_; return *this; }
+        StridedIterator operator++(int) { auto res = *this; ++*this; return res; }
+        StridedIterator operator--(int) { auto res = *this; --*this; return res; }
+        StridedIterator& operator+=(difference_type n) { record_ += n * stride_; return *this; }
+        StridedIterator& operator-=(difference_type n) { record_ -= n * stride_; return *this; }
+
+        friend StridedIterator operator+(StridedIterator it, difference_type n) { return it += n; }
+        friend StridedIterator operator+(difference_type n, StridedIterator it) { return it += n; }
+        friend StridedIterator operator-(StridedIterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(StridedIterator a, StridedIterator b) { return (a.record_ - b.record_) / a.stride_; }
+
+        friend bool operator==(StridedIterator a, StridedIterator b) { return a.record_ == b.record_; }
+        friend auto operator<=>(StridedIterator a, StridedIterator b) { return a.record_ <=> b.record_; }
+
+    private:
+        std::byte const* record_ = nullptr;
+        difference_type stride_ = 0;
+    };
+
+    // A field of every record of a partition, in place: a view striding over the records, see Partition::column.
+    // Scans of the field still load the whole records, see MaterializedColumn for a contiguous copy.
+    template<typename T, typename M, typename Index = uint32_t>
+    class PartitionColumn : public std::ranges::view_base
+    {
+    public:
+        struct Iterator
+        {
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = M;
+            using reference = M const&;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            Iterator(StridedIterator<T> record, M T::* member)
+                : record_(record)
+                , member_(member)
+            {}
+
+            M const& operator*() const { return *record_.*member_; }
+            M const& operator[](difference_type n) const { return record_[n].*member_; }
+
+            Iterator& operator++() { ++record_; return *this; }
+            Iterator& operator--() { --record_; return *this; }
+            Iterator operator++(int) { auto res = *this; ++record_; return res; }
+            Iterator operator--(int) { auto res = *this; --record_; return res; }
+            Iterator& operator+=(difference_type n) { record_ += n; return *this; }
+            Iterator& operator-=(difference_type n) { record_ -= n; return *this; }
+
+            friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+            friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+            friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(Iterator a, Iterator b) { return a.record_ - b.record_; }
+
+            friend bool operator==(Iterator a, Iterator b) { return a.record_ == b.record_; }
+            friend auto operator<=>(Iterator a, Iterator b) { return a.record_ <=> b.record_; }
+
+        private:
+            StridedIterator<T> record_;
+            M T::* member_ = nullptr;
+        };
+
+        PartitionColumn() = default;
+
+        PartitionColumn(StridedIterator<T> first, size_t size, M T::* member)
+            : first_(first)
+            , size_(size)
+            , member_(member)
+        {}
+
+        M const& operator[] (Index index) const
+        {
+            if constexpr (CanValidateIndexSort<T, Index>)
+            {
+                assert(index.sort() == T::Sort);
+            }
+            return first_[static_cast<std::ptrdiff_t>(get_raw_index(index))].*member_;
+        }
+
+        size_t size() const { return size_; }
+        bool   empty() const { return size_ == 0; }
+
+        Iterator begin() const { return { first_, member_ }; }
+        Iterator end()   const { return { first_ + static_cast<std::ptrdiff_t>(size_), member_ }; }
+
+    private:
+        StridedIterator<T> first_;
+        size_t size_ = 0;
+        M T::* member_ = nullptr;
+    };
+
+    // The records of a partition, in place in the file. Records are `stride()` bytes apart, the entry size of
+    // the partition, which is larger than `sizeof(T)` for files written by newer compilers that append fields
+    // to the records: those fields are skipped without copying the partition.
+    // A checked partition, as those of a File that is not trusted (see FileOptions::trusted), throws
+    // std::out_of_range on indexes and slices out of its records; others only assert.
     template<typename T, typename Index = uint32_t>
     class Partition : public std::ranges::view_base
     {
     public:
+        using Iterator = StridedIterator<T>;
+
         T const & operator[] (Index index) const
         {
             if constexpr (CanValidateIndexSort<T, Index>)
             {
                 assert(index.sort() == T::Sort);
             }
-            return data_[static_cast<size_t>(get_raw_index(index))];
+            const auto i = static_cast<size_t>(get_raw_index(index));
+            if (checked_ && i >= size_) [[unlikely]]
+                throw_out_of_partition(i, size_);
+            assert(i < size_);
+            return at(i);
         }
 
+        // The first record; the records are an array only if the partition is contiguous.
         T const* data() const { return data_; }
         size_t   size() const { return size_; }
+        size_t   stride() const { return stride_; }
+        bool     contiguous() const { return stride_ == sizeof(T); }
+        bool     checked() const { return checked_; }
 
-        T const * begin() const { return data_; }
-        T const * end()   const { return data_ + size_; }
+        Iterator begin() const { return { data_, stride_ }; }
+        Iterator end()   const { return { &at(size_), stride_ }; }
 
-        T const& front() const { return *begin(); }
+        T const& front() const { return *data_; }
+
+        // Position of a record of the partition.
+        size_t index_of(T const& record) const
+        {
+            return static_cast<size_t>(reinterpret_cast<std::byte const*>(&record) - reinterpret_cast<std::byte const*>(data_)) / stride_;
+        }
+
+        // View of one field of the records, e.g. `functions.column(&FunctionDeclaration::name)`.
+        // `Base` lets fields of base classes be named through the record, as in the example.
+        template<typename M, typename Base>
+            requires std::derived_from<T, Base>
+        PartitionColumn<T, M, Index> column(M Base::* member) const
+        {
+            return { begin(), size_, static_cast<M T::*>(member) };
+        }
 
         Partition slice(Sequence seq)
         {
-            return { data_ + static_cast<std::ptrdiff_t>(seq.start), raw_count(seq.cardinality) };
+            const auto start = static_cast<size_t>(seq.start);
+            const auto count = raw_count(seq.cardinality);
+            if (checked_ && (start > size_ || count > size_ - start)) [[unlikely]]
+                throw_out_of_partition(start + count, size_);
+            return { &at(start), count, stride_, checked_ };
         }
 
         Partition drop(std::size_t n) const
         {
-            return { data_ + n, size_ - n };
+            if (checked_ && n > size_) [[unlikely]]
+                throw_out_of_partition(n, size_);
+            return { &at(n), size_ - n, stride_, checked_ };
         }
 
-        Partition(T const * data, size_t size)
+        Partition(T const * data, size_t size, size_t stride = sizeof(T), bool checked = false)
             : data_(data)
             , size_(size)
+            , stride_(stride)
+            , checked_(checked)
         {}
 
     private:
+        T const& at(size_t i) const
+        {
+            return *reinterpret_cast<T const*>(reinterpret_cast<std::byte const*>(data_) + i * stride_);
+        }
+
         T const* data_;
         size_t size_;
+        size_t stride_;
+        bool checked_;
     };
 }
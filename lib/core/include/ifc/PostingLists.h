@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Environment.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ifc
+{
+    // Sorted lists of declarations across the modules of an Environment, e.g. the declarations of each symbol,
+    // the users of each type or the declarations of each attribute, compressed into one buffer.
+    //
+    // Lists are split into blocks of 128 postings. The first posting of a block is stored whole, the others
+    // as the file delta from the previous posting and, within a file and sort, the index delta, bit-packed
+    // at the widths of the largest of the block; declarations starting a file or sort follow as varints.
+    // Postings of one file with nearby declarations take a few bits each instead of 8 bytes. Blocks are
+    // unpacked whole by loops over fixed widths, and lists of more than one block start with the first
+    // posting and offset of each later block, so that cursors skip the blocks ending before their target.
+    //
+    // Reads are safe from multiple threads, add is not.
+    class PostingLists
+    {
+    public:
+        using ListId = uint32_t;
+
+        static constexpr uint32_t BlockSize = 128;
+
+        PostingLists();
+
+        // Appends a list, sorted and without duplicates, throws std::invalid_argument otherwise.
+        ListId add(std::span<DeclarationId const> postings);
+
+        // Number of lists.
+        size_t size() const { return offsets_.size(); }
+
+        // Number of postings of the list.
+        uint32_t count(ListId) const;
+
+        // Total number of postings of the lists.
+        uint64_t postings() const { return postings_; }
+
+        std::vector<DeclarationId> decode(ListId) const;
+
+        bool contains(ListId, DeclarationId) const;
+
+        // Postings in every one of the lists, driven by the shortest one.
+        std::vector<DeclarationId> intersect(std::span<ListId const> lists) const;
+
+        size_t heap_bytes() const;
+
+        // Postings of a list in increasing order, decoded a block at a time.
+        class Cursor
+        {
+        public:
+            Cursor(PostingLists const&, ListId);
+
+            bool at_end() const { return block_ == blocks_; }
+            DeclarationId value() const { return values_[position_]; }
+            uint32_t size() const { return count_; }
+
+            void next()
+            {
+                if (++position_ == block_size_)
+                    enter(block_ + 1);
+            }
+
+            // To the first posting not below the target.
+            void advance_to(DeclarationId target);
+
+        private:
+            void enter(uint32_t block);
+            DeclarationId block_first(uint32_t block) const;
+
+            uint8_t const* skips_ = nullptr; // Entries of the blocks after the first
+            uint8_t const* first_block_ = nullptr;
+            DeclarationId first_;
+            uint32_t count_ = 0;
+            uint32_t blocks_ = 0;
+            uint32_t block_ = 0;
+            uint32_t block_size_ = 0;
+            uint32_t position_ = 0;
+            std::array<DeclarationId, BlockSize> values_;
+        };
+
+    private:
+        std::vector<uint8_t> bytes_; // Followed by padding, so that bit-unpacking reads 8 bytes at a time
+        std::vector<uint64_t> offsets_; // Of the lists in bytes_
+        uint64_t postings_ = 0;
+    };
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Environment.h"
+#include "File.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace ifc
+{
+    // Memoized answers of queries over many Files, e.g. "members of X including inherited ones", each with
+    // the Files it read. Files are identified by the checksum of their BMI, so an answer stays valid while
+    // the BMIs it read are unchanged, even across evictions and reloads of the same contents, and only the
+    // answers that read a BMI are dropped when it changes. Safe to use from multiple threads.
+    class QueryCache
+    {
+    public:
+        // The Files a computation reads, see get.
+        class Reads
+        {
+        public:
+            void add(File const& file) { add(file.header().checksum); }
+            void add(SHA256 const&);
+
+        private:
+            friend QueryCache;
+            std::vector<SHA256> checksums_;
+        };
+
+        // The answer to the query `kind` with the key, computed by `compute(reads)` if it is not cached.
+        // `compute` runs without locks, so concurrent misses compute the same answer more than once; it must
+        // add every File its answer depends on to `reads`. The answer must not point into the Files it read,
+        // which may be unloaded while it is cached, and is not cached if one of them changes meanwhile.
+        template<typename T, typename Compute>
+        std::shared_ptr<T const> get(std::string_view kind, std::string_view key, Compute&& compute)
+        {
+            auto full_key = make_key(kind, key);
+            if (auto found = find(full_key, typeid(T)))
+                return std::static_pointer_cast<T const>(std::move(found));
+
+            const auto invalidations = invalidations_.load(std::memory_order_acquire);
+            Reads reads;
+            auto answer = std::make_shared<T const>(compute(reads));
+            insert(std::move(full_key), typeid(T), answer, std::move(reads), invalidations);
+            return answer;
+        }
+
+        // Drops the answers that read the BMI with the checksum, returns their number.
+        size_t invalidate(SHA256 const&);
+        // Drops the answers that read the previous version of a reloaded BMI, unless it was unchanged.
+        size_t invalidate(Environment::Reload const&);
+        void clear();
+
+        struct Stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t invalidated = 0;
+        };
+
+        Stats stats() const;
+        size_t size() const;
+        size_t heap_bytes() const;
+
+    private:
+        static std::string make_key(std::string_view kind, std::string_view key);
+        std::shared_ptr<void const> find(std::string const& key, std::type_index);
+        void insert(std::string key, std::type_index, std::shared_ptr<void const>, Reads, uint64_t invalidations);
+
+        struct ChecksumHasher
+        {
+            size_t operator() (SHA256 const& checksum) const noexcept;
+        };
+
+        struct ChecksumEqual
+        {
+            bool operator() (SHA256 const& a, SHA256 const& b) const noexcept { return a.data == b.data; }
+        };
+
+        struct Entry
+        {
+            std::type_index type;
+            std::shared_ptr<void const> answer;
+            std::vector<SHA256> reads;
+        };
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+        // Keys of the entries that read each BMI.
+        std::unordered_map<SHA256, std::vector<std::string>, ChecksumHasher, ChecksumEqual> readers_;
+
+        // Incremented by every invalidation, answers computed across one are not cached.
+        std::atomic<uint64_t> invalidations_ = 0;
+        std::atomic<uint64_t> hits_ = 0;
+        std::atomic<uint64_t> misses_ = 0;
+        uint64_t invalidated_ = 0;
+    };
+}
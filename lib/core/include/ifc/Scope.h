@@ -30,7 +30,10 @@ namespace ifc
             return Base::operator[](ScopeIndex{static_cast<uint32_t>(index) - 1});
         }
 
+        using Base::data;
         using Base::size;
+        using Base::stride;
+        using Base::checked;
         using Base::begin;
         using Base::end;
     };
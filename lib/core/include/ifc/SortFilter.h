@@ -0,0 +1,102 @@
+#pragma once
+
+#include "AbstractReference.h"
+#include "Partition.h"
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ifc
+{
+    // Positions of the `count` 32-bit words at `words` whose bits under `tag_mask` equal `tag`, written to
+    // `positions`. Its capacity is reused between calls. Words are compared in blocks by a loop without
+    // branches, which compilers vectorize, and blocks are skipped 8 words at a time where nothing matched.
+    void find_tagged(void const* words, size_t count, uint32_t tag_mask, uint32_t tag, std::vector<uint32_t>& positions);
+
+    // Adds to `counts[t]` the number of the `count` 32-bit words at `words` whose bits under `tag_mask` equal t.
+    // `tag_mask` is a low bit mask (2^n - 1) and `counts` has at least 2^n elements. Consecutive words are
+    // counted into separate tables, so that runs of equal tags do not wait on each other's increments.
+    void count_tagged(void const* words, size_t count, uint32_t tag_mask, std::span<size_t> counts);
+
+    // Whether each of the `count` 32-bit words at `words`, `stride` bytes apart, is zero or has its bits above
+    // `tag_mask` (a low bit mask, 2^n - 1) below `limits[t]`, t being its bits under the mask: whether abstract
+    // references are null or within the partitions of their sorts. `limits` has at least 2^n elements.
+    // Words are checked by a loop without branches, a block of them at a time.
+    bool references_within(void const* words, size_t count, size_t stride, uint32_t tag_mask, std::span<uint32_t const> limits);
+
+    namespace detail
+    {
+        template<typename T>
+        struct ReferenceOf
+        {
+        };
+
+        template<int N, typename Sort>
+        struct ReferenceOf<AbstractReference<N, Sort>>
+        {
+            using type = AbstractReference<N, Sort>;
+        };
+
+        // Records holding just a reference, like `scope.member`.
+        template<typename T>
+            requires requires { typename decltype(T::index)::Sort; }
+        struct ReferenceOf<T>
+        {
+            using type = decltype(T::index);
+        };
+    }
+
+    // Abstract reference type of the entries of a partition that can be filtered by sort.
+    template<typename T>
+    using ReferenceOf = typename detail::ReferenceOf<T>::type;
+
+    template<typename T>
+    concept SortFilterable = sizeof(T) == sizeof(uint32_t) && std::is_trivially_copyable_v<T>
+        && requires { typename ReferenceOf<T>::Sort; ReferenceOf<T>::SortCount; };
+
+    // Positions of the entries whose reference has the sort, see find_tagged.
+    template<SortFilterable T>
+    void find_sort(std::span<T const> entries, typename ReferenceOf<T>::Sort sort, std::vector<uint32_t>& positions)
+    {
+        // The tag is in the low bits of a reference.
+        find_tagged(entries.data(), entries.size(), static_cast<uint32_t>(ReferenceOf<T>::SortCount - 1),
+                    static_cast<uint32_t>(sort), positions);
+    }
+
+    template<SortFilterable T, typename Index>
+    void find_sort(Partition<T, Index> entries, typename ReferenceOf<T>::Sort sort, std::vector<uint32_t>& positions)
+    {
+        if (entries.contiguous())
+            return find_sort(std::span(entries.data(), entries.size()), sort, positions);
+
+        // Records of files with larger entries are filtered one by one.
+        positions.clear();
+        uint32_t position = 0;
+        for (auto const & entry : entries)
+        {
+            if (std::bit_cast<ReferenceOf<T>>(entry).sort() == sort)
+                positions.push_back(position);
+            ++position;
+        }
+    }
+
+    // Adds the number of entries of each sort to `counts`, indexed by sort, see count_tagged.
+    template<SortFilterable T>
+    void count_sorts(std::span<T const> entries, std::span<size_t, ReferenceOf<T>::SortCount> counts)
+    {
+        count_tagged(entries.data(), entries.size(), static_cast<uint32_t>(ReferenceOf<T>::SortCount - 1), counts);
+    }
+
+    template<SortFilterable T, typename Index>
+    void count_sorts(Partition<T, Index> entries, std::span<size_t, ReferenceOf<T>::SortCount> counts)
+    {
+        if (entries.contiguous())
+            return count_sorts(std::span(entries.data(), entries.size()), counts);
+
+        for (auto const & entry : entries)
+            ++counts[static_cast<size_t>(std::bit_cast<ReferenceOf<T>>(entry).sort())];
+    }
+}
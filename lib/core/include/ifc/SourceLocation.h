@@ -1,5 +1,8 @@
 #pragma once
 
+#include "NameFwd.h"
+#include "common_types.h"
+
 #include <cstdint>
 
 namespace ifc
@@ -10,6 +13,8 @@ namespace ifc
 
     enum class Column : uint32_t {};
 
+    enum class LineNumber : uint32_t {};
+
     struct SourceLocation
     {
         LineIndex   line;
@@ -21,4 +26,14 @@ namespace ifc
                    static_cast<uint32_t>(column) == 0;
         }
     };
+
+    // Entry of the line table, which a LineIndex indexes: the source file (a NameIndex of sort
+    // NameSort::SourceFile, null if unknown) and the line in it.
+    struct FileAndLine
+    {
+        NameIndex   file;
+        LineNumber  line;
+
+        PARTITION_NAME("src.line");
+    };
 }
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "File.h"
+#include "Parallel.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ifc
+{
+    // Dense number of a text across the Files of a SymbolTable, see Environment::symbols.
+    enum class SymbolId : uint32_t {};
+
+    // Texts of the strings of many Files, numbered from 0, so that names of different modules
+    // (e.g. `std`, `size_type`) compare as integers. Each File gets a table from its own text symbols
+    // (File::text_symbol) to the global ones, built on first use with one lock per shard of the texts
+    // it interns. Texts are copied, they outlive the Files. Safe to use from multiple threads.
+    class SymbolTable
+    {
+    public:
+        SymbolTable();
+        ~SymbolTable();
+
+        SymbolTable(SymbolTable const&) = delete;
+        SymbolTable& operator=(SymbolTable const&) = delete;
+
+        // Global symbol of each text symbol of the file. Valid until `forget(file)`.
+        std::span<SymbolId const> symbols(File const&);
+
+        // Empty if the offset does not start a string.
+        std::optional<SymbolId> symbol(File const&, TextOffset);
+
+        // Builds the tables of the files, one per task of the executor.
+        void intern(std::span<File const* const>, Executor& = default_executor());
+
+        // Empty if no File interned the text.
+        std::optional<SymbolId> find(std::string_view) const;
+
+        // Of the symbols returned so far.
+        std::string_view text(SymbolId) const;
+
+        uint32_t size() const { return count_.load(std::memory_order_acquire); }
+
+        // Drops the table of the file, e.g. once it was unloaded. Its symbols stay.
+        void forget(File const&);
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Shard;
+
+        SymbolId intern(Shard&, std::string_view);
+        std::vector<SymbolId> build(File const&);
+
+        static constexpr size_t ShardCount = 64;
+        std::array<std::unique_ptr<Shard>, ShardCount> shards_;
+
+        // Texts by id, in segments that never move once allocated.
+        static constexpr uint32_t SegmentBits = 14;
+        static constexpr uint32_t Segments = 4096;
+        std::mutex segments_mutex_;
+        std::array<std::atomic<std::string_view*>, Segments> texts_{};
+        std::atomic<uint32_t> count_ = 0;
+
+        mutable std::shared_mutex files_mutex_;
+        std::unordered_map<File const*, std::unique_ptr<std::vector<SymbolId> const>> files_;
+    };
+}
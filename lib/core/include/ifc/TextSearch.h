@@ -0,0 +1,34 @@
+#pragma once
+
+#include "FileFwd.h"
+#include "common_types.h"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ifc
+{
+    enum class TextMatch : uint8_t
+    {
+        Prefix,     // Texts starting with the pattern
+        Substring,  // Texts containing the pattern
+    };
+
+    // Offsets [start, end) of the string table whose texts match. Strings may share their tails, so
+    // a text offset may point into the middle of a string, and every such offset is covered.
+    struct TextRange
+    {
+        uint32_t start;
+        uint32_t end;
+    };
+
+    // Texts of the string table that match the pattern, written to `ranges` in increasing order, without
+    // overlaps. Its capacity is reused between calls. One pass over the table: `memchr` for the first
+    // character of the pattern, which the C library vectorizes, then `memcmp`.
+    void find_text_ranges(File const&, std::string_view pattern, TextMatch, std::vector<TextRange>& ranges);
+
+    // Whether one of the ranges, as written by find_text_ranges, covers the offset.
+    bool contains(std::span<TextRange const> ranges, TextOffset);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace ifc
+{
+    // Receives the spans of work done while loading modules: reading and validating BMIs and building their
+    // indices. Called from every thread that does such work, so implementations must be thread-safe.
+    class TraceSink
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // `detail` is empty, or names what the span worked on (e.g. the path of a BMI).
+        virtual void complete(std::string_view name, std::string_view category, std::string_view detail,
+                              Clock::time_point start, Clock::duration duration) = 0;
+        virtual ~TraceSink() = default;
+    };
+
+    // Writes the spans as Chrome trace events (JSON), which chrome://tracing and Perfetto open.
+    // The trace is complete once the writer is destroyed.
+    class ChromeTraceWriter final : public TraceSink
+    {
+    public:
+        explicit ChromeTraceWriter(std::ostream& out);
+        ~ChromeTraceWriter() override;
+
+        ChromeTraceWriter(ChromeTraceWriter const&) = delete;
+        ChromeTraceWriter& operator=(ChromeTraceWriter const&) = delete;
+
+        void complete(std::string_view name, std::string_view category, std::string_view detail,
+                      Clock::time_point start, Clock::duration duration) override;
+
+    private:
+        std::mutex mutex_;
+        std::ostream& out_;
+        Clock::time_point origin_;
+        bool first_event_ = true;
+        // Small thread ids, in order of their first event.
+        std::unordered_map<std::thread::id, size_t> threads_;
+    };
+
+    // Installs the sink receiving the spans of all threads, nullptr stops tracing (the default).
+    // The sink must outlive its installation and the spans in progress when it is replaced.
+    void set_trace_sink(TraceSink* sink);
+    TraceSink* trace_sink();
+
+    // Reports the span of its lifetime to the installed sink. Without one it costs one atomic load.
+    class TraceScope
+    {
+    public:
+        TraceScope(std::string_view name, std::string_view category)
+            : sink_(trace_sink())
+            , name_(name)
+            , category_(category)
+        {
+            if (sink_)
+                start_ = TraceSink::Clock::now();
+        }
+
+        TraceScope(std::string_view name, std::string_view category, std::filesystem::path const& path)
+            : TraceScope(name, category)
+        {
+            if (sink_)
+                detail_ = path.string();
+        }
+
+        ~TraceScope()
+        {
+            if (sink_)
+                sink_->complete(name_, category_, detail_, start_, TraceSink::Clock::now() - start_);
+        }
+
+        TraceScope(TraceScope const&) = delete;
+        TraceScope& operator=(TraceScope const&) = delete;
+
+    private:
+        TraceSink* sink_;
+        std::string_view name_;
+        std::string_view category_;
+        std::string detail_;
+        TraceSink::Clock::time_point start_;
+    };
+}
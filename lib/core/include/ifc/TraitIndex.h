@@ -0,0 +1,106 @@
+#pragma once
+
+#include "File.h"
+#include "MemoryUsage.h"
+#include "Trait.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace ifc
+{
+    // Traits of the declarations of `AssociatedTrait<T>` partitions as two flat arrays sorted by declaration,
+    // the declarations and their traits: the traits of a declaration are one range of both, found by binary
+    // search. Traits of a declaration keep the order of the partitions, and their order within each.
+    template<typename T>
+    class TraitIndex
+    {
+    public:
+        explicit TraitIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : decls_(resource)
+            , values_(resource)
+        {
+        }
+
+        TraitIndex(std::initializer_list<Partition<AssociatedTrait<T>, Index>> partitions, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : TraitIndex(resource)
+        {
+            std::vector<AssociatedTrait<T>> traits;
+            for (auto const & partition : partitions)
+                traits.insert(traits.end(), partition.begin(), partition.end());
+            if (!std::ranges::is_sorted(traits, {}, &AssociatedTrait<T>::decl))
+                std::ranges::stable_sort(traits, {}, &AssociatedTrait<T>::decl);
+
+            // Reserved up front, so that growing leaves no dead buffers in an arena.
+            decls_.reserve(traits.size());
+            values_.reserve(traits.size());
+            for (auto const & [decl, trait] : traits)
+            {
+                decls_.push_back(decl);
+                values_.push_back(trait);
+            }
+        }
+
+        std::span<T const> find(DeclIndex decl) const
+        {
+            const auto [first, last] = std::ranges::equal_range(decls_, decl);
+            return std::span(values_).subspan(static_cast<size_t>(first - decls_.begin()), static_cast<size_t>(last - first));
+        }
+
+        // The last trait of the declaration or a null one, for partitions of at most one trait per declaration.
+        T find_last(DeclIndex decl) const
+        {
+            const auto traits = find(decl);
+            return traits.empty() ? T{} : traits.back();
+        }
+
+        // Declarations with traits in DeclIndex order, once per trait.
+        std::span<DeclIndex const> declarations() const { return decls_; }
+
+        size_t size() const { return decls_.size(); }
+
+        size_t heap_bytes() const
+        {
+            return ifc::heap_bytes(decls_) + ifc::heap_bytes(values_);
+        }
+
+    private:
+        std::pmr::vector<DeclIndex> decls_;
+        std::pmr::vector<T> values_;
+    };
+
+    // Name of a trait partition as a template argument, see NamedTraitIndex.
+    template<size_t N>
+    struct TraitPartitionName
+    {
+        char value[N];
+
+        constexpr TraitPartitionName(char const (&name)[N])
+        {
+            std::copy_n(name, N, value);
+        }
+
+        constexpr std::string_view view() const { return { value, N - 1 }; }
+    };
+
+    // TraitIndex of the trait partitions of those names, including those File has no accessor for, e.g.
+    // `file.get_index<NamedTraitIndex<ExprIndex, "trait.alignas">>()`. Absent partitions have no traits.
+    template<typename T, TraitPartitionName... Names>
+    class NamedTraitIndex : public TraitIndex<T>
+    {
+    public:
+        static_assert(sizeof...(Names) != 0, "a trait index needs at least one partition");
+
+        static constexpr std::string_view Partitions[] = { Names.view()... };
+
+        explicit NamedTraitIndex(File const& file)
+            : TraitIndex<T>({ file.get_partition_by_name<AssociatedTrait<T>>(Names.view())... }, file.memory_resource())
+        {
+        }
+    };
+}
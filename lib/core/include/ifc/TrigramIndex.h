@@ -0,0 +1,68 @@
+#pragma once
+
+#include "SymbolTable.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+namespace ifc
+{
+    // Identifiers of a SymbolTable (e.g. Environment::symbols) by the trigrams of their lowercase texts, for
+    // "go to symbol" fuzzy search across every module interned without scanning their string tables.
+    // Only texts made of letters, digits and `_` are identifiers. Symbols are numbered in interning order,
+    // so the posting list of each trigram grows at its end: update indexes the symbols interned since the
+    // last one. Posting lists are delta-encoded varints in blocks of 128 symbols, with the first symbol and
+    // offset of each block kept aside so that intersections skip whole blocks. Safe to use from multiple threads.
+    class TrigramIndex
+    {
+    public:
+        struct SearchOptions
+        {
+            size_t limit = 100;
+            // Fraction of the trigrams of the pattern a match must share, 1 for every one of them, which
+            // intersects their posting lists. Lower values tolerate typos, at the cost of merging them.
+            float min_shared = 1.0f;
+        };
+
+        struct Match
+        {
+            SymbolId symbol;
+            uint32_t shared; // Trigrams of the pattern in the identifier
+        };
+
+        TrigramIndex();
+        ~TrigramIndex();
+
+        TrigramIndex(TrigramIndex const&) = delete;
+        TrigramIndex& operator=(TrigramIndex const&) = delete;
+
+        // Indexes the identifiers interned since the last update.
+        void update(SymbolTable const&);
+
+        // Identifiers matching the pattern, case-insensitively, best first: by shared trigrams, then those
+        // starting with the pattern, then those containing it, then shorter ones. Patterns shorter than a
+        // trigram match the identifiers containing them.
+        std::vector<Match> search(SymbolTable const&, std::string_view pattern, SearchOptions options) const;
+        std::vector<Match> search(SymbolTable const& symbols, std::string_view pattern) const { return search(symbols, pattern, {}); }
+
+        // Symbols indexed so far (identifiers or not).
+        uint32_t indexed() const;
+
+        size_t heap_bytes() const;
+
+    private:
+        class PostingList;
+
+        // Letters (case-insensitively), digits and `_`.
+        static constexpr uint32_t Alphabet = 37;
+
+        mutable std::shared_mutex mutex_;
+        std::vector<PostingList> lists_; // By trigram, Alphabet^3 of them
+        std::vector<SymbolId> identifiers_; // For patterns shorter than a trigram
+        uint32_t indexed_ = 0;
+    };
+}
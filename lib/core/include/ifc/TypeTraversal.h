@@ -0,0 +1,156 @@
+#pragma once
+
+#include "File.h"
+#include "Type.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ifc
+{
+    // Calls `fn(TypeIndex)` for every type the type is directly made of (pointee, function parameters
+    // and return type, tuple elements, ...), in order, including null ones (e.g. the scope of a method type).
+    // Declarations, expressions and syntax trees referred to by the type are not followed.
+    template<typename Fn>
+    void for_each_type_operand(File const& file, TypeIndex type, Fn && fn)
+    {
+        auto operand = [&fn](TypeIndex index) {
+            fn(index);
+        };
+
+        switch (type.sort())
+        {
+        case TypeSort::Expansion:
+            operand(file.expansion_types()[type].pack);
+            break;
+        case TypeSort::Pointer:
+            operand(file.pointer_types()[type].pointee);
+            break;
+        case TypeSort::LvalueReference:
+            operand(file.lvalue_references()[type].referee);
+            break;
+        case TypeSort::RvalueReference:
+            operand(file.rvalue_references()[type].referee);
+            break;
+        case TypeSort::Function:
+        {
+            auto const & function = file.function_types()[type];
+            operand(function.target);
+            operand(function.source);
+            break;
+        }
+        case TypeSort::Method:
+        {
+            auto const & method = file.method_types()[type];
+            operand(method.target);
+            operand(method.source);
+            operand(method.scope);
+            break;
+        }
+        case TypeSort::Tor:
+            operand(file.tor_types()[type].source);
+            break;
+        case TypeSort::Array:
+            operand(file.array_types()[type].element);
+            break;
+        case TypeSort::Qualified:
+            operand(file.qualified_types()[type].unqualified);
+            break;
+        case TypeSort::Base:
+            operand(file.base_types()[type].type);
+            break;
+        case TypeSort::Tuple:
+            for (auto element : file.type_heap().slice(file.tuple_types()[type].seq))
+                operand(element);
+            break;
+        case TypeSort::Forall:
+            operand(file.forall_types()[type].subject);
+            break;
+        case TypeSort::Placeholder:
+            operand(file.placeholder_types()[type].elaboration);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Walks the type graph of a file (a DAG, operands are shared between types) iteratively,
+    // visiting each type once across all walks. Visited types are tracked in a bitset per TypeSort.
+    class TypeTraversal
+    {
+    public:
+        explicit TypeTraversal(File const& file)
+            : file_(&file)
+        {
+        }
+
+        // Calls `visit(TypeIndex)` for the root and every type reachable from it
+        // that was not visited before, each type before its operands.
+        template<typename Visit>
+        void walk(TypeIndex root, Visit && visit)
+        {
+            if (root.is_null() || !mark(root))
+                return;
+
+            stack_.push_back(root);
+            while (!stack_.empty())
+            {
+                const auto type = stack_.back();
+                stack_.pop_back();
+                visit(type);
+                for_each_type_operand(*file_, type, [this](TypeIndex operand) {
+                    if (!operand.is_null() && mark(operand))
+                        stack_.push_back(operand);
+                });
+            }
+        }
+
+        void walk(TypeIndex root)
+        {
+            walk(root, [](TypeIndex) {});
+        }
+
+        bool visited(TypeIndex type) const
+        {
+            auto const & bits = visited_[type.tag];
+            const size_t word = type.index / 64;
+            return word < bits.size() && (bits[word] >> (type.index % 64) & 1) != 0;
+        }
+
+        size_t visited_count() const { return visited_count_; }
+
+    private:
+        // False if the type was already visited.
+        bool mark(TypeIndex type)
+        {
+            auto & bits = visited_[type.tag];
+            const size_t word = type.index / 64;
+            if (word >= bits.size())
+                bits.resize(word + 1);
+
+            const auto bit = uint64_t{ 1 } << (type.index % 64);
+            if (bits[word] & bit)
+                return false;
+            bits[word] |= bit;
+            ++visited_count_;
+            return true;
+        }
+
+        File const* file_;
+        std::array<std::vector<uint64_t>, TypeIndex::SortCount> visited_;
+        std::vector<TypeIndex> stack_;
+        size_t visited_count_ = 0;
+    };
+
+    // Every type reachable from the roots, each once, in visiting order.
+    inline std::vector<TypeIndex> reachable_types(File const& file, std::span<TypeIndex const> roots)
+    {
+        std::vector<TypeIndex> result;
+        TypeTraversal traversal(file);
+        for (auto root : roots)
+            traversal.walk(root, [&result](TypeIndex type) { result.push_back(type); });
+        return result;
+    }
+}
@@ -17,6 +17,11 @@ namespace ifc
         Identifier = 0x06, // Word::value type is SourceIdentifier
     };
 
+    inline bool is_null(SentenceIndex sentence)
+    {
+        return sentence == SentenceIndex{0};
+    }
+
     struct Sentence
     {
         WordIndex start;
@@ -0,0 +1,96 @@
+#pragma once
+
+/* C interface over ifc::File for embedding the reader through an FFI. Partitions are exposed in place:
+ * base pointers into the blob, entry counts and entry sizes, so that consumers scan them in their own runtime
+ * without a call per element. Records have the layout of the IFC specification (and of the structs of the
+ * ifc headers): little-endian, packed at 4 bytes, references being 32-bit values with the sort in the low bits.
+ *
+ * Functions taking a file accept only live files from ifc_file_open. Pointers returned for a file stay valid
+ * until it is closed, the blob must outlive it. Files can be read from several threads at once. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Incremented on incompatible changes of this interface. */
+#define IFC_C_API_VERSION 1
+
+typedef struct ifc_file ifc_file;
+
+typedef struct ifc_partition
+{
+    const char* name;   /* e.g. "decl.function" */
+    const void* data;   /* count * entry_size bytes, NULL if the partition is empty */
+    uint32_t count;
+    uint32_t entry_size;
+} ifc_partition;
+
+enum
+{
+    IFC_OPEN_VERIFY_CHECKSUM  = 1 << 0, /* See ifc::FileOptions::verify_checksum */
+    IFC_OPEN_EAGER_PARTITIONS = 1 << 1, /* See ifc::FileOptions::eager_partitions */
+};
+
+/* IFC_C_API_VERSION of the library. */
+uint32_t ifc_api_version(void);
+
+/* NULL if the blob is not a valid IFC file, ifc_last_error tells why. */
+ifc_file* ifc_file_open(const void* data, size_t size, uint32_t flags);
+void ifc_file_close(ifc_file* file);
+
+/* Message of the last failure of this thread, empty if there was none. */
+const char* ifc_last_error(void);
+
+/* Partitions in the order of the table of contents. Return 0 if there is no such partition, 1 otherwise. */
+uint32_t ifc_partition_count(const ifc_file* file);
+int ifc_get_partition(const ifc_file* file, uint32_t position, ifc_partition* out);
+int ifc_find_partition(const ifc_file* file, const char* name, ifc_partition* out);
+
+/* Null-terminated strings back to back, addressed by text offset. */
+const char* ifc_string_table(const ifc_file* file, size_t* size);
+/* NULL if the offset is outside of the string table. */
+const char* ifc_get_string(const ifc_file* file, uint32_t text_offset);
+
+enum
+{
+    IFC_FIELD_UNSIGNED  = 0,
+    IFC_FIELD_SIGNED    = 1,
+    IFC_FIELD_REFERENCE = 2, /* Unsigned, the sort in the low `sort_bits` bits and the index in the others */
+};
+
+/* What of the string table a field addresses, see ifc_string_table. */
+enum
+{
+    IFC_TEXT_NONE   = 0,
+    IFC_TEXT_OFFSET = 1, /* A text offset */
+    IFC_TEXT_NAME   = 2, /* A name reference, its index is a text offset when its sort is 0 (identifier) */
+    IFC_TEXT_WORD   = 3, /* The index of a word, a text offset for identifiers and scalar or string literals,
+                            see ifc::Word: its value is the uint16_t 4 bytes after, its sort the uint8_t 6 bytes after */
+};
+
+/* Member of the records of a partition, members of nested structs are named by their path, e.g. "locus.line". */
+typedef struct ifc_field
+{
+    const char* name;
+    uint32_t offset;
+    uint16_t size;      /* Of one element */
+    uint16_t count;     /* Elements, more than 1 for arrays */
+    uint8_t kind;       /* IFC_FIELD_* */
+    uint8_t sort_bits;
+    uint8_t text;       /* IFC_TEXT_* */
+} ifc_field;
+
+/* Members of the records of the partition of that name, from the structs of the ifc headers, e.g. to map a
+ * partition onto a structured array. Entries of a file may be larger than record_size, see ifc_partition.
+ * NULL for partitions without a known layout. Needs no file, the array is static. */
+const ifc_field* ifc_partition_fields(const char* partition_name, uint32_t* count, uint32_t* record_size);
+
+/* Raw ScopeIndex of the global scope, an index into "scope.desc" (1-based, 0 is null). */
+uint32_t ifc_global_scope(const ifc_file* file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,115 @@
+#include "ifc/AllocationCounter.h"
+
+#ifdef IFC_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace ifc
+{
+#ifdef IFC_COUNT_ALLOCATIONS
+    namespace
+    {
+        thread_local AllocationCount counts;
+
+        void* allocate(std::size_t size)
+        {
+            ++counts.allocations;
+            counts.bytes += size;
+            return std::malloc(size != 0 ? size : 1);
+        }
+
+        void* allocate(std::size_t size, std::align_val_t alignment)
+        {
+            ++counts.allocations;
+            counts.bytes += size;
+            const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+            return _aligned_malloc(size != 0 ? size : 1, align);
+#else
+            // aligned_alloc wants a non-zero multiple of the alignment.
+            return std::aligned_alloc(align, (size != 0 ? size + align - 1 : align) / align * align);
+#endif
+        }
+
+        void deallocate(void* pointer, std::align_val_t)
+        {
+#ifdef _WIN32
+            _aligned_free(pointer);
+#else
+            std::free(pointer);
+#endif
+        }
+    }
+
+    AllocationCount thread_allocations()
+    {
+        return counts;
+    }
+#else
+    AllocationCount thread_allocations()
+    {
+        return {};
+    }
+#endif
+}
+
+#ifdef IFC_COUNT_ALLOCATIONS
+// Replacements of the global operators, only linked in along with thread_allocations.
+void* operator new(std::size_t size)
+{
+    if (auto pointer = ifc::allocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+    return ifc::allocate(size);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+{
+    return ifc::allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto pointer = ifc::allocate(size, alignment))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    return ifc::allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept
+{
+    return ifc::allocate(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::nothrow_t const&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::nothrow_t const&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t alignment) noexcept { ifc::deallocate(pointer, alignment); }
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept { ifc::deallocate(pointer, alignment); }
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept { ifc::deallocate(pointer, alignment); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept { ifc::deallocate(pointer, alignment); }
+void operator delete(void* pointer, std::align_val_t alignment, std::nothrow_t const&) noexcept { ifc::deallocate(pointer, alignment); }
+void operator delete[](void* pointer, std::align_val_t alignment, std::nothrow_t const&) noexcept { ifc::deallocate(pointer, alignment); }
+#endif
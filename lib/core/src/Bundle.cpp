@@ -0,0 +1,439 @@
+#include "ifc/Bundle.h"
+#include "ifc/Expression.h"
+#include "ifc/FileWriter.h"
+#include "ifc/Name.h"
+#include "ifc/Word.h"
+#include "ifc/c_api.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace ifc
+{
+    namespace
+    {
+        constexpr std::array<std::byte, 4> BundleSignature = { std::byte{ 'I' }, std::byte{ 'F' }, std::byte{ 'C' }, std::byte{ 'B' } };
+        constexpr uint32_t BundleVersion = 1;
+
+        // Followed by the member records, the string table records, the names, the string tables and the members.
+        struct BundleHeader
+        {
+            std::array<std::byte, 4> signature;
+            uint32_t version;
+            uint32_t member_count;
+            uint32_t string_table_count;
+            uint64_t names_offset;
+            uint64_t names_size;
+        };
+
+        // Members start at multiples of it, as their own partitions are aligned within them.
+        constexpr size_t MemberAlignment = 8;
+
+        void pad(std::vector<std::byte>& out, size_t alignment)
+        {
+            out.resize((out.size() + alignment - 1) / alignment * alignment);
+        }
+
+        void append(std::vector<std::byte>& out, void const* data, size_t size)
+        {
+            const auto bytes = static_cast<std::byte const*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        bool starts_with(std::span<char const> text, std::span<char const> prefix)
+        {
+            return prefix.size() <= text.size() && std::equal(prefix.begin(), prefix.end(), text.begin());
+        }
+
+        // The string table of the members whose text offsets are rewritten, each distinct string stored once.
+        class MergedStringTable
+        {
+        public:
+            MergedStringTable()
+                : bytes_(1, '\0') // The null text offset
+            {
+            }
+
+            TextOffset add(std::string_view text)
+            {
+                auto it = offsets_.find(text);
+                if (it == offsets_.end())
+                {
+                    if (bytes_.size() + text.size() >= UINT32_MAX)
+                        throw std::runtime_error("bundle string table too large");
+                    it = offsets_.emplace(text, TextOffset{ static_cast<uint32_t>(bytes_.size()) }).first;
+                    bytes_.insert(bytes_.end(), text.begin(), text.end());
+                    bytes_.push_back('\0');
+                }
+                return it->second;
+            }
+
+            std::span<char const> bytes() const
+            {
+                return bytes_;
+            }
+
+        private:
+            std::vector<char> bytes_;
+            std::map<std::string, TextOffset, std::less<>> offsets_;
+        };
+
+        // Maps the text offsets of a file to those of the same strings in a MergedStringTable.
+        class TextRemapper
+        {
+        public:
+            TextRemapper(std::span<char const> strings, MergedStringTable& merged)
+                : strings_(strings)
+                , merged_(merged)
+            {
+            }
+
+            TextOffset remap(TextOffset offset)
+            {
+                if (is_null(offset))
+                    return offset;
+                const auto start = static_cast<size_t>(offset);
+                const auto end = start < strings_.size() ? std::find(strings_.begin() + start, strings_.end(), '\0') : strings_.end();
+                if (end == strings_.end())
+                    throw std::runtime_error("corrupted file");
+                return merged_.add({ strings_.data() + start, static_cast<size_t>(end - strings_.begin()) - start });
+            }
+
+            // Of string literals, whose `length` bytes include the terminator and may hold others.
+            TextOffset remap(TextOffset offset, Cardinality length)
+            {
+                if (is_null(offset))
+                    return offset;
+                const auto start = static_cast<size_t>(offset);
+                const auto size = raw_count(length);
+                if (start > strings_.size() || size > strings_.size() - start)
+                    throw std::runtime_error("corrupted file");
+                std::string_view text(strings_.data() + start, size);
+                if (text.ends_with('\0'))
+                    text.remove_suffix(1);
+                return merged_.add(text);
+            }
+
+            // The index of a reference with `sort_bits` bits of sort.
+            uint32_t remap_index(uint32_t offset, uint8_t sort_bits)
+            {
+                const auto remapped = static_cast<uint32_t>(remap(TextOffset{ offset }));
+                if (remapped >> (32 - sort_bits) != 0)
+                    throw std::runtime_error("bundle string table too large");
+                return remapped;
+            }
+
+            void remap(std::byte* record, ifc_field const & field)
+            {
+                if (field.text == IFC_TEXT_NONE)
+                    return;
+                for (size_t i = 0; i != field.count; ++i)
+                {
+                    const auto value = record + field.offset + i * field.size;
+                    uint32_t raw;
+                    std::memcpy(&raw, value, sizeof(raw));
+                    switch (field.text)
+                    {
+                    case IFC_TEXT_OFFSET:
+                        raw = static_cast<uint32_t>(remap(TextOffset{ raw }));
+                        break;
+                    case IFC_TEXT_NAME:
+                        if ((raw & ((1u << field.sort_bits) - 1)) == static_cast<uint32_t>(NameSort::Identifier))
+                            raw = remap_index(raw >> field.sort_bits, field.sort_bits) << field.sort_bits;
+                        break;
+                    case IFC_TEXT_WORD:
+                        if (is_text(value))
+                            raw = static_cast<uint32_t>(remap(TextOffset{ raw }));
+                        break;
+                    }
+                    std::memcpy(value, &raw, sizeof(raw));
+                }
+            }
+
+        private:
+            // Whether the word whose index is at `index` is a text offset, see reflifc::Word.
+            static bool is_text(std::byte const* index)
+            {
+                uint16_t value;
+                WordSort sort;
+                std::memcpy(&value, index + offsetof(Word, value) - offsetof(Word, index), sizeof(value));
+                std::memcpy(&sort, index + offsetof(Word, sort) - offsetof(Word, index), sizeof(sort));
+                switch (sort)
+                {
+                case WordSort::Identifier:
+                    return true;
+                case WordSort::Literal:
+                    switch (static_cast<SourceLiteral>(value))
+                    {
+                    case SourceLiteral::Scalar:
+                    case SourceLiteral::String:
+                    case SourceLiteral::DefinedString:
+                        return true;
+                    default:
+                        return false;
+                    }
+                default:
+                    return false;
+                }
+            }
+
+            std::span<char const> strings_;
+            MergedStringTable& merged_;
+        };
+
+        // Whether all the text offsets of the file can be found, from the layouts of its partitions.
+        bool has_known_layouts(File const & file)
+        {
+            return std::ranges::all_of(file.table_of_contents(), [&file](PartitionSummary const & summary) {
+                uint32_t count, record_size;
+                return ifc_partition_fields(file.get_string(summary.name), &count, &record_size) != nullptr
+                    && record_size == static_cast<size_t>(summary.entry_size);
+            });
+        }
+
+        // Copy of the file without its string table, its text offsets addressing `strings` instead.
+        std::vector<std::byte> with_merged_strings(File const & file, MergedStringTable & strings)
+        {
+            TextRemapper remapper(file.string_table(), strings);
+            auto header = file.header();
+            header.src_path = remapper.remap(header.src_path);
+            switch (header.unit.sort())
+            {
+            case UnitSort::Primary:
+            case UnitSort::Partition:
+            case UnitSort::Header:
+                header.unit.index = remapper.remap_index(header.unit.index, 3);
+                break;
+            default:
+                break;
+            }
+
+            FileWriter writer(header, {});
+            std::vector<std::byte> records;
+            for (auto const & summary : file.table_of_contents())
+            {
+                const auto name = file.get_string(summary.name);
+                const auto data = file.get_data_pointer(summary);
+                records.assign(data, data + summary.size_bytes());
+                if (std::string_view(name) == StringLiteral::PartitionName)
+                {
+                    for (size_t offset = 0; offset != records.size(); offset += sizeof(StringLiteral))
+                    {
+                        StringLiteral literal;
+                        std::memcpy(&literal, records.data() + offset, sizeof(literal));
+                        literal.start = remapper.remap(literal.start, literal.length);
+                        literal.suffix = remapper.remap(literal.suffix);
+                        std::memcpy(records.data() + offset, &literal, sizeof(literal));
+                    }
+                }
+                else
+                {
+                    uint32_t count, record_size;
+                    const auto fields = ifc_partition_fields(name, &count, &record_size);
+                    for (size_t offset = 0; offset != records.size(); offset += record_size)
+                        for (auto const & field : std::span(fields, count))
+                            remapper.remap(records.data() + offset, field);
+                }
+                writer.add_partition(remapper.remap(summary.name), records, static_cast<size_t>(summary.entry_size));
+            }
+            return writer.write();
+        }
+
+        // Copy of the file without its string table, for one of its own.
+        std::vector<std::byte> without_strings(File const & file)
+        {
+            FileWriter writer(file.header(), {});
+            for (auto const & summary : file.table_of_contents())
+                writer.add_partition(summary.name, { file.get_data_pointer(summary), summary.size_bytes() }, static_cast<size_t>(summary.entry_size));
+            return writer.write();
+        }
+
+        class MemberBlobHolder : public Environment::BlobHolder
+        {
+        public:
+            explicit MemberBlobHolder(Bundle::Member member)
+                : member_(member)
+            {
+            }
+
+            File::BlobView view() const override
+            {
+                return member_.blob;
+            }
+
+            std::span<char const> string_table() const override
+            {
+                return member_.string_table;
+            }
+
+        private:
+            Bundle::Member member_;
+        };
+    }
+
+    std::vector<std::byte> Bundle::write(std::span<Entry const> entries)
+    {
+        std::vector<Entry const*> sorted;
+        for (auto const & entry : entries)
+            sorted.push_back(&entry);
+        std::ranges::sort(sorted, {}, &Entry::name);
+        if (std::ranges::adjacent_find(sorted, {}, &Entry::name) != sorted.end())
+            throw std::invalid_argument("bundle entries must have distinct names");
+
+        // Members whose text offsets can all be found share one table of their strings. The others keep
+        // their own table, shared whole with those equal to it or a prefix of it: largest tables first.
+        MergedStringTable merged;
+        std::vector<std::vector<std::byte>> blobs(sorted.size());
+        std::vector<size_t> by_size;
+        for (size_t i = 0; i != sorted.size(); ++i)
+        {
+            if (has_known_layouts(*sorted[i]->file))
+                blobs[i] = with_merged_strings(*sorted[i]->file, merged);
+            else
+                by_size.push_back(i);
+        }
+        std::ranges::stable_sort(by_size, std::greater{}, [&sorted](size_t i) { return sorted[i]->file->string_table().size(); });
+
+        std::vector<std::span<char const>> string_tables;
+        std::vector<uint32_t> string_table_of(sorted.size()); // 0, the merged table, unless shared whole
+        if (by_size.size() != sorted.size())
+            string_tables.push_back(merged.bytes());
+        for (auto i : by_size)
+        {
+            blobs[i] = without_strings(*sorted[i]->file);
+            const auto strings = sorted[i]->file->string_table();
+            const auto shared = std::ranges::find_if(string_tables, [strings](auto table) { return starts_with(table, strings); });
+            string_table_of[i] = static_cast<uint32_t>(shared - string_tables.begin());
+            if (shared == string_tables.end())
+                string_tables.push_back(strings);
+        }
+
+        std::vector<std::byte> names;
+        std::vector<MemberRecord> members(sorted.size());
+        for (size_t i = 0; i != sorted.size(); ++i)
+        {
+            members[i].name_offset = static_cast<uint32_t>(names.size());
+            members[i].name_size = static_cast<uint32_t>(sorted[i]->name.size());
+            members[i].string_table = string_table_of[i];
+            append(names, sorted[i]->name.data(), sorted[i]->name.size());
+        }
+
+        const BundleHeader header{
+            .signature = BundleSignature,
+            .version = BundleVersion,
+            .member_count = static_cast<uint32_t>(members.size()),
+            .string_table_count = static_cast<uint32_t>(string_tables.size()),
+            .names_offset = sizeof(BundleHeader) + members.size() * sizeof(MemberRecord) + string_tables.size() * sizeof(StringTableRecord),
+            .names_size = names.size(),
+        };
+
+        std::vector<std::byte> result(static_cast<size_t>(header.names_offset));
+        append(result, names.data(), names.size());
+
+        std::vector<StringTableRecord> string_table_records;
+        for (auto table : string_tables)
+        {
+            string_table_records.push_back({ result.size(), table.size() });
+            append(result, table.data(), table.size());
+        }
+
+        for (size_t i = 0; i != sorted.size(); ++i)
+        {
+            pad(result, MemberAlignment);
+            members[i].offset = result.size();
+            members[i].size = blobs[i].size();
+            append(result, blobs[i].data(), blobs[i].size());
+        }
+
+        std::memcpy(result.data(), &header, sizeof(header));
+        std::memcpy(result.data() + sizeof(header), members.data(), members.size() * sizeof(MemberRecord));
+        std::memcpy(result.data() + sizeof(header) + members.size() * sizeof(MemberRecord), string_table_records.data(), string_table_records.size() * sizeof(StringTableRecord));
+        return result;
+    }
+
+    Bundle::Bundle(Environment::BlobHolderPtr holder)
+        : holder_(std::move(holder))
+        , blob_(holder_->view())
+    {
+        auto check_range = [this](uint64_t offset, uint64_t size) {
+            if (offset > blob_.size() || size > blob_.size() - offset)
+                throw std::runtime_error("corrupted bundle");
+        };
+
+        BundleHeader header;
+        check_range(0, sizeof(header));
+        std::memcpy(&header, blob_.data(), sizeof(header));
+        if (header.signature != BundleSignature || header.version != BundleVersion)
+            throw std::runtime_error("not a bundle");
+
+        check_range(sizeof(header), uint64_t{ header.member_count } * sizeof(MemberRecord) + uint64_t{ header.string_table_count } * sizeof(StringTableRecord));
+        members_ = { reinterpret_cast<MemberRecord const*>(blob_.data() + sizeof(header)), header.member_count };
+        string_tables_ = { reinterpret_cast<StringTableRecord const*>(members_.data() + members_.size()), header.string_table_count };
+
+        check_range(header.names_offset, header.names_size);
+        for (auto const & member : members_)
+        {
+            check_range(member.offset, member.size);
+            check_range(header.names_offset + member.name_offset, member.name_size);
+            if (member.name_offset + uint64_t{ member.name_size } > header.names_size || member.string_table >= string_tables_.size())
+                throw std::runtime_error("corrupted bundle");
+        }
+        for (auto const & table : string_tables_)
+            check_range(table.offset, table.size);
+    }
+
+    Bundle::Member Bundle::operator[](size_t i) const
+    {
+        BundleHeader header;
+        std::memcpy(&header, blob_.data(), sizeof(header));
+
+        auto const & member = members_[i];
+        auto const & strings = string_tables_[member.string_table];
+        return {
+            .name = { reinterpret_cast<char const*>(blob_.data() + header.names_offset + member.name_offset), member.name_size },
+            .blob = blob_.subspan(static_cast<size_t>(member.offset), static_cast<size_t>(member.size)),
+            .string_table = { reinterpret_cast<char const*>(blob_.data() + strings.offset), static_cast<size_t>(strings.size) },
+        };
+    }
+
+    std::optional<Bundle::Member> Bundle::find(std::string_view name) const
+    {
+        size_t first = 0, count = size();
+        while (count > 0)
+        {
+            const auto half = count / 2;
+            if ((*this)[first + half].name < name)
+            {
+                first += half + 1;
+                count -= half + 1;
+            }
+            else
+            {
+                count = half;
+            }
+        }
+        if (first == size())
+            return std::nullopt;
+        auto member = (*this)[first];
+        if (member.name != name)
+            return std::nullopt;
+        return member;
+    }
+
+    Environment::FileReader Bundle::file_reader(Environment::FileReader fallback) const
+    {
+        return [this, fallback = std::move(fallback)](std::filesystem::path const & path) -> Environment::BlobHolderPtr {
+            if (auto member = find(path.generic_string()))
+                return std::make_unique<MemberBlobHolder>(*member);
+            if (fallback)
+                return fallback(path);
+            throw std::out_of_range("'" + path.generic_string() + "' is not in the bundle");
+        };
+    }
+}
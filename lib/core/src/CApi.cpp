@@ -0,0 +1,108 @@
+#include "ifc/c_api.h"
+
+#include "ifc/File.h"
+
+#include <cstring>
+#include <exception>
+#include <string>
+
+struct ifc_file
+{
+    ifc::File file;
+};
+
+namespace
+{
+    thread_local std::string last_error;
+
+    void describe(ifc::File const& file, ifc::PartitionSummary const& partition, ifc_partition* out)
+    {
+        const auto count = static_cast<uint32_t>(raw_count(partition.cardinality));
+        out->name = file.get_string(partition.name);
+        out->data = count != 0 ? file.blob().data() + static_cast<size_t>(partition.offset) : nullptr;
+        out->count = count;
+        out->entry_size = static_cast<uint32_t>(partition.entry_size);
+    }
+}
+
+extern "C"
+{
+    uint32_t ifc_api_version(void)
+    {
+        return IFC_C_API_VERSION;
+    }
+
+    ifc_file* ifc_file_open(const void* data, size_t size, uint32_t flags)
+    {
+        last_error.clear();
+        try
+        {
+            const ifc::FileOptions options{
+                .eager_partitions = (flags & IFC_OPEN_EAGER_PARTITIONS) != 0,
+                .verify_checksum = (flags & IFC_OPEN_VERIFY_CHECKSUM) != 0,
+            };
+            return new ifc_file{ ifc::File({ static_cast<std::byte const*>(data), size }, options) };
+        }
+        catch (std::exception const& e)
+        {
+            last_error = e.what();
+            return nullptr;
+        }
+    }
+
+    void ifc_file_close(ifc_file* file)
+    {
+        delete file;
+    }
+
+    const char* ifc_last_error(void)
+    {
+        return last_error.c_str();
+    }
+
+    uint32_t ifc_partition_count(const ifc_file* file)
+    {
+        return static_cast<uint32_t>(file->file.table_of_contents().size());
+    }
+
+    int ifc_get_partition(const ifc_file* file, uint32_t position, ifc_partition* out)
+    {
+        const auto partitions = file->file.table_of_contents();
+        if (position >= partitions.size())
+            return 0;
+        describe(file->file, partitions[position], out);
+        return 1;
+    }
+
+    int ifc_find_partition(const ifc_file* file, const char* name, ifc_partition* out)
+    {
+        for (auto const & partition : file->file.table_of_contents())
+        {
+            if (std::strcmp(file->file.get_string(partition.name), name) == 0)
+            {
+                describe(file->file, partition, out);
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    const char* ifc_string_table(const ifc_file* file, size_t* size)
+    {
+        const auto strings = file->file.string_table();
+        *size = strings.size();
+        return strings.data();
+    }
+
+    const char* ifc_get_string(const ifc_file* file, uint32_t text_offset)
+    {
+        if (text_offset >= file->file.string_table().size())
+            return nullptr;
+        return file->file.get_string(ifc::TextOffset{ text_offset });
+    }
+
+    uint32_t ifc_global_scope(const ifc_file* file)
+    {
+        return static_cast<uint32_t>(file->file.header().global_scope);
+    }
+}
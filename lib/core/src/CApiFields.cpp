@@ -0,0 +1,833 @@
+#include "ifc/c_api.h"
+
+#include "ifc/Attribute.h"
+#include "ifc/Chart.h"
+#include "ifc/Declaration.h"
+#include "ifc/Expression.h"
+#include "ifc/File.h"
+#include "ifc/Literal.h"
+#include "ifc/Macro.h"
+#include "ifc/Module.h"
+#include "ifc/Name.h"
+#include "ifc/Operator.h"
+#include "ifc/SourceLocation.h"
+#include "ifc/SyntaxTree.h"
+#include "ifc/Trait.h"
+#include "ifc/Type.h"
+#include "ifc/Word.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Record layouts of ifc_partition_fields, by member of the structs of the ifc headers: offsets, sizes and kinds
+// are taken from the structs themselves, only the member names are listed here.
+namespace ifc
+{
+    namespace
+    {
+        template<typename T>
+        constexpr ifc_field field(const char* name, size_t offset)
+        {
+            using Element = std::remove_extent_t<T>;
+            ifc_field result{ name, static_cast<uint32_t>(offset), sizeof(Element), static_cast<uint16_t>(std::max<size_t>(std::extent_v<T>, 1)), IFC_FIELD_UNSIGNED, 0, IFC_TEXT_NONE };
+            if constexpr (requires { Element::SortCount; })
+            {
+                result.kind = IFC_FIELD_REFERENCE;
+                result.sort_bits = static_cast<uint8_t>(std::countr_zero(Element::SortCount));
+                if constexpr (std::is_same_v<Element, NameIndex>)
+                    result.text = IFC_TEXT_NAME;
+            }
+            else if constexpr (std::is_same_v<Element, Operator>)
+            {
+                // The sort in the low 4 bits, like a reference.
+                result.kind = IFC_FIELD_REFERENCE;
+                result.sort_bits = 4;
+            }
+            else if constexpr (std::is_enum_v<Element>)
+            {
+                result.kind = std::is_signed_v<std::underlying_type_t<Element>> ? IFC_FIELD_SIGNED : IFC_FIELD_UNSIGNED;
+                if constexpr (std::is_same_v<Element, TextOffset>)
+                    result.text = IFC_TEXT_OFFSET;
+            }
+            else
+            {
+                static_assert(std::is_integral_v<Element>, "members of other structs are listed by their own members");
+                result.kind = std::is_signed_v<Element> ? IFC_FIELD_SIGNED : IFC_FIELD_UNSIGNED;
+            }
+            return result;
+        }
+
+        // Bit-fields have no offset of their own, the word holding them is described instead.
+        template<typename Record>
+        constexpr ifc_field bitfield_word(const char* name, size_t offset)
+        {
+            return { name, static_cast<uint32_t>(offset), sizeof(uint32_t), 1, IFC_FIELD_UNSIGNED, 0, IFC_TEXT_NONE };
+        }
+
+        // Word::index is a plain Index, what it addresses depends on the sort of the word.
+        constexpr ifc_field word_index(ifc_field index)
+        {
+            index.text = IFC_TEXT_WORD;
+            return index;
+        }
+
+// Records with members in a base struct (e.g. expressions) are not standard-layout, but laid out as the
+// members in order all the same, which the IFC format relies on anyway.
+#if defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+#define IFC_FIELD(Record, member) field<decltype(std::declval<Record&>().member)>(#member, offsetof(Record, member))
+#define IFC_WORD_INDEX(Record, member) word_index(IFC_FIELD(Record, member))
+
+        constexpr ifc_field AttrBasicFields[] = {
+            IFC_FIELD(AttrBasic, word.locus.line), IFC_FIELD(AttrBasic, word.locus.column), IFC_WORD_INDEX(AttrBasic, word.index),
+            IFC_FIELD(AttrBasic, word.value), IFC_FIELD(AttrBasic, word.sort), IFC_FIELD(AttrBasic, word.padding),
+        };
+        constexpr ifc_field AttrScopedFields[] = {
+            IFC_FIELD(AttrScoped, scope.locus.line), IFC_FIELD(AttrScoped, scope.locus.column),
+            IFC_WORD_INDEX(AttrScoped, scope.index), IFC_FIELD(AttrScoped, scope.value), IFC_FIELD(AttrScoped, scope.sort),
+            IFC_FIELD(AttrScoped, scope.padding), IFC_FIELD(AttrScoped, member.locus.line),
+            IFC_FIELD(AttrScoped, member.locus.column), IFC_WORD_INDEX(AttrScoped, member.index), IFC_FIELD(AttrScoped, member.value),
+            IFC_FIELD(AttrScoped, member.sort), IFC_FIELD(AttrScoped, member.padding),
+        };
+        constexpr ifc_field AttrLabeledFields[] = {
+            IFC_FIELD(AttrLabeled, label.locus.line), IFC_FIELD(AttrLabeled, label.locus.column),
+            IFC_WORD_INDEX(AttrLabeled, label.index), IFC_FIELD(AttrLabeled, label.value), IFC_FIELD(AttrLabeled, label.sort),
+            IFC_FIELD(AttrLabeled, label.padding), IFC_FIELD(AttrLabeled, attribute),
+        };
+        constexpr ifc_field AttrCalledFields[] = {
+            IFC_FIELD(AttrCalled, function), IFC_FIELD(AttrCalled, arguments),
+        };
+        constexpr ifc_field AttrExpandedFields[] = {
+            IFC_FIELD(AttrExpanded, operand),
+        };
+        constexpr ifc_field AttrFactoredFields[] = {
+            IFC_FIELD(AttrFactored, factor.locus.line), IFC_FIELD(AttrFactored, factor.locus.column),
+            IFC_WORD_INDEX(AttrFactored, factor.index), IFC_FIELD(AttrFactored, factor.value), IFC_FIELD(AttrFactored, factor.sort),
+            IFC_FIELD(AttrFactored, factor.padding), IFC_FIELD(AttrFactored, terms),
+        };
+        constexpr ifc_field AttrElaboratedFields[] = {
+            IFC_FIELD(AttrElaborated, expression),
+        };
+        constexpr ifc_field AttrTupleFields[] = {
+            IFC_FIELD(AttrTuple, start), IFC_FIELD(AttrTuple, cardinality),
+        };
+        constexpr ifc_field ChartUnilevelFields[] = {
+            IFC_FIELD(ChartUnilevel, start), IFC_FIELD(ChartUnilevel, cardinality), IFC_FIELD(ChartUnilevel, constraint),
+        };
+        constexpr ifc_field ChartMultilevelFields[] = {
+            IFC_FIELD(ChartMultilevel, start), IFC_FIELD(ChartMultilevel, cardinality),
+        };
+        constexpr ifc_field DeclarationFields[] = {
+            IFC_FIELD(Declaration, index),
+        };
+        constexpr ifc_field UsingDeclarationFields[] = {
+            IFC_FIELD(UsingDeclaration, name), IFC_FIELD(UsingDeclaration, locus.line), IFC_FIELD(UsingDeclaration, locus.column),
+            IFC_FIELD(UsingDeclaration, home_scope), IFC_FIELD(UsingDeclaration, resolution), IFC_FIELD(UsingDeclaration, parent),
+            IFC_FIELD(UsingDeclaration, name2), IFC_FIELD(UsingDeclaration, specifiers), IFC_FIELD(UsingDeclaration, access),
+            IFC_FIELD(UsingDeclaration, hidden),
+        };
+        constexpr ifc_field TemplateDeclarationFields[] = {
+            IFC_FIELD(TemplateDeclaration, name), IFC_FIELD(TemplateDeclaration, locus.line),
+            IFC_FIELD(TemplateDeclaration, locus.column), IFC_FIELD(TemplateDeclaration, home_scope),
+            IFC_FIELD(TemplateDeclaration, chart), IFC_FIELD(TemplateDeclaration, entity.decl),
+            IFC_FIELD(TemplateDeclaration, entity.head), IFC_FIELD(TemplateDeclaration, entity.body),
+            IFC_FIELD(TemplateDeclaration, entity.attributes), IFC_FIELD(TemplateDeclaration, type),
+            IFC_FIELD(TemplateDeclaration, specifiers), IFC_FIELD(TemplateDeclaration, access),
+            IFC_FIELD(TemplateDeclaration, properties),
+        };
+        constexpr ifc_field SpecializationFormFields[] = {
+            IFC_FIELD(SpecializationForm, primary), IFC_FIELD(SpecializationForm, arguments),
+        };
+        constexpr ifc_field PartialSpecializationFields[] = {
+            IFC_FIELD(PartialSpecialization, name), IFC_FIELD(PartialSpecialization, locus.line),
+            IFC_FIELD(PartialSpecialization, locus.column), IFC_FIELD(PartialSpecialization, home_scope),
+            IFC_FIELD(PartialSpecialization, chart), IFC_FIELD(PartialSpecialization, entity.decl),
+            IFC_FIELD(PartialSpecialization, entity.head), IFC_FIELD(PartialSpecialization, entity.body),
+            IFC_FIELD(PartialSpecialization, entity.attributes), IFC_FIELD(PartialSpecialization, form),
+            IFC_FIELD(PartialSpecialization, specifiers), IFC_FIELD(PartialSpecialization, access),
+            IFC_FIELD(PartialSpecialization, properties),
+        };
+        constexpr ifc_field SpecializationFields[] = {
+            IFC_FIELD(Specialization, form), IFC_FIELD(Specialization, decl), IFC_FIELD(Specialization, sort),
+        };
+        constexpr ifc_field EnumerationFields[] = {
+            IFC_FIELD(Enumeration, name), IFC_FIELD(Enumeration, locus.line), IFC_FIELD(Enumeration, locus.column),
+            IFC_FIELD(Enumeration, type), IFC_FIELD(Enumeration, base), IFC_FIELD(Enumeration, initializer.start),
+            IFC_FIELD(Enumeration, initializer.cardinality), IFC_FIELD(Enumeration, home_scope),
+            IFC_FIELD(Enumeration, alignment), IFC_FIELD(Enumeration, specifiers), IFC_FIELD(Enumeration, access),
+            IFC_FIELD(Enumeration, properties),
+        };
+        constexpr ifc_field EnumeratorFields[] = {
+            IFC_FIELD(Enumerator, name), IFC_FIELD(Enumerator, locus.line), IFC_FIELD(Enumerator, locus.column),
+            IFC_FIELD(Enumerator, type), IFC_FIELD(Enumerator, initializer), IFC_FIELD(Enumerator, specifier),
+            IFC_FIELD(Enumerator, access),
+        };
+        constexpr ifc_field AliasDeclarationFields[] = {
+            IFC_FIELD(AliasDeclaration, name), IFC_FIELD(AliasDeclaration, locus.line), IFC_FIELD(AliasDeclaration, locus.column),
+            IFC_FIELD(AliasDeclaration, type), IFC_FIELD(AliasDeclaration, home_scope), IFC_FIELD(AliasDeclaration, aliasee),
+            IFC_FIELD(AliasDeclaration, specifiers), IFC_FIELD(AliasDeclaration, access),
+        };
+        constexpr ifc_field ScopeDeclarationFields[] = {
+            IFC_FIELD(ScopeDeclaration, name), IFC_FIELD(ScopeDeclaration, locus.line), IFC_FIELD(ScopeDeclaration, locus.column),
+            IFC_FIELD(ScopeDeclaration, type), IFC_FIELD(ScopeDeclaration, base), IFC_FIELD(ScopeDeclaration, initializer),
+            IFC_FIELD(ScopeDeclaration, home_scope), IFC_FIELD(ScopeDeclaration, alignment),
+            IFC_FIELD(ScopeDeclaration, pack_size), IFC_FIELD(ScopeDeclaration, specifiers), IFC_FIELD(ScopeDeclaration, traits),
+            IFC_FIELD(ScopeDeclaration, access), IFC_FIELD(ScopeDeclaration, properties),
+        };
+        constexpr ifc_field FunctionDeclarationFields[] = {
+            IFC_FIELD(FunctionDeclaration, name), IFC_FIELD(FunctionDeclaration, locus.line),
+            IFC_FIELD(FunctionDeclaration, locus.column), IFC_FIELD(FunctionDeclaration, type),
+            IFC_FIELD(FunctionDeclaration, home_scope), IFC_FIELD(FunctionDeclaration, chart),
+            IFC_FIELD(FunctionDeclaration, traits), IFC_FIELD(FunctionDeclaration, specifiers),
+            IFC_FIELD(FunctionDeclaration, access), IFC_FIELD(FunctionDeclaration, properties),
+        };
+        constexpr ifc_field MethodDeclarationFields[] = {
+            IFC_FIELD(MethodDeclaration, name), IFC_FIELD(MethodDeclaration, locus.line),
+            IFC_FIELD(MethodDeclaration, locus.column), IFC_FIELD(MethodDeclaration, type),
+            IFC_FIELD(MethodDeclaration, home_scope), IFC_FIELD(MethodDeclaration, chart), IFC_FIELD(MethodDeclaration, traits),
+            IFC_FIELD(MethodDeclaration, specifiers), IFC_FIELD(MethodDeclaration, access),
+            IFC_FIELD(MethodDeclaration, properties),
+        };
+        constexpr ifc_field ConstructorFields[] = {
+            IFC_FIELD(Constructor, name), IFC_FIELD(Constructor, locus.line), IFC_FIELD(Constructor, locus.column),
+            IFC_FIELD(Constructor, type), IFC_FIELD(Constructor, home_scope), IFC_FIELD(Constructor, chart),
+            IFC_FIELD(Constructor, traits), IFC_FIELD(Constructor, specifiers), IFC_FIELD(Constructor, access),
+            IFC_FIELD(Constructor, properties),
+        };
+        constexpr ifc_field DestructorFields[] = {
+            IFC_FIELD(Destructor, name), IFC_FIELD(Destructor, locus.line), IFC_FIELD(Destructor, locus.column),
+            IFC_FIELD(Destructor, home_scope), IFC_FIELD(Destructor, eh_spec.words), IFC_FIELD(Destructor, eh_spec.sort),
+            IFC_FIELD(Destructor, traits), IFC_FIELD(Destructor, specifiers), IFC_FIELD(Destructor, access),
+            IFC_FIELD(Destructor, convention), IFC_FIELD(Destructor, properties),
+        };
+        constexpr ifc_field VariableDeclarationFields[] = {
+            IFC_FIELD(VariableDeclaration, name), IFC_FIELD(VariableDeclaration, locus.line),
+            IFC_FIELD(VariableDeclaration, locus.column), IFC_FIELD(VariableDeclaration, type),
+            IFC_FIELD(VariableDeclaration, home_scope), IFC_FIELD(VariableDeclaration, initializer),
+            IFC_FIELD(VariableDeclaration, alignment), IFC_FIELD(VariableDeclaration, traits),
+            IFC_FIELD(VariableDeclaration, specifiers), IFC_FIELD(VariableDeclaration, access),
+            IFC_FIELD(VariableDeclaration, properties),
+        };
+        constexpr ifc_field FieldDeclarationFields[] = {
+            IFC_FIELD(FieldDeclaration, name), IFC_FIELD(FieldDeclaration, locus.line), IFC_FIELD(FieldDeclaration, locus.column),
+            IFC_FIELD(FieldDeclaration, type), IFC_FIELD(FieldDeclaration, home_scope), IFC_FIELD(FieldDeclaration, initializer),
+            IFC_FIELD(FieldDeclaration, alignment), IFC_FIELD(FieldDeclaration, traits), IFC_FIELD(FieldDeclaration, specifiers),
+            IFC_FIELD(FieldDeclaration, access), IFC_FIELD(FieldDeclaration, properties),
+        };
+        constexpr ifc_field BitfieldDeclarationFields[] = {
+            IFC_FIELD(BitfieldDeclaration, name), IFC_FIELD(BitfieldDeclaration, locus.line),
+            IFC_FIELD(BitfieldDeclaration, locus.column), IFC_FIELD(BitfieldDeclaration, type),
+            IFC_FIELD(BitfieldDeclaration, home_scope), IFC_FIELD(BitfieldDeclaration, width),
+            IFC_FIELD(BitfieldDeclaration, initializer), IFC_FIELD(BitfieldDeclaration, traits),
+            IFC_FIELD(BitfieldDeclaration, specifiers), IFC_FIELD(BitfieldDeclaration, access),
+            IFC_FIELD(BitfieldDeclaration, properties),
+        };
+        constexpr ifc_field ParameterDeclarationFields[] = {
+            IFC_FIELD(ParameterDeclaration, name), IFC_FIELD(ParameterDeclaration, locus.line),
+            IFC_FIELD(ParameterDeclaration, locus.column), IFC_FIELD(ParameterDeclaration, type),
+            IFC_FIELD(ParameterDeclaration, constraint), IFC_FIELD(ParameterDeclaration, initializer),
+            IFC_FIELD(ParameterDeclaration, level), IFC_FIELD(ParameterDeclaration, position),
+            IFC_FIELD(ParameterDeclaration, sort), IFC_FIELD(ParameterDeclaration, properties),
+        };
+        constexpr ifc_field FriendDeclarationFields[] = {
+            IFC_FIELD(FriendDeclaration, entity),
+        };
+        constexpr ifc_field ConceptFields[] = {
+            IFC_FIELD(Concept, name), IFC_FIELD(Concept, locus.line), IFC_FIELD(Concept, locus.column),
+            IFC_FIELD(Concept, home_scope), IFC_FIELD(Concept, type), IFC_FIELD(Concept, chart), IFC_FIELD(Concept, constraint),
+            IFC_FIELD(Concept, specifiers), IFC_FIELD(Concept, access), IFC_FIELD(Concept, head), IFC_FIELD(Concept, body),
+        };
+        constexpr ifc_field IntrinsicDeclarationFields[] = {
+            IFC_FIELD(IntrinsicDeclaration, name), IFC_FIELD(IntrinsicDeclaration, locus.line),
+            IFC_FIELD(IntrinsicDeclaration, locus.column), IFC_FIELD(IntrinsicDeclaration, type),
+            IFC_FIELD(IntrinsicDeclaration, home_scope), IFC_FIELD(IntrinsicDeclaration, specifiers),
+            IFC_FIELD(IntrinsicDeclaration, access),
+        };
+        constexpr ifc_field DeclReferenceFields[] = {
+            IFC_FIELD(DeclReference, unit.owner), IFC_FIELD(DeclReference, unit.partition), IFC_FIELD(DeclReference, local_index),
+        };
+        constexpr ifc_field LiteralExpressionFields[] = {
+            IFC_FIELD(LiteralExpression, source.line), IFC_FIELD(LiteralExpression, source.column),
+            IFC_FIELD(LiteralExpression, type), IFC_FIELD(LiteralExpression, value),
+        };
+        constexpr ifc_field NamedDeclFields[] = {
+            IFC_FIELD(NamedDecl, source.line), IFC_FIELD(NamedDecl, source.column), IFC_FIELD(NamedDecl, type),
+            IFC_FIELD(NamedDecl, resolution),
+        };
+        constexpr ifc_field UnqualifiedIdFields[] = {
+            IFC_FIELD(UnqualifiedId, source.line), IFC_FIELD(UnqualifiedId, source.column), IFC_FIELD(UnqualifiedId, type),
+            IFC_FIELD(UnqualifiedId, name), IFC_FIELD(UnqualifiedId, resolution), IFC_FIELD(UnqualifiedId, template_keyword.line),
+            IFC_FIELD(UnqualifiedId, template_keyword.column),
+        };
+        constexpr ifc_field TemplateIdFields[] = {
+            IFC_FIELD(TemplateId, source.line), IFC_FIELD(TemplateId, source.column), IFC_FIELD(TemplateId, type),
+            IFC_FIELD(TemplateId, primary), IFC_FIELD(TemplateId, arguments),
+        };
+        constexpr ifc_field TemplateReferenceFields[] = {
+            IFC_FIELD(TemplateReference, source.line), IFC_FIELD(TemplateReference, source.column),
+            IFC_FIELD(TemplateReference, type), IFC_FIELD(TemplateReference, member), IFC_FIELD(TemplateReference, member_name),
+            IFC_FIELD(TemplateReference, scope), IFC_FIELD(TemplateReference, arguments),
+        };
+        constexpr ifc_field TupleExpressionFields[] = {
+            IFC_FIELD(TupleExpression, source.line), IFC_FIELD(TupleExpression, source.column), IFC_FIELD(TupleExpression, type),
+            IFC_FIELD(TupleExpression, seq.start), IFC_FIELD(TupleExpression, seq.cardinality),
+        };
+        constexpr ifc_field ExpressionListExpressionFields[] = {
+            IFC_FIELD(ExpressionListExpression, left.line), IFC_FIELD(ExpressionListExpression, left.column),
+            IFC_FIELD(ExpressionListExpression, right.line), IFC_FIELD(ExpressionListExpression, right.column),
+            IFC_FIELD(ExpressionListExpression, contents), IFC_FIELD(ExpressionListExpression, delimiter),
+        };
+        constexpr ifc_field TypeExpressionFields[] = {
+            IFC_FIELD(TypeExpression, source.line), IFC_FIELD(TypeExpression, source.column), IFC_FIELD(TypeExpression, type),
+            IFC_FIELD(TypeExpression, denotation),
+        };
+        constexpr ifc_field PackedTemplateArgumentsFields[] = {
+            IFC_FIELD(PackedTemplateArguments, source.line), IFC_FIELD(PackedTemplateArguments, source.column),
+            IFC_FIELD(PackedTemplateArguments, type), IFC_FIELD(PackedTemplateArguments, arguments),
+        };
+        constexpr ifc_field MonadExpressionFields[] = {
+            IFC_FIELD(MonadExpression, source.line), IFC_FIELD(MonadExpression, source.column), IFC_FIELD(MonadExpression, type),
+            IFC_FIELD(MonadExpression, impl), IFC_FIELD(MonadExpression, argument), IFC_FIELD(MonadExpression, op),
+        };
+        constexpr ifc_field DyadExpressionFields[] = {
+            IFC_FIELD(DyadExpression, source.line), IFC_FIELD(DyadExpression, source.column), IFC_FIELD(DyadExpression, type),
+            IFC_FIELD(DyadExpression, impl), IFC_FIELD(DyadExpression, arguments), IFC_FIELD(DyadExpression, op),
+        };
+        constexpr ifc_field StringExpressionFields[] = {
+            IFC_FIELD(StringExpression, source.line), IFC_FIELD(StringExpression, source.column),
+            IFC_FIELD(StringExpression, type), IFC_FIELD(StringExpression, string_index),
+        };
+        constexpr ifc_field CallExpressionFields[] = {
+            IFC_FIELD(CallExpression, source.line), IFC_FIELD(CallExpression, source.column), IFC_FIELD(CallExpression, type),
+            IFC_FIELD(CallExpression, operation), IFC_FIELD(CallExpression, arguments),
+        };
+        constexpr ifc_field SizeofExpressionFields[] = {
+            IFC_FIELD(SizeofExpression, source.line), IFC_FIELD(SizeofExpression, source.column),
+            IFC_FIELD(SizeofExpression, type), IFC_FIELD(SizeofExpression, operand),
+        };
+        constexpr ifc_field AlignofExpressionFields[] = {
+            IFC_FIELD(AlignofExpression, source.line), IFC_FIELD(AlignofExpression, source.column),
+            IFC_FIELD(AlignofExpression, type), IFC_FIELD(AlignofExpression, operand),
+        };
+        constexpr ifc_field RequiresExpressionFields[] = {
+            IFC_FIELD(RequiresExpression, source.line), IFC_FIELD(RequiresExpression, source.column),
+            IFC_FIELD(RequiresExpression, type), IFC_FIELD(RequiresExpression, parameters), IFC_FIELD(RequiresExpression, body),
+        };
+        constexpr ifc_field QualifiedNameExpressionFields[] = {
+            IFC_FIELD(QualifiedNameExpression, source.line), IFC_FIELD(QualifiedNameExpression, source.column),
+            IFC_FIELD(QualifiedNameExpression, type), IFC_FIELD(QualifiedNameExpression, elements),
+            IFC_FIELD(QualifiedNameExpression, template_keyword.line),
+            IFC_FIELD(QualifiedNameExpression, template_keyword.column),
+        };
+        constexpr ifc_field PathExpressionFields[] = {
+            IFC_FIELD(PathExpression, source.line), IFC_FIELD(PathExpression, source.column), IFC_FIELD(PathExpression, type),
+            IFC_FIELD(PathExpression, scope), IFC_FIELD(PathExpression, member),
+        };
+        constexpr ifc_field ReadExpressionFields[] = {
+            IFC_FIELD(ReadExpression, source.line), IFC_FIELD(ReadExpression, source.column), IFC_FIELD(ReadExpression, type),
+            IFC_FIELD(ReadExpression, address), IFC_FIELD(ReadExpression, sort),
+        };
+        constexpr ifc_field SyntaxTreeExpressionFields[] = {
+            IFC_FIELD(SyntaxTreeExpression, syntax),
+        };
+        constexpr ifc_field ProductValueTypeExpressionFields[] = {
+            IFC_FIELD(ProductValueTypeExpression, source.line), IFC_FIELD(ProductValueTypeExpression, source.column),
+            IFC_FIELD(ProductValueTypeExpression, type), IFC_FIELD(ProductValueTypeExpression, structure),
+            IFC_FIELD(ProductValueTypeExpression, members), IFC_FIELD(ProductValueTypeExpression, base_subobjects),
+        };
+        constexpr ifc_field SubobjectValueExpressionFields[] = {
+            IFC_FIELD(SubobjectValueExpression, value),
+        };
+        constexpr ifc_field StringLiteralFields[] = {
+            IFC_FIELD(StringLiteral, start), IFC_FIELD(StringLiteral, length), IFC_FIELD(StringLiteral, suffix),
+        };
+        constexpr ifc_field IntegerLiteralFields[] = {
+            IFC_FIELD(IntegerLiteral, value),
+        };
+        constexpr ifc_field ObjectLikeMacroFields[] = {
+            IFC_FIELD(ObjectLikeMacro, locus.line), IFC_FIELD(ObjectLikeMacro, locus.column), IFC_FIELD(ObjectLikeMacro, name),
+            IFC_FIELD(ObjectLikeMacro, body),
+        };
+        constexpr ifc_field FunctionLikeMacroFields[] = {
+            IFC_FIELD(FunctionLikeMacro, locus.line), IFC_FIELD(FunctionLikeMacro, locus.column),
+            IFC_FIELD(FunctionLikeMacro, name), IFC_FIELD(FunctionLikeMacro, parameters), IFC_FIELD(FunctionLikeMacro, body),
+            // `arity` in the low 31 bits, `variadic` in the top one.
+            bitfield_word<FunctionLikeMacro>("arity", offsetof(FunctionLikeMacro, body) + sizeof(FormIndex)),
+        };
+        constexpr ifc_field IdentifierFormFields[] = {
+            IFC_FIELD(IdentifierForm, locus.line), IFC_FIELD(IdentifierForm, locus.column), IFC_FIELD(IdentifierForm, spelling),
+        };
+        constexpr ifc_field NumberFormFields[] = {
+            IFC_FIELD(NumberForm, locus.line), IFC_FIELD(NumberForm, locus.column), IFC_FIELD(NumberForm, spelling),
+        };
+        constexpr ifc_field CharacterFormFields[] = {
+            IFC_FIELD(CharacterForm, locus.line), IFC_FIELD(CharacterForm, locus.column), IFC_FIELD(CharacterForm, spelling),
+        };
+        constexpr ifc_field StringFormFields[] = {
+            IFC_FIELD(StringForm, locus.line), IFC_FIELD(StringForm, locus.column), IFC_FIELD(StringForm, spelling),
+        };
+        constexpr ifc_field OperatorFormFields[] = {
+            IFC_FIELD(OperatorForm, locus.line), IFC_FIELD(OperatorForm, locus.column), IFC_FIELD(OperatorForm, spelling),
+            IFC_FIELD(OperatorForm, value),
+        };
+        constexpr ifc_field KeywordFormFields[] = {
+            IFC_FIELD(KeywordForm, locus.line), IFC_FIELD(KeywordForm, locus.column), IFC_FIELD(KeywordForm, spelling),
+        };
+        constexpr ifc_field WhitespaceFormFields[] = {
+            IFC_FIELD(WhitespaceForm, locus.line), IFC_FIELD(WhitespaceForm, locus.column),
+        };
+        constexpr ifc_field ParameterFormFields[] = {
+            IFC_FIELD(ParameterForm, locus.line), IFC_FIELD(ParameterForm, locus.column), IFC_FIELD(ParameterForm, spelling),
+        };
+        constexpr ifc_field StringizeFormFields[] = {
+            IFC_FIELD(StringizeForm, locus.line), IFC_FIELD(StringizeForm, locus.column), IFC_FIELD(StringizeForm, operand),
+        };
+        constexpr ifc_field CatenateFormFields[] = {
+            IFC_FIELD(CatenateForm, locus.line), IFC_FIELD(CatenateForm, locus.column), IFC_FIELD(CatenateForm, first),
+            IFC_FIELD(CatenateForm, second),
+        };
+        constexpr ifc_field PragmaFormFields[] = {
+            IFC_FIELD(PragmaForm, locus.line), IFC_FIELD(PragmaForm, locus.column), IFC_FIELD(PragmaForm, operand),
+        };
+        constexpr ifc_field HeaderFormFields[] = {
+            IFC_FIELD(HeaderForm, locus.line), IFC_FIELD(HeaderForm, locus.column), IFC_FIELD(HeaderForm, spelling),
+        };
+        constexpr ifc_field ParenthesizedFormFields[] = {
+            IFC_FIELD(ParenthesizedForm, locus.line), IFC_FIELD(ParenthesizedForm, locus.column),
+            IFC_FIELD(ParenthesizedForm, operand),
+        };
+        constexpr ifc_field TupleFormFields[] = {
+            IFC_FIELD(TupleForm, start), IFC_FIELD(TupleForm, cardinality),
+        };
+        constexpr ifc_field JunkFormFields[] = {
+            IFC_FIELD(JunkForm, locus.line), IFC_FIELD(JunkForm, locus.column), IFC_FIELD(JunkForm, spelling),
+        };
+        constexpr ifc_field OperatorFunctionNameFields[] = {
+            IFC_FIELD(OperatorFunctionName, encoded), IFC_FIELD(OperatorFunctionName, operator_),
+        };
+        constexpr ifc_field ConversionFunctionNameFields[] = {
+            IFC_FIELD(ConversionFunctionName, target), IFC_FIELD(ConversionFunctionName, encoded),
+        };
+        constexpr ifc_field LiteralNameFields[] = {
+            IFC_FIELD(LiteralName, encoded),
+        };
+        constexpr ifc_field TemplateNameFields[] = {
+            IFC_FIELD(TemplateName, name),
+        };
+        constexpr ifc_field SpecializationNameFields[] = {
+            IFC_FIELD(SpecializationName, primary), IFC_FIELD(SpecializationName, arguments),
+        };
+        constexpr ifc_field SourceFileNameFields[] = {
+            IFC_FIELD(SourceFileName, path), IFC_FIELD(SourceFileName, guard),
+        };
+        constexpr ifc_field DeductionGuideNameFields[] = {
+            IFC_FIELD(DeductionGuideName, primary_template),
+        };
+        constexpr ifc_field FileAndLineFields[] = {
+            IFC_FIELD(FileAndLine, file), IFC_FIELD(FileAndLine, line),
+        };
+        constexpr ifc_field SimpleTypeSpecifierFields[] = {
+            IFC_FIELD(SimpleTypeSpecifier, type), IFC_FIELD(SimpleTypeSpecifier, expr),
+            IFC_FIELD(SimpleTypeSpecifier, locus.line), IFC_FIELD(SimpleTypeSpecifier, locus.column),
+        };
+        constexpr ifc_field DecltypeSpecifierFields[] = {
+            IFC_FIELD(DecltypeSpecifier, argument), IFC_FIELD(DecltypeSpecifier, decltype_keyword.line),
+            IFC_FIELD(DecltypeSpecifier, decltype_keyword.column), IFC_FIELD(DecltypeSpecifier, left_paren.line),
+            IFC_FIELD(DecltypeSpecifier, left_paren.column), IFC_FIELD(DecltypeSpecifier, right_paren.line),
+            IFC_FIELD(DecltypeSpecifier, right_paren.column),
+        };
+        constexpr ifc_field TypeSpecifierSeqFields[] = {
+            IFC_FIELD(TypeSpecifierSeq, typename_), IFC_FIELD(TypeSpecifierSeq, type), IFC_FIELD(TypeSpecifierSeq, source.line),
+            IFC_FIELD(TypeSpecifierSeq, source.column), IFC_FIELD(TypeSpecifierSeq, qualifiers),
+            IFC_FIELD(TypeSpecifierSeq, unshashed),
+        };
+        constexpr ifc_field DeclSpecifierSeqFields[] = {
+            IFC_FIELD(DeclSpecifierSeq, type), IFC_FIELD(DeclSpecifierSeq, typename_), IFC_FIELD(DeclSpecifierSeq, source.line),
+            IFC_FIELD(DeclSpecifierSeq, source.column), IFC_FIELD(DeclSpecifierSeq, storage_class),
+            IFC_FIELD(DeclSpecifierSeq, declspec), IFC_FIELD(DeclSpecifierSeq, explicit_),
+            IFC_FIELD(DeclSpecifierSeq, qualifiers),
+        };
+        constexpr ifc_field TypeIdSyntaxFields[] = {
+            IFC_FIELD(TypeIdSyntax, type_specifier), IFC_FIELD(TypeIdSyntax, abstract_declarator),
+            IFC_FIELD(TypeIdSyntax, locus.line), IFC_FIELD(TypeIdSyntax, locus.column),
+        };
+        constexpr ifc_field DeclaratorSyntaxFields[] = {
+            IFC_FIELD(DeclaratorSyntax, pointer), IFC_FIELD(DeclaratorSyntax, parenthesized),
+            IFC_FIELD(DeclaratorSyntax, array_or_function), IFC_FIELD(DeclaratorSyntax, trailing_target),
+            IFC_FIELD(DeclaratorSyntax, virtual_specifiers), IFC_FIELD(DeclaratorSyntax, name),
+            IFC_FIELD(DeclaratorSyntax, ellipsis.line), IFC_FIELD(DeclaratorSyntax, ellipsis.column),
+            IFC_FIELD(DeclaratorSyntax, locus.line), IFC_FIELD(DeclaratorSyntax, locus.column),
+            IFC_FIELD(DeclaratorSyntax, qualifiers), IFC_FIELD(DeclaratorSyntax, convention),
+            IFC_FIELD(DeclaratorSyntax, callable),
+        };
+        constexpr ifc_field PointerDeclaratorSyntaxFields[] = {
+            IFC_FIELD(PointerDeclaratorSyntax, whole), IFC_FIELD(PointerDeclaratorSyntax, next),
+            IFC_FIELD(PointerDeclaratorSyntax, locus.line), IFC_FIELD(PointerDeclaratorSyntax, locus.column),
+            IFC_FIELD(PointerDeclaratorSyntax, sort), IFC_FIELD(PointerDeclaratorSyntax, qualifiers),
+            IFC_FIELD(PointerDeclaratorSyntax, convention), IFC_FIELD(PointerDeclaratorSyntax, callable),
+        };
+        constexpr ifc_field FunctionDeclaratorSyntaxFields[] = {
+            IFC_FIELD(FunctionDeclaratorSyntax, parameters), IFC_FIELD(FunctionDeclaratorSyntax, eh_spec),
+            IFC_FIELD(FunctionDeclaratorSyntax, left_paren.line), IFC_FIELD(FunctionDeclaratorSyntax, left_paren.column),
+            IFC_FIELD(FunctionDeclaratorSyntax, right_paren.line), IFC_FIELD(FunctionDeclaratorSyntax, right_paren.column),
+            IFC_FIELD(FunctionDeclaratorSyntax, ellipsis.line), IFC_FIELD(FunctionDeclaratorSyntax, ellipsis.column),
+            IFC_FIELD(FunctionDeclaratorSyntax, ref.line), IFC_FIELD(FunctionDeclaratorSyntax, ref.column),
+            IFC_FIELD(FunctionDeclaratorSyntax, traits),
+        };
+        constexpr ifc_field ParameterDeclaratorSyntaxFields[] = {
+            IFC_FIELD(ParameterDeclaratorSyntax, decl_specifiers), IFC_FIELD(ParameterDeclaratorSyntax, declarator),
+            IFC_FIELD(ParameterDeclaratorSyntax, default_), IFC_FIELD(ParameterDeclaratorSyntax, location.line),
+            IFC_FIELD(ParameterDeclaratorSyntax, location.column), IFC_FIELD(ParameterDeclaratorSyntax, sort),
+        };
+        constexpr ifc_field ExpressionSyntaxFields[] = {
+            IFC_FIELD(ExpressionSyntax, expression),
+        };
+        constexpr ifc_field RequiresClauseSyntaxFields[] = {
+            IFC_FIELD(RequiresClauseSyntax, condition), IFC_FIELD(RequiresClauseSyntax, location.line),
+            IFC_FIELD(RequiresClauseSyntax, location.column),
+        };
+        constexpr ifc_field SimpleRequirementSyntaxFields[] = {
+            IFC_FIELD(SimpleRequirementSyntax, condition), IFC_FIELD(SimpleRequirementSyntax, location.line),
+            IFC_FIELD(SimpleRequirementSyntax, location.column),
+        };
+        constexpr ifc_field TypeRequirementSyntaxFields[] = {
+            IFC_FIELD(TypeRequirementSyntax, type), IFC_FIELD(TypeRequirementSyntax, location.line),
+            IFC_FIELD(TypeRequirementSyntax, location.column),
+        };
+        constexpr ifc_field CompoundRequirementSyntaxFields[] = {
+            IFC_FIELD(CompoundRequirementSyntax, condition), IFC_FIELD(CompoundRequirementSyntax, constraint),
+            IFC_FIELD(CompoundRequirementSyntax, location.line), IFC_FIELD(CompoundRequirementSyntax, location.column),
+            IFC_FIELD(CompoundRequirementSyntax, right_curly.line), IFC_FIELD(CompoundRequirementSyntax, right_curly.column),
+            IFC_FIELD(CompoundRequirementSyntax, noexcept_.line), IFC_FIELD(CompoundRequirementSyntax, noexcept_.column),
+        };
+        constexpr ifc_field NestedRequirementSyntaxFields[] = {
+            IFC_FIELD(NestedRequirementSyntax, condition), IFC_FIELD(NestedRequirementSyntax, location.line),
+            IFC_FIELD(NestedRequirementSyntax, location.column),
+        };
+        constexpr ifc_field RequirementBodySyntaxFields[] = {
+            IFC_FIELD(RequirementBodySyntax, requirements), IFC_FIELD(RequirementBodySyntax, location.line),
+            IFC_FIELD(RequirementBodySyntax, location.column), IFC_FIELD(RequirementBodySyntax, right_curly.line),
+            IFC_FIELD(RequirementBodySyntax, right_curly.column),
+        };
+        constexpr ifc_field TypeTemplateArgumentSyntaxFields[] = {
+            IFC_FIELD(TypeTemplateArgumentSyntax, argument), IFC_FIELD(TypeTemplateArgumentSyntax, expander.line),
+            IFC_FIELD(TypeTemplateArgumentSyntax, expander.column), IFC_FIELD(TypeTemplateArgumentSyntax, comma.line),
+            IFC_FIELD(TypeTemplateArgumentSyntax, comma.column),
+        };
+        constexpr ifc_field TemplateArgumentListSyntaxFields[] = {
+            IFC_FIELD(TemplateArgumentListSyntax, arguments), IFC_FIELD(TemplateArgumentListSyntax, lt.line),
+            IFC_FIELD(TemplateArgumentListSyntax, lt.column), IFC_FIELD(TemplateArgumentListSyntax, gt.line),
+            IFC_FIELD(TemplateArgumentListSyntax, gt.column),
+        };
+        constexpr ifc_field TemplateIdSyntaxFields[] = {
+            IFC_FIELD(TemplateIdSyntax, name), IFC_FIELD(TemplateIdSyntax, symbol), IFC_FIELD(TemplateIdSyntax, arguments),
+            IFC_FIELD(TemplateIdSyntax, locus.line), IFC_FIELD(TemplateIdSyntax, locus.column),
+            IFC_FIELD(TemplateIdSyntax, template_.line), IFC_FIELD(TemplateIdSyntax, template_.column),
+        };
+        constexpr ifc_field TypeTraitIntrinsicSyntaxFields[] = {
+            IFC_FIELD(TypeTraitIntrinsicSyntax, arguments), IFC_FIELD(TypeTraitIntrinsicSyntax, location.line),
+            IFC_FIELD(TypeTraitIntrinsicSyntax, location.column), IFC_FIELD(TypeTraitIntrinsicSyntax, intrinsic),
+        };
+        constexpr ifc_field TupleSyntaxFields[] = {
+            IFC_FIELD(TupleSyntax, seq.start), IFC_FIELD(TupleSyntax, seq.cardinality),
+        };
+        constexpr ifc_field FundamentalTypeFields[] = {
+            IFC_FIELD(FundamentalType, basis), IFC_FIELD(FundamentalType, precision), IFC_FIELD(FundamentalType, sign),
+            IFC_FIELD(FundamentalType, _padding_),
+        };
+        constexpr ifc_field DesignatedTypeFields[] = {
+            IFC_FIELD(DesignatedType, decl),
+        };
+        constexpr ifc_field SyntacticTypeFields[] = {
+            IFC_FIELD(SyntacticType, expr),
+        };
+        constexpr ifc_field ExpansionTypeFields[] = {
+            IFC_FIELD(ExpansionType, pack), IFC_FIELD(ExpansionType, mode),
+        };
+        constexpr ifc_field PointerTypeFields[] = {
+            IFC_FIELD(PointerType, pointee),
+        };
+        constexpr ifc_field FunctionTypeFields[] = {
+            IFC_FIELD(FunctionType, target), IFC_FIELD(FunctionType, source), IFC_FIELD(FunctionType, eh_spec.words),
+            IFC_FIELD(FunctionType, eh_spec.sort), IFC_FIELD(FunctionType, convention), IFC_FIELD(FunctionType, traits),
+        };
+        constexpr ifc_field MethodTypeFields[] = {
+            IFC_FIELD(MethodType, target), IFC_FIELD(MethodType, source), IFC_FIELD(MethodType, scope),
+            IFC_FIELD(MethodType, eh_spec.words), IFC_FIELD(MethodType, eh_spec.sort), IFC_FIELD(MethodType, convention),
+            IFC_FIELD(MethodType, traits),
+        };
+        constexpr ifc_field TorTypeFields[] = {
+            IFC_FIELD(TorType, source), IFC_FIELD(TorType, eh_spec.words), IFC_FIELD(TorType, eh_spec.sort),
+            IFC_FIELD(TorType, convention),
+        };
+        constexpr ifc_field BaseTypeFields[] = {
+            IFC_FIELD(BaseType, type), IFC_FIELD(BaseType, access), IFC_FIELD(BaseType, specifiers),
+        };
+        constexpr ifc_field TupleTypeFields[] = {
+            IFC_FIELD(TupleType, seq.start), IFC_FIELD(TupleType, seq.cardinality),
+        };
+        constexpr ifc_field LvalueReferenceFields[] = {
+            IFC_FIELD(LvalueReference, referee),
+        };
+        constexpr ifc_field RvalueReferenceFields[] = {
+            IFC_FIELD(RvalueReference, referee),
+        };
+        constexpr ifc_field ArrayTypeFields[] = {
+            IFC_FIELD(ArrayType, element), IFC_FIELD(ArrayType, extent),
+        };
+        constexpr ifc_field QualifiedTypeFields[] = {
+            IFC_FIELD(QualifiedType, unqualified), IFC_FIELD(QualifiedType, qualifiers),
+        };
+        constexpr ifc_field ForallTypeFields[] = {
+            IFC_FIELD(ForallType, chart), IFC_FIELD(ForallType, subject),
+        };
+        constexpr ifc_field SyntaxTypeFields[] = {
+            IFC_FIELD(SyntaxType, syntax),
+        };
+        constexpr ifc_field PlaceholderTypeFields[] = {
+            IFC_FIELD(PlaceholderType, constraint), IFC_FIELD(PlaceholderType, basis), IFC_FIELD(PlaceholderType, elaboration),
+        };
+        constexpr ifc_field TypenameTypeFields[] = {
+            IFC_FIELD(TypenameType, path),
+        };
+        constexpr ifc_field DecltypeTypeFields[] = {
+            IFC_FIELD(DecltypeType, argument),
+        };
+        constexpr ifc_field SentenceFields[] = {
+            IFC_FIELD(Sentence, start), IFC_FIELD(Sentence, cardinality), IFC_FIELD(Sentence, locus.line),
+            IFC_FIELD(Sentence, locus.column),
+        };
+        constexpr ifc_field WordFields[] = {
+            IFC_FIELD(Word, locus.line), IFC_FIELD(Word, locus.column), IFC_WORD_INDEX(Word, index), IFC_FIELD(Word, value),
+            IFC_FIELD(Word, sort), IFC_FIELD(Word, padding),
+        };
+
+        using AttributeTrait = AssociatedTrait<AttrIndex>;
+        using DeprecationTrait = AssociatedTrait<TextOffset>;
+        using FriendshipTrait = AssociatedTrait<Sequence>;
+        using InitializerLocusTrait = AssociatedTrait<SourceLocation>;
+
+        // Of ".msvc.trait.suppressed-warnings", which the ifc headers have no struct for: as MSVC writes it.
+        struct SuppressedWarning
+        {
+            SourceLocation start;
+            SourceLocation end;
+            uint32_t warning;
+        };
+        static_assert(sizeof(SuppressedWarning) == 20);
+
+        constexpr ifc_field AttributeTraitFields[] = {
+            IFC_FIELD(AttributeTrait, decl), IFC_FIELD(AttributeTrait, trait),
+        };
+        constexpr ifc_field DeprecationTraitFields[] = {
+            IFC_FIELD(DeprecationTrait, decl), IFC_FIELD(DeprecationTrait, trait),
+        };
+        constexpr ifc_field FriendshipTraitFields[] = {
+            IFC_FIELD(FriendshipTrait, decl), IFC_FIELD(FriendshipTrait, trait.start), IFC_FIELD(FriendshipTrait, trait.cardinality),
+        };
+        constexpr ifc_field InitializerLocusTraitFields[] = {
+            IFC_FIELD(InitializerLocusTrait, decl), IFC_FIELD(InitializerLocusTrait, trait.line),
+            IFC_FIELD(InitializerLocusTrait, trait.column),
+        };
+        constexpr ifc_field SuppressedWarningFields[] = {
+            IFC_FIELD(SuppressedWarning, start.line), IFC_FIELD(SuppressedWarning, start.column),
+            IFC_FIELD(SuppressedWarning, end.line), IFC_FIELD(SuppressedWarning, end.column), IFC_FIELD(SuppressedWarning, warning),
+        };
+        constexpr ifc_field ModuleReferenceFields[] = {
+            IFC_FIELD(ModuleReference, owner), IFC_FIELD(ModuleReference, partition),
+        };
+        constexpr ifc_field SequenceFields[] = {
+            IFC_FIELD(Sequence, start), IFC_FIELD(Sequence, cardinality),
+        };
+
+        // Heaps are arrays of references, the command line one of text offsets.
+        template<typename Reference>
+        constexpr ifc_field HeapFields[] = { field<Reference>("value", 0) };
+
+#undef IFC_WORD_INDEX
+#undef IFC_FIELD
+
+        struct RecordLayout
+        {
+            std::string_view partition;
+            std::span<ifc_field const> fields;
+            size_t size;
+        };
+
+        template<typename Record>
+        constexpr RecordLayout layout(std::span<ifc_field const> fields)
+        {
+            return { Record::PartitionName, fields, sizeof(Record) };
+        }
+
+        constexpr auto sorted_by_name(auto layouts)
+        {
+            std::ranges::sort(layouts, {}, &RecordLayout::partition);
+            return layouts;
+        }
+
+        constexpr auto RECORD_LAYOUTS = sorted_by_name(std::to_array<RecordLayout>({
+            layout<AttrBasic>(AttrBasicFields),
+            layout<AttrScoped>(AttrScopedFields),
+            layout<AttrLabeled>(AttrLabeledFields),
+            layout<AttrCalled>(AttrCalledFields),
+            layout<AttrExpanded>(AttrExpandedFields),
+            layout<AttrFactored>(AttrFactoredFields),
+            layout<AttrElaborated>(AttrElaboratedFields),
+            layout<AttrTuple>(AttrTupleFields),
+            layout<ChartUnilevel>(ChartUnilevelFields),
+            layout<ChartMultilevel>(ChartMultilevelFields),
+            layout<Declaration>(DeclarationFields),
+            layout<UsingDeclaration>(UsingDeclarationFields),
+            layout<TemplateDeclaration>(TemplateDeclarationFields),
+            layout<SpecializationForm>(SpecializationFormFields),
+            layout<PartialSpecialization>(PartialSpecializationFields),
+            layout<Specialization>(SpecializationFields),
+            layout<Enumeration>(EnumerationFields),
+            layout<Enumerator>(EnumeratorFields),
+            layout<AliasDeclaration>(AliasDeclarationFields),
+            layout<ScopeDeclaration>(ScopeDeclarationFields),
+            layout<FunctionDeclaration>(FunctionDeclarationFields),
+            layout<MethodDeclaration>(MethodDeclarationFields),
+            layout<Constructor>(ConstructorFields),
+            layout<Destructor>(DestructorFields),
+            layout<VariableDeclaration>(VariableDeclarationFields),
+            layout<FieldDeclaration>(FieldDeclarationFields),
+            layout<BitfieldDeclaration>(BitfieldDeclarationFields),
+            layout<ParameterDeclaration>(ParameterDeclarationFields),
+            layout<FriendDeclaration>(FriendDeclarationFields),
+            layout<Concept>(ConceptFields),
+            layout<IntrinsicDeclaration>(IntrinsicDeclarationFields),
+            layout<DeclReference>(DeclReferenceFields),
+            layout<LiteralExpression>(LiteralExpressionFields),
+            layout<NamedDecl>(NamedDeclFields),
+            layout<UnqualifiedId>(UnqualifiedIdFields),
+            layout<TemplateId>(TemplateIdFields),
+            layout<TemplateReference>(TemplateReferenceFields),
+            layout<TupleExpression>(TupleExpressionFields),
+            layout<ExpressionListExpression>(ExpressionListExpressionFields),
+            layout<TypeExpression>(TypeExpressionFields),
+            layout<PackedTemplateArguments>(PackedTemplateArgumentsFields),
+            layout<MonadExpression>(MonadExpressionFields),
+            layout<DyadExpression>(DyadExpressionFields),
+            layout<StringExpression>(StringExpressionFields),
+            layout<CallExpression>(CallExpressionFields),
+            layout<SizeofExpression>(SizeofExpressionFields),
+            layout<AlignofExpression>(AlignofExpressionFields),
+            layout<RequiresExpression>(RequiresExpressionFields),
+            layout<QualifiedNameExpression>(QualifiedNameExpressionFields),
+            layout<PathExpression>(PathExpressionFields),
+            layout<ReadExpression>(ReadExpressionFields),
+            layout<SyntaxTreeExpression>(SyntaxTreeExpressionFields),
+            layout<ProductValueTypeExpression>(ProductValueTypeExpressionFields),
+            layout<SubobjectValueExpression>(SubobjectValueExpressionFields),
+            layout<StringLiteral>(StringLiteralFields),
+            layout<IntegerLiteral>(IntegerLiteralFields),
+            layout<ObjectLikeMacro>(ObjectLikeMacroFields),
+            layout<FunctionLikeMacro>(FunctionLikeMacroFields),
+            layout<IdentifierForm>(IdentifierFormFields),
+            layout<NumberForm>(NumberFormFields),
+            layout<CharacterForm>(CharacterFormFields),
+            layout<StringForm>(StringFormFields),
+            layout<OperatorForm>(OperatorFormFields),
+            layout<KeywordForm>(KeywordFormFields),
+            layout<WhitespaceForm>(WhitespaceFormFields),
+            layout<ParameterForm>(ParameterFormFields),
+            layout<StringizeForm>(StringizeFormFields),
+            layout<CatenateForm>(CatenateFormFields),
+            layout<PragmaForm>(PragmaFormFields),
+            layout<HeaderForm>(HeaderFormFields),
+            layout<ParenthesizedForm>(ParenthesizedFormFields),
+            layout<TupleForm>(TupleFormFields),
+            layout<JunkForm>(JunkFormFields),
+            layout<OperatorFunctionName>(OperatorFunctionNameFields),
+            layout<ConversionFunctionName>(ConversionFunctionNameFields),
+            layout<LiteralName>(LiteralNameFields),
+            layout<TemplateName>(TemplateNameFields),
+            layout<SpecializationName>(SpecializationNameFields),
+            layout<SourceFileName>(SourceFileNameFields),
+            layout<DeductionGuideName>(DeductionGuideNameFields),
+            layout<FileAndLine>(FileAndLineFields),
+            layout<SimpleTypeSpecifier>(SimpleTypeSpecifierFields),
+            layout<DecltypeSpecifier>(DecltypeSpecifierFields),
+            layout<TypeSpecifierSeq>(TypeSpecifierSeqFields),
+            layout<DeclSpecifierSeq>(DeclSpecifierSeqFields),
+            layout<TypeIdSyntax>(TypeIdSyntaxFields),
+            layout<DeclaratorSyntax>(DeclaratorSyntaxFields),
+            layout<PointerDeclaratorSyntax>(PointerDeclaratorSyntaxFields),
+            layout<FunctionDeclaratorSyntax>(FunctionDeclaratorSyntaxFields),
+            layout<ParameterDeclaratorSyntax>(ParameterDeclaratorSyntaxFields),
+            layout<ExpressionSyntax>(ExpressionSyntaxFields),
+            layout<RequiresClauseSyntax>(RequiresClauseSyntaxFields),
+            layout<SimpleRequirementSyntax>(SimpleRequirementSyntaxFields),
+            layout<TypeRequirementSyntax>(TypeRequirementSyntaxFields),
+            layout<CompoundRequirementSyntax>(CompoundRequirementSyntaxFields),
+            layout<NestedRequirementSyntax>(NestedRequirementSyntaxFields),
+            layout<RequirementBodySyntax>(RequirementBodySyntaxFields),
+            layout<TypeTemplateArgumentSyntax>(TypeTemplateArgumentSyntaxFields),
+            layout<TemplateArgumentListSyntax>(TemplateArgumentListSyntaxFields),
+            layout<TemplateIdSyntax>(TemplateIdSyntaxFields),
+            layout<TypeTraitIntrinsicSyntax>(TypeTraitIntrinsicSyntaxFields),
+            layout<TupleSyntax>(TupleSyntaxFields),
+            layout<FundamentalType>(FundamentalTypeFields),
+            layout<DesignatedType>(DesignatedTypeFields),
+            layout<SyntacticType>(SyntacticTypeFields),
+            layout<ExpansionType>(ExpansionTypeFields),
+            layout<PointerType>(PointerTypeFields),
+            layout<FunctionType>(FunctionTypeFields),
+            layout<MethodType>(MethodTypeFields),
+            layout<TorType>(TorTypeFields),
+            layout<BaseType>(BaseTypeFields),
+            layout<TupleType>(TupleTypeFields),
+            layout<LvalueReference>(LvalueReferenceFields),
+            layout<RvalueReference>(RvalueReferenceFields),
+            layout<ArrayType>(ArrayTypeFields),
+            layout<QualifiedType>(QualifiedTypeFields),
+            layout<ForallType>(ForallTypeFields),
+            layout<SyntaxType>(SyntaxTypeFields),
+            layout<PlaceholderType>(PlaceholderTypeFields),
+            layout<TypenameType>(TypenameTypeFields),
+            layout<DecltypeType>(DecltypeTypeFields),
+            layout<Sentence>(SentenceFields),
+            layout<Word>(WordFields),
+            { "heap.type",              HeapFields<TypeIndex>,   sizeof(TypeIndex) },
+            { "heap.expr",              HeapFields<ExprIndex>,   sizeof(ExprIndex) },
+            { "heap.attr",              HeapFields<AttrIndex>,   sizeof(AttrIndex) },
+            { "heap.syn",               HeapFields<SyntaxIndex>, sizeof(SyntaxIndex) },
+            { "heap.chart",             HeapFields<ChartIndex>,  sizeof(ChartIndex) },
+            { "heap.form",              HeapFields<FormIndex>,   sizeof(FormIndex) },
+            { "module.imported",        ModuleReferenceFields,   sizeof(ModuleReference) },
+            { "module.exported",        ModuleReferenceFields,   sizeof(ModuleReference) },
+            { "scope.desc",             SequenceFields,          sizeof(Sequence) },
+            { "trait.attribute",        AttributeTraitFields,    sizeof(AttributeTrait) },
+            { ".msvc.trait.decl-attrs", AttributeTraitFields,    sizeof(AttributeTrait) },
+            { "trait.deprecated",       DeprecationTraitFields,  sizeof(DeprecationTrait) },
+            { "trait.friend",           FriendshipTraitFields,   sizeof(FriendshipTrait) },
+            { "command_line",           HeapFields<TextOffset>,  sizeof(TextOffset) },
+            { ".msvc.trait.entity-initializer-locus", InitializerLocusTraitFields, sizeof(InitializerLocusTrait) },
+            { ".msvc.trait.suppressed-warnings",      SuppressedWarningFields,     sizeof(SuppressedWarning) },
+        }));
+
+        static_assert(std::ranges::adjacent_find(RECORD_LAYOUTS, {}, &RecordLayout::partition) == RECORD_LAYOUTS.end(),
+            "every partition must have one layout");
+    }
+}
+
+extern "C"
+{
+    const ifc_field* ifc_partition_fields(const char* partition_name, uint32_t* count, uint32_t* record_size)
+    {
+        const auto layouts = std::ranges::equal_range(ifc::RECORD_LAYOUTS, std::string_view(partition_name), {}, &ifc::RecordLayout::partition);
+        if (layouts.empty())
+            return nullptr;
+        *count = static_cast<uint32_t>(layouts.front().fields.size());
+        *record_size = static_cast<uint32_t>(layouts.front().size);
+        return layouts.front().fields.data();
+    }
+}
@@ -0,0 +1,31 @@
+#include "ifc/Cancellation.h"
+
+namespace ifc
+{
+    namespace
+    {
+        thread_local CancellationToken const* current_token = nullptr;
+    }
+
+    CancellationToken const* current_cancellation()
+    {
+        return current_token;
+    }
+
+    CancellationScope::CancellationScope(CancellationToken const* token)
+        : outer_(current_token)
+    {
+        current_token = token;
+    }
+
+    CancellationScope::~CancellationScope()
+    {
+        current_token = outer_;
+    }
+
+    void check_cancellation()
+    {
+        if (current_token != nullptr)
+            current_token->throw_if_cancelled();
+    }
+}
@@ -1,5 +1,17 @@
 #include "ifc/Environment.h"
 #include "ifc/Module.h"
+#include "ifc/Declaration.h"
+#include "ifc/MemoryUsage.h"
+#include "ifc/Trace.h"
+
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <utility>
 
 namespace ifc
 {
@@ -19,27 +31,1083 @@ namespace ifc
         }
     }
 
+    std::filesystem::path const* Environment::find_bmi_path(ModuleMap const& modules, ModuleReference module, File const& file)
+    {
+        if (is_null(module.owner))
+            return modules.find(ModuleMap::NameParts{ {}, file.get_string_view(module.partition) });
+
+        std::string_view partition;
+        if (!is_null(module.partition))
+            partition = file.get_string_view(module.partition);
+        return modules.find(ModuleMap::NameParts{ file.get_string_view(module.owner), partition });
+    }
+
+    std::filesystem::path const* Environment::find_bmi_path(ModuleReference module, File const& file) const
+    {
+        return find_bmi_path(*modules_, module, file);
+    }
+
     File const& Environment::get_referenced_module(ModuleReference module, File const& file)
     {
-        return get_module_by_bmi_path(module_name_to_bmi_path_[module_name(module, file)]);
+        auto bmi = find_bmi_path(module, file);
+        if (bmi == nullptr)
+            throw std::out_of_range("module '" + module_name(module, file) + "' is not in the environment");
+        return get_module_by_bmi_path(*bmi);
     }
 
-    File const& Environment::get_module_by_bmi_path(std::filesystem::path const & key)
+    void Environment::resolve_all(File const& file, std::span<ModuleReference const> modules, std::span<File const*> out, Executor& executor)
     {
-        auto cached = cached_bmis_.find(key);
-        if (cached == cached_bmis_.end())
+        if (out.size() != modules.size())
+            throw std::invalid_argument("resolve_all: output size differs from the number of modules");
+
+        // Equal names are equal string offsets within one file, and distinct names may map to the same BMI.
+        const auto name_key = [](ModuleReference module) {
+            return std::pair(static_cast<uint32_t>(module.owner), static_cast<uint32_t>(module.partition));
+        };
+        std::vector<uint32_t> order(modules.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(order, {}, [&](uint32_t i) { return name_key(modules[i]); });
+
+        std::vector<std::filesystem::path const*> bmis;
+        std::vector<uint32_t> bmi_of(modules.size());
+        std::unordered_map<std::filesystem::path const*, uint32_t> distinct;
+        for (size_t i = 0; i != order.size(); ++i)
         {
-            cached = cached_bmis_.emplace_hint(cached, key, file_reader_(key));
+            const auto module = modules[order[i]];
+            if (i != 0 && name_key(module) == name_key(modules[order[i - 1]]))
+            {
+                bmi_of[order[i]] = bmi_of[order[i - 1]];
+                continue;
+            }
+            auto bmi = find_bmi_path(module, file);
+            if (bmi == nullptr)
+                throw std::out_of_range("module '" + module_name(module, file) + "' is not in the environment");
+            const auto [found, added] = distinct.try_emplace(bmi, static_cast<uint32_t>(bmis.size()));
+            if (added)
+                bmis.push_back(bmi);
+            bmi_of[order[i]] = found->second;
         }
-        return cached->second.ifc;
+
+        // Starting every load first lets an AsyncFileReader read all the BMIs at once.
+        std::vector<CacheEntryPtr> entries;
+        entries.reserve(bmis.size());
+        for (auto bmi : bmis)
+            entries.push_back(start_loading(*bmi, true));
+
+        std::vector<File const*> files(bmis.size());
+        std::vector<size_t> pending;
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            if (entries[i]->ready.load(std::memory_order_acquire))
+                files[i] = entries[i]->bmi.get();
+            else
+                pending.push_back(i);
+        }
+        if (!pending.empty())
+        {
+            executor.run(pending.size(), [&](size_t i) {
+                const auto bmi = pending[i];
+                files[bmi] = &finish_loading(*entries[bmi], *bmis[bmi]);
+            });
+        }
+
+        for (size_t i = 0; i != modules.size(); ++i)
+            out[i] = files[bmi_of[i]];
     }
 
-    Environment::Environment(Config config, std::function<BlobHolderPtr(std::filesystem::path const &)> file_reader)
-        : file_reader_(std::move(file_reader))
+    Environment::ModuleHandle Environment::acquire_referenced_module(ModuleReference module, File const& file)
+    {
+        auto bmi = find_bmi_path(module, file);
+        if (bmi == nullptr)
+            throw std::out_of_range("module '" + module_name(module, file) + "' is not in the environment");
+        return acquire_module_by_bmi_path(*bmi);
+    }
+
+    std::span<File const* const> Environment::imported_files(File const& file)
+    {
+        return resolve_references(file).imported;
+    }
+
+    std::span<File const* const> Environment::exported_files(File const& file)
+    {
+        return resolve_references(file).exported;
+    }
+
+    Environment::ResolvedReferences& Environment::references_of(File const& file)
+    {
+        std::scoped_lock lock(resolved_references_mutex_);
+        auto & found = resolved_references_[&file];
+        if (!found)
+            found = std::make_unique<ResolvedReferences>();
+        return *found;
+    }
+
+    Environment::ResolvedReferences const& Environment::resolve_references(File const& file)
+    {
+        auto* references = &references_of(file);
+
+        // Referenced modules are pinned, so the pointers stay valid.
+        std::call_once(references->resolved, [&] {
+            auto resolve = [&](Partition<ModuleReference, Index> modules, std::vector<File const*> & files) {
+                const std::vector<ModuleReference> references(modules.begin(), modules.end());
+                files.assign(references.size(), nullptr);
+                resolve_all(file, references, files);
+            };
+            resolve(file.imported_modules(), references->imported);
+            resolve(file.exported_modules(), references->exported);
+        });
+        return *references;
+    }
+
+    FileIdSet const& Environment::transitive_exports(File const& file)
+    {
+        auto & references = references_of(file);
+        if (references.exports_closed.load(std::memory_order_acquire))
+            return references.transitive_exports;
+
+        // Modules without a closure yet, each after the ones it re-exports. Resolving (and loading) them
+        // happens here, without the lock.
+        std::unordered_set<File const*> visited{ &file };
+        std::vector<File const*> order;
+        std::vector<std::pair<File const*, size_t>> stack{ { &file, 0 } }; // Module and its next re-export to visit
+        while (!stack.empty())
+        {
+            auto & [module, next] = stack.back();
+            const auto exported = exported_files(*module);
+            if (next != exported.size())
+            {
+                const auto dependency = exported[next++];
+                if (!references_of(*dependency).exports_closed.load(std::memory_order_acquire) && visited.insert(dependency).second)
+                    stack.emplace_back(dependency, 0);
+                continue;
+            }
+            order.push_back(module);
+            stack.pop_back();
+        }
+
+        std::scoped_lock lock(transitive_exports_mutex_);
+        for (auto module : order)
+        {
+            auto & closure = references_of(*module);
+            // Closed meanwhile by another thread.
+            if (closure.exports_closed.load(std::memory_order_relaxed))
+                continue;
+            closure.transitive_exports.insert(file_id(*module));
+            for (auto exported : exported_files(*module))
+            {
+                if (auto const & dependency = references_of(*exported); dependency.exports_closed.load(std::memory_order_relaxed))
+                    closure.transitive_exports.merge(dependency.transitive_exports);
+                else
+                    closure.transitive_exports.insert(file_id(*exported));
+            }
+            closure.exports_closed.store(true, std::memory_order_release);
+        }
+        return references.transitive_exports;
+    }
+
+    Environment::ResolvedDeclaration Environment::resolve_reference(File const& file, DeclIndex reference)
+    {
+        const DeclarationKey key{ &file, reference };
+        {
+            std::scoped_lock lock(resolved_declarations_mutex_);
+            if (auto found = resolved_declarations_.find(key); found != resolved_declarations_.end())
+                return found->second;
+        }
+
+        // Referenced modules are pinned, so the resolved file stays valid.
+        ResolvedDeclaration resolved{ &file, reference };
+        constexpr int MaxReferenceChain = 256;
+        for (int i = 0; resolved.decl.sort() == DeclSort::Reference; ++i)
+        {
+            if (i == MaxReferenceChain)
+                throw std::runtime_error("cyclic declaration references");
+
+            auto const& decl_reference = resolved.file->decl_references()[resolved.decl];
+            resolved = { &get_referenced_module(decl_reference.unit, *resolved.file), decl_reference.local_index };
+        }
+
+        std::scoped_lock lock(resolved_declarations_mutex_);
+        resolved_declarations_.emplace(key, resolved);
+        return resolved;
+    }
+
+    std::span<Environment::ResolvedDeclaration const> Environment::resolve_all_references(File const& file)
+    {
+        auto & references = references_of(file);
+        std::call_once(references.declarations_resolved, [&] {
+            if (!file.has_partition(DeclReference::PartitionName))
+                return;
+            const auto decl_references = file.decl_references();
+
+            // By module, as the string offsets of its name, which the references of one file share.
+            std::vector<uint32_t> order(decl_references.size());
+            std::iota(order.begin(), order.end(), 0);
+            const auto module_key = [&](uint32_t i) {
+                auto const & unit = decl_references.begin()[i].unit;
+                return std::pair(static_cast<uint32_t>(unit.owner), static_cast<uint32_t>(unit.partition));
+            };
+            std::ranges::sort(order, {}, module_key);
+
+            auto & declarations = references.declarations;
+            declarations.resize(decl_references.size());
+            File const* module = nullptr;
+            for (size_t i = 0; i != order.size(); ++i)
+            {
+                auto const & reference = decl_references.begin()[order[i]];
+                if (i == 0 || module_key(order[i]) != module_key(order[i - 1]))
+                {
+                    auto bmi = find_bmi_path(reference.unit, file);
+                    module = bmi ? &get_module_by_bmi_path(*bmi) : nullptr;
+                }
+
+                ResolvedDeclaration resolved{ module, reference.local_index };
+                // References to references are rare, they are followed one at a time.
+                if (module && resolved.decl.sort() == DeclSort::Reference)
+                {
+                    try
+                    {
+                        resolved = resolve_reference(*module, resolved.decl);
+                    }
+                    catch (std::out_of_range const&)
+                    {
+                        resolved.file = nullptr;
+                    }
+                }
+                declarations[order[i]] = resolved;
+            }
+        });
+        return references.declarations;
+    }
+
+    void Environment::prefetch_transitive(File const& file, Executor& executor, CancellationToken const* cancellation)
+    {
+        if (cancellation == nullptr)
+            cancellation = current_cancellation();
+
+        std::unordered_set<std::filesystem::path const*> visited;
+        std::vector<std::filesystem::path const*> level;
+        std::vector<File const*> level_files;
+
+        auto add_references = [&](File const& referencing_file) {
+            for (auto modules : { referencing_file.imported_modules(), referencing_file.exported_modules() })
+            {
+                for (auto module : modules)
+                {
+                    if (auto bmi = find_bmi_path(module, referencing_file); bmi && visited.insert(bmi).second)
+                        level.push_back(bmi);
+                }
+            }
+        };
+
+        add_references(file);
+        while (!level.empty())
+        {
+            level_files.assign(level.size(), nullptr);
+            executor.run(level.size(), [&](size_t i) {
+                const CancellationScope scope(cancellation);
+                check_cancellation();
+                level_files[i] = &get_module_by_bmi_path(*level[i], LoadPriority::Speculative);
+            });
+
+            level.clear();
+            for (auto loaded : level_files)
+                add_references(*loaded);
+        }
+    }
+
+    Environment::GlobalIndexStats Environment::build_global_indexes(GlobalIndexOptions const& options)
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto started = Clock::now();
+        const size_t count = options.bmis.size();
+        const size_t capacity = std::max<size_t>(options.queue_capacity, 1);
+        const unsigned workers = options.workers != 0 ? options.workers : std::max(1u, std::thread::hardware_concurrency());
+        auto & executor = options.executor != nullptr ? *options.executor : default_executor();
+
+        GlobalIndexStats result;
+        result.files.assign(count, nullptr);
+
+        enum Stage : size_t { Load, Validate, Index, Merge, StageCount };
+        struct StageState
+        {
+            GlobalIndexStats::Stage* stats;
+            std::deque<size_t> queue{}; // Files waiting for the stage
+            size_t in_progress = 0;
+            Clock::time_point first_start = Clock::time_point::max();
+            Clock::time_point last_end = Clock::time_point::min();
+        };
+
+        std::array<StageState, StageCount> stages{ { { &result.load }, { &result.validate }, { &result.index }, { &result.merge } } };
+        for (size_t i = 0; i != count; ++i)
+            stages[Load].queue.push_back(i);
+        const auto next_stage = [&options](size_t stage) { return stage == Load && !options.validate ? Index : stage + 1; };
+
+        // Guarded by the mutex.
+        std::mutex mutex;
+        std::condition_variable changed;
+        size_t merged = 0;
+        bool failed = false;
+
+        // Latest stage first, so that files leave the pipeline before new ones enter it.
+        auto take = [&]() -> std::optional<std::pair<size_t, size_t>> {
+            for (size_t stage = StageCount; stage-- != 0;)
+            {
+                auto & state = stages[stage];
+                if (state.queue.empty())
+                    continue;
+                if (stage != Merge && stages[next_stage(stage)].queue.size() + state.in_progress >= capacity)
+                    continue;
+                const auto file = state.queue.front();
+                state.queue.pop_front();
+                ++state.in_progress;
+                return std::pair{ stage, file };
+            }
+            return std::nullopt;
+        };
+
+        std::mutex merge_mutex;
+        auto run = [&](size_t stage, size_t i) {
+            switch (stage)
+            {
+            case Load:
+                result.files[i] = &get_module_by_bmi_path(options.bmis[i]);
+                break;
+            case Validate:
+                result.files[i]->validate();
+                break;
+            case Index:
+                (void)result.files[i]->text_symbol_count();
+                if (options.build_file_indexes)
+                    options.build_file_indexes(*result.files[i]);
+                break;
+            default:
+            {
+                symbols_.symbols(*result.files[i]);
+                const auto id = file_id(*result.files[i]);
+                if (options.merge)
+                {
+                    std::scoped_lock lock(merge_mutex);
+                    options.merge(*result.files[i], id);
+                }
+                break;
+            }
+            }
+        };
+
+        const auto cancellation = current_cancellation();
+        executor.run(workers, [&](size_t) {
+            const CancellationScope scope(cancellation);
+            std::unique_lock lock(mutex);
+            while (true)
+            {
+                std::optional<std::pair<size_t, size_t>> work;
+                changed.wait(lock, [&] { return failed || merged == count || (work = take()).has_value(); });
+                if (!work)
+                    return;
+
+                const auto [stage, i] = *work;
+                const auto start = Clock::now();
+                lock.unlock();
+                try
+                {
+                    check_cancellation();
+                    run(stage, i);
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    failed = true;
+                    changed.notify_all();
+                    throw;
+                }
+                const auto end = Clock::now();
+                lock.lock();
+
+                auto & state = stages[stage];
+                --state.in_progress;
+                state.first_start = std::min(state.first_start, start);
+                state.last_end = std::max(state.last_end, end);
+                ++state.stats->files;
+                state.stats->bytes += result.files[i]->blob().size();
+                state.stats->busy += end - start;
+                if (stage == Merge)
+                    ++merged;
+                else
+                    stages[next_stage(stage)].queue.push_back(i);
+                changed.notify_all();
+            }
+        });
+
+        for (auto const & state : stages)
+        {
+            if (state.stats->files != 0)
+                state.stats->elapsed = state.last_end - state.first_start;
+        }
+        result.elapsed = Clock::now() - started;
+        return result;
+    }
+
+    File const& Environment::get_module_by_bmi_path(std::filesystem::path const & key, LoadPriority priority)
+    {
+        TraceScope trace("get_module_by_bmi_path", "environment", key);
+        return finish_loading(*start_loading(key, true, priority), key, priority);
+    }
+
+    std::future<File const&> Environment::load_module_by_bmi_path(std::filesystem::path const & key, LoadPriority priority)
+    {
+        return std::async(std::launch::deferred, [this, entry = start_loading(key, true, priority), key, priority]() -> File const& {
+            return finish_loading(*entry, key, priority);
+        });
+    }
+
+    Environment::ModuleHandle Environment::acquire_module_by_bmi_path(std::filesystem::path const & key)
+    {
+        auto entry = start_loading(key, false);
+        auto const& file = finish_loading(*entry, key);
+        evict_over_budget();
+        return { std::move(entry), &file };
+    }
+
+    void Environment::set_file_options(FileOptions options)
+    {
+        file_options_ = options;
+    }
+
+    void Environment::set_memory_budget(size_t bytes)
+    {
+        memory_budget_ = bytes;
+        evict_over_budget();
+    }
+
+    size_t Environment::loaded_bytes() const
+    {
+        return loaded_bytes_;
+    }
+
+    Environment::MemoryUsage Environment::memory_usage() const
+    {
+        MemoryUsage result;
+        result.resident_bytes = 0;
+
+        std::vector<std::shared_ptr<File const>> loaded;
+        for (auto const & shard : cached_bmis_)
+        {
+            std::scoped_lock lock(shard.mutex);
+            result.environment_heap_bytes += heap_bytes(shard.entries) + shard.entries.size() * sizeof(CacheEntry);
+            for (auto const & [key, entry] : shard.entries)
+            {
+                if (entry->ready.load(std::memory_order_acquire))
+                    loaded.push_back(entry->bmi);
+            }
+        }
+
+        // Outside of the shard locks, File::memory_usage may walk many indexes.
+        for (auto const & file : loaded)
+        {
+            const auto usage = file->memory_usage();
+            ++result.modules;
+            result.mapped_bytes += usage.mapped_bytes;
+            result.file_heap_bytes += usage.heap_bytes();
+            if (result.resident_bytes && usage.resident_bytes)
+                *result.resident_bytes += *usage.resident_bytes;
+            else
+                result.resident_bytes.reset();
+        }
+
+        {
+            // The import lists themselves are left out, they may be in the middle of being resolved.
+            std::scoped_lock lock(transitive_exports_mutex_, resolved_references_mutex_);
+            result.environment_heap_bytes += heap_bytes(resolved_references_) + resolved_references_.size() * sizeof(ResolvedReferences);
+            for (auto const & [file, references] : resolved_references_)
+            {
+                if (references->exports_closed.load(std::memory_order_relaxed))
+                    result.environment_heap_bytes += references->transitive_exports.heap_bytes();
+            }
+        }
+        {
+            std::scoped_lock lock(resolved_declarations_mutex_);
+            result.environment_heap_bytes += heap_bytes(resolved_declarations_);
+        }
+        {
+            std::scoped_lock lock(file_ids_mutex_);
+            result.environment_heap_bytes += heap_bytes(file_ids_);
+            const auto segments = (file_id_count_.load(std::memory_order_relaxed) + (1u << FileIdSegmentBits) - 1) >> FileIdSegmentBits;
+            result.environment_heap_bytes += size_t{ segments } * (sizeof(std::atomic<File const*>) << FileIdSegmentBits);
+        }
+        result.environment_heap_bytes += symbols_.heap_bytes();
+        return result;
+    }
+
+    Environment::CacheEntryPtr Environment::start_loading(std::filesystem::path const & key, bool pin, LoadPriority priority)
+    {
+        if (changes_pending_.load(std::memory_order_acquire))
+            drop_changed_bmis();
+
+        auto & shard = cached_bmis_[PathHasher{}(key) % CacheShards];
+
+        std::scoped_lock lock(shard.mutex);
+        auto & entry = shard.entries[key];
+        if (!entry)
+        {
+            entry = std::make_shared<CacheEntry>();
+            // With a store the file is only read if no other Environment has it loaded,
+            // speculative loads read it once they are let through, see finish_loading.
+            if (!store_ && priority == LoadPriority::Foreground)
+            {
+                TraceScope trace("file_reader", "environment", key);
+                entry->pending_blob = file_reader_(key);
+            }
+        }
+        entry->pinned |= pin;
+        entry->last_use = ++use_clock_;
+        return entry;
+    }
+
+    File const& Environment::finish_loading(CacheEntry& entry, std::filesystem::path const & key, LoadPriority priority)
+    {
+        if (entry.ready.load(std::memory_order_acquire))
+            return *entry.bmi;
+
+        // Counts the foreground load for its duration, including the wait for a load of the BMI in progress.
+        struct ForegroundLoad
+        {
+            Environment* environment;
+
+            ~ForegroundLoad()
+            {
+                if (environment == nullptr)
+                    return;
+                std::scoped_lock lock(environment->foreground_mutex_);
+                if (--environment->foreground_loads_ == 0)
+                    environment->foreground_idle_.notify_all();
+            }
+        } foreground{ nullptr };
+
+        if (priority == LoadPriority::Speculative)
+        {
+            wait_for_foreground_loads();
+        }
+        else
+        {
+            std::scoped_lock lock(foreground_mutex_);
+            ++foreground_loads_;
+            foreground.environment = this;
+        }
+
+        // Happens outside of the shard lock, concurrent requests of the same BMI wait here.
+        // If loading throws, the next request reads the file again.
+        std::call_once(entry.loaded, [&] {
+            auto read = [&] {
+                TraceScope trace("file_reader", "environment", key);
+                if (!entry.pending_blob.valid())
+                    entry.pending_blob = file_reader_(key);
+                // Asynchronous readers finish here.
+                return entry.pending_blob.get();
+            };
+
+            if (store_)
+            {
+                entry.bmi = store_->get(key, read, file_options_);
+            }
+            else
+            {
+                auto bmi = std::make_shared<CachedBMI>(read(), file_options_);
+                entry.bmi = std::shared_ptr<File const>(bmi, &bmi->ifc);
+            }
+            loaded_bytes_ += entry.bmi->blob().size();
+            file_id(*entry.bmi);
+            if (watcher_)
+            {
+                try
+                {
+                    watcher_->watch(key);
+                }
+                catch (std::system_error const&)
+                {
+                    // BMIs of custom readers may not be files on disk, those are just not watched.
+                }
+            }
+            entry.ready.store(true, std::memory_order_release);
+            ++module_set_version_;
+        });
+        return *entry.bmi;
+    }
+
+    void Environment::wait_for_foreground_loads()
+    {
+        std::unique_lock lock(foreground_mutex_);
+        // Cancellation cannot wake the wait, it is polled.
+        while (!foreground_idle_.wait_for(lock, std::chrono::milliseconds(1), [this] { return foreground_loads_ == 0; }))
+            check_cancellation();
+    }
+
+    size_t Environment::trim(TrimLevel level, size_t heap_bytes)
+    {
+        struct Loaded
+        {
+            uint64_t last_use;
+            std::shared_ptr<File const> bmi;
+        };
+        std::vector<Loaded> loaded;
+        for (auto const & shard : cached_bmis_)
+        {
+            std::scoped_lock lock(shard.mutex);
+            for (auto const & [key, entry] : shard.entries)
+            {
+                if (entry->ready.load(std::memory_order_acquire))
+                    loaded.push_back({ entry->last_use, entry->bmi });
+            }
+        }
+        std::ranges::sort(loaded, {}, &Loaded::last_use);
+
+        // Outside of the shard locks, like memory_usage.
+        size_t total = 0;
+        for (auto const & file : loaded)
+            total += file.bmi->memory_usage().heap_bytes();
+
+        size_t released = 0;
+        for (auto const & file : loaded)
+        {
+            if (total - released <= heap_bytes)
+                break;
+            released += file.bmi->trim(level);
+        }
+        return released;
+    }
+
+    void Environment::record_access_profile(AccessProfile& profile) const
+    {
+        std::vector<std::shared_ptr<File const>> loaded;
+        for (auto const & shard : cached_bmis_)
+        {
+            std::scoped_lock lock(shard.mutex);
+            for (auto const & [key, entry] : shard.entries)
+            {
+                if (entry->ready.load(std::memory_order_acquire))
+                    loaded.push_back(entry->bmi);
+            }
+        }
+
+        for (auto const & bmi : loaded)
+            profile.record(*bmi);
+    }
+
+    void Environment::evict_over_budget()
+    {
+        if (loaded_bytes_ <= memory_budget_)
+            return;
+
+        std::scoped_lock eviction_lock(eviction_mutex_);
+
+        struct Candidate
+        {
+            uint64_t last_use;
+            size_t shard;
+            std::filesystem::path key;
+        };
+        std::vector<Candidate> candidates;
+        for (size_t i = 0; i != CacheShards; ++i)
+        {
+            std::scoped_lock lock(cached_bmis_[i].mutex);
+            for (auto & [key, entry] : cached_bmis_[i].entries)
+            {
+                // Nobody else references the entry, so it is not being loaded either.
+                if (entry.use_count() == 1 && !entry->pinned && entry->bmi)
+                    candidates.push_back({ entry->last_use, i, key });
+            }
+        }
+        std::ranges::sort(candidates, {}, &Candidate::last_use);
+
+        for (auto & candidate : candidates)
+        {
+            if (loaded_bytes_ <= memory_budget_)
+                break;
+
+            CacheEntryPtr evicted;
+            {
+                auto & shard = cached_bmis_[candidate.shard];
+                std::scoped_lock lock(shard.mutex);
+                auto it = shard.entries.find(candidate.key);
+                // Acquired or pinned since the candidates were collected.
+                if (it == shard.entries.end() || it->second.use_count() != 1 || it->second->last_use != candidate.last_use)
+                    continue;
+
+                evicted = std::move(it->second);
+                shard.entries.erase(it);
+            }
+
+            // Unmapped outside of the shard lock, unless a snapshot still holds it.
+            loaded_bytes_ -= evicted->bmi->blob().size();
+            forget_resolutions(evicted->bmi.get());
+            ++module_set_version_;
+        }
+    }
+
+    void Environment::forget_resolutions(File const* file)
+    {
+        {
+            std::scoped_lock lock(file_ids_mutex_);
+            if (auto found = file_ids_.find(file); found != file_ids_.end())
+            {
+                const auto id = static_cast<uint32_t>(found->second);
+                files_by_id_[id >> FileIdSegmentBits][id & ((1u << FileIdSegmentBits) - 1)].store(nullptr, std::memory_order_release);
+                file_ids_.erase(found);
+            }
+        }
+        symbols_.forget(*file);
+        {
+            std::scoped_lock lock(transitive_exports_mutex_, resolved_references_mutex_);
+            resolved_references_.erase(file);
+        }
+        {
+            std::scoped_lock lock(resolved_declarations_mutex_);
+            std::erase_if(resolved_declarations_, [file](auto const& resolution) {
+                return resolution.first.file == file;
+            });
+        }
+    }
+
+    void Environment::retire(CacheEntryPtr entry, bool pinned)
+    {
+        ++module_set_version_;
+        if (pinned)
+        {
+            std::scoped_lock lock(replaced_mutex_);
+            replaced_bmis_.push_back(std::move(entry));
+        }
+        else
+        {
+            loaded_bytes_ -= entry->bmi->blob().size();
+            forget_resolutions(entry->bmi.get());
+        }
+    }
+
+    void Environment::watch_for_changes()
+    {
+        watcher_ = std::make_unique<FileWatcher>([this](std::filesystem::path const & path) {
+            std::scoped_lock lock(changed_mutex_);
+            changed_bmis_.push_back(path);
+            changes_pending_.store(true, std::memory_order_release);
+        });
+    }
+
+    uint64_t Environment::generation() const
+    {
+        return generation_;
+    }
+
+    void Environment::drop_changed_bmis()
+    {
+        std::vector<std::filesystem::path> changed;
+        {
+            std::scoped_lock lock(changed_mutex_);
+            changed.swap(changed_bmis_);
+            changes_pending_.store(false, std::memory_order_relaxed);
+        }
+
+        for (auto const & key : changed)
+        {
+            auto & shard = cached_bmis_[PathHasher{}(key) % CacheShards];
+            CacheEntryPtr dropped;
+            bool pinned = false;
+            {
+                std::scoped_lock lock(shard.mutex);
+                auto found = shard.entries.find(key);
+                // Entries still loading may have read the new contents already, they are kept.
+                if (found == shard.entries.end() || !found->second->ready.load(std::memory_order_acquire))
+                    continue;
+                dropped = std::move(found->second);
+                pinned = dropped->pinned;
+                shard.entries.erase(found);
+            }
+            retire(std::move(dropped), pinned);
+            ++generation_;
+        }
+    }
+
+    FileId Environment::file_id(File const& file)
+    {
+        std::scoped_lock lock(file_ids_mutex_);
+        auto [found, inserted] = file_ids_.try_emplace(&file);
+        if (!inserted)
+            return found->second;
+
+        const auto id = file_id_count_.load(std::memory_order_relaxed);
+        if (id == FileIdSegments << FileIdSegmentBits)
+        {
+            file_ids_.erase(found);
+            throw std::length_error("too many files in the environment");
+        }
+
+        auto & segment = files_by_id_[id >> FileIdSegmentBits];
+        if (!segment)
+            segment = std::make_unique<std::atomic<File const*>[]>(size_t{ 1 } << FileIdSegmentBits);
+        segment[id & ((1u << FileIdSegmentBits) - 1)].store(&file, std::memory_order_relaxed);
+        found->second = FileId{ id };
+        file_id_count_.store(id + 1, std::memory_order_release);
+        return found->second;
+    }
+
+    File const* Environment::file(FileId id) const
+    {
+        const auto i = static_cast<uint32_t>(id);
+        if (i >= file_id_count_.load(std::memory_order_acquire))
+            return nullptr;
+        return files_by_id_[i >> FileIdSegmentBits][i & ((1u << FileIdSegmentBits) - 1)].load(std::memory_order_acquire);
+    }
+
+    std::shared_ptr<Environment::Snapshot const> Environment::snapshot()
+    {
+        if (changes_pending_.load(std::memory_order_acquire))
+            drop_changed_bmis();
+
+        auto current = snapshot_.load(std::memory_order_acquire);
+        if (current && current->version_ == module_set_version_.load(std::memory_order_acquire))
+            return current;
+
+        std::scoped_lock lock(snapshot_mutex_);
+        // Read before collecting, changes made meanwhile make the snapshot outdated right away.
+        const auto version = module_set_version_.load(std::memory_order_acquire);
+        current = snapshot_.load(std::memory_order_acquire);
+        if (current && current->version_ == version)
+            return current;
+
+        auto next = std::make_shared<Snapshot>();
+        next->version_ = version;
+        next->module_map_ = modules_;
+        for (auto const & shard : cached_bmis_)
+        {
+            std::scoped_lock shard_lock(shard.mutex);
+            for (auto const & [key, entry] : shard.entries)
+            {
+                if (entry->ready.load(std::memory_order_acquire))
+                    next->modules_.emplace(key, entry->bmi);
+            }
+        }
+
+        snapshot_.store(next, std::memory_order_release);
+        return next;
+    }
+
+    File const* Environment::Snapshot::find(std::filesystem::path const & key) const
+    {
+        const auto found = modules_.find(key);
+        return found != modules_.end() ? found->second.get() : nullptr;
+    }
+
+    File const* Environment::Snapshot::find_referenced_module(ModuleReference module, File const& file) const
+    {
+        const auto bmi = find_bmi_path(*module_map_, module, file);
+        return bmi != nullptr ? find(*bmi) : nullptr;
+    }
+
+    Environment::Reload Environment::reload_module_by_bmi_path(std::filesystem::path const & key)
+    {
+        TraceScope trace("reload_module_by_bmi_path", "environment", key);
+        auto & shard = cached_bmis_[PathHasher{}(key) % CacheShards];
+
+        CacheEntryPtr previous;
+        {
+            std::scoped_lock lock(shard.mutex);
+            if (auto found = shard.entries.find(key); found != shard.entries.end() && found->second->ready.load(std::memory_order_acquire))
+                previous = found->second;
+        }
+        if (!previous)
+            return { acquire_module_by_bmi_path(key) };
+
+        // Read like any other load, but into an entry of its own until it turns out to differ.
+        auto entry = std::make_shared<CacheEntry>();
+        auto const& file = finish_loading(*entry, key);
+
+        Reload result;
+        result.reloaded = true;
+        result.previous_checksum = previous->bmi->header().checksum;
+        result.diff = diff_files(*previous->bmi, file);
+        if (result.diff.identical)
+        {
+            loaded_bytes_ -= file.blob().size();
+            forget_resolutions(&file);
+            {
+                std::scoped_lock lock(shard.mutex);
+                previous->last_use = ++use_clock_;
+            }
+            auto const* previous_file = previous->bmi.get();
+            result.module = { std::move(previous), previous_file };
+            return result;
+        }
+
+        result.adopted_indexes = file.adopt_indexes(*previous->bmi, result.diff);
+
+        CacheEntryPtr replaced;
+        bool replaced_pinned = false;
+        {
+            std::scoped_lock lock(shard.mutex);
+            replaced = std::exchange(shard.entries[key], entry);
+            replaced_pinned = replaced && replaced->pinned;
+            entry->last_use = ++use_clock_;
+        }
+        ++module_set_version_;
+
+        // The replaced entry may have been evicted or reloaded by another thread meanwhile.
+        if (replaced && replaced->ready.load(std::memory_order_acquire))
+            retire(std::move(replaced), replaced_pinned);
+
+        result.module = { std::move(entry), &file };
+        evict_over_budget();
+        return result;
+    }
+
+    Environment::ModuleMap::ModuleMap(Config config)
+    {
+        add(std::move(config));
+    }
+
+    void Environment::ModuleMap::add(Config config)
     {
         for (auto & [header, bmi] : config.imported_header_units)
-            module_name_to_bmi_path_.emplace(std::move(header), std::move(bmi));
+            add(std::move(header), std::move(bmi));
         for (auto & [name, bmi] : config.imported_modules)
-            module_name_to_bmi_path_.emplace(std::move(name), std::move(bmi));
+            add(std::move(name), std::move(bmi));
+    }
+
+    void Environment::ModuleMap::add(std::string name, std::filesystem::path bmi)
+    {
+        auto [it, inserted] = bmis_.try_emplace(std::move(name), std::move(bmi));
+        if (!inserted && it->second != bmi)
+            throw std::invalid_argument("'" + it->first + "' is mapped to both " + it->second.string() + " and " + bmi.string());
+    }
+
+    std::filesystem::path const* Environment::ModuleMap::find(std::string_view name) const
+    {
+        const auto bmi = bmis_.find(name);
+        return bmi != bmis_.end() ? &bmi->second : nullptr;
+    }
+
+    std::filesystem::path const* Environment::ModuleMap::find(NameParts name) const
+    {
+        const auto bmi = bmis_.find(name);
+        return bmi != bmis_.end() ? &bmi->second : nullptr;
+    }
+
+    namespace
+    {
+        // FNV-1a, which can continue hashing where a previous string left off.
+        constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+
+        uint64_t fnv1a(uint64_t hash, std::string_view s)
+        {
+            for (unsigned char c : s)
+                hash = (hash ^ c) * 0x100000001b3;
+            return hash;
+        }
+    }
+
+    size_t Environment::ModuleMap::NameHash::operator()(std::string_view name) const noexcept
+    {
+        return static_cast<size_t>(fnv1a(FNV_OFFSET_BASIS, name));
+    }
+
+    size_t Environment::ModuleMap::NameHash::operator()(NameParts name) const noexcept
+    {
+        if (name.owner.empty())
+            return (*this)(name.partition);
+
+        auto hash = fnv1a(FNV_OFFSET_BASIS, name.owner);
+        if (!name.partition.empty())
+            hash = fnv1a(fnv1a(hash, ":"), name.partition);
+        return static_cast<size_t>(hash);
+    }
+
+    bool Environment::ModuleMap::NameEqual::operator()(std::string_view a, NameParts b) const noexcept
+    {
+        if (b.owner.empty())
+            return a == b.partition;
+        if (b.partition.empty())
+            return a == b.owner;
+        return a.size() == b.owner.size() + 1 + b.partition.size()
+            && a.starts_with(b.owner) && a[b.owner.size()] == ':' && a.ends_with(b.partition);
+    }
+
+    Environment::Environment(Config config, FileReader file_reader, std::shared_ptr<SharedBMIStore> store)
+        : Environment(std::make_shared<ModuleMap const>(std::move(config)), std::move(file_reader), std::move(store))
+    {
+    }
+
+    Environment::Environment(Config config, AsyncFileReader file_reader, std::shared_ptr<SharedBMIStore> store)
+        : Environment(std::make_shared<ModuleMap const>(std::move(config)), std::move(file_reader), std::move(store))
+    {
+    }
+
+    Environment::Environment(std::shared_ptr<ModuleMap const> modules, FileReader file_reader, std::shared_ptr<SharedBMIStore> store)
+        // Deferred, so that synchronous reads happen in finish_loading, outside of the shard lock.
+        : Environment(std::move(modules), [file_reader = std::move(file_reader)](std::filesystem::path const & path) {
+            return std::async(std::launch::deferred, file_reader, path);
+        }, std::move(store))
+    {
+    }
+
+    Environment::Environment(std::shared_ptr<ModuleMap const> modules, AsyncFileReader file_reader, std::shared_ptr<SharedBMIStore> store)
+        : file_reader_(std::move(file_reader))
+        , store_(std::move(store))
+        , modules_(std::move(modules))
+    {
+    }
+
+    std::shared_ptr<SharedBMIStore> SharedBMIStore::global()
+    {
+        static const auto store = std::make_shared<SharedBMIStore>();
+        return store;
+    }
+
+    size_t SharedBMIStore::KeyHasher::operator() (Key const & key) const noexcept
+    {
+        auto hash = std::hash<std::string>{}(key.path);
+        hash ^= std::hash<uintmax_t>{}(key.size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<int64_t>{}(key.modification_time) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    std::shared_ptr<File const> SharedBMIStore::get(std::filesystem::path const & path, std::function<Environment::BlobHolderPtr()> const& read, FileOptions const& options)
+    {
+        // Paths that are not files on disk (e.g. for custom readers) are used as they are.
+        std::error_code canonical_error;
+        auto canonical_path = std::filesystem::canonical(path, canonical_error);
+        if (canonical_error)
+            canonical_path = path;
+        std::error_code size_error;
+        const auto size = std::filesystem::file_size(canonical_path, size_error);
+        std::error_code time_error;
+        const auto modification_time = std::filesystem::last_write_time(canonical_path, time_error);
+        const Key key{
+            canonical_path.string(),
+            size_error ? 0 : size,
+            time_error ? 0 : static_cast<int64_t>(modification_time.time_since_epoch().count()),
+        };
+
+        std::shared_ptr<Slot> slot;
+        {
+            std::scoped_lock lock(mutex_);
+            auto found = slots_.find(key);
+            if (found == slots_.end())
+            {
+                // Drop slots of BMIs that are no longer used by any Environment.
+                std::erase_if(slots_, [](auto const& key_and_slot) {
+                    auto const& [key, slot] = key_and_slot;
+                    return slot.use_count() == 1 && slot->bmi.expired();
+                });
+                found = slots_.emplace(key, std::make_shared<Slot>()).first;
+            }
+            slot = found->second;
+        }
+
+        // Reading happens outside of the store lock, so that different BMIs load concurrently.
+        std::scoped_lock lock(slot->mutex);
+        if (auto bmi = slot->bmi.lock())
+            return bmi;
+
+        auto cached = std::make_shared<Environment::CachedBMI>(read(), options);
+        std::shared_ptr<File const> bmi(cached, &cached->ifc);
+        slot->bmi = bmi;
+        return bmi;
     }
 }
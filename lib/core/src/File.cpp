@@ -1,18 +1,44 @@
 #include "ifc/File.h"
+#include "ifc/Cancellation.h"
+#include "ifc/FileDiff.h"
+#include "ifc/MemoryUsage.h"
+#include "ifc/Parallel.h"
+#include "ifc/SortFilter.h"
+#include "ifc/Trace.h"
 #include "ifc/Trait.h"
+#include "ifc/TraitIndex.h"
 
 #include "ifc/Attribute.h"
 #include "ifc/Chart.h"
 #include "ifc/Declaration.h"
 #include "ifc/Expression.h"
+#include "ifc/Macro.h"
 #include "ifc/SyntaxTree.h"
 #include "ifc/Type.h"
+#include "ifc/Word.h"
 
+#include "Sha256.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
 #include <span>
 #include <stdexcept>
-#include <unordered_map>
+#include <string>
+#include <string_view>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace ifc
 {
@@ -27,123 +53,313 @@ namespace ifc
 
         constexpr FileSignature CANONICAL_FILE_SIGNATURE = as_bytes(0x54, 0x51, 0x45, 0x1A);
 
-        enum class FilePartitionCache : uint32_t
-        {
-            Declarations,
-            ScopeDeclarations,
-            TemplateDeclarations,
-            PartialSpecializations,
-            Specializations,
-            UsingDeclarations,
-            Enumerations,
-            Enumerators,
-            AliasDeclarations,
-            DeclReferences,
-            Functions,
-            Methods,
-            Constructors,
-            Destructors,
-            Variables,
-            Parameters,
-            Fields,
-            Friends,
-            Concepts,
-            IntrinsicDeclarations,
-            SpecializationForms,
-            FundamentalTypes,
-            DesignatedTypes,
-            TorTypes,
-            SyntacticTypes,
-            ExpansionTypes,
-            PointerTypes,
-            FunctionTypes,
-            MethodTypes,
-            ArrayTypes,
-            BaseTypes,
-            TupleTypes,
-            LvalueReferences,
-            RvalueReferences,
-            QualifiedTypes,
-            ForallTypes,
-            SyntaxTypes,
-            PlaceholderTypes,
-            TypenameTypes,
-            DecltypeTypes,
-            BasicAttributes,
-            ScopedAttributes,
-            LabeledAttributes,
-            CalledAttributes,
-            ExpandedAttributes,
-            FactoredAttributes,
-            ElaboratedAttributes,
-            TupleAttributes,
-            LiteralExpressions,
-            TypeExpressions,
-            DeclExpressions,
-            UnqualifiedIdExpressions,
-            TemplateIds,
-            TemplateReferences,
-            MonadExpressions,
-            DyadExpressions,
-            StringExpressions,
-            CallExpressions,
-            SizeofExpressions,
-            AlignofExpressions,
-            RequiresExpressions,
-            TupleExpressions,
-            PathExpressions,
-            ReadExpressions,
-            SyntaxTreeExpressions,
-            ExpressionLists,
-            QualifiedNameExpressions,
-            PackedTemplateArguments,
-            ProductValueTypeExpressions,
-            SubojectValueExpressions,
-            StringLiteralExpressions,
-            TypeHeap,
-            ExprHeap,
-            AttrHeap,
-            SyntaxHeap,
-            OperatorNames,
-            ConversionNames,
-            LiteralNames,
-            TemplateNames,
-            SpecializationNames,
-            SourceFileNames,
-            DeductionGuideNames,
-            UnilevelCharts,
-            MultilevelCharts,
-            IntegerLiterals,
-            FpLiterals,
-            SimpleTypeSpecifiers,
-            DecltypeSpecifiers,
-            TypeSpecifierSeqSyntaxTrees,
-            DeclSpecifierSeqSyntaxTrees,
-            TypeidSyntaxTrees,
-            DeclaratorSyntaxTrees,
-            PointerDeclaratorSyntaxTrees,
-            FunctionDeclaratorSyntaxTrees,
-            ParameterDeclaratorSyntaxTrees,
-            ExpressionSyntaxTrees,
-            RequiresClauseSyntaxTrees,
-            SimpleRequirementSyntaxTrees,
-            TypeRequirementSyntaxTrees,
-            NestedRequirementSyntaxTrees,
-            CompoundRequirementSyntaxTrees,
-            RequirementBodySyntaxTrees,
-            TypeTemplateArgumentSyntaxTrees,
-            TemplateArgumentListSyntaxTrees,
-            TemplateidSyntaxTrees,
-            TypeTraitIntrinsicSyntaxTrees,
-            TupleSyntaxTrees,
-            ImportedModules,
-            ExportedModules,
-            DeductionGuides,
-
-            Num,
+        // Abstract references whose sorts index partitions, see File::validate.
+        enum class ReferenceKind : uint8_t
+        {
+            None,
+            Decl,
+            Type,
+            Expr,
+            Attr,
+            Syntax,
+            Chart,
+            Form,
+            Name,
+            Count,
         };
+
+        constexpr ReferenceKind reference_kind(DeclSort)   { return ReferenceKind::Decl; }
+        constexpr ReferenceKind reference_kind(TypeSort)   { return ReferenceKind::Type; }
+        constexpr ReferenceKind reference_kind(ExprSort)   { return ReferenceKind::Expr; }
+        constexpr ReferenceKind reference_kind(AttrSort)   { return ReferenceKind::Attr; }
+        constexpr ReferenceKind reference_kind(SyntaxSort) { return ReferenceKind::Syntax; }
+        constexpr ReferenceKind reference_kind(ChartSort)  { return ReferenceKind::Chart; }
+        constexpr ReferenceKind reference_kind(FormSort)   { return ReferenceKind::Form; }
+        constexpr ReferenceKind reference_kind(NameSort)   { return ReferenceKind::Name; }
+        constexpr ReferenceKind reference_kind(auto)       { return ReferenceKind::None; }
+
+        // Maps every known partition name to its cache slot. Sorted at compile time,
+        // so the table of contents is resolved with one binary search per entry
+        // instead of building a hash map of partition names for every file.
+        // Files written by newer compilers may have larger entries, whose records are read with a stride,
+        // except in partitions that are read as arrays (heaps of references and words).
+        struct PartitionSlot
+        {
+            std::string_view name;
+            FilePartitionCache cache;
+            size_t entry_size;
+            bool packed = false;
+            // Of the records, for the partitions of a sort.
+            ReferenceKind kind = ReferenceKind::None;
+            uint8_t sort = 0;
+        };
+
+        template<typename T>
+        constexpr PartitionSlot slot(FilePartitionCache cache, bool packed = false)
+        {
+            PartitionSlot result{ T::PartitionName, cache, sizeof(T), packed };
+            if constexpr (requires { T::Sort; })
+            {
+                result.kind = reference_kind(T::Sort);
+                result.sort = static_cast<uint8_t>(T::Sort);
+            }
+            return result;
+        }
+
+        constexpr auto sorted_by_name(auto slots)
+        {
+            std::ranges::sort(slots, {}, &PartitionSlot::name);
+            return slots;
+        }
+
+        constexpr auto PARTITION_SLOTS = sorted_by_name(std::to_array<PartitionSlot>({
+                slot<Declaration>(FilePartitionCache::Declarations),
+                slot<ScopeDeclaration>(FilePartitionCache::ScopeDeclarations),
+                slot<TemplateDeclaration>(FilePartitionCache::TemplateDeclarations),
+                slot<PartialSpecialization>(FilePartitionCache::PartialSpecializations),
+                slot<Specialization>(FilePartitionCache::Specializations),
+                slot<UsingDeclaration>(FilePartitionCache::UsingDeclarations),
+                slot<Enumeration>(FilePartitionCache::Enumerations),
+                slot<Enumerator>(FilePartitionCache::Enumerators),
+                slot<AliasDeclaration>(FilePartitionCache::AliasDeclarations),
+                slot<DeclReference>(FilePartitionCache::DeclReferences),
+                slot<FunctionDeclaration>(FilePartitionCache::Functions),
+                slot<MethodDeclaration>(FilePartitionCache::Methods),
+                slot<Constructor>(FilePartitionCache::Constructors),
+                slot<Destructor>(FilePartitionCache::Destructors),
+                slot<VariableDeclaration>(FilePartitionCache::Variables),
+                slot<ParameterDeclaration>(FilePartitionCache::Parameters),
+                slot<FieldDeclaration>(FilePartitionCache::Fields),
+                slot<BitfieldDeclaration>(FilePartitionCache::Bitfields),
+                slot<FriendDeclaration>(FilePartitionCache::Friends),
+                slot<Concept>(FilePartitionCache::Concepts),
+                slot<IntrinsicDeclaration>(FilePartitionCache::IntrinsicDeclarations),
+                slot<SpecializationForm>(FilePartitionCache::SpecializationForms),
+                slot<FundamentalType>(FilePartitionCache::FundamentalTypes),
+                slot<DesignatedType>(FilePartitionCache::DesignatedTypes),
+                slot<TorType>(FilePartitionCache::TorTypes),
+                slot<SyntacticType>(FilePartitionCache::SyntacticTypes),
+                slot<ExpansionType>(FilePartitionCache::ExpansionTypes),
+                slot<PointerType>(FilePartitionCache::PointerTypes),
+                slot<FunctionType>(FilePartitionCache::FunctionTypes),
+                slot<MethodType>(FilePartitionCache::MethodTypes),
+                slot<ArrayType>(FilePartitionCache::ArrayTypes),
+                slot<BaseType>(FilePartitionCache::BaseTypes),
+                slot<TupleType>(FilePartitionCache::TupleTypes),
+                slot<LvalueReference>(FilePartitionCache::LvalueReferences),
+                slot<RvalueReference>(FilePartitionCache::RvalueReferences),
+                slot<QualifiedType>(FilePartitionCache::QualifiedTypes),
+                slot<ForallType>(FilePartitionCache::ForallTypes),
+                slot<SyntaxType>(FilePartitionCache::SyntaxTypes),
+                slot<PlaceholderType>(FilePartitionCache::PlaceholderTypes),
+                slot<TypenameType>(FilePartitionCache::TypenameTypes),
+                slot<DecltypeType>(FilePartitionCache::DecltypeTypes),
+                slot<AttrBasic>(FilePartitionCache::BasicAttributes),
+                slot<AttrScoped>(FilePartitionCache::ScopedAttributes),
+                slot<AttrLabeled>(FilePartitionCache::LabeledAttributes),
+                slot<AttrCalled>(FilePartitionCache::CalledAttributes),
+                slot<AttrExpanded>(FilePartitionCache::ExpandedAttributes),
+                slot<AttrFactored>(FilePartitionCache::FactoredAttributes),
+                slot<AttrElaborated>(FilePartitionCache::ElaboratedAttributes),
+                slot<AttrTuple>(FilePartitionCache::TupleAttributes),
+                slot<LiteralExpression>(FilePartitionCache::LiteralExpressions),
+                slot<TypeExpression>(FilePartitionCache::TypeExpressions),
+                slot<NamedDecl>(FilePartitionCache::DeclExpressions),
+                slot<UnqualifiedId>(FilePartitionCache::UnqualifiedIdExpressions),
+                slot<TemplateId>(FilePartitionCache::TemplateIds),
+                slot<TemplateReference>(FilePartitionCache::TemplateReferences),
+                slot<MonadExpression>(FilePartitionCache::MonadExpressions),
+                slot<DyadExpression>(FilePartitionCache::DyadExpressions),
+                slot<StringExpression>(FilePartitionCache::StringExpressions),
+                slot<CallExpression>(FilePartitionCache::CallExpressions),
+                slot<SizeofExpression>(FilePartitionCache::SizeofExpressions),
+                slot<AlignofExpression>(FilePartitionCache::AlignofExpressions),
+                slot<RequiresExpression>(FilePartitionCache::RequiresExpressions),
+                slot<TupleExpression>(FilePartitionCache::TupleExpressions),
+                slot<PathExpression>(FilePartitionCache::PathExpressions),
+                slot<ReadExpression>(FilePartitionCache::ReadExpressions),
+                slot<SyntaxTreeExpression>(FilePartitionCache::SyntaxTreeExpressions),
+                slot<ExpressionListExpression>(FilePartitionCache::ExpressionLists),
+                slot<QualifiedNameExpression>(FilePartitionCache::QualifiedNameExpressions),
+                slot<PackedTemplateArguments>(FilePartitionCache::PackedTemplateArguments),
+                slot<ProductValueTypeExpression>(FilePartitionCache::ProductValueTypeExpressions),
+                slot<SubobjectValueExpression>(FilePartitionCache::SubojectValueExpressions),
+                slot<StringLiteral>(FilePartitionCache::StringLiteralExpressions),
+                slot<ChartUnilevel>(FilePartitionCache::UnilevelCharts),
+                slot<ChartMultilevel>(FilePartitionCache::MultilevelCharts),
+                slot<IntegerLiteral>(FilePartitionCache::IntegerLiterals),
+                slot<FPLiteral>(FilePartitionCache::FpLiterals),
+                slot<SimpleTypeSpecifier>(FilePartitionCache::SimpleTypeSpecifiers),
+                slot<DecltypeSpecifier>(FilePartitionCache::DecltypeSpecifiers),
+                slot<TypeSpecifierSeq>(FilePartitionCache::TypeSpecifierSeqSyntaxTrees),
+                slot<DeclSpecifierSeq>(FilePartitionCache::DeclSpecifierSeqSyntaxTrees),
+                slot<TypeIdSyntax>(FilePartitionCache::TypeidSyntaxTrees),
+                slot<DeclaratorSyntax>(FilePartitionCache::DeclaratorSyntaxTrees),
+                slot<PointerDeclaratorSyntax>(FilePartitionCache::PointerDeclaratorSyntaxTrees),
+                slot<FunctionDeclaratorSyntax>(FilePartitionCache::FunctionDeclaratorSyntaxTrees),
+                slot<ParameterDeclaratorSyntax>(FilePartitionCache::ParameterDeclaratorSyntaxTrees),
+                slot<ExpressionSyntax>(FilePartitionCache::ExpressionSyntaxTrees),
+                slot<RequiresClauseSyntax>(FilePartitionCache::RequiresClauseSyntaxTrees),
+                slot<SimpleRequirementSyntax>(FilePartitionCache::SimpleRequirementSyntaxTrees),
+                slot<TypeRequirementSyntax>(FilePartitionCache::TypeRequirementSyntaxTrees),
+                slot<NestedRequirementSyntax>(FilePartitionCache::NestedRequirementSyntaxTrees),
+                slot<CompoundRequirementSyntax>(FilePartitionCache::CompoundRequirementSyntaxTrees),
+                slot<RequirementBodySyntax>(FilePartitionCache::RequirementBodySyntaxTrees),
+                slot<TypeTemplateArgumentSyntax>(FilePartitionCache::TypeTemplateArgumentSyntaxTrees),
+                slot<TemplateArgumentListSyntax>(FilePartitionCache::TemplateArgumentListSyntaxTrees),
+                slot<TemplateIdSyntax>(FilePartitionCache::TemplateidSyntaxTrees),
+                slot<TypeTraitIntrinsicSyntax>(FilePartitionCache::TypeTraitIntrinsicSyntaxTrees),
+                slot<TupleSyntax>(FilePartitionCache::TupleSyntaxTrees),
+                slot<Word>(FilePartitionCache::Words, true),
+                slot<Sentence>(FilePartitionCache::Sentences),
+                slot<ObjectLikeMacro>(FilePartitionCache::ObjectLikeMacros),
+                slot<FunctionLikeMacro>(FilePartitionCache::FunctionLikeMacros),
+                slot<IdentifierForm>(FilePartitionCache::IdentifierForms),
+                slot<NumberForm>(FilePartitionCache::NumberForms),
+                slot<CharacterForm>(FilePartitionCache::CharacterForms),
+                slot<StringForm>(FilePartitionCache::StringForms),
+                slot<OperatorForm>(FilePartitionCache::OperatorForms),
+                slot<KeywordForm>(FilePartitionCache::KeywordForms),
+                slot<WhitespaceForm>(FilePartitionCache::WhitespaceForms),
+                slot<ParameterForm>(FilePartitionCache::ParameterForms),
+                slot<StringizeForm>(FilePartitionCache::StringizeForms),
+                slot<CatenateForm>(FilePartitionCache::CatenateForms),
+                slot<PragmaForm>(FilePartitionCache::PragmaForms),
+                slot<HeaderForm>(FilePartitionCache::HeaderForms),
+                slot<ParenthesizedForm>(FilePartitionCache::ParenthesizedForms),
+                slot<TupleForm>(FilePartitionCache::TupleForms),
+                slot<JunkForm>(FilePartitionCache::JunkForms),
+                slot<OperatorFunctionName>(FilePartitionCache::OperatorNames),
+                slot<ConversionFunctionName>(FilePartitionCache::ConversionNames),
+                slot<LiteralName>(FilePartitionCache::LiteralNames),
+                slot<TemplateName>(FilePartitionCache::TemplateNames),
+                slot<SpecializationName>(FilePartitionCache::SpecializationNames),
+                slot<SourceFileName>(FilePartitionCache::SourceFileNames),
+                slot<DeductionGuideName>(FilePartitionCache::DeductionGuideNames),
+                slot<FileAndLine>(FilePartitionCache::Lines),
+                { "heap.type",              FilePartitionCache::TypeHeap,                sizeof(TypeIndex), true },
+                { "heap.expr",              FilePartitionCache::ExprHeap,                sizeof(ExprIndex), true },
+                { "heap.attr",              FilePartitionCache::AttrHeap,                sizeof(AttrIndex), true },
+                { "heap.syn",               FilePartitionCache::SyntaxHeap,              sizeof(SyntaxIndex), true },
+                { "heap.chart",             FilePartitionCache::ChartHeap,               sizeof(ChartIndex), true },
+                { "heap.form",              FilePartitionCache::FormHeap,                sizeof(FormIndex), true },
+                { "module.imported",        FilePartitionCache::ImportedModules,         sizeof(ModuleReference) },
+                { "module.exported",        FilePartitionCache::ExportedModules,         sizeof(ModuleReference) },
+                { "name.guide",             FilePartitionCache::DeductionGuides,         sizeof(DeclIndex), true },
+                { "scope.desc",             FilePartitionCache::ScopeDescriptors,        sizeof(Sequence) },
+                { "trait.attribute",        FilePartitionCache::TraitAttributes,         sizeof(AssociatedTrait<AttrIndex>) },
+                { ".msvc.trait.decl-attrs", FilePartitionCache::MsvcTraitDeclAttributes, sizeof(AssociatedTrait<AttrIndex>) },
+                { "trait.deprecated",       FilePartitionCache::TraitDeprecated,         sizeof(AssociatedTrait<TextOffset>) },
+                { "trait.friend",           FilePartitionCache::TraitFriend,             sizeof(AssociatedTrait<Sequence>) },
+            }));
+
+        static_assert(PARTITION_SLOTS.size() == static_cast<size_t>(FilePartitionCache::Num),
+            "every FilePartitionCache entry must have exactly one partition name");
+
+        std::string_view partition_name(FilePartitionCache cache)
+        {
+            return std::ranges::find(PARTITION_SLOTS, cache, &PartitionSlot::cache)->name;
+        }
     }
 
+    // Monotonic arena of a File (see FileOptions::arena), safe for concurrent builds of different indexes.
+    class FileArena final : public std::pmr::memory_resource
+    {
+    public:
+        explicit FileArena(std::pmr::memory_resource* upstream)
+            : arena_(upstream)
+        {
+        }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            std::scoped_lock lock(mutex_);
+            return arena_.allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void*, size_t, size_t) override
+        {
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        std::mutex mutex_;
+        std::pmr::monotonic_buffer_resource arena_;
+    };
+
+    // Blocked Bloom filter over the distinct texts of the string table: each text sets bits of one 64-byte
+    // block only, so that rejecting a text takes a single cache line, for about 1% of false positives.
+    struct TextFilter
+    {
+        static constexpr uint32_t BlockWords = 16;
+        static constexpr size_t BitsPerText = 10;
+        static constexpr int Probes = 6;
+
+        static size_t word_count(size_t texts)
+        {
+            return std::max<size_t>(1, (texts * BitsPerText + BlockWords * 32 - 1) / (BlockWords * 32)) * BlockWords;
+        }
+
+        // FNV-1a and the splitmix64 finalizer, stable across runs unlike std::hash, as filters are stored
+        // in side indexes.
+        static uint64_t hash(std::string_view text)
+        {
+            uint64_t hash = 0xcbf29ce484222325;
+            for (char c : text)
+                hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+            hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+            hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+            return hash ^ (hash >> 31);
+        }
+
+        // The block by the high half of the hash, the bits within it by 9-bit slices of the low one.
+        template<typename Visit>
+        static void for_each_bit(size_t words, std::string_view text, Visit visit)
+        {
+            const auto h = hash(text);
+            const auto block = static_cast<size_t>(((h >> 32) * (words / BlockWords)) >> 32) * BlockWords;
+            for (int probe = 0; probe != Probes; ++probe)
+            {
+                const auto bit = static_cast<uint32_t>(h >> (9 * probe)) & (BlockWords * 32 - 1);
+                visit(block + bit / 32, uint32_t{ 1 } << (bit % 32));
+            }
+        }
+
+        static void add(std::span<uint32_t> words, std::string_view text)
+        {
+            for_each_bit(words.size(), text, [&](size_t word, uint32_t mask) { words[word] |= mask; });
+        }
+
+        static bool may_contain(std::span<uint32_t const> words, std::string_view text)
+        {
+            bool result = true;
+            for_each_bit(words.size(), text, [&](size_t word, uint32_t mask) { result &= (words[word] & mask) != 0; });
+            return result;
+        }
+    };
+
+    // Layout of a side index: the header followed by the arrays of uint32_t
+    // string ends, string starts, string symbols and texts (see File::Impl::TextInterning),
+    // and the words of the text filter.
+    struct SideIndexHeader
+    {
+        static constexpr std::array<char, 4> Magic{ 'I', 'F', 'C', 'X' };
+        static constexpr uint32_t CurrentVersion = 2;
+
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint64_t blob_size;
+        SHA256 checksum;
+        uint32_t string_ends;
+        uint32_t strings;
+        uint32_t texts;
+        uint32_t text_filter;
+    };
+
     struct File::Impl
     {
     private:
@@ -154,7 +370,7 @@ namespace ifc
         };
 
         std::span<std::byte const> blob_;
-        std::unordered_map<std::string_view, PartitionSummary const*> table_of_contents_;
+        std::array<PartitionSummary const*, (size_t)FilePartitionCache::Num> table_of_contents_{};
 
         Structure const * structure() const
         {
@@ -177,20 +393,127 @@ namespace ifc
             return reinterpret_cast<T const*>(get_raw_pointer(offset));
         }
 
+        // `init`, traced and timed into the stats when they are collected.
+        template<typename Init>
+        auto timed(std::string_view name, Init init)
+        {
+#ifdef IFC_FILE_STATS
+            return [this, name, init](auto &... value) {
+                TraceScope trace(name, "index");
+                const auto start = std::chrono::steady_clock::now();
+                init(value...);
+                const auto duration = std::chrono::steady_clock::now() - start;
+                std::scoped_lock lock(stats_.mutex);
+                stats_.builds.push_back({ name, duration });
+            };
+#else
+            return [name, init](auto &... value) {
+                TraceScope trace(name, "index");
+                init(value...);
+            };
+#endif
+        }
+
     public:
-        Impl(BlobView blob)
+        Impl(BlobView blob, FileOptions options)
             : blob_(blob)
+            , arena_(options.arena ? std::make_unique<FileArena>(options.memory_resource ? options.memory_resource : std::pmr::get_default_resource()) : nullptr)
+            , resource_(arena_ ? arena_.get() : options.memory_resource ? options.memory_resource : std::pmr::get_default_resource())
+            , index_string_lengths_(options.index_string_lengths)
+            , fetch_(std::move(options.fetch))
+            , string_ends_(resource_)
+            , text_interning_(resource_)
+            , text_filter_(resource_)
+            , trait_deprecation_texts_(resource_)
+            , trait_declaration_attributes_(resource_)
+            , trait_friendship_of_class_(resource_)
         {
+            TraceScope trace("File", "file");
+
+            if (fetch_)
+            {
+                fetch_(blob_.first(std::min(sizeof(Structure), blob_.size())));
+                if (blob_.size() < sizeof(Structure))
+                    throw std::runtime_error("corrupted file");
+                fetch_bytes(static_cast<size_t>(header().toc), raw_count(header().partition_count) * sizeof(PartitionSummary));
+                fetch_bytes(static_cast<size_t>(header().string_table_bytes), raw_count(header().string_table_size));
+            }
+
             if (structure()->signature != CANONICAL_FILE_SIGNATURE)
                 throw std::invalid_argument("corrupted file signature");
 
+            // The table of contents and the string table are read before the partitions are checked.
+            if (!in_blob(static_cast<size_t>(header().toc), raw_count(header().partition_count) * sizeof(PartitionSummary))
+                || !in_blob(static_cast<size_t>(header().string_table_bytes), raw_count(header().string_table_size)))
+                throw std::runtime_error("corrupted file");
+
             if (calc_size() != blob_.size())
                 throw std::runtime_error("corrupted file");
 
+            string_table_ = { get_pointer<char>(header().string_table_bytes), raw_count(header().string_table_size) };
+            if (string_table_.empty())
+                string_table_ = options.string_table;
+
+            // The checksum covers everything after itself.
+            if (options.verify_checksum)
+            {
+                TraceScope trace_checksum("verify_checksum", "file");
+                if (fetch_)
+                    fetch_(blob_);
+                const auto checksum = compute_sha256(blob_.subspan(sizeof(FileSignature) + sizeof(SHA256)));
+                if (checksum.data != header().checksum.data)
+                    throw std::runtime_error("file checksum mismatch");
+            }
+
+            if (!options.side_index.empty())
+                load_side_index(options.side_index);
+
             for (auto const& partition : table_of_contents())
             {
-                table_of_contents_.emplace(get_string(partition.name), &partition);
+                if (!in_blob(static_cast<size_t>(partition.offset), partition.size_bytes())
+                    || static_cast<size_t>(partition.name) >= string_table_.size())
+                    throw std::runtime_error("corrupted file");
+
+                // Several caches may share one partition (e.g. "name.guide").
+                const auto slots = std::ranges::equal_range(PARTITION_SLOTS, std::string_view(get_string(partition.name)), {}, &PartitionSlot::name);
+                for (auto const& slot : slots)
+                {
+                    const auto entry_size = static_cast<size_t>(partition.entry_size);
+                    if (entry_size < slot.entry_size || (slot.packed && entry_size != slot.entry_size))
+                        throw std::runtime_error("partition '" + std::string(slot.name) + "' has entries of an unsupported size");
+
+                    table_of_contents_[(size_t)slot.cache] = &partition;
+                    if (options.eager_partitions)
+                    {
+                        fetch(partition);
+                        auto& cached_partition = cached_partitions_[(size_t)slot.cache];
+                        cached_partition.data = get_raw_pointer(partition.offset);
+                        cached_partition.size = raw_count(partition.cardinality);
+                        cached_partition.stride = entry_size;
+                    }
+                }
             }
+
+            if (options.validate)
+                validate(default_executor());
+            else if (options.validate_in_background)
+                validation_ = std::async(std::launch::async, [this] { validate(default_executor()); }).share();
+        }
+
+        ~Impl()
+        {
+            // The validation reads the blob and the table of contents.
+            if (validation_.valid())
+                validation_.wait();
+        }
+
+        std::shared_future<void> validation_status() const
+        {
+            if (validation_.valid() || !validated_.load(std::memory_order_acquire))
+                return validation_;
+            std::promise<void> validated;
+            validated.set_value();
+            return validated.get_future().share();
         }
 
         FileHeader const & header() const
@@ -198,785 +521,1220 @@ namespace ifc
             return structure()->header;
         }
 
+        BlobView blob() const
+        {
+            return blob_;
+        }
+
         std::span<PartitionSummary const> table_of_contents() const
         {
             auto const & h = header();
             return { get_pointer<PartitionSummary>(h.toc), raw_count(h.partition_count) };
         }
 
-        const char* get_string(TextOffset index) const
+        std::span<char const> string_table() const
         {
-            return get_pointer<char>(header().string_table_bytes) + static_cast<size_t>(index);
+            return string_table_;
         }
 
-        std::byte const* get_raw_pointer(ByteOffset offset) const
+        const char* get_string(TextOffset index) const
         {
-            return blob_.data() + static_cast<std::underlying_type_t<ByteOffset>>(offset);
+            return string_table_.data() + static_cast<size_t>(index);
         }
 
-        template<typename T, typename Index>
-        std::optional<Partition<T, Index>> try_get_partition(std::string_view name) const
+        std::string_view get_string_view(TextOffset index)
         {
-            auto it = table_of_contents_.find(name);
-            if (it == table_of_contents_.end())
-                return std::nullopt;
-
-            return get_partition<T, Index>(it->second);
+            const char* str = get_string(index);
+            if (!index_string_lengths_)
+                return str;
+
+            // The string ends at the first terminator at or after its offset
+            // (offsets may point into the middle of a string).
+            auto const & ends = string_ends();
+            const auto offset = static_cast<uint32_t>(index);
+            const auto end = std::ranges::lower_bound(ends, offset);
+            assert(end != ends.end());
+            return { str, *end - offset };
         }
 
-        template<typename T, typename Index>
-        Partition<T, Index> get_partition(std::string_view name) const
+        std::byte const* get_raw_pointer(ByteOffset offset) const
         {
-            return get_partition<T, Index>(table_of_contents_.at(name));
+            return blob_.data() + static_cast<std::underlying_type_t<ByteOffset>>(offset);
         }
 
         template<typename T, typename Index>
-        Partition<T, Index> get_partition(PartitionSummary const * partition) const
+        std::optional<Partition<T, Index>> try_get_partition(FilePartitionCache cache_type) const
         {
-            assert(static_cast<size_t>(partition->entry_size) == sizeof(T));
-            return { get_pointer<T>(partition->offset), raw_count(partition->cardinality) };
-        }
+            if (auto partition = table_of_contents_[(size_t)cache_type])
+            {
+                mark_accessed(cache_type);
+                return get_partition<T, Index>(partition);
+            }
 
-        template<typename T, typename Index>
-        Partition<T, Index> get_and_cache_partition(FilePartitionCache cache_type) const
-        {
-            return get_and_cache_partition<T, Index>(T::PartitionName, cache_type);
+            return std::nullopt;
         }
 
-        template<typename T, typename Index>
-        Partition<T, Index> get_and_cache_partition(std::string_view name, FilePartitionCache cache_type) const
-        { 
-            auto const cache_index = (uint32_t)cache_type;
-
-            if (auto& cached_partition = cached_partitions_[cache_index])
+        File::ResolvedPartition resolve_partition(std::string_view name, size_t entry_size) const
+        {
+            PartitionSummary const * partition = nullptr;
+            if (const auto slots = std::ranges::equal_range(PARTITION_SLOTS, name, {}, &PartitionSlot::name); !slots.empty())
             {
-                auto partition = *cached_partition;
-                return { static_cast<T const*>(partition.data), partition.size };
+                partition = table_of_contents_[(size_t)slots.front().cache];
+                if (partition)
+                    mark_accessed(slots.front().cache);
             }
             else
             {
-                auto result = get_partition<T, Index>(table_of_contents_.at(name));
-                cached_partition.emplace(result.data(), result.size());
-                return result;
+                const auto toc = table_of_contents();
+                const auto it = std::ranges::find_if(toc, [&](PartitionSummary const & summary) { return std::string_view(get_string(summary.name)) == name; });
+                partition = it != toc.end() ? &*it : nullptr;
             }
+            if (!partition)
+                return { nullptr, 0, entry_size };
+
+            if (static_cast<size_t>(partition->entry_size) < entry_size || !in_blob(static_cast<size_t>(partition->offset), partition->size_bytes()))
+                throw std::runtime_error("corrupted file: partition '" + std::string(name) + "' does not hold records of the expected size");
+            fetch(*partition);
+            return { get_raw_pointer(partition->offset), raw_count(partition->cardinality), static_cast<size_t>(partition->entry_size) };
         }
 
-        std::unordered_map<DeclIndex, std::vector<AttrIndex>> const & trait_declaration_attributes()
+        File::ResolvedPartition resolve_partition(size_t slot, std::string_view name, size_t entry_size) const
         {
-            if (!trait_declaration_attributes_)
-            {
-                trait_declaration_attributes_.emplace();
-
-                // ObjectTraits, FunctionTraits or Attributes for a template.
-                // We could separate this trait & .msvc.trait.decl-attrs.
-                // But the type is the same so it fits nicely here I think.
-                fill_decl_attributes("trait.attribute");
-                // All other attributes like [[nodiscard]] etc...
-                fill_decl_attributes(".msvc.trait.decl-attrs");
-            }
-            return *trait_declaration_attributes_;
+            auto result = resolve_partition(name, entry_size);
+            // Absent partitions are cached as empty ones, the null pointer means unresolved.
+            if (!result.data)
+                result.data = blob_.data();
+
+            // Concurrent first accesses may race here, but they all store the same values.
+            auto& cached_partition = user_partitions_[slot];
+            cached_partition.size.store(result.size, std::memory_order_relaxed);
+            cached_partition.stride.store(result.stride, std::memory_order_relaxed);
+            cached_partition.data.store(result.data, std::memory_order_release);
+            return result;
         }
 
-        std::unordered_map<DeclIndex, TextOffset> const & trait_deprecation_texts()
+        PartitionSummary const * get_partition_summary(FilePartitionCache cache_type) const
         {
-            if (!trait_deprecation_texts_)
-            {
-                trait_deprecation_texts_.emplace();
+            if (auto partition = table_of_contents_[(size_t)cache_type])
+                return partition;
 
-                if (auto deprecations = try_get_partition<AssociatedTrait<TextOffset>, Index>("trait.deprecated"))
-                {
-                    for (auto deprecation : *deprecations)
-                    {
-                        (*trait_deprecation_texts_)[deprecation.decl] = deprecation.trait;
-                    }
-                }
-            }
-            return *trait_deprecation_texts_;
+            throw std::out_of_range("partition '" + std::string(partition_name(cache_type)) + "' is absent");
         }
 
-        std::unordered_map<DeclIndex, Sequence> const& trait_friendship_of_class()
+        // Makes the partition readable, see FileOptions::fetch.
+        void fetch(PartitionSummary const& partition) const
         {
-            if (!trait_friendship_of_class_)
-            {
-                trait_friendship_of_class_.emplace();
-
-                if (auto friendships = try_get_partition<AssociatedTrait<Sequence>, Index>("trait.friend"))
-                {
-                    for (auto friendship : *friendships)
-                    {
-                        (*trait_friendship_of_class_)[friendship.decl] = friendship.trait;
-                    }
-                }
-            }
-            return *trait_friendship_of_class_;
+            if (fetch_)
+                fetch_bytes(static_cast<size_t>(partition.offset), partition.size_bytes());
         }
 
-    private:
-        void fill_decl_attributes(std::string_view partition)
+        void fetch_bytes(size_t offset, size_t size) const
         {
-            if (auto attributes = try_get_partition<AssociatedTrait<AttrIndex>, Index>(partition))
-            {
-                for (auto attribute : *attributes)
-                {
-                    (*trait_declaration_attributes_)[attribute.decl].push_back(attribute.trait);
-                }
-            }
+            if (!in_blob(offset, size))
+                throw std::runtime_error("corrupted file");
+            fetch_(blob_.subspan(offset, size));
         }
 
-        std::optional<std::unordered_map<DeclIndex, TextOffset>> trait_deprecation_texts_;
-        std::optional<std::unordered_map<DeclIndex, std::vector<AttrIndex>>> trait_declaration_attributes_;
-        std::optional<std::unordered_map<DeclIndex, Sequence>> trait_friendship_of_class_;
-
-        struct UntypedPartition
+        bool in_blob(size_t offset, size_t size) const
         {
-            const void* data;
-            size_t      size;
-        };
-        using CachedPartition = std::optional<UntypedPartition>;
-
-        mutable std::array<CachedPartition, (size_t)FilePartitionCache::Num> cached_partitions_{};
-    };
-
-    FileHeader const& File::header() const
-    {
-        return impl_->header();
-    }
-
-    std::span<PartitionSummary const> File::table_of_contents() const
-    {
-        return impl_->table_of_contents();
-    }
-
-    const char* File::get_string(TextOffset index) const
-    {
-        return impl_->get_string(index);
-    }
-
-    Sequence File::global_scope() const
-    {
-        return scope_descriptors()[header().global_scope];
-    }
-
-    ScopePartition File::scope_descriptors() const
-    {
-        return impl_->get_partition<Sequence, ScopeIndex>("scope.desc");
-    }
-
-    std::byte const* File::get_data_pointer(PartitionSummary const& partition) const
-    {
-        return impl_->get_raw_pointer(partition.offset);
-    }
-
-    // ------------------------------------------------------------------------
-
-    Partition<Declaration, Index> File::declarations() const
-    {
-        return impl_->get_and_cache_partition<Declaration, Index>(FilePartitionCache::Declarations);
-    }
-
-    Partition<ScopeDeclaration, DeclIndex> File::scope_declarations() const
-    {
-        return impl_->get_and_cache_partition<ScopeDeclaration, DeclIndex>(FilePartitionCache::ScopeDeclarations);
-    }
-
-    Partition<TemplateDeclaration, DeclIndex> File::template_declarations() const
-    {
-        return impl_->get_and_cache_partition<TemplateDeclaration, DeclIndex>(FilePartitionCache::TemplateDeclarations);
-    }
-
-    Partition<PartialSpecialization, DeclIndex> File::partial_specializations() const
-    {
-        return impl_->get_and_cache_partition<PartialSpecialization, DeclIndex>(FilePartitionCache::PartialSpecializations);
-    }
+            return offset <= blob_.size() && size <= blob_.size() - offset;
+        }
 
-    Partition<Specialization, DeclIndex> File::specializations() const
-    {
-        return impl_->get_and_cache_partition<Specialization, DeclIndex>(FilePartitionCache::Specializations);
-    }
+        template<typename T, typename Index>
+        Partition<T, Index> get_partition(PartitionSummary const * partition) const
+        {
+            // Entry sizes were checked against the slots when the table of contents was read.
+            assert(static_cast<size_t>(partition->entry_size) >= sizeof(T));
+            fetch(*partition);
+            return { get_pointer<T>(partition->offset), raw_count(partition->cardinality), static_cast<size_t>(partition->entry_size) };
+        }
 
-    Partition<UsingDeclaration, DeclIndex> File::using_declarations() const
-    {
-        return impl_->get_and_cache_partition<UsingDeclaration, DeclIndex>(FilePartitionCache::UsingDeclarations);
-    }
+        File::ResolvedPartition resolve_partition(FilePartitionCache cache_type) const
+        {
+            auto const partition = get_partition_summary(cache_type);
+            fetch(*partition);
+            mark_accessed(cache_type);
+            const File::ResolvedPartition result{ get_raw_pointer(partition->offset), raw_count(partition->cardinality), static_cast<size_t>(partition->entry_size) };
+
+            // Concurrent first accesses may race here, but they all store the same values.
+            auto& cached_partition = cached_partitions_[(size_t)cache_type];
+            cached_partition.size.store(result.size, std::memory_order_relaxed);
+            cached_partition.stride.store(result.stride, std::memory_order_relaxed);
+            cached_partition.data.store(result.data, std::memory_order_release);
+            return result;
+        }
 
-    Partition<Enumeration, DeclIndex> File::enumerations() const
-    {
-        return impl_->get_and_cache_partition<Enumeration, DeclIndex>(FilePartitionCache::Enumerations);
-    }
+        // Checked first so that repeated accesses of a trait partition only read the flag.
+        void mark_accessed(FilePartitionCache cache_type) const
+        {
+            auto & accessed = accessed_[(size_t)cache_type];
+            if (!accessed.load(std::memory_order_relaxed))
+                accessed.store(true, std::memory_order_relaxed);
+        }
 
-    Partition<Enumerator, DeclIndex> File::enumerators() const
-    {
-        return impl_->get_and_cache_partition<Enumerator, DeclIndex>(FilePartitionCache::Enumerators);
-    }
+        std::vector<std::string_view> accessed_partitions() const
+        {
+            std::vector<std::string_view> result;
+            for (auto const & slot : PARTITION_SLOTS)
+            {
+                // Slots are sorted by name, caches sharing a partition are adjacent.
+                if (accessed_[(size_t)slot.cache].load(std::memory_order_relaxed) && (result.empty() || result.back() != slot.name))
+                    result.push_back(slot.name);
+            }
+            return result;
+        }
 
-    Partition<AliasDeclaration, DeclIndex> File::alias_declarations() const
-    {
-        return impl_->get_and_cache_partition<AliasDeclaration, DeclIndex>(FilePartitionCache::AliasDeclarations);
-    }
+        File::CachedPartition* cached_partitions() const
+        {
+            return cached_partitions_.data();
+        }
 
-    Partition<DeclReference, DeclIndex> File::decl_references() const
-    {
-        return impl_->get_and_cache_partition<DeclReference, DeclIndex>(FilePartitionCache::DeclReferences);
-    }
+        File::CachedPartition* user_partitions() const
+        {
+            return user_partitions_.data();
+        }
 
-    Partition<FunctionDeclaration, DeclIndex> File::functions() const
-    {
-        return impl_->get_and_cache_partition<FunctionDeclaration, DeclIndex>(FilePartitionCache::Functions);
-    }
+        void validate(Executor& executor) const
+        {
+            if (validated_.load(std::memory_order_acquire))
+                return;
+            TraceScope trace("validate", "file");
+
+            // Offsets are within the string table if it is terminated.
+            if (!string_table_.empty() && string_table_.back() != '\0')
+                throw std::runtime_error("corrupted file: the string table is not terminated");
+
+            // Bound of the indexes of each sort: the cardinality of its partition (0 if the file lacks it),
+            // the size of the string table for identifiers, no bound for sorts without a partition.
+            using SortLimits = std::array<uint32_t, SyntaxIndex::SortCount>;
+            static_assert(DeclIndex::SortCount <= SyntaxIndex::SortCount && TypeIndex::SortCount <= SyntaxIndex::SortCount
+                && ExprIndex::SortCount <= SyntaxIndex::SortCount);
+            std::array<SortLimits, (size_t)ReferenceKind::Count> limits;
+            for (auto & kind : limits)
+                kind.fill(std::numeric_limits<uint32_t>::max());
+            for (auto const & slot : PARTITION_SLOTS)
+            {
+                if (slot.kind == ReferenceKind::None)
+                    continue;
+                const auto partition = table_of_contents_[(size_t)slot.cache];
+                limits[(size_t)slot.kind][slot.sort] = partition ? static_cast<uint32_t>(raw_count(partition->cardinality)) : 0;
+            }
+            limits[(size_t)ReferenceKind::Name][(size_t)NameSort::Identifier] = static_cast<uint32_t>(string_table_.size());
 
-    Partition<MethodDeclaration, DeclIndex> File::methods() const
-    {
-        return impl_->get_and_cache_partition<MethodDeclaration, DeclIndex>(FilePartitionCache::Methods);
-    }
+            struct Check
+            {
+                FilePartitionCache cache;
+                ReferenceKind kind;
+                uint32_t tag_mask;
+            };
+            static constexpr Check checks[] = {
+                { FilePartitionCache::Declarations,     ReferenceKind::Decl,   DeclIndex::SortCount - 1 },
+                { FilePartitionCache::DeductionGuides,  ReferenceKind::Decl,   DeclIndex::SortCount - 1 },
+                { FilePartitionCache::TypeHeap,         ReferenceKind::Type,   TypeIndex::SortCount - 1 },
+                { FilePartitionCache::ExprHeap,         ReferenceKind::Expr,   ExprIndex::SortCount - 1 },
+                { FilePartitionCache::AttrHeap,         ReferenceKind::Attr,   AttrIndex::SortCount - 1 },
+                { FilePartitionCache::SyntaxHeap,       ReferenceKind::Syntax, SyntaxIndex::SortCount - 1 },
+                { FilePartitionCache::ChartHeap,        ReferenceKind::Chart,  ChartIndex::SortCount - 1 },
+                { FilePartitionCache::FormHeap,         ReferenceKind::Form,   FormIndex::SortCount - 1 },
+                { FilePartitionCache::ScopeDescriptors, ReferenceKind::None,   0 },
+                { FilePartitionCache::ImportedModules,  ReferenceKind::None,   0 },
+                { FilePartitionCache::ExportedModules,  ReferenceKind::None,   0 },
+            };
+
+            // One task per partition, flags rather than exceptions so that the first corrupted one is reported.
+            std::array<bool, std::size(checks)> corrupted{};
+            executor.run(std::size(checks), [&](size_t i) {
+                auto const & check = checks[i];
+                const auto partition = table_of_contents_[(size_t)check.cache];
+                if (!partition)
+                    return;
+                fetch(*partition);
+                const auto data = get_raw_pointer(partition->offset);
+                const auto count = raw_count(partition->cardinality);
+                const auto stride = static_cast<size_t>(partition->entry_size);
+
+                if (check.kind != ReferenceKind::None)
+                {
+                    corrupted[i] = !references_within(data, count, stride, check.tag_mask, limits[(size_t)check.kind]);
+                }
+                else if (check.cache == FilePartitionCache::ScopeDescriptors)
+                {
+                    const auto members = table_of_contents_[(size_t)FilePartitionCache::Declarations];
+                    const uint64_t bound = members ? raw_count(members->cardinality) : 0;
+                    bool outside = false;
+                    for (auto const & scope : Partition<Sequence>(reinterpret_cast<Sequence const*>(data), count, stride))
+                        outside |= static_cast<uint64_t>(scope.start) + raw_count(scope.cardinality) > bound;
+                    corrupted[i] = outside;
+                }
+                else
+                {
+                    const auto bound = string_table_.size();
+                    bool outside = false;
+                    for (auto const & module : Partition<ModuleReference>(reinterpret_cast<ModuleReference const*>(data), count, stride))
+                        outside |= (static_cast<size_t>(module.owner) >= bound) | (static_cast<size_t>(module.partition) >= bound);
+                    corrupted[i] = outside;
+                }
+            });
 
-    Partition<Constructor, DeclIndex> File::constructors() const
-    {
-        return impl_->get_and_cache_partition<Constructor, DeclIndex>(FilePartitionCache::Constructors);
-    }
+            for (size_t i = 0; i != std::size(checks); ++i)
+            {
+                if (corrupted[i])
+                    throw std::runtime_error("corrupted file: partition '" + std::string(partition_name(checks[i].cache)) + "' refers out of bounds");
+            }
+            validated_.store(true, std::memory_order_release);
+        }
 
-    Partition<Destructor, DeclIndex> File::destructors() const
-    {
-        return impl_->get_and_cache_partition<Destructor, DeclIndex>(FilePartitionCache::Destructors);
-    }
+        TraitIndex<AttrIndex> const & trait_declaration_attributes()
+        {
+            return trait_declaration_attributes_.get(timed("trait_declaration_attributes", [this](auto & index) {
+                // ObjectTraits, FunctionTraits or Attributes for a template,
+                // then all other attributes like [[nodiscard]] etc...
+                index = TraitIndex<AttrIndex>({ trait_partition<AttrIndex>(FilePartitionCache::TraitAttributes),
+                                                trait_partition<AttrIndex>(FilePartitionCache::MsvcTraitDeclAttributes) }, resource_);
+            }));
+        }
 
-    Partition<VariableDeclaration, DeclIndex> File::variables() const
-    {
-        return impl_->get_and_cache_partition<VariableDeclaration, DeclIndex>(FilePartitionCache::Variables);
-    }
+        TraitIndex<TextOffset> const & trait_deprecation_texts()
+        {
+            return trait_deprecation_texts_.get(timed("trait_deprecation_texts", [this](auto & index) {
+                index = TraitIndex<TextOffset>({ trait_partition<TextOffset>(FilePartitionCache::TraitDeprecated) }, resource_);
+            }));
+        }
 
-    Partition<ParameterDeclaration, DeclIndex> File::parameters() const
-    {
-        return impl_->get_and_cache_partition<ParameterDeclaration, DeclIndex>(FilePartitionCache::Parameters);
-    }
+        TraitIndex<Sequence> const& trait_friendship_of_class()
+        {
+            return trait_friendship_of_class_.get(timed("trait_friendship_of_class", [this](auto & index) {
+                index = TraitIndex<Sequence>({ trait_partition<Sequence>(FilePartitionCache::TraitFriend) }, resource_);
+            }));
+        }
 
-    Partition<FieldDeclaration, DeclIndex> File::fields() const
-    {
-        return impl_->get_and_cache_partition<FieldDeclaration, DeclIndex>(FilePartitionCache::Fields);
-    }
+        template<typename T>
+        Partition<AssociatedTrait<T>, Index> trait_partition(FilePartitionCache partition) const
+        {
+            return try_get_partition<AssociatedTrait<T>, Index>(partition).value_or(Partition<AssociatedTrait<T>, Index>(nullptr, 0));
+        }
 
-    Partition<FriendDeclaration, DeclIndex> File::friends() const
-    {
-        return impl_->get_and_cache_partition<FriendDeclaration, DeclIndex>(FilePartitionCache::Friends);
-    }
+        std::optional<TextOffset> find_text(std::string_view text)
+        {
+            // Most texts looked up across modules are in few of them, the filter of a side index rejects
+            // them without building the interning table.
+            if (side_index_.loaded && !TextFilter::may_contain(side_index_.text_filter, text))
+                return std::nullopt;
+            auto const & interning = text_interning();
+            if (auto it = interning.symbol_by_text.find(text); it != interning.symbol_by_text.end())
+                return TextOffset{ interning.texts[it->second] };
+            return std::nullopt;
+        }
 
-    Partition<Concept, DeclIndex> File::concepts() const
-    {
-        return impl_->get_and_cache_partition<Concept, DeclIndex>(FilePartitionCache::Concepts);
-    }
+        std::optional<uint32_t> text_symbol(TextOffset offset)
+        {
+            auto const & interning = text_interning();
+            const auto start = std::ranges::lower_bound(interning.starts, static_cast<uint32_t>(offset));
+            if (start == interning.starts.end() || *start != static_cast<uint32_t>(offset))
+                return std::nullopt;
+            return interning.symbols[start - interning.starts.begin()];
+        }
 
-    Partition<IntrinsicDeclaration, DeclIndex> File::intrinsic_declarations() const
-    {
-        return impl_->get_and_cache_partition<IntrinsicDeclaration, DeclIndex>(FilePartitionCache::IntrinsicDeclarations);
-    }
+        TextOffset symbol_text(uint32_t symbol)
+        {
+            return TextOffset{ text_interning().texts[symbol] };
+        }
 
-    // ------------------------------------------------------------------------
+        bool may_contain_text(std::string_view text)
+        {
+            return TextFilter::may_contain(text_filter(), text);
+        }
 
-    Partition<SpecializationForm, SpecFormIndex> File::specialization_forms() const
-    {
-        return impl_->get_and_cache_partition<SpecializationForm, SpecFormIndex>(FilePartitionCache::SpecializationForms);
-    }
+        uint32_t text_symbol_count()
+        {
+            return static_cast<uint32_t>(text_interning().texts.size());
+        }
 
-    // ------------------------------------------------------------------------
+        bool has_partition(std::string_view name) const
+        {
+            const auto slots = std::ranges::equal_range(PARTITION_SLOTS, name, {}, &PartitionSlot::name);
+            return !slots.empty() && table_of_contents_[(size_t)slots.front().cache] != nullptr;
+        }
 
-    Partition<FundamentalType, TypeIndex> File::fundamental_types() const
-    {
-        return impl_->get_and_cache_partition<FundamentalType, TypeIndex>(FilePartitionCache::FundamentalTypes);
-    }
+        bool has_side_index() const
+        {
+            return side_index_.loaded;
+        }
 
-    Partition<DesignatedType, TypeIndex> File::designated_types() const
-    {
-        return impl_->get_and_cache_partition<DesignatedType, TypeIndex>(FilePartitionCache::DesignatedTypes);
-    }
+        std::vector<std::byte> side_index()
+        {
+            auto const ends = string_ends();
+            auto const & interning = text_interning();
+            auto const filter = text_filter();
+
+            const SideIndexHeader side_header{
+                .magic = SideIndexHeader::Magic,
+                .version = SideIndexHeader::CurrentVersion,
+                .blob_size = blob_.size(),
+                .checksum = header().checksum,
+                .string_ends = static_cast<uint32_t>(ends.size()),
+                .strings = static_cast<uint32_t>(interning.starts.size()),
+                .texts = static_cast<uint32_t>(interning.texts.size()),
+                .text_filter = static_cast<uint32_t>(filter.size()),
+            };
+
+            std::vector<std::byte> result;
+            auto append = [&result](std::span<std::byte const> bytes) {
+                result.insert(result.end(), bytes.begin(), bytes.end());
+            };
+            append(std::as_bytes(std::span(&side_header, 1)));
+            append(std::as_bytes(ends));
+            append(std::as_bytes(interning.starts));
+            append(std::as_bytes(interning.symbols));
+            append(std::as_bytes(interning.texts));
+            append(std::as_bytes(filter));
+            return result;
+        }
 
-    Partition<TorType, TypeIndex> File::tor_types() const
-    {
-        return impl_->get_and_cache_partition<TorType, TypeIndex>(FilePartitionCache::TorTypes);
-    }
+        void const* get_or_build_index(File const& file, size_t id, IndexBuilder build, IndexHeapBytes heap_bytes,
+                                       IndexPartitions partitions, const char* name)
+        {
+            auto & index = indexes_[id];
+            std::call_once(index.once, timed(name, [&] {
+                check_cancellation();
+                index.value = build(file);
+                index.heap_bytes = heap_bytes;
+                index.partitions = partitions;
+                index.name = name;
+                index.built.store(true, std::memory_order_release);
+            }));
+            mark_used(index.used);
+            return index.value.get();
+        }
 
-    Partition<SyntacticType, TypeIndex> File::syntactic_types() const
-    {
-        return impl_->get_and_cache_partition<SyntacticType, TypeIndex>(FilePartitionCache::SyntacticTypes);
-    }
+        size_t adopt_indexes(Impl const& previous, FileDiff const& diff)
+        {
+            if (previous.arena_ || diff.strings_changed)
+                return 0;
+
+            size_t adopted = 0;
+            previous.indexes_.for_each([&](size_t id, CachedIndex const& old_index) {
+                if (!old_index.built.load(std::memory_order_acquire) || !old_index.partitions.declared)
+                    return;
+                if (std::ranges::any_of(old_index.partitions.names, [&diff](std::string_view name) { return diff.changed(name); }))
+                    return;
+
+                auto & index = indexes_[id];
+                std::call_once(index.once, [&] {
+                    index.value = old_index.value;
+                    index.heap_bytes = old_index.heap_bytes;
+                    index.partitions = old_index.partitions;
+                    index.name = old_index.name;
+                    index.built.store(true, std::memory_order_release);
+                    ++adopted;
+                });
+            });
+            return adopted;
+        }
 
-    Partition<ExpansionType, TypeIndex> File::expansion_types() const
-    {
-        return impl_->get_and_cache_partition<ExpansionType, TypeIndex>(FilePartitionCache::ExpansionTypes);
-    }
+        size_t trim(TrimLevel level)
+        {
+            // Nothing is returned to the resource before the arena is released.
+            if (arena_)
+                return 0;
+
+            const auto before = memory_usage().heap_bytes();
+            const bool cold_only = level == TrimLevel::Cold;
+            indexes_.for_each([cold_only](size_t, CachedIndex& index) {
+                if (!index.built.load(std::memory_order_acquire) || !take_cold(index.used, cold_only))
+                    return;
+                reset_once(index.once);
+                index.built.store(false, std::memory_order_relaxed);
+                index.value.reset();
+            });
+            trait_deprecation_texts_.trim(cold_only);
+            trait_declaration_attributes_.trim(cold_only);
+            trait_friendship_of_class_.trim(cold_only);
+            if (level == TrimLevel::All)
+            {
+                string_ends_.trim(false);
+                text_interning_.trim(false);
+                text_filter_.trim(false);
+            }
+            return before - memory_usage().heap_bytes();
+        }
 
-    Partition<PointerType, TypeIndex> File::pointer_types() const
-    {
-        return impl_->get_and_cache_partition<PointerType, TypeIndex>(FilePartitionCache::PointerTypes);
-    }
+#ifdef IFC_FILE_STATS
+        void record_first_access(FilePartitionCache cache)
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - stats_.created;
+            std::scoped_lock lock(stats_.mutex);
+            stats_.first_accesses.push_back({ cache, elapsed });
+        }
+#endif
 
-    Partition<FunctionType, TypeIndex> File::function_types() const
-    {
-        return impl_->get_and_cache_partition<FunctionType, TypeIndex>(FilePartitionCache::FunctionTypes);
-    }
+        FileStats stats() const
+        {
+            FileStats result;
+#ifdef IFC_FILE_STATS
+            result.enabled = true;
+            std::scoped_lock lock(stats_.mutex);
+            for (auto const & [cache, elapsed] : stats_.first_accesses)
+                result.partitions.push_back({
+                    partition_name(cache),
+                    cached_partitions_[(size_t)cache].accesses.load(std::memory_order_relaxed),
+                    elapsed });
+            result.builds = stats_.builds;
+#endif
+            return result;
+        }
 
-    Partition<MethodType, TypeIndex> File::method_types() const
-    {
-        return impl_->get_and_cache_partition<MethodType, TypeIndex>(FilePartitionCache::MethodTypes);
-    }
+        std::pmr::memory_resource* memory_resource() const
+        {
+            return resource_;
+        }
 
-    Partition<ArrayType, TypeIndex> File::array_types() const
-    {
-        return impl_->get_and_cache_partition<ArrayType, TypeIndex>(FilePartitionCache::ArrayTypes);
-    }
+        FileMemoryUsage memory_usage() const
+        {
+            FileMemoryUsage result;
+            result.mapped_bytes = blob_.size();
+            result.resident_bytes = resident_bytes(blob_);
+
+            if (auto ends = string_ends_.peek())
+                result.heap.push_back({ "string_ends", heap_bytes(*ends) });
+            if (auto interning = text_interning_.peek())
+                result.heap.push_back({ "text_interning", heap_bytes(interning->symbol_by_text) + heap_bytes(interning->owned_starts)
+                                                          + heap_bytes(interning->owned_symbols) + heap_bytes(interning->owned_texts) });
+            if (auto filter = text_filter_.peek())
+                result.heap.push_back({ "text_filter", heap_bytes(*filter) });
+            if (auto index = trait_deprecation_texts_.peek())
+                result.heap.push_back({ "trait_deprecation_texts", index->heap_bytes() });
+            if (auto index = trait_declaration_attributes_.peek())
+                result.heap.push_back({ "trait_declaration_attributes", index->heap_bytes() });
+            if (auto index = trait_friendship_of_class_.peek())
+                result.heap.push_back({ "trait_friendship_of_class", index->heap_bytes() });
+
+            indexes_.for_each([&result](size_t, CachedIndex const& index) {
+                if (index.built.load(std::memory_order_acquire))
+                    result.heap.push_back({ index.name, index.heap_bytes(index.value.get()) });
+            });
+            return result;
+        }
 
-    Partition<BaseType, TypeIndex> File::base_types() const
-    {
-        return impl_->get_and_cache_partition<BaseType, TypeIndex>(FilePartitionCache::BaseTypes);
-    }
+    private:
+        // Dense symbol ids for the strings of the string table: equal strings get equal ids.
+        // The arrays either view a side index or the owned vectors.
+        struct TextInterning
+        {
+            std::span<uint32_t const> starts;   // offsets of all strings, in increasing order
+            std::span<uint32_t const> symbols;  // symbol of the string at `starts[i]`
+            std::span<uint32_t const> texts;    // offset of the first string with the given symbol
+            std::pmr::unordered_map<std::string_view, uint32_t> symbol_by_text;
+
+            std::pmr::vector<uint32_t> owned_starts, owned_symbols, owned_texts;
+
+            explicit TextInterning(std::pmr::memory_resource* resource)
+                : symbol_by_text(resource)
+                , owned_starts(resource)
+                , owned_symbols(resource)
+                , owned_texts(resource)
+            {
+            }
+        };
 
-    Partition<TupleType, TypeIndex> File::tuple_types() const
-    {
-        return impl_->get_and_cache_partition<TupleType, TypeIndex>(FilePartitionCache::TupleTypes);
-    }
+        TextInterning const & text_interning()
+        {
+            return text_interning_.get(timed("text_interning", [this](TextInterning & interning) {
+                const char* table = get_string(TextOffset{0});
+                if (side_index_.loaded)
+                {
+                    // Only the map is rebuilt, from the distinct texts.
+                    interning.starts = side_index_.starts;
+                    interning.symbols = side_index_.symbols;
+                    interning.texts = side_index_.texts;
+                    interning.symbol_by_text.reserve(interning.texts.size());
+                    for (uint32_t symbol = 0; symbol != interning.texts.size(); ++symbol)
+                        interning.symbol_by_text.emplace(table + interning.texts[symbol], symbol);
+                    return;
+                }
 
-    Partition<LvalueReference, TypeIndex> File::lvalue_references() const
-    {
-        return impl_->get_and_cache_partition<LvalueReference, TypeIndex>(FilePartitionCache::LvalueReferences);
-    }
+                uint32_t start = 0;
+                for (auto end : string_ends())
+                {
+                    const auto [it, inserted] = interning.symbol_by_text.try_emplace(
+                        std::string_view(table + start, end - start), static_cast<uint32_t>(interning.owned_texts.size()));
+                    if (inserted)
+                        interning.owned_texts.push_back(start);
+                    interning.owned_starts.push_back(start);
+                    interning.owned_symbols.push_back(it->second);
+                    start = end + 1;
+                }
+                interning.starts = interning.owned_starts;
+                interning.symbols = interning.owned_symbols;
+                interning.texts = interning.owned_texts;
+            }));
+        }
 
-    Partition<RvalueReference, TypeIndex> File::rvalue_references() const
-    {
-        return impl_->get_and_cache_partition<RvalueReference, TypeIndex>(FilePartitionCache::RvalueReferences);
-    }
+        std::span<uint32_t const> text_filter()
+        {
+            if (side_index_.loaded)
+                return side_index_.text_filter;
+
+            return text_filter_.get(timed("text_filter", [this](auto & words) {
+                auto const & interning = text_interning();
+                const char* table = get_string(TextOffset{0});
+                words.resize(TextFilter::word_count(interning.texts.size()));
+                for (auto text : interning.texts)
+                    TextFilter::add(words, table + text);
+            }));
+        }
 
-    Partition<QualifiedType, TypeIndex> File::qualified_types() const
-    {
-        return impl_->get_and_cache_partition<QualifiedType, TypeIndex>(FilePartitionCache::QualifiedTypes);
-    }
+        // Offsets of all terminating zeros in the string table, in increasing order.
+        std::span<uint32_t const> string_ends()
+        {
+            if (side_index_.loaded)
+                return side_index_.string_ends;
 
-    Partition<ForallType, TypeIndex> File::forall_types() const
-    {
-        return impl_->get_and_cache_partition<ForallType, TypeIndex>(FilePartitionCache::ForallTypes);
-    }
+            return string_ends_.get(timed("string_ends", [this](auto & ends) {
+                const char* table = string_table_.data();
+                const size_t size = string_table_.size();
+                for (const char* p = table; p < table + size; ++p)
+                {
+                    p = static_cast<const char*>(std::memchr(p, '\0', table + size - p));
+                    if (!p)
+                        break;
+                    ends.push_back(static_cast<uint32_t>(p - table));
+                }
+            }));
+        }
 
-    Partition<SyntaxType, TypeIndex> File::syntax_types() const
-    {
-        return impl_->get_and_cache_partition<SyntaxType, TypeIndex>(FilePartitionCache::SyntaxTypes);
-    }
+        // A side index written for a different (version of the) file is ignored, as is one with offsets out of
+        // the string table.
+        void load_side_index(std::span<std::byte const> side_index)
+        {
+            SideIndexHeader side_header;
+            if (side_index.size() < sizeof(side_header) || reinterpret_cast<uintptr_t>(side_index.data()) % alignof(uint32_t) != 0)
+                return;
+            std::memcpy(&side_header, side_index.data(), sizeof(side_header));
+
+            if (side_header.magic != SideIndexHeader::Magic
+                || side_header.version != SideIndexHeader::CurrentVersion
+                || side_header.blob_size != blob_.size()
+                || side_header.checksum.data != header().checksum.data)
+                return;
+
+            if (side_header.text_filter != TextFilter::word_count(side_header.texts))
+                return;
+
+            const size_t counts[] = { side_header.string_ends, side_header.strings, side_header.strings, side_header.texts, side_header.text_filter };
+            if (side_index.size() != sizeof(side_header) + std::accumulate(std::begin(counts), std::end(counts), size_t{ 0 }) * sizeof(uint32_t))
+                return;
+
+            auto array = reinterpret_cast<uint32_t const*>(side_index.data() + sizeof(side_header));
+            auto next = [&array](size_t count) {
+                const std::span<uint32_t const> result(array, count);
+                array += count;
+                return result;
+            };
+            const auto string_ends = next(side_header.string_ends);
+            const auto starts = next(side_header.strings);
+            const auto symbols = next(side_header.strings);
+            const auto texts = next(side_header.texts);
+
+            // Offsets are searched and read through without checks, those out of the string table (e.g. of a side
+            // index written over in shared memory) would read past it.
+            const auto bound = string_table_.size();
+            const auto below = [](std::span<uint32_t const> values, size_t bound) {
+                return std::ranges::all_of(values, [bound](uint32_t value) { return value < bound; });
+            };
+            if (!std::ranges::is_sorted(string_ends) || !std::ranges::is_sorted(starts)
+                || (string_ends.empty() ? bound != 0 : string_ends.back() != bound - 1)
+                || !below(starts, bound) || !below(texts, bound) || !below(symbols, texts.size()))
+                return;
+
+            side_index_.string_ends = string_ends;
+            side_index_.starts = starts;
+            side_index_.symbols = symbols;
+            side_index_.texts = texts;
+            side_index_.text_filter = next(side_header.text_filter);
+            side_index_.loaded = true;
+        }
 
-    Partition<PlaceholderType, TypeIndex> File::placeholder_types() const
-    {
-        return impl_->get_and_cache_partition<PlaceholderType, TypeIndex>(FilePartitionCache::PlaceholderTypes);
-    }
+        // Value built on first use. Safe for concurrent first use;
+        // once built, access is a single check of the once_flag.
+        template<typename T>
+        class Lazy
+        {
+        public:
+            explicit Lazy(std::pmr::memory_resource* resource)
+                : resource_(resource)
+                , value_(resource)
+            {
+            }
 
-    Partition<TypenameType, TypeIndex> File::typename_types() const
-    {
-        return impl_->get_and_cache_partition<TypenameType, TypeIndex>(FilePartitionCache::TypenameTypes);
-    }
+            T const & get(auto init)
+            {
+                std::call_once(once_, [&] {
+                    init(value_);
+                    built_.store(true, std::memory_order_release);
+                });
+                mark_used(used_);
+                return value_;
+            }
 
-    Partition<DecltypeType, TypeIndex> File::decltype_types() const
-    {
-        return impl_->get_and_cache_partition<DecltypeType, TypeIndex>(FilePartitionCache::DecltypeTypes);
-    }
+            // The value if it has been built, without building it.
+            T const * peek() const
+            {
+                return built_.load(std::memory_order_acquire) ? &value_ : nullptr;
+            }
 
-    // ------------------------------------------------------------------------
+            // Drops the value (see File::trim), to be built again on next use. Returns whether it was dropped.
+            bool trim(bool cold_only)
+            {
+                if (!built_.load(std::memory_order_acquire) || !take_cold(used_, cold_only))
+                    return false;
+                reset_once(once_);
+                built_.store(false, std::memory_order_relaxed);
+                value_ = T(resource_);
+                return true;
+            }
 
-    Partition<AttrBasic, AttrIndex> File::basic_attributes() const
-    {
-        return impl_->get_and_cache_partition<AttrBasic, AttrIndex>(FilePartitionCache::BasicAttributes);
-    }
+        private:
+            std::pmr::memory_resource* resource_;
+            std::once_flag once_;
+            std::atomic<bool> built_ = false;
+            std::atomic<bool> used_ = false; // Since the previous trim
+            T value_;
+        };
 
-    Partition<AttrScoped, AttrIndex> File::scoped_attributes() const
-    {
-        return impl_->get_and_cache_partition<AttrScoped, AttrIndex>(FilePartitionCache::ScopedAttributes);
-    }
+        // Use since the previous trim, only written when it changes so that hot lookups do not write.
+        static void mark_used(std::atomic<bool> & used)
+        {
+            if (!used.load(std::memory_order_relaxed))
+                used.store(true, std::memory_order_relaxed);
+        }
 
-    Partition<AttrLabeled, AttrIndex> File::labeled_attributes() const
-    {
-        return impl_->get_and_cache_partition<AttrLabeled, AttrIndex>(FilePartitionCache::LabeledAttributes);
-    }
+        // Whether state is to be trimmed: anything but `cold_only`, which gives state used since the previous
+        // trim a second chance, clearing its use.
+        static bool take_cold(std::atomic<bool> & used, bool cold_only)
+        {
+            const bool was_used = used.exchange(false, std::memory_order_relaxed);
+            return !cold_only || !was_used;
+        }
 
-    Partition<AttrCalled, AttrIndex> File::called_attributes() const
-    {
-        return impl_->get_and_cache_partition<AttrCalled, AttrIndex>(FilePartitionCache::CalledAttributes);
-    }
+        // A once_flag cannot be reset, it is constructed again: trims run while nothing else uses the File.
+        static void reset_once(std::once_flag & once)
+        {
+            std::destroy_at(&once);
+            std::construct_at(&once);
+        }
 
-    Partition<AttrExpanded, AttrIndex> File::expanded_attributes() const
-    {
-        return impl_->get_and_cache_partition<AttrExpanded, AttrIndex>(FilePartitionCache::ExpandedAttributes);
-    }
+        // `heap_bytes` and `name` are set along with `value`, and valid once `built` is.
+        struct CachedIndex
+        {
+            std::once_flag once;
+            std::shared_ptr<void const> value;
+            File::IndexHeapBytes heap_bytes = nullptr;
+            File::IndexPartitions partitions;
+            const char* name = nullptr;
+            std::atomic<bool> built = false;
+            std::atomic<bool> used = false; // Since the previous trim
+        };
 
-    Partition<AttrFactored, AttrIndex> File::factored_attributes() const
-    {
-        return impl_->get_and_cache_partition<AttrFactored, AttrIndex>(FilePartitionCache::FactoredAttributes);
-    }
+        // Slots of the indexes of get_index by id. Ids are given out per index type (and per instantiation of
+        // templates of indexes) for the whole program, so the slots are allocated on first use, in segments of
+        // doubling sizes that never move: a slot is a segment lookup and a once-flag check away.
+        class IndexSlots
+        {
+        public:
+            CachedIndex& operator[](size_t id)
+            {
+                const auto [segment, offset] = locate(id);
+                auto & slots = segments_[segment];
+                std::call_once(slots.once, [&] {
+                    slots.indexes = std::make_unique<CachedIndex[]>(FirstSegmentSize << segment);
+                    slots.allocated.store(true, std::memory_order_release);
+                });
+                return slots.indexes[offset];
+            }
 
-    Partition<AttrElaborated, AttrIndex> File::elaborated_attributes() const
-    {
-        return impl_->get_and_cache_partition<AttrElaborated, AttrIndex>(FilePartitionCache::ElaboratedAttributes);
-    }
+            // Calls `f(id, index)` on the slots of the allocated segments.
+            template<typename F>
+            void for_each(F f) const
+            {
+                for (size_t segment = 0; segment != SegmentCount; ++segment)
+                {
+                    auto const & slots = segments_[segment];
+                    if (!slots.allocated.load(std::memory_order_acquire))
+                        continue;
+                    const auto first = FirstSegmentSize * ((size_t{ 1 } << segment) - 1);
+                    for (size_t offset = 0; offset != FirstSegmentSize << segment; ++offset)
+                        f(first + offset, slots.indexes[offset]);
+                }
+            }
 
-    Partition<AttrTuple, AttrIndex> File::tuple_attributes() const
-    {
-        return impl_->get_and_cache_partition<AttrTuple, AttrIndex>(FilePartitionCache::TupleAttributes);
-    }
+        private:
+            static constexpr size_t FirstSegmentSize = 64;
+            static constexpr size_t SegmentCount = 32;
 
-    // ------------------------------------------------------------------------
+            // Segment k holds the ids from FirstSegmentSize * (2^k - 1), FirstSegmentSize * 2^k of them.
+            static std::pair<size_t, size_t> locate(size_t id)
+            {
+                const auto segment = static_cast<size_t>(std::bit_width(id / FirstSegmentSize + 1)) - 1;
+                return { segment, id - FirstSegmentSize * ((size_t{ 1 } << segment) - 1) };
+            }
 
-    Partition<LiteralExpression, ExprIndex> File::literal_expressions() const
-    {
-        return impl_->get_and_cache_partition<LiteralExpression, ExprIndex>(FilePartitionCache::LiteralExpressions);
-    }
+            struct Segment
+            {
+                std::once_flag once;
+                std::atomic<bool> allocated = false;
+                std::unique_ptr<CachedIndex[]> indexes;
+            };
 
-    Partition<TypeExpression, ExprIndex> File::type_expressions() const
-    {
-        return impl_->get_and_cache_partition<TypeExpression, ExprIndex>(FilePartitionCache::TypeExpressions);
-    }
+            std::array<Segment, SegmentCount> segments_;
+        };
 
-    Partition<NamedDecl, ExprIndex> File::decl_expressions() const
-    {
-        return impl_->get_and_cache_partition<NamedDecl, ExprIndex>(FilePartitionCache::DeclExpressions);
-    }
+        // Declared before everything allocated from it.
+        std::unique_ptr<FileArena> arena_;
+        std::pmr::memory_resource* resource_;
 
-    Partition<UnqualifiedId, ExprIndex> File::unqualified_id_expressions() const
-    {
-        return impl_->get_and_cache_partition<UnqualifiedId, ExprIndex>(FilePartitionCache::UnqualifiedIdExpressions);
-    }
+        IndexSlots indexes_;
 
-    Partition<TemplateId, ExprIndex> File::template_ids() const
-    {
-        return impl_->get_and_cache_partition<TemplateId, ExprIndex>(FilePartitionCache::TemplateIds);
-    }
+        struct SideIndex
+        {
+            bool loaded = false;
+            std::span<uint32_t const> string_ends, starts, symbols, texts, text_filter;
+        };
 
-    Partition<TemplateReference, ExprIndex> File::template_references() const
-    {
-        return impl_->get_and_cache_partition<TemplateReference, ExprIndex>(FilePartitionCache::TemplateReferences);
-    }
+        bool index_string_lengths_;
+        std::function<void(BlobView)> fetch_;
+        std::span<char const> string_table_;
+        SideIndex side_index_;
+        Lazy<std::pmr::vector<uint32_t>> string_ends_;
+        Lazy<TextInterning> text_interning_;
+        Lazy<std::pmr::vector<uint32_t>> text_filter_;
+
+        Lazy<TraitIndex<TextOffset>> trait_deprecation_texts_;
+        Lazy<TraitIndex<AttrIndex>> trait_declaration_attributes_;
+        Lazy<TraitIndex<Sequence>> trait_friendship_of_class_;
+
+        mutable std::array<File::CachedPartition, (size_t)FilePartitionCache::Num> cached_partitions_{};
+        mutable std::array<File::CachedPartition, File::MaxUserPartitions> user_partitions_{};
+        mutable std::atomic<bool> validated_ = false;
+        std::shared_future<void> validation_; // See FileOptions::validate_in_background
+        mutable std::array<std::atomic<bool>, (size_t)FilePartitionCache::Num> accessed_{}; // See mark_accessed
+
+#ifdef IFC_FILE_STATS
+        struct Stats
+        {
+            std::chrono::steady_clock::time_point created = std::chrono::steady_clock::now();
+            mutable std::mutex mutex;
+            std::vector<std::pair<FilePartitionCache, std::chrono::nanoseconds>> first_accesses;
+            std::vector<FileStats::Build> builds;
+        };
+        Stats stats_;
+#endif
+    };
 
-    Partition<MonadExpression, ExprIndex> File::monad_expressions() const
+    FileHeader const& File::header() const
     {
-        return impl_->get_and_cache_partition<MonadExpression, ExprIndex>(FilePartitionCache::MonadExpressions);
+        return impl_->header();
     }
 
-    Partition<DyadExpression, ExprIndex> File::dyad_expressions() const
+    File::BlobView File::blob() const
     {
-        return impl_->get_and_cache_partition<DyadExpression, ExprIndex>(FilePartitionCache::DyadExpressions);
+        return impl_->blob();
     }
 
-    Partition<StringExpression, ExprIndex> File::string_expressions() const
+    std::span<char const> File::string_table() const
     {
-        return impl_->get_and_cache_partition<StringExpression, ExprIndex>(FilePartitionCache::StringExpressions);
+        return impl_->string_table();
     }
 
-    Partition<CallExpression, ExprIndex> File::call_expressions() const
+    std::vector<File::BlobView> File::partitions_data(std::string_view name_prefix) const
     {
-        return impl_->get_and_cache_partition<CallExpression, ExprIndex>(FilePartitionCache::CallExpressions);
+        std::vector<BlobView> result;
+        for (auto const & partition : table_of_contents())
+        {
+            if (std::string_view(get_string(partition.name)).starts_with(name_prefix))
+            {
+                impl_->fetch(partition);
+                result.push_back(blob().subspan(static_cast<size_t>(partition.offset), partition.size_bytes()));
+            }
+        }
+        return result;
     }
 
-    Partition<SizeofExpression, ExprIndex> File::sizeof_expressions() const
+    bool File::has_partition(std::string_view name) const
     {
-        return impl_->get_and_cache_partition<SizeofExpression, ExprIndex>(FilePartitionCache::SizeofExpressions);
+        return impl_->has_partition(name);
     }
 
-    Partition<AlignofExpression, ExprIndex> File::alignof_expressions() const
+    bool File::has_side_index() const
     {
-        return impl_->get_and_cache_partition<AlignofExpression, ExprIndex>(FilePartitionCache::AlignofExpressions);
+        return impl_->has_side_index();
     }
 
-    Partition<RequiresExpression, ExprIndex> File::requires_expressions() const
+    std::vector<std::byte> File::side_index() const
     {
-        return impl_->get_and_cache_partition<RequiresExpression, ExprIndex>(FilePartitionCache::RequiresExpressions);
+        return impl_->side_index();
     }
 
-    Partition<TupleExpression, ExprIndex> File::tuple_expressions() const
+    std::span<PartitionSummary const> File::table_of_contents() const
     {
-        return impl_->get_and_cache_partition<TupleExpression, ExprIndex>(FilePartitionCache::TupleExpressions);
+        return impl_->table_of_contents();
     }
 
-    Partition<PathExpression, ExprIndex> File::path_expressions() const
+    const char* File::get_string(TextOffset index) const
     {
-        return impl_->get_and_cache_partition<PathExpression, ExprIndex>(FilePartitionCache::PathExpressions);
+        return impl_->get_string(index);
     }
 
-    Partition<ReadExpression, ExprIndex> File::read_expressions() const
+    std::string_view File::get_string_view(TextOffset index) const
     {
-        return impl_->get_and_cache_partition<ReadExpression, ExprIndex>(FilePartitionCache::ReadExpressions);
+        return impl_->get_string_view(index);
     }
 
-    Partition<SyntaxTreeExpression, ExprIndex> File::syntax_tree_expressions() const
+    std::optional<TextOffset> File::find_text(std::string_view text) const
     {
-        return impl_->get_and_cache_partition<SyntaxTreeExpression, ExprIndex>(FilePartitionCache::SyntaxTreeExpressions);
+        return impl_->find_text(text);
     }
 
-    // ------------------------------------------------------------------------
-
-    Partition<ExpressionListExpression, ExprIndex> File::expression_lists() const
+    std::optional<uint32_t> File::text_symbol(TextOffset offset) const
     {
-        return impl_->get_and_cache_partition<ExpressionListExpression, ExprIndex>(FilePartitionCache::ExpressionLists);
+        return impl_->text_symbol(offset);
     }
 
-    Partition<QualifiedNameExpression, ExprIndex> File::qualified_name_expressions() const
+    TextOffset File::symbol_text(uint32_t symbol) const
     {
-        return impl_->get_and_cache_partition<QualifiedNameExpression, ExprIndex>(FilePartitionCache::QualifiedNameExpressions);
+        return impl_->symbol_text(symbol);
     }
 
-    Partition<PackedTemplateArguments, ExprIndex> File::packed_template_arguments() const
+    bool File::may_contain_text(std::string_view text) const
     {
-        return impl_->get_and_cache_partition<PackedTemplateArguments, ExprIndex>(FilePartitionCache::PackedTemplateArguments);
+        return impl_->may_contain_text(text);
     }
 
-    Partition<ProductValueTypeExpression, ExprIndex> File::product_value_type_expressions() const
+    uint32_t File::text_symbol_count() const
     {
-        return impl_->get_and_cache_partition<ProductValueTypeExpression, ExprIndex>(FilePartitionCache::ProductValueTypeExpressions);
+        return impl_->text_symbol_count();
     }
 
-    Partition<SubobjectValueExpression, ExprIndex> File::suboject_value_expressions() const
+    Sequence File::global_scope() const
     {
-        return impl_->get_and_cache_partition<SubobjectValueExpression, ExprIndex>(FilePartitionCache::SubojectValueExpressions);
+        return scope_descriptors()[header().global_scope];
     }
 
-    // ------------------------------------------------------------------------
-
-    Partition<StringLiteral, StringIndex> File::string_literal_expressions() const
+    std::byte const* File::get_data_pointer(PartitionSummary const& partition) const
     {
-        return impl_->get_and_cache_partition<StringLiteral, StringIndex>(FilePartitionCache::StringLiteralExpressions);
+        impl_->fetch(partition);
+        return impl_->get_raw_pointer(partition.offset);
     }
 
     // ------------------------------------------------------------------------
 
-    Partition<ChartUnilevel, ChartIndex> File::unilevel_charts() const
-    {
-        return impl_->get_and_cache_partition<ChartUnilevel, ChartIndex>(FilePartitionCache::UnilevelCharts);
-    }
-
-    Partition<ChartMultilevel, ChartIndex> File::multilevel_charts() const
-    {
-        return impl_->get_and_cache_partition<ChartMultilevel, ChartIndex>(FilePartitionCache::MultilevelCharts);
-    }
-
-    Partition<IntegerLiteral, LitIndex> File::integer_literals() const
+    Partition<ModuleReference, Index> File::imported_modules() const
     {
-        return impl_->get_and_cache_partition<IntegerLiteral, LitIndex>(FilePartitionCache::IntegerLiterals);
+        // Absent in modules without any.
+        if (auto modules = impl_->try_get_partition<ModuleReference, Index>(FilePartitionCache::ImportedModules))
+            return *modules;
+        return { nullptr, 0 };
     }
 
-    Partition<FPLiteral, LitIndex> File::fp_literals() const
+    Partition<ModuleReference, Index> File::exported_modules() const
     {
-        return impl_->get_and_cache_partition<FPLiteral, LitIndex>(FilePartitionCache::FpLiterals);
+        // Absent in modules without any.
+        if (auto modules = impl_->try_get_partition<ModuleReference, Index>(FilePartitionCache::ExportedModules))
+            return *modules;
+        return { nullptr, 0 };
     }
 
     // ------------------------------------------------------------------------
 
-    Partition<SimpleTypeSpecifier, SyntaxIndex> File::simple_type_specifiers() const
-    {
-        return impl_->get_and_cache_partition<SimpleTypeSpecifier, SyntaxIndex>(FilePartitionCache::SimpleTypeSpecifiers);
-    }
-
-    Partition<DecltypeSpecifier, SyntaxIndex> File::decltype_specifiers() const
+    TextOffset File::trait_deprecation_texts(DeclIndex declaration) const
     {
-        return impl_->get_and_cache_partition<DecltypeSpecifier, SyntaxIndex>(FilePartitionCache::DecltypeSpecifiers);
+        return impl_->trait_deprecation_texts().find_last(declaration);
     }
 
-    Partition<TypeSpecifierSeq, SyntaxIndex> File::type_specifier_seq_syntax_trees() const
+    std::span<AttrIndex const> File::trait_declaration_attributes(DeclIndex declaration) const
     {
-        return impl_->get_and_cache_partition<TypeSpecifierSeq, SyntaxIndex>(FilePartitionCache::TypeSpecifierSeqSyntaxTrees);
+        return impl_->trait_declaration_attributes().find(declaration);
     }
 
-    Partition<DeclSpecifierSeq, SyntaxIndex> File::decl_specifier_seq_syntax_trees() const
+    Partition<AssociatedTrait<AttrIndex>, Index> File::attribute_traits() const
     {
-        return impl_->get_and_cache_partition<DeclSpecifierSeq, SyntaxIndex>(FilePartitionCache::DeclSpecifierSeqSyntaxTrees);
+        return impl_->try_get_partition<AssociatedTrait<AttrIndex>, Index>(FilePartitionCache::TraitAttributes)
+            .value_or(Partition<AssociatedTrait<AttrIndex>, Index>(nullptr, 0));
     }
 
-    Partition<TypeIdSyntax, SyntaxIndex> File::typeid_syntax_trees() const
+    Partition<AssociatedTrait<AttrIndex>, Index> File::msvc_declaration_attribute_traits() const
     {
-        return impl_->get_and_cache_partition<TypeIdSyntax, SyntaxIndex>(FilePartitionCache::TypeidSyntaxTrees);
+        return impl_->try_get_partition<AssociatedTrait<AttrIndex>, Index>(FilePartitionCache::MsvcTraitDeclAttributes)
+            .value_or(Partition<AssociatedTrait<AttrIndex>, Index>(nullptr, 0));
     }
 
-    Partition<DeclaratorSyntax, SyntaxIndex> File::declarator_syntax_trees() const
+    Partition<AssociatedTrait<Sequence>, Index> File::friendship_traits() const
     {
-        return impl_->get_and_cache_partition<DeclaratorSyntax, SyntaxIndex>(FilePartitionCache::DeclaratorSyntaxTrees);
+        return impl_->try_get_partition<AssociatedTrait<Sequence>, Index>(FilePartitionCache::TraitFriend)
+            .value_or(Partition<AssociatedTrait<Sequence>, Index>(nullptr, 0));
     }
 
-    Partition<PointerDeclaratorSyntax, SyntaxIndex> File::pointer_declarator_syntax_trees() const
+    Partition<AssociatedTrait<TextOffset>, Index> File::deprecation_traits() const
     {
-        return impl_->get_and_cache_partition<PointerDeclaratorSyntax, SyntaxIndex>(FilePartitionCache::PointerDeclaratorSyntaxTrees);
+        return impl_->try_get_partition<AssociatedTrait<TextOffset>, Index>(FilePartitionCache::TraitDeprecated)
+            .value_or(Partition<AssociatedTrait<TextOffset>, Index>(nullptr, 0));
     }
 
-    Partition<FunctionDeclaratorSyntax, SyntaxIndex> File::function_declarator_syntax_trees() const
+    Sequence File::trait_friendship_of_class(DeclIndex declaration) const
     {
-        return impl_->get_and_cache_partition<FunctionDeclaratorSyntax, SyntaxIndex>(FilePartitionCache::FunctionDeclaratorSyntaxTrees);
+        return impl_->trait_friendship_of_class().find_last(declaration);
     }
 
-    Partition<ParameterDeclaratorSyntax, SyntaxIndex> File::parameter_declarator_syntax_trees() const
+    size_t File::allocate_index_id()
     {
-        return impl_->get_and_cache_partition<ParameterDeclaratorSyntax, SyntaxIndex>(FilePartitionCache::ParameterDeclaratorSyntaxTrees);
+        static std::atomic<size_t> next_id = 0;
+        return next_id++;
     }
 
-    Partition<ExpressionSyntax, SyntaxIndex> File::expression_syntax_trees() const
+    size_t File::allocate_partition_slot()
     {
-        return impl_->get_and_cache_partition<ExpressionSyntax, SyntaxIndex>(FilePartitionCache::ExpressionSyntaxTrees);
+        static std::atomic<size_t> next_slot = 0;
+        const auto slot = next_slot++;
+        if (slot >= MaxUserPartitions)
+            throw std::length_error("too many user partition types");
+        return slot;
     }
 
-    Partition<RequiresClauseSyntax, SyntaxIndex> File::requires_clause_syntax_trees() const
+    void const* File::get_or_build_index(size_t id, IndexBuilder build, IndexHeapBytes heap_bytes, IndexPartitions partitions, const char* name) const
     {
-        return impl_->get_and_cache_partition<RequiresClauseSyntax, SyntaxIndex>(FilePartitionCache::RequiresClauseSyntaxTrees);
+        return impl_->get_or_build_index(*this, id, build, heap_bytes, partitions, name);
     }
 
-    Partition<SimpleRequirementSyntax, SyntaxIndex> File::simple_requirement_syntax_trees() const
+    size_t File::adopt_indexes(File const& previous, FileDiff const& diff) const
     {
-        return impl_->get_and_cache_partition<SimpleRequirementSyntax, SyntaxIndex>(FilePartitionCache::SimpleRequirementSyntaxTrees);
+        return impl_->adopt_indexes(*previous.impl_, diff);
     }
 
-    Partition<TypeRequirementSyntax, SyntaxIndex> File::type_requirement_syntax_trees() const
+    FileStats File::stats() const
     {
-        return impl_->get_and_cache_partition<TypeRequirementSyntax, SyntaxIndex>(FilePartitionCache::TypeRequirementSyntaxTrees);
+        return impl_->stats();
     }
 
-    Partition<NestedRequirementSyntax, SyntaxIndex> File::nested_requirement_syntax_trees() const
+    std::vector<std::string_view> File::accessed_partitions() const
     {
-        return impl_->get_and_cache_partition<NestedRequirementSyntax, SyntaxIndex>(FilePartitionCache::NestedRequirementSyntaxTrees);
+        return impl_->accessed_partitions();
     }
 
-    Partition<CompoundRequirementSyntax, SyntaxIndex> File::compound_requirement_syntax_trees() const
+    FileMemoryUsage File::memory_usage() const
     {
-        return impl_->get_and_cache_partition<CompoundRequirementSyntax, SyntaxIndex>(FilePartitionCache::CompoundRequirementSyntaxTrees);
+        return impl_->memory_usage();
     }
 
-    Partition<RequirementBodySyntax, SyntaxIndex> File::requirement_body_syntax_trees() const
+    size_t File::trim(TrimLevel level) const
     {
-        return impl_->get_and_cache_partition<RequirementBodySyntax, SyntaxIndex>(FilePartitionCache::RequirementBodySyntaxTrees);
+        return impl_->trim(level);
     }
 
-    Partition<TypeTemplateArgumentSyntax, SyntaxIndex> File::type_template_argument_syntax_trees() const
+    std::pmr::memory_resource* File::memory_resource() const
     {
-        return impl_->get_and_cache_partition<TypeTemplateArgumentSyntax, SyntaxIndex>(FilePartitionCache::TypeTemplateArgumentSyntaxTrees);
+        return impl_->memory_resource();
     }
 
-    Partition<TemplateArgumentListSyntax, SyntaxIndex> File::template_argument_list_syntax_trees() const
+    File::File(BlobView data, FileOptions options)
+        : impl_(std::make_unique<Impl>(data, options))
+        , cached_partitions_(impl_->cached_partitions())
+        , user_partitions_(impl_->user_partitions())
+        , trusted_(options.trusted)
     {
-        return impl_->get_and_cache_partition<TemplateArgumentListSyntax, SyntaxIndex>(FilePartitionCache::TemplateArgumentListSyntaxTrees);
     }
 
-    Partition<TemplateIdSyntax, SyntaxIndex> File::templateid_syntax_trees() const
+    void File::validate() const
     {
-        return impl_->get_and_cache_partition<TemplateIdSyntax, SyntaxIndex>(FilePartitionCache::TemplateidSyntaxTrees);
+        impl_->validate(default_executor());
     }
 
-    Partition<TypeTraitIntrinsicSyntax, SyntaxIndex> File::type_trait_intrinsic_syntax_trees() const
+    void File::validate(Executor& executor) const
     {
-        return impl_->get_and_cache_partition<TypeTraitIntrinsicSyntax, SyntaxIndex>(FilePartitionCache::TypeTraitIntrinsicSyntaxTrees);
+        impl_->validate(executor);
     }
 
-    Partition<TupleSyntax, SyntaxIndex> File::tuple_syntax_trees() const
+    std::shared_future<void> File::validation_status() const
     {
-        return impl_->get_and_cache_partition<TupleSyntax, SyntaxIndex>(FilePartitionCache::TupleSyntaxTrees);
+        return impl_->validation_status();
     }
 
-    // ------------------------------------------------------------------------
-
-    Partition<OperatorFunctionName, NameIndex> File::operator_names() const
+    File::ResolvedPartition File::resolve_partition(FilePartitionCache cache_type) const
     {
-        return impl_->get_and_cache_partition<OperatorFunctionName, NameIndex>(FilePartitionCache::OperatorNames);
+        return impl_->resolve_partition(cache_type);
     }
 
-    Partition<ConversionFunctionName, NameIndex> File::conversion_function_names() const
-	{
-		return impl_->get_and_cache_partition<ConversionFunctionName, NameIndex>(FilePartitionCache::ConversionNames);
-	}
-
-    Partition<LiteralName, NameIndex> File::literal_names() const
+    File::ResolvedPartition File::resolve_partition(std::string_view name, size_t entry_size) const
     {
-        return impl_->get_and_cache_partition<LiteralName, NameIndex>(FilePartitionCache::LiteralNames);
+        return impl_->resolve_partition(name, entry_size);
     }
 
-    Partition<TemplateName, NameIndex> File::template_names() const
-	{
-		return impl_->get_and_cache_partition<TemplateName, NameIndex>(FilePartitionCache::TemplateNames);
-	}
-
-    Partition<SpecializationName, NameIndex> File::specialization_names() const
+    File::ResolvedPartition File::resolve_partition(size_t slot, std::string_view name, size_t entry_size) const
     {
-        return impl_->get_and_cache_partition<SpecializationName, NameIndex>(FilePartitionCache::SpecializationNames);
+        return impl_->resolve_partition(slot, name, entry_size);
     }
 
-    Partition<SourceFileName, NameIndex> File::source_file_names() const
-	{
-		return impl_->get_and_cache_partition<SourceFileName, NameIndex>(FilePartitionCache::SourceFileNames);
-	}
-
-    Partition<DeductionGuideName, NameIndex> File::deduction_guide_names() const
+#ifdef IFC_FILE_STATS
+    void File::record_first_access(FilePartitionCache cache_type) const
     {
-		return impl_->get_and_cache_partition<DeductionGuideName, NameIndex>(FilePartitionCache::DeductionGuideNames);
+        impl_->record_first_access(cache_type);
     }
+#endif
 
-    // ------------------------------------------------------------------------
+    File::~File() = default;
 
-    Partition<TypeIndex, Index> File::type_heap() const
-    {
-        return impl_->get_and_cache_partition<TypeIndex, Index>("heap.type", FilePartitionCache::TypeHeap);
-    }
+    File::File           (File&&) noexcept = default;
+    File& File::operator=(File&&) noexcept = default;
 
-    Partition<ExprIndex, Index> File::expr_heap() const
+    void AccessProfile::record(File const& file)
     {
-        return impl_->get_and_cache_partition<ExprIndex, Index>("heap.expr", FilePartitionCache::ExprHeap);
+        for (auto name : file.accessed_partitions())
+        {
+            auto position = std::ranges::lower_bound(partitions, name);
+            if (position == partitions.end() || *position != name)
+                partitions.emplace(position, name);
+        }
     }
 
-    Partition<AttrIndex, Index> File::attr_heap() const
+    std::vector<File::BlobView> AccessProfile::ranges(File const& file) const
     {
-        return impl_->get_and_cache_partition<AttrIndex, Index>("heap.attr", FilePartitionCache::AttrHeap);
-    }
+        std::vector<File::BlobView> result;
+        for (auto const & partition : file.table_of_contents())
+        {
+            if (partition.size_bytes() != 0 && std::ranges::binary_search(partitions, std::string_view(file.get_string(partition.name))))
+                result.push_back(file.blob().subspan(static_cast<size_t>(partition.offset), partition.size_bytes()));
+        }
 
-    Partition<SyntaxIndex, Index> File::syntax_heap() const
-    {
-        return impl_->get_and_cache_partition<SyntaxIndex, Index>("heap.syn", FilePartitionCache::SyntaxHeap);
+        std::ranges::sort(result, {}, [](File::BlobView range) { return range.data(); });
+        std::vector<File::BlobView> merged;
+        for (auto range : result)
+        {
+            if (!merged.empty() && range.data() <= merged.back().data() + merged.back().size())
+            {
+                auto const & last = merged.back();
+                const auto end = std::max(last.data() + last.size(), range.data() + range.size());
+                merged.back() = { last.data(), end };
+            }
+            else
+            {
+                merged.push_back(range);
+            }
+        }
+        return merged;
     }
 
-    Partition<ModuleReference, Index> File::imported_modules() const
+    std::string AccessProfile::serialize() const
     {
-        return impl_->get_and_cache_partition<ModuleReference, Index>("module.imported", FilePartitionCache::ImportedModules);
+        std::string result;
+        for (auto const & name : partitions)
+        {
+            result += name;
+            result += '\n';
+        }
+        return result;
     }
 
-    Partition<ModuleReference, Index> File::exported_modules() const
+    AccessProfile AccessProfile::parse(std::string_view text)
     {
-        return impl_->get_and_cache_partition<ModuleReference, Index>("module.exported", FilePartitionCache::ExportedModules);
+        AccessProfile result;
+        while (!text.empty())
+        {
+            const auto end = std::min(text.find('\n'), text.size());
+            auto line = text.substr(0, end);
+            if (line.ends_with('\r'))
+                line.remove_suffix(1);
+            if (!line.empty())
+                result.partitions.emplace_back(line);
+            text.remove_prefix(std::min(end + 1, text.size()));
+        }
+        std::ranges::sort(result.partitions);
+        const auto duplicates = std::ranges::unique(result.partitions);
+        result.partitions.erase(duplicates.begin(), duplicates.end());
+        return result;
     }
 
-    // ------------------------------------------------------------------------
-
-    Partition<DeclIndex> File::deduction_guides() const
+    FilePeek peek_file(File::BlobView blob)
     {
-        return impl_->get_and_cache_partition<DeclIndex, uint32_t>("name.guide", FilePartitionCache::DeductionGuides);
-    }
-
-    // ------------------------------------------------------------------------
+        auto check_range = [&blob](size_t offset, size_t size) {
+            if (offset > blob.size() || size > blob.size() - offset)
+                throw std::runtime_error("corrupted file");
+        };
 
-    template<typename RetType, typename Value>
-    RetType get_value(DeclIndex declaration, std::unordered_map<DeclIndex, Value> const & map)
-    {
-        if (auto it = map.find(declaration); it != map.end())
-            return it->second;
+        FileSignature signature;
+        check_range(0, sizeof(signature) + sizeof(FileHeader));
+        std::memcpy(&signature, blob.data(), sizeof(signature));
+        if (signature != CANONICAL_FILE_SIGNATURE)
+            throw std::invalid_argument("corrupted file signature");
+
+        FilePeek result;
+        std::memcpy(&result.header, blob.data() + sizeof(signature), sizeof(FileHeader));
+        auto const & header = result.header;
+
+        const auto strings_offset = static_cast<size_t>(header.string_table_bytes);
+        const auto strings_size = raw_count(header.string_table_size);
+        check_range(strings_offset, strings_size);
+        const std::string_view strings(reinterpret_cast<const char*>(blob.data()) + strings_offset, strings_size);
+
+        auto get_string = [&strings](TextOffset offset) {
+            const auto start = static_cast<size_t>(offset);
+            const auto end = strings.find('\0', start);
+            if (start >= strings.size() || end == std::string_view::npos)
+                throw std::runtime_error("corrupted file");
+            return strings.substr(start, end - start);
+        };
 
-        return {};
-    }
+        switch (header.unit.sort())
+        {
+        case UnitSort::Primary:
+        case UnitSort::Partition:
+        case UnitSort::Header:
+            result.unit_name = get_string(TextOffset{ header.unit.index });
+            break;
+        default:
+            break;
+        }
 
-    TextOffset File::trait_deprecation_texts(DeclIndex declaration) const
-    {
-        return get_value<TextOffset>(declaration, impl_->trait_deprecation_texts());
-    }
+        const auto toc_offset = static_cast<size_t>(header.toc);
+        const auto toc_size = raw_count(header.partition_count);
+        check_range(toc_offset, toc_size * sizeof(PartitionSummary));
+        std::vector<PartitionSummary> toc(toc_size);
+        std::memcpy(toc.data(), blob.data() + toc_offset, toc_size * sizeof(PartitionSummary));
+
+        auto read_module_names = [&](FilePartitionCache cache, std::vector<std::string> & names) {
+            const auto name = partition_name(cache);
+            const auto partition = std::ranges::find(toc, name, [&](PartitionSummary const & summary) { return get_string(summary.name); });
+            if (partition == toc.end())
+                return;
+
+            check_range(static_cast<size_t>(partition->offset), partition->size_bytes());
+            const auto entry_size = static_cast<size_t>(partition->entry_size);
+            if (entry_size < sizeof(ModuleReference))
+                throw std::runtime_error("corrupted file");
 
-    std::span<AttrIndex const> File::trait_declaration_attributes(DeclIndex declaration) const
-    {
-        return get_value<std::span<AttrIndex const>>(declaration, impl_->trait_declaration_attributes());
-    }
+            names.reserve(raw_count(partition->cardinality));
+            for (size_t i = 0; i != raw_count(partition->cardinality); ++i)
+            {
+                ModuleReference module;
+                std::memcpy(&module, blob.data() + static_cast<size_t>(partition->offset) + i * entry_size, sizeof(module));
 
-    Sequence File::trait_friendship_of_class(DeclIndex declaration) const
-    {
-        return get_value<Sequence>(declaration, impl_->trait_friendship_of_class());
-    }
+                // Same naming as the Environment uses to look modules up.
+                if (is_null(module.owner))
+                {
+                    names.emplace_back(get_string(module.partition));
+                }
+                else
+                {
+                    auto & module_name = names.emplace_back(get_string(module.owner));
+                    if (!is_null(module.partition))
+                        module_name.append(":").append(get_string(module.partition));
+                }
+            }
+        };
+        read_module_names(FilePartitionCache::ImportedModules, result.imported_modules);
+        read_module_names(FilePartitionCache::ExportedModules, result.exported_modules);
 
-    File::File(BlobView data)
-        : impl_(std::make_unique<Impl>(data))
-    {
+        return result;
     }
 
-    File::~File() = default;
-
-    File::File           (File&&) noexcept = default;
-    File& File::operator=(File&&) noexcept = default;
-
     ScopeDeclaration const& get_scope(File const& file, DeclIndex decl)
     {
         return file.scope_declarations()[decl];
@@ -1002,4 +1760,44 @@ namespace ifc
     {
         return file.fundamental_types()[scope.type].basis;
     }
+
+    namespace
+    {
+        std::optional<TextOffset> as_identifier(TextOffset text)
+        {
+            if (is_null(text))
+                return std::nullopt;
+            return text;
+        }
+
+        std::optional<TextOffset> as_identifier(NameIndex name)
+        {
+            if (name.sort() != NameSort::Identifier)
+                return std::nullopt;
+            return as_identifier(TextOffset{ name.index });
+        }
+    }
+
+    std::optional<TextOffset> declaration_identifier(File const & file, DeclIndex decl)
+    {
+        switch (decl.sort())
+        {
+        case DeclSort::Enumerator:              return as_identifier(file.enumerators()[decl].name);
+        case DeclSort::Variable:                return as_identifier(file.variables()[decl].name);
+        case DeclSort::Parameter:               return as_identifier(file.parameters()[decl].name);
+        case DeclSort::Field:                   return as_identifier(file.fields()[decl].name);
+        case DeclSort::Bitfield:                return as_identifier(file.bitfields()[decl].name);
+        case DeclSort::Scope:                   return as_identifier(file.scope_declarations()[decl].name);
+        case DeclSort::Enumeration:             return as_identifier(file.enumerations()[decl].name);
+        case DeclSort::Alias:                   return as_identifier(file.alias_declarations()[decl].name);
+        case DeclSort::Template:                return as_identifier(file.template_declarations()[decl].name);
+        case DeclSort::PartialSpecialization:   return as_identifier(file.partial_specializations()[decl].name);
+        case DeclSort::Concept:                 return as_identifier(file.concepts()[decl].name);
+        case DeclSort::Function:                return as_identifier(file.functions()[decl].name);
+        case DeclSort::Method:                  return as_identifier(file.methods()[decl].name);
+        case DeclSort::UsingDeclaration:        return as_identifier(file.using_declarations()[decl].name);
+        case DeclSort::Intrinsic:               return as_identifier(file.intrinsic_declarations()[decl].name);
+        default:                                return std::nullopt;
+        }
+    }
 }
@@ -0,0 +1,132 @@
+#include "ifc/FileDiff.h"
+
+#include "ifc/Declaration.h"
+#include "ifc/File.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace ifc
+{
+    namespace
+    {
+        using Bytes = std::span<std::byte const>;
+
+        bool same_bytes(Bytes a, Bytes b)
+        {
+            return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size()) == 0);
+        }
+
+        std::unordered_map<std::string_view, PartitionSummary const*> partitions_by_name(File const& file)
+        {
+            std::unordered_map<std::string_view, PartitionSummary const*> result;
+            for (auto const & partition : file.table_of_contents())
+                result.emplace(file.get_string_view(partition.name), &partition);
+            return result;
+        }
+
+        Bytes partition_bytes(File const& file, PartitionSummary const* partition)
+        {
+            return partition ? file.blob().subspan(static_cast<size_t>(partition->offset), partition->size_bytes()) : Bytes{};
+        }
+
+        Bytes string_table(File const& file)
+        {
+            return std::as_bytes(file.string_table());
+        }
+
+        struct Partitions
+        {
+            File const& file;
+            std::unordered_map<std::string_view, PartitionSummary const*> by_name;
+
+            PartitionSummary const* find(std::string_view name) const
+            {
+                const auto found = by_name.find(name);
+                return found != by_name.end() ? found->second : nullptr;
+            }
+        };
+
+        // Records of the same index that differ, or are present in only one of the partitions.
+        template<typename T>
+        void add_changed_declarations(Partitions const& before, Partitions const& after, std::vector<DeclIndex>& out)
+        {
+            const auto old_partition = before.find(T::PartitionName);
+            const auto new_partition = after.find(T::PartitionName);
+            const auto old_bytes = partition_bytes(before.file, old_partition);
+            const auto new_bytes = partition_bytes(after.file, new_partition);
+            if (same_bytes(old_bytes, new_bytes))
+                return;
+
+            const auto old_count = old_partition ? raw_count(old_partition->cardinality) : 0;
+            const auto new_count = new_partition ? raw_count(new_partition->cardinality) : 0;
+            // Records of a different layout (e.g. of another format version) all count as changed.
+            const bool same_layout = old_partition && new_partition && old_partition->entry_size == new_partition->entry_size;
+            const auto entry_size = same_layout ? static_cast<size_t>(new_partition->entry_size) : 0;
+            for (size_t i = 0; i != std::max(old_count, new_count); ++i)
+            {
+                const bool changed = !same_layout || i >= old_count || i >= new_count
+                    || std::memcmp(old_bytes.data() + i * entry_size, new_bytes.data() + i * entry_size, entry_size) != 0;
+                if (changed)
+                    out.push_back({ static_cast<uint32_t>(T::Sort), static_cast<uint32_t>(i) });
+            }
+        }
+
+        template<typename... Ts>
+        void add_changed_declarations_of(Partitions const& before, Partitions const& after, std::vector<DeclIndex>& out)
+        {
+            (add_changed_declarations<Ts>(before, after, out), ...);
+        }
+
+        bool matches(std::string_view pattern, std::string_view name)
+        {
+            return pattern.ends_with('.') ? name.starts_with(pattern) : name == pattern;
+        }
+    }
+
+    bool FileDiff::changed(std::string_view partition) const
+    {
+        if (identical)
+            return false;
+        if (partition.empty())
+            return strings_changed;
+        return std::ranges::any_of(changed_partitions, [partition](std::string const& name) { return matches(partition, name); });
+    }
+
+    FileDiff diff_files(File const& before, File const& after)
+    {
+        FileDiff result;
+        const auto & old_checksum = before.header().checksum.data;
+        const auto & new_checksum = after.header().checksum.data;
+        if (std::ranges::equal(old_checksum, new_checksum))
+        {
+            result.identical = true;
+            return result;
+        }
+
+        result.strings_changed = !same_bytes(string_table(before), string_table(after));
+
+        const Partitions old_partitions{ before, partitions_by_name(before) };
+        const Partitions new_partitions{ after, partitions_by_name(after) };
+        for (auto const & [name, partition] : new_partitions.by_name)
+        {
+            if (!same_bytes(partition_bytes(before, old_partitions.find(name)), partition_bytes(after, partition)))
+                result.changed_partitions.emplace_back(name);
+        }
+        for (auto const & [name, partition] : old_partitions.by_name)
+        {
+            if (!new_partitions.find(name))
+                result.changed_partitions.emplace_back(name);
+        }
+        std::ranges::sort(result.changed_partitions);
+
+        add_changed_declarations_of<
+            UsingDeclaration, TemplateDeclaration, PartialSpecialization, Specialization, Enumeration, Enumerator,
+            AliasDeclaration, ScopeDeclaration, FunctionDeclaration, MethodDeclaration, Constructor, Destructor,
+            VariableDeclaration, FieldDeclaration, BitfieldDeclaration, ParameterDeclaration, FriendDeclaration,
+            Concept, IntrinsicDeclaration, DeclReference>(old_partitions, new_partitions, result.changed_declarations);
+        std::ranges::sort(result.changed_declarations);
+        return result;
+    }
+}
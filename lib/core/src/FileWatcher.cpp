@@ -0,0 +1,489 @@
+#include "ifc/FileWatcher.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace ifc
+{
+    namespace
+    {
+        // Watched files of a directory by file name, each with the paths it was watched by.
+        using WatchedFiles = std::unordered_map<std::string, std::vector<std::filesystem::path>>;
+
+        // Adds the file to the files of its directory, returns false if it is already there.
+        bool add_file(WatchedFiles& files, std::filesystem::path const& path)
+        {
+            auto & paths = files[std::filesystem::absolute(path).filename().string()];
+            for (auto const & watched : paths)
+                if (watched == path)
+                    return false;
+            paths.push_back(path);
+            return true;
+        }
+
+        [[noreturn]] void throw_last_error(const char* what)
+        {
+#if defined(_WIN32)
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+#else
+            throw std::system_error(errno, std::generic_category(), what);
+#endif
+        }
+    }
+
+#if defined(__linux__)
+    struct FileWatcher::Impl
+    {
+        Callback on_change;
+        std::chrono::milliseconds poll_interval;
+        std::mutex mutex;
+        std::unordered_map<std::string, int> watches; // by directory
+        std::unordered_map<int, WatchedFiles> files;  // by watch descriptor
+        // By directory, of the directories whose watch was removed (e.g. they were deleted or moved), watched
+        // again every `poll_interval` until they exist again.
+        std::unordered_map<std::string, WatchedFiles> unwatched;
+        int inotify = -1;
+        int wake[2] = { -1, -1 };
+        std::jthread thread;
+
+        static constexpr uint32_t Events = IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MOVE_SELF;
+
+        Impl(Callback callback, std::chrono::milliseconds interval)
+            : on_change(std::move(callback))
+            , poll_interval(interval)
+        {
+            inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (inotify < 0)
+                throw_last_error("inotify_init1");
+            if (pipe2(wake, O_CLOEXEC) != 0)
+            {
+                close(inotify);
+                throw_last_error("pipe2");
+            }
+            thread = std::jthread([this] { run(); });
+        }
+
+        ~Impl()
+        {
+            const char stop = 0;
+            (void)!write(wake[1], &stop, 1);
+            thread.join();
+            close(wake[0]);
+            close(wake[1]);
+            close(inotify);
+        }
+
+        void watch(std::filesystem::path const& path)
+        {
+            const auto directory = std::filesystem::absolute(path).parent_path();
+            std::scoped_lock lock(mutex);
+            if (auto waiting = unwatched.find(directory.string()); waiting != unwatched.end())
+            {
+                add_file(waiting->second, path);
+                return;
+            }
+            auto [found, inserted] = watches.try_emplace(directory.string(), -1);
+            if (inserted)
+            {
+                found->second = inotify_add_watch(inotify, directory.c_str(), Events);
+                if (found->second < 0)
+                {
+                    watches.erase(found);
+                    throw_last_error("inotify_add_watch");
+                }
+            }
+            add_file(files[found->second], path);
+        }
+
+        static void add_all(WatchedFiles const& directory, std::vector<std::filesystem::path>& changed)
+        {
+            for (auto const & [name, paths] : directory)
+                changed.insert(changed.end(), paths.begin(), paths.end());
+        }
+
+        static void merge_files(WatchedFiles& files, WatchedFiles const& more)
+        {
+            for (auto const & [name, more_paths] : more)
+            {
+                auto & paths = files[name];
+                for (auto const & path : more_paths)
+                    if (std::find(paths.begin(), paths.end(), path) == paths.end())
+                        paths.push_back(path);
+            }
+        }
+
+        // The watch is gone, its files may have changed in any way.
+        void unwatch(int wd, std::vector<std::filesystem::path>& changed)
+        {
+            auto node = files.extract(wd);
+            if (node.empty())
+                return;
+            add_all(node.mapped(), changed);
+            // Under the first of its paths, the others watched it with the same descriptor.
+            bool moved = false;
+            for (auto directory = watches.begin(); directory != watches.end();)
+            {
+                if (directory->second != wd)
+                {
+                    ++directory;
+                    continue;
+                }
+                if (!moved)
+                    unwatched[directory->first] = std::move(node.mapped());
+                moved = true;
+                directory = watches.erase(directory);
+            }
+        }
+
+        // Files of the directories watched again may have been created meanwhile.
+        void rewatch(std::vector<std::filesystem::path>& changed)
+        {
+            for (auto directory = unwatched.begin(); directory != unwatched.end();)
+            {
+                const int wd = inotify_add_watch(inotify, directory->first.c_str(), Events);
+                if (wd < 0)
+                {
+                    ++directory;
+                    continue;
+                }
+                add_all(directory->second, changed);
+                // Another path of a directory already watched gets the same descriptor.
+                merge_files(files[wd], directory->second);
+                watches[directory->first] = wd;
+                directory = unwatched.erase(directory);
+            }
+        }
+
+        void run()
+        {
+            // Aligned for the inotify_event records read into it.
+            alignas(inotify_event) char buffer[16 * 1024];
+            std::vector<std::filesystem::path> changed;
+            for (;;)
+            {
+                int timeout = -1;
+                {
+                    std::scoped_lock lock(mutex);
+                    if (!unwatched.empty())
+                        timeout = static_cast<int>(poll_interval.count());
+                }
+                pollfd fds[2] = { { inotify, POLLIN, 0 }, { wake[0], POLLIN, 0 } };
+                if (poll(fds, 2, timeout) < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    return;
+                }
+                if (fds[1].revents != 0)
+                    return;
+
+                changed.clear();
+                {
+                    std::scoped_lock lock(mutex);
+                    rewatch(changed);
+                }
+                for (auto const & path : changed)
+                    on_change(path);
+
+                ssize_t size;
+                while ((size = read(inotify, buffer, sizeof(buffer))) > 0)
+                {
+                    changed.clear();
+                    {
+                        std::scoped_lock lock(mutex);
+                        for (ssize_t offset = 0; offset < size;)
+                        {
+                            auto const & event = *reinterpret_cast<inotify_event const*>(buffer + offset);
+                            offset += sizeof(inotify_event) + event.len;
+                            if ((event.mask & IN_Q_OVERFLOW) != 0)
+                            {
+                                // Events were dropped: any of the files may have changed.
+                                for (auto const & [wd, directory] : files)
+                                    add_all(directory, changed);
+                                continue;
+                            }
+                            if ((event.mask & IN_IGNORED) != 0)
+                            {
+                                unwatch(event.wd, changed);
+                                continue;
+                            }
+                            // The watch follows the directory, not its path: it is removed, IN_IGNORED follows.
+                            if ((event.mask & IN_MOVE_SELF) != 0)
+                            {
+                                inotify_rm_watch(inotify, event.wd);
+                                continue;
+                            }
+                            if (event.len == 0)
+                                continue;
+                            auto directory = files.find(event.wd);
+                            if (directory == files.end())
+                                continue;
+                            if (auto file = directory->second.find(event.name); file != directory->second.end())
+                                changed.insert(changed.end(), file->second.begin(), file->second.end());
+                        }
+                    }
+                    for (auto const & path : changed)
+                        on_change(path);
+                }
+            }
+        }
+    };
+#elif defined(_WIN32)
+    struct FileWatcher::Impl
+    {
+        struct Directory
+        {
+            HANDLE handle = INVALID_HANDLE_VALUE;
+            OVERLAPPED overlapped{};
+            alignas(DWORD) char buffer[16 * 1024];
+            WatchedFiles files;
+        };
+
+        Callback on_change;
+        std::mutex mutex;
+        std::unordered_map<std::wstring, std::unique_ptr<Directory>> directories; // by path
+        HANDLE stop = nullptr;
+        HANDLE added = nullptr; // Signaled when a directory is added, so that the thread waits for it too
+        std::jthread thread;
+
+        static constexpr DWORD Events = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+        Impl(Callback callback, std::chrono::milliseconds)
+            : on_change(std::move(callback))
+        {
+            stop = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            added = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+            if (!stop || !added)
+                throw_last_error("CreateEvent");
+            thread = std::jthread([this] { run(); });
+        }
+
+        ~Impl()
+        {
+            SetEvent(stop);
+            thread.join();
+            for (auto & [path, directory] : directories)
+            {
+                CancelIoEx(directory->handle, &directory->overlapped);
+                DWORD transferred;
+                GetOverlappedResult(directory->handle, &directory->overlapped, &transferred, TRUE);
+                CloseHandle(directory->overlapped.hEvent);
+                CloseHandle(directory->handle);
+            }
+            CloseHandle(added);
+            CloseHandle(stop);
+        }
+
+        static bool arm(Directory& directory)
+        {
+            ResetEvent(directory.overlapped.hEvent);
+            return ReadDirectoryChangesW(directory.handle, directory.buffer, sizeof(directory.buffer), FALSE, Events,
+                                         nullptr, &directory.overlapped, nullptr);
+        }
+
+        void watch(std::filesystem::path const& path)
+        {
+            const auto directory_path = std::filesystem::absolute(path).parent_path();
+            std::scoped_lock lock(mutex);
+            auto & directory = directories[directory_path.native()];
+            if (!directory)
+            {
+                auto watched = std::make_unique<Directory>();
+                watched->handle = CreateFileW(directory_path.c_str(), FILE_LIST_DIRECTORY,
+                                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                              FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+                if (watched->handle == INVALID_HANDLE_VALUE)
+                {
+                    directories.erase(directory_path.native());
+                    throw_last_error("CreateFile");
+                }
+                watched->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+                if (!watched->overlapped.hEvent || !arm(*watched))
+                {
+                    const auto error = GetLastError();
+                    if (watched->overlapped.hEvent)
+                        CloseHandle(watched->overlapped.hEvent);
+                    CloseHandle(watched->handle);
+                    directories.erase(directory_path.native());
+                    SetLastError(error);
+                    throw_last_error("ReadDirectoryChangesW");
+                }
+                directory = std::move(watched);
+                SetEvent(added);
+            }
+            add_file(directory->files, path);
+        }
+
+        void run()
+        {
+            std::vector<HANDLE> handles;
+            std::vector<Directory*> waited;
+            std::vector<std::filesystem::path> changed;
+            for (;;)
+            {
+                handles.assign({ stop, added });
+                waited.clear();
+                {
+                    std::scoped_lock lock(mutex);
+                    // WaitForMultipleObjects waits for at most MAXIMUM_WAIT_OBJECTS handles.
+                    for (auto & [path, directory] : directories)
+                    {
+                        if (handles.size() == MAXIMUM_WAIT_OBJECTS)
+                            break;
+                        handles.push_back(directory->overlapped.hEvent);
+                        waited.push_back(directory.get());
+                    }
+                }
+
+                const auto signaled = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, INFINITE);
+                if (signaled == WAIT_OBJECT_0 || signaled == WAIT_FAILED)
+                    return;
+                if (signaled == WAIT_OBJECT_0 + 1)
+                    continue;
+
+                auto & directory = *waited[signaled - WAIT_OBJECT_0 - 2];
+                DWORD transferred = 0;
+                changed.clear();
+                {
+                    std::scoped_lock lock(mutex);
+                    if (GetOverlappedResult(directory.handle, &directory.overlapped, &transferred, FALSE) && transferred != 0)
+                    {
+                        for (DWORD offset = 0;;)
+                        {
+                            auto const & info = *reinterpret_cast<FILE_NOTIFY_INFORMATION const*>(directory.buffer + offset);
+                            const std::filesystem::path name(std::wstring(info.FileName, info.FileNameLength / sizeof(WCHAR)));
+                            if (auto file = directory.files.find(name.string()); file != directory.files.end())
+                                changed.insert(changed.end(), file->second.begin(), file->second.end());
+                            if (info.NextEntryOffset == 0)
+                                break;
+                            offset += info.NextEntryOffset;
+                        }
+                    }
+                    else
+                    {
+                        // The buffer overflowed: any of the files may have changed.
+                        for (auto const & [name, paths] : directory.files)
+                            changed.insert(changed.end(), paths.begin(), paths.end());
+                    }
+                    // A directory that cannot be watched anymore (e.g. removed) stays silent.
+                    if (!arm(directory))
+                        ResetEvent(directory.overlapped.hEvent);
+                }
+                for (auto const & path : changed)
+                    on_change(path);
+            }
+        }
+    };
+#else
+    struct FileWatcher::Impl
+    {
+        struct State
+        {
+            std::filesystem::path path;
+            bool exists;
+            uintmax_t size;
+            std::filesystem::file_time_type modification_time;
+
+            static State of(std::filesystem::path const& path)
+            {
+                std::error_code error;
+                State state{ path, std::filesystem::exists(path, error), 0, {} };
+                if (state.exists)
+                {
+                    state.size = std::filesystem::file_size(path, error);
+                    state.modification_time = std::filesystem::last_write_time(path, error);
+                }
+                return state;
+            }
+
+            bool operator==(State const&) const = default;
+        };
+
+        Callback on_change;
+        std::chrono::milliseconds poll_interval;
+        std::mutex mutex;
+        std::condition_variable stopped;
+        bool stopping = false;
+        std::vector<State> files;
+        std::jthread thread;
+
+        Impl(Callback callback, std::chrono::milliseconds interval)
+            : on_change(std::move(callback))
+            , poll_interval(interval)
+            , thread([this] { run(); })
+        {
+        }
+
+        ~Impl()
+        {
+            {
+                std::scoped_lock lock(mutex);
+                stopping = true;
+            }
+            stopped.notify_one();
+            thread.join();
+        }
+
+        void watch(std::filesystem::path const& path)
+        {
+            auto state = State::of(path);
+            std::scoped_lock lock(mutex);
+            for (auto const & file : files)
+                if (file.path == path)
+                    return;
+            files.push_back(std::move(state));
+        }
+
+        void run()
+        {
+            std::vector<std::filesystem::path> changed;
+            std::unique_lock lock(mutex);
+            while (!stopped.wait_for(lock, poll_interval, [this] { return stopping; }))
+            {
+                changed.clear();
+                for (auto & file : files)
+                {
+                    if (auto state = State::of(file.path); !(state == file))
+                    {
+                        file = std::move(state);
+                        changed.push_back(file.path);
+                    }
+                }
+
+                lock.unlock();
+                for (auto const & path : changed)
+                    on_change(path);
+                lock.lock();
+            }
+        }
+    };
+#endif
+
+    FileWatcher::FileWatcher(Callback on_change, std::chrono::milliseconds poll_interval)
+        : impl_(std::make_unique<Impl>(std::move(on_change), poll_interval))
+    {
+    }
+
+    FileWatcher::~FileWatcher() = default;
+
+    void FileWatcher::watch(std::filesystem::path const & path)
+    {
+        impl_->watch(path);
+    }
+}
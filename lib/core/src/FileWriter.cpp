@@ -0,0 +1,113 @@
+#include "ifc/FileWriter.h"
+#include "ifc/File.h"
+#include "Sha256.h"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace ifc
+{
+    namespace
+    {
+        // As checked by File.
+        constexpr std::array<std::byte, 4> Signature = { std::byte{ 0x54 }, std::byte{ 0x51 }, std::byte{ 0x45 }, std::byte{ 0x1A } };
+
+        struct Structure
+        {
+            std::array<std::byte, 4> signature;
+            FileHeader header;
+        };
+
+        void append(std::vector<std::byte>& out, void const* data, size_t size)
+        {
+            const auto bytes = static_cast<std::byte const*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+    }
+
+    FileWriter::FileWriter(FileHeader const& header, std::span<char const> string_table)
+        : header_(header)
+        , string_table_(string_table.begin(), string_table.end())
+    {
+    }
+
+    TextOffset FileWriter::add_string(std::string_view text)
+    {
+        const auto offset = static_cast<TextOffset>(string_table_.size());
+        string_table_.insert(string_table_.end(), text.begin(), text.end());
+        string_table_.push_back('\0');
+        return offset;
+    }
+
+    void FileWriter::add_partition(TextOffset name, std::span<std::byte const> entries, size_t entry_size)
+    {
+        if (entry_size == 0 || entries.size() % entry_size != 0)
+            throw std::invalid_argument("partition size is not a multiple of its entry size");
+
+        toc_.push_back({
+            .name = name,
+            .offset = static_cast<ByteOffset>(sizeof(Structure) + partitions_.size()),
+            .cardinality = static_cast<Cardinality>(entries.size() / entry_size),
+            .entry_size = static_cast<EntitySize>(entry_size),
+        });
+        partitions_.insert(partitions_.end(), entries.begin(), entries.end());
+    }
+
+    std::vector<std::byte> FileWriter::write(Layout layout) const
+    {
+        Structure structure{ Signature, header_ };
+        auto & header = structure.header;
+        const auto toc_bytes = toc_.size() * sizeof(PartitionSummary);
+        header.string_table_size = static_cast<Cardinality>(string_table_.size());
+        header.partition_count = static_cast<Cardinality>(toc_.size());
+
+        // Partitions were placed right after the header.
+        auto toc = toc_;
+        if (layout == Layout::TableOfContentsFirst)
+        {
+            header.string_table_bytes = static_cast<ByteOffset>(sizeof(Structure));
+            header.toc = static_cast<ByteOffset>(sizeof(Structure) + string_table_.size());
+            for (auto & partition : toc)
+                partition.offset = static_cast<ByteOffset>(static_cast<size_t>(partition.offset) + string_table_.size() + toc_bytes);
+        }
+        else
+        {
+            header.string_table_bytes = static_cast<ByteOffset>(sizeof(Structure) + partitions_.size());
+            header.toc = static_cast<ByteOffset>(static_cast<size_t>(header.string_table_bytes) + string_table_.size());
+        }
+
+        std::vector<std::byte> result;
+        result.reserve(sizeof(Structure) + partitions_.size() + string_table_.size() + toc_bytes);
+        append(result, &structure, sizeof(structure));
+        if (layout == Layout::TableOfContentsFirst)
+        {
+            append(result, string_table_.data(), string_table_.size());
+            append(result, toc.data(), toc_bytes);
+            append(result, partitions_.data(), partitions_.size());
+        }
+        else
+        {
+            append(result, partitions_.data(), partitions_.size());
+            append(result, string_table_.data(), string_table_.size());
+            append(result, toc.data(), toc_bytes);
+        }
+
+        // The checksum covers everything after itself.
+        const auto checksum_offset = offsetof(Structure, header) + offsetof(FileHeader, checksum);
+        const auto checksum = compute_sha256(std::span(result).subspan(checksum_offset + sizeof(SHA256)));
+        std::memcpy(result.data() + checksum_offset, &checksum, sizeof(checksum));
+        return result;
+    }
+
+    std::vector<std::byte> streaming_layout(File const& file)
+    {
+        FileWriter writer(file.header(), file.string_table());
+        for (auto const & partition : file.table_of_contents())
+        {
+            const auto entry_size = static_cast<size_t>(partition.entry_size);
+            writer.add_partition(partition.name, { file.get_data_pointer(partition), partition.size_bytes() }, entry_size);
+        }
+        return writer.write(FileWriter::Layout::TableOfContentsFirst);
+    }
+}
@@ -0,0 +1,50 @@
+#include "ifc/MemoryUsage.h"
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <sys/mman.h>
+#include <unistd.h>
+#define IFC_HAS_MINCORE 1
+#endif
+
+#include <algorithm>
+#include <cstdint>
+
+namespace ifc
+{
+    std::optional<size_t> resident_bytes(std::span<std::byte const> range)
+    {
+#ifdef IFC_HAS_MINCORE
+        if (range.empty())
+            return 0;
+
+        static const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const auto first = reinterpret_cast<uintptr_t>(range.data());
+        const auto last = first + range.size();
+        const auto first_page = first & ~(page_size - 1);
+        const auto pages = (last - first_page + page_size - 1) / page_size;
+
+#ifdef __APPLE__
+        std::vector<char> residency(pages);
+#else
+        std::vector<unsigned char> residency(pages);
+#endif
+        if (mincore(reinterpret_cast<void*>(first_page), pages * page_size, residency.data()) != 0)
+            return std::nullopt;
+
+        // Partial pages at either end count with the bytes of the range they hold.
+        size_t result = 0;
+        for (size_t page = 0; page != pages; ++page)
+        {
+            if ((residency[page] & 1) == 0)
+                continue;
+            const auto page_start = std::max(first, first_page + page * page_size);
+            const auto page_end = std::min(last, first_page + (page + 1) * page_size);
+            result += page_end - page_start;
+        }
+        return result;
+#else
+        (void)range;
+        return std::nullopt;
+#endif
+    }
+}
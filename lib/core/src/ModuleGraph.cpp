@@ -0,0 +1,98 @@
+#include "ifc/ModuleGraph.h"
+
+#include <algorithm>
+
+namespace ifc
+{
+    ModuleGraph::ModuleGraph(Environment& environment, File const& root)
+    {
+        auto node_of = [this](File const* file) {
+            auto [it, inserted] = ids_.try_emplace(file, static_cast<NodeId>(files_.size()));
+            if (inserted)
+                files_.push_back(file);
+            return it->second;
+        };
+
+        // Breadth-first, files_ doubles as the queue.
+        node_of(&root);
+        edge_offsets_.push_back(0);
+        for (size_t node = 0; node != files_.size(); ++node)
+        {
+            const auto first_edge = edges_.size();
+            for (auto references : { environment.imported_files(*files_[node]), environment.exported_files(*files_[node]) })
+            {
+                for (auto file : references)
+                {
+                    const auto dependency = node_of(file);
+                    if (std::find(edges_.begin() + first_edge, edges_.end(), dependency) == edges_.end())
+                        edges_.push_back(dependency);
+                }
+            }
+            edge_offsets_.push_back(static_cast<uint32_t>(edges_.size()));
+        }
+
+        // Iterative depth-first post-order, depth is the length of the longest dependency chain.
+        enum class State : uint8_t { New, Visiting, Done };
+        std::vector<State> states(files_.size(), State::New);
+        std::vector<uint32_t> depths(files_.size(), 0);
+        std::vector<std::pair<NodeId, uint32_t>> stack; // Node and its next dependency to visit
+
+        order_.reserve(files_.size());
+        for (NodeId start = 0; start != files_.size(); ++start)
+        {
+            if (states[start] != State::New)
+                continue;
+
+            states[start] = State::Visiting;
+            stack.emplace_back(start, 0);
+            while (!stack.empty())
+            {
+                auto & [node, next] = stack.back();
+                const auto node_dependencies = dependencies(node);
+                if (next != node_dependencies.size())
+                {
+                    const auto dependency = node_dependencies[next++];
+                    if (states[dependency] == State::New)
+                    {
+                        states[dependency] = State::Visiting;
+                        stack.emplace_back(dependency, 0);
+                    }
+                    continue;
+                }
+
+                for (auto dependency : node_dependencies)
+                {
+                    if (states[dependency] == State::Done)
+                        depths[node] = std::max(depths[node], depths[dependency] + 1);
+                }
+                states[node] = State::Done;
+                order_.push_back(node);
+                stack.pop_back();
+            }
+        }
+
+        std::ranges::stable_sort(order_, {}, [&depths](NodeId node) { return depths[node]; });
+        for (size_t i = 0; i != order_.size(); ++i)
+        {
+            while (depth_offsets_.size() <= depths[order_[i]])
+                depth_offsets_.push_back(static_cast<uint32_t>(i));
+        }
+        depth_offsets_.push_back(static_cast<uint32_t>(order_.size()));
+    }
+
+    std::optional<ModuleGraph::NodeId> ModuleGraph::find(File const& file) const
+    {
+        if (auto it = ids_.find(&file); it != ids_.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    void ModuleGraph::for_each_parallel(std::function<void(NodeId)> const& visit, Executor& executor) const
+    {
+        for (size_t depth = 0; depth + 1 < depth_offsets_.size(); ++depth)
+        {
+            const auto level = std::span(order_).subspan(depth_offsets_[depth], depth_offsets_[depth + 1] - depth_offsets_[depth]);
+            executor.run(level.size(), [&](size_t i) { visit(level[i]); });
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#include "ifc/ModuleGraphSnapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace ifc
+{
+    namespace
+    {
+        constexpr std::array<std::byte, 4> SnapshotSignature = { std::byte{ 'I' }, std::byte{ 'F' }, std::byte{ 'C' }, std::byte{ 'G' } };
+        constexpr uint32_t SnapshotVersion = 1;
+
+        // Followed by the node records, the edge offsets (one more than the nodes), the edges, the topological
+        // order, the nodes sorted by path and the strings.
+        struct SnapshotHeader
+        {
+            std::array<std::byte, 4> signature;
+            uint32_t version;
+            uint32_t node_count;
+            uint32_t edge_count;
+            uint64_t strings_size;
+        };
+
+        void append(std::vector<std::byte>& out, void const* data, size_t size)
+        {
+            const auto bytes = static_cast<std::byte const*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        std::string_view unit_name(File const& file)
+        {
+            switch (file.header().unit.sort())
+            {
+            case UnitSort::Primary:
+            case UnitSort::Partition:
+            case UnitSort::Header:
+                return file.get_string_view(TextOffset{ file.header().unit.index });
+            default:
+                return {};
+            }
+        }
+    }
+
+    std::vector<std::byte> ModuleGraphSnapshot::write(ModuleGraph const& graph, std::span<std::filesystem::path const> paths)
+    {
+        if (paths.size() != graph.size())
+            throw std::invalid_argument("a module graph snapshot needs one path per node");
+
+        std::string strings;
+        auto add_string = [&strings](std::string_view text, uint32_t& offset, uint32_t& size) {
+            offset = static_cast<uint32_t>(strings.size());
+            size = static_cast<uint32_t>(text.size());
+            strings += text;
+        };
+
+        std::vector<std::string> generic_paths(graph.size());
+        std::vector<NodeRecord> nodes(graph.size());
+        std::vector<uint32_t> edge_offsets{ 0 };
+        std::vector<NodeId> edges;
+        for (NodeId node = 0; node != graph.size(); ++node)
+        {
+            generic_paths[node] = paths[node].generic_string();
+            nodes[node].checksum = graph.file(node).header().checksum;
+            nodes[node].size = std::filesystem::file_size(paths[node]);
+            nodes[node].modification_time = static_cast<int64_t>(std::filesystem::last_write_time(paths[node]).time_since_epoch().count());
+            add_string(generic_paths[node], nodes[node].path_offset, nodes[node].path_size);
+            add_string(ifc::unit_name(graph.file(node)), nodes[node].unit_name_offset, nodes[node].unit_name_size);
+
+            const auto dependencies = graph.dependencies(node);
+            edges.insert(edges.end(), dependencies.begin(), dependencies.end());
+            edge_offsets.push_back(static_cast<uint32_t>(edges.size()));
+        }
+
+        std::vector<NodeId> by_path(graph.size());
+        std::iota(by_path.begin(), by_path.end(), NodeId{ 0 });
+        std::ranges::sort(by_path, {}, [&generic_paths](NodeId node) -> std::string_view { return generic_paths[node]; });
+
+        const SnapshotHeader header{
+            .signature = SnapshotSignature,
+            .version = SnapshotVersion,
+            .node_count = static_cast<uint32_t>(nodes.size()),
+            .edge_count = static_cast<uint32_t>(edges.size()),
+            .strings_size = strings.size(),
+        };
+
+        std::vector<std::byte> result;
+        const auto order = graph.topological_order();
+        append(result, &header, sizeof(header));
+        append(result, nodes.data(), nodes.size() * sizeof(NodeRecord));
+        append(result, edge_offsets.data(), edge_offsets.size() * sizeof(uint32_t));
+        append(result, edges.data(), edges.size() * sizeof(NodeId));
+        append(result, order.data(), order.size() * sizeof(NodeId));
+        append(result, by_path.data(), by_path.size() * sizeof(NodeId));
+        append(result, strings.data(), strings.size());
+        return result;
+    }
+
+    ModuleGraphSnapshot::ModuleGraphSnapshot(Environment::BlobHolderPtr holder)
+        : holder_(std::move(holder))
+    {
+        const auto blob = holder_->view();
+        size_t position = 0;
+        auto take = [&blob, &position](uint64_t size) {
+            if (size > blob.size() - position)
+                throw std::runtime_error("corrupted module graph snapshot");
+            const auto data = blob.data() + position;
+            position += static_cast<size_t>(size);
+            return data;
+        };
+
+        SnapshotHeader header;
+        std::memcpy(&header, take(sizeof(header)), sizeof(header));
+        if (header.signature != SnapshotSignature || header.version != SnapshotVersion)
+            throw std::runtime_error("not a module graph snapshot");
+
+        const size_t node_count = header.node_count;
+        nodes_ = { reinterpret_cast<NodeRecord const*>(take(node_count * uint64_t{ sizeof(NodeRecord) })), node_count };
+        edge_offsets_ = { reinterpret_cast<uint32_t const*>(take((node_count + 1) * uint64_t{ sizeof(uint32_t) })), node_count + 1 };
+        edges_ = { reinterpret_cast<NodeId const*>(take(header.edge_count * uint64_t{ sizeof(NodeId) })), header.edge_count };
+        order_ = { reinterpret_cast<NodeId const*>(take(node_count * uint64_t{ sizeof(NodeId) })), node_count };
+        by_path_ = { reinterpret_cast<NodeId const*>(take(node_count * uint64_t{ sizeof(NodeId) })), node_count };
+        strings_ = { reinterpret_cast<char const*>(take(header.strings_size)), static_cast<size_t>(header.strings_size) };
+
+        auto is_node = [node_count](NodeId node) { return node < node_count; };
+        if (edge_offsets_.front() != 0 || edge_offsets_.back() != edges_.size() || !std::ranges::is_sorted(edge_offsets_)
+            || !std::ranges::all_of(edges_, is_node) || !std::ranges::all_of(order_, is_node) || !std::ranges::all_of(by_path_, is_node))
+            throw std::runtime_error("corrupted module graph snapshot");
+        for (auto const & node : nodes_)
+        {
+            if (node.path_offset + uint64_t{ node.path_size } > strings_.size() || node.unit_name_offset + uint64_t{ node.unit_name_size } > strings_.size())
+                throw std::runtime_error("corrupted module graph snapshot");
+        }
+
+        validity_ = std::make_unique<std::atomic<Validity>[]>(node_count);
+    }
+
+    std::string_view ModuleGraphSnapshot::path(NodeId node) const
+    {
+        return strings_.substr(nodes_[node].path_offset, nodes_[node].path_size);
+    }
+
+    std::string_view ModuleGraphSnapshot::unit_name(NodeId node) const
+    {
+        return strings_.substr(nodes_[node].unit_name_offset, nodes_[node].unit_name_size);
+    }
+
+    std::optional<ModuleGraphSnapshot::NodeId> ModuleGraphSnapshot::find(std::string_view path) const
+    {
+        const auto it = std::ranges::lower_bound(by_path_, path, {}, [this](NodeId node) { return this->path(node); });
+        if (it != by_path_.end() && this->path(*it) == path)
+            return *it;
+        return std::nullopt;
+    }
+
+    bool ModuleGraphSnapshot::is_current(NodeId node) const
+    {
+        auto validity = validity_[node].load(std::memory_order_relaxed);
+        if (validity == Validity::Unchecked)
+        {
+            // Racing threads find the same answer, unless the BMI changes in between.
+            const std::filesystem::path bmi(path(node));
+            std::error_code size_error, time_error;
+            const auto size = std::filesystem::file_size(bmi, size_error);
+            const auto time = std::filesystem::last_write_time(bmi, time_error);
+            const bool current = !size_error && !time_error && size == nodes_[node].size
+                && static_cast<int64_t>(time.time_since_epoch().count()) == nodes_[node].modification_time;
+            validity = current ? Validity::Current : Validity::Stale;
+            validity_[node].store(validity, std::memory_order_relaxed);
+        }
+        return validity == Validity::Current;
+    }
+
+    bool ModuleGraphSnapshot::is_current() const
+    {
+        for (NodeId node = 0; node != size(); ++node)
+        {
+            if (!is_current(node))
+                return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,248 @@
+#include "ifc/Parallel.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ifc
+{
+    void InlineExecutor::run(size_t count, std::function<void(size_t)> const& task)
+    {
+        for (size_t i = 0; i != count; ++i)
+            task(i);
+    }
+
+    struct ThreadPool::Impl
+    {
+        // Remaining tasks [begin, end) of a thread as `end << 32 | begin`, taken from the front by their
+        // thread and split in halves by thieves, both with a compare-exchange.
+        struct Range
+        {
+            std::atomic<uint64_t> bounds = 0;
+
+            static uint64_t pack(uint32_t begin, uint32_t end) { return uint64_t{ end } << 32 | begin; }
+            static uint32_t begin(uint64_t bounds) { return static_cast<uint32_t>(bounds); }
+            static uint32_t end(uint64_t bounds) { return static_cast<uint32_t>(bounds >> 32); }
+        };
+
+        struct Job
+        {
+            std::function<void(size_t)> const* task;
+            size_t offset;
+            std::vector<Range> ranges; // One per thread, the calling one first
+            std::atomic<bool> failed = false;
+            std::exception_ptr exception;
+            std::mutex exception_mutex;
+
+            Job(std::function<void(size_t)> const& task, size_t offset, uint32_t count, size_t threads)
+                : task(&task)
+                , offset(offset)
+                , ranges(threads)
+            {
+                for (size_t i = 0; i != threads; ++i)
+                    ranges[i].bounds = Range::pack(static_cast<uint32_t>(count * i / threads), static_cast<uint32_t>(count * (i + 1) / threads));
+            }
+
+            std::optional<uint32_t> take(size_t thread)
+            {
+                auto& range = ranges[thread].bounds;
+                for (auto bounds = range.load(); Range::begin(bounds) < Range::end(bounds);)
+                {
+                    if (range.compare_exchange_weak(bounds, Range::pack(Range::begin(bounds) + 1, Range::end(bounds))))
+                        return Range::begin(bounds);
+                }
+                return std::nullopt;
+            }
+
+            // Moves the upper half of the remaining tasks of another thread to the (empty) range of the thread.
+            bool steal(size_t thread)
+            {
+                for (size_t i = 1; i != ranges.size(); ++i)
+                {
+                    auto& victim = ranges[(thread + i) % ranges.size()].bounds;
+                    for (auto bounds = victim.load(); Range::begin(bounds) < Range::end(bounds);)
+                    {
+                        const auto begin = Range::begin(bounds), end = Range::end(bounds);
+                        const auto middle = begin + (end - begin) / 2;
+                        if (victim.compare_exchange_weak(bounds, Range::pack(begin, middle)))
+                        {
+                            ranges[thread].bounds = Range::pack(middle, end);
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+        };
+
+        // Pool whose task the thread is running, to run nested runs inline.
+        static thread_local Impl const* running;
+
+        // Runs tasks of the job until there are none left.
+        void work(Job& job, size_t thread) const
+        {
+            auto const* outer = running;
+            running = this;
+            while (!job.failed.load(std::memory_order_relaxed))
+            {
+                const auto i = job.take(thread);
+                if (!i)
+                {
+                    if (job.steal(thread))
+                        continue;
+                    break;
+                }
+
+                try
+                {
+                    (*job.task)(job.offset + *i);
+                }
+                catch (...)
+                {
+                    std::scoped_lock lock(job.exception_mutex);
+                    if (!job.exception)
+                        job.exception = std::current_exception();
+                    job.failed = true;
+                }
+            }
+            running = outer;
+        }
+
+        void worker(size_t thread)
+        {
+            uint64_t seen_generation = 0;
+            std::unique_lock lock(mutex);
+            while (true)
+            {
+                work_available.wait(lock, [&] { return stopping || generation != seen_generation; });
+                if (stopping)
+                    return;
+                seen_generation = generation;
+
+                // Woken up after the job was finished by the others.
+                auto job = current_job;
+                if (job == nullptr)
+                    continue;
+
+                ++busy_workers;
+                lock.unlock();
+                work(*job, thread);
+                lock.lock();
+                if (--busy_workers == 0)
+                    workers_idle.notify_all();
+            }
+        }
+
+        void run(size_t offset, uint32_t count, std::function<void(size_t)> const& task)
+        {
+            const bool parallel = count > 1 && !workers.empty();
+            Job job(task, offset, count, parallel ? workers.size() + 1 : 1);
+            if (parallel)
+            {
+                {
+                    std::scoped_lock lock(mutex);
+                    current_job = &job;
+                    ++generation;
+                }
+                work_available.notify_all();
+            }
+
+            work(job, 0);
+
+            {
+                // Workers that have not woken up yet for this job will find it finished.
+                std::unique_lock lock(mutex);
+                workers_idle.wait(lock, [&] { return busy_workers == 0; });
+                current_job = nullptr;
+            }
+
+            if (job.exception)
+                std::rethrow_exception(job.exception);
+        }
+
+        std::mutex run_mutex;
+
+        std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable workers_idle;
+        Job* current_job = nullptr;
+        uint64_t generation = 0;
+        unsigned busy_workers = 0;
+        bool stopping = false;
+
+        std::vector<std::jthread> workers;
+    };
+
+    thread_local ThreadPool::Impl const* ThreadPool::Impl::running = nullptr;
+
+    ThreadPool::ThreadPool(unsigned threads, std::function<void(unsigned)> on_start)
+        : impl_(std::make_unique<Impl>())
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        impl_->workers.reserve(threads - 1);
+        for (unsigned i = 1; i < threads; ++i)
+        {
+            impl_->workers.emplace_back([impl = impl_.get(), i, on_start] {
+                if (on_start)
+                    on_start(i);
+                impl->worker(i);
+            });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::scoped_lock lock(impl_->mutex);
+            impl_->stopping = true;
+        }
+        impl_->work_available.notify_all();
+        impl_->workers.clear();
+    }
+
+    void ThreadPool::run(size_t count, std::function<void(size_t)> const& task)
+    {
+        if (count == 0)
+            return;
+
+        if (Impl::running == impl_.get())
+        {
+            InlineExecutor().run(count, task);
+            return;
+        }
+
+        std::scoped_lock run_lock(impl_->run_mutex);
+
+        // Ranges hold 32-bit indices.
+        constexpr size_t max_count = std::numeric_limits<uint32_t>::max();
+        for (size_t offset = 0; offset < count; offset += max_count)
+            impl_->run(offset, static_cast<uint32_t>(std::min(count - offset, max_count)), task);
+    }
+
+    namespace
+    {
+        std::atomic<Executor*> installed_executor = nullptr;
+    }
+
+    Executor& default_executor()
+    {
+        if (auto executor = installed_executor.load(std::memory_order_acquire))
+            return *executor;
+
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void set_default_executor(Executor* executor)
+    {
+        installed_executor.store(executor, std::memory_order_release);
+    }
+}
@@ -0,0 +1,345 @@
+#include "ifc/PostingLists.h"
+#include "ifc/MemoryUsage.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace ifc
+{
+    namespace
+    {
+        // Blocks are unpacked with unaligned little-endian 8-byte loads.
+        static_assert(std::endian::native == std::endian::little);
+
+        constexpr size_t Padding = sizeof(uint64_t);
+
+        // First posting and offset (from the data of the first block) of a block after the first.
+        constexpr size_t SkipEntrySize = 3 * sizeof(uint32_t);
+
+        uint32_t raw(DeclIndex decl)
+        {
+            return std::bit_cast<uint32_t>(decl);
+        }
+
+        DeclIndex decl_of(uint32_t raw)
+        {
+            return std::bit_cast<DeclIndex>(raw);
+        }
+
+        void write_varint(std::vector<uint8_t>& out, uint32_t value)
+        {
+            for (; value >= 0x80; value >>= 7)
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        uint32_t read_varint(uint8_t const*& in)
+        {
+            uint32_t value = 0;
+            for (int shift = 0; ; shift += 7)
+            {
+                const auto byte = *in++;
+                value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+                if (byte < 0x80)
+                    return value;
+            }
+        }
+
+        void write_u32(std::vector<uint8_t>& out, uint32_t value)
+        {
+            uint8_t bytes[sizeof(value)];
+            std::memcpy(bytes, &value, sizeof(value));
+            out.insert(out.end(), bytes, bytes + sizeof(value));
+        }
+
+        size_t packed_bytes(uint32_t bits, uint32_t count)
+        {
+            return (size_t{ bits } * count + 7) / 8;
+        }
+
+        void pack(std::vector<uint8_t>& out, std::span<uint32_t const> values, uint32_t bits)
+        {
+            const auto start = out.size();
+            out.resize(start + packed_bytes(bits, static_cast<uint32_t>(values.size())));
+            size_t bit = 0;
+            for (auto value : values)
+            {
+                for (uint32_t i = 0; i != bits; ++i, ++bit)
+                    out[start + bit / 8] |= static_cast<uint8_t>(((value >> i) & 1) << (bit % 8));
+            }
+        }
+
+        // Independent fixed-width loads, which compilers unroll and vectorize.
+        void unpack(uint8_t const* data, uint32_t bits, uint32_t count, uint32_t* out)
+        {
+            if (bits == 0)
+            {
+                std::fill_n(out, count, 0u);
+                return;
+            }
+            const uint64_t mask = (uint64_t{ 1 } << bits) - 1;
+            for (uint32_t i = 0; i != count; ++i)
+            {
+                const size_t bit = size_t{ i } * bits;
+                uint64_t word;
+                std::memcpy(&word, data + bit / 8, sizeof(word));
+                out[i] = static_cast<uint32_t>((word >> (bit % 8)) & mask);
+            }
+        }
+
+        // Steps, the file delta and whether the declaration sort changes (as the lowest bit), then the index
+        // deltas (minus one, as postings are distinct) of the postings not stepping, each at the width of its
+        // largest value. The declarations of the postings stepping follow as varints.
+        void encode_block(std::vector<uint8_t>& out, std::span<DeclarationId const> postings)
+        {
+            if (postings.size() == 1)
+                return;
+
+            uint32_t steps[PostingLists::BlockSize];
+            uint32_t deltas[PostingLists::BlockSize];
+            const auto count = static_cast<uint32_t>(postings.size() - 1);
+            uint32_t step_max = 0, delta_max = 0;
+            for (uint32_t i = 0; i != count; ++i)
+            {
+                const auto previous = postings[i], current = postings[i + 1];
+                const auto file_delta = static_cast<uint32_t>(current.file) - static_cast<uint32_t>(previous.file);
+                if (file_delta > std::numeric_limits<uint32_t>::max() / 2)
+                    throw std::length_error("file ids too far apart");
+                steps[i] = file_delta << 1 | (current.decl.tag != previous.decl.tag ? 1 : 0);
+                deltas[i] = steps[i] == 0 ? current.decl.index - previous.decl.index - 1 : 0;
+                step_max = std::max(step_max, steps[i]);
+                delta_max = std::max(delta_max, deltas[i]);
+            }
+
+            const auto step_bits = static_cast<uint32_t>(std::bit_width(step_max));
+            const auto delta_bits = static_cast<uint32_t>(std::bit_width(delta_max));
+            out.push_back(static_cast<uint8_t>(step_bits));
+            out.push_back(static_cast<uint8_t>(delta_bits));
+            pack(out, std::span(steps, count), step_bits);
+            pack(out, std::span(deltas, count), delta_bits);
+            for (uint32_t i = 0; i != count; ++i)
+            {
+                if (steps[i] != 0)
+                    write_varint(out, raw(postings[i + 1].decl));
+            }
+        }
+
+        void decode_block(uint8_t const* data, DeclarationId first, uint32_t size, DeclarationId* out)
+        {
+            out[0] = first;
+            if (size == 1)
+                return;
+
+            uint32_t steps[PostingLists::BlockSize];
+            uint32_t deltas[PostingLists::BlockSize];
+            const auto count = size - 1;
+            const uint32_t step_bits = data[0];
+            const uint32_t delta_bits = data[1];
+            const auto packed_deltas = data + 2 + packed_bytes(step_bits, count);
+            unpack(data + 2, step_bits, count, steps);
+            unpack(packed_deltas, delta_bits, count, deltas);
+
+            auto stepped = packed_deltas + packed_bytes(delta_bits, count);
+            auto file = static_cast<uint32_t>(first.file);
+            auto decl = first.decl;
+            for (uint32_t i = 0; i != count; ++i)
+            {
+                file += steps[i] >> 1;
+                if (steps[i] == 0)
+                    decl.index = decl.index + deltas[i] + 1;
+                else
+                    decl = decl_of(read_varint(stepped));
+                out[i + 1] = { FileId{ file }, decl };
+            }
+        }
+
+        uint32_t block_count(uint32_t postings)
+        {
+            return (postings + PostingLists::BlockSize - 1) / PostingLists::BlockSize;
+        }
+    }
+
+    PostingLists::PostingLists()
+        : bytes_(Padding)
+    {
+    }
+
+    PostingLists::ListId PostingLists::add(std::span<DeclarationId const> postings)
+    {
+        if (std::ranges::adjacent_find(postings, std::greater_equal<>{}) != postings.end())
+            throw std::invalid_argument("postings must be sorted and distinct");
+        if (postings.size() > std::numeric_limits<uint32_t>::max() || offsets_.size() == std::numeric_limits<ListId>::max())
+            throw std::length_error("too many postings");
+
+        const auto count = static_cast<uint32_t>(postings.size());
+        const auto blocks = block_count(count);
+
+        // Blocks after the first are encoded aside, to know their offsets before writing the skip entries.
+        std::vector<uint8_t> data;
+        std::vector<uint32_t> block_offsets;
+        for (uint32_t block = 0; block != blocks; ++block)
+        {
+            if (data.size() > std::numeric_limits<uint32_t>::max())
+                throw std::length_error("too many postings");
+            block_offsets.push_back(static_cast<uint32_t>(data.size()));
+            encode_block(data, postings.subspan(size_t{ block } * BlockSize, std::min<size_t>(BlockSize, count - block * BlockSize)));
+        }
+
+        bytes_.resize(bytes_.size() - Padding);
+        const auto id = static_cast<ListId>(offsets_.size());
+        offsets_.push_back(bytes_.size());
+        write_varint(bytes_, count);
+        for (uint32_t block = 1; block < blocks; ++block)
+        {
+            const auto first = postings[size_t{ block } * BlockSize];
+            write_u32(bytes_, static_cast<uint32_t>(first.file));
+            write_u32(bytes_, raw(first.decl));
+            write_u32(bytes_, block_offsets[block]);
+        }
+        if (count != 0)
+        {
+            write_varint(bytes_, static_cast<uint32_t>(postings.front().file));
+            write_varint(bytes_, raw(postings.front().decl));
+        }
+        bytes_.insert(bytes_.end(), data.begin(), data.end());
+        bytes_.resize(bytes_.size() + Padding);
+        postings_ += count;
+        return id;
+    }
+
+    uint32_t PostingLists::count(ListId list) const
+    {
+        auto in = bytes_.data() + offsets_[list];
+        return read_varint(in);
+    }
+
+    std::vector<DeclarationId> PostingLists::decode(ListId list) const
+    {
+        std::vector<DeclarationId> result;
+        Cursor cursor(*this, list);
+        result.reserve(cursor.size());
+        for (; !cursor.at_end(); cursor.next())
+            result.push_back(cursor.value());
+        return result;
+    }
+
+    bool PostingLists::contains(ListId list, DeclarationId posting) const
+    {
+        Cursor cursor(*this, list);
+        cursor.advance_to(posting);
+        return !cursor.at_end() && cursor.value() == posting;
+    }
+
+    std::vector<DeclarationId> PostingLists::intersect(std::span<ListId const> lists) const
+    {
+        std::vector<DeclarationId> result;
+        if (lists.empty())
+            return result;
+
+        std::vector<Cursor> cursors;
+        cursors.reserve(lists.size());
+        for (auto list : lists)
+            cursors.emplace_back(*this, list);
+        std::ranges::sort(cursors, {}, &Cursor::size);
+
+        auto & shortest = cursors.front();
+        for (; !shortest.at_end(); shortest.next())
+        {
+            const auto candidate = shortest.value();
+            bool everywhere = true;
+            for (size_t i = 1; i != cursors.size() && everywhere; ++i)
+            {
+                cursors[i].advance_to(candidate);
+                if (cursors[i].at_end())
+                    return result;
+                everywhere = cursors[i].value() == candidate;
+            }
+            if (everywhere)
+                result.push_back(candidate);
+        }
+        return result;
+    }
+
+    size_t PostingLists::heap_bytes() const
+    {
+        return ifc::heap_bytes(bytes_) + ifc::heap_bytes(offsets_);
+    }
+
+    PostingLists::Cursor::Cursor(PostingLists const& lists, ListId list)
+    {
+        auto in = lists.bytes_.data() + lists.offsets_[list];
+        count_ = read_varint(in);
+        blocks_ = block_count(count_);
+        if (count_ == 0)
+            return;
+
+        skips_ = in;
+        in += size_t{ blocks_ - 1 } * SkipEntrySize;
+        const auto file = read_varint(in);
+        first_ = { FileId{ file }, decl_of(read_varint(in)) };
+        first_block_ = in;
+        enter(0);
+    }
+
+    void PostingLists::Cursor::advance_to(DeclarationId target)
+    {
+        if (at_end() || value() >= target)
+            return;
+
+        if (values_[block_size_ - 1] < target)
+        {
+            // The last block starting at or before the target holds it, if any of them does.
+            uint32_t low = block_ + 1, high = blocks_;
+            while (low != high)
+            {
+                const auto middle = low + (high - low) / 2;
+                if (block_first(middle) <= target)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            if (low - 1 == block_)
+            {
+                // The next block starts after the target.
+                enter(block_ + 1);
+                return;
+            }
+            enter(low - 1);
+        }
+
+        position_ = static_cast<uint32_t>(std::lower_bound(values_.begin() + position_, values_.begin() + block_size_, target) - values_.begin());
+        if (position_ == block_size_)
+            enter(block_ + 1);
+    }
+
+    void PostingLists::Cursor::enter(uint32_t block)
+    {
+        block_ = block;
+        position_ = 0;
+        if (block == blocks_)
+            return;
+
+        block_size_ = std::min(BlockSize, count_ - block * BlockSize);
+        auto data = first_block_;
+        if (block != 0)
+        {
+            uint32_t offset;
+            std::memcpy(&offset, skips_ + size_t{ block - 1 } * SkipEntrySize + 2 * sizeof(uint32_t), sizeof(offset));
+            data += offset;
+        }
+        decode_block(data, block_first(block), block_size_, values_.data());
+    }
+
+    DeclarationId PostingLists::Cursor::block_first(uint32_t block) const
+    {
+        if (block == 0)
+            return first_;
+        uint32_t entry[2];
+        std::memcpy(entry, skips_ + size_t{ block - 1 } * SkipEntrySize, sizeof(entry));
+        return { FileId{ entry[0] }, decl_of(entry[1]) };
+    }
+}
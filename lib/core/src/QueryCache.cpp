@@ -0,0 +1,138 @@
+#include "ifc/QueryCache.h"
+#include "ifc/MemoryUsage.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ifc
+{
+    void QueryCache::Reads::add(SHA256 const& checksum)
+    {
+        const auto same = [&checksum](SHA256 const& read) { return read.data == checksum.data; };
+        if (std::ranges::none_of(checksums_, same))
+            checksums_.push_back(checksum);
+    }
+
+    size_t QueryCache::ChecksumHasher::operator() (SHA256 const& checksum) const noexcept
+    {
+        // Already uniformly distributed.
+        size_t result;
+        std::memcpy(&result, checksum.data.data(), sizeof(result));
+        return result;
+    }
+
+    std::string QueryCache::make_key(std::string_view kind, std::string_view key)
+    {
+        std::string result;
+        result.reserve(kind.size() + 1 + key.size());
+        result.append(kind).push_back('\0');
+        result.append(key);
+        return result;
+    }
+
+    std::shared_ptr<void const> QueryCache::find(std::string const& key, std::type_index type)
+    {
+        {
+            std::scoped_lock lock(mutex_);
+            if (auto found = entries_.find(key); found != entries_.end() && found->second.type == type)
+            {
+                ++hits_;
+                return found->second.answer;
+            }
+        }
+        ++misses_;
+        return nullptr;
+    }
+
+    void QueryCache::insert(std::string key, std::type_index type, std::shared_ptr<void const> answer, Reads reads, uint64_t invalidations)
+    {
+        std::scoped_lock lock(mutex_);
+        // A BMI read by the computation may have changed under it.
+        if (invalidations_.load(std::memory_order_relaxed) != invalidations)
+            return;
+
+        // Computed concurrently, otherwise new or cached before as another type.
+        auto entry = entries_.find(key);
+        if (entry != entries_.end() && entry->second.type == type)
+            return;
+        Entry cached{ type, std::move(answer), std::move(reads.checksums_) };
+        if (entry == entries_.end())
+            entry = entries_.emplace(key, std::move(cached)).first;
+        else
+            entry->second = std::move(cached);
+        for (auto const & checksum : entry->second.reads)
+            readers_[checksum].push_back(key);
+    }
+
+    size_t QueryCache::invalidate(SHA256 const& checksum)
+    {
+        std::scoped_lock lock(mutex_);
+        ++invalidations_;
+
+        const auto found = readers_.find(checksum);
+        if (found == readers_.end())
+            return 0;
+        const auto keys = std::move(found->second);
+        readers_.erase(found);
+
+        // Keys of entries dropped before, or replaced by ones that did not read the BMI, are left over.
+        size_t dropped = 0;
+        for (auto const & key : keys)
+        {
+            const auto entry = entries_.find(key);
+            if (entry == entries_.end())
+                continue;
+            const auto & reads = entry->second.reads;
+            if (std::ranges::none_of(reads, [&](SHA256 const& read) { return read.data == checksum.data; }))
+                continue;
+            entries_.erase(entry);
+            ++dropped;
+        }
+        invalidated_ += dropped;
+        return dropped;
+    }
+
+    size_t QueryCache::invalidate(Environment::Reload const& reload)
+    {
+        if (!reload.reloaded || reload.diff.identical)
+            return 0;
+        return invalidate(reload.previous_checksum);
+    }
+
+    void QueryCache::clear()
+    {
+        std::scoped_lock lock(mutex_);
+        ++invalidations_;
+        invalidated_ += entries_.size();
+        entries_.clear();
+        readers_.clear();
+    }
+
+    QueryCache::Stats QueryCache::stats() const
+    {
+        std::scoped_lock lock(mutex_);
+        return { hits_.load(), misses_.load(), invalidated_ };
+    }
+
+    size_t QueryCache::size() const
+    {
+        std::scoped_lock lock(mutex_);
+        return entries_.size();
+    }
+
+    size_t QueryCache::heap_bytes() const
+    {
+        // Of the bookkeeping, the answers are opaque.
+        std::scoped_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(entries_) + ifc::heap_bytes(readers_);
+        for (auto const & [key, entry] : entries_)
+            result += ifc::heap_bytes(key) + ifc::heap_bytes(entry.reads);
+        for (auto const & [checksum, keys] : readers_)
+        {
+            result += ifc::heap_bytes(keys);
+            for (auto const & key : keys)
+                result += ifc::heap_bytes(key);
+        }
+        return result;
+    }
+}
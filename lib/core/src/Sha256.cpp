@@ -0,0 +1,100 @@
+#include "Sha256.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace ifc
+{
+    namespace
+    {
+        constexpr std::array<uint32_t, 64> ROUND_CONSTANTS = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+        };
+
+        constexpr size_t BLOCK_SIZE = 64;
+
+        uint32_t load_big_endian(std::byte const* bytes)
+        {
+            return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16
+                 | static_cast<uint32_t>(bytes[2]) << 8  | static_cast<uint32_t>(bytes[3]);
+        }
+
+        void compress(std::array<uint32_t, 8> & state, std::byte const* block)
+        {
+            std::array<uint32_t, 64> w;
+            for (size_t i = 0; i != 16; ++i)
+                w[i] = load_big_endian(block + i * 4);
+            for (size_t i = 16; i != 64; ++i)
+            {
+                const auto s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                const auto s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            auto [a, b, c, d, e, f, g, h] = state;
+            for (size_t i = 0; i != 64; ++i)
+            {
+                const auto s1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+                const auto choice = (e & f) ^ (~e & g);
+                const auto t1 = h + s1 + choice + ROUND_CONSTANTS[i] + w[i];
+                const auto s0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+                const auto majority = (a & b) ^ (a & c) ^ (b & c);
+                const auto t2 = s0 + majority;
+
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+
+            state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        }
+    }
+
+    SHA256 compute_sha256(std::span<std::byte const> data)
+    {
+        std::array<uint32_t, 8> state = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+        };
+
+        const auto full_blocks = data.size() / BLOCK_SIZE;
+        for (size_t i = 0; i != full_blocks; ++i)
+            compress(state, data.data() + i * BLOCK_SIZE);
+
+        // The rest of the data, 0x80, zero padding and the length in bits fill one or two final blocks.
+        std::array<std::byte, 2 * BLOCK_SIZE> tail{};
+        const auto rest = data.size() % BLOCK_SIZE;
+        std::memcpy(tail.data(), data.data() + full_blocks * BLOCK_SIZE, rest);
+        tail[rest] = std::byte{ 0x80 };
+
+        const auto tail_size = rest + 1 + 8 <= BLOCK_SIZE ? BLOCK_SIZE : 2 * BLOCK_SIZE;
+        const uint64_t bits = static_cast<uint64_t>(data.size()) * 8;
+        for (size_t i = 0; i != 8; ++i)
+            tail[tail_size - 1 - i] = static_cast<std::byte>(bits >> (i * 8));
+
+        for (size_t offset = 0; offset != tail_size; offset += BLOCK_SIZE)
+            compress(state, tail.data() + offset);
+
+        SHA256 result;
+        for (size_t i = 0; i != state.size(); ++i)
+        {
+            for (size_t j = 0; j != 4; ++j)
+                result.data[i * 4 + j] = static_cast<std::byte>(state[i] >> (24 - j * 8));
+        }
+        return result;
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "ifc/FileHeader.h"
+
+#include <cstddef>
+#include <span>
+
+namespace ifc
+{
+    SHA256 compute_sha256(std::span<std::byte const>);
+}
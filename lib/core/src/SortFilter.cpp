@@ -0,0 +1,106 @@
+#include "ifc/SortFilter.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+namespace ifc
+{
+    namespace
+    {
+        uint32_t load(std::byte const* words, size_t position)
+        {
+            uint32_t word;
+            std::memcpy(&word, words + position * sizeof(word), sizeof(word));
+            return word;
+        }
+    }
+
+    void find_tagged(void const* words, size_t count, uint32_t tag_mask, uint32_t tag, std::vector<uint32_t>& positions)
+    {
+        constexpr size_t BlockSize = 64;
+        constexpr size_t ChunkSize = sizeof(uint64_t);
+
+        const auto bytes = static_cast<std::byte const*>(words);
+        positions.clear();
+
+        size_t start = 0;
+        for (; start + BlockSize <= count; start += BlockSize)
+        {
+            // The compare loop is vectorized, matches are then looked for 8 flags at a time.
+            uint8_t matches[BlockSize];
+            for (size_t i = 0; i != BlockSize; ++i)
+                matches[i] = (load(bytes, start + i) & tag_mask) == tag;
+
+            for (size_t chunk = 0; chunk != BlockSize; chunk += ChunkSize)
+            {
+                uint64_t any;
+                std::memcpy(&any, matches + chunk, sizeof(any));
+                if (any == 0)
+                    continue;
+                for (size_t i = chunk; i != chunk + ChunkSize; ++i)
+                {
+                    if (matches[i])
+                        positions.push_back(static_cast<uint32_t>(start + i));
+                }
+            }
+        }
+
+        for (; start != count; ++start)
+        {
+            if ((load(bytes, start) & tag_mask) == tag)
+                positions.push_back(static_cast<uint32_t>(start));
+        }
+    }
+
+    void count_tagged(void const* words, size_t count, uint32_t tag_mask, std::span<size_t> counts)
+    {
+        constexpr size_t Lanes = 4;
+
+        const auto bytes = static_cast<std::byte const*>(words);
+        const size_t tags = size_t{ tag_mask } + 1;
+        assert((tags & tag_mask) == 0 && counts.size() >= tags);
+
+        std::vector<size_t> lanes(Lanes * tags);
+        size_t start = 0;
+        for (; start + Lanes <= count; start += Lanes)
+        {
+            for (size_t lane = 0; lane != Lanes; ++lane)
+                ++lanes[lane * tags + (load(bytes, start + lane) & tag_mask)];
+        }
+        for (; start != count; ++start)
+            ++lanes[load(bytes, start) & tag_mask];
+
+        for (size_t lane = 0; lane != Lanes; ++lane)
+        {
+            for (size_t tag = 0; tag != tags; ++tag)
+                counts[tag] += lanes[lane * tags + tag];
+        }
+    }
+
+    bool references_within(void const* words, size_t count, size_t stride, uint32_t tag_mask, std::span<uint32_t const> limits)
+    {
+        constexpr size_t BlockSize = 1024;
+
+        const auto bytes = static_cast<std::byte const*>(words);
+        const auto shift = std::popcount(tag_mask);
+        assert(limits.size() > tag_mask);
+
+        // Blocks are checked whole, a corrupted one stops the check at its end.
+        for (size_t start = 0; start < count; start += BlockSize)
+        {
+            const auto end = std::min(count, start + BlockSize);
+            uint32_t outside = 0;
+            for (size_t i = start; i != end; ++i)
+            {
+                uint32_t word;
+                std::memcpy(&word, bytes + i * stride, sizeof(word));
+                outside |= static_cast<uint32_t>((word >> shift) >= limits[word & tag_mask]) & static_cast<uint32_t>(word != 0);
+            }
+            if (outside != 0)
+                return false;
+        }
+        return true;
+    }
+}
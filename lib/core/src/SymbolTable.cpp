@@ -0,0 +1,172 @@
+#include "ifc/SymbolTable.h"
+#include "ifc/MemoryUsage.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ifc
+{
+    struct SymbolTable::Shard
+    {
+        std::mutex mutex;
+        std::pmr::monotonic_buffer_resource texts;
+        size_t text_bytes = 0;
+        // Views into `texts`.
+        std::unordered_map<std::string_view, SymbolId> ids;
+    };
+
+    namespace
+    {
+        template<size_t Shards>
+        size_t shard_of(std::string_view text)
+        {
+            // High bits, the low ones pick the bucket in the map of the shard.
+            const auto hash = std::hash<std::string_view>{}(text);
+            return (hash >> 32 ^ hash >> 16) % Shards;
+        }
+    }
+
+    SymbolTable::SymbolTable()
+    {
+        for (auto & shard : shards_)
+            shard = std::make_unique<Shard>();
+    }
+
+    SymbolTable::~SymbolTable()
+    {
+        for (auto & segment : texts_)
+            delete[] segment.load(std::memory_order_relaxed);
+    }
+
+    // Under the lock of the shard.
+    SymbolId SymbolTable::intern(Shard& shard, std::string_view text)
+    {
+        if (auto found = shard.ids.find(text); found != shard.ids.end())
+            return found->second;
+
+        const auto copy = static_cast<char*>(shard.texts.allocate(text.size() + 1, 1));
+        std::copy(text.begin(), text.end(), copy);
+        copy[text.size()] = '\0';
+        shard.text_bytes += text.size() + 1;
+        const std::string_view stored(copy, text.size());
+
+        // Ids are dense across shards, so they are taken under one more lock.
+        std::scoped_lock lock(segments_mutex_);
+        const auto id = count_.load(std::memory_order_relaxed);
+        if (id == Segments << SegmentBits)
+            throw std::length_error("too many symbols");
+        auto & segment = texts_[id >> SegmentBits];
+        if (segment.load(std::memory_order_relaxed) == nullptr)
+            segment.store(new std::string_view[size_t{ 1 } << SegmentBits], std::memory_order_release);
+        segment.load(std::memory_order_relaxed)[id & ((1u << SegmentBits) - 1)] = stored;
+        count_.store(id + 1, std::memory_order_release);
+
+        shard.ids.emplace(stored, SymbolId{ id });
+        return SymbolId{ id };
+    }
+
+    std::vector<SymbolId> SymbolTable::build(File const& file)
+    {
+        // Texts grouped by shard, so each shard is locked once.
+        const auto count = file.text_symbol_count();
+        std::vector<std::string_view> texts(count);
+        std::vector<uint8_t> shard_of_text(count);
+        std::array<uint32_t, ShardCount + 1> starts{};
+        for (uint32_t i = 0; i != count; ++i)
+        {
+            texts[i] = file.get_string_view(file.symbol_text(i));
+            shard_of_text[i] = static_cast<uint8_t>(shard_of<ShardCount>(texts[i]));
+            ++starts[shard_of_text[i] + 1];
+        }
+        for (size_t shard = 0; shard != ShardCount; ++shard)
+            starts[shard + 1] += starts[shard];
+        std::vector<uint32_t> by_shard(count);
+        auto next = starts;
+        for (uint32_t i = 0; i != count; ++i)
+            by_shard[next[shard_of_text[i]]++] = i;
+
+        std::vector<SymbolId> result(count);
+        for (size_t shard = 0; shard != ShardCount; ++shard)
+        {
+            if (starts[shard] == starts[shard + 1])
+                continue;
+            check_cancellation();
+            std::scoped_lock lock(shards_[shard]->mutex);
+            for (auto i = starts[shard]; i != starts[shard + 1]; ++i)
+                result[by_shard[i]] = intern(*shards_[shard], texts[by_shard[i]]);
+        }
+        return result;
+    }
+
+    std::span<SymbolId const> SymbolTable::symbols(File const& file)
+    {
+        {
+            std::shared_lock lock(files_mutex_);
+            if (auto found = files_.find(&file); found != files_.end())
+                return *found->second;
+        }
+
+        // Built outside the lock: a table built concurrently by another thread is the same.
+        auto table = std::make_unique<std::vector<SymbolId> const>(build(file));
+        std::unique_lock lock(files_mutex_);
+        return *files_.try_emplace(&file, std::move(table)).first->second;
+    }
+
+    std::optional<SymbolId> SymbolTable::symbol(File const& file, TextOffset offset)
+    {
+        const auto local = file.text_symbol(offset);
+        if (!local)
+            return std::nullopt;
+        return symbols(file)[*local];
+    }
+
+    void SymbolTable::intern(std::span<File const* const> files, Executor& executor)
+    {
+        const auto cancellation = current_cancellation();
+        executor.run(files.size(), [&](size_t i) {
+            const CancellationScope scope(cancellation);
+            symbols(*files[i]);
+        });
+    }
+
+    std::optional<SymbolId> SymbolTable::find(std::string_view text) const
+    {
+        auto & shard = *shards_[shard_of<ShardCount>(text)];
+        std::scoped_lock lock(shard.mutex);
+        if (auto found = shard.ids.find(text); found != shard.ids.end())
+            return found->second;
+        return std::nullopt;
+    }
+
+    std::string_view SymbolTable::text(SymbolId symbol) const
+    {
+        const auto id = static_cast<uint32_t>(symbol);
+        if (id >= size())
+            throw std::out_of_range("unknown symbol");
+        return texts_[id >> SegmentBits].load(std::memory_order_acquire)[id & ((1u << SegmentBits) - 1)];
+    }
+
+    void SymbolTable::forget(File const& file)
+    {
+        std::unique_lock lock(files_mutex_);
+        files_.erase(&file);
+    }
+
+    size_t SymbolTable::heap_bytes() const
+    {
+        size_t result = 0;
+        for (auto const & shard : shards_)
+        {
+            std::scoped_lock lock(shard->mutex);
+            result += sizeof(Shard) + ifc::heap_bytes(shard->ids) + shard->text_bytes;
+        }
+        const auto segments = (size() + (1u << SegmentBits) - 1) >> SegmentBits;
+        result += size_t{ segments } * (sizeof(std::string_view) << SegmentBits);
+
+        std::shared_lock lock(files_mutex_);
+        result += ifc::heap_bytes(files_);
+        for (auto const & [file, table] : files_)
+            result += sizeof(*table) + ifc::heap_bytes(*table);
+        return result;
+    }
+}
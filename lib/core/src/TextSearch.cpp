@@ -0,0 +1,68 @@
+#include "ifc/TextSearch.h"
+
+#include "ifc/File.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace ifc
+{
+    void find_text_ranges(File const & file, std::string_view pattern, TextMatch match, std::vector<TextRange>& ranges)
+    {
+        ranges.clear();
+
+        const char* table = file.string_table().data();
+        const size_t size = file.string_table().size();
+        if (pattern.empty())
+        {
+            if (size != 0)
+                ranges.push_back({ 0, static_cast<uint32_t>(size) });
+            return;
+        }
+        if (pattern.size() > size)
+            return;
+
+        // Candidate positions are in [position, last_candidate].
+        const size_t last_candidate = size - pattern.size();
+        size_t position = 0;
+        while (position <= last_candidate)
+        {
+            const auto hit = static_cast<const char*>(std::memchr(table + position, pattern.front(), last_candidate - position + 1));
+            if (!hit)
+                break;
+
+            const auto candidate = static_cast<size_t>(hit - table);
+            if (std::memcmp(hit + 1, pattern.data() + 1, pattern.size() - 1) != 0)
+            {
+                position = candidate + 1;
+                continue;
+            }
+
+            if (match == TextMatch::Prefix)
+            {
+                ranges.push_back({ static_cast<uint32_t>(candidate), static_cast<uint32_t>(candidate + 1) });
+                position = candidate + 1;
+                continue;
+            }
+
+            // Every offset of the string up to its last occurrence of the pattern contains it.
+            // The pattern has no terminators, so the occurrence lies within the string.
+            size_t start = candidate;
+            while (start != 0 && table[start - 1] != '\0')
+                --start;
+            const auto terminator = static_cast<const char*>(std::memchr(hit, '\0', size - candidate));
+            const auto string_end = terminator ? static_cast<size_t>(terminator - table) : size;
+            const auto last = candidate + std::string_view(hit, string_end - candidate).rfind(pattern);
+            ranges.push_back({ static_cast<uint32_t>(start), static_cast<uint32_t>(last + 1) });
+            position = string_end + 1;
+        }
+    }
+
+    bool contains(std::span<TextRange const> ranges, TextOffset text)
+    {
+        const auto offset = static_cast<uint32_t>(text);
+        const auto range = std::ranges::upper_bound(ranges, offset, {}, &TextRange::start);
+        return range != ranges.begin() && offset < std::prev(range)->end;
+    }
+}
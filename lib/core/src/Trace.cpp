@@ -0,0 +1,92 @@
+#include "ifc/Trace.h"
+
+#include <atomic>
+#include <cstdio>
+
+namespace ifc
+{
+    namespace
+    {
+        std::atomic<TraceSink*> installed_sink = nullptr;
+
+        void write_json_string(std::ostream& out, std::string_view text)
+        {
+            out << '"';
+            for (const char c : text)
+            {
+                switch (c)
+                {
+                case '"':  out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        out << escaped;
+                    }
+                    else
+                    {
+                        out << c;
+                    }
+                }
+            }
+            out << '"';
+        }
+
+        // Trace event timestamps are in microseconds.
+        double microseconds(TraceSink::Clock::duration duration)
+        {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        }
+    }
+
+    void set_trace_sink(TraceSink* sink)
+    {
+        installed_sink.store(sink, std::memory_order_release);
+    }
+
+    TraceSink* trace_sink()
+    {
+        return installed_sink.load(std::memory_order_acquire);
+    }
+
+    ChromeTraceWriter::ChromeTraceWriter(std::ostream& out)
+        : out_(out)
+        , origin_(Clock::now())
+    {
+        out_ << "{\"traceEvents\":[";
+    }
+
+    ChromeTraceWriter::~ChromeTraceWriter()
+    {
+        out_ << "\n]}\n";
+        out_.flush();
+    }
+
+    void ChromeTraceWriter::complete(std::string_view name, std::string_view category, std::string_view detail,
+                                     Clock::time_point start, Clock::duration duration)
+    {
+        std::scoped_lock lock(mutex_);
+        const auto tid = threads_.try_emplace(std::this_thread::get_id(), threads_.size() + 1).first->second;
+
+        out_ << (first_event_ ? "\n" : ",\n");
+        first_event_ = false;
+        out_ << "{\"name\":";
+        write_json_string(out_, name);
+        out_ << ",\"cat\":";
+        write_json_string(out_, category);
+        out_ << ",\"ph\":\"X\",\"ts\":" << microseconds(start - origin_)
+             << ",\"dur\":" << microseconds(duration)
+             << ",\"pid\":1,\"tid\":" << tid;
+        if (!detail.empty())
+        {
+            out_ << ",\"args\":{\"detail\":";
+            write_json_string(out_, detail);
+            out_ << '}';
+        }
+        out_ << '}';
+    }
+}
@@ -0,0 +1,323 @@
+#include "ifc/TrigramIndex.h"
+#include "ifc/MemoryUsage.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <queue>
+
+namespace ifc
+{
+    namespace
+    {
+        constexpr uint32_t NotInAlphabet = ~uint32_t{ 0 };
+
+        // Letters case-insensitively, then digits, then `_`.
+        uint32_t letter_code(char c)
+        {
+            if (c >= 'a' && c <= 'z')
+                return static_cast<uint32_t>(c - 'a');
+            if (c >= 'A' && c <= 'Z')
+                return static_cast<uint32_t>(c - 'A');
+            if (c >= '0' && c <= '9')
+                return 26 + static_cast<uint32_t>(c - '0');
+            if (c == '_')
+                return 36;
+            return NotInAlphabet;
+        }
+
+        bool is_identifier(std::string_view text)
+        {
+            return !text.empty() && std::ranges::all_of(text, [](char c) { return letter_code(c) != NotInAlphabet; });
+        }
+
+        // Distinct trigrams of the text, skipping those with characters out of the alphabet.
+        void trigrams(std::string_view text, uint32_t alphabet, std::vector<uint32_t> & out)
+        {
+            out.clear();
+            for (size_t i = 0; i + 3 <= text.size(); ++i)
+            {
+                const auto a = letter_code(text[i]);
+                const auto b = letter_code(text[i + 1]);
+                const auto c = letter_code(text[i + 2]);
+                if (a != NotInAlphabet && b != NotInAlphabet && c != NotInAlphabet)
+                    out.push_back((a * alphabet + b) * alphabet + c);
+            }
+            std::ranges::sort(out);
+            const auto [last, end] = std::ranges::unique(out);
+            out.erase(last, end);
+        }
+
+        char lower(char c)
+        {
+            return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        size_t find_ignoring_case(std::string_view text, std::string_view pattern)
+        {
+            const auto found = std::ranges::search(text, pattern, {}, lower, lower);
+            return found.empty() ? std::string_view::npos : static_cast<size_t>(found.begin() - text.begin());
+        }
+    }
+
+    class TrigramIndex::PostingList
+    {
+    public:
+        static constexpr uint32_t BlockSize = 128;
+
+        void append(uint32_t symbol)
+        {
+            if (count_ % BlockSize == 0)
+            {
+                // The first symbol of a block is only in the block table.
+                blocks_.push_back({ symbol, static_cast<uint32_t>(bytes_.size()) });
+            }
+            else
+            {
+                for (auto delta = symbol - last_; ; delta >>= 7)
+                {
+                    if (delta < 0x80)
+                    {
+                        bytes_.push_back(static_cast<uint8_t>(delta));
+                        break;
+                    }
+                    bytes_.push_back(static_cast<uint8_t>(delta | 0x80));
+                }
+            }
+            last_ = symbol;
+            ++count_;
+        }
+
+        uint32_t size() const { return count_; }
+
+        size_t heap_bytes() const { return ifc::heap_bytes(bytes_) + ifc::heap_bytes(blocks_); }
+
+        // Symbols of the list in increasing order, decoded as they are visited.
+        class Cursor
+        {
+        public:
+            explicit Cursor(PostingList const& list)
+                : list_(&list)
+            {
+                enter(0);
+            }
+
+            bool at_end() const { return position_ == list_->count_; }
+            uint32_t value() const { return value_; }
+            uint32_t size() const { return list_->count_; }
+
+            void next()
+            {
+                if (++position_ == list_->count_)
+                    return;
+                if (position_ % BlockSize == 0)
+                {
+                    enter(position_ / BlockSize);
+                    return;
+                }
+                uint32_t delta = 0;
+                for (int shift = 0; ; shift += 7)
+                {
+                    const auto byte = list_->bytes_[offset_++];
+                    delta |= static_cast<uint32_t>(byte & 0x7f) << shift;
+                    if (byte < 0x80)
+                        break;
+                }
+                value_ += delta;
+            }
+
+            // To the first symbol not below the target, skipping the blocks that end before it.
+            void advance_to(uint32_t target)
+            {
+                if (at_end() || value_ >= target)
+                    return;
+                auto const & blocks = list_->blocks_;
+                const auto block = position_ / BlockSize;
+                const auto later = std::upper_bound(blocks.begin() + block + 1, blocks.end(), target,
+                    [](uint32_t symbol, Block const & b) { return symbol < b.first; });
+                if (const auto last_start = static_cast<uint32_t>(later - blocks.begin()) - 1; last_start > block)
+                    enter(last_start);
+                while (!at_end() && value_ < target)
+                    next();
+            }
+
+        private:
+            void enter(uint32_t block)
+            {
+                position_ = block * BlockSize;
+                if (position_ >= list_->count_)
+                {
+                    position_ = list_->count_;
+                    return;
+                }
+                value_ = list_->blocks_[block].first;
+                offset_ = list_->blocks_[block].offset;
+            }
+
+            PostingList const* list_;
+            uint32_t position_ = 0;
+            uint32_t offset_ = 0;
+            uint32_t value_ = 0;
+        };
+
+    private:
+        struct Block
+        {
+            uint32_t first;  // Symbol
+            uint32_t offset; // In bytes_ of the delta of the second symbol
+        };
+
+        std::vector<uint8_t> bytes_;
+        std::vector<Block> blocks_;
+        uint32_t last_ = 0;
+        uint32_t count_ = 0;
+    };
+
+    TrigramIndex::TrigramIndex()
+        : lists_(Alphabet * Alphabet * Alphabet)
+    {
+    }
+
+    TrigramIndex::~TrigramIndex() = default;
+
+    void TrigramIndex::update(SymbolTable const& symbols)
+    {
+        std::unique_lock lock(mutex_);
+        std::vector<uint32_t> keys;
+        const auto size = symbols.size();
+        for (; indexed_ < size; ++indexed_)
+        {
+            const SymbolId symbol{ indexed_ };
+            const auto text = symbols.text(symbol);
+            if (!is_identifier(text))
+                continue;
+            identifiers_.push_back(symbol);
+            trigrams(text, Alphabet, keys);
+            for (auto key : keys)
+                lists_[key].append(indexed_);
+        }
+    }
+
+    std::vector<TrigramIndex::Match> TrigramIndex::search(SymbolTable const& symbols, std::string_view pattern, SearchOptions options) const
+    {
+        std::shared_lock lock(mutex_);
+        std::vector<Match> matches;
+
+        std::vector<uint32_t> keys;
+        trigrams(pattern, Alphabet, keys);
+        if (keys.empty())
+        {
+            for (auto symbol : identifiers_)
+            {
+                if (find_ignoring_case(symbols.text(symbol), pattern) != std::string_view::npos)
+                    matches.push_back({ symbol, 0 });
+            }
+        }
+        else
+        {
+            std::vector<PostingList::Cursor> cursors;
+            for (auto key : keys)
+                cursors.emplace_back(lists_[key]);
+            std::ranges::sort(cursors, {}, &PostingList::Cursor::size);
+            const auto total = static_cast<uint32_t>(cursors.size());
+            const auto required = std::clamp(static_cast<uint32_t>(std::ceil(options.min_shared * static_cast<float>(total))), 1u, total);
+
+            if (required == total)
+            {
+                // Intersection, driven by the shortest list.
+                auto & shortest = cursors.front();
+                for (; !shortest.at_end(); shortest.next())
+                {
+                    const auto candidate = shortest.value();
+                    bool everywhere = true;
+                    for (size_t i = 1; i != cursors.size() && everywhere; ++i)
+                    {
+                        cursors[i].advance_to(candidate);
+                        everywhere = !cursors[i].at_end() && cursors[i].value() == candidate;
+                    }
+                    if (everywhere)
+                        matches.push_back({ SymbolId{ candidate }, total });
+                    else if (std::ranges::any_of(cursors, &PostingList::Cursor::at_end))
+                        break;
+                }
+            }
+            else
+            {
+                // Merge, counting the lists of each symbol.
+                using Head = std::pair<uint32_t, size_t>; // Symbol, cursor
+                std::priority_queue<Head, std::vector<Head>, std::greater<>> heads;
+                for (size_t i = 0; i != cursors.size(); ++i)
+                {
+                    if (!cursors[i].at_end())
+                        heads.emplace(cursors[i].value(), i);
+                }
+                while (!heads.empty())
+                {
+                    const auto symbol = heads.top().first;
+                    uint32_t shared = 0;
+                    while (!heads.empty() && heads.top().first == symbol)
+                    {
+                        auto & cursor = cursors[heads.top().second];
+                        const auto i = heads.top().second;
+                        heads.pop();
+                        ++shared;
+                        cursor.next();
+                        if (!cursor.at_end())
+                            heads.emplace(cursor.value(), i);
+                    }
+                    if (shared >= required)
+                        matches.push_back({ SymbolId{ symbol }, shared });
+                }
+            }
+        }
+
+        struct Ranked
+        {
+            Match match;
+            bool prefix;
+            bool substring;
+            size_t length;
+        };
+        std::vector<Ranked> ranked;
+        ranked.reserve(matches.size());
+        for (auto match : matches)
+        {
+            const auto text = symbols.text(match.symbol);
+            const auto found = find_ignoring_case(text, pattern);
+            ranked.push_back({ match, found == 0, found != std::string_view::npos, text.size() });
+        }
+        const auto better = [](Ranked const & a, Ranked const & b) {
+            if (a.match.shared != b.match.shared)
+                return a.match.shared > b.match.shared;
+            if (a.prefix != b.prefix)
+                return a.prefix;
+            if (a.substring != b.substring)
+                return a.substring;
+            if (a.length != b.length)
+                return a.length < b.length;
+            return a.match.symbol < b.match.symbol;
+        };
+        const auto kept = std::min(options.limit, ranked.size());
+        std::ranges::partial_sort(ranked, ranked.begin() + static_cast<std::ptrdiff_t>(kept), better);
+
+        matches.clear();
+        for (size_t i = 0; i != kept; ++i)
+            matches.push_back(ranked[i].match);
+        return matches;
+    }
+
+    uint32_t TrigramIndex::indexed() const
+    {
+        std::shared_lock lock(mutex_);
+        return indexed_;
+    }
+
+    size_t TrigramIndex::heap_bytes() const
+    {
+        std::shared_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(lists_) + ifc::heap_bytes(identifiers_);
+        for (auto const & list : lists_)
+            result += list.heap_bytes();
+        return result;
+    }
+}
@@ -2,7 +2,29 @@
 
 #include "ifc/Environment.h"
 
+#include <span>
+
 namespace ifc
 {
+    struct MSVCConfigOptions
+    {
+        // Check that the BMI of every header unit and module exists while reading the config.
+        // Without the check a missing BMI is reported when the module is loaded.
+        bool check_bmi_files = true;
+        // Keep the resolved config in a binary cache next to it (see msvc_config_cache_path), which later reads
+        // map instead of parsing the JSON while the config keeps its size and modification time, and the
+        // directory for relative paths and check_bmi_files are unchanged. BMIs are not checked again then.
+        // The cache is written when missing or stale, failures to write it are ignored.
+        bool cache = false;
+    };
+
+    // `<config>.cache`.
+    std::filesystem::path msvc_config_cache_path(std::string const& path_to_config);
+
     Environment::Config read_msvc_config(std::string const& path_to_config, std::optional<std::filesystem::path> dir_for_relative_paths = std::nullopt);
+    Environment::Config read_msvc_config(std::string const& path_to_config, std::optional<std::filesystem::path> dir_for_relative_paths, MSVCConfigOptions options);
+
+    // Merges the configs of many translation units into one map to be shared by their Environments,
+    // so every header unit and module is stored once.
+    std::shared_ptr<Environment::ModuleMap const> read_msvc_configs(std::span<std::string const> paths_to_configs, std::optional<std::filesystem::path> dir_for_relative_paths = std::nullopt, MSVCConfigOptions options = {});
 }
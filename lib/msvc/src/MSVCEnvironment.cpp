@@ -1,61 +1,379 @@
 #include "ifc/MSVCEnvironment.h"
+#include "ifc/blob_reader.h"
 
 #include <nlohmann/json.hpp>
 
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <random>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
-static ifc::Environment::Config read_config(std::string const& path_to_config, std::optional<std::filesystem::path> const& dir_for_relative_paths)
+namespace
 {
-    std::ifstream file(path_to_config);
-    if (!file)
-        throw std::runtime_error("metadata is not found by path '" + path_to_config + "'");
+    // Extracts `Data.ImportedHeaderUnits` and `Data.ImportedModules` while parsing,
+    // without building a DOM of the whole config.
+    class ConfigExtractor : public nlohmann::json_sax<nlohmann::json>
+    {
+    public:
+        std::vector<ifc::Environment::Config::HeaderUnit> header_units;
+        std::vector<ifc::Environment::Config::Module> modules;
 
-    nlohmann::json metadata;
-    file >> metadata;
-    auto const & data = metadata["Data"];
+        bool null() override { return true; }
+        bool boolean(bool) override { return true; }
+        bool number_integer(number_integer_t) override { return true; }
+        bool number_unsigned(number_unsigned_t) override { return true; }
+        bool number_float(number_float_t, string_t const&) override { return true; }
+        bool binary(binary_t&) override { return true; }
 
-    ifc::Environment::Config config;
+        bool string(string_t& value) override
+        {
+            if (in_entry())
+            {
+                if (key_ == "BMI")
+                    entry_bmi_ = std::move(value);
+                else if (key_ == (kind() == Kind::HeaderUnits ? "Header" : "Name"))
+                    entry_name_ = std::move(value);
+            }
+            return true;
+        }
 
-    auto const & imported_header_units = data["ImportedHeaderUnits"];
-    for (auto const & unit : imported_header_units)
-    {
-        std::string header = unit["Header"];
-        std::filesystem::path bmi = static_cast<std::string>(unit["BMI"]);
-        if (dir_for_relative_paths && bmi.is_relative())
-            bmi = *dir_for_relative_paths / bmi;
+        bool start_object(std::size_t) override
+        {
+            push(false);
+            if (in_entry())
+            {
+                entry_name_.reset();
+                entry_bmi_.reset();
+            }
+            return true;
+        }
+
+        bool end_object() override
+        {
+            if (in_entry())
+            {
+                if (!entry_name_ || !entry_bmi_)
+                    throw std::runtime_error("malformed metadata: an entry without a name or BMI");
+
+                if (kind() == Kind::HeaderUnits)
+                    header_units.push_back({ std::move(*entry_name_), std::move(*entry_bmi_) });
+                else
+                    modules.push_back({ std::move(*entry_name_), std::move(*entry_bmi_) });
+            }
+            frames_.pop_back();
+            return true;
+        }
+
+        bool start_array(std::size_t) override
+        {
+            push(true);
+            return true;
+        }
+
+        bool end_array() override
+        {
+            frames_.pop_back();
+            return true;
+        }
+
+        bool key(string_t& value) override
+        {
+            key_ = std::move(value);
+            return true;
+        }
+
+        bool parse_error(std::size_t position, std::string const&, nlohmann::json::exception const& error) override
+        {
+            throw std::runtime_error("malformed metadata at " + std::to_string(position) + ": " + error.what());
+        }
+
+    private:
+        enum class Kind { Other, HeaderUnits, Modules };
 
+        struct Frame
+        {
+            bool is_array;
+            std::string key; // Key of the value in its parent object, empty in arrays and for the root
+        };
+
+        void push(bool is_array)
+        {
+            const bool parent_is_object = !frames_.empty() && !frames_.back().is_array;
+            frames_.push_back({ is_array, parent_is_object ? std::move(key_) : std::string() });
+            key_.clear();
+        }
+
+        // root { "Data": { "Imported...": [ entry { ... } ] } }
+        Kind kind() const
+        {
+            if (frames_.size() < 3 || frames_[1].key != "Data" || !frames_[2].is_array)
+                return Kind::Other;
+            if (frames_[2].key == "ImportedHeaderUnits")
+                return Kind::HeaderUnits;
+            if (frames_[2].key == "ImportedModules")
+                return Kind::Modules;
+            return Kind::Other;
+        }
+
+        bool in_entry() const
+        {
+            return frames_.size() == 4 && !frames_[3].is_array && kind() != Kind::Other;
+        }
+
+        std::vector<Frame> frames_;
+        std::string key_;
+        std::optional<std::string> entry_name_;
+        std::optional<std::string> entry_bmi_;
+    };
+
+    void check_bmi_file(std::filesystem::path const& bmi, const char* kind, std::string const& name)
+    {
         if (!is_regular_file(bmi))
         {
             std::ostringstream ss;
-            ss << "cannot find BMI file " << bmi << " for header '" << header << "'";
+            ss << "cannot find BMI file " << bmi << " for " << kind << " '" << name << "'";
             throw std::runtime_error(std::move(ss).str());
         }
+    }
+}
+
+namespace
+{
+    // Binary cache of a resolved config: the header, then `string_count + 1` offsets into the text, then a
+    // (name, BMI) pair of string ids per header unit and per module, then the text of the interned strings.
+    struct CacheHeader
+    {
+        char magic[8];
+        uint64_t config_size;
+        int64_t config_time;
+        uint64_t settings; // See cache_settings
+        uint32_t header_unit_count;
+        uint32_t module_count;
+        uint32_t string_count;
+        uint32_t text_size;
+    };
 
-        config.imported_header_units.push_back({ std::move(header), std::move(bmi) });
+    constexpr char cache_magic[8] = { 'I', 'F', 'C', 'C', 'F', 'G', '1', '\0' };
+
+    // FNV-1a, stable across runs unlike std::hash.
+    uint64_t fnv1a(std::string_view text, uint64_t hash = 0xcbf29ce484222325)
+    {
+        for (char c : text)
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+        return hash;
     }
 
-    auto const & imported_modules = data["ImportedModules"];
-    for (auto const & module : imported_modules)
+    // Everything other than the config that the resolved paths depend on.
+    uint64_t cache_settings(std::optional<std::filesystem::path> const& dir_for_relative_paths, ifc::MSVCConfigOptions options)
     {
-        std::string name = module["Name"];
-        std::filesystem::path bmi = static_cast<std::string>(module["BMI"]);
-        if (dir_for_relative_paths && bmi.is_relative())
-            bmi = *dir_for_relative_paths / bmi;
-        if (!is_regular_file(bmi))
+        std::string settings = options.check_bmi_files ? "checked" : "unchecked";
+        if (dir_for_relative_paths)
+            settings += ":" + dir_for_relative_paths->string();
+        return fnv1a(settings);
+    }
+
+    struct CacheKey
+    {
+        uint64_t config_size;
+        int64_t config_time;
+        uint64_t settings;
+    };
+
+    std::optional<ifc::Environment::Config> read_cache(std::filesystem::path const& path, CacheKey key)
+    {
+        std::error_code error;
+        if (!is_regular_file(path, error))
+            return std::nullopt;
+
+        const auto blob = ifc::read_blob(path);
+        const auto bytes = blob->view();
+        CacheHeader header;
+        if (bytes.size() < sizeof(header))
+            return std::nullopt;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 || header.config_size != key.config_size
+            || header.config_time != key.config_time || header.settings != key.settings)
+            return std::nullopt;
+
+        const size_t entry_count = size_t{ header.header_unit_count } + header.module_count;
+        const size_t offsets_size = (size_t{ header.string_count } + 1) * sizeof(uint32_t);
+        const size_t entries_size = entry_count * 2 * sizeof(uint32_t);
+        if (bytes.size() != sizeof(header) + offsets_size + entries_size + header.text_size)
+            return std::nullopt;
+
+        std::vector<uint32_t> offsets(header.string_count + 1);
+        std::vector<uint32_t> entries(entry_count * 2);
+        std::memcpy(offsets.data(), bytes.data() + sizeof(header), offsets_size);
+        std::memcpy(entries.data(), bytes.data() + sizeof(header) + offsets_size, entries_size);
+        const std::string_view text(reinterpret_cast<char const*>(bytes.data()) + bytes.size() - header.text_size, header.text_size);
+
+        auto string = [&](uint32_t id) -> std::optional<std::string_view> {
+            if (id >= header.string_count || offsets[id] > offsets[id + 1] || offsets[id + 1] > text.size())
+                return std::nullopt;
+            return text.substr(offsets[id], offsets[id + 1] - offsets[id]);
+        };
+
+        ifc::Environment::Config config;
+        for (size_t i = 0; i != entry_count; ++i)
         {
-            std::ostringstream ss;
-            ss << "cannot find BMI file " << bmi << " for module '" << name << "'";
-            throw std::runtime_error(std::move(ss).str());
+            const auto name = string(entries[2 * i]);
+            const auto bmi = string(entries[2 * i + 1]);
+            if (!name || !bmi)
+                return std::nullopt;
+            if (i < header.header_unit_count)
+                config.imported_header_units.push_back({ std::string(*name), std::filesystem::path(*bmi) });
+            else
+                config.imported_modules.push_back({ std::string(*name), std::filesystem::path(*bmi) });
         }
+        return config;
+    }
+
+    void write_cache(std::filesystem::path const& path, CacheKey key, ifc::Environment::Config const& config)
+    {
+        std::vector<uint32_t> offsets{ 0 };
+        std::vector<uint32_t> entries;
+        std::string text;
+        std::unordered_map<std::string, uint32_t> ids;
+        auto intern = [&](std::string const& string) {
+            const auto [it, inserted] = ids.try_emplace(string, static_cast<uint32_t>(ids.size()));
+            if (inserted)
+            {
+                text += string;
+                offsets.push_back(static_cast<uint32_t>(text.size()));
+            }
+            entries.push_back(it->second);
+        };
+        for (auto const & [header, bmi] : config.imported_header_units)
+        {
+            intern(header);
+            intern(bmi.string());
+        }
+        for (auto const & [name, bmi] : config.imported_modules)
+        {
+            intern(name);
+            intern(bmi.string());
+        }
+
+        CacheHeader header{};
+        std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+        header.config_size = key.config_size;
+        header.config_time = key.config_time;
+        header.settings = key.settings;
+        header.header_unit_count = static_cast<uint32_t>(config.imported_header_units.size());
+        header.module_count = static_cast<uint32_t>(config.imported_modules.size());
+        header.string_count = static_cast<uint32_t>(ids.size());
+        header.text_size = static_cast<uint32_t>(text.size());
+
+        // Written aside and renamed, so that concurrent readers never see a partial cache.
+        auto temporary = path;
+        temporary += ".tmp" + std::to_string(std::random_device()());
+        {
+            std::ofstream out(temporary, std::ios::binary);
+            out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+            out.write(reinterpret_cast<char const*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+            out.write(reinterpret_cast<char const*>(entries.data()), entries.size() * sizeof(uint32_t));
+            out.write(text.data(), text.size());
+            if (!out)
+            {
+                out.close();
+                std::error_code error;
+                std::filesystem::remove(temporary, error);
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error)
+            std::filesystem::remove(temporary, error);
+    }
+}
+
+static ifc::Environment::Config parse_config(std::string const& path_to_config, std::optional<std::filesystem::path> const& dir_for_relative_paths, ifc::MSVCConfigOptions options)
+{
+    std::ifstream file(path_to_config, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("metadata is not found by path '" + path_to_config + "'");
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
 
-        config.imported_modules.push_back({ std::move(name), std::move(bmi) });
+    ConfigExtractor extractor;
+    nlohmann::json::sax_parse(std::move(contents).str(), &extractor);
+
+    auto resolve = [&](std::filesystem::path & bmi) {
+        if (dir_for_relative_paths && bmi.is_relative())
+            bmi = *dir_for_relative_paths / bmi;
+    };
+
+    ifc::Environment::Config config;
+
+    config.imported_header_units = std::move(extractor.header_units);
+    for (auto & [header, bmi] : config.imported_header_units)
+    {
+        resolve(bmi);
+        if (options.check_bmi_files)
+            check_bmi_file(bmi, "header", header);
+    }
+
+    config.imported_modules = std::move(extractor.modules);
+    for (auto & [name, bmi] : config.imported_modules)
+    {
+        resolve(bmi);
+        if (options.check_bmi_files)
+            check_bmi_file(bmi, "module", name);
     }
 
     return config;
 }
 
+static ifc::Environment::Config read_config(std::string const& path_to_config, std::optional<std::filesystem::path> const& dir_for_relative_paths, ifc::MSVCConfigOptions options)
+{
+    if (!options.cache)
+        return parse_config(path_to_config, dir_for_relative_paths, options);
+
+    std::error_code error;
+    const auto config_size = std::filesystem::file_size(path_to_config, error);
+    if (error)
+        throw std::runtime_error("metadata is not found by path '" + path_to_config + "'");
+    const CacheKey key{
+        .config_size = config_size,
+        .config_time = static_cast<int64_t>(std::filesystem::last_write_time(path_to_config).time_since_epoch().count()),
+        .settings = cache_settings(dir_for_relative_paths, options),
+    };
+
+    const auto cache_path = ifc::msvc_config_cache_path(path_to_config);
+    if (auto cached = read_cache(cache_path, key))
+        return std::move(*cached);
+
+    auto config = parse_config(path_to_config, dir_for_relative_paths, options);
+    write_cache(cache_path, key, config);
+    return config;
+}
+
+std::filesystem::path ifc::msvc_config_cache_path(std::string const& path_to_config)
+{
+    return path_to_config + ".cache";
+}
+
 ifc::Environment::Config ifc::read_msvc_config(std::string const& path_to_config, std::optional<std::filesystem::path> dir_for_relative_paths)
 {
-    return read_config(path_to_config, dir_for_relative_paths);
+    return read_config(path_to_config, dir_for_relative_paths, {});
+}
+
+ifc::Environment::Config ifc::read_msvc_config(std::string const& path_to_config, std::optional<std::filesystem::path> dir_for_relative_paths, MSVCConfigOptions options)
+{
+    return read_config(path_to_config, dir_for_relative_paths, options);
+}
+
+std::shared_ptr<ifc::Environment::ModuleMap const> ifc::read_msvc_configs(std::span<std::string const> paths_to_configs, std::optional<std::filesystem::path> dir_for_relative_paths, MSVCConfigOptions options)
+{
+    auto modules = std::make_shared<Environment::ModuleMap>();
+    for (auto const & path : paths_to_configs)
+        modules->add(read_config(path, dir_for_relative_paths, options));
+    return modules;
 }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Module.h"
+
+#include <ifc/DeclarationFwd.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace ifc
+{
+    class Environment;
+}
+
+namespace reflifc
+{
+    // ABI-relevant parts of the exported declarations of a module (and of the members of exported classes),
+    // one entry per declaration, in declaration order.
+    //
+    // Keys identify a declaration between two builds of the module: its sort, its qualified name, and the
+    // parameter types of functions so that overloads differ. Declarations left with the same key, like function
+    // templates differing only by their template parameters, are told apart by their order.
+    // Fingerprints hash the rest: types, access, linkage, function and object traits, the bases and data members
+    // of classes (see extract_layouts) and the enumerators of enumerations.
+    //
+    // Types are hashed by their spelling (see TypeRenderer) rather than by TypeHashIndex, whose hashes identify
+    // declarations by their index, which changes between builds.
+    struct AbiFingerprints
+    {
+        std::vector<uint64_t> keys;
+        std::vector<uint64_t> fingerprints;
+        std::vector<ifc::DeclIndex> decls;
+
+        size_t size() const { return keys.size(); }
+    };
+
+    // Without an Environment, types from other modules are all spelled alike, see TypeRenderer.
+    AbiFingerprints fingerprint_abi(Module, ifc::Environment* = nullptr);
+
+    struct AbiChange
+    {
+        enum class Kind : uint8_t
+        {
+            Added,
+            Removed,
+            Changed,
+        };
+
+        Kind kind;
+        ifc::DeclIndex before; // Null for added declarations
+        ifc::DeclIndex after;  // Null for removed declarations
+    };
+
+    // One hash join of the two tables: removed and changed declarations in the order of `before`,
+    // then added ones in the order of `after`.
+    std::vector<AbiChange> diff_abi(AbiFingerprints const& before, AbiFingerprints const& after);
+
+    std::vector<AbiChange> diff_abi(Module before, Module after, ifc::Environment* = nullptr);
+}
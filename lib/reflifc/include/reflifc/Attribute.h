@@ -1,15 +1,21 @@
 ﻿#pragma once
 
 #include "HashCombine.h"
+#include "TupleView.h"
 
 #include <ifc/FileFwd.h>
 #include <ifc/AttributeFwd.h>
 
 namespace reflifc
 {
+    struct Expression;
     struct Word;
 
+    struct AttributeScoped;
+    struct AttributeLabeled;
     struct AttributeCalled;
+    struct AttributeExpanded;
+    struct AttributeFactored;
 
     struct Attribute
     {
@@ -19,12 +25,42 @@ namespace reflifc
         {
         }
 
+        ifc::AttrSort sort() const;
+
         bool is_basic() const;
         Word as_basic() const;
 
+        // `scope::member`
+        bool            is_scoped() const;
+        AttributeScoped as_scoped() const;
+
+        // `label: attribute`
+        bool             is_labeled() const;
+        AttributeLabeled as_labeled() const;
+
         bool            is_called() const;
         AttributeCalled as_called() const;
 
+        // `attribute...`
+        bool              is_expanded() const;
+        AttributeExpanded as_expanded() const;
+
+        // `using factor: terms`
+        bool              is_factored() const;
+        AttributeFactored as_factored() const;
+
+        // An attribute argument that is an expression.
+        bool       is_elaborated() const;
+        Expression as_elaborated() const;
+
+        // Viewed in place in `heap.attr`.
+        bool               is_tuple() const;
+        TupleAttributeView as_tuple() const;
+
+        ifc::AttrIndex index() const { return index_; }
+
+        ifc::File const* containing_file() const { return ifc_; }
+
         auto operator<=>(Attribute const& other) const = default;
 
     private:
@@ -34,6 +70,46 @@ namespace reflifc
         ifc::AttrIndex index_;
     };
 
+    struct AttributeScoped
+    {
+        AttributeScoped(ifc::File const* ifc, ifc::AttrScoped const& attr)
+            : ifc_(ifc)
+            , attr_(&attr)
+        {
+        }
+
+        Word scope() const;
+        Word member() const;
+
+        auto operator<=>(AttributeScoped const& other) const = default;
+
+    private:
+        friend std::hash<AttributeScoped>;
+
+        ifc::File const* ifc_;
+        ifc::AttrScoped const* attr_;
+    };
+
+    struct AttributeLabeled
+    {
+        AttributeLabeled(ifc::File const* ifc, ifc::AttrLabeled const& attr)
+            : ifc_(ifc)
+            , attr_(&attr)
+        {
+        }
+
+        Word      label() const;
+        Attribute attribute() const;
+
+        auto operator<=>(AttributeLabeled const& other) const = default;
+
+    private:
+        friend std::hash<AttributeLabeled>;
+
+        ifc::File const* ifc_;
+        ifc::AttrLabeled const* attr_;
+    };
+
     struct AttributeCalled
     {
         AttributeCalled(ifc::File const* ifc, ifc::AttrCalled const& attr)
@@ -45,6 +121,9 @@ namespace reflifc
         Attribute function() const;
         Attribute arguments() const;
 
+        // The arguments one by one: the elements of a tuple, a single argument or none.
+        TupleAttributeView argument_list() const;
+
         auto operator<=>(AttributeCalled const& other) const = default;
 
     private:
@@ -53,6 +132,47 @@ namespace reflifc
         ifc::File const* ifc_;
         ifc::AttrCalled const* attr_;
     };
+
+    struct AttributeExpanded
+    {
+        AttributeExpanded(ifc::File const* ifc, ifc::AttrExpanded const& attr)
+            : ifc_(ifc)
+            , attr_(&attr)
+        {
+        }
+
+        Attribute operand() const;
+
+        auto operator<=>(AttributeExpanded const& other) const = default;
+
+    private:
+        friend std::hash<AttributeExpanded>;
+
+        ifc::File const* ifc_;
+        ifc::AttrExpanded const* attr_;
+    };
+
+    struct AttributeFactored
+    {
+        AttributeFactored(ifc::File const* ifc, ifc::AttrFactored const& attr)
+            : ifc_(ifc)
+            , attr_(&attr)
+        {
+        }
+
+        Word factor() const;
+
+        // The attributes the factor applies to, one by one.
+        TupleAttributeView terms() const;
+
+        auto operator<=>(AttributeFactored const& other) const = default;
+
+    private:
+        friend std::hash<AttributeFactored>;
+
+        ifc::File const* ifc_;
+        ifc::AttrFactored const* attr_;
+    };
 }
 
 template<>
@@ -60,7 +180,25 @@ struct std::hash<reflifc::Attribute>
 {
     size_t operator()(reflifc::Attribute attribute) const noexcept
     {
-        return reflifc::hash_combine(0, attribute.ifc_, attribute.index_);
+        return reflifc::hash_handle(attribute.ifc_, attribute.index_);
+    }
+};
+
+template<>
+struct std::hash<reflifc::AttributeScoped>
+{
+    size_t operator()(reflifc::AttributeScoped attribute_scoped) const noexcept
+    {
+        return reflifc::hash_combine(0, attribute_scoped.ifc_, attribute_scoped.attr_);
+    }
+};
+
+template<>
+struct std::hash<reflifc::AttributeLabeled>
+{
+    size_t operator()(reflifc::AttributeLabeled attribute_labeled) const noexcept
+    {
+        return reflifc::hash_combine(0, attribute_labeled.ifc_, attribute_labeled.attr_);
     }
 };
 
@@ -72,3 +210,21 @@ struct std::hash<reflifc::AttributeCalled>
         return reflifc::hash_combine(0, attribute_called.ifc_, attribute_called.attr_);
     }
 };
+
+template<>
+struct std::hash<reflifc::AttributeExpanded>
+{
+    size_t operator()(reflifc::AttributeExpanded attribute_expanded) const noexcept
+    {
+        return reflifc::hash_combine(0, attribute_expanded.ifc_, attribute_expanded.attr_);
+    }
+};
+
+template<>
+struct std::hash<reflifc::AttributeFactored>
+{
+    size_t operator()(reflifc::AttributeFactored attribute_factored) const noexcept
+    {
+        return reflifc::hash_combine(0, attribute_factored.ifc_, attribute_factored.attr_);
+    }
+};
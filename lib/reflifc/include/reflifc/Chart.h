@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "reflifc/decl/Parameter.h"
+#include "reflifc/index/ChartParameterIndex.h"
 
 #include "ViewOf.h"
 #include "HashCombine.h"
@@ -11,6 +12,7 @@
 namespace reflifc
 {
     struct ChartUnilevel;
+    struct ChartMultilevel;
 
     struct Chart
     {
@@ -20,9 +22,21 @@ namespace reflifc
         {
         }
 
-        ChartUnilevel as_unilevel() const;
+        bool            is_unilevel()   const { return sort() == ifc::ChartSort::Unilevel; }
+        ChartUnilevel   as_unilevel()   const;
+
+        bool            is_multilevel() const { return sort() == ifc::ChartSort::Multilevel; }
+        ChartMultilevel as_multilevel() const;
+
+        // Parameters of every level, outermost first, from the file's ChartParameterIndex.
+        ViewOf<Parameter> auto parameters() const
+        {
+            return ifc_->get_index<ChartParameterIndex>().parameters(index_)
+                | std::views::transform([ifc = ifc_] (ifc::ParameterDeclaration const * param) { return Parameter(ifc, *param); });
+        }
 
         ifc::ChartSort sort() const { return index_.sort(); }
+        ifc::ChartIndex index() const { return index_; }
 
         auto operator<=>(Chart const& other) const = default;
 
@@ -62,6 +76,34 @@ namespace reflifc
         ifc::File const* ifc_;
         ifc::ChartUnilevel const* unilevel_;
     };
+
+    // Template parameter lists of nested templates, like the member template of a class template
+    // defined outside of its class.
+    struct ChartMultilevel
+    {
+        ChartMultilevel(ifc::File const* ifc, ifc::ChartMultilevel const& multilevel)
+            : ifc_(ifc),
+              multilevel_(&multilevel)
+        {
+        }
+
+        // Outermost first.
+        ViewOf<Chart> auto levels() const
+        {
+            return ifc_->chart_heap().slice(*multilevel_)
+                | std::views::transform([ifc = ifc_] (ifc::ChartIndex level) { return Chart(ifc, level); });
+        }
+
+        size_t size() const { return raw_count(multilevel_->cardinality); }
+
+        auto operator<=>(ChartMultilevel const& other) const = default;
+
+    private:
+        friend std::hash<ChartMultilevel>;
+
+        ifc::File const* ifc_;
+        ifc::ChartMultilevel const* multilevel_;
+    };
 }
 
 template<>
@@ -69,7 +111,7 @@ struct std::hash<reflifc::Chart>
 {
     size_t operator()(reflifc::Chart object) const noexcept
     {
-        return reflifc::hash_combine(0, object.ifc_, object.index_);
+        return reflifc::hash_handle(object.ifc_, object.index_);
     }
 };
 
@@ -81,3 +123,12 @@ struct std::hash<reflifc::ChartUnilevel>
         return reflifc::hash_combine(0, object.ifc_, object.unilevel_);
     }
 };
+
+template<>
+struct std::hash<reflifc::ChartMultilevel>
+{
+    size_t operator()(reflifc::ChartMultilevel object) const noexcept
+    {
+        return reflifc::hash_combine(0, object.ifc_, object.multilevel_);
+    }
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Declaration.h"
+#include "Expression.h"
+#include "Syntax.h"
+#include "Type.h"
+
+#include <cassert>
+#include <compare>
+
+namespace reflifc
+{
+    // Handle without its file: just the 4-byte abstract reference, for keeping many handles
+    // of one file densely packed. Turned back into the full handle by the FileContext of the file.
+    template<typename Handle, typename Index>
+    struct CompactHandle
+    {
+        Index index;
+
+        explicit operator bool() const
+        {
+            return !index.is_null();
+        }
+
+        auto operator<=>(CompactHandle const& other) const = default;
+    };
+
+    using CompactDeclaration = CompactHandle<Declaration, ifc::DeclIndex>;
+    using CompactType        = CompactHandle<Type,        ifc::TypeIndex>;
+    using CompactExpression  = CompactHandle<Expression,  ifc::ExprIndex>;
+    using CompactSyntax      = CompactHandle<Syntax,      ifc::SyntaxIndex>;
+
+    static_assert(sizeof(CompactDeclaration) == 4);
+
+    // The file of compact handles.
+    class FileContext
+    {
+    public:
+        explicit FileContext(ifc::File const* ifc)
+            : ifc_(ifc)
+        {
+        }
+
+        template<typename Handle, typename Index>
+        Handle operator[](CompactHandle<Handle, Index> compact) const
+        {
+            return Handle(ifc_, compact.index);
+        }
+
+        // The handle must belong to the file of the context.
+        template<typename Handle>
+        auto compact(Handle handle) const -> CompactHandle<Handle, decltype(handle.index())>
+        {
+            assert(handle.containing_file() == ifc_);
+            return { handle.index() };
+        }
+
+        ifc::File const* file() const { return ifc_; }
+
+    private:
+        ifc::File const* ifc_;
+    };
+}
+
+template<typename Handle, typename Index>
+struct std::hash<reflifc::CompactHandle<Handle, Index>>
+{
+    size_t operator()(reflifc::CompactHandle<Handle, Index> compact) const noexcept
+    {
+        return reflifc::hash_handle(nullptr, compact.index);
+    }
+};
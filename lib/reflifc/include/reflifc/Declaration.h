@@ -31,6 +31,9 @@ namespace reflifc
 
     struct Declaration
     {
+        // Null, e.g. to size the buffers of collect_declarations.
+        Declaration() = default;
+
         Declaration(ifc::File const* ifc, ifc::DeclIndex index)
             : ifc_(ifc)
             , index_(index)
@@ -120,8 +123,8 @@ namespace reflifc
     private:
         friend std::hash<Declaration>;
 
-        ifc::File const* ifc_;
-        ifc::DeclIndex index_;
+        ifc::File const* ifc_ = nullptr;
+        ifc::DeclIndex index_{};
     };
 }
 
@@ -130,6 +133,6 @@ struct std::hash<reflifc::Declaration>
 {
     size_t operator()(reflifc::Declaration decl) const noexcept
     {
-        return reflifc::hash_combine(0, decl.ifc_, decl.index_);
+        return reflifc::hash_handle(decl.ifc_, decl.index_);
     }
 };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Declaration.h"
+#include "Module.h"
+
+#include <ifc/Declaration.h>
+#include <ifc/Parallel.h>
+#include <ifc/Type.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Declarations of a module meeting all the conditions given to the builder, e.g. the public methods
+    // of the classes of namespace `app` returning `app::Status`:
+    //
+    //     DeclarationQuery classes(module);
+    //     classes.in("app").kind(ifc::TypeBasis::Class);
+    //     DeclarationQuery methods(module);
+    //     methods.members_of(classes).sort(ifc::DeclSort::Method).access(ifc::Access::Public).returning("app::Status");
+    //     for (auto method : methods.run()) ...
+    //
+    // run() draws the candidates from the most selective index the conditions allow (see Plan) and checks
+    // the remaining conditions on each candidate. Without an applicable index, the declaration partitions
+    // are scanned in parallel. Names are resolved when given, names missing from the module make the query empty.
+    class DeclarationQuery
+    {
+    public:
+        explicit DeclarationQuery(Module);
+
+        // Members of the scope. A query has one scope condition, later ones replace earlier ones.
+        DeclarationQuery& in(Scope);
+        // Members of the namespace or class (template) with the qualified name, see resolve.
+        DeclarationQuery& in(std::string_view qualified_name);
+        // Members of the namespaces and classes (templates) the other query finds, which is run with this one.
+        DeclarationQuery& members_of(DeclarationQuery const& scopes);
+
+        DeclarationQuery& sort(ifc::DeclSort);
+        // Scope declarations of the kind (namespace, class, struct, union...).
+        DeclarationQuery& kind(ifc::TypeBasis);
+        // Declarations named by the identifier, see ifc::declaration_identifier.
+        DeclarationQuery& named(std::string_view identifier);
+        // Declarations with an attribute of that name, `identifier` or `scope::identifier`, see AttributeIndex.
+        DeclarationQuery& with_attribute(std::string_view name);
+        DeclarationQuery& access(ifc::Access);
+        // Functions and methods returning the type declared with the qualified name, cv-qualified or not.
+        DeclarationQuery& returning(std::string_view qualified_name);
+        // Any other condition, checked last. Called concurrently during parallel scans.
+        DeclarationQuery& where(std::function<bool(Declaration)> predicate);
+
+        // Where the candidates come from, in the order of preference.
+        enum class Plan
+        {
+            Empty,              // A name is missing from the module
+            AttributeIndex,     // Declarations with the attribute
+            ScopeNameIndex,     // Members of the scopes named by the identifier
+            ScopeSortIndex,     // Members of the scopes of the sort or kind
+            ScopeMembers,       // All members of the scopes
+            IdentifierIndex,    // Declarations named by the identifier
+            SortPartition,      // Parallel scan of the partition of the sort
+            ParallelScan,       // Parallel scan of every declaration partition
+        };
+
+        Plan plan() const;
+
+        // Matching declarations, in the order of the index or partitions they were drawn from.
+        std::vector<Declaration> run(ifc::Executor& = ifc::default_executor()) const;
+
+    private:
+        using Candidates = std::vector<ifc::DeclIndex>;
+
+        std::vector<ifc::ScopeIndex> scopes(ifc::Executor&) const;
+        bool matches(ifc::DeclIndex, std::vector<ifc::ScopeIndex> const* scopes) const;
+        Candidates scan(ifc::Executor&) const;
+
+        ifc::File const* file_;
+        bool empty_ = false;
+
+        // At most one of them.
+        std::optional<ifc::ScopeIndex> scope_;
+        std::shared_ptr<DeclarationQuery const> scope_query_;
+
+        std::optional<ifc::DeclSort> sort_;
+        std::optional<ifc::TypeBasis> kind_;
+        std::optional<ifc::TextOffset> identifier_;
+        std::string attribute_;
+        std::optional<ifc::Access> access_;
+        ifc::DeclIndex return_type_{};
+        std::vector<std::function<bool(Declaration)>> predicates_;
+    };
+}
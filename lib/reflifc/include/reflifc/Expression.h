@@ -95,6 +95,8 @@ namespace reflifc
         ifc::ExprSort sort() const { return index_.sort(); }
         ifc::ExprIndex index() const { return index_; }
 
+        ifc::File const* containing_file() const { return ifc_; }
+
         auto operator<=>(Expression const& other) const = default;
 
     private:
@@ -110,6 +112,6 @@ struct std::hash<reflifc::Expression>
 {
     size_t operator()(reflifc::Expression object) const noexcept
     {
-        return reflifc::hash_combine(0, object.ifc_, object.index_);
+        return reflifc::hash_handle(object.ifc_, object.index_);
     }
 };
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+namespace reflifc
+{
+    // Elements of a view satisfying a predicate, transformed, like `std::views::filter | std::views::transform`
+    // without the begin() that std::views::filter caches: every begin() looks for the first element anew, so the
+    // view is const-iterable and can be iterated by several threads at once. Over a random-access view, `chunk`
+    // splits it into views over contiguous parts of the underlying elements, e.g. one per task of an Executor.
+    template<std::ranges::view Base, typename Predicate, typename Transform>
+        requires std::ranges::forward_range<Base const>
+    class FilteredView : public std::ranges::view_interface<FilteredView<Base, Predicate, Transform>>
+    {
+        using BaseIterator = std::ranges::iterator_t<Base const>;
+        using BaseSentinel = std::ranges::sentinel_t<Base const>;
+        using BaseReference = std::ranges::range_reference_t<Base const>;
+
+    public:
+        class Iterator
+        {
+        public:
+            // Elements are transformed on dereference, so they are not references to a range.
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::remove_cvref_t<std::invoke_result_t<Transform const&, BaseReference>>;
+            using difference_type = std::ranges::range_difference_t<Base const>;
+
+            Iterator() = default;
+
+            Iterator(BaseIterator current, BaseSentinel end, Predicate const& predicate, Transform const& transform)
+                : current_(std::move(current))
+                , end_(std::move(end))
+                , predicate_(predicate)
+                , transform_(transform)
+            {
+                skip();
+            }
+
+            value_type operator*() const { return std::invoke(transform_, *current_); }
+
+            Iterator& operator++() { ++current_; skip(); return *this; }
+            Iterator operator++(int) { auto res = *this; ++*this; return res; }
+
+            friend bool operator==(Iterator const& a, Iterator const& b) { return a.current_ == b.current_; }
+            friend bool operator==(Iterator const& it, std::default_sentinel_t) { return it.current_ == it.end_; }
+
+        private:
+            void skip()
+            {
+                while (current_ != end_ && !std::invoke(predicate_, *current_))
+                    ++current_;
+            }
+
+            BaseIterator current_{};
+            BaseSentinel end_{};
+            Predicate predicate_{};
+            Transform transform_{};
+        };
+
+        FilteredView() = default;
+
+        FilteredView(Base base, Predicate predicate, Transform transform)
+            : base_(std::move(base))
+            , predicate_(std::move(predicate))
+            , transform_(std::move(transform))
+        {}
+
+        Iterator begin() const
+        {
+            return { std::ranges::begin(base_), std::ranges::end(base_), predicate_, transform_ };
+        }
+
+        auto end() const
+        {
+            if constexpr (std::ranges::common_range<Base const>)
+                return Iterator{ std::ranges::end(base_), std::ranges::end(base_), predicate_, transform_ };
+            else
+                return std::default_sentinel;
+        }
+
+        // The part `index` of `count` parts of about the same number of underlying elements, filtered alike.
+        // Chunks iterate the underlying view of this one, which must outlive them.
+        auto chunk(size_t index, size_t count) const
+            requires std::ranges::random_access_range<Base const> && std::ranges::sized_range<Base const>
+        {
+            const auto size = std::ranges::size(base_);
+            const auto first = std::ranges::begin(base_) + static_cast<difference_type>(size * index / count);
+            const auto last = std::ranges::begin(base_) + static_cast<difference_type>(size * (index + 1) / count);
+            return FilteredView<std::ranges::subrange<BaseIterator>, Predicate, Transform>(
+                std::ranges::subrange<BaseIterator>(first, last), predicate_, transform_);
+        }
+
+        Base const& base() const { return base_; }
+
+    private:
+        using difference_type = std::ranges::range_difference_t<Base const>;
+
+        Base base_{};
+        Predicate predicate_{};
+        Transform transform_{};
+    };
+
+    template<std::ranges::viewable_range Range, typename Predicate, typename Transform>
+    auto filter_transform(Range&& range, Predicate predicate, Transform transform)
+    {
+        return FilteredView<std::views::all_t<Range>, Predicate, Transform>(
+            std::views::all(std::forward<Range>(range)), std::move(predicate), std::move(transform));
+    }
+}
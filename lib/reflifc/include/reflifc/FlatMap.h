@@ -0,0 +1,225 @@
+#pragma once
+
+#include "HashCombine.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace reflifc
+{
+    // Open-addressing hash map for small keys such as handles, compact handles and abstract references,
+    // in place of a node-based std::unordered_map. Entries live in one array probed linearly, next to an
+    // array of one byte per slot holding 7 bits of the hash, so that most mismatches are rejected without
+    // comparing keys. Erasing shifts the following entries back instead of leaving tombstones.
+    // Grows at a load of 7/8. The hash is mixed once more, so identity hashes of integers work too.
+    // Keys and values must be default-constructible. Insertions and erasures invalidate iterators and
+    // pointers to values, and the keys of entries must not be modified through iterators.
+    template<typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+    class FlatMap
+    {
+    public:
+        using value_type = std::pair<Key, Value>;
+
+        template<bool Const>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = FlatMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, value_type const*, value_type*>;
+            using reference = std::conditional_t<Const, value_type const&, value_type&>;
+            using Map = std::conditional_t<Const, FlatMap const, FlatMap>;
+
+            Iterator() = default;
+            Iterator(Map* map, size_t slot)
+                : map_(map)
+                , slot_(slot)
+            {
+                skip_empty();
+            }
+
+            reference operator*() const { return map_->slots_[slot_]; }
+            pointer operator->() const { return &map_->slots_[slot_]; }
+
+            Iterator& operator++()
+            {
+                ++slot_;
+                skip_empty();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            bool operator==(Iterator const& other) const { return slot_ == other.slot_; }
+
+        private:
+            void skip_empty()
+            {
+                while (slot_ != map_->control_.size() && map_->control_[slot_] == Empty)
+                    ++slot_;
+            }
+
+            Map* map_ = nullptr;
+            size_t slot_ = 0;
+        };
+
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        iterator begin() { return { this, 0 }; }
+        iterator end() { return { this, control_.size() }; }
+        const_iterator begin() const { return { this, 0 }; }
+        const_iterator end() const { return { this, control_.size() }; }
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        size_t capacity() const { return control_.size(); }
+
+        void clear()
+        {
+            control_.assign(control_.size(), Empty);
+            slots_.assign(slots_.size(), value_type{});
+            size_ = 0;
+        }
+
+        // Makes room for `count` entries without growing again.
+        void reserve(size_t count)
+        {
+            if (count * 8 <= capacity() * 7)
+                return;
+
+            size_t slots = 8;
+            while (count * 8 > slots * 7)
+                slots *= 2;
+            rehash(slots);
+        }
+
+        // Null if the key is absent.
+        Value* find(Key const& key)
+        {
+            const auto slot = find_slot(key);
+            return slot == NotFound ? nullptr : &slots_[slot].second;
+        }
+
+        Value const* find(Key const& key) const
+        {
+            const auto slot = find_slot(key);
+            return slot == NotFound ? nullptr : &slots_[slot].second;
+        }
+
+        bool contains(Key const& key) const { return find_slot(key) != NotFound; }
+
+        // Inserts a value constructed from `args` if the key is absent. The value of the key, and whether it was inserted.
+        template<typename... Args>
+        std::pair<Value*, bool> try_emplace(Key const& key, Args&&... args)
+        {
+            reserve(size_ + 1);
+            const auto hash = spread(key);
+            for (auto slot = hash & mask();; slot = (slot + 1) & mask())
+            {
+                if (control_[slot] == Empty)
+                {
+                    control_[slot] = tag(hash);
+                    slots_[slot] = value_type(key, Value(std::forward<Args>(args)...));
+                    ++size_;
+                    return { &slots_[slot].second, true };
+                }
+                if (control_[slot] == tag(hash) && Equal{}(slots_[slot].first, key))
+                    return { &slots_[slot].second, false };
+            }
+        }
+
+        Value& operator[](Key const& key)
+        {
+            return *try_emplace(key).first;
+        }
+
+        // False if the key is absent.
+        bool erase(Key const& key)
+        {
+            auto hole = find_slot(key);
+            if (hole == NotFound)
+                return false;
+
+            // Entries of the probe sequence after the hole move into it, unless their home slot lies after the hole.
+            for (auto slot = (hole + 1) & mask(); control_[slot] != Empty; slot = (slot + 1) & mask())
+            {
+                const auto home = spread(slots_[slot].first) & mask();
+                if (((slot - hole) & mask()) <= ((slot - home) & mask()))
+                {
+                    control_[hole] = control_[slot];
+                    slots_[hole] = std::move(slots_[slot]);
+                    hole = slot;
+                }
+            }
+            control_[hole] = Empty;
+            slots_[hole] = value_type{};
+            --size_;
+            return true;
+        }
+
+    private:
+        static constexpr uint8_t Empty = 0;
+        static constexpr size_t NotFound = SIZE_MAX;
+
+        static size_t spread(Key const& key)
+        {
+            return static_cast<size_t>(hash_mix(Hash{}(key) ^ HashSecret0, HashSecret1));
+        }
+
+        // The top 7 bits of the hash, with the high bit set to tell it apart from Empty.
+        static uint8_t tag(size_t hash)
+        {
+            return static_cast<uint8_t>(0x80 | (hash >> (sizeof(size_t) * 8 - 7)));
+        }
+
+        size_t mask() const { return control_.size() - 1; }
+
+        size_t find_slot(Key const& key) const
+        {
+            if (size_ == 0)
+                return NotFound;
+
+            const auto hash = spread(key);
+            for (auto slot = hash & mask(); control_[slot] != Empty; slot = (slot + 1) & mask())
+            {
+                if (control_[slot] == tag(hash) && Equal{}(slots_[slot].first, key))
+                    return slot;
+            }
+            return NotFound;
+        }
+
+        void rehash(size_t slots)
+        {
+            auto old_control = std::exchange(control_, std::vector<uint8_t>(slots, Empty));
+            auto old_slots = std::exchange(slots_, std::vector<value_type>(slots));
+            for (size_t i = 0; i != old_control.size(); ++i)
+            {
+                if (old_control[i] == Empty)
+                    continue;
+
+                const auto hash = spread(old_slots[i].first);
+                auto slot = hash & mask();
+                while (control_[slot] != Empty)
+                    slot = (slot + 1) & mask();
+                control_[slot] = tag(hash);
+                slots_[slot] = std::move(old_slots[i]);
+            }
+        }
+
+        std::vector<uint8_t> control_;
+        std::vector<value_type> slots_;
+        size_t size_ = 0;
+    };
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace reflifc
+{
+    // Elements yielded by a coroutine (`co_yield`), computed as they are consumed, like C++23's std::generator.
+    // The coroutine keeps its state in its frame and is suspended between elements, so a consumer can take a page
+    // of elements (e.g. the first 100 members of a huge namespace) and come back for the next one later, without
+    // a call stack kept alive in between. Unlike std::generator, iterating again (or calling next_page) resumes
+    // at the element the previous iteration stopped at, including the one a loop broke out with. An exception of
+    // the coroutine is rethrown to the consumer, which then sees the generator done. Move-only, not safe to consume
+    // from several threads at once.
+    template<typename T>
+    class Generator : public std::ranges::view_base
+    {
+    public:
+        struct promise_type
+        {
+            std::optional<T> current;
+            std::exception_ptr exception;
+
+            Generator get_return_object()
+            {
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            std::suspend_always yield_value(T value)
+            {
+                current = std::move(value);
+                return {};
+            }
+
+            void return_void() {}
+            void unhandled_exception() { exception = std::current_exception(); }
+
+            // Only yields.
+            template<typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        class Iterator
+        {
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+
+            explicit Iterator(Generator* generator)
+                : generator_(generator)
+            {
+            }
+
+            T const& operator*() const { return *generator_->handle_.promise().current; }
+
+            Iterator& operator++()
+            {
+                generator_->advance();
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            friend bool operator==(Iterator const& it, std::default_sentinel_t) { return it.generator_->done(); }
+
+        private:
+            Generator* generator_ = nullptr;
+        };
+
+        Generator() = default;
+
+        Generator(Generator&& other) noexcept
+            : handle_(std::exchange(other.handle_, {}))
+            , started_(other.started_)
+        {
+        }
+
+        Generator& operator=(Generator&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle_)
+                    handle_.destroy();
+                handle_ = std::exchange(other.handle_, {});
+                started_ = other.started_;
+            }
+            return *this;
+        }
+
+        ~Generator()
+        {
+            if (handle_)
+                handle_.destroy();
+        }
+
+        // At the next element not consumed yet.
+        Iterator begin()
+        {
+            if (!started_)
+                advance();
+            return Iterator(this);
+        }
+
+        std::default_sentinel_t end() const { return {}; }
+
+        bool done()
+        {
+            if (!started_)
+                advance();
+            return !handle_ || handle_.done();
+        }
+
+        // The next `count` elements at most, empty once the generator is done.
+        std::vector<T> next_page(size_t count)
+        {
+            std::vector<T> page;
+            if (count == 0)
+                return page;
+            // Stops once past the last element of the page, at the first element of the next one.
+            for (auto it = begin(); it != end(); ++it)
+            {
+                page.push_back(*it);
+                if (page.size() == count)
+                {
+                    ++it;
+                    break;
+                }
+            }
+            return page;
+        }
+
+    private:
+        explicit Generator(std::coroutine_handle<promise_type> handle)
+            : handle_(handle)
+        {
+        }
+
+        void advance()
+        {
+            started_ = true;
+            if (!handle_ || handle_.done())
+                return;
+            handle_.promise().current.reset();
+            handle_.resume();
+            if (auto exception = std::exchange(handle_.promise().exception, nullptr))
+                std::rethrow_exception(exception);
+        }
+
+        std::coroutine_handle<promise_type> handle_;
+        bool started_ = false;
+    };
+
+    // Elements of a range, e.g. of a scope listing or of a query result, yielded one by one, so that they can be
+    // consumed in pages like those of any other generator. The range is kept in the coroutine frame: pass a view,
+    // or move a container in.
+    template<std::ranges::input_range Range>
+    Generator<std::ranges::range_value_t<Range>> generate(Range range)
+    {
+        for (auto&& element : range)
+            co_yield element;
+    }
+}
@@ -1,19 +1,52 @@
 #pragma once
+#include <bit>
+#include <cstdint>
 #include <functional>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
 namespace reflifc
 {
+	// Multiplies the words into 128 bits and folds the halves together, the mixing step of wyhash:
+	// every input bit affects every output bit, for one multiplication.
+	inline uint64_t hash_mix(uint64_t a, uint64_t b) noexcept
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		uint64_t high;
+		const uint64_t low = _umul128(a, b, &high);
+		return low ^ high;
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+		return (a * b) ^ __umulh(a, b);
+#else
+		const auto product = static_cast<unsigned __int128>(a) * b;
+		return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#endif
+	}
+
+	inline constexpr uint64_t HashSecret0 = 0xa0761d6478bd642f;
+	inline constexpr uint64_t HashSecret1 = 0xe7037ed1a0b428db;
+
 	template<typename... Args>
 	size_t hash_combine(size_t seed, Args const&... args) noexcept
 	{
-		// Implementation inspired from Boost.
 		auto hash_combine_single = [&seed]<typename Arg>(Arg const& arg)
 		{
-			seed ^= std::hash<Arg>{}(arg) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			seed = static_cast<size_t>(hash_mix(seed ^ std::hash<Arg>{}(arg) ^ HashSecret0, HashSecret1));
 		};
 
 		(hash_combine_single(args), ...);
 
 		return seed;
 	}
-}
\ No newline at end of file
+
+	// Hash of a handle made of a file and a 4-byte abstract reference, in a single mix of the two.
+	template<typename Index>
+		requires (sizeof(Index) == sizeof(uint32_t))
+	size_t hash_handle(void const* file, Index index) noexcept
+	{
+		const auto reference = std::bit_cast<uint32_t>(index);
+		return static_cast<size_t>(hash_mix(reinterpret_cast<uintptr_t>(file) ^ HashSecret0, reference ^ HashSecret1));
+	}
+}
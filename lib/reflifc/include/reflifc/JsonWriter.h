@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Module.h"
+
+#include <ifc/Parallel.h>
+
+#include <string>
+
+namespace ifc
+{
+    class Environment;
+}
+
+namespace reflifc
+{
+    struct JsonOptions
+    {
+        // Without an Environment, types from other modules are all spelled alike, see TypeRenderer.
+        ifc::Environment* environment = nullptr;
+
+        // Declarations are written in chunks, each into its own buffer, on this executor,
+        // and the buffers concatenated in order. The output is the same as without one.
+        ifc::Executor* executor = nullptr;
+    };
+
+    // Appends the declarations of a module to `out` as one JSON object:
+    //
+    //     {"module":"m","declarations":[{"kind":"struct","name":"S","line":3,"members":[...]}, ...]}
+    //
+    // Every declaration has a "kind" (namespace, class, struct, union, enum, function, method, constructor,
+    // destructor, variable, field, bitfield, alias, template or other) and, depending on it, a "name", a "line"
+    // (index into `name.line`), an "access", a "type" (spelled by TypeRenderer), "members", "enumerators" or
+    // the templated "entity".
+    //
+    // Written straight into `out` without a document tree. Strings of the string table are escaped at most once,
+    // up front, and only the ones that need it.
+    void write_json(Module, std::string& out, JsonOptions const& = {});
+}
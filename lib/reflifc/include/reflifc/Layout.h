@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Module.h"
+#include "index/VirtualTableIndex.h"
+
+#include <ifc/Declaration.h>
+#include <ifc/Parallel.h>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Non-static data members of every complete class, struct and union of a module, as columns
+    // with one entry per member. The members of classes[i] are the entries
+    // [member_offsets[i], member_offsets[i + 1]), in declaration order.
+    struct ClassLayouts
+    {
+        // Not a bitfield, or a bitfield whose width is not a constant (in templates).
+        static constexpr uint32_t NotBitfield = UINT32_MAX;
+        static constexpr uint32_t DependentWidth = UINT32_MAX - 1;
+
+        std::vector<ifc::DeclIndex> classes;
+        std::vector<uint32_t> member_offsets{ 0 };
+
+        std::vector<ifc::TextOffset> names;
+        std::vector<ifc::TypeIndex> types;
+        std::vector<ifc::Access> access;
+        std::vector<uint32_t> bit_widths;
+        std::vector<ifc::DeclIndex> members; // `decl.field` or `decl.bitfield`
+
+        size_t size() const { return classes.size(); }
+
+        std::span<ifc::TypeIndex const> member_types(size_t i) const
+        {
+            return std::span(types).subspan(member_offsets[i], member_offsets[i + 1] - member_offsets[i]);
+        }
+    };
+
+    // One pass over `decl.field` and `decl.bitfield`, grouping members by their home scope,
+    // instead of filtering the members of every class.
+    ClassLayouts extract_layouts(Module);
+
+    struct ClassVirtualTable
+    {
+        ifc::DeclIndex decl;
+        std::shared_ptr<VirtualTableIndex::Table const> table;
+    };
+
+    // Virtual tables of the polymorphic classes and structs of a module, in declaration order, built in parallel
+    // through the VirtualTableIndex of each file: the tables of bases are shared by all their derived classes.
+    std::vector<ClassVirtualTable> extract_virtual_tables(Module, ifc::Environment&, ifc::Executor& = ifc::default_executor());
+}
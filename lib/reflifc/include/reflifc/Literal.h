@@ -40,6 +40,6 @@ struct std::hash<reflifc::Literal>
 {
     size_t operator()(reflifc::Literal object) const noexcept
     {
-        return reflifc::hash_combine(0, object.ifc_, object.index_);
+        return reflifc::hash_handle(object.ifc_, object.index_);
     }
 };
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/MacroFwd.h>
+#include <ifc/common_types.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // A preprocessing token of a form.
+    struct FormToken
+    {
+        ifc::FormSort sort;
+        std::string_view spelling;
+    };
+
+    // Writes the tokens of the form to the buffer, replacing its contents; its capacity is reused between calls.
+    // Tuples are flattened, and the punctuation of stringizing (`#`), pasting (`##`), `_Pragma(...)` and
+    // parentheses is written as operator tokens. Whitespace forms are a single space.
+    void decode_form(ifc::File const&, ifc::FormIndex, std::vector<FormToken>& buffer);
+
+    // Appends the spellings of the tokens of the form, spaced as in the source.
+    void render_form(ifc::File const&, ifc::FormIndex, std::string& out);
+
+    // A macro of a header unit.
+    struct Macro
+    {
+        Macro(ifc::File const* ifc, ifc::MacroIndex index)
+            : ifc_(ifc)
+            , index_(index)
+        {
+        }
+
+        std::string_view name() const;
+        bool is_function_like() const;
+        // Of function-like macros, 0 for object-like ones.
+        uint32_t arity() const;
+        bool is_variadic() const;
+
+        // Parameter forms of function-like macros, in order.
+        void parameters(std::vector<FormToken>& buffer) const;
+        void body(std::vector<FormToken>& buffer) const;
+
+        // Appends the macro as `#define` would spell it after the directive, e.g. `MAX(a, b) ((a) < (b) ? (b) : (a))`.
+        void definition(std::string& out) const;
+
+        ifc::MacroIndex index() const { return index_; }
+
+    private:
+        ifc::FormIndex body_form() const;
+
+        ifc::File const* ifc_;
+        ifc::MacroIndex index_;
+    };
+
+    // The macro the header unit defines with the name, see MacroTable.
+    std::optional<Macro> find_macro(ifc::File const&, std::string_view name);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Module.h"
+#include "NameArena.h"
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/NameFwd.h>
+#include <ifc/TypeFwd.h>
+#include <ifc/Parallel.h>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // MSVC decorated names (x64) of the functions, methods, constructors, destructors and variables of a file,
+    // like `?get@S@ns@@QEBAHAEBU12@0@Z`, to join declarations against linker maps and PDB symbols.
+    //
+    // The encoding of each type is built once and kept in a NameArena owned by the mangler, with the names and
+    // parameter types it contains marked, so that the back-references of a decorated name (the first ten names and
+    // the first ten parameter types of multiple characters) are resolved in one pass over the encodings it is made
+    // of. Classes imported from other modules are only resolved when an Environment is given.
+    //
+    // Declarations MSVC does not decorate or that the mangler does not support get no name: members of templates
+    // and specializations, declarations of unnamed scopes, hidden friends, and those whose types involve
+    // templates, pointers to members, arrays (other than parameters) or unresolved imports. Overriders are decorated
+    // as virtual only when the file marks them so. Not thread-safe, see decorate_module.
+    class Mangler
+    {
+    public:
+        explicit Mangler(ifc::File const&, ifc::Environment* = nullptr);
+
+        Mangler(Mangler const&) = delete;
+        Mangler& operator=(Mangler const&) = delete;
+
+        // Decorated name of a `decl.function`, `decl.method`, `decl.constructor`, `decl.destructor` or
+        // `decl.variable` of the file, as a new name of `out`. Empty for other declarations and unsupported ones.
+        std::string_view decorated_name(ifc::DeclIndex, NameArena & out);
+
+        // Same, as a name of the mangler's own arena, valid as long as the mangler.
+        std::string_view decorated_name(ifc::DeclIndex);
+
+    private:
+        std::string_view encoding(ifc::File const&, ifc::TypeIndex);
+        void encode(ifc::File const&, ifc::TypeIndex, std::string & out);
+        void encode_fundamental(ifc::FundamentalType, std::string & out);
+        void encode_designated(ifc::File const&, ifc::DeclIndex, std::string & out);
+        void encode_indirection(ifc::File const&, std::string_view kind, ifc::TypeIndex pointee, std::string & out);
+        void encode_result(ifc::File const&, ifc::TypeIndex, std::string & out);
+        void encode_parameters(ifc::File const&, ifc::TypeIndex source, std::string & out);
+        void encode_parameter(ifc::File const&, ifc::TypeIndex, std::string & out);
+        void encode_function(ifc::File const&, ifc::TypeIndex target, ifc::TypeIndex source, std::string & out);
+        void encode_scoped_name(ifc::File const&, ifc::DeclIndex scope, std::string & out);
+
+        bool encode_declaration(ifc::DeclIndex, std::string & out);
+        bool encode_member_kind(ifc::DeclIndex home_scope, ifc::Access, bool is_static, bool is_virtual, std::string & out);
+
+        void resolve(std::string_view encoded, NameArena & out);
+
+        ifc::File const& file_;
+        ifc::Environment* environment_;
+
+        // Encodings by type, per sort. Null views are not encoded yet.
+        std::array<std::vector<std::string_view>, ifc::TypeIndex::SortCount> encodings_;
+        NameArena arena_;
+        NameArena names_;
+
+        // Scratch buffers for encoding, one per nesting level of `encoding`.
+        std::deque<std::string> buffers_;
+        size_t depth_ = 0;
+        std::string declaration_;
+
+        // Back-references of the name being resolved.
+        std::array<std::string_view, 10> name_references_;
+        size_t name_count_ = 0;
+        std::array<std::string_view, 10> type_references_;
+        size_t type_count_ = 0;
+    };
+
+    // Decorated names of the functions, methods, constructors, destructors and variables of a module, as columns
+    // with one entry per decorated declaration, by sort and then in declaration order. The names are kept in the
+    // arenas, valid as long as the result.
+    struct DecoratedNames
+    {
+        std::vector<ifc::DeclIndex> decls;
+        std::vector<std::string_view> names;
+        std::vector<std::unique_ptr<NameArena>> arenas;
+
+        size_t size() const { return decls.size(); }
+    };
+
+    // Decorated in parallel, a mangler and an arena per chunk of declarations.
+    DecoratedNames decorate_module(Module, ifc::Environment* = nullptr, ifc::Executor& = ifc::default_executor());
+}
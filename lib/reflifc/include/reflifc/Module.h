@@ -64,12 +64,11 @@ namespace reflifc
     struct Module
     {
     private:
-        ViewOf<Module> auto dereference(ifc::Partition<ifc::ModuleReference, ifc::Index> partition, ifc::Environment& environment) const 
+        static ViewOf<Module> auto dereference(std::span<ifc::File const* const> files)
         {
-            return partition
-                | std::views::transform([ifc = ifc_, &environment] (ifc::ModuleReference const & module_reference) {
-                    const auto& other_ifc = environment.get_referenced_module(module_reference, *ifc);
-                    return Module(&other_ifc);
+            return files
+                | std::views::transform([] (ifc::File const* file) {
+                    return Module(file);
                 });
         }
 
@@ -89,12 +88,12 @@ namespace reflifc
 
         ViewOf<Module> auto exported_modules(ifc::Environment& environment) const
         {
-            return dereference(ifc_->exported_modules(), environment);
+            return dereference(environment.exported_files(*ifc_));
         }
 
         ViewOf<Module> auto imported_modules(ifc::Environment& environment) const
         {
-            return dereference(ifc_->imported_modules(), environment);
+            return dereference(environment.imported_files(*ifc_));
         }
 
         Scope global_namespace() const
@@ -29,6 +29,7 @@ namespace reflifc
 
         bool                is_identifier() const;
         char const*         as_identifier() const;
+        std::string_view    as_identifier_view() const;
 
         bool                is_operator() const;
         char const*         operator_name() const;
@@ -55,6 +56,7 @@ namespace reflifc
         Declaration			as_deduction_guide() const;
 
         ifc::NameSort sort() const { return index_.sort(); }
+        ifc::NameIndex index() const { return index_; }
 
         auto operator<=>(Name const& other) const = default;
 
@@ -75,6 +77,9 @@ namespace reflifc
 
         Name                primary()               const;
         TupleExpressionView template_arguments()    const;
+        ifc::ExprIndex      template_arguments_index() const;
+
+        ifc::File const* containing_file() const { return ifc_; }
 
         auto operator<=>(SpecializationName const& other) const = default;
 
@@ -87,7 +92,13 @@ namespace reflifc
 
     inline bool is_identifier(Name name, std::string_view s)
     {
-        return name.is_identifier() && name.as_identifier() == s;
+        return name.is_identifier() && name.as_identifier_view() == s;
+    }
+
+    // `text` is an interned string of the file containing the name (see ifc::File::find_text).
+    inline bool is_identifier(Name name, ifc::TextOffset text)
+    {
+        return name.is_identifier() && name.index().index == static_cast<uint32_t>(text);
     }
 
     template<typename Declaration>
@@ -102,7 +113,7 @@ struct std::hash<reflifc::Name>
 {
     size_t operator()(reflifc::Name object) const noexcept
     {
-        return reflifc::hash_combine(0, object.ifc_, object.index_);
+        return reflifc::hash_handle(object.ifc_, object.index_);
     }
 };
 
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Monotonic buffer for names built out of several parts, like qualified names or specialization names.
+    // A name is built with `append` and completed with `finish`, the returned view stays valid as long as the arena
+    // (or until `release`). Blocks are only allocated when the current one is full, so building many names costs
+    // no allocation per name.
+    class NameArena
+    {
+    public:
+        explicit NameArena(size_t block_size = 16 * 1024);
+
+        NameArena(NameArena const&) = delete;
+        NameArena& operator=(NameArena const&) = delete;
+
+        NameArena& append(std::string_view);
+        NameArena& append(char);
+
+        // Part of the name being built so far, invalidated by the next `append`.
+        std::string_view pending() const { return { start_, static_cast<size_t>(cursor_ - start_) }; }
+
+        // Completes the name being built and starts a new one. The returned view is null-terminated.
+        std::string_view finish();
+
+        // Copies a whole name at once.
+        std::string_view store(std::string_view);
+
+        // Frees every block, invalidating every name of the arena.
+        void release();
+
+    private:
+        void grow(size_t additional);
+
+        size_t block_size_;
+        std::vector<std::unique_ptr<char[]>> blocks_;
+        char* start_ = nullptr;
+        char* cursor_ = nullptr;
+        char* end_ = nullptr;
+    };
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Declaration.h"
+#include "Module.h"
+
+#include <ifc/DeclarationFwd.h>
+#include <ifc/Scope.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Kinds of the nodes of an Outline, in the order their children are listed.
+    enum class OutlineKind : uint8_t
+    {
+        Namespace,
+        Class, // Classes, structs and unions
+        Enumeration,
+        Template,
+        Concept,
+        Alias,
+        Function, // Functions, methods, constructors and destructors
+        Variable,
+        Field, // Fields and bitfields
+        Enumerator,
+        Other, // Using declarations, specializations, friends, other scope kinds...
+        Count
+    };
+
+    // Namespace and class tree of a module for UI views, e.g. a module browser, expanded on demand: nodes are
+    // created for the children of a node when they are first asked for, and their child counts (per kind too)
+    // and names when those are, so that the cost of an outline is that of the nodes visible in it rather than
+    // a traversal of the module. Namespaces, complete classes, class templates and enumerations have children,
+    // grouped by kind (through the file's ScopeSortIndex) and in declaration order within a kind.
+    // Not safe to use from multiple threads, like the UI models it backs.
+    class Outline
+    {
+    public:
+        using NodeId = uint32_t;
+
+        // The global namespace.
+        static constexpr NodeId Root = 0;
+
+        explicit Outline(Module);
+
+        // Null for the root.
+        Declaration declaration(NodeId) const;
+        OutlineKind kind(NodeId) const;
+
+        // The root for the children of the root, and for the root itself.
+        NodeId parent(NodeId node) const { return nodes_[node].parent; }
+
+        // Identifier of the declaration, read from the string table, "(unnamed)" for declarations without one
+        // (e.g. operators and specializations) and "" for the root.
+        std::string_view name(NodeId) const;
+
+        // Without listing the children.
+        uint32_t child_count(NodeId node) const { return nodes_[node].child_count; }
+        bool has_children(NodeId node) const { return child_count(node) != 0; }
+
+        // Children of the kind, grouping the members of the node's scope on first use.
+        uint32_t child_count(NodeId, OutlineKind) const;
+
+        // Creates the nodes of the children on first use.
+        std::span<NodeId const> children(NodeId);
+        NodeId child(NodeId node, uint32_t row) { return children(node)[row]; }
+
+        bool is_expanded(NodeId node) const { return nodes_[node].first_child != Unexpanded; }
+
+        // Nodes created so far.
+        size_t size() const { return nodes_.size(); }
+
+    private:
+        static constexpr uint32_t Unexpanded = ~uint32_t{ 0 };
+
+        struct Node
+        {
+            ifc::DeclIndex decl;
+            NodeId parent;
+            ifc::ScopeIndex scope; // Of the members, null for enumerations and nodes without children
+            uint32_t child_count;
+            uint32_t first_child = Unexpanded; // In children_
+        };
+
+        NodeId add(ifc::DeclIndex, NodeId parent);
+
+        // Calls `f` with the spans of the members of the node's scope of the kind, grouped by the ScopeSortIndex.
+        template<typename F>
+        void for_each_group(Node const&, OutlineKind, F f) const;
+
+        ifc::File const* ifc_;
+        std::vector<Node> nodes_;
+        std::vector<NodeId> children_; // Of the expanded nodes, contiguous per node
+    };
+}
@@ -1,25 +1,53 @@
 ﻿#pragma once
 
+#include "Expression.h"
+#include "FilteredView.h"
 #include "Module.h"
+#include "NameArena.h"
+#include "TupleView.h"
 #include "decl/ClassOrStruct.h"
+#include "decl/Enumeration.h"
 #include "decl/Namespace.h"
+#include "decl/Specialization.h"
+#include "index/AttributeIndex.h"
+#include "index/ConstantEvaluator.h"
+#include "index/ConstraintIndex.h"
+#include "index/DeductionGuideIndex.h"
+#include "index/EnclosingScopeIndex.h"
+#include "index/EnumerationTable.h"
+#include "index/FlatExpressionCache.h"
+#include "index/FriendshipIndex.h"
+#include "index/LineTable.h"
+#include "index/PositionIndex.h"
+#include "index/ReferenceIndex.h"
+#include "index/ScopeSortIndex.h"
+#include "index/SourceFileIndex.h"
+#include "index/SpecifierTable.h"
+#include "index/TypeUseIndex.h"
+
+#include <ifc/TextSearch.h>
+#include <ifc/Type.h>
 
 #include <optional>
+#include <span>
 
 namespace reflifc
 {
-#define FILTER_AND_TRANSFORM(BaseDeclaration, kind) \
-              std::views::filter   (&BaseDeclaration::is_ ## kind) \
-            | std::views::transform(&BaseDeclaration::as_ ## kind)
+#define FILTER_AND_TRANSFORM(range, BaseDeclaration, kind) \
+    filter_transform(range, &BaseDeclaration::is_ ## kind, &BaseDeclaration::as_ ## kind)
 
+    // Scope declarations in the scope, in declaration order, through the file's ScopeSortIndex. See
+    // ScopeSortIndex::scope_members for them grouped by kind.
     inline ViewOf<ScopeDeclaration> auto get_scope_declarations(Scope scope)
     {
-        return scope.get_declarations() | FILTER_AND_TRANSFORM(Declaration, scope);
+        auto ifc = scope.containing_file();
+        return ifc->get_index<ScopeSortIndex>().members(*ifc, scope.index(), ifc::DeclSort::Scope)
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return ScopeDeclaration(ifc, ifc->scope_declarations()[decl]); });
     }
 
     inline ViewOf<ClassOrStruct> auto get_classes_and_structs(ViewOf<ScopeDeclaration> auto declarations)
     {
-        return declarations | FILTER_AND_TRANSFORM(ScopeDeclaration, class_or_struct);
+        return FILTER_AND_TRANSFORM(std::move(declarations), ScopeDeclaration, class_or_struct);
     }
 
     inline ViewOf<ClassOrStruct> auto get_classes_and_structs(Module module)
@@ -27,6 +55,7 @@ namespace reflifc
         return get_classes_and_structs(module.scope_declarations());
     }
 
+    // In declaration order, filtering the scope declarations only.
     inline ViewOf<ClassOrStruct> auto get_classes_and_structs(Scope scope)
     {
         return get_classes_and_structs(get_scope_declarations(scope));
@@ -34,16 +63,223 @@ namespace reflifc
 
     inline std::optional<Namespace> find_namespace_by_name(Scope scope, std::string_view name)
     {
-        auto namespaces = get_scope_declarations(scope) | FILTER_AND_TRANSFORM(ScopeDeclaration, namespace);
-
-        const auto it = std::ranges::find_if(namespaces, [name] (Namespace ns) {
-            return has_name(ns, name);
-        });
+        auto namespaces = FILTER_AND_TRANSFORM(
+            scope.find_all(name, ifc::DeclSort::Scope) | std::views::transform(&Declaration::as_scope),
+            ScopeDeclaration, namespace);
 
-        if (it == namespaces.end())
+        const auto it = std::ranges::begin(namespaces);
+        if (it == std::ranges::end(namespaces))
             return std::nullopt;
         return *it;
     }
 
+    // Scope holding the member at the position of `scope.member`, by a binary search in the file's
+    // EnclosingScopeIndex, e.g. for the parents of members walked in parallel over the partition.
+    inline std::optional<Scope> enclosing_scope(Module module, ifc::Index member)
+    {
+        auto ifc = module.global_namespace().containing_file();
+        const auto scope = ifc->get_index<EnclosingScopeIndex>().owning_scope(member);
+        if (ifc::is_null(scope))
+            return std::nullopt;
+        return Scope(ifc, scope);
+    }
+
+    // Types of the sort in the type heap of the module (the elements of type tuples), with one ifc::find_sort pass.
+    inline ViewOf<Type> auto get_heap_types(Module module, ifc::TypeSort sort)
+    {
+        auto ifc = module.global_namespace().containing_file();
+        const auto heap = ifc->has_partition("heap.type")
+            ? ifc->type_heap() : ifc::Partition<ifc::TypeIndex, ifc::Index>(nullptr, 0);
+        std::vector<uint32_t> positions;
+        ifc::find_sort(heap, sort, positions);
+        return std::views::all(std::move(positions))
+            | std::views::transform([ifc, heap] (uint32_t position) { return Type(ifc, heap[ifc::Index{ position }]); });
+    }
+
+    // Batch counterparts of Scope::get_declarations and of iterating a TupleTypeView: write the first
+    // `out.size()` elements into the caller's buffer with no per-element indirection and return the count of
+    // elements, so that a buffer can be sized with a first call on an empty span.
+    size_t collect_declarations(Scope scope, std::span<Declaration> out);
+    size_t collect_types(TupleTypeView types, std::span<Type> out);
+
+    // Declaration named by a qualified name like `std::chrono::duration`, looked up from the global scope.
+    // Results (including every prefix) are memoized per file, see QualifiedNameResolver. Names are looked up
+    // through using-declarations and namespace aliases, see UsingResolver.
+    std::optional<Declaration> resolve(Module module, std::string_view qualified_name);
+
+    // Declarations of the module with an attribute named `identifier` or `scope::identifier`, through the file's AttributeIndex.
+    inline ViewOf<Declaration> auto get_declarations_with_attribute(Module module, std::string_view name)
+    {
+        auto ifc = module.global_namespace().containing_file();
+        return ifc->get_index<AttributeIndex>().find(*ifc, name)
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+    }
+
+    // Exported declarations of the module, by sort, through the file's SpecifierTable.
+    inline ViewOf<Declaration> auto exported_declarations(Module module)
+    {
+        auto ifc = module.global_namespace().containing_file();
+        return std::views::all(ifc->get_index<SpecifierTable>().select({ DeclarationFlag::Exported }))
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+    }
+
+    // Templates, partial specializations and concepts whose constraints name the concept, through the file's ConstraintIndex.
+    inline ViewOf<Declaration> auto get_constrained_declarations(Declaration concept_decl)
+    {
+        auto ifc = concept_decl.containing_file();
+        return ifc->get_index<ConstraintIndex>().constrained_by(concept_decl.index())
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+    }
+
+    // Deduction guides of the class template, through the file's DeductionGuideIndex.
+    inline ViewOf<Declaration> auto get_deduction_guides(Declaration primary_template)
+    {
+        auto ifc = primary_template.containing_file();
+        return ifc->get_index<DeductionGuideIndex>().guides(primary_template.index())
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+    }
+
+    // Classes that declare the function or class a friend, the reverse of Declaration::friends, through the
+    // file's FriendshipIndex.
+    inline ViewOf<Declaration> auto get_befriending_classes(Declaration befriended)
+    {
+        auto ifc = befriended.containing_file();
+        return ifc->get_index<FriendshipIndex>().befriending(befriended.index())
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+    }
+
+    // Every (class, friend) pair of the module at once, from the file's FriendshipIndex.
+    inline std::span<FriendshipIndex::Friendship const> get_friendships(Module module)
+    {
+        auto ifc = module.global_namespace().containing_file();
+        return ifc->get_index<FriendshipIndex>().friendships();
+    }
+
+    // Declarations whose type, parameters, return type, aliasee or bases use the type, up to cv-qualifiers,
+    // references and pointers, through the file's TypeUseIndex.
+    inline ViewOf<Declaration> auto get_type_users(Type type)
+    {
+        auto ifc = type.containing_file();
+        return ifc->get_index<TypeUseIndex>().users(*ifc, type.index())
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+    }
+
+    // Declarations named by the initializer or default arguments of the declaration, through the file's ReferenceIndex.
+    inline ViewOf<Declaration> auto get_referenced_declarations(Declaration declaration)
+    {
+        auto ifc = declaration.containing_file();
+        return ifc->get_index<ReferenceIndex>().references(declaration.index())
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+    }
+
+    // Declarations whose initializer or default arguments name the declaration, through the file's ReferenceIndex.
+    inline ViewOf<Declaration> auto get_referencing_declarations(Declaration declaration)
+    {
+        auto ifc = declaration.containing_file();
+        return ifc->get_index<ReferenceIndex>().referrers(declaration.index())
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+    }
+
+    // Declarations of the module declared in the source file, as spelled in `name.source-file`
+    // (see Name::as_source_file), through the file's SourceFileIndex.
+    inline ViewOf<Declaration> auto get_source_file_declarations(Module module, std::string_view path)
+    {
+        auto ifc = module.global_namespace().containing_file();
+        return std::views::all(ifc->get_index<SourceFileIndex>().declarations(path))
+            | std::views::transform([ifc] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+    }
+
+    // File, line and column of the declaration through the file's LineTable, empty for the sorts without a location.
+    Location location(Declaration declaration);
+
+    // Innermost declaration of the module at the line and column of the source file, as spelled in
+    // `name.source-file`, by a binary search in the file's PositionIndex, e.g. for editor hover.
+    inline std::optional<Declaration> declaration_at(Module module, std::string_view path, uint32_t line, uint32_t column)
+    {
+        auto ifc = module.global_namespace().containing_file();
+        const auto decl = ifc->get_index<PositionIndex>().innermost(path, line, column);
+        if (decl.is_null())
+            return std::nullopt;
+        return Declaration(ifc, decl);
+    }
+
+    // Conjunctions and disjunctions of the atomic constraints of a constraint expression, memoized per file.
+    NormalizedConstraint const& normalized_constraint(Expression constraint);
+
+    // Nodes of the expression tree in post-order, root last, flattened once per file by its FlatExpressionCache.
+    std::span<FlatExpressionCache::Node const> flattened(Expression expression);
+
+    // Declarations of the module named by an identifier that starts with (or contains) the pattern, in the
+    // order of their identifiers in the string table. The string table is scanned once (see ifc::find_text_ranges),
+    // the matches are looked up in the file's IdentifierIndex.
+    std::vector<Declaration> find_declarations(Module module, std::string_view pattern, ifc::TextMatch match);
+
+    // Fully qualified name of the declaration, written into a buffer reused between calls, see ParentIndex.
+    std::string_view qualified_name(Declaration declaration, std::string & buffer);
+
+    // Same, as a new name of the arena.
+    std::string_view qualified_name(Declaration declaration, NameArena & arena);
+
+    struct Deprecation
+    {
+        Declaration declaration;
+        std::string_view qualified_name; // In the arena
+        std::string_view message;        // In the string table, empty if none
+    };
+
+    // Deprecated declarations of the module with their messages, named through the file's ParentIndex:
+    // the ones of `trait.deprecated`, in one pass, then the other ones with a `[[deprecated]]` attribute,
+    // through the file's AttributeIndex.
+    std::vector<Deprecation> get_deprecations(Module module, NameArena & arena);
+
+    // Members named by the identifier in the class or its bases, through the Environment for bases in other
+    // modules. Members of a class hide the ones of its bases, like in C++ name lookup, so members of different
+    // bases (an ambiguous lookup) are all returned. Each class's bases are linearized once (see BaseLinearization)
+    // and the members of each scope grouped by identifier once (see ScopeNameIndex), so repeated lookups in
+    // deep hierarchies visit each class at most once without walking its bases again. Using-declarations
+    // are found as the members they name, see UsingResolver.
+    std::vector<Declaration> lookup_member(ClassOrStruct, std::string_view name, ifc::Environment&);
+
+    // Type named through a chain of aliases of the type's module, the type itself if it does not designate an
+    // alias. Chains are followed once per file and memoized, see AliasResolution.
+    Type resolve_underlying(Type type);
+
+    // Same, also following aliases of other modules through the Environment, with the references of each
+    // file resolved in bulk (see Environment::resolve_all_references). Stops at modules that are not in it.
+    Type resolve_underlying(Type type, ifc::Environment&);
+
+    // Without top-level cv-qualifiers and references, and decayed like a by-value argument, each one array
+    // load in the file's TypeStripTable.
+    Type strip_cvref(Type type);
+    Type decay(Type type);
+
+    // Functions and methods of the module taking as many parameters as there are arguments, each accepting its
+    // argument up to cv-qualifiers and references, with arrays and functions decayed to pointers, in DeclIndex
+    // order. Candidates are the users of every argument's core type in the file's TypeUseIndex, intersected from
+    // the least used type, so only their parameter lists are compared (by decay and canonical id, see
+    // TypeHashIndex), not every function type of the module. Arguments are types of the module; parameters
+    // spelled through aliases, conversions and default arguments are not considered. Empty without arguments.
+    std::vector<Declaration> find_callables(Module module, std::span<Type const> arguments);
+
+    // Value of a constant expression, memoized per file, see ConstantEvaluator.
+    std::optional<Constant> evaluate(Expression expression);
+
+    // Names and values of the enumerators, from the file's EnumerationTable.
+    std::span<EnumerationTable::Entry const> enumerator_values(Enumeration enumeration);
+
+    // Structural hash of the type, equal for the same type in different files, see TypeHashIndex.
+    uint64_t structural_hash(Type type);
+
+    // Compares canonical ids within a file and structural hashes across files.
+    bool same_type(Type a, Type b);
+
+    // Structural hash of the template arguments, equal for the same arguments in different files, see TemplateArgumentIndex.
+    uint64_t arguments_hash(SpecializationForm form);
+    uint64_t arguments_hash(SpecializationName name);
+
+    // Compares interned ids within a file and structural hashes across files.
+    bool same_arguments(SpecializationForm a, SpecializationForm b);
+    bool same_arguments(SpecializationName a, SpecializationName b);
+
 #undef FILTER_AND_TRANSFORM
 }
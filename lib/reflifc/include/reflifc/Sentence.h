@@ -0,0 +1,57 @@
+﻿#pragma once
+
+#include "HashCombine.h"
+
+#include <ifc/FileFwd.h>
+#include <ifc/WordFwd.h>
+#include <ifc/common_types.h>
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Writes the sorts of the words to the buffer, replacing its contents.
+    // One pass over the 16-byte records without branches, which compilers vectorize.
+    void decode_word_sorts(std::span<ifc::Word const> words, std::vector<ifc::WordSort>& buffer);
+
+    // A token sequence of `src.sentence`, e.g. a default argument or the body of a template.
+    struct Sentence
+    {
+        Sentence(ifc::File const* ifc, ifc::SentenceIndex index)
+            : ifc_(ifc)
+            , index_(index)
+        {
+        }
+
+        // The null sentence is empty.
+        std::span<ifc::Word const> words() const;
+
+        // Sorts of words(), written to the buffer. Its capacity is reused between calls.
+        void sorts(std::vector<ifc::WordSort>& buffer) const;
+
+        // Spellings of the words, separated by spaces where tokens would fuse otherwise.
+        // Rendered once per sentence and cached by SentenceTextIndex.
+        std::string_view text() const;
+
+        ifc::SentenceIndex index() const { return index_; }
+
+        auto operator<=>(Sentence const& other) const = default;
+
+    private:
+        friend std::hash<Sentence>;
+
+        ifc::File const* ifc_;
+        ifc::SentenceIndex index_;
+    };
+}
+
+template<>
+struct std::hash<reflifc::Sentence>
+{
+    size_t operator()(reflifc::Sentence sentence) const noexcept
+    {
+        return reflifc::hash_handle(sentence.ifc_, sentence.index_);
+    }
+};
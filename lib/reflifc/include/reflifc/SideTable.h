@@ -0,0 +1,79 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/ExpressionFwd.h>
+#include <ifc/TypeFwd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace reflifc
+{
+    // Number of records of each sort in the partitions of the file, 0 for sorts without one.
+    std::array<uint32_t, ifc::DeclIndex::SortCount> sort_cardinalities(ifc::File const&, ifc::DeclSort);
+    std::array<uint32_t, ifc::TypeIndex::SortCount> sort_cardinalities(ifc::File const&, ifc::TypeSort);
+    std::array<uint32_t, ifc::ExprIndex::SortCount> sort_cardinalities(ifc::File const&, ifc::ExprSort);
+
+    // A value for every declaration, type or expression of a file, e.g. to mark visited declarations or keep
+    // metadata computed per declaration without hashing: one array holds the values of each sort in turn,
+    // sized from the cardinalities of their partitions, and is indexed directly by the abstract reference.
+    // Only references to records of the partitions are keys, which excludes the null reference.
+    template<typename Index, typename V>
+    class SideTable
+    {
+    public:
+        using Sort = typename Index::Sort;
+
+        explicit SideTable(ifc::File const& file, V const& initial = V())
+        {
+            const auto counts = sort_cardinalities(file, Sort{});
+            for (size_t sort = 0; sort != counts.size(); ++sort)
+                offsets_[sort + 1] = offsets_[sort] + counts[sort];
+            // Not a vector, which would pack bools into bits.
+            values_ = std::make_unique<V[]>(offsets_.back());
+            std::fill_n(values_.get(), offsets_.back(), initial);
+        }
+
+        V& operator[](Index index) { return values_[offsets_[index.tag] + index.index]; }
+        V const& operator[](Index index) const { return values_[offsets_[index.tag] + index.index]; }
+
+        bool contains(Index index) const { return index.index < offsets_[index.tag + 1] - offsets_[index.tag]; }
+
+        // Null unless the table contains the reference.
+        V* find(Index index) { return contains(index) ? &(*this)[index] : nullptr; }
+        V const* find(Index index) const { return contains(index) ? &(*this)[index] : nullptr; }
+
+        // Values of the records of a sort, in partition order.
+        std::span<V> values(Sort sort)
+        {
+            const auto tag = static_cast<size_t>(sort);
+            return { values_.get() + offsets_[tag], offsets_[tag + 1] - offsets_[tag] };
+        }
+
+        std::span<V const> values(Sort sort) const
+        {
+            const auto tag = static_cast<size_t>(sort);
+            return { values_.get() + offsets_[tag], offsets_[tag + 1] - offsets_[tag] };
+        }
+
+        size_t size() const { return offsets_.back(); }
+
+        size_t heap_bytes() const { return size() * sizeof(V); }
+
+    private:
+        // Values of sort s are values_[offsets_[s], offsets_[s + 1]).
+        std::array<uint32_t, Index::SortCount + 1> offsets_{};
+        std::unique_ptr<V[]> values_;
+    };
+
+    template<typename V>
+    using DeclarationTable = SideTable<ifc::DeclIndex, V>;
+    template<typename V>
+    using TypeTable = SideTable<ifc::TypeIndex, V>;
+    template<typename V>
+    using ExpressionTable = SideTable<ifc::ExprIndex, V>;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Module.h"
+
+#include <ifc/CallingConvention.h>
+#include <ifc/Declaration.h>
+#include <ifc/NoexceptSpecification.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Signatures of every function, method, constructor and destructor of a module, as columns with one
+    // entry per declaration, in the order of `decl.function`, `decl.method`, `decl.constructor` and then
+    // `decl.destructor`. The parameter types of functions[i] are the entries
+    // [parameter_offsets[i], parameter_offsets[i + 1]) of parameter_types.
+    //
+    // Types of function templates are read through their `type.forall`. Declarations of other types
+    // (e.g. syntactic ones) have a null return type, no parameters and the default exception specification
+    // and calling convention.
+    struct FunctionSignatures
+    {
+        std::vector<ifc::DeclIndex> functions;
+        std::vector<ifc::NameIndex> names; // Constructors and destructors are named by the identifier of their class
+        std::vector<ifc::TypeIndex> return_types; // Null for constructors and destructors
+        std::vector<ifc::NoexceptSpecification> eh_specs;
+        std::vector<ifc::CallingConvention> conventions;
+        std::vector<uint32_t> default_arguments; // Number of trailing parameters with a default argument
+
+        std::vector<uint32_t> parameter_offsets{ 0 };
+        std::vector<ifc::TypeIndex> parameter_types;
+
+        size_t size() const { return functions.size(); }
+
+        std::span<ifc::TypeIndex const> parameters(size_t i) const
+        {
+            return std::span(parameter_types).subspan(parameter_offsets[i], parameter_offsets[i + 1] - parameter_offsets[i]);
+        }
+    };
+
+    // One pass over each declaration partition, reading the function types and parameter charts directly
+    // instead of going through Function, Method or Constructor per declaration.
+    FunctionSignatures extract_signatures(Module);
+}
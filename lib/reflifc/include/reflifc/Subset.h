@@ -0,0 +1,20 @@
+#pragma once
+
+#include "index/Reachability.h"
+
+#include <ifc/FileFwd.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace reflifc
+{
+    // A smaller BMI with only the declarations, types, expressions and syntax trees of the file that the
+    // reachability marks, e.g. the exported surface of a module for machines that only import it.
+    // Their partitions are renumbered and every reference to them is fixed up, references to dropped
+    // entries becoming null; scopes keep their reachable members. Names, literals, attributes, charts,
+    // heaps, sentences and the string table keep their entries (and indices), with their references fixed.
+    // Partitions this library does not read are left out, as their references could not be fixed.
+    // The result is a valid file: File checks its layout and checksum as for any other.
+    std::vector<std::byte> write_subset(ifc::File const&, Reachability const&);
+}
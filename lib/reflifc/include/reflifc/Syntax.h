@@ -22,6 +22,9 @@ namespace reflifc
         }
 
         ifc::SyntaxSort sort() const { return index_.sort(); }
+        ifc::SyntaxIndex index() const { return index_; }
+
+        ifc::File const* containing_file() const { return ifc_; }
 
         TemplateIdSyntax            as_template_id()            const;
         Expression                  as_expression()             const;
@@ -46,6 +49,6 @@ struct std::hash<reflifc::Syntax>
 {
     size_t operator()(reflifc::Syntax object) const noexcept
     {
-        return reflifc::hash_combine(0, object.ifc_, object.index_);
+        return reflifc::hash_handle(object.ifc_, object.index_);
     }
 };
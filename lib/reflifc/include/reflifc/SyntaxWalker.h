@@ -0,0 +1,98 @@
+﻿#pragma once
+
+#include "Syntax.h"
+
+#include <ifc/FileFwd.h>
+#include <ifc/SyntaxTreeFwd.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+namespace reflifc
+{
+    // Set of SyntaxSorts, one bit per value of the 7-bit tag.
+    class SyntaxSortSet
+    {
+    public:
+        constexpr SyntaxSortSet() = default;
+
+        constexpr SyntaxSortSet(std::initializer_list<ifc::SyntaxSort> sorts)
+        {
+            for (auto sort : sorts)
+                insert(sort);
+        }
+
+        static constexpr SyntaxSortSet all()
+        {
+            SyntaxSortSet result;
+            result.bits_[0] = result.bits_[1] = ~uint64_t{ 0 };
+            return result;
+        }
+
+        constexpr SyntaxSortSet& insert(ifc::SyntaxSort sort)
+        {
+            const auto value = static_cast<uint32_t>(sort);
+            bits_[value / 64 % 2] |= uint64_t{ 1 } << value % 64;
+            return *this;
+        }
+
+        constexpr bool contains(ifc::SyntaxSort sort) const
+        {
+            const auto value = static_cast<uint32_t>(sort);
+            return (bits_[value / 64 % 2] >> value % 64 & 1) != 0;
+        }
+
+    private:
+        uint64_t bits_[2] = {};
+    };
+
+    // Iterative pre-order walk over syntax trees, through the SyntaxIndex fields of the nodes and the
+    // elements of tuples (expressions are not entered). Nodes of the `interest` sorts are visited, the
+    // children of nodes of the `descend` sorts are walked. Leaves that are of no interest, and subtrees
+    // that are not descended into, are skipped without reading their partitions.
+    // The stack is reused between walks, so one walker per thread serves any number of trees.
+    class SyntaxWalker
+    {
+    public:
+        explicit SyntaxWalker(SyntaxSortSet interest, SyntaxSortSet descend = SyntaxSortSet::all())
+            : interest_(interest)
+            , descend_(descend)
+        {
+        }
+
+        // `visit` is called with a Syntax of each interesting node, in source order. If it returns bool,
+        // false skips the children of the node.
+        template<typename Visitor>
+        void walk(ifc::File const& file, ifc::SyntaxIndex root, Visitor&& visit)
+        {
+            stack_.clear();
+            push(root);
+            while (!stack_.empty())
+            {
+                const auto node = stack_.back();
+                stack_.pop_back();
+
+                bool descend = descend_.contains(node.sort());
+                if (interest_.contains(node.sort()))
+                {
+                    if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, Syntax>, bool>)
+                        descend = visit(Syntax(&file, node)) && descend;
+                    else
+                        visit(Syntax(&file, node));
+                }
+                if (descend)
+                    push_children(file, node);
+            }
+        }
+
+    private:
+        void push(ifc::SyntaxIndex);
+        void push_children(ifc::File const&, ifc::SyntaxIndex);
+
+        SyntaxSortSet interest_;
+        SyntaxSortSet descend_;
+        std::vector<ifc::SyntaxIndex> stack_;
+    };
+}
@@ -1,15 +1,20 @@
 ﻿#pragma once
 
 #include <ifc/common_types.h>
+#include <ifc/AttributeFwd.h>
 #include <ifc/FileFwd.h>
 #include <ifc/ExpressionFwd.h>
 #include <ifc/SyntaxTreeFwd.h>
 #include <ifc/TypeFwd.h>
 
+#include <cassert>
+#include <iterator>
 #include <ranges>
 
 namespace reflifc
 {
+    // Elements of a tuple (or a single element, or none for a null index).
+    // The range of indexes is resolved once on construction, the rest is plain pointer arithmetic.
     template<typename Traits>
     struct TupleView : std::ranges::view_interface<TupleView<Traits>>
     {
@@ -19,7 +24,10 @@ namespace reflifc
 
         struct Iterator
         {
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
             using value_type = Element;
+            using reference = Element;
             using difference_type = std::ptrdiff_t;
 
             Iterator(Index const* index, ifc::File const* ifc)
@@ -31,6 +39,11 @@ namespace reflifc
 
             Element operator*() const;
 
+            Element operator[](difference_type n) const
+            {
+                return *(*this + n);
+            }
+
             Iterator& operator++()
             {
                 ++index_;
@@ -44,46 +57,88 @@ namespace reflifc
                 return res;
             }
 
+            Iterator& operator--()
+            {
+                --index_;
+                return *this;
+            }
+
+            Iterator operator--(int)
+            {
+                auto res = *this;
+                --*this;
+                return res;
+            }
+
+            Iterator& operator+=(difference_type n)
+            {
+                index_ += n;
+                return *this;
+            }
+
+            Iterator& operator-=(difference_type n)
+            {
+                index_ -= n;
+                return *this;
+            }
+
+            friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+            friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+            friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+
+            friend difference_type operator-(Iterator a, Iterator b)
+            {
+                assert(a.ifc_ == b.ifc_);
+                return a.index_ - b.index_;
+            }
+
             friend bool operator==(Iterator a, Iterator b)
             {
                 assert(a.ifc_ == b.ifc_);
                 return a.index_ == b.index_;
             }
 
+            friend auto operator<=>(Iterator a, Iterator b)
+            {
+                assert(a.ifc_ == b.ifc_);
+                return a.index_ <=> b.index_;
+            }
+
         private:
-            Index const* index_;
-            ifc::File const* ifc_;
+            Index const* index_ = nullptr;
+            ifc::File const* ifc_ = nullptr;
         };
 
         TupleView() = default;
 
-        TupleView(ifc::File const* ifc, Index const& index)
-            : index_(&index)
-            , ifc_(ifc)
-        {
-        }
+        TupleView(ifc::File const* ifc, Index const& index);
 
-        Iterator begin() const;
-        Iterator end()   const;
+        Iterator begin() const { return { first_, ifc_ }; }
+        Iterator end()   const { return { last_, ifc_ }; }
 
+        // Throws std::out_of_range.
         Element operator[] (size_t index) const;
 
-        size_t size() const;
-        bool   empty() const;
+        size_t size() const { return static_cast<size_t>(last_ - first_); }
+        bool   empty() const { return first_ == last_; }
 
     private:
-        ifc::Sequence get_tuple_elements() const;
-        Iterator get_tuple_element(ifc::Index) const;
-
-    private:
-        Index const* index_;
-        ifc::File const* ifc_;
+        Index const* first_ = nullptr;
+        Index const* last_ = nullptr;
+        ifc::File const* ifc_ = nullptr;
     };
 
+    struct Attribute;
     struct Expression;
     struct Syntax;
     struct Type;
 
+    struct TupleAttributeTraits
+    {
+        using Index = ifc::AttrIndex;
+        using Element = Attribute;
+    };
+
     struct TupleExpressionTraits
     {
         using Index = ifc::ExprIndex;
@@ -102,6 +157,11 @@ namespace reflifc
         using Element = Type;
     };
 
+    struct TupleAttributeView : TupleView<TupleAttributeTraits>
+    {
+        using TupleView::TupleView;
+    };
+
     struct TupleExpressionView : TupleView<TupleExpressionTraits>
     {
         using TupleView::TupleView;
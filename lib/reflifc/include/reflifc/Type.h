@@ -26,6 +26,9 @@ namespace reflifc
 
     struct Type
     {
+        // Null, e.g. to size the buffers of collect_types.
+        Type() = default;
+
         Type(ifc::File const* ifc, ifc::TypeIndex index)
             : ifc_(ifc)
             , index_(index)
@@ -86,14 +89,17 @@ namespace reflifc
         PathExpression  typename_path() const;
 
         ifc::TypeSort sort() const { return index_.sort(); }
+        ifc::TypeIndex index() const { return index_; }
+
+        ifc::File const* containing_file() const { return ifc_; }
 
         auto operator<=>(Type const& other) const = default;
 
     private:
         friend std::hash<Type>;
 
-        ifc::File const* ifc_;
-        ifc::TypeIndex index_;
+        ifc::File const* ifc_ = nullptr;
+        ifc::TypeIndex index_{};
     };
 }
 
@@ -102,6 +108,6 @@ struct std::hash<reflifc::Type>
 {
     size_t operator()(reflifc::Type object) const noexcept
     {
-        return reflifc::hash_combine(0, object.ifc_, object.index_);
+        return reflifc::hash_handle(object.ifc_, object.index_);
     }
 };
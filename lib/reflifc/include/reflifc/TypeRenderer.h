@@ -0,0 +1,74 @@
+#pragma once
+
+#include "NameArena.h"
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/ExpressionFwd.h>
+#include <ifc/NameFwd.h>
+#include <ifc/TypeFwd.h>
+
+#include <array>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ifc
+{
+    class Environment;
+}
+
+namespace reflifc
+{
+    // C++ spelling of the types of a file, like `std::vector<int,std::allocator<int>> const&`.
+    // Each type is rendered once, its spelling is kept in a NameArena owned by the renderer and reused
+    // by every type containing it.
+    //
+    // Declarations are spelled by their qualified name, see ParentIndex. Declarations imported from other
+    // modules are only resolved when an Environment is given, they are spelled "(imported)" otherwise.
+    // Not thread-safe.
+    class TypeRenderer
+    {
+    public:
+        explicit TypeRenderer(ifc::File const&, ifc::Environment* = nullptr);
+
+        TypeRenderer(TypeRenderer const&) = delete;
+        TypeRenderer& operator=(TypeRenderer const&) = delete;
+
+        // Valid as long as the renderer. The null type is spelled as an empty string.
+        std::string_view spelling(ifc::TypeIndex);
+
+        // Appends the spelling to `out`, whose capacity is reused by the caller.
+        void append(ifc::TypeIndex, std::string & out);
+
+        // Spelling of a name as written in a declaration, like `operator+=`, `operator int`
+        // or `vector<int,std::allocator<int>>`. Only names other than identifiers are kept in the arena.
+        std::string_view spelling(ifc::NameIndex);
+
+    private:
+        void render(ifc::TypeIndex, std::string & out);
+        void render(ifc::ExprIndex, std::string & out);
+        void render_declaration(ifc::DeclIndex, std::string & out);
+        void render_list(ifc::TypeIndex, std::string & out);
+        void render_list(ifc::ExprIndex, std::string & out);
+
+        void render_name(ifc::NameIndex, std::string & out);
+
+        template<typename Index>
+        std::string_view memoized(std::vector<std::string_view> & spellings, Index);
+
+        ifc::File const& file_;
+        ifc::Environment* environment_;
+
+        // Spellings by type and name, per sort. Null views are not rendered yet.
+        std::array<std::vector<std::string_view>, ifc::TypeIndex::SortCount> spellings_;
+        std::array<std::vector<std::string_view>, ifc::NameIndex::SortCount> name_spellings_;
+        NameArena arena_;
+
+        // Scratch buffers for rendering, one per nesting level of `spelling`.
+        std::deque<std::string> buffers_;
+        size_t depth_ = 0;
+        std::string name_buffer_;
+    };
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Declaration.h"
+#include "Expression.h"
+#include "Literal.h"
+#include "StringLiteral.h"
+#include "Syntax.h"
+#include "TemplateId.h"
+#include "Type.h"
+#include "decl/AliasDeclaration.h"
+#include "decl/Concept.h"
+#include "decl/DeclarationReference.h"
+#include "decl/Enumeration.h"
+#include "decl/Field.h"
+#include "decl/Function.h"
+#include "decl/Intrinsic.h"
+#include "decl/Parameter.h"
+#include "decl/ScopeDeclaration.h"
+#include "decl/Specialization.h"
+#include "decl/TemplateDeclaration.h"
+#include "decl/UsingDeclaration.h"
+#include "decl/Variable.h"
+#include "expr/Alignof.h"
+#include "expr/Call.h"
+#include "expr/Dyad.h"
+#include "expr/Monad.h"
+#include "expr/Path.h"
+#include "expr/ProductValueType.h"
+#include "expr/QualifiedName.h"
+#include "expr/Read.h"
+#include "expr/RequiresExpression.h"
+#include "expr/UnqualifiedId.h"
+#include "syntax/TemplateId.h"
+#include "syntax/TypeId.h"
+#include "syntax/TypeSpecifier.h"
+#include "syntax/TypeTraitIntrinsic.h"
+#include "type/Array.h"
+#include "type/Base.h"
+#include "type/Expansion.h"
+#include "type/Forall.h"
+#include "type/Function.h"
+#include "type/Placeholder.h"
+#include "type/Pointer.h"
+#include "type/Qualified.h"
+#include "type/Reference.h"
+
+#include <array>
+#include <type_traits>
+
+namespace reflifc
+{
+    // Handle of the given sort is turned into a typed one by `As`.
+    template<auto Sort, auto As>
+    struct VisitCase
+    {
+        static constexpr auto sort = Sort;
+        static constexpr auto as = As;
+    };
+
+    // Calls the visitor with the typed handle for the sort of the handle, through a table indexed by the sort.
+    // Sorts without a case are visited with the handle itself, so the visitor must accept that too
+    // (e.g. with an `auto` overload). All calls must return the type returned for the handle itself.
+    template<typename Handle, typename Visitor, typename... Cases>
+    decltype(auto) visit_by_sort(Handle handle, Visitor && visitor, Cases...)
+    {
+        using Result = std::invoke_result_t<Visitor&, Handle>;
+        using Entry = Result (*)(Handle, Visitor&);
+        using Index = decltype(handle.index());
+
+        static constexpr auto table = [] {
+            std::array<Entry, Index::SortCount> entries;
+            entries.fill([](Handle h, Visitor& v) -> Result { return v(h); });
+            ((entries[static_cast<size_t>(Cases::sort)] = [](Handle h, Visitor& v) -> Result { return v((h.*Cases::as)()); }), ...);
+            return entries;
+        }();
+
+        return table[static_cast<size_t>(handle.sort())](handle, visitor);
+    }
+
+    template<typename Visitor>
+    decltype(auto) visit(Declaration declaration, Visitor && visitor)
+    {
+        using ifc::DeclSort;
+        return visit_by_sort(declaration, visitor,
+            VisitCase<DeclSort::Scope,                 &Declaration::as_scope>{},
+            VisitCase<DeclSort::Enumeration,           &Declaration::as_enumeration>{},
+            VisitCase<DeclSort::Alias,                 &Declaration::as_alias>{},
+            VisitCase<DeclSort::UsingDeclaration,      &Declaration::as_using>{},
+            VisitCase<DeclSort::Template,              &Declaration::as_template>{},
+            VisitCase<DeclSort::Specialization,        &Declaration::as_specialization>{},
+            VisitCase<DeclSort::PartialSpecialization, &Declaration::as_partial_specialization>{},
+            VisitCase<DeclSort::Concept,               &Declaration::as_concept>{},
+            VisitCase<DeclSort::Variable,              &Declaration::as_variable>{},
+            VisitCase<DeclSort::Field,                 &Declaration::as_field>{},
+            VisitCase<DeclSort::Parameter,             &Declaration::as_parameter>{},
+            VisitCase<DeclSort::Function,              &Declaration::as_function>{},
+            VisitCase<DeclSort::Method,                &Declaration::as_method>{},
+            VisitCase<DeclSort::Constructor,           &Declaration::as_constructor>{},
+            VisitCase<DeclSort::Destructor,            &Declaration::as_destructor>{},
+            VisitCase<DeclSort::Intrinsic,             &Declaration::as_intrinsic>{},
+            VisitCase<DeclSort::Reference,             &Declaration::as_reference>{});
+    }
+
+    // Designated, syntactic, decltype and typename types are visited as Type.
+    template<typename Visitor>
+    decltype(auto) visit(Type type, Visitor && visitor)
+    {
+        using ifc::TypeSort;
+        return visit_by_sort(type, visitor,
+            VisitCase<TypeSort::Fundamental,     &Type::as_fundamental>{},
+            VisitCase<TypeSort::Array,           &Type::as_array>{},
+            VisitCase<TypeSort::Base,            &Type::as_base>{},
+            VisitCase<TypeSort::LvalueReference, &Type::as_lvalue_reference>{},
+            VisitCase<TypeSort::RvalueReference, &Type::as_rvalue_reference>{},
+            VisitCase<TypeSort::Pointer,         &Type::as_pointer>{},
+            VisitCase<TypeSort::Function,        &Type::as_function>{},
+            VisitCase<TypeSort::Method,          &Type::as_method>{},
+            VisitCase<TypeSort::Qualified,       &Type::as_qualified>{},
+            VisitCase<TypeSort::Expansion,       &Type::as_expansion>{},
+            VisitCase<TypeSort::Forall,          &Type::as_forall>{},
+            VisitCase<TypeSort::Placeholder,     &Type::as_placeholder>{});
+    }
+
+    template<typename Visitor>
+    decltype(auto) visit(Expression expression, Visitor && visitor)
+    {
+        using ifc::ExprSort;
+        return visit_by_sort(expression, visitor,
+            VisitCase<ExprSort::Monad,             &Expression::as_monad>{},
+            VisitCase<ExprSort::Dyad,              &Expression::as_dyad>{},
+            VisitCase<ExprSort::UnqualifiedId,     &Expression::as_unqualified_id>{},
+            VisitCase<ExprSort::QualifiedName,     &Expression::as_qualified_name>{},
+            VisitCase<ExprSort::Call,              &Expression::as_call>{},
+            VisitCase<ExprSort::Literal,           &Expression::as_literal>{},
+            VisitCase<ExprSort::String,            &Expression::as_string_literal>{},
+            VisitCase<ExprSort::Type,              &Expression::as_type>{},
+            VisitCase<ExprSort::Read,              &Expression::as_read>{},
+            VisitCase<ExprSort::TemplateId,        &Expression::as_template_id>{},
+            VisitCase<ExprSort::TemplateReference, &Expression::as_template_reference>{},
+            VisitCase<ExprSort::Path,              &Expression::as_path>{},
+            VisitCase<ExprSort::Alignof,           &Expression::as_alignof>{},
+            VisitCase<ExprSort::Requires,          &Expression::as_requires>{},
+            VisitCase<ExprSort::ProductTypeValue,  &Expression::as_product_value_type>{});
+    }
+
+    template<typename Visitor>
+    decltype(auto) visit(Syntax syntax, Visitor && visitor)
+    {
+        using ifc::SyntaxSort;
+        return visit_by_sort(syntax, visitor,
+            VisitCase<SyntaxSort::TemplateId,         &Syntax::as_template_id>{},
+            VisitCase<SyntaxSort::Expression,         &Syntax::as_expression>{},
+            VisitCase<SyntaxSort::TypeId,             &Syntax::as_type_id>{},
+            VisitCase<SyntaxSort::TypeSpecifierSeq,   &Syntax::as_type_specifier>{},
+            VisitCase<SyntaxSort::TypeTraitIntrinsic, &Syntax::as_type_trait_intrinsic>{});
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Declaration.h"
+#include "Generator.h"
+#include "Module.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/Parallel.h>
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace reflifc
+{
+    struct WalkEntry
+    {
+        Declaration declaration;
+        // Namespace, class (template) or enumeration the declaration is a member of, null in the global namespace.
+        Declaration parent;
+        // 0 in the global namespace.
+        uint32_t depth = 0;
+    };
+
+    struct WalkOptions
+    {
+        // Enumerators are walked as members of their enumeration.
+        bool enumerators = true;
+        // Members of class templates are walked as members of the template.
+        bool template_members = true;
+        // Walks the members of different namespaces concurrently, see walk.
+        ifc::Executor* executor = nullptr;
+        // Checked every ifc::CancellationInterval declarations and installed while `visit` runs, so that
+        // the indexes it builds check it too. By default the token of the calling thread.
+        ifc::CancellationToken const* cancellation = nullptr;
+    };
+
+    // See walk.
+    void walk_declarations(Module, std::function<bool(WalkEntry const&)> const& visit, WalkOptions = {});
+
+    // Pre-order walk over every declaration reachable from the global namespace of the module, through
+    // namespaces, classes, class templates and enumerations, with an explicit stack instead of recursion.
+    // `visit` is called with a WalkEntry of each declaration, before its members, which are visited in
+    // declaration order. If it returns bool, false skips the members.
+    // With an executor, namespaces are walked first on the calling thread, then the other members of each
+    // namespace as a task of its own: `visit` is called concurrently and the namespaces interleave.
+    // A cancelled walk throws ifc::Cancelled.
+    template<typename Visitor>
+    void walk(Module module, Visitor&& visit, WalkOptions options = {})
+    {
+        walk_declarations(module, [&visit] (WalkEntry const& entry) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Visitor&, WalkEntry const&>, bool>)
+                return visit(entry);
+            else
+            {
+                visit(entry);
+                return true;
+            }
+        }, options);
+    }
+
+    // The declarations of walk, in the same pre-order, yielded one by one: the walk is suspended between them
+    // with its explicit stack in the coroutine frame, so they can be consumed in pages (see Generator::next_page),
+    // e.g. the first ones of a huge header unit before the walk goes on. Members are always walked and the
+    // executor is ignored. The cancellation token is checked like that of walk, as the walk is resumed.
+    Generator<WalkEntry> walk_generator(Module, WalkOptions = {});
+}
@@ -5,6 +5,8 @@
 #include <ifc/FileFwd.h>
 #include <ifc/WordFwd.h>
 
+#include <string_view>
+
 namespace reflifc
 {
     struct Word
@@ -18,6 +20,10 @@ namespace reflifc
         bool        is_identifier() const;
         char const* as_identifier() const;
 
+        // Source spelling of identifiers, keywords, punctuators, operators and literals.
+        // Empty for directives, MSVC markers and the MSVC trait intrinsics.
+        std::string_view spelling() const;
+
         auto operator<=>(Word const& other) const = default;
 
     private:
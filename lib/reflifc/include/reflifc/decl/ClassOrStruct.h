@@ -35,6 +35,12 @@ namespace reflifc
             return Scope(ifc_, scope_->initializer).get_declarations();
         }
 
+        ViewOf<Declaration> auto members(ifc::DeclSort sort) const
+        {
+            assert(is_complete());
+            return Scope(ifc_, scope_->initializer).get_declarations(sort);
+        }
+
         ViewOf<BaseType> auto bases() const
         {
             return TupleTypeView(ifc_, scope_->base) | std::views::transform(&Type::as_base);
@@ -42,6 +48,16 @@ namespace reflifc
 
         Declaration home_scope() const;
 
+        // Index of the declaration in the file.
+        ifc::DeclIndex index() const;
+
+        // Requires is_complete().
+        Scope scope() const
+        {
+            assert(is_complete());
+            return Scope(ifc_, scope_->initializer);
+        }
+
         ifc::File const* containing_file() const { return ifc_; }
 
         auto operator<=>(ClassOrStruct const& other) const = default;
@@ -55,15 +71,13 @@ namespace reflifc
 
     inline ViewOf<Field> auto fields(ClassOrStruct strct)
     {
-        return strct.members()
-            | std::views::filter(&Declaration::is_field)
+        return strct.members(ifc::DeclSort::Field)
             | std::views::transform(&Declaration::as_field);
     }
 
     inline ViewOf<Variable> auto static_variables(ClassOrStruct strct)
     {
-        return strct.members()
-            | std::views::filter(&Declaration::is_variable)
+        return strct.members(ifc::DeclSort::Variable)
             | std::views::transform(&Declaration::as_variable);
     }
 }
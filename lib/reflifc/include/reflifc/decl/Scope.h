@@ -6,6 +6,12 @@
 
 #include <ifc/File.h>
 #include <ifc/Declaration.h>
+#include <ifc/SortFilter.h>
+
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
 
 namespace reflifc
 {
@@ -24,10 +30,60 @@ namespace reflifc
                 | std::views::transform([ifc = ifc_] (ifc::Declaration decl) { return Declaration(ifc, decl.index); });
         }
 
+        // Members of the sort, found with one ifc::find_sort pass over the members.
+        ViewOf<Declaration> auto get_declarations(ifc::DeclSort sort) const
+        {
+            const auto scope_members = ifc::get_declarations(*ifc_, ifc_->scope_descriptors()[scope_]);
+            std::vector<uint32_t> positions;
+            ifc::find_sort(scope_members, sort, positions);
+            return std::views::all(std::move(positions))
+                | std::views::transform([ifc = ifc_, scope_members] (uint32_t position) {
+                    return Declaration(ifc, scope_members[ifc::Index{ position }].index);
+                });
+        }
+
+        // Lookup of members by identifier through the file's ScopeNameIndex.
+        std::optional<Declaration> find(std::string_view name) const;
+
+        ViewOf<Declaration> auto find_all(std::string_view name) const
+        {
+            return members_named(name)
+                | std::views::transform([ifc = ifc_] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+        }
+
+        // Members named by the identifier of the sort.
+        ViewOf<Declaration> auto find_all(std::string_view name, ifc::DeclSort sort) const
+        {
+            const auto members = members_named(name);
+            std::vector<uint32_t> positions;
+            ifc::find_sort(members, sort, positions);
+            return std::views::all(std::move(positions))
+                | std::views::transform([ifc = ifc_, members] (uint32_t position) { return Declaration(ifc, members[position]); });
+        }
+
+        // Functions, methods and function templates by name, through the file's OverloadSetIndex.
+        ViewOf<Declaration> auto find_overloads(std::string_view name) const
+        {
+            return overloads_named(name)
+                | std::views::transform([ifc = ifc_] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+        }
+
+        ViewOf<Declaration> auto find_overloads(ifc::Operator op) const
+        {
+            return overloads_of(op)
+                | std::views::transform([ifc = ifc_] (ifc::DeclIndex decl) { return Declaration(ifc, decl); });
+        }
+
         ifc::File const* containing_file() const { return ifc_; }
+        ifc::ScopeIndex index() const { return scope_; }
 
         auto operator<=>(Scope const& other) const = default;
         
+    private:
+        std::span<ifc::DeclIndex const> members_named(std::string_view name) const;
+        std::span<ifc::DeclIndex const> overloads_named(std::string_view name) const;
+        std::span<ifc::DeclIndex const> overloads_of(ifc::Operator op) const;
+
     private:
         friend std::hash<Scope>;
 
@@ -4,6 +4,7 @@
 #include "reflifc/Name.h"
 
 #include <ifc/DeclarationFwd.h>
+#include <ifc/ExpressionFwd.h>
 #include <ifc/FileFwd.h>
 
 namespace reflifc
@@ -20,6 +21,7 @@ namespace reflifc
 
         Declaration primary_template()  const;
         TupleExpressionView arguments() const;
+        ifc::ExprIndex      arguments_index() const;
 
         ifc::File const* containing_file() const { return ifc_; }
 
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/TypeFwd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace reflifc
+{
+    // Type named through a chain of aliases (`using size_type = ...`, `typedef`) by each designated type of a
+    // file: the aliasee of the alias, of the alias it designates in turn, and so on. Chains are followed
+    // within the file and stop at the first type that does not designate an alias of the file, e.g. a class,
+    // a specialization or an alias of another module (`decl.reference`). Each designated type is resolved
+    // once and the whole chain memoized with it, so resolving many types follows each alias once.
+    // Qualifiers, pointers and other types built on an alias are not rewritten.
+    // Safe to use from multiple threads. Obtained via `ifc::File::get_index<AliasResolution>()`.
+    class AliasResolution
+    {
+    public:
+        explicit AliasResolution(ifc::File const&);
+
+        // The type itself if it does not designate an alias of the file.
+        ifc::TypeIndex underlying(ifc::File const&, ifc::TypeIndex) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        // Of `type.designated`, the bits of the resolved type, 0 until resolved.
+        uint32_t count_ = 0;
+        std::unique_ptr<std::atomic<uint32_t>[]> designated_;
+    };
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/AttributeFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Declarations of a file by the names of their attributes, built in one pass over `trait.attribute`
+    // and `.msvc.trait.decl-attrs`. A name is the identifier of a basic attribute (`deprecated`) or the
+    // scope and member of a scoped one (`ns::meta`), also inside calls (`[[deprecated("...")]]`),
+    // packs, using-prefixes (`[[using ns: meta]]`) and attribute lists.
+    // Obtained via `ifc::File::get_index<AttributeIndex>()`.
+    class AttributeIndex
+    {
+    public:
+        explicit AttributeIndex(ifc::File const&);
+
+        static constexpr std::string_view Partitions[] = { "trait.attribute", ".msvc.trait.decl-attrs", "attr.", "heap.attr" };
+
+        // Declarations with an attribute of that name, `identifier` or `scope::identifier`, in DeclIndex order.
+        std::span<ifc::DeclIndex const> find(ifc::File const&, std::string_view name) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        // Keys are (scope, identifier) pairs of text offsets, the scope being null for basic attributes.
+        // Sorted by key, declarations with the same key are sorted and distinct.
+        std::pmr::vector<uint64_t> keys_;
+        std::pmr::vector<ifc::DeclIndex> decls_;
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ifc/Environment.h>
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace reflifc
+{
+    // Each class of a file followed by its direct and indirect bases, depth first and left to right,
+    // each class once, so the bases of a class are the classes after it up to its `end`.
+    // Bases in other modules are resolved through an Environment and referred to by their ids in it.
+    // A class is linearized on the first lookup, reusing the linearizations of its bases, and again only
+    // once a module it names was unloaded or it is linearized for another Environment.
+    // Obtained via `ifc::File::get_index<BaseLinearization>()`.
+    class BaseLinearization
+    {
+    public:
+        struct Base
+        {
+            ifc::DeclarationId id;
+            // One past the last of its own bases.
+            uint32_t end;
+        };
+
+        struct Linearization
+        {
+            ifc::Environment const* environment;
+            std::vector<Base> bases;
+        };
+
+        explicit BaseLinearization(ifc::File const&);
+
+        // The class itself comes first. Dependent bases (e.g. `B<T>`) are left out.
+        std::shared_ptr<Linearization const> find(ifc::File const&, ifc::DeclIndex, ifc::Environment&) const;
+
+        // Classes named by the bases of the class, in order, leaving out dependent bases.
+        static std::vector<ifc::Environment::ResolvedDeclaration> direct_bases(ifc::File const&, ifc::DeclIndex, ifc::Environment&);
+
+        // Of the classes linearized so far.
+        size_t heap_bytes() const;
+
+    private:
+        std::shared_ptr<Linearization const> linearize(ifc::File const&, ifc::DeclIndex, ifc::Environment&) const;
+
+        // By index of the scope declaration, null until linearized.
+        mutable std::pmr::vector<std::atomic<std::shared_ptr<Linearization const>>> classes_;
+    };
+}
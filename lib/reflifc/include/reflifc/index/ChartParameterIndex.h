@@ -0,0 +1,32 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/ChartFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Template parameters of every chart of a file as flat lists, built in one pass over `chart.unilevel`
+    // and `chart.multilevel`. The parameters of a multilevel chart are the ones of each of its levels,
+    // outermost first, so that matching or printing a template signature needs no per-level slices.
+    // Obtained via `ifc::File::get_index<ChartParameterIndex>()`.
+    class ChartParameterIndex
+    {
+    public:
+        explicit ChartParameterIndex(ifc::File const&);
+
+        // Empty for `chart.none`.
+        std::span<ifc::ParameterDeclaration const* const> parameters(ifc::ChartIndex) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        // Parameters of chart i of each sort are [offsets[i], offsets[i + 1]) of parameters_.
+        std::vector<uint32_t> unilevel_offsets_{ 0 };
+        std::vector<uint32_t> multilevel_offsets_{ 0 };
+        std::vector<ifc::ParameterDeclaration const*> parameters_;
+    };
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/Parallel.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace ifc
+{
+    class Environment;
+    class ModuleGraph;
+}
+
+namespace reflifc
+{
+    // Base and derived classes of every class, struct and union of a set of files, with dense class ids.
+    // Built explicitly, one file per task. Bases referenced from other modules (through `decl.reference`)
+    // are resolved through the Environment, bases outside of the set of files are left out,
+    // and so are dependent bases like `B<T>`.
+    //
+    // Transitive base sets are bitsets over class ids, computed once per class when first needed.
+    class ClassHierarchy
+    {
+    public:
+        using ClassId = uint32_t;
+
+        struct Class
+        {
+            ifc::File const* file;
+            ifc::DeclIndex decl;
+        };
+
+        // Without an Environment, bases from other modules are left out too.
+        explicit ClassHierarchy(std::span<ifc::File const* const> files, ifc::Environment* = nullptr, ifc::Executor& = ifc::default_executor());
+        ClassHierarchy(ifc::ModuleGraph const&, ifc::Environment&, ifc::Executor& = ifc::default_executor());
+        ~ClassHierarchy();
+
+        size_t size() const { return classes_.size(); }
+
+        Class const& get(ClassId id) const { return classes_[id]; }
+        std::optional<ClassId> find(ifc::File const&, ifc::DeclIndex) const;
+
+        std::span<ClassId const> direct_bases(ClassId id) const
+        {
+            return std::span(bases_).subspan(base_offsets_[id], base_offsets_[id + 1] - base_offsets_[id]);
+        }
+
+        std::span<ClassId const> direct_derived(ClassId id) const
+        {
+            return std::span(derived_).subspan(derived_offsets_[id], derived_offsets_[id + 1] - derived_offsets_[id]);
+        }
+
+        // Whether `base` is a direct or indirect base of `derived`.
+        bool derives_from(ClassId derived, ClassId base) const;
+
+        // Every direct or indirect base, in increasing id order.
+        std::vector<ClassId> all_bases(ClassId) const;
+
+        // Every direct or indirect derived class, in increasing id order.
+        std::vector<ClassId> all_derived(ClassId) const;
+
+    private:
+        std::span<uint64_t const> base_closure(ClassId) const;
+
+        std::vector<Class> classes_;
+
+        // Per file, the class id of each of its scope declarations, NoClass for namespaces.
+        static constexpr ClassId NoClass = UINT32_MAX;
+        std::unordered_map<ifc::File const*, std::vector<ClassId>> ids_;
+
+        // Adjacency of class i is [offsets_[i]..offsets_[i + 1]) in each direction.
+        std::vector<uint32_t> base_offsets_;
+        std::vector<ClassId> bases_;
+        std::vector<uint32_t> derived_offsets_;
+        std::vector<ClassId> derived_;
+
+        mutable std::mutex closures_mutex_;
+        mutable std::vector<std::unique_ptr<uint64_t[]>> base_closures_;
+    };
+}
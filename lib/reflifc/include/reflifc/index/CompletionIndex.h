@@ -0,0 +1,70 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/Parallel.h>
+
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    class QualifiedNameList;
+
+    // Completion of qualified names (e.g. `std::chr`) over a set of files, like those of an Environment: the
+    // sorted QualifiedNameList of each file is searched for the prefix and the matches of the files are merged.
+    // Files are added, replaced (e.g. once the Environment reloaded one) and removed one by one without
+    // touching the lists of the others. Safe to use from multiple threads.
+    class CompletionIndex
+    {
+    public:
+        struct Completion
+        {
+            std::string_view qualified_name; // In the list of the file, valid until the file is removed
+            ifc::File const* file;
+            ifc::DeclIndex decl;
+        };
+
+        CompletionIndex() = default;
+
+        // With the lists of the files, built one per task.
+        explicit CompletionIndex(std::span<ifc::File const* const> files, ifc::Executor& = ifc::default_executor());
+
+        // With its list (see File::get_index), or the one given, e.g. over a mapped `.names` file, which is kept.
+        // A file added twice keeps its first list.
+        void add(ifc::File const&);
+        void add(ifc::File const&, std::shared_ptr<QualifiedNameList const>);
+
+        // Removes the file and adds the new version in its place, in the position of the file.
+        void replace(ifc::File const& old_file, ifc::File const& new_file);
+
+        void remove(ifc::File const&);
+
+        // Names starting with the prefix, sorted, each name in the order of the files (at most `limit`).
+        // A leading `::` is ignored.
+        void complete(std::string_view prefix, size_t limit, std::vector<Completion> & out) const;
+
+        // Members of the scope (a qualified name, empty for the global scope) whose name starts with the prefix,
+        // without their own members: `std`, `chr` finds `std::chrono` but not `std::chrono::duration`.
+        void complete_members(std::string_view scope, std::string_view prefix, size_t limit, std::vector<Completion> & out) const;
+
+        size_t file_count() const;
+
+    private:
+        struct Entry
+        {
+            ifc::File const* file;
+            std::shared_ptr<QualifiedNameList const> names;
+        };
+
+        // Names starting with the prefix, without those with a `::` from the position `members_from` on.
+        void search(std::string_view prefix, size_t members_from, size_t limit, std::vector<Completion> & out) const;
+
+        mutable std::shared_mutex mutex_;
+        std::vector<Entry> entries_;
+    };
+}
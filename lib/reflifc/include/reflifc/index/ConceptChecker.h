@@ -0,0 +1,142 @@
+#pragma once
+
+#include "reflifc/Type.h"
+#include "reflifc/decl/Concept.h"
+
+#include <ifc/Declaration.h>
+#include <ifc/ExpressionFwd.h>
+#include <ifc/FileFwd.h>
+#include <ifc/Operator.h>
+#include <ifc/SyntaxTreeFwd.h>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace ifc
+{
+    class Environment;
+}
+
+namespace reflifc
+{
+    struct NormalizedConstraint;
+
+    enum class Satisfaction : uint8_t
+    {
+        Unsatisfied,
+        Satisfied,
+        Unknown, // Outside of the decidable subset
+    };
+
+    // Whether types satisfy concepts, for a decidable subset of constraints: conjunctions, disjunctions and
+    // negations of concept-ids, of `std::same_as`, of the type trait intrinsics that only depend on what kind of
+    // type their arguments are (`__is_class`, `__is_union`, `__is_enum`, `__is_base_of`) and of the constant
+    // expressions of ConstantEvaluator. Other atomic constraints are Unknown, and so are the conjunctions and
+    // disjunctions they leave undecided.
+    //
+    // Definitions are normalized by the ConstraintIndex of their file. Each atomic constraint is evaluated once
+    // per argument list: arguments are made canonical at their top (aliases followed, parameters of the
+    // enclosing concept replaced by what they are bound to) and the lists interned, so that repeated checks of
+    // a concept, and atoms reached through several concepts (e.g. `std::same_as<T, U>`), are hash lookups.
+    // Concepts and classes of other modules (`decl.reference`) are resolved through the environment, if any.
+    // Safe to use from multiple threads, checks run one at a time.
+    class ConceptChecker
+    {
+    public:
+        explicit ConceptChecker(ifc::Environment* environment = nullptr);
+
+        ConceptChecker(ConceptChecker const&) = delete;
+        ConceptChecker& operator=(ConceptChecker const&) = delete;
+
+        // Arguments by position of the parameters of the concept's chart, Unknown if their numbers differ.
+        Satisfaction check(Concept, std::span<Type const> arguments) const;
+
+        // Memoized atomic constraints.
+        size_t size() const;
+
+        size_t heap_bytes() const;
+
+    private:
+        static constexpr uint32_t Unbound = UINT32_MAX;
+
+        // A type of a file, read under the argument list `bindings` when it involves parameters.
+        struct Argument
+        {
+            Type type;
+            uint32_t bindings = Unbound;
+
+            bool operator==(Argument const&) const = default;
+        };
+
+        struct ArgumentList
+        {
+            ifc::ParameterLevel level;
+            std::vector<Argument> arguments;
+
+            bool operator==(ArgumentList const&) const = default;
+        };
+
+        struct ArgumentListHash
+        {
+            size_t operator()(ArgumentList const&) const noexcept;
+        };
+
+        struct AtomKey
+        {
+            ifc::File const* file;
+            ifc::ExprIndex atom;
+            uint32_t bindings;
+
+            bool operator==(AtomKey const&) const = default;
+        };
+
+        struct AtomKeyHash
+        {
+            size_t operator()(AtomKey const&) const noexcept;
+        };
+
+        // What a declaration designated by a type is, through `decl.reference`.
+        struct Resolved
+        {
+            ifc::File const* file = nullptr;
+            ifc::DeclIndex decl{};
+        };
+
+        enum class TypeKind : uint8_t
+        {
+            Class,
+            Union,
+            Enumeration,
+            Other,
+        };
+
+        uint32_t intern(ArgumentList) const;
+        Argument canonical(Argument) const;
+        std::optional<Argument> type_argument(ifc::File const&, ifc::ExprIndex, uint32_t bindings) const;
+        std::optional<Argument> type_argument(ifc::File const&, ifc::SyntaxIndex, uint32_t bindings) const;
+        Resolved resolve(ifc::File const&, ifc::DeclIndex) const;
+        Resolved designation(Argument) const;
+        std::optional<TypeKind> kind(Argument) const;
+
+        Satisfaction check_concept(Concept, std::vector<Argument> const&, unsigned depth) const;
+        Satisfaction evaluate(ifc::File const&, NormalizedConstraint const&, uint32_t node, uint32_t bindings, unsigned depth) const;
+        Satisfaction atom(ifc::File const&, ifc::ExprIndex, uint32_t bindings, unsigned depth) const;
+        Satisfaction compute(ifc::File const&, ifc::ExprIndex, uint32_t bindings, unsigned depth) const;
+        Satisfaction concept_id(ifc::File const&, ifc::ExprIndex template_id, uint32_t bindings, unsigned depth) const;
+        Satisfaction unary_trait(ifc::MonadicOperator, std::optional<Argument>) const;
+        Satisfaction binary_trait(ifc::DyadicOperator, std::optional<Argument>, std::optional<Argument>) const;
+        Satisfaction same_type(Argument, Argument, unsigned depth) const;
+        Satisfaction base_of(Argument base, Argument derived) const;
+
+        ifc::Environment* environment_;
+
+        mutable std::mutex mutex_;
+        mutable std::unordered_map<ArgumentList, uint32_t, ArgumentListHash> list_ids_;
+        mutable std::vector<ArgumentList const*> lists_; // By id, into list_ids_
+        mutable std::unordered_map<AtomKey, Satisfaction, AtomKeyHash> atoms_;
+    };
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <ifc/Cancellation.h>
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/ExpressionFwd.h>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace reflifc
+{
+    // Value of an integral, boolean (as 0 or 1) or floating point constant expression.
+    using Constant = std::variant<int64_t, uint64_t, double>;
+
+    // Values of the constant expressions of a file, each evaluated once, when first asked for.
+    //
+    // Evaluates a subset of constant expressions: literals, enumerators, constexpr variables of the file
+    // and the built-in arithmetic, bitwise, comparison and logical operators applied to them. Expressions
+    // outside of it (calls, sizeof, declarations of other modules, division by zero, ...) have no value.
+    // Obtained via `ifc::File::get_index<ConstantEvaluator>()`.
+    class ConstantEvaluator
+    {
+    public:
+        explicit ConstantEvaluator(ifc::File const&);
+
+        // The token (by default the one of the calling thread) is checked every ifc::CancellationInterval
+        // subexpressions. A cancelled evaluation throws ifc::Cancelled, the values it did not finish are
+        // evaluated again when next asked for.
+        std::optional<Constant> evaluate(ifc::File const&, ifc::ExprIndex, ifc::CancellationToken const* = nullptr) const;
+
+        // Value of the initializer of an enumerator or a constexpr variable.
+        std::optional<Constant> value(ifc::File const&, ifc::DeclIndex, ifc::CancellationToken const* = nullptr) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        enum class State : uint8_t
+        {
+            Unevaluated,
+            Evaluating,
+            Constant,
+            NotConstant,
+        };
+
+        struct Entry
+        {
+            State state = State::Unevaluated;
+            Constant value;
+        };
+
+        std::optional<Constant> evaluate_locked(ifc::File const&, ifc::ExprIndex, unsigned depth) const;
+        std::optional<Constant> value_locked(ifc::File const&, ifc::DeclIndex, unsigned depth) const;
+        std::optional<Constant> compute(ifc::File const&, ifc::ExprIndex, unsigned depth) const;
+        Entry& slot(ifc::ExprIndex) const;
+
+        mutable std::mutex mutex_;
+        // Of the evaluation in progress.
+        mutable ifc::CancellationToken const* cancellation_ = nullptr;
+        mutable size_t steps_ = 0;
+        mutable std::array<std::vector<Entry>, ifc::ExprIndex::SortCount> entries_;
+    };
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/ExpressionFwd.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace reflifc
+{
+    // Constraint as conjunctions and disjunctions of atomic constraints: nested `&&` (or `||`) of the same
+    // operator are flattened into one node and parentheses are dropped, so `(A && B) && C` and `A && (B && C)`
+    // have the same form.
+    struct NormalizedConstraint
+    {
+        enum class Kind : uint8_t
+        {
+            Atomic,
+            Conjunction,
+            Disjunction,
+        };
+
+        struct Node
+        {
+            Kind kind;
+            // Operands of a conjunction or disjunction are nodes[first, first + count).
+            uint32_t first;
+            uint32_t count;
+            // Expression of an atomic constraint, null otherwise.
+            ifc::ExprIndex atom;
+        };
+
+        // nodes[0] is the root, empty for a null constraint.
+        std::vector<Node> nodes;
+
+        // Concepts named by the atomic constraints, sorted and distinct.
+        std::vector<ifc::DeclIndex> concepts;
+    };
+
+    // Templates of a file by the concepts their constraints name, built in one pass over the charts of
+    // `decl.template`, `decl.partial-specialization` and `decl.concept` (whose definitions may name other
+    // concepts), and the normal forms of constraint expressions, each computed once, when first asked for.
+    // Obtained via `ifc::File::get_index<ConstraintIndex>()`.
+    class ConstraintIndex
+    {
+    public:
+        explicit ConstraintIndex(ifc::File const&);
+
+        // Templates, partial specializations and concepts constrained by the concept, in DeclIndex order.
+        std::span<ifc::DeclIndex const> constrained_by(ifc::DeclIndex concept_decl) const;
+
+        // References stay valid for the lifetime of the index.
+        NormalizedConstraint const& normalized(ifc::File const&, ifc::ExprIndex constraint) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        // Sorted by concept, templates of the same concept are sorted and distinct.
+        std::pmr::vector<ifc::DeclIndex> concepts_;
+        std::pmr::vector<ifc::DeclIndex> templates_;
+
+        mutable std::mutex mutex_;
+        mutable std::unordered_map<ifc::ExprIndex, NormalizedConstraint> normalized_;
+    };
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <memory_resource>
+#include <span>
+
+namespace reflifc
+{
+    // Deduction guides of a file by the primary template they deduce the arguments of, built in one pass over
+    // `decl.template` and `decl.function` for the declarations named by a `name.guide`. A guide template is
+    // listed once, without the function it parameterizes.
+    // Obtained via `ifc::File::get_index<DeductionGuideIndex>()`.
+    class DeductionGuideIndex
+    {
+    public:
+        explicit DeductionGuideIndex(ifc::File const&);
+
+        // Guides of the class template, in DeclIndex order.
+        std::span<ifc::DeclIndex const> guides(ifc::DeclIndex primary_template) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        // Sorted by primary template, guides of the same template are sorted.
+        std::pmr::vector<ifc::DeclIndex> primary_templates_;
+        std::pmr::vector<ifc::DeclIndex> guides_;
+    };
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/Scope.h>
+
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Scope owning each position of `scope.member`, found by a binary search over the starts of the member
+    // sequences of `scope.desc`, which are contiguous and disjoint, and the declaration owning each scope.
+    // Gives every member its parent in O(log n) from two arrays the size of `scope.desc`, where ParentIndex
+    // walks the whole scope tree to store a parent per declaration.
+    // Obtained via `ifc::File::get_index<EnclosingScopeIndex>()`.
+    class EnclosingScopeIndex
+    {
+    public:
+        static constexpr std::string_view Partitions[] = { "scope.desc", "decl.scope", "decl.template" };
+
+        explicit EnclosingScopeIndex(ifc::File const&);
+
+        // Scope whose members include the position, null if none does.
+        ifc::ScopeIndex owning_scope(ifc::Index member) const;
+
+        // Namespace or class whose initializer is the scope, or the template of a class template (like
+        // ParentIndex::parent), null for the global scope and for scopes of no declaration.
+        ifc::DeclIndex owner(ifc::ScopeIndex) const;
+
+        // Declaration owning the scope that owns the position, see owner.
+        ifc::DeclIndex parent(ifc::Index member) const { return owner(owning_scope(member)); }
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Interval
+        {
+            uint32_t start; // Position of the first member
+            uint32_t end;
+            ifc::ScopeIndex scope;
+        };
+
+        std::pmr::vector<Interval> intervals_; // Of the non-empty scopes, sorted by start
+        std::pmr::vector<ifc::DeclIndex> owners_; // By scope index - 1
+    };
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "reflifc/FlatMap.h"
+
+#include <ifc/Environment.h>
+#include <ifc/Parallel.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Entities declared in several of a set of files, typically the STL machinery repeated by header units
+    // imported together, mapped to one canonical copy. Each named declaration reachable from the global scopes
+    // (see GlobalSymbolIndex) is identified by a 64-bit hash of its qualified name, its kind and, for functions
+    // and function templates, the spelling of its type, hashed one file per task. A `decl.reference` is
+    // identified as the declaration the Environment resolves it to, unresolvable ones are left out.
+    // The canonical copy of an entity is its first definition in the order of the files, or the resolution of
+    // its first reference if no file defines it.
+    class EntityIdentity
+    {
+    public:
+        using Entity = ifc::Environment::ResolvedDeclaration;
+
+        EntityIdentity(ifc::Environment&, std::span<ifc::File const* const> files, ifc::Executor& = ifc::default_executor());
+
+        // The declaration itself if it was not identified.
+        Entity canonical(ifc::File const&, ifc::DeclIndex) const;
+
+        // Declarations identified as the same entity as the declaration, including itself, definitions first.
+        // Empty if it was not identified.
+        std::span<Entity const> copies(ifc::File const&, ifc::DeclIndex) const;
+
+        size_t entity_count() const { return canonical_.size(); }
+        size_t declaration_count() const { return copies_.size(); }
+
+    private:
+        struct Key
+        {
+            ifc::File const* file = nullptr;
+            ifc::DeclIndex decl{};
+
+            bool operator==(Key const&) const = default;
+        };
+
+        struct KeyHasher
+        {
+            size_t operator()(Key const&) const noexcept;
+        };
+
+        // Copies of entity i are copies_[offsets_[i], offsets_[i + 1]).
+        std::vector<Entity> copies_;
+        std::vector<uint32_t> offsets_;
+        std::vector<Entity> canonical_;
+        FlatMap<Key, uint32_t, KeyHasher> entities_;
+    };
+}
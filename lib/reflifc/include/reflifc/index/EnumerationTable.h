@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ConstantEvaluator.h"
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/common_types.h>
+
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Names and values of the enumerators of every enumeration of a file, extracted in one pass over
+    // `decl.enumerator`, whose order they keep: the enumerators of an enumeration are the ones of its
+    // `initializer` sequence. Values are evaluated by the file's ConstantEvaluator.
+    // Obtained via `ifc::File::get_index<EnumerationTable>()`.
+    class EnumerationTable
+    {
+    public:
+        struct Entry
+        {
+            std::string_view name;
+            std::optional<Constant> value; // Empty if the initializer is not a constant the evaluator supports
+        };
+
+        explicit EnumerationTable(ifc::File const&);
+
+        // Every enumerator of the file.
+        std::span<Entry const> entries() const { return entries_; }
+
+        std::span<Entry const> enumerators(ifc::Sequence enumerators) const;
+        std::span<Entry const> enumerators(ifc::File const&, ifc::DeclIndex enumeration) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        std::vector<Entry> entries_;
+    };
+}
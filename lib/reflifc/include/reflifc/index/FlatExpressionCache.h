@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/ExpressionFwd.h>
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace reflifc
+{
+    // Expression trees of a file as contiguous arrays of nodes in post-order, so that walks over the same
+    // expression scan one array instead of jumping between the `expr.*` partitions. Each tree is flattened
+    // once, when first asked for; nothing is built up front.
+    // Obtained via `ifc::File::get_index<FlatExpressionCache>()`.
+    class FlatExpressionCache
+    {
+    public:
+        struct Node
+        {
+            // Read from the partition of expr.sort(), e.g. file.call_expressions()[expr].
+            ifc::ExprIndex expr;
+            // The children are the last child_count subtrees before the node, in source order.
+            uint32_t child_count;
+
+            ifc::ExprSort sort() const;
+        };
+
+        explicit FlatExpressionCache(ifc::File const&);
+
+        // The root is the last node, empty for a null expression. Children are the non-null operands,
+        // arguments, elements and resolutions of calls, paths, reads, operators, template-ids, tuples and
+        // lists; other expressions are leaves. References stay valid for the lifetime of the cache.
+        std::span<Node const> flatten(ifc::File const&, ifc::ExprIndex root) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        mutable std::mutex mutex_;
+        mutable std::unordered_map<ifc::ExprIndex, std::vector<Node>> trees_;
+    };
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/ExpressionFwd.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Friendships of a file in both directions, built in one pass over `trait.friend`: every friend declaration
+    // of every class, and the classes befriending each function or class, as a compressed sparse row index
+    // over the befriended declarations. Friends named by an expression that does not designate a declaration
+    // (e.g. a specialization of a function template) are only listed in `friendships`.
+    // Obtained via `ifc::File::get_index<FriendshipIndex>()`.
+    class FriendshipIndex
+    {
+    public:
+        struct Friendship
+        {
+            ifc::DeclIndex befriending;   // The class
+            ifc::DeclIndex friend_decl;   // `decl.friend`
+            ifc::ExprIndex entity;        // Of the friend declaration
+            ifc::DeclIndex befriended;    // Designated by the entity, null if it designates none
+        };
+
+        static constexpr std::string_view Partitions[] = { "trait.friend", "decl.friend", "scope.member", "expr.", "type." };
+
+        explicit FriendshipIndex(ifc::File const&);
+
+        // Every (class, friend) pair of the file, classes in the order of `trait.friend`, the friends of
+        // a class in declaration order.
+        std::span<Friendship const> friendships() const { return friendships_; }
+
+        // Classes that declare the function or class a friend, sorted and distinct.
+        std::span<ifc::DeclIndex const> befriending(ifc::DeclIndex befriended) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        std::pmr::vector<Friendship> friendships_;
+        // Befriended declarations, sorted and distinct, befriended by classes_[offsets_[i]..offsets_[i + 1]).
+        std::pmr::vector<ifc::DeclIndex> befriended_;
+        std::pmr::vector<uint32_t> offsets_;
+        std::pmr::vector<ifc::DeclIndex> classes_;
+    };
+}
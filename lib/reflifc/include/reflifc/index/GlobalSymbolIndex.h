@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/Parallel.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ifc
+{
+    class ModuleGraph;
+}
+
+namespace reflifc
+{
+    // Fully qualified names (without a leading `::`) of every named declaration reachable
+    // from the global scopes of a set of files, through namespaces, classes and class templates.
+    // Built explicitly from the QualifiedNameList of each file, one file per task, then merged into a single
+    // sorted table.
+    class GlobalSymbolIndex
+    {
+    public:
+        struct Symbol
+        {
+            ifc::File const* file;
+            ifc::DeclIndex decl;
+        };
+
+        explicit GlobalSymbolIndex(std::span<ifc::File const* const> files, ifc::Executor& = ifc::default_executor());
+        explicit GlobalSymbolIndex(ifc::ModuleGraph const&, ifc::Executor& = ifc::default_executor());
+
+        // Every declaration with the name, in the order of the files the index was built from.
+        // Leading `::` is ignored.
+        std::span<Symbol const> find(std::string_view qualified_name) const;
+
+        size_t size() const { return symbols_.size(); }
+
+    private:
+        // symbols_[i] is named by names_[name_offsets_[i]..name_offsets_[i + 1]), sorted by name.
+        std::string names_;
+        std::vector<uint32_t> name_offsets_;
+        std::vector<Symbol> symbols_;
+
+        std::string_view name(size_t i) const
+        {
+            return std::string_view(names_).substr(name_offsets_[i], name_offsets_[i + 1] - name_offsets_[i]);
+        }
+    };
+}
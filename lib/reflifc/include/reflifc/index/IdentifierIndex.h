@@ -0,0 +1,46 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/TextSearch.h>
+#include <ifc/common_types.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Declarations of every `decl.*` partition of a file by the identifier naming them (see
+    // ifc::declaration_identifier), in one table sorted by text offset. Equal texts at different offsets
+    // are keyed by the offset of the first string with that text, so lookups are by text.
+    // Obtained via `ifc::File::get_index<IdentifierIndex>()`.
+    class IdentifierIndex
+    {
+    public:
+        explicit IdentifierIndex(ifc::File const&);
+
+        // Declaration identifiers are read from the declarations and their names.
+        static constexpr std::string_view Partitions[] = { "decl.", "name." };
+
+        // Declarations named by the identifier, by sort and then in partition order.
+        std::span<ifc::DeclIndex const> find(ifc::File const&, std::string_view identifier) const;
+        std::span<ifc::DeclIndex const> find(ifc::File const&, ifc::TextOffset identifier) const;
+
+        // Declarations named by identifiers in the ranges (see ifc::find_text_ranges), appended to `out`
+        // in the order of their identifiers in the string table.
+        void find(std::span<ifc::TextRange const> ranges, std::vector<ifc::DeclIndex>& out) const;
+
+        size_t size() const { return decls_.size(); }
+
+        size_t heap_bytes() const;
+
+    private:
+        std::span<ifc::DeclIndex const> find(uint32_t offset) const;
+
+        std::pmr::vector<uint32_t> offsets_; // Sorted, the identifier of decls_[i]
+        std::pmr::vector<ifc::DeclIndex> decls_;
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/SourceLocation.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Source location resolved through the line table, `file` is empty and `line` 0 if unknown.
+    struct Location
+    {
+        std::string_view file;
+        uint32_t line = 0;
+        uint32_t column = 0;
+    };
+
+    // The line table of a file (`src.line`) with the source files of its entries resolved to their paths,
+    // so that turning a SourceLocation into a Location is two array loads.
+    // Obtained via `ifc::File::get_index<LineTable>()`.
+    class LineTable
+    {
+    public:
+        explicit LineTable(ifc::File const&);
+
+        Location locate(ifc::SourceLocation) const;
+
+        // Location of the declaration, empty for the sorts without one (e.g. specializations).
+        Location locate(ifc::File const&, ifc::DeclIndex) const;
+
+        // Position of the source file of the location in files(), 0 if unknown.
+        uint32_t file_position(ifc::SourceLocation) const;
+
+        // Paths of the source files of `name.source-file` after the unknown file, an empty path.
+        std::span<std::string_view const> files() const { return files_; }
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Line
+        {
+            uint32_t file; // Position in files_
+            uint32_t line;
+        };
+
+        std::pmr::vector<std::string_view> files_; // files_[0] is the unknown file
+        std::pmr::vector<Line> lines_;
+    };
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/ExpressionFwd.h>
+#include <ifc/Literal.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Values of every literal of a file decoded into flat arrays, in one pass over each of `const.i64`,
+    // `const.f64` and `const.str`, whose order they keep, so that a LitIndex or StringIndex indexes them
+    // directly. The encoding of a string is the sort of the StringIndex that `expr.strings` refers to it with.
+    // Obtained via `ifc::File::get_index<LiteralTable>()`.
+    class LiteralTable
+    {
+    public:
+        struct String
+        {
+            // Encoded code units, without the terminating null.
+            std::string_view value;
+            ifc::StringSort encoding;
+            // `u8`, `u`, `U` or `L`, empty for ordinary strings.
+            std::string_view prefix;
+            // User-defined literal suffix, empty if none.
+            std::string_view suffix;
+        };
+
+        explicit LiteralTable(ifc::File const&);
+
+        static constexpr std::string_view Partitions[] = { "const.", "expr.strings" };
+
+        // Values of `const.i64` and `const.f64`, indexed by the index of a LitIndex of their sort.
+        std::span<uint64_t const> integers() const { return integers_; }
+        std::span<double const> floating_points() const { return floating_points_; }
+
+        // Values of `const.str`, indexed by the index of a StringIndex.
+        std::span<String const> strings() const { return strings_; }
+
+        // Immediate and integer literals, 0 for floating-point ones.
+        uint64_t integer(ifc::LitIndex) const;
+        // Any literal, integers converted.
+        double floating_point(ifc::LitIndex) const;
+        String const& string(ifc::StringIndex index) const { return strings_[index.index]; }
+
+        size_t heap_bytes() const;
+
+    private:
+        std::pmr::vector<uint64_t> integers_;
+        std::pmr::vector<double> floating_points_;
+        std::pmr::vector<String> strings_;
+    };
+}
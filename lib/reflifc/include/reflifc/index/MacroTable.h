@@ -0,0 +1,32 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/MacroFwd.h>
+
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+namespace reflifc
+{
+    // Macros of a header unit by name, hashed in one pass over `macro.object-like` and `macro.function-like`,
+    // so that "does the header unit define X" is one lookup. A name defined in both partitions maps to the
+    // function-like macro, a name defined twice in one to its last definition.
+    // Obtained via `ifc::File::get_index<MacroTable>()`.
+    class MacroTable
+    {
+    public:
+        explicit MacroTable(ifc::File const&);
+
+        std::optional<ifc::MacroIndex> find(std::string_view name) const;
+
+        size_t size() const { return macros_.size(); }
+
+        size_t heap_bytes() const;
+
+    private:
+        // Names point into the string table of the file.
+        std::pmr::unordered_map<std::string_view, ifc::MacroIndex> macros_;
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/Operator.h>
+#include <ifc/Scope.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Functions, methods and function templates of every scope of a file grouped by name:
+    // by identifier, or by operator for operator functions. Names of specializations and templates
+    // (`name.specialization`, `name.template`) are grouped with their primary name.
+    // The members of a scope are grouped on the first lookup in that scope.
+    // Obtained via `ifc::File::get_index<OverloadSetIndex>()`.
+    class OverloadSetIndex
+    {
+    public:
+        explicit OverloadSetIndex(ifc::File const&);
+
+        // Overloads of the scope named by the identifier, in declaration order.
+        std::span<ifc::DeclIndex const> find(ifc::File const&, ifc::ScopeIndex, ifc::TextOffset identifier) const;
+
+        // Overloads of the operator in the scope, in declaration order.
+        std::span<ifc::DeclIndex const> find(ifc::File const&, ifc::ScopeIndex, ifc::Operator) const;
+
+        // Of the scopes grouped so far.
+        size_t heap_bytes() const;
+
+    private:
+        // Keys are (name sort, identifier or operator) pairs.
+        // Sorted by key, members with the same key keep their declaration order.
+        struct ScopeOverloads
+        {
+            std::pmr::vector<uint64_t> keys;
+            std::pmr::vector<ifc::DeclIndex> members;
+        };
+
+        // Allocated from the resource of the file, like the grouped members.
+        struct LazyScopeOverloads
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            explicit LazyScopeOverloads(allocator_type allocator)
+                : overloads{ decltype(ScopeOverloads::keys)(allocator), decltype(ScopeOverloads::members)(allocator) }
+            {
+            }
+
+            std::once_flag once;
+            std::atomic<bool> built = false; // Set once the members are grouped
+            ScopeOverloads overloads;
+        };
+
+        std::span<ifc::DeclIndex const> find(ifc::File const&, ifc::ScopeIndex, uint64_t key) const;
+
+        mutable std::pmr::vector<LazyScopeOverloads> scopes_;
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    class NameArena;
+
+    // Parent of every declaration reachable from the global scope of a file: the namespace, class,
+    // class template or enumeration it is a member of. Stored in one flat array, with the declarations
+    // of every DeclSort in a range of their own.
+    // Obtained via `ifc::File::get_index<ParentIndex>()`.
+    class ParentIndex
+    {
+    public:
+        explicit ParentIndex(ifc::File const&);
+
+        // Null for members of the global scope and for declarations that are not members of any scope.
+        ifc::DeclIndex parent(ifc::DeclIndex) const;
+
+        // Fully qualified name of the declaration (without a leading `::`), written into `buffer`,
+        // whose capacity is reused between calls. Unnamed declarations are written as "(unnamed)".
+        std::string_view qualified_name(ifc::File const&, ifc::DeclIndex, std::string & buffer) const;
+
+        // Same, as a new name of the arena.
+        std::string_view qualified_name(ifc::File const&, ifc::DeclIndex, NameArena &) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        template<typename Out>
+        void write_qualified_name(ifc::File const&, ifc::DeclIndex, Out &) const;
+
+        // Parents of the declarations of sort s are parents_[offsets_[s]..offsets_[s + 1]).
+        std::array<uint32_t, 33> offsets_{};
+        std::vector<ifc::DeclIndex> parents_;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace reflifc
+{
+    // Declarations of a file by source position, for editor hover and go-to-definition: the innermost
+    // declaration at a line and column of a source file, by a binary search over the declarations of that
+    // source file. IFC records where declarations start, not where they end, so a declaration extends up to
+    // the next declaration of its source file that is not one of its members: members of namespaces, classes,
+    // class templates and enumerations nest in them. Declarations reachable from the global scope through
+    // those are indexed, parameters are not. Positions are located through the file's LineTable.
+    // Obtained via `ifc::File::get_index<PositionIndex>()`.
+    class PositionIndex
+    {
+    public:
+        explicit PositionIndex(ifc::File const&);
+
+        // Innermost declaration at the position of the source file, as spelled in `name.source-file` (see
+        // Name::as_source_file), null if the position precedes every declaration of the source file.
+        ifc::DeclIndex innermost(std::string_view path, uint32_t line, uint32_t column) const;
+
+        // The declarations at the position, innermost first.
+        std::vector<ifc::DeclIndex> enclosing(std::string_view path, uint32_t line, uint32_t column) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        static constexpr uint32_t None = ~uint32_t{ 0 };
+
+        struct Interval
+        {
+            uint64_t start; // Line and column, see position
+            uint64_t end; // Start of the declaration closing it, or past every position
+            uint32_t parent; // Innermost interval containing this one, or None
+            ifc::DeclIndex decl;
+        };
+
+        static uint64_t position(uint32_t line, uint32_t column)
+        {
+            return uint64_t{ line } << 32 | column;
+        }
+
+        // Innermost interval containing the position, or None.
+        uint32_t find(std::string_view path, uint64_t position) const;
+
+        // Paths point into the string table of the file.
+        std::pmr::unordered_map<std::string_view, std::pair<uint32_t, uint32_t>> files_; // Range of intervals_ of each source file
+        std::pmr::vector<Interval> intervals_; // Grouped by source file, sorted by start within
+    };
+}
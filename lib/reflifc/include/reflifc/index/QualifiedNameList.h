@@ -0,0 +1,58 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace reflifc
+{
+    // Fully qualified names (without a leading `::`) of every named declaration reachable from the global scope
+    // of a file, through namespaces, classes and class templates, sorted, in one flat buffer that can be written
+    // next to the BMI (e.g. as `<file>.names` by ifc-warm) and mapped back instead of walking the scopes again.
+    // A table of the first name starting with each byte narrows every prefix search to the names of its first
+    // character before the binary search.
+    // Obtained via `ifc::File::get_index<QualifiedNameList>()`, or over the contents of a `.names` file.
+    class QualifiedNameList
+    {
+    public:
+        explicit QualifiedNameList(ifc::File const&);
+
+        // Over the contents of a written list, in place. They must outlive the list and be 8-byte aligned.
+        // Throws std::runtime_error if they were written for a different file (by size and checksum),
+        // by another version, or are corrupted.
+        QualifiedNameList(ifc::File const&, std::span<std::byte const> contents);
+
+        QualifiedNameList(QualifiedNameList const&) = delete;
+        QualifiedNameList& operator=(QualifiedNameList const&) = delete;
+
+        size_t size() const;
+        std::string_view name(size_t i) const;
+        ifc::DeclIndex decl(size_t i) const;
+
+        // Positions [first, last) of the names starting with the prefix.
+        std::pair<size_t, size_t> prefix_range(std::string_view prefix) const;
+
+        // Serialized list, to be written as it is.
+        std::span<std::byte const> contents() const { return contents_; }
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Header;
+
+        void attach();
+        Header const& header() const;
+
+        std::vector<std::byte> owned_;
+        std::span<std::byte const> contents_;
+        uint32_t const* name_ends_ = nullptr; // The end of name i, which starts at the end of name i - 1
+        ifc::DeclIndex const* decls_ = nullptr;
+        char const* names_ = nullptr;
+    };
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace reflifc
+{
+    // Resolves qualified names like `a::b::C` starting from the global scope of a file,
+    // memoizing results for every resolved prefix.
+    // Obtained via `ifc::File::get_index<QualifiedNameResolver>()`.
+    class QualifiedNameResolver
+    {
+    public:
+        explicit QualifiedNameResolver(ifc::File const&) {}
+
+        // Null DeclIndex if the name cannot be resolved. Leading `::` is ignored.
+        ifc::DeclIndex resolve(ifc::File const&, std::string_view qualified_name) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        ifc::DeclIndex resolve_uncached(ifc::File const&, std::string_view qualified_name) const;
+
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view s) const noexcept
+            {
+                return std::hash<std::string_view>{}(s);
+            }
+        };
+
+        mutable std::shared_mutex mutex_;
+        mutable std::unordered_map<std::string, ifc::DeclIndex, StringHash, std::equal_to<>> resolved_;
+    };
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/ChartFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/ExpressionFwd.h>
+#include <ifc/SyntaxTreeFwd.h>
+#include <ifc/TypeFwd.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Declarations, types, expressions and syntax trees of a file that an importer can reach from its
+    // exported declarations (see SpecifierTable), or from other roots, e.g. to audit an API surface or to
+    // skip the internals of a header unit when indexing. Computed in one pass with a worklist per kind of
+    // entry and a bitset per sort, so every entry is expanded once:
+    //  - declarations reach their names, types, initializers, charts, specialization forms and home scopes, classes
+    //    and enumerations their members, templates their specializations (namespaces not their members),
+    //  - types reach their operands, declarations, expressions and syntax trees,
+    //  - expressions reach their types and operands, down to the declarations they name,
+    //  - syntax trees reach their children and the types and expressions they were resolved to.
+    // Declarations of other modules (`decl.reference`) are reached but not followed.
+    // Obtained via `ifc::File::get_index<Reachability>()`.
+    class Reachability
+    {
+    public:
+        // From the exported declarations.
+        explicit Reachability(ifc::File const&);
+        Reachability(ifc::File const&, std::span<ifc::DeclIndex const> roots);
+
+        bool reachable(ifc::DeclIndex decl) const { return test(declarations_, decl); }
+        bool reachable(ifc::TypeIndex type) const { return test(types_, type); }
+        bool reachable(ifc::ExprIndex expr) const { return test(expressions_, expr); }
+        bool reachable(ifc::SyntaxIndex syntax) const { return test(syntax_trees_, syntax); }
+
+        // Reachable entries of each kind.
+        size_t declaration_count() const { return declaration_count_; }
+        size_t type_count() const { return type_count_; }
+        size_t expression_count() const { return expression_count_; }
+        size_t syntax_count() const { return syntax_count_; }
+
+        // Reachable declarations of the sort, in partition order.
+        std::vector<ifc::DeclIndex> declarations(ifc::DeclSort) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        class Walker;
+
+        // Bit i % 64 of word i / 64 of the vector of a sort is entry i of the sort, grown as entries are marked.
+        template<typename Index>
+        using Bits = std::array<std::vector<uint64_t>, Index::SortCount>;
+
+        template<typename Index>
+        static bool test(Bits<Index> const& bits, Index index)
+        {
+            auto const & words = bits[index.tag];
+            const size_t word = index.index / 64;
+            return word < words.size() && (words[word] >> (index.index % 64) & 1) != 0;
+        }
+
+        Bits<ifc::DeclIndex> declarations_;
+        Bits<ifc::TypeIndex> types_;
+        Bits<ifc::ExprIndex> expressions_;
+        Bits<ifc::SyntaxIndex> syntax_trees_;
+        size_t declaration_count_ = 0;
+        size_t type_count_ = 0;
+        size_t expression_count_ = 0;
+        size_t syntax_count_ = 0;
+    };
+}
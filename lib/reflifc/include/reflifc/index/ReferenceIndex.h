@@ -0,0 +1,56 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Declarations of a file referenced by the expressions the file exports with other declarations, built in
+    // one pass over the declaration partitions: the initializers of variables, fields, bitfields and enumerators,
+    // and the default arguments of the parameters of functions, methods, constructors and templates, which
+    // are references of the function or template itself. Expressions are walked through calls, paths, reads,
+    // operators (whose overloads are references too), template-ids and lists, down to their declarations.
+    // Both directions are stored as compressed rows: the references of a declaration, and its referrers.
+    // Obtained via `ifc::File::get_index<ReferenceIndex>()`.
+    class ReferenceIndex
+    {
+    public:
+        explicit ReferenceIndex(ifc::File const&);
+
+        static constexpr std::string_view Partitions[] = { "decl.", "expr.", "heap.expr", "chart." };
+
+        // Declarations referenced by the declaration, sorted and distinct.
+        std::span<ifc::DeclIndex const> references(ifc::DeclIndex) const;
+
+        // Declarations referencing the declaration, sorted and distinct.
+        std::span<ifc::DeclIndex const> referrers(ifc::DeclIndex) const;
+
+        // Number of distinct (referencing, referenced) pairs.
+        size_t edge_count() const { return targets_.size(); }
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Rows
+        {
+            explicit Rows(std::pmr::memory_resource*);
+
+            // Sorted, the row of keys[i] is columns[offsets[i], offsets[i + 1]).
+            std::pmr::vector<ifc::DeclIndex> keys;
+            std::pmr::vector<uint32_t> offsets;
+
+            std::span<ifc::DeclIndex const> row(std::pmr::vector<ifc::DeclIndex> const& columns, ifc::DeclIndex) const;
+        };
+
+        Rows forward_;
+        std::pmr::vector<ifc::DeclIndex> targets_;
+        Rows backward_;
+        std::pmr::vector<ifc::DeclIndex> sources_;
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/Scope.h>
+
+#include <atomic>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Members of every scope of a file grouped by identifier, compared by text (see ifc::File::find_text).
+    // The members of a scope are grouped on the first lookup in that scope, and grouped again with
+    // using-declarations and namespace aliases replaced by their targets on the first lookup through them.
+    // Obtained via `ifc::File::get_index<ScopeNameIndex>()`.
+    class ScopeNameIndex
+    {
+    public:
+        explicit ScopeNameIndex(ifc::File const&);
+
+        // Members of the scope named by the identifier, in declaration order.
+        std::span<ifc::DeclIndex const> find(ifc::File const&, ifc::ScopeIndex, ifc::TextOffset identifier) const;
+
+        // Same, with using-declarations and namespace aliases replaced by the declarations they stand for
+        // (see UsingResolver), so that lookups through them answer directly.
+        std::span<ifc::DeclIndex const> find_resolved(ifc::File const&, ifc::ScopeIndex, ifc::TextOffset identifier) const;
+
+        // Of the scopes grouped so far.
+        size_t heap_bytes() const;
+
+    private:
+        // Sorted by identifier, members with the same identifier keep their declaration order.
+        struct ScopeMembers
+        {
+            std::pmr::vector<ifc::TextOffset> identifiers;
+            std::pmr::vector<ifc::DeclIndex> members;
+        };
+
+        // Allocated from the resource of the file, like the grouped members.
+        struct LazyScopeMembers
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            explicit LazyScopeMembers(allocator_type allocator)
+                : members{ decltype(ScopeMembers::identifiers)(allocator), decltype(ScopeMembers::members)(allocator) }
+                , resolved{ decltype(ScopeMembers::identifiers)(allocator), decltype(ScopeMembers::members)(allocator) }
+            {
+            }
+
+            std::once_flag once;
+            std::atomic<bool> built = false; // Set once the members are grouped
+            bool has_indirections = false;   // Using-declarations or namespace aliases among the members
+            ScopeMembers members;
+
+            // Grouped only for scopes with indirections.
+            std::once_flag resolved_once;
+            std::atomic<bool> resolved_built = false;
+            ScopeMembers resolved;
+        };
+
+        // Null for the null scope.
+        LazyScopeMembers* grouped(ifc::File const&, ifc::ScopeIndex) const;
+
+        mutable std::pmr::vector<LazyScopeMembers> scopes_;
+    };
+}
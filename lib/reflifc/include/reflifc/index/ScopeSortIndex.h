@@ -0,0 +1,82 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/TypeFwd.h>
+#include <ifc/Scope.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Members of every scope of a file grouped by declaration sort,
+    // and scope declarations additionally by their kind (namespace, class, union...),
+    // in declaration order within a group.
+    // The members of a scope are grouped on the first lookup in that scope.
+    // Obtained via `ifc::File::get_index<ScopeSortIndex>()`.
+    class ScopeSortIndex
+    {
+    public:
+        explicit ScopeSortIndex(ifc::File const&);
+
+        // Members of the scope of the given sort, in declaration order.
+        std::span<ifc::DeclIndex const> members(ifc::File const&, ifc::ScopeIndex, ifc::DeclSort) const;
+
+        // Scope declarations of the scope with kinds in [first, last], grouped by kind. See `members` for all
+        // of them in declaration order.
+        std::span<ifc::DeclIndex const> scope_members(ifc::File const&, ifc::ScopeIndex, ifc::TypeBasis first, ifc::TypeBasis last) const;
+
+        std::span<ifc::DeclIndex const> scope_members(ifc::File const& file, ifc::ScopeIndex scope, ifc::TypeBasis kind) const
+        {
+            return scope_members(file, scope, kind, kind);
+        }
+
+        // Of the scopes grouped so far.
+        size_t heap_bytes() const;
+
+    private:
+        // Sorted by key, members with the same key keep their declaration order.
+        struct Group
+        {
+            explicit Group(std::pmr::polymorphic_allocator<> allocator)
+                : keys(allocator)
+                , members(allocator)
+            {
+            }
+
+            std::pmr::vector<uint8_t> keys;
+            std::pmr::vector<ifc::DeclIndex> members;
+        };
+
+        struct ScopeMembers
+        {
+            Group by_sort;
+            Group scopes_by_kind; // Of the scope declarations
+        };
+
+        // Allocated from the resource of the file, like the grouped members.
+        struct LazyScopeMembers
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            explicit LazyScopeMembers(allocator_type allocator)
+                : members{ Group(allocator), Group(allocator) }
+            {
+            }
+
+            std::once_flag once;
+            std::atomic<bool> built = false; // Set once the members are grouped
+            ScopeMembers members;
+        };
+
+        ScopeMembers const& get_members(ifc::File const&, ifc::ScopeIndex) const;
+        static std::span<ifc::DeclIndex const> members_with_keys(Group const&, uint8_t first, uint8_t last);
+
+        mutable std::pmr::vector<LazyScopeMembers> scopes_;
+    };
+}
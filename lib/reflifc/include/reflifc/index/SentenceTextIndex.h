@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/common_types.h>
+
+#include <atomic>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Text of every sentence of a file, see Sentence::text. A sentence is rendered on its first lookup.
+    // Obtained via `ifc::File::get_index<SentenceTextIndex>()`.
+    class SentenceTextIndex
+    {
+    public:
+        explicit SentenceTextIndex(ifc::File const&);
+
+        static constexpr std::string_view Partitions[] = { "src.word", "src.sentence" };
+
+        // Empty for the null sentence.
+        std::string_view text(ifc::File const&, ifc::SentenceIndex) const;
+
+        // Of the sentences rendered so far.
+        size_t heap_bytes() const;
+
+    private:
+        // Allocated from the resource of the file, like the rendered text.
+        struct LazyText
+        {
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            explicit LazyText(allocator_type allocator)
+                : text(allocator)
+            {
+            }
+
+            std::once_flag once;
+            std::atomic<bool> built = false; // Set once the text is rendered
+            std::pmr::string text;
+        };
+
+        mutable std::pmr::vector<LazyText> sentences_;
+    };
+}
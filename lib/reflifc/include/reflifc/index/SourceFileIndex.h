@@ -0,0 +1,41 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace reflifc
+{
+    // Declarations of a file grouped by the source file they are declared in, e.g. the ones a header unit of
+    // <string> got from <xstring>, built in one pass over the declaration partitions, locating each declaration
+    // through the file's LineTable. Source files listed twice in `name.source-file` form one group.
+    // Obtained via `ifc::File::get_index<SourceFileIndex>()`.
+    class SourceFileIndex
+    {
+    public:
+        explicit SourceFileIndex(ifc::File const&);
+
+        // Declarations of the source file, as spelled in `name.source-file` (see Name::as_source_file), grouped
+        // by sort and in index order within a sort. The empty path has the declarations of unknown location.
+        // Only the sorts that LineTable::locate knows a location of are listed.
+        std::span<ifc::DeclIndex const> declarations(std::string_view path) const;
+
+        // Paths of the source files with declarations, the empty path first if some have no location.
+        std::span<std::string_view const> source_files() const { return paths_; }
+
+        size_t heap_bytes() const;
+
+    private:
+        // Paths point into the string table of the file.
+        std::pmr::vector<std::string_view> paths_;
+        std::pmr::unordered_map<std::string_view, uint32_t> groups_; // Position in paths_
+        std::pmr::vector<uint32_t> starts_; // Of each group in declarations_, and the end
+        std::pmr::vector<ifc::DeclIndex> declarations_;
+    };
+}
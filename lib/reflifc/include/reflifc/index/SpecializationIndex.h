@@ -0,0 +1,47 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace reflifc
+{
+    // Specializations (`decl.specialization` and `decl.partial-specialization`) of the templates used in a file,
+    // grouped by primary template, and by primary template and template arguments.
+    //
+    // Primary templates are keyed by TypeHashIndex::declaration_hash, so a primary may be given either as a local
+    // declaration or as a `decl.reference` to it, and arguments by TemplateArgumentIndex::hash, so `vector<int>`
+    // is found from the same hash in every file. Lookups by arguments return every specialization with an equal
+    // hash, compare them to tell collisions apart.
+    // Obtained via `ifc::File::get_index<SpecializationIndex>()`.
+    class SpecializationIndex
+    {
+    public:
+        explicit SpecializationIndex(ifc::File const&);
+
+        // In partition order, specializations first.
+        std::span<ifc::DeclIndex const> specializations(ifc::File const&, ifc::DeclIndex primary) const;
+
+        // See TemplateArgumentIndex::hash and TemplateArgumentIndex::combine for `arguments_hash`.
+        std::span<ifc::DeclIndex const> find(ifc::File const&, ifc::DeclIndex primary, uint64_t arguments_hash) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Range
+        {
+            uint32_t offset;
+            uint32_t count;
+        };
+
+        // The specializations of a key are the range of it in the matching vector.
+        std::vector<ifc::DeclIndex> primary_specializations_;
+        std::unordered_map<uint64_t, Range> primaries_;
+        std::vector<ifc::DeclIndex> argument_specializations_;
+        std::unordered_map<uint64_t, Range> arguments_;
+    };
+}
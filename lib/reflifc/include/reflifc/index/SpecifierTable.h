@@ -0,0 +1,56 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Properties of declarations kept as bit columns by SpecifierTable.
+    enum class DeclarationFlag : uint8_t
+    {
+        Exported,       // Has specifiers without BasicSpecifiers::NonExported
+        Public,         // Has an access that is Public, or None for non-members
+        Deprecated,     // BasicSpecifiers::Deprecated or a [[deprecated]] attribute
+        GlobalModule,   // BasicSpecifiers::IsMemberOfGlobalModule
+    };
+
+    constexpr size_t DeclarationFlagCount = 4;
+
+    // The specifiers and access of every declaration of a file, decoded once into one bit per declaration
+    // and flag, so that questions about the API surface of a module (exported, public, not deprecated...)
+    // are scans of 64 declarations per word instead of a load of each record. The bits of a sort are in
+    // partition order. Sorts without specifiers or access have no flags set.
+    // Obtained via `ifc::File::get_index<SpecifierTable>()`.
+    class SpecifierTable
+    {
+    public:
+        explicit SpecifierTable(ifc::File const&);
+
+        bool has(ifc::DeclIndex, DeclarationFlag) const;
+
+        // Bit i % 64 of word i / 64 is the flag of the i-th declaration of the sort.
+        std::span<uint64_t const> column(ifc::DeclSort, DeclarationFlag) const;
+
+        // Declarations with all the `required` flags and none of the `excluded` ones, by sort, in partition order.
+        // Without conditions, every declaration of the partitions.
+        std::vector<ifc::DeclIndex> select(std::initializer_list<DeclarationFlag> required,
+            std::initializer_list<DeclarationFlag> excluded = {}) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        // The columns of sort s are DeclarationFlagCount runs of word_count(s) words from starts_[s].
+        size_t word_count(size_t sort) const { return (counts_[sort] + 63) / 64; }
+
+        std::array<uint32_t, ifc::DeclIndex::SortCount> counts_{};
+        std::array<uint32_t, ifc::DeclIndex::SortCount> starts_{};
+        std::pmr::vector<uint64_t> words_;
+    };
+}
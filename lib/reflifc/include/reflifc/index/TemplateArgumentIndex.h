@@ -0,0 +1,60 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/ExpressionFwd.h>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace reflifc
+{
+    // Structural hashes and interned ids of the template argument lists of a file (the `arguments` of
+    // specialization forms and specialization names), each computed once.
+    //
+    // Argument lists with equal canonical ids are the same within the file. Hashes are also equal across files:
+    // type arguments hash by TypeHashIndex::hash, declarations by TypeHashIndex::declaration_hash and constants
+    // by value (see ConstantEvaluator). Other arguments, like value-dependent expressions, are identified
+    // by index, so lists containing them are only equal within a file.
+    // Obtained via `ifc::File::get_index<TemplateArgumentIndex>()`.
+    class TemplateArgumentIndex
+    {
+    public:
+        explicit TemplateArgumentIndex(ifc::File const&);
+
+        // `arguments` is a tuple, a single argument, or null for an empty list.
+        uint64_t hash(ifc::File const&, ifc::ExprIndex arguments) const;
+
+        // Dense, starting at 1.
+        uint32_t canonical_id(ifc::File const&, ifc::ExprIndex arguments) const;
+
+        // Hash of an argument list from the hashes of its arguments, as `hash` computes it:
+        // a type argument hashes as TypeHashIndex::hash of the type.
+        static uint64_t combine(std::span<uint64_t const> argument_hashes);
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Entry
+        {
+            uint64_t hash = 0;
+            uint32_t id = 0; // 0 until computed
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(std::vector<uint64_t> const&) const noexcept;
+        };
+
+        Entry entry(ifc::File const&, ifc::ExprIndex) const;
+        Entry entry_locked(ifc::File const&, ifc::ExprIndex) const;
+        Entry intern(std::vector<uint64_t> const& key, std::span<uint64_t const> hashes) const;
+
+        mutable std::mutex mutex_;
+        mutable std::array<std::vector<Entry>, ifc::ExprIndex::SortCount> entries_;
+        mutable std::unordered_map<std::vector<uint64_t>, uint32_t, KeyHash> ids_;
+    };
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "reflifc/Declaration.h"
+#include "reflifc/Expression.h"
+#include "reflifc/Type.h"
+#include "reflifc/decl/Specialization.h"
+
+#include <ifc/Declaration.h>
+#include <ifc/Environment.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace reflifc
+{
+    // Member types of class and alias template specializations, e.g. `value_type` of `vector<Foo>`: the arguments
+    // of a specialization form are bound to the parameters of the chart of its primary template, and the types of
+    // the members of the primary's definition are read under those bindings. A type parameter bound to a type
+    // argument stands for that type; aliases, of the template's members too, are followed on the way (see
+    // AliasResolution).
+    //
+    // Types built on parameters, like `T*`, are not in any file for most arguments. They are kept as the type of
+    // the definition along with the bindings (a BoundType), which `substitute` resolves again at every step down,
+    // e.g. at the pointee of `T*`.
+    //
+    // Each specialization is bound once per primary template and argument list, keyed by the canonical id of the
+    // list in the form's file (see TemplateArgumentIndex), and its member types are kept with it, so that
+    // analyses over many uses of the same specialization reuse them. Primary templates of other modules
+    // (`decl.reference`) are resolved through the environment, if any.
+    // Safe to use from multiple threads.
+    class TemplateSubstitution
+    {
+    public:
+        // Arguments of a specialization, by position (from 1) of the parameter of the primary's chart.
+        // Parameters of other levels, e.g. of an enclosing template, stay unbound.
+        class Bindings
+        {
+        public:
+            ifc::ParameterLevel level() const { return level_; }
+            std::span<Expression const> arguments() const { return arguments_; }
+
+            // Null if the parameter is not bound.
+            Expression const* argument(ifc::ParameterLevel, ifc::ParameterPosition) const;
+
+        private:
+            friend TemplateSubstitution;
+
+            ifc::ParameterLevel level_{};
+            std::vector<Expression> arguments_;
+        };
+
+        // A type of a template's definition read under bindings, or a plain type when `bindings` is null.
+        struct BoundType
+        {
+            Type type;
+            Bindings const* bindings = nullptr;
+        };
+
+        struct MemberType
+        {
+            Declaration member; // Alias or field of the primary's definition, or the alias template itself
+            BoundType type;     // Substituted at its top
+        };
+
+        explicit TemplateSubstitution(ifc::Environment* environment = nullptr);
+
+        TemplateSubstitution(TemplateSubstitution const&) = delete;
+        TemplateSubstitution& operator=(TemplateSubstitution const&) = delete;
+
+        // Aliases and fields of the class template's definition, in member order, or the aliasee of an alias
+        // template. Empty for other primaries, incomplete classes and primaries that cannot be resolved.
+        std::span<MemberType const> member_types(SpecializationForm) const;
+
+        // The type of the member of that name, if it is an alias or a field.
+        std::optional<BoundType> member_type(SpecializationForm, std::string_view name) const;
+
+        // Null if the primary is not a template with a chart.
+        Bindings const* bindings(SpecializationForm) const;
+
+        // The type that a bound type stands for, at its top: the argument of a bound type parameter, the
+        // aliasee of an alias, and so on. Types that are neither are returned as given, with their bindings.
+        BoundType substitute(BoundType) const;
+
+        // Bound specializations.
+        size_t size() const;
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Instantiation
+        {
+            bool bound = false;
+            Bindings bindings;
+            std::vector<MemberType> members;
+        };
+
+        struct Key
+        {
+            ifc::File const* file;
+            ifc::DeclIndex primary;
+            uint32_t arguments; // TemplateArgumentIndex::canonical_id
+
+            bool operator==(Key const&) const = default;
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(Key const&) const noexcept;
+        };
+
+        Instantiation const& instantiation(SpecializationForm) const;
+        void instantiate(SpecializationForm, Instantiation&) const;
+
+        ifc::Environment* environment_;
+
+        mutable std::shared_mutex mutex_;
+        mutable std::unordered_map<Key, std::unique_ptr<Instantiation>, KeyHash> instantiations_;
+    };
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "reflifc/Declaration.h"
+
+#include <ifc/Environment.h>
+
+#include <functional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace reflifc
+{
+    // Qualified names as seen by a translation unit: in the header units and modules of its config and the modules
+    // they re-export, transitively (see Environment::transitive_exports), and nowhere else. The visible modules
+    // are loaded together and fixed on construction. Each name is then resolved in every visible module with its
+    // QualifiedNameResolver, built on first use, skipping the modules whose strings lack the last component of the
+    // name (see File::may_contain_text), and the merged result is cached for the translation unit.
+    // Safe to use from multiple threads.
+    class TranslationUnitLookup
+    {
+    public:
+        // Throws std::out_of_range if a re-exported module is not in the environment's config.
+        TranslationUnitLookup(ifc::Environment&, ifc::Environment::Config const& translation_unit);
+
+        TranslationUnitLookup(TranslationUnitLookup const&) = delete;
+        TranslationUnitLookup& operator=(TranslationUnitLookup const&) = delete;
+
+        // Declarations named so in the visible modules, in the order of the modules, with declarations of
+        // other modules (`decl.reference`) resolved and without duplicates. Leading `::` is ignored.
+        std::span<Declaration const> resolve(std::string_view qualified_name) const;
+
+        // Header units and modules of the config, each followed by the modules it re-exports that come
+        // before in none of them.
+        std::span<ifc::File const* const> visible_modules() const { return visible_modules_; }
+        bool is_visible(ifc::File const&) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        std::vector<Declaration> resolve_uncached(std::string_view qualified_name) const;
+
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view s) const noexcept
+            {
+                return std::hash<std::string_view>{}(s);
+            }
+        };
+
+        ifc::Environment* environment_;
+        std::vector<ifc::File const*> visible_modules_;
+
+        mutable std::shared_mutex mutex_;
+        mutable std::unordered_map<std::string, std::vector<Declaration>, StringHash, std::equal_to<>> resolved_;
+    };
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/TypeFwd.h>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace reflifc
+{
+    // Structural hashes and canonical ids of the types of a file, each computed once, operands first.
+    //
+    // Types with equal canonical ids are the same type of the file. Hashes are also equal for the same type
+    // used in different files: declarations are hashed by the name of the module they belong to and their index
+    // in it, whether they are local or referenced through `decl.reference`. Operands that are not types
+    // (array extents, syntactic types, placeholder constraints, ...) are compared by index and hashed
+    // by index too, so types containing them are only equal within a file.
+    // Obtained via `ifc::File::get_index<TypeHashIndex>()`.
+    class TypeHashIndex
+    {
+    public:
+        explicit TypeHashIndex(ifc::File const&);
+
+        uint64_t hash(ifc::File const&, ifc::TypeIndex) const;
+
+        // Dense, starting at 1. The null type has id 0.
+        uint32_t canonical_id(ifc::File const&, ifc::TypeIndex) const;
+
+        // Hash of a declaration, by module name and index in it, equal for a declaration and references to it.
+        uint64_t declaration_hash(ifc::File const&, ifc::DeclIndex) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Entry
+        {
+            uint64_t hash = 0;
+            uint32_t id = 0; // 0 until computed
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(std::vector<uint64_t> const&) const noexcept;
+        };
+
+        Entry entry(ifc::File const&, ifc::TypeIndex) const;
+        Entry& slot(ifc::TypeIndex) const;
+        void compute(ifc::File const&, ifc::TypeIndex) const;
+
+        uint64_t module_hash_;
+
+        mutable std::mutex mutex_;
+        mutable std::array<std::vector<Entry>, ifc::TypeIndex::SortCount> entries_;
+        mutable std::unordered_map<std::vector<uint64_t>, uint32_t, KeyHash> ids_;
+    };
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/TypeFwd.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace ifc
+{
+    class Environment;
+}
+
+namespace reflifc
+{
+    struct TypeLayout
+    {
+        uint64_t size;
+        uint32_t alignment;
+
+        bool operator==(TypeLayout const&) const = default;
+    };
+
+    // Sizes, alignments and member offsets of the types of a file as laid out by MSVC for the architecture of
+    // the file (see ifc::FileHeader::arch): fundamental types, pointers and references, arrays with constant
+    // extents, enumerations, aliases and complete classes, structs and unions through their bases and fields,
+    // honoring `#pragma pack`, `alignas` and a pointer to the virtual table of polymorphic classes.
+    // Dependent types, functions, pointers to members and classes with virtual bases have no layout.
+    //
+    // Each type and class is laid out once, operands first, and memoized in a dense array per type sort, so
+    // laying out many types costs one computation per distinct type. Types of other modules are laid out
+    // through an Environment and memoized in the index of their own file; without one they have no layout,
+    // which is not memoized. Safe to use from multiple threads.
+    // Obtained via `ifc::File::get_index<TypeLayoutIndex>()`.
+    class TypeLayoutIndex
+    {
+    public:
+        struct Base
+        {
+            ifc::TypeIndex type;
+            uint64_t offset;
+        };
+
+        struct Member
+        {
+            ifc::DeclIndex decl; // `decl.field` or `decl.bitfield`
+            uint64_t offset;     // Of the storage unit of bitfields
+            uint32_t bit_offset; // Within the storage unit, 0 for fields
+        };
+
+        struct ClassLayout
+        {
+            TypeLayout layout;
+            bool has_vtable_pointer = false; // Laid out at offset 0, before the bases and fields
+            std::vector<Base> bases;
+            std::vector<Member> members; // In declaration order
+        };
+
+        explicit TypeLayoutIndex(ifc::File const&);
+
+        std::optional<TypeLayout> layout(ifc::File const&, ifc::TypeIndex, ifc::Environment* = nullptr) const;
+
+        // Of a class, struct or union, with the offsets of its bases and members. Only the size and alignment
+        // are memoized, the offsets are computed again from the memoized layouts of the bases and members.
+        std::optional<ClassLayout> class_layout(ifc::File const&, ifc::DeclIndex, ifc::Environment* = nullptr) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        // 0 until computed, see TypeLayoutIndex.cpp.
+        using Packed = std::atomic<uint64_t>;
+
+        struct ClassInfo
+        {
+            TypeLayout layout;
+            bool polymorphic;
+            bool empty;
+        };
+
+        // `memoizable` is cleared if the result depends on a type of another module laid out without an Environment.
+        std::optional<TypeLayout> lookup(ifc::File const&, ifc::TypeIndex, ifc::Environment*, bool& memoizable) const;
+        std::optional<TypeLayout> compute(ifc::File const&, ifc::TypeIndex, ifc::Environment*, bool& memoizable) const;
+        std::optional<TypeLayout> declaration_layout(ifc::File const&, ifc::DeclIndex, ifc::Environment*, bool& memoizable) const;
+        std::optional<ClassInfo> class_info(ifc::File const&, ifc::DeclIndex, ifc::Environment*, bool& memoizable) const;
+        std::optional<ClassLayout> lay_out_class(ifc::File const&, ifc::DeclIndex, ifc::Environment*, bool& memoizable, bool& polymorphic) const;
+
+        uint32_t pointer_size_;
+        // By type sort, empty for the sorts that are not memoized.
+        std::array<uint32_t, ifc::TypeIndex::SortCount> type_counts_{};
+        std::array<std::unique_ptr<Packed[]>, ifc::TypeIndex::SortCount> types_;
+        // By index of the scope declaration.
+        uint32_t class_count_ = 0;
+        std::unique_ptr<Packed[]> classes_;
+    };
+}
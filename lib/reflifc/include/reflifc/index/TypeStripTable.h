@@ -0,0 +1,54 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/TypeFwd.h>
+
+#include <array>
+#include <vector>
+
+namespace reflifc
+{
+    // Types of a file with their cv-qualifiers and references stripped, and decayed like function arguments
+    // passed by value, for every qualified, reference, array and function type, precomputed in one pass over
+    // their partitions so that each normalization is one array load.
+    // Types are never made up: arrays and functions decay to the pointer type of the file to their element
+    // or to them, and are only stripped if the file has no such pointer type.
+    // Obtained via `ifc::File::get_index<TypeStripTable>()`.
+    class TypeStripTable
+    {
+    public:
+        explicit TypeStripTable(ifc::File const&);
+
+        // Without its top-level cv-qualifiers and references, like std::remove_cvref_t.
+        ifc::TypeIndex strip_cvref(ifc::TypeIndex type) const
+        {
+            const auto entry = find(type);
+            return entry ? entry->stripped : type;
+        }
+
+        // Like std::decay_t, within the types of the file.
+        ifc::TypeIndex decay(ifc::TypeIndex type) const
+        {
+            const auto entry = find(type);
+            return entry ? entry->decayed : type;
+        }
+
+        size_t heap_bytes() const;
+
+    private:
+        struct Entry
+        {
+            ifc::TypeIndex stripped;
+            ifc::TypeIndex decayed;
+        };
+
+        Entry const* find(ifc::TypeIndex type) const
+        {
+            auto const & entries = entries_[static_cast<size_t>(type.sort())];
+            return type.index < entries.size() ? &entries[type.index] : nullptr;
+        }
+
+        // By type sort, empty for the sorts whose types are their own normalizations.
+        std::array<std::vector<Entry>, ifc::TypeIndex::SortCount> entries_;
+    };
+}
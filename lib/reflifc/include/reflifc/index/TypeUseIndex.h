@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/TypeFwd.h>
+
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace reflifc
+{
+    // Declarations of a file by the types they use, built in one pass over the declaration partitions:
+    // the types of variables, fields, bitfields and parameters, the aliasees of aliases, the return and
+    // parameter types of functions, methods and constructors, and the bases of classes. Uses are keyed by
+    // core type (see core_type), and function types are entered, so a function taking `Foo const&` or
+    // returning `Foo*` is a user of `Foo` as well as of its function type.
+    // Obtained via `ifc::File::get_index<TypeUseIndex>()`.
+    class TypeUseIndex
+    {
+    public:
+        explicit TypeUseIndex(ifc::File const&);
+
+        static constexpr std::string_view Partitions[] = { "decl.", "type.", "heap.type" };
+
+        // The type without cv-qualifiers, references and pointers, e.g. `Foo` for `Foo const* const&`.
+        static ifc::TypeIndex core_type(ifc::File const&, ifc::TypeIndex);
+
+        // Declarations using the core type of the type, sorted and distinct.
+        std::span<ifc::DeclIndex const> users(ifc::File const&, ifc::TypeIndex) const;
+
+        size_t heap_bytes() const;
+
+    private:
+        // Sorted, types_[i] is used by decls_[i].
+        std::pmr::vector<ifc::TypeIndex> types_;
+        std::pmr::vector<ifc::DeclIndex> decls_;
+    };
+}
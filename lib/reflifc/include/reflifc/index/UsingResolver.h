@@ -0,0 +1,49 @@
+#pragma once
+
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace reflifc
+{
+    // Declarations that the using-declarations (`using std::swap;`) and namespace aliases
+    // (`namespace fs = std::filesystem;`) of a file stand for. A using-declaration stands for every member
+    // named like its resolution in the scope of the resolution, so it names a whole overload set; a namespace
+    // alias stands for its namespace. Using-declarations and namespace aliases among the targets are followed
+    // in turn. Targets in other modules are the `decl.reference` naming them, as are namespaces of other
+    // modules, whose aliases are not followed without an Environment.
+    // Each declaration is resolved on the first lookup and memoized, reusing the targets of the declarations
+    // it goes through. Safe to use from multiple threads.
+    // Obtained via `ifc::File::get_index<UsingResolver>()`.
+    class UsingResolver
+    {
+    public:
+        explicit UsingResolver(ifc::File const&);
+
+        // In declaration order, without duplicates. Empty for other declarations.
+        std::span<ifc::DeclIndex const> targets(ifc::File const&, ifc::DeclIndex) const;
+
+        // Whether the declaration is a using-declaration or an alias of a namespace of the file.
+        static bool is_indirection(ifc::File const&, ifc::DeclIndex);
+
+        // Of the declarations resolved so far.
+        size_t heap_bytes() const;
+
+    private:
+        using Targets = std::vector<ifc::DeclIndex>;
+        using Slot = std::atomic<std::shared_ptr<Targets const>>;
+
+        Slot* slot(ifc::DeclIndex) const;
+        std::shared_ptr<Targets const> resolve(ifc::File const&, ifc::DeclIndex, std::vector<ifc::DeclIndex> & visiting) const;
+        Targets build(ifc::File const&, ifc::DeclIndex, std::vector<ifc::DeclIndex> & visiting) const;
+
+        // By index of the using-declaration and of the alias declaration, null until resolved.
+        mutable std::pmr::vector<Slot> usings_;
+        mutable std::pmr::vector<Slot> aliases_;
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <ifc/Environment.h>
+#include <ifc/FileFwd.h>
+#include <ifc/DeclarationFwd.h>
+#include <ifc/SymbolTable.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+namespace reflifc
+{
+    // Shape of the virtual table of each class of a file: the slots of its direct bases in order, each base's
+    // slots once, then the virtual methods it introduces in declaration order. Methods and destructors of the
+    // class that match a slot by name, parameter types and qualifiers override it. The table of a class is
+    // built on the first lookup from the tables of its bases, which are memoized in the indexes of their own
+    // files, so building the tables of a whole hierarchy visits each class once.
+    // Bases in other modules are resolved through an Environment and methods referred to by their ids in it,
+    // a table is built again only once a module it names was unloaded or for another Environment.
+    // Obtained via `ifc::File::get_index<VirtualTableIndex>()`.
+    class VirtualTableIndex
+    {
+    public:
+        struct Slot
+        {
+            // Method or destructor of the class that introduced the slot.
+            ifc::DeclarationId introducer;
+            // The final overrider in the class.
+            ifc::DeclarationId overrider;
+            // Of the method, see ifc::Environment::symbols. Unset for destructors.
+            std::optional<ifc::SymbolId> name;
+            // Structural hash of the parameter types and the qualifiers of the method, 0 for destructors.
+            uint64_t signature = 0;
+            bool pure = false;
+        };
+
+        struct Table
+        {
+            ifc::Environment const* environment;
+            // Of every method of the slots, for checking that the table is still valid.
+            std::vector<ifc::FileId> files;
+            // Empty for classes that are not polymorphic.
+            std::vector<Slot> slots;
+        };
+
+        explicit VirtualTableIndex(ifc::File const&);
+
+        // Null for declarations that are not classes or structs.
+        std::shared_ptr<Table const> find(ifc::File const&, ifc::DeclIndex, ifc::Environment&) const;
+
+        // Of the tables built so far.
+        size_t heap_bytes() const;
+
+    private:
+        std::shared_ptr<Table const> build(ifc::File const&, ifc::DeclIndex, ifc::Environment&) const;
+
+        // By index of the scope declaration, null until built.
+        mutable std::pmr::vector<std::atomic<std::shared_ptr<Table const>>> classes_;
+    };
+}
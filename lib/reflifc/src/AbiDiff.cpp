@@ -0,0 +1,255 @@
+#include "reflifc/AbiDiff.h"
+
+#include "reflifc/HashCombine.h"
+#include "reflifc/Layout.h"
+#include "reflifc/TypeRenderer.h"
+#include "reflifc/index/ConstantEvaluator.h"
+#include "reflifc/index/EnumerationTable.h"
+
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+
+#include <string_view>
+#include <unordered_map>
+
+namespace reflifc
+{
+    namespace
+    {
+        bool has_specifier(ifc::BasicSpecifiers specifiers, ifc::BasicSpecifiers specifier)
+        {
+            return (static_cast<uint8_t>(specifiers) & static_cast<uint8_t>(specifier)) != 0;
+        }
+
+        uint8_t linkage(ifc::BasicSpecifiers specifiers)
+        {
+            constexpr auto mask = static_cast<uint8_t>(ifc::BasicSpecifiers::C) | static_cast<uint8_t>(ifc::BasicSpecifiers::Internal)
+                | static_cast<uint8_t>(ifc::BasicSpecifiers::Vague) | static_cast<uint8_t>(ifc::BasicSpecifiers::External);
+            return static_cast<uint8_t>(specifiers) & mask;
+        }
+
+        class Fingerprinter
+        {
+        public:
+            Fingerprinter(ifc::File const& file, ifc::Environment* environment, Module module, AbiFingerprints& out)
+                : file_(file)
+                , renderer_(file, environment)
+                , layouts_(extract_layouts(module))
+                , out_(out)
+            {
+                if (file.has_partition(ifc::ScopeDeclaration::PartitionName))
+                    layout_of_scope_.assign(file.scope_declarations().size(), UINT32_MAX);
+                for (uint32_t i = 0; i != layouts_.size(); ++i)
+                    layout_of_scope_[layouts_.classes[i].index] = i;
+            }
+
+            void scope(ifc::ScopeIndex scope, uint64_t parent, bool exported_only)
+            {
+                if (ifc::is_null(scope))
+                    return;
+                for (auto const & member : ifc::get_declarations(file_, file_.scope_descriptors()[scope]))
+                    declaration(member.index, parent, exported_only);
+            }
+
+        private:
+            static uint64_t text_hash(std::string_view text)
+            {
+                return std::hash<std::string_view>{}(text);
+            }
+
+            uint64_t type_hash(ifc::TypeIndex type)
+            {
+                return text_hash(renderer_.spelling(type));
+            }
+
+            uint64_t name_hash(ifc::NameIndex name)
+            {
+                return text_hash(renderer_.spelling(name));
+            }
+
+            uint64_t name_hash(ifc::TextOffset name)
+            {
+                return text_hash(ifc::is_null(name) ? std::string_view() : file_.get_string_view(name));
+            }
+
+            // Parameter types of a function type, the whole type for other types (like `decltype(...)`).
+            uint64_t parameters_hash(ifc::TypeIndex type)
+            {
+                switch (type.sort())
+                {
+                case ifc::TypeSort::Function:
+                    return type_hash(file_.function_types()[type].source);
+                case ifc::TypeSort::Method:
+                    return hash_combine(type_hash(file_.method_types()[type].source), file_.method_types()[type].traits);
+                case ifc::TypeSort::Tor:
+                    return type_hash(file_.tor_types()[type].source);
+                default:
+                    return type_hash(type);
+                }
+            }
+
+            void add(ifc::DeclIndex decl, uint64_t key, uint64_t fingerprint)
+            {
+                if (const auto occurrence = occurrences_[key]++)
+                    key = hash_combine(key, occurrence);
+                out_.keys.push_back(key);
+                out_.fingerprints.push_back(fingerprint);
+                out_.decls.push_back(decl);
+            }
+
+            uint64_t class_fingerprint(ifc::DeclIndex decl, ifc::ScopeDeclaration const& scope)
+            {
+                auto fingerprint = hash_combine(0, get_kind(scope, file_), scope.access, scope.traits, scope.pack_size, type_hash(scope.base));
+                if (!scope.alignment.is_null())
+                {
+                    const auto alignment = file_.get_index<ConstantEvaluator>().evaluate(file_, scope.alignment);
+                    fingerprint = alignment ? hash_combine(fingerprint, *alignment) : hash_combine(fingerprint, text_hash("dependent"));
+                }
+
+                const auto layout = layout_of_scope_[decl.index];
+                if (layout == UINT32_MAX)
+                    return fingerprint;
+                for (auto member = layouts_.member_offsets[layout]; member != layouts_.member_offsets[layout + 1]; ++member)
+                    fingerprint = hash_combine(fingerprint, name_hash(layouts_.names[member]), type_hash(layouts_.types[member]),
+                        layouts_.access[member], layouts_.bit_widths[member]);
+                return fingerprint;
+            }
+
+            uint64_t enumeration_fingerprint(ifc::DeclIndex decl, ifc::Enumeration const& enumeration)
+            {
+                auto fingerprint = hash_combine(0, enumeration.access, type_hash(enumeration.base));
+                for (auto const & enumerator : file_.get_index<EnumerationTable>().enumerators(file_, decl))
+                {
+                    fingerprint = hash_combine(fingerprint, text_hash(enumerator.name));
+                    fingerprint = enumerator.value ? hash_combine(fingerprint, *enumerator.value) : hash_combine(fingerprint, text_hash("dependent"));
+                }
+                return fingerprint;
+            }
+
+            void declaration(ifc::DeclIndex decl, uint64_t parent, bool exported_only)
+            {
+                const auto sort = decl.sort();
+                auto key_of = [&](uint64_t name, auto... rest) { return hash_combine(parent, sort, name, rest...); };
+
+                switch (sort)
+                {
+                case ifc::DeclSort::Scope:
+                {
+                    auto const & scope = file_.scope_declarations()[decl];
+                    const auto key = key_of(name_hash(scope.name));
+                    if (get_kind(scope, file_) == ifc::TypeBasis::Namespace)
+                        return this->scope(scope.initializer, key, exported_only);
+                    if (exported_only && has_specifier(scope.specifiers, ifc::BasicSpecifiers::NonExported))
+                        return;
+                    add(decl, key, class_fingerprint(decl, scope));
+                    return this->scope(scope.initializer, key, false);
+                }
+                case ifc::DeclSort::Enumeration:
+                {
+                    auto const & enumeration = file_.enumerations()[decl];
+                    if (exported_only && has_specifier(enumeration.specifiers, ifc::BasicSpecifiers::NonExported))
+                        return;
+                    return add(decl, key_of(name_hash(enumeration.name)), enumeration_fingerprint(decl, enumeration));
+                }
+                case ifc::DeclSort::Alias:
+                {
+                    auto const & alias = file_.alias_declarations()[decl];
+                    if (exported_only && has_specifier(alias.specifiers, ifc::BasicSpecifiers::NonExported))
+                        return;
+                    return add(decl, key_of(name_hash(alias.name)), hash_combine(0, alias.access, type_hash(alias.aliasee)));
+                }
+                case ifc::DeclSort::Variable:
+                {
+                    auto const & variable = file_.variables()[decl];
+                    if (exported_only && has_specifier(variable.specifiers, ifc::BasicSpecifiers::NonExported))
+                        return;
+                    return add(decl, key_of(name_hash(variable.name)),
+                        hash_combine(0, variable.access, linkage(variable.specifiers), variable.traits, type_hash(variable.type)));
+                }
+                case ifc::DeclSort::Function:
+                case ifc::DeclSort::Method:
+                {
+                    ifc::FunctionDeclarationBase const & function = sort == ifc::DeclSort::Function
+                        ? static_cast<ifc::FunctionDeclarationBase const &>(file_.functions()[decl])
+                        : file_.methods()[decl];
+                    if (exported_only && has_specifier(function.specifiers, ifc::BasicSpecifiers::NonExported))
+                        return;
+                    return add(decl, key_of(name_hash(function.name), parameters_hash(function.type)),
+                        hash_combine(0, function.access, linkage(function.specifiers), function.traits, type_hash(function.type)));
+                }
+                case ifc::DeclSort::Constructor:
+                {
+                    auto const & constructor = file_.constructors()[decl];
+                    return add(decl, key_of(name_hash(constructor.name), parameters_hash(constructor.type)),
+                        hash_combine(0, constructor.access, linkage(constructor.specifiers), constructor.traits, type_hash(constructor.type)));
+                }
+                case ifc::DeclSort::Destructor:
+                {
+                    auto const & destructor = file_.destructors()[decl];
+                    return add(decl, key_of(name_hash(destructor.name)),
+                        hash_combine(0, destructor.access, linkage(destructor.specifiers), destructor.traits, destructor.eh_spec.sort, destructor.convention));
+                }
+                case ifc::DeclSort::Template:
+                {
+                    auto const & template_ = file_.template_declarations()[decl];
+                    if (exported_only && has_specifier(template_.specifiers, ifc::BasicSpecifiers::NonExported))
+                        return;
+                    return add(decl, key_of(name_hash(template_.name), template_.entity.decl.sort()),
+                        hash_combine(0, template_.access, type_hash(template_.type)));
+                }
+                default:
+                    return;
+                }
+            }
+
+            ifc::File const& file_;
+            TypeRenderer renderer_;
+            ClassLayouts layouts_;
+            std::vector<uint32_t> layout_of_scope_;
+            std::unordered_map<uint64_t, uint32_t> occurrences_;
+            AbiFingerprints& out_;
+        };
+    }
+
+    AbiFingerprints fingerprint_abi(Module module, ifc::Environment* environment)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        AbiFingerprints result;
+        Fingerprinter fingerprinter(file, environment, module, result);
+        fingerprinter.scope(file.header().global_scope, 0, true);
+        return result;
+    }
+
+    std::vector<AbiChange> diff_abi(AbiFingerprints const& before, AbiFingerprints const& after)
+    {
+        std::unordered_map<uint64_t, uint32_t> after_by_key;
+        after_by_key.reserve(after.size());
+        for (uint32_t i = 0; i != after.size(); ++i)
+            after_by_key.emplace(after.keys[i], i);
+
+        std::vector<AbiChange> changes;
+        std::vector<bool> matched(after.size());
+        for (uint32_t i = 0; i != before.size(); ++i)
+        {
+            const auto it = after_by_key.find(before.keys[i]);
+            if (it == after_by_key.end())
+            {
+                changes.push_back({ AbiChange::Kind::Removed, before.decls[i], {} });
+                continue;
+            }
+            matched[it->second] = true;
+            if (before.fingerprints[i] != after.fingerprints[it->second])
+                changes.push_back({ AbiChange::Kind::Changed, before.decls[i], after.decls[it->second] });
+        }
+        for (uint32_t i = 0; i != after.size(); ++i)
+            if (!matched[i])
+                changes.push_back({ AbiChange::Kind::Added, {}, after.decls[i] });
+        return changes;
+    }
+
+    std::vector<AbiChange> diff_abi(Module before, Module after, ifc::Environment* environment)
+    {
+        return diff_abi(fingerprint_abi(before, environment), fingerprint_abi(after, environment));
+    }
+}
@@ -1,4 +1,5 @@
 ﻿#include "reflifc/Attribute.h"
+#include "reflifc/Expression.h"
 #include "reflifc/Word.h"
 
 #include <ifc/Attribute.h>
@@ -6,6 +7,11 @@
 
 namespace reflifc
 {
+    ifc::AttrSort Attribute::sort() const
+    {
+        return index_.sort();
+    }
+
     bool Attribute::is_basic() const
     {
         return index_.sort() == ifc::AttrSort::Basic;
@@ -17,6 +23,28 @@ namespace reflifc
         return { ifc_, ifc_->basic_attributes()[index_].word };
     }
 
+    bool Attribute::is_scoped() const
+    {
+        return index_.sort() == ifc::AttrSort::Scoped;
+    }
+
+    AttributeScoped Attribute::as_scoped() const
+    {
+        assert(is_scoped());
+        return { ifc_, ifc_->scoped_attributes()[index_] };
+    }
+
+    bool Attribute::is_labeled() const
+    {
+        return index_.sort() == ifc::AttrSort::Labeled;
+    }
+
+    AttributeLabeled Attribute::as_labeled() const
+    {
+        assert(is_labeled());
+        return { ifc_, ifc_->labeled_attributes()[index_] };
+    }
+
     bool Attribute::is_called() const
     {
         return index_.sort() == ifc::AttrSort::Called;
@@ -28,6 +56,70 @@ namespace reflifc
         return { ifc_, ifc_->called_attributes()[index_] };
     }
 
+    bool Attribute::is_expanded() const
+    {
+        return index_.sort() == ifc::AttrSort::Expanded;
+    }
+
+    AttributeExpanded Attribute::as_expanded() const
+    {
+        assert(is_expanded());
+        return { ifc_, ifc_->expanded_attributes()[index_] };
+    }
+
+    bool Attribute::is_factored() const
+    {
+        return index_.sort() == ifc::AttrSort::Factored;
+    }
+
+    AttributeFactored Attribute::as_factored() const
+    {
+        assert(is_factored());
+        return { ifc_, ifc_->factored_attributes()[index_] };
+    }
+
+    bool Attribute::is_elaborated() const
+    {
+        return index_.sort() == ifc::AttrSort::Elaborated;
+    }
+
+    Expression Attribute::as_elaborated() const
+    {
+        assert(is_elaborated());
+        return { ifc_, ifc_->elaborated_attributes()[index_].expression };
+    }
+
+    bool Attribute::is_tuple() const
+    {
+        return index_.sort() == ifc::AttrSort::Tuple;
+    }
+
+    TupleAttributeView Attribute::as_tuple() const
+    {
+        assert(is_tuple());
+        return { ifc_, index_ };
+    }
+
+    Word AttributeScoped::scope() const
+    {
+        return { ifc_, attr_->scope };
+    }
+
+    Word AttributeScoped::member() const
+    {
+        return { ifc_, attr_->member };
+    }
+
+    Word AttributeLabeled::label() const
+    {
+        return { ifc_, attr_->label };
+    }
+
+    Attribute AttributeLabeled::attribute() const
+    {
+        return { ifc_, attr_->attribute };
+    }
+
     Attribute AttributeCalled::function() const
     {
         return { ifc_, attr_->function };
@@ -37,4 +129,24 @@ namespace reflifc
     {
         return { ifc_, attr_->arguments };
     }
+
+    TupleAttributeView AttributeCalled::argument_list() const
+    {
+        return { ifc_, attr_->arguments };
+    }
+
+    Attribute AttributeExpanded::operand() const
+    {
+        return { ifc_, attr_->operand };
+    }
+
+    Word AttributeFactored::factor() const
+    {
+        return { ifc_, attr_->factor };
+    }
+
+    TupleAttributeView AttributeFactored::terms() const
+    {
+        return { ifc_, attr_->terms };
+    }
 }
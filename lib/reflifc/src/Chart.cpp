@@ -23,4 +23,9 @@ namespace reflifc
     {
         return { ifc_, ifc_->unilevel_charts()[index_] };
     }
+
+    ChartMultilevel Chart::as_multilevel() const
+    {
+        return { ifc_, ifc_->multilevel_charts()[index_] };
+    }
 }
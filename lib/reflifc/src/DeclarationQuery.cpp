@@ -0,0 +1,365 @@
+#include "reflifc/DeclarationQuery.h"
+
+#include "reflifc/Query.h"
+#include "reflifc/Type.h"
+#include "reflifc/index/AttributeIndex.h"
+#include "reflifc/index/IdentifierIndex.h"
+#include "reflifc/index/ParentIndex.h"
+#include "reflifc/index/ScopeNameIndex.h"
+#include "reflifc/index/ScopeSortIndex.h"
+#include "reflifc/type/Function.h"
+#include "reflifc/type/Qualified.h"
+
+#include <ifc/File.h>
+
+#include <algorithm>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Declarations per task of the parallel scans.
+        constexpr uint32_t ScanChunkSize = 4096;
+
+        // The sorts with a partition of their own, scanned when no index applies.
+        constexpr ifc::DeclSort ScannedSorts[] = {
+            ifc::DeclSort::Enumerator, ifc::DeclSort::Variable, ifc::DeclSort::Parameter, ifc::DeclSort::Field,
+            ifc::DeclSort::Bitfield, ifc::DeclSort::Scope, ifc::DeclSort::Enumeration, ifc::DeclSort::Alias,
+            ifc::DeclSort::Template, ifc::DeclSort::PartialSpecialization, ifc::DeclSort::Specialization,
+            ifc::DeclSort::Concept, ifc::DeclSort::Function, ifc::DeclSort::Method, ifc::DeclSort::Constructor,
+            ifc::DeclSort::Destructor, ifc::DeclSort::UsingDeclaration, ifc::DeclSort::Intrinsic,
+        };
+
+        template<typename T>
+        uint32_t count(ifc::File const& file, ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const)
+        {
+            return file.has_partition(T::PartitionName) ? static_cast<uint32_t>((file.*partition)().size()) : 0;
+        }
+
+        uint32_t declaration_count(ifc::File const& file, ifc::DeclSort sort)
+        {
+            switch (sort)
+            {
+            case ifc::DeclSort::Enumerator:             return count(file, &ifc::File::enumerators);
+            case ifc::DeclSort::Variable:               return count(file, &ifc::File::variables);
+            case ifc::DeclSort::Parameter:              return count(file, &ifc::File::parameters);
+            case ifc::DeclSort::Field:                  return count(file, &ifc::File::fields);
+            case ifc::DeclSort::Bitfield:               return count(file, &ifc::File::bitfields);
+            case ifc::DeclSort::Scope:                  return count(file, &ifc::File::scope_declarations);
+            case ifc::DeclSort::Enumeration:            return count(file, &ifc::File::enumerations);
+            case ifc::DeclSort::Alias:                  return count(file, &ifc::File::alias_declarations);
+            case ifc::DeclSort::Template:               return count(file, &ifc::File::template_declarations);
+            case ifc::DeclSort::PartialSpecialization:  return count(file, &ifc::File::partial_specializations);
+            case ifc::DeclSort::Specialization:         return count(file, &ifc::File::specializations);
+            case ifc::DeclSort::Concept:                return count(file, &ifc::File::concepts);
+            case ifc::DeclSort::Function:               return count(file, &ifc::File::functions);
+            case ifc::DeclSort::Method:                 return count(file, &ifc::File::methods);
+            case ifc::DeclSort::Constructor:            return count(file, &ifc::File::constructors);
+            case ifc::DeclSort::Destructor:             return count(file, &ifc::File::destructors);
+            case ifc::DeclSort::UsingDeclaration:       return count(file, &ifc::File::using_declarations);
+            case ifc::DeclSort::Intrinsic:              return count(file, &ifc::File::intrinsic_declarations);
+            default:                                    return 0;
+            }
+        }
+
+        std::optional<ifc::Access> declaration_access(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            switch (decl.sort())
+            {
+            case ifc::DeclSort::Enumerator:             return file.enumerators()[decl].access;
+            case ifc::DeclSort::Variable:               return file.variables()[decl].access;
+            case ifc::DeclSort::Field:                  return file.fields()[decl].access;
+            case ifc::DeclSort::Bitfield:               return file.bitfields()[decl].access;
+            case ifc::DeclSort::Scope:                  return file.scope_declarations()[decl].access;
+            case ifc::DeclSort::Enumeration:            return file.enumerations()[decl].access;
+            case ifc::DeclSort::Alias:                  return file.alias_declarations()[decl].access;
+            case ifc::DeclSort::Template:               return file.template_declarations()[decl].access;
+            case ifc::DeclSort::PartialSpecialization:  return file.partial_specializations()[decl].access;
+            case ifc::DeclSort::Concept:                return file.concepts()[decl].access;
+            case ifc::DeclSort::Function:               return file.functions()[decl].access;
+            case ifc::DeclSort::Method:                 return file.methods()[decl].access;
+            case ifc::DeclSort::Constructor:            return file.constructors()[decl].access;
+            case ifc::DeclSort::Destructor:             return file.destructors()[decl].access;
+            case ifc::DeclSort::UsingDeclaration:       return file.using_declarations()[decl].access;
+            case ifc::DeclSort::Intrinsic:              return file.intrinsic_declarations()[decl].access;
+            default:                                    return std::nullopt;
+            }
+        }
+
+        Type return_type(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            Type type;
+            if (decl.sort() == ifc::DeclSort::Function)
+                type = Type(&file, file.functions()[decl].type);
+            else if (decl.sort() == ifc::DeclSort::Method)
+                type = Type(&file, file.methods()[decl].type);
+            else
+                return {};
+
+            if (type.is_function())
+                type = type.as_function().return_type();
+            else if (type.is_method())
+                type = type.as_method().return_type();
+            else
+                return {};
+
+            while (type && type.is_qualified())
+                type = type.as_qualified().unqualified();
+            return type;
+        }
+
+        // Scope whose members the declaration declares, null for declarations other than namespaces and classes (templates).
+        ifc::ScopeIndex members_scope(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            if (decl.sort() == ifc::DeclSort::Template)
+                decl = file.template_declarations()[decl].entity.decl;
+            if (decl.sort() != ifc::DeclSort::Scope)
+                return {};
+            return file.scope_declarations()[decl].initializer;
+        }
+    }
+
+    DeclarationQuery::DeclarationQuery(Module module)
+        : file_(module.global_namespace().containing_file())
+    {
+    }
+
+    DeclarationQuery& DeclarationQuery::in(Scope scope)
+    {
+        scope_ = scope.index();
+        scope_query_.reset();
+        return *this;
+    }
+
+    DeclarationQuery& DeclarationQuery::in(std::string_view qualified_name)
+    {
+        const auto decl = resolve(Module(file_), qualified_name);
+        const auto scope = decl ? members_scope(*file_, decl->index()) : ifc::ScopeIndex{};
+        if (ifc::is_null(scope))
+            empty_ = true;
+        scope_ = scope;
+        scope_query_.reset();
+        return *this;
+    }
+
+    DeclarationQuery& DeclarationQuery::members_of(DeclarationQuery const& scopes)
+    {
+        scope_.reset();
+        scope_query_ = std::make_shared<DeclarationQuery const>(scopes);
+        return *this;
+    }
+
+    DeclarationQuery& DeclarationQuery::sort(ifc::DeclSort sort)
+    {
+        sort_ = sort;
+        return *this;
+    }
+
+    DeclarationQuery& DeclarationQuery::kind(ifc::TypeBasis kind)
+    {
+        kind_ = kind;
+        return *this;
+    }
+
+    DeclarationQuery& DeclarationQuery::named(std::string_view identifier)
+    {
+        identifier_ = file_->find_text(identifier);
+        if (!identifier_)
+            empty_ = true;
+        return *this;
+    }
+
+    DeclarationQuery& DeclarationQuery::with_attribute(std::string_view name)
+    {
+        attribute_ = name;
+        return *this;
+    }
+
+    DeclarationQuery& DeclarationQuery::access(ifc::Access access)
+    {
+        access_ = access;
+        return *this;
+    }
+
+    DeclarationQuery& DeclarationQuery::returning(std::string_view qualified_name)
+    {
+        const auto decl = resolve(Module(file_), qualified_name);
+        if (!decl)
+            empty_ = true;
+        else
+            return_type_ = decl->index();
+        return *this;
+    }
+
+    DeclarationQuery& DeclarationQuery::where(std::function<bool(Declaration)> predicate)
+    {
+        predicates_.push_back(std::move(predicate));
+        return *this;
+    }
+
+    DeclarationQuery::Plan DeclarationQuery::plan() const
+    {
+        if (empty_ || (scope_query_ && scope_query_->plan() == Plan::Empty))
+            return Plan::Empty;
+        if (!attribute_.empty())
+            return Plan::AttributeIndex;
+        if (scope_ || scope_query_)
+        {
+            if (identifier_)
+                return Plan::ScopeNameIndex;
+            return sort_ || kind_ ? Plan::ScopeSortIndex : Plan::ScopeMembers;
+        }
+        if (identifier_)
+            return Plan::IdentifierIndex;
+        return sort_ || kind_ ? Plan::SortPartition : Plan::ParallelScan;
+    }
+
+    std::vector<ifc::ScopeIndex> DeclarationQuery::scopes(ifc::Executor& executor) const
+    {
+        if (scope_)
+            return { *scope_ };
+
+        std::vector<ifc::ScopeIndex> result;
+        for (auto decl : scope_query_->run(executor))
+        {
+            if (const auto scope = members_scope(*file_, decl.index()); !ifc::is_null(scope))
+                result.push_back(scope);
+        }
+        std::ranges::sort(result);
+        const auto duplicates = std::ranges::unique(result);
+        result.erase(duplicates.begin(), duplicates.end());
+        return result;
+    }
+
+    bool DeclarationQuery::matches(ifc::DeclIndex decl, std::vector<ifc::ScopeIndex> const* scopes) const
+    {
+        auto const & file = *file_;
+        if (sort_ && decl.sort() != *sort_)
+            return false;
+        if (kind_ && (decl.sort() != ifc::DeclSort::Scope || get_kind(file.scope_declarations()[decl], file) != *kind_))
+            return false;
+        if (identifier_)
+        {
+            const auto identifier = ifc::declaration_identifier(file, decl);
+            if (!identifier || file.get_string_view(*identifier) != file.get_string_view(*identifier_))
+                return false;
+        }
+        if (!attribute_.empty() && !std::ranges::binary_search(file.get_index<AttributeIndex>().find(file, attribute_), decl))
+            return false;
+        if (access_ && declaration_access(file, decl) != access_)
+            return false;
+        if (!return_type_.is_null())
+        {
+            const auto type = return_type(file, decl);
+            if (!type || !type.is_designated() || type.designation().index() != return_type_)
+                return false;
+        }
+        if (scopes)
+        {
+            const auto parent = file.get_index<ParentIndex>().parent(decl);
+            const auto scope = parent.is_null() ? file.header().global_scope : members_scope(file, parent);
+            if (!std::ranges::binary_search(*scopes, scope))
+                return false;
+        }
+        return std::ranges::all_of(predicates_, [&](auto const & predicate) { return predicate(Declaration(&file, decl)); });
+    }
+
+    DeclarationQuery::Candidates DeclarationQuery::scan(ifc::Executor& executor) const
+    {
+        struct Chunk
+        {
+            ifc::DeclSort sort;
+            uint32_t first;
+            uint32_t last;
+        };
+
+        std::vector<Chunk> chunks;
+        auto add_chunks = [&](ifc::DeclSort sort) {
+            const auto size = declaration_count(*file_, sort);
+            for (uint32_t first = 0; first < size; first += ScanChunkSize)
+                chunks.push_back({ sort, first, std::min(size, first + ScanChunkSize) });
+        };
+        if (sort_ || kind_)
+            add_chunks(kind_ ? ifc::DeclSort::Scope : *sort_);
+        else
+            std::ranges::for_each(ScannedSorts, add_chunks);
+
+        // Matches of each chunk, concatenated in partition order.
+        std::vector<Candidates> found(chunks.size());
+        executor.run(chunks.size(), [&](size_t i) {
+            const auto [sort, first, last] = chunks[i];
+            for (auto index = first; index != last; ++index)
+            {
+                const ifc::DeclIndex decl{ static_cast<uint32_t>(sort), index };
+                if (matches(decl, nullptr))
+                    found[i].push_back(decl);
+            }
+        });
+
+        Candidates result;
+        for (auto const & chunk : found)
+            result.insert(result.end(), chunk.begin(), chunk.end());
+        return result;
+    }
+
+    std::vector<Declaration> DeclarationQuery::run(ifc::Executor& executor) const
+    {
+        auto const & file = *file_;
+        const auto plan = this->plan();
+        if (plan == Plan::Empty)
+            return {};
+
+        std::vector<ifc::ScopeIndex> scopes;
+        if (scope_ || scope_query_)
+            scopes = this->scopes(executor);
+
+        Candidates decls;
+        // Candidates of the scope indexes are members of the scopes already.
+        auto const * check_scopes = scope_ || scope_query_ ? &scopes : nullptr;
+        auto add = [&](std::span<ifc::DeclIndex const> candidates, std::vector<ifc::ScopeIndex> const* in_scopes) {
+            for (auto decl : candidates)
+                if (matches(decl, in_scopes))
+                    decls.push_back(decl);
+        };
+        switch (plan)
+        {
+        case Plan::AttributeIndex:
+            add(file.get_index<AttributeIndex>().find(file, attribute_), check_scopes);
+            break;
+        case Plan::ScopeNameIndex:
+            for (auto scope : scopes)
+                add(file.get_index<ScopeNameIndex>().find(file, scope, *identifier_), nullptr);
+            break;
+        case Plan::ScopeSortIndex:
+            for (auto scope : scopes)
+            {
+                auto const & index = file.get_index<ScopeSortIndex>();
+                add(kind_ ? index.scope_members(file, scope, *kind_) : index.members(file, scope, *sort_), nullptr);
+            }
+            break;
+        case Plan::ScopeMembers:
+            for (auto scope : scopes)
+            {
+                for (auto member : ifc::get_declarations(file, file.scope_descriptors()[scope]))
+                    if (matches(member.index, nullptr))
+                        decls.push_back(member.index);
+            }
+            break;
+        case Plan::IdentifierIndex:
+            add(file.get_index<IdentifierIndex>().find(file, *identifier_), nullptr);
+            break;
+        case Plan::SortPartition:
+        case Plan::ParallelScan:
+            decls = scan(executor);
+            break;
+        case Plan::Empty:
+            break;
+        }
+
+        std::vector<Declaration> result;
+        result.reserve(decls.size());
+        for (auto decl : decls)
+            result.emplace_back(&file, decl);
+        return result;
+    }
+}
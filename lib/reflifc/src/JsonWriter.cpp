@@ -0,0 +1,463 @@
+#include "reflifc/JsonWriter.h"
+
+#include "reflifc/TypeRenderer.h"
+#include "reflifc/index/ConstantEvaluator.h"
+#include "reflifc/index/EnumerationTable.h"
+
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+
+#include <charconv>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+
+namespace reflifc
+{
+    namespace
+    {
+        bool needs_escaping(std::string_view text)
+        {
+            for (const unsigned char c : text)
+                if (c < 0x20 || c == '"' || c == '\\')
+                    return true;
+            return false;
+        }
+
+        void append_escaped(std::string_view text, std::string& out)
+        {
+            constexpr char hex[] = "0123456789abcdef";
+            for (const char c : text)
+            {
+                switch (c)
+                {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        out += "\\u00";
+                        out += hex[c >> 4];
+                        out += hex[c & 0xF];
+                    }
+                    else
+                    {
+                        out += c;
+                    }
+                }
+            }
+        }
+
+        void append_string(std::string_view text, std::string& out)
+        {
+            out += '"';
+            if (needs_escaping(text))
+                append_escaped(text, out);
+            else
+                out += text;
+            out += '"';
+        }
+
+        template<typename T>
+        void append_number(T value, std::string& out)
+        {
+            char buffer[32];
+            const auto end = std::to_chars(buffer, buffer + sizeof buffer, value).ptr;
+            out.append(buffer, end);
+        }
+
+        // Escaped forms of the interned strings of a file that need escaping, by text symbol,
+        // built once and then only read, from every chunk.
+        class EscapedStrings
+        {
+        public:
+            explicit EscapedStrings(ifc::File const& file)
+            {
+                for (uint32_t symbol = 0, count = file.text_symbol_count(); symbol != count; ++symbol)
+                {
+                    const auto text = file.get_string_view(file.symbol_text(symbol));
+                    if (!needs_escaping(text))
+                        continue;
+                    const auto begin = static_cast<uint32_t>(arena_.size());
+                    append_escaped(text, arena_);
+                    escaped_.emplace(symbol, std::pair(begin, static_cast<uint32_t>(arena_.size()) - begin));
+                }
+            }
+
+            void append(ifc::File const& file, ifc::TextOffset offset, std::string& out) const
+            {
+                out += '"';
+                if (escaped_.empty())
+                {
+                    out += file.get_string_view(offset);
+                }
+                else if (const auto symbol = file.text_symbol(offset); !symbol)
+                {
+                    append_escaped(file.get_string_view(offset), out);
+                }
+                else if (const auto it = escaped_.find(*symbol); it != escaped_.end())
+                {
+                    out.append(arena_, it->second.first, it->second.second);
+                }
+                else
+                {
+                    out += file.get_string_view(offset);
+                }
+                out += '"';
+            }
+
+        private:
+            std::string arena_;
+            std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> escaped_;
+        };
+
+        const char* access_name(ifc::Access access)
+        {
+            switch (access)
+            {
+            case ifc::Access::Private:   return "private";
+            case ifc::Access::Protected: return "protected";
+            case ifc::Access::Public:    return "public";
+            default:                     return nullptr;
+            }
+        }
+
+        const char* scope_kind(ifc::TypeBasis basis)
+        {
+            switch (basis)
+            {
+            case ifc::TypeBasis::Namespace: return "namespace";
+            case ifc::TypeBasis::Class:     return "class";
+            case ifc::TypeBasis::Struct:    return "struct";
+            case ifc::TypeBasis::Union:     return "union";
+            default:                        return "other";
+            }
+        }
+
+        bool is_namespace(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            return decl.sort() == ifc::DeclSort::Scope
+                && get_kind(file.scope_declarations()[decl], file) == ifc::TypeBasis::Namespace;
+        }
+
+        class Emitter
+        {
+        public:
+            Emitter(ifc::File const& file, ifc::Environment* environment, EscapedStrings const& strings, std::string& out)
+                : file_(file)
+                , renderer_(file, environment)
+                , strings_(strings)
+                , out_(out)
+            {
+            }
+
+            // The members of a scope, without the surrounding brackets.
+            void members(ifc::ScopeIndex scope)
+            {
+                if (ifc::is_null(scope))
+                    return;
+                bool first = true;
+                for (auto const & member : ifc::get_declarations(file_, file_.scope_descriptors()[scope]))
+                {
+                    if (!first)
+                        out_ += ',';
+                    first = false;
+                    declaration(member.index);
+                }
+            }
+
+            // `{"kind":"namespace",...,"members":[` - to be closed by `]}`.
+            void namespace_header(ifc::ScopeDeclaration const& scope)
+            {
+                out_ += "{\"kind\":\"namespace\"";
+                name(scope.name);
+                line(scope.locus);
+                out_ += ",\"members\":[";
+            }
+
+            void declaration(ifc::DeclIndex decl)
+            {
+                switch (decl.sort())
+                {
+                case ifc::DeclSort::Scope:
+                {
+                    auto const & scope = file_.scope_declarations()[decl];
+                    const auto kind = get_kind(scope, file_);
+                    if (kind == ifc::TypeBasis::Namespace)
+                    {
+                        namespace_header(scope);
+                        members(scope.initializer);
+                        out_ += "]}";
+                        return;
+                    }
+                    open(scope_kind(kind), scope.name, scope.locus, scope.access);
+                    type("base", scope.base);
+                    out_ += ",\"members\":[";
+                    members(scope.initializer);
+                    out_ += "]}";
+                    return;
+                }
+                case ifc::DeclSort::Enumeration:
+                {
+                    auto const & enumeration = file_.enumerations()[decl];
+                    open("enum", enumeration.name, enumeration.locus, enumeration.access);
+                    type("base", enumeration.base);
+                    out_ += ",\"enumerators\":[";
+                    bool first = true;
+                    for (auto const & enumerator : file_.get_index<EnumerationTable>().enumerators(file_, decl))
+                    {
+                        if (!first)
+                            out_ += ',';
+                        first = false;
+                        out_ += "{\"name\":";
+                        append_string(enumerator.name, out_);
+                        out_ += ",\"value\":";
+                        constant(enumerator.value);
+                        out_ += '}';
+                    }
+                    out_ += "]}";
+                    return;
+                }
+                case ifc::DeclSort::Function:
+                case ifc::DeclSort::Method:
+                {
+                    ifc::FunctionDeclarationBase const & function = decl.sort() == ifc::DeclSort::Function
+                        ? static_cast<ifc::FunctionDeclarationBase const &>(file_.functions()[decl])
+                        : file_.methods()[decl];
+                    open(decl.sort() == ifc::DeclSort::Function ? "function" : "method", function.name, function.locus, function.access);
+                    type("type", function.type);
+                    out_ += '}';
+                    return;
+                }
+                case ifc::DeclSort::Constructor:
+                {
+                    auto const & constructor = file_.constructors()[decl];
+                    open("constructor", constructor.name, constructor.locus, constructor.access);
+                    type("type", constructor.type);
+                    out_ += '}';
+                    return;
+                }
+                case ifc::DeclSort::Destructor:
+                {
+                    auto const & destructor = file_.destructors()[decl];
+                    open("destructor", destructor.name, destructor.locus, destructor.access);
+                    out_ += '}';
+                    return;
+                }
+                case ifc::DeclSort::Variable:
+                {
+                    auto const & variable = file_.variables()[decl];
+                    open("variable", variable.name, variable.locus, variable.access);
+                    type("type", variable.type);
+                    out_ += '}';
+                    return;
+                }
+                case ifc::DeclSort::Field:
+                {
+                    auto const & field = file_.fields()[decl];
+                    open("field", field.name, field.locus, field.access);
+                    type("type", field.type);
+                    out_ += '}';
+                    return;
+                }
+                case ifc::DeclSort::Bitfield:
+                {
+                    auto const & bitfield = file_.bitfields()[decl];
+                    open("bitfield", bitfield.name, bitfield.locus, bitfield.access);
+                    type("type", bitfield.type);
+                    out_ += ",\"width\":";
+                    constant(file_.get_index<ConstantEvaluator>().evaluate(file_, bitfield.width));
+                    out_ += '}';
+                    return;
+                }
+                case ifc::DeclSort::Alias:
+                {
+                    auto const & alias = file_.alias_declarations()[decl];
+                    open("alias", alias.name, alias.locus, alias.access);
+                    type("aliasee", alias.aliasee);
+                    out_ += '}';
+                    return;
+                }
+                case ifc::DeclSort::Template:
+                {
+                    auto const & template_ = file_.template_declarations()[decl];
+                    open("template", template_.name, template_.locus, template_.access);
+                    out_ += ",\"entity\":";
+                    declaration(template_.entity.decl);
+                    out_ += '}';
+                    return;
+                }
+                default:
+                    out_ += "{\"kind\":\"other\",\"sort\":";
+                    append_number(static_cast<uint32_t>(decl.sort()), out_);
+                    out_ += '}';
+                    return;
+                }
+            }
+
+        private:
+            template<typename Name>
+            void open(const char* kind, Name name, ifc::SourceLocation locus, ifc::Access access)
+            {
+                out_ += "{\"kind\":\"";
+                out_ += kind;
+                out_ += '"';
+                this->name(name);
+                line(locus);
+                if (const auto spelling = access_name(access))
+                {
+                    out_ += ",\"access\":\"";
+                    out_ += spelling;
+                    out_ += '"';
+                }
+            }
+
+            void name(ifc::TextOffset name)
+            {
+                if (ifc::is_null(name))
+                    return;
+                out_ += ",\"name\":";
+                strings_.append(file_, name, out_);
+            }
+
+            void name(ifc::NameIndex name)
+            {
+                if (name.is_null())
+                    return;
+                if (name.sort() == ifc::NameSort::Identifier)
+                    return this->name(ifc::TextOffset{ name.index });
+                out_ += ",\"name\":";
+                append_string(renderer_.spelling(name), out_);
+            }
+
+            void line(ifc::SourceLocation locus)
+            {
+                out_ += ",\"line\":";
+                append_number(static_cast<uint32_t>(locus.line), out_);
+            }
+
+            void type(const char* key, ifc::TypeIndex type)
+            {
+                if (type.is_null())
+                    return;
+                out_ += ",\"";
+                out_ += key;
+                out_ += "\":";
+                append_string(renderer_.spelling(type), out_);
+            }
+
+            void constant(std::optional<Constant> const& value)
+            {
+                if (!value)
+                    out_ += "null";
+                else
+                    std::visit([this](auto v) { append_number(v, out_); }, *value);
+            }
+
+            ifc::File const& file_;
+            TypeRenderer renderer_;
+            EscapedStrings const& strings_;
+            std::string& out_;
+        };
+
+        // Text between the declarations of a chunk (namespace headers, closing brackets and commas),
+        // or a declaration written by the chunk's task when `decl` is not null.
+        struct Piece
+        {
+            ifc::DeclIndex decl;
+            std::string text;
+        };
+
+        // Flattens namespaces, so that the members of a large namespace like `std` are spread over chunks
+        // rather than making a single one. Namespace headers are written by `emitter` into `scratch`.
+        void collect(ifc::File const& file, ifc::ScopeIndex scope, Emitter& emitter, std::string& scratch, std::vector<Piece>& pieces)
+        {
+            if (ifc::is_null(scope))
+                return;
+            bool first = true;
+            for (auto const & member : ifc::get_declarations(file, file.scope_descriptors()[scope]))
+            {
+                if (!first)
+                    pieces.push_back({ {}, "," });
+                first = false;
+                if (!is_namespace(file, member.index))
+                {
+                    pieces.push_back({ member.index, {} });
+                    continue;
+                }
+                auto const & namespace_ = file.scope_declarations()[member.index];
+                scratch.clear();
+                emitter.namespace_header(namespace_);
+                pieces.push_back({ {}, scratch });
+                collect(file, namespace_.initializer, emitter, scratch, pieces);
+                pieces.push_back({ {}, "]}" });
+            }
+        }
+
+        constexpr size_t DeclarationsPerChunk = 64;
+    }
+
+    void write_json(Module module, std::string& out, JsonOptions const& options)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        const EscapedStrings strings(file);
+
+        out += "{\"module\":";
+        const auto unit = file.header().unit;
+        if (unit.sort() == ifc::UnitSort::Source || unit.sort() == ifc::UnitSort::ExportedTU)
+            out += "null";
+        else
+            strings.append(file, ifc::TextOffset{ unit.index }, out);
+        out += ",\"declarations\":[";
+
+        const auto global_scope = file.header().global_scope;
+        if (!options.executor)
+        {
+            Emitter(file, options.environment, strings, out).members(global_scope);
+            out += "]}";
+            return;
+        }
+
+        std::vector<Piece> pieces;
+        {
+            std::string scratch;
+            Emitter emitter(file, options.environment, strings, scratch);
+            collect(file, global_scope, emitter, scratch, pieces);
+        }
+
+        // Chunk i is pieces [chunk_starts[i], chunk_starts[i + 1]).
+        std::vector<size_t> chunk_starts{ 0 };
+        size_t declarations = 0;
+        for (size_t i = 0; i != pieces.size(); ++i)
+            if (!pieces[i].decl.is_null() && declarations++ == DeclarationsPerChunk)
+            {
+                chunk_starts.push_back(i);
+                declarations = 1;
+            }
+        chunk_starts.push_back(pieces.size());
+
+        std::vector<std::string> chunks(chunk_starts.size() - 1);
+        options.executor->run(chunks.size(), [&](size_t chunk) {
+            Emitter emitter(file, options.environment, strings, chunks[chunk]);
+            for (auto i = chunk_starts[chunk]; i != chunk_starts[chunk + 1]; ++i)
+            {
+                if (pieces[i].decl.is_null())
+                    chunks[chunk] += pieces[i].text;
+                else
+                    emitter.declaration(pieces[i].decl);
+            }
+        });
+
+        size_t size = out.size();
+        for (auto const & chunk : chunks)
+            size += chunk.size();
+        out.reserve(size + 2);
+        for (auto const & chunk : chunks)
+            out += chunk;
+        out += "]}";
+    }
+}
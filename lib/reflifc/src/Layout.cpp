@@ -0,0 +1,156 @@
+#include "reflifc/Layout.h"
+
+#include "reflifc/index/ConstantEvaluator.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/File.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace reflifc
+{
+    namespace
+    {
+        constexpr uint32_t NoClass = UINT32_MAX;
+
+        struct Member
+        {
+            ifc::SourceLocation locus;
+            ifc::TextOffset name;
+            ifc::TypeIndex type;
+            ifc::Access access;
+            uint32_t bit_width;
+            ifc::DeclIndex decl;
+        };
+
+        bool is_complete_class(ifc::File const& file, ifc::ScopeDeclaration const& scope)
+        {
+            if (ifc::is_null(scope.initializer))
+                return false;
+            switch (get_kind(scope, file))
+            {
+            case ifc::TypeBasis::Class:
+            case ifc::TypeBasis::Struct:
+            case ifc::TypeBasis::Union:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        uint32_t bit_width(ifc::File const& file, ifc::ExprIndex width)
+        {
+            const auto value = file.get_index<ConstantEvaluator>().evaluate(file, width);
+            if (!value)
+                return ClassLayouts::DependentWidth;
+            return std::visit([](auto v) { return static_cast<uint32_t>(v); }, *value);
+        }
+    }
+
+    ClassLayouts extract_layouts(Module module)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        ClassLayouts result;
+        if (!file.has_partition(ifc::ScopeDeclaration::PartitionName))
+            return result;
+
+        const auto scopes = file.scope_declarations();
+        std::vector<uint32_t> class_of_scope(scopes.size(), NoClass);
+        uint32_t index = 0;
+        for (auto const & scope : scopes)
+        {
+            if (is_complete_class(file, scope))
+            {
+                class_of_scope[index] = static_cast<uint32_t>(result.classes.size());
+                result.classes.push_back({ .tag = static_cast<uint32_t>(ifc::DeclSort::Scope), .index = index });
+            }
+            ++index;
+        }
+
+        auto class_of = [&](ifc::DeclIndex home_scope) {
+            if (home_scope.sort() != ifc::DeclSort::Scope || home_scope.index >= class_of_scope.size())
+                return NoClass;
+            return class_of_scope[home_scope.index];
+        };
+
+        const auto fields = file.has_partition(ifc::FieldDeclaration::PartitionName)
+            ? file.fields() : ifc::Partition<ifc::FieldDeclaration, ifc::DeclIndex>(nullptr, 0);
+        const auto bitfields = file.has_partition(ifc::BitfieldDeclaration::PartitionName)
+            ? file.bitfields() : ifc::Partition<ifc::BitfieldDeclaration, ifc::DeclIndex>(nullptr, 0);
+
+        // Counting sort by class: count, then place every member at its class' cursor.
+        std::vector<uint32_t> cursors(result.classes.size() + 1, 0);
+        std::vector<bool> has_bitfields(result.classes.size());
+        for (auto const & field : fields)
+            if (const auto c = class_of(field.home_scope); c != NoClass)
+                ++cursors[c + 1];
+        for (auto const & bitfield : bitfields)
+            if (const auto c = class_of(bitfield.home_scope); c != NoClass)
+            {
+                ++cursors[c + 1];
+                has_bitfields[c] = true;
+            }
+        for (size_t c = 0; c != result.classes.size(); ++c)
+            cursors[c + 1] += cursors[c];
+        result.member_offsets = cursors;
+
+        std::vector<Member> members(cursors.back());
+        index = 0;
+        for (auto const & field : fields)
+        {
+            const ifc::DeclIndex decl{ .tag = static_cast<uint32_t>(ifc::DeclSort::Field), .index = index++ };
+            if (const auto c = class_of(field.home_scope); c != NoClass)
+                members[cursors[c]++] = { field.locus, field.name, field.type, field.access, ClassLayouts::NotBitfield, decl };
+        }
+        index = 0;
+        for (auto const & bitfield : bitfields)
+        {
+            const ifc::DeclIndex decl{ .tag = static_cast<uint32_t>(ifc::DeclSort::Bitfield), .index = index++ };
+            if (const auto c = class_of(bitfield.home_scope); c != NoClass)
+                members[cursors[c]++] = { bitfield.locus, bitfield.name, bitfield.type, bitfield.access, bit_width(file, bitfield.width), decl };
+        }
+
+        // Fields and bitfields come from different partitions, each in declaration order: merge them by location.
+        for (size_t c = 0; c != result.classes.size(); ++c)
+            if (has_bitfields[c])
+                std::ranges::stable_sort(members.begin() + result.member_offsets[c], members.begin() + result.member_offsets[c + 1], {},
+                    [](Member const & member) { return std::tuple(static_cast<uint32_t>(member.locus.line), static_cast<uint32_t>(member.locus.column)); });
+
+        result.names.reserve(members.size());
+        result.types.reserve(members.size());
+        result.access.reserve(members.size());
+        result.bit_widths.reserve(members.size());
+        result.members.reserve(members.size());
+        for (auto const & member : members)
+        {
+            result.names.push_back(member.name);
+            result.types.push_back(member.type);
+            result.access.push_back(member.access);
+            result.bit_widths.push_back(member.bit_width);
+            result.members.push_back(member.decl);
+        }
+        return result;
+    }
+
+    std::vector<ClassVirtualTable> extract_virtual_tables(Module module, ifc::Environment& environment, ifc::Executor& executor)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        if (!file.has_partition(ifc::ScopeDeclaration::PartitionName))
+            return {};
+
+        auto const & index = file.get_index<VirtualTableIndex>();
+        const auto count = file.scope_declarations().size();
+        std::vector<ClassVirtualTable> tables(count);
+        const auto cancellation = ifc::current_cancellation();
+        executor.run(count, [&](size_t i) {
+            const ifc::CancellationScope scope(cancellation);
+            const ifc::DeclIndex decl{ .tag = static_cast<uint32_t>(ifc::DeclSort::Scope), .index = static_cast<uint32_t>(i) };
+            tables[i] = { decl, index.find(file, decl, environment) };
+        });
+
+        std::erase_if(tables, [](ClassVirtualTable const& table) { return !table.table || table.table->slots.empty(); });
+        return tables;
+    }
+}
@@ -0,0 +1,170 @@
+#include "reflifc/Macro.h"
+
+#include "reflifc/index/MacroTable.h"
+
+#include <ifc/File.h>
+#include <ifc/Macro.h>
+
+#include <stdexcept>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Forms nest like the parentheses of a replacement list.
+        constexpr size_t MaxFormDepth = 256;
+
+        void decode_form(ifc::File const& file, ifc::FormIndex form, std::vector<FormToken>& out, size_t depth)
+        {
+            if (depth == MaxFormDepth)
+                throw std::runtime_error("preprocessing forms nested too deeply");
+
+            const auto spelled = [&](auto const & forms) {
+                out.push_back({ form.sort(), file.get_string_view(forms[form].spelling) });
+            };
+            const auto punctuation = [&](std::string_view spelling) {
+                out.push_back({ ifc::FormSort::Operator, spelling });
+            };
+
+            switch (form.sort())
+            {
+            case ifc::FormSort::Identifier: spelled(file.identifier_forms()); break;
+            case ifc::FormSort::Number:     spelled(file.number_forms()); break;
+            case ifc::FormSort::Character:  spelled(file.character_forms()); break;
+            case ifc::FormSort::String:     spelled(file.string_forms()); break;
+            case ifc::FormSort::Operator:   spelled(file.operator_forms()); break;
+            case ifc::FormSort::Keyword:    spelled(file.keyword_forms()); break;
+            case ifc::FormSort::Parameter:  spelled(file.parameter_forms()); break;
+            case ifc::FormSort::Header:     spelled(file.header_forms()); break;
+            case ifc::FormSort::Junk:       spelled(file.junk_forms()); break;
+            case ifc::FormSort::Whitespace:
+                out.push_back({ ifc::FormSort::Whitespace, " " });
+                break;
+            case ifc::FormSort::Stringize:
+                punctuation("#");
+                decode_form(file, file.stringize_forms()[form].operand, out, depth + 1);
+                break;
+            case ifc::FormSort::Catenate:
+            {
+                auto const & catenate = file.catenate_forms()[form];
+                decode_form(file, catenate.first, out, depth + 1);
+                punctuation("##");
+                decode_form(file, catenate.second, out, depth + 1);
+                break;
+            }
+            case ifc::FormSort::Pragma:
+                out.push_back({ ifc::FormSort::Identifier, "_Pragma" });
+                punctuation("(");
+                decode_form(file, file.pragma_forms()[form].operand, out, depth + 1);
+                punctuation(")");
+                break;
+            case ifc::FormSort::Parenthesized:
+                punctuation("(");
+                decode_form(file, file.parenthesized_forms()[form].operand, out, depth + 1);
+                punctuation(")");
+                break;
+            case ifc::FormSort::Tuple:
+            {
+                auto const & tuple = file.tuple_forms()[form];
+                for (auto element : file.form_heap().slice(tuple))
+                    decode_form(file, element, out, depth + 1);
+                break;
+            }
+            default:
+                throw std::runtime_error("unknown preprocessing form");
+            }
+        }
+    }
+
+    void decode_form(ifc::File const& file, ifc::FormIndex form, std::vector<FormToken>& buffer)
+    {
+        buffer.clear();
+        decode_form(file, form, buffer, 0);
+    }
+
+    void render_form(ifc::File const& file, ifc::FormIndex form, std::string& out)
+    {
+        std::vector<FormToken> tokens;
+        decode_form(file, form, tokens);
+        for (auto const & token : tokens)
+            out += token.spelling;
+    }
+
+    std::string_view Macro::name() const
+    {
+        if (is_function_like())
+            return ifc_->get_string_view(ifc_->function_like_macros()[index_].name);
+        return ifc_->get_string_view(ifc_->object_like_macros()[index_].name);
+    }
+
+    bool Macro::is_function_like() const
+    {
+        return index_.sort() == ifc::MacroSort::FunctionLike;
+    }
+
+    uint32_t Macro::arity() const
+    {
+        return is_function_like() ? ifc_->function_like_macros()[index_].arity : 0;
+    }
+
+    bool Macro::is_variadic() const
+    {
+        return is_function_like() && ifc_->function_like_macros()[index_].variadic;
+    }
+
+    void Macro::parameters(std::vector<FormToken>& buffer) const
+    {
+        buffer.clear();
+        if (is_function_like() && arity() != 0)
+            decode_form(*ifc_, ifc_->function_like_macros()[index_].parameters, buffer);
+    }
+
+    void Macro::body(std::vector<FormToken>& buffer) const
+    {
+        decode_form(*ifc_, body_form(), buffer);
+    }
+
+    ifc::FormIndex Macro::body_form() const
+    {
+        if (is_function_like())
+            return ifc_->function_like_macros()[index_].body;
+        return ifc_->object_like_macros()[index_].body;
+    }
+
+    void Macro::definition(std::string& out) const
+    {
+        out += name();
+        std::vector<FormToken> tokens;
+        if (is_function_like())
+        {
+            out += '(';
+            parameters(tokens);
+            bool first = true;
+            for (auto const & token : tokens)
+            {
+                if (token.sort != ifc::FormSort::Parameter)
+                    continue;
+                if (!first)
+                    out += ", ";
+                out += token.spelling;
+                first = false;
+            }
+            if (is_variadic())
+                out += first ? "..." : ", ...";
+            out += ')';
+        }
+
+        body(tokens);
+        if (!tokens.empty())
+            out += ' ';
+        for (auto const & token : tokens)
+            out += token.spelling;
+    }
+
+    std::optional<Macro> find_macro(ifc::File const& file, std::string_view name)
+    {
+        if (const auto macro = file.get_index<MacroTable>().find(name))
+            return Macro(&file, *macro);
+        return std::nullopt;
+    }
+}
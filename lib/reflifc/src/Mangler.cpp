@@ -0,0 +1,767 @@
+#include "reflifc/Mangler.h"
+
+#include <ifc/Environment.h>
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Name.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Markers of the encodings kept by the mangler, resolved (or dropped) by `resolve`.
+        constexpr char NameMarker = '\x01';     // Followed by a name fragment, up to and including its '@'
+        constexpr char Unsupported = '\x02';    // The decorated name cannot be built
+        constexpr char ParameterStart = '\x03'; // Around the encoding of each parameter type
+        constexpr char ParameterEnd = '\x04';
+
+        template<typename E>
+        bool has_flag(E value, E flag)
+        {
+            using Underlying = std::underlying_type_t<E>;
+            return (static_cast<Underlying>(value) & static_cast<Underlying>(flag)) != 0;
+        }
+
+        char cv_letter(ifc::Qualifiers qualifiers)
+        {
+            const bool is_const = has_flag(qualifiers, ifc::Qualifiers::Const);
+            const bool is_volatile = has_flag(qualifiers, ifc::Qualifiers::Volatile);
+            return is_const ? (is_volatile ? 'D' : 'B') : (is_volatile ? 'C' : 'A');
+        }
+
+        // Qualifiers of the type and the type without them.
+        std::pair<ifc::Qualifiers, ifc::TypeIndex> unqualified(ifc::File const& file, ifc::TypeIndex type)
+        {
+            auto qualifiers = ifc::Qualifiers::None;
+            while (type.sort() == ifc::TypeSort::Qualified)
+            {
+                const auto qualified = file.qualified_types()[type];
+                qualifiers = static_cast<ifc::Qualifiers>(static_cast<uint8_t>(qualifiers) | static_cast<uint8_t>(qualified.qualifiers));
+                type = qualified.unqualified;
+            }
+            return { qualifiers, type };
+        }
+
+        bool is_class(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            if (decl.is_null() || decl.sort() != ifc::DeclSort::Scope)
+                return false;
+            const auto type = file.scope_declarations()[decl].type;
+            if (type.sort() != ifc::TypeSort::Fundamental)
+                return false;
+            const auto basis = file.fundamental_types()[type].basis;
+            return basis == ifc::TypeBasis::Class || basis == ifc::TypeBasis::Struct || basis == ifc::TypeBasis::Union;
+        }
+
+        // Special names of operator functions, by their spelling.
+        std::string_view operator_code(std::string_view spelling)
+        {
+            static constexpr std::pair<std::string_view, std::string_view> codes[] = {
+                { "new", "?2" }, { "delete", "?3" }, { "=", "?4" }, { ">>", "?5" }, { "<<", "?6" }, { "!", "?7" },
+                { "==", "?8" }, { "!=", "?9" }, { "[]", "?A" }, { "->", "?C" }, { "*", "?D" }, { "++", "?E" },
+                { "--", "?F" }, { "-", "?G" }, { "+", "?H" }, { "&", "?I" }, { "->*", "?J" }, { "/", "?K" },
+                { "%", "?L" }, { "<", "?M" }, { "<=", "?N" }, { ">", "?O" }, { ">=", "?P" }, { ",", "?Q" },
+                { "()", "?R" }, { "~", "?S" }, { "^", "?T" }, { "|", "?U" }, { "&&", "?V" }, { "||", "?W" },
+                { "*=", "?X" }, { "+=", "?Y" }, { "-=", "?Z" }, { "/=", "?_0" }, { "%=", "?_1" }, { ">>=", "?_2" },
+                { "<<=", "?_3" }, { "&=", "?_4" }, { "|=", "?_5" }, { "^=", "?_6" }, { "new[]", "?_U" },
+                { "delete[]", "?_V" }, { "<=>", "?__M" },
+            };
+            for (auto [operator_spelling, code] : codes)
+            {
+                if (operator_spelling == spelling)
+                    return code;
+            }
+            return {};
+        }
+
+        // Index of the ParameterEnd closing the parameter starting at `start`.
+        size_t parameter_end(std::string_view encoded, size_t start)
+        {
+            size_t depth = 0;
+            for (size_t i = start; i != encoded.size(); ++i)
+            {
+                if (encoded[i] == ParameterStart)
+                    ++depth;
+                else if (encoded[i] == ParameterEnd && --depth == 0)
+                    return i;
+            }
+            throw std::logic_error("unbalanced parameter encoding");
+        }
+
+        // Digit of the back-reference to `part`, remembering it if there is room left.
+        template<size_t N>
+        int back_reference(std::array<std::string_view, N> & references, size_t & count, std::string_view part, bool remember)
+        {
+            for (size_t i = 0; i != count; ++i)
+            {
+                if (references[i] == part)
+                    return static_cast<int>(i);
+            }
+            if (remember && count != N)
+                references[count++] = part;
+            return -1;
+        }
+
+        constexpr ifc::DeclSort decorated_sorts[] = {
+            ifc::DeclSort::Function, ifc::DeclSort::Method, ifc::DeclSort::Constructor,
+            ifc::DeclSort::Destructor, ifc::DeclSort::Variable,
+        };
+
+        std::string_view partition_name(ifc::DeclSort sort)
+        {
+            switch (sort)
+            {
+            case ifc::DeclSort::Function:    return ifc::FunctionDeclaration::PartitionName;
+            case ifc::DeclSort::Method:      return ifc::MethodDeclaration::PartitionName;
+            case ifc::DeclSort::Constructor: return ifc::Constructor::PartitionName;
+            case ifc::DeclSort::Destructor:  return ifc::Destructor::PartitionName;
+            default:                         return ifc::VariableDeclaration::PartitionName;
+            }
+        }
+
+        size_t declaration_count(ifc::File const& file, ifc::DeclSort sort)
+        {
+            if (!file.has_partition(partition_name(sort)))
+                return 0;
+            switch (sort)
+            {
+            case ifc::DeclSort::Function:    return file.functions().size();
+            case ifc::DeclSort::Method:      return file.methods().size();
+            case ifc::DeclSort::Constructor: return file.constructors().size();
+            case ifc::DeclSort::Destructor:  return file.destructors().size();
+            default:                         return file.variables().size();
+            }
+        }
+    }
+
+    Mangler::Mangler(ifc::File const& file, ifc::Environment* environment)
+        : file_(file)
+        , environment_(environment)
+    {
+    }
+
+    std::string_view Mangler::decorated_name(ifc::DeclIndex decl)
+    {
+        return decorated_name(decl, names_);
+    }
+
+    std::string_view Mangler::decorated_name(ifc::DeclIndex decl, NameArena & out)
+    {
+        declaration_.clear();
+        if (!encode_declaration(decl, declaration_) || declaration_.find(Unsupported) != std::string::npos)
+            return {};
+
+        name_count_ = 0;
+        type_count_ = 0;
+        resolve(declaration_, out);
+        return out.finish();
+    }
+
+    std::string_view Mangler::encoding(ifc::File const& file, ifc::TypeIndex type)
+    {
+        auto* encodings = &file == &file_ ? &encodings_[static_cast<size_t>(type.sort())] : nullptr;
+        if (encodings && type.index < encodings->size() && (*encodings)[type.index].data() != nullptr)
+            return (*encodings)[type.index];
+
+        // Operands are encoded (and stored) first, by nested calls, each into a buffer of its own.
+        if (depth_ == buffers_.size())
+            buffers_.emplace_back();
+        auto & buffer = buffers_[depth_++];
+        buffer.clear();
+        try
+        {
+            encode(file, type, buffer);
+        }
+        catch (...)
+        {
+            --depth_;
+            throw;
+        }
+        --depth_;
+
+        // Types of other files are not kept by index, only those of the mangler's file are reused.
+        const auto result = arena_.store(buffer);
+        if (encodings)
+        {
+            if (type.index >= encodings->size())
+                encodings->resize(type.index + 1);
+            (*encodings)[type.index] = result;
+        }
+        return result;
+    }
+
+    void Mangler::encode(ifc::File const& file, ifc::TypeIndex type, std::string & out)
+    {
+        switch (type.sort())
+        {
+        case ifc::TypeSort::Fundamental:
+            encode_fundamental(file.fundamental_types()[type], out);
+            break;
+        case ifc::TypeSort::Designated:
+            encode_designated(file, file.designated_types()[type].decl, out);
+            break;
+        case ifc::TypeSort::Pointer:
+            encode_indirection(file, "P", file.pointer_types()[type].pointee, out);
+            break;
+        case ifc::TypeSort::LvalueReference:
+            encode_indirection(file, "A", file.lvalue_references()[type].referee, out);
+            break;
+        case ifc::TypeSort::RvalueReference:
+            encode_indirection(file, "$$Q", file.rvalue_references()[type].referee, out);
+            break;
+        case ifc::TypeSort::Function:
+        {
+            const auto function = file.function_types()[type];
+            encode_function(file, function.target, function.source, out);
+            break;
+        }
+        case ifc::TypeSort::Qualified:
+        {
+            // The qualifiers of a pointee are encoded by the indirection, except for those of pointers to pointers.
+            const auto [qualifiers, unqualified_type] = unqualified(file, type);
+            if (unqualified_type.sort() != ifc::TypeSort::Pointer)
+            {
+                out += encoding(file, unqualified_type);
+                break;
+            }
+            constexpr std::string_view pointers[] = { "P", "Q", "R", "S" };
+            encode_indirection(file, pointers[cv_letter(qualifiers) - 'A'], file.pointer_types()[unqualified_type].pointee, out);
+            break;
+        }
+        default:
+            out += Unsupported;
+        }
+    }
+
+    void Mangler::encode_fundamental(ifc::FundamentalType type, std::string & out)
+    {
+        const bool is_unsigned = type.sign == ifc::TypeSign::Unsigned;
+        switch (type.basis)
+        {
+        case ifc::TypeBasis::Void:
+            out += 'X';
+            return;
+        case ifc::TypeBasis::Bool:
+            out += "_N";
+            return;
+        case ifc::TypeBasis::Wchar_t:
+            out += "_W";
+            return;
+        case ifc::TypeBasis::Float:
+            out += 'M';
+            return;
+        case ifc::TypeBasis::Double:
+            out += type.precision == ifc::TypePrecision::Long ? 'O' : 'N';
+            return;
+        case ifc::TypeBasis::Nullptr:
+            out += "$$T";
+            return;
+        case ifc::TypeBasis::Char:
+            switch (type.precision)
+            {
+            case ifc::TypePrecision::Bit8:  out += "_Q"; return;
+            case ifc::TypePrecision::Bit16: out += "_S"; return;
+            case ifc::TypePrecision::Bit32: out += "_U"; return;
+            default:
+                out += type.sign == ifc::TypeSign::Plain ? 'D' : is_unsigned ? 'E' : 'C';
+                return;
+            }
+        case ifc::TypeBasis::Int:
+            switch (type.precision)
+            {
+            case ifc::TypePrecision::Default:
+            case ifc::TypePrecision::Bit32: out += is_unsigned ? 'I' : 'H'; return;
+            case ifc::TypePrecision::Short:
+            case ifc::TypePrecision::Bit16: out += is_unsigned ? 'G' : 'F'; return;
+            case ifc::TypePrecision::Long:  out += is_unsigned ? 'K' : 'J'; return;
+            case ifc::TypePrecision::Bit8:  out += is_unsigned ? 'E' : 'C'; return;
+            case ifc::TypePrecision::Bit64: out += is_unsigned ? "_K" : "_J"; return;
+            default:
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+        out += Unsupported;
+    }
+
+    void Mangler::encode_designated(ifc::File const& file, ifc::DeclIndex decl, std::string & out)
+    {
+        switch (decl.sort())
+        {
+        case ifc::DeclSort::Scope:
+        {
+            const auto type = file.scope_declarations()[decl].type;
+            const auto basis = type.sort() == ifc::TypeSort::Fundamental ? file.fundamental_types()[type].basis : ifc::TypeBasis::Void;
+            switch (basis)
+            {
+            case ifc::TypeBasis::Class:  out += 'V'; break;
+            case ifc::TypeBasis::Struct: out += 'U'; break;
+            case ifc::TypeBasis::Union:  out += 'T'; break;
+            default:
+                out += Unsupported;
+                return;
+            }
+            encode_scoped_name(file, decl, out);
+            out += '@';
+            break;
+        }
+        case ifc::DeclSort::Enumeration:
+            out += "W4";
+            encode_scoped_name(file, decl, out);
+            out += '@';
+            break;
+        case ifc::DeclSort::Alias:
+            out += encoding(file, file.alias_declarations()[decl].aliasee);
+            break;
+        case ifc::DeclSort::Reference:
+        {
+            if (!environment_)
+            {
+                out += Unsupported;
+                return;
+            }
+            ifc::Environment::ResolvedDeclaration resolved;
+            try
+            {
+                resolved = environment_->resolve_reference(file, decl);
+            }
+            catch (std::out_of_range const&)
+            {
+                // Its module is not in the environment.
+                out += Unsupported;
+                return;
+            }
+            encode_designated(*resolved.file, resolved.decl, out);
+            break;
+        }
+        default:
+            out += Unsupported;
+        }
+    }
+
+    void Mangler::encode_indirection(ifc::File const& file, std::string_view kind, ifc::TypeIndex pointee, std::string & out)
+    {
+        const auto [qualifiers, unqualified_pointee] = unqualified(file, pointee);
+        out += kind;
+        if (unqualified_pointee.sort() == ifc::TypeSort::Function)
+        {
+            // Pointers and references to functions, without a pointee qualifier.
+            out += '6';
+            out += encoding(file, unqualified_pointee);
+            return;
+        }
+        out += 'E';
+        out += cv_letter(qualifiers);
+        out += encoding(file, pointee);
+    }
+
+    void Mangler::encode_result(ifc::File const& file, ifc::TypeIndex type, std::string & out)
+    {
+        if (type.is_null())
+        {
+            out += '@';
+            return;
+        }
+
+        // Classes and enumerations are returned with their qualifiers, other types only with those of values.
+        const auto [qualifiers, unqualified_type] = unqualified(file, type);
+        const auto result = encoding(file, unqualified_type);
+        const bool is_tag = !result.empty() && std::string_view("TUVW").find(result.front()) != std::string_view::npos;
+        const bool is_indirection = unqualified_type.sort() == ifc::TypeSort::Pointer
+            || unqualified_type.sort() == ifc::TypeSort::LvalueReference
+            || unqualified_type.sort() == ifc::TypeSort::RvalueReference;
+        if (is_tag || (qualifiers != ifc::Qualifiers::None && !is_indirection))
+        {
+            out += '?';
+            out += cv_letter(qualifiers);
+        }
+        out += result;
+    }
+
+    void Mangler::encode_parameters(ifc::File const& file, ifc::TypeIndex source, std::string & out)
+    {
+        const auto encode_list = [&](auto const& parameters) {
+            // A trailing `...` ends the list with 'Z' instead of '@'.
+            size_t count = std::ranges::distance(parameters);
+            const auto last = count != 0 ? *std::ranges::next(std::ranges::begin(parameters), count - 1) : ifc::TypeIndex{};
+            const bool variadic = count != 0 && last.sort() == ifc::TypeSort::Fundamental
+                && file.fundamental_types()[last].basis == ifc::TypeBasis::Ellipsis;
+            if (variadic)
+                --count;
+
+            if (count == 0 && !variadic)
+            {
+                out += 'X';
+                return;
+            }
+            for (auto parameter : parameters | std::views::take(count))
+            {
+                out += ParameterStart;
+                encode_parameter(file, parameter, out);
+                out += ParameterEnd;
+            }
+            out += variadic ? 'Z' : '@';
+        };
+
+        if (source.sort() == ifc::TypeSort::Tuple)
+            encode_list(file.type_heap().slice(file.tuple_types()[source].seq));
+        else if (source.is_null())
+            out += 'X';
+        else
+            encode_list(std::span(&source, 1));
+    }
+
+    void Mangler::encode_parameter(ifc::File const& file, ifc::TypeIndex type, std::string & out)
+    {
+        // Top-level qualifiers are not part of the signature, arrays decay to constant pointers.
+        const auto unqualified_type = unqualified(file, type).second;
+        if (unqualified_type.sort() == ifc::TypeSort::Array)
+        {
+            encode_indirection(file, "Q", file.array_types()[unqualified_type].element, out);
+            return;
+        }
+        out += encoding(file, unqualified_type);
+    }
+
+    void Mangler::encode_function(ifc::File const& file, ifc::TypeIndex target, ifc::TypeIndex source, std::string & out)
+    {
+        // x64 has a single calling convention (`__cdecl`), and exception specifications are not encoded.
+        out += 'A';
+        encode_result(file, target, out);
+        encode_parameters(file, source, out);
+        out += 'Z';
+    }
+
+    void Mangler::encode_scoped_name(ifc::File const& file, ifc::DeclIndex decl, std::string & out)
+    {
+        // Innermost first, up to the global namespace.
+        while (!decl.is_null())
+        {
+            std::string_view name;
+            switch (decl.sort())
+            {
+            case ifc::DeclSort::Scope:
+            {
+                const auto scope = file.scope_declarations()[decl];
+                const auto type = scope.type;
+                const bool is_namespace = type.sort() == ifc::TypeSort::Fundamental
+                    && file.fundamental_types()[type].basis == ifc::TypeBasis::Namespace;
+                if ((!is_namespace && !is_class(file, decl)) || scope.name.is_null() || scope.name.sort() != ifc::NameSort::Identifier)
+                {
+                    out += Unsupported;
+                    return;
+                }
+                name = file.get_string_view(ifc::TextOffset{ scope.name.index });
+                decl = scope.home_scope;
+                break;
+            }
+            case ifc::DeclSort::Enumeration:
+            {
+                const auto enumeration = file.enumerations()[decl];
+                name = ifc::is_null(enumeration.name) ? std::string_view() : file.get_string_view(enumeration.name);
+                decl = enumeration.home_scope;
+                break;
+            }
+            default:
+                // Templates, functions (local classes) and so on.
+                out += Unsupported;
+                return;
+            }
+
+            if (name.empty())
+            {
+                out += Unsupported;
+                return;
+            }
+            out += NameMarker;
+            out += name;
+            out += '@';
+        }
+    }
+
+    bool Mangler::encode_member_kind(ifc::DeclIndex home_scope, ifc::Access access, bool is_static, bool is_virtual, std::string & out)
+    {
+        if (!is_class(file_, home_scope))
+            return false;
+
+        const int kind = is_static ? 2 : is_virtual ? 4 : 0;
+        switch (access)
+        {
+        case ifc::Access::Private:   out += static_cast<char>('A' + kind); break;
+        case ifc::Access::Protected: out += static_cast<char>('I' + kind); break;
+        default:                     out += static_cast<char>('Q' + kind); break;
+        }
+        return true;
+    }
+
+    bool Mangler::encode_declaration(ifc::DeclIndex decl, std::string & out)
+    {
+        const auto identifier = [&](ifc::NameIndex name) {
+            return file_.get_string_view(ifc::TextOffset{ name.index });
+        };
+        const auto encode_name = [&](ifc::NameIndex name) {
+            switch (name.is_null() ? ifc::NameSort::Template : name.sort())
+            {
+            case ifc::NameSort::Identifier:
+                out += NameMarker;
+                out += identifier(name);
+                out += '@';
+                break;
+            case ifc::NameSort::Operator:
+            {
+                const auto code = operator_code(file_.get_string_view(file_.operator_names()[name].encoded));
+                out += code.empty() ? std::string_view(&Unsupported, 1) : code;
+                break;
+            }
+            case ifc::NameSort::Conversion:
+                out += "?B";
+                break;
+            case ifc::NameSort::Literal:
+                out += "?__K";
+                out += NameMarker;
+                out += file_.get_string_view(file_.literal_names()[name].encoded);
+                out += '@';
+                break;
+            default:
+                out += Unsupported;
+            }
+        };
+        // `?name@scopes@@`
+        const auto encode_qualified_name = [&](auto const& encode_unqualified, ifc::DeclIndex home_scope) {
+            out += '?';
+            encode_unqualified();
+            encode_scoped_name(file_, home_scope, out);
+            out += '@';
+        };
+
+        switch (decl.sort())
+        {
+        case ifc::DeclSort::Function:
+        {
+            const auto function = file_.functions()[decl];
+            if (function.name.sort() == ifc::NameSort::Identifier && has_flag(function.specifiers, ifc::BasicSpecifiers::C))
+            {
+                out += identifier(function.name);
+                return true;
+            }
+            if (!function.chart.is_null() || has_flag(function.traits, ifc::FunctionTraits::HiddenFriend)
+                || function.type.sort() != ifc::TypeSort::Function)
+            {
+                out += Unsupported;
+                return true;
+            }
+
+            encode_qualified_name([&] { encode_name(function.name); }, function.home_scope);
+            // Static members, or functions of namespaces.
+            if (is_class(file_, function.home_scope))
+                encode_member_kind(function.home_scope, function.access, true, false, out);
+            else
+                out += 'Y';
+            const auto type = file_.function_types()[function.type];
+            const auto target = function.name.sort() == ifc::NameSort::Conversion ? file_.conversion_function_names()[function.name].target : type.target;
+            encode_function(file_, target, type.source, out);
+            return true;
+        }
+        case ifc::DeclSort::Method:
+        {
+            const auto method = file_.methods()[decl];
+            if (!method.chart.is_null() || method.type.sort() != ifc::TypeSort::Method)
+            {
+                out += Unsupported;
+                return true;
+            }
+
+            encode_qualified_name([&] { encode_name(method.name); }, method.home_scope);
+            if (!encode_member_kind(method.home_scope, method.access, false, has_flag(method.traits, ifc::FunctionTraits::Virtual), out))
+                out += Unsupported;
+            const auto type = file_.method_types()[method.type];
+            out += 'E';
+            if (has_trait(type.traits, ifc::FunctionTypeTraits::Lvalue))
+                out += 'G';
+            else if (has_trait(type.traits, ifc::FunctionTypeTraits::Rvalue))
+                out += 'H';
+            const bool is_const = has_trait(type.traits, ifc::FunctionTypeTraits::Const);
+            const bool is_volatile = has_trait(type.traits, ifc::FunctionTypeTraits::Volatile);
+            out += is_const ? (is_volatile ? 'D' : 'B') : (is_volatile ? 'C' : 'A');
+            encode_function(file_, type.target, type.source, out);
+            return true;
+        }
+        case ifc::DeclSort::Constructor:
+        {
+            const auto constructor = file_.constructors()[decl];
+            if (!constructor.chart.is_null() || constructor.type.sort() != ifc::TypeSort::Tor)
+            {
+                out += Unsupported;
+                return true;
+            }
+
+            encode_qualified_name([&] { out += "?0"; }, constructor.home_scope);
+            if (!encode_member_kind(constructor.home_scope, constructor.access, false, false, out))
+                out += Unsupported;
+            out += "EA";
+            encode_function(file_, {}, file_.tor_types()[constructor.type].source, out);
+            return true;
+        }
+        case ifc::DeclSort::Destructor:
+        {
+            const auto destructor = file_.destructors()[decl];
+            encode_qualified_name([&] { out += "?1"; }, destructor.home_scope);
+            if (!encode_member_kind(destructor.home_scope, destructor.access, false, has_flag(destructor.traits, ifc::FunctionTraits::Virtual), out))
+                out += Unsupported;
+            out += "EA";
+            encode_function(file_, {}, {}, out);
+            return true;
+        }
+        case ifc::DeclSort::Variable:
+        {
+            const auto variable = file_.variables()[decl];
+            if (variable.name.sort() != ifc::NameSort::Identifier)
+            {
+                out += Unsupported;
+                return true;
+            }
+            if (has_flag(variable.specifiers, ifc::BasicSpecifiers::C))
+            {
+                out += identifier(variable.name);
+                return true;
+            }
+
+            encode_qualified_name([&] { encode_name(variable.name); }, variable.home_scope);
+            // Static members by access, or variables of namespaces.
+            if (is_class(file_, variable.home_scope))
+            {
+                switch (variable.access)
+                {
+                case ifc::Access::Private:   out += '0'; break;
+                case ifc::Access::Protected: out += '1'; break;
+                default:                     out += '2'; break;
+                }
+            }
+            else
+            {
+                out += '3';
+            }
+
+            // The qualifiers of the variable come last, after the 'E' of pointers and references.
+            const auto [qualifiers, unqualified_type] = unqualified(file_, variable.type);
+            if (unqualified_type.sort() == ifc::TypeSort::Array)
+            {
+                out += Unsupported;
+                return true;
+            }
+            const auto type = encoding(file_, unqualified_type);
+            out += type;
+            if (type.starts_with('P') || type.starts_with('A') || type.starts_with("$$Q"))
+                out += 'E';
+            out += cv_letter(qualifiers);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    void Mangler::resolve(std::string_view encoded, NameArena & out)
+    {
+        for (size_t i = 0; i != encoded.size();)
+        {
+            const char c = encoded[i];
+            if (c == NameMarker)
+            {
+                const auto end = encoded.find('@', i + 1);
+                const auto fragment = encoded.substr(i + 1, end - i);
+                const auto reference = back_reference(name_references_, name_count_, fragment, true);
+                if (reference < 0)
+                    out.append(fragment);
+                else
+                    out.append(static_cast<char>('0' + reference));
+                i = end + 1;
+            }
+            else if (c == ParameterStart)
+            {
+                // Parameter types of more than one character are back-referenced, including those of parameters of
+                // function types, which come first.
+                const auto end = parameter_end(encoded, i);
+                const auto parameter = encoded.substr(i + 1, end - i - 1);
+                const auto reference = back_reference(type_references_, type_count_, parameter, false);
+                if (reference < 0)
+                {
+                    resolve(parameter, out);
+                    if (parameter.size() > 1)
+                        back_reference(type_references_, type_count_, parameter, true);
+                }
+                else
+                {
+                    out.append(static_cast<char>('0' + reference));
+                }
+                i = end + 1;
+            }
+            else
+            {
+                out.append(c);
+                ++i;
+            }
+        }
+    }
+
+    DecoratedNames decorate_module(Module module, ifc::Environment* environment, ifc::Executor& executor)
+    {
+        constexpr size_t chunk_size = 1024;
+
+        struct Chunk
+        {
+            ifc::DeclSort sort;
+            size_t first;
+            size_t last;
+            std::vector<ifc::DeclIndex> decls;
+            std::vector<std::string_view> names;
+            std::unique_ptr<NameArena> arena;
+        };
+
+        auto const & file = *module.global_namespace().containing_file();
+        std::vector<Chunk> chunks;
+        for (auto sort : decorated_sorts)
+        {
+            const auto count = declaration_count(file, sort);
+            for (size_t first = 0; first < count; first += chunk_size)
+                chunks.push_back({ .sort = sort, .first = first, .last = std::min(count, first + chunk_size) });
+        }
+
+        const auto cancellation = ifc::current_cancellation();
+        executor.run(chunks.size(), [&](size_t i) {
+            const ifc::CancellationScope scope(cancellation);
+            ifc::check_cancellation();
+            auto & chunk = chunks[i];
+            chunk.arena = std::make_unique<NameArena>();
+            Mangler mangler(file, environment);
+            for (size_t index = chunk.first; index != chunk.last; ++index)
+            {
+                const ifc::DeclIndex decl{ .tag = static_cast<uint32_t>(chunk.sort), .index = static_cast<uint32_t>(index) };
+                const auto name = mangler.decorated_name(decl, *chunk.arena);
+                if (name.empty())
+                    continue;
+                chunk.decls.push_back(decl);
+                chunk.names.push_back(name);
+            }
+        });
+
+        DecoratedNames result;
+        for (auto & chunk : chunks)
+        {
+            result.decls.insert(result.decls.end(), chunk.decls.begin(), chunk.decls.end());
+            result.names.insert(result.names.end(), chunk.names.begin(), chunk.names.end());
+            result.arenas.push_back(std::move(chunk.arena));
+        }
+        return result;
+    }
+}
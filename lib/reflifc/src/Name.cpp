@@ -18,6 +18,11 @@ namespace reflifc
         return ifc_->get_string(ifc::TextOffset{index_.index});
     }
 
+    std::string_view Name::as_identifier_view() const
+    {
+        return ifc_->get_string_view(ifc::TextOffset{index_.index});
+    }
+
     bool Name::is_operator() const
     {
         return sort() == ifc::NameSort::Operator;
@@ -117,4 +122,9 @@ namespace reflifc
     {
         return { ifc_, specialization_->arguments };
     }
+
+    ifc::ExprIndex SpecializationName::template_arguments_index() const
+    {
+        return specialization_->arguments;
+    }
 }
@@ -0,0 +1,63 @@
+#include "reflifc/NameArena.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace reflifc
+{
+    NameArena::NameArena(size_t block_size)
+        : block_size_(block_size)
+    {
+    }
+
+    NameArena& NameArena::append(std::string_view text)
+    {
+        // Always leaves room for the terminating null written by `finish`.
+        if (static_cast<size_t>(end_ - cursor_) <= text.size())
+            grow(text.size());
+        std::memcpy(cursor_, text.data(), text.size());
+        cursor_ += text.size();
+        return *this;
+    }
+
+    NameArena& NameArena::append(char c)
+    {
+        return append(std::string_view(&c, 1));
+    }
+
+    std::string_view NameArena::finish()
+    {
+        if (cursor_ == end_)
+            grow(0);
+        *cursor_ = '\0';
+        const std::string_view result(start_, static_cast<size_t>(cursor_ - start_));
+        start_ = ++cursor_;
+        return result;
+    }
+
+    std::string_view NameArena::store(std::string_view text)
+    {
+        return append(text).finish();
+    }
+
+    void NameArena::release()
+    {
+        blocks_.clear();
+        start_ = cursor_ = end_ = nullptr;
+    }
+
+    void NameArena::grow(size_t additional)
+    {
+        // The pending part of the name moves to the new block, finished names stay where they are.
+        const auto pending_size = static_cast<size_t>(cursor_ - start_);
+        const auto size = std::max(block_size_, 2 * (pending_size + additional + 1));
+        auto block = std::make_unique<char[]>(size);
+        if (pending_size != 0)
+            std::memcpy(block.get(), start_, pending_size);
+
+        start_ = block.get();
+        cursor_ = start_ + pending_size;
+        end_ = start_ + size;
+        blocks_.push_back(std::move(block));
+    }
+}
@@ -0,0 +1,192 @@
+#include "reflifc/Outline.h"
+#include "reflifc/index/ScopeSortIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+#include <initializer_list>
+
+namespace reflifc
+{
+    namespace
+    {
+        using ifc::DeclSort;
+        using ifc::TypeBasis;
+
+        // Sorts of every kind but Other, which has the rest of the sorts besides scopes.
+        constexpr DeclSort KindSorts[] = {
+            DeclSort::Enumeration, DeclSort::Template, DeclSort::Concept, DeclSort::Alias,
+            DeclSort::Function, DeclSort::Method, DeclSort::Constructor, DeclSort::Destructor,
+            DeclSort::Variable, DeclSort::Field, DeclSort::Bitfield, DeclSort::Enumerator,
+        };
+
+        bool is_other_sort(DeclSort sort)
+        {
+            return sort != DeclSort::Scope && std::ranges::find(KindSorts, sort) == std::end(KindSorts);
+        }
+
+        OutlineKind kind_of(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            switch (decl.sort())
+            {
+            case DeclSort::Scope:
+                switch (get_kind(file.scope_declarations()[decl], file))
+                {
+                case TypeBasis::Namespace:
+                    return OutlineKind::Namespace;
+                case TypeBasis::Class:
+                case TypeBasis::Struct:
+                case TypeBasis::Union:
+                    return OutlineKind::Class;
+                default:
+                    return OutlineKind::Other;
+                }
+            case DeclSort::Enumeration: return OutlineKind::Enumeration;
+            case DeclSort::Template:    return OutlineKind::Template;
+            case DeclSort::Concept:     return OutlineKind::Concept;
+            case DeclSort::Alias:       return OutlineKind::Alias;
+            case DeclSort::Function:
+            case DeclSort::Method:
+            case DeclSort::Constructor:
+            case DeclSort::Destructor:  return OutlineKind::Function;
+            case DeclSort::Variable:    return OutlineKind::Variable;
+            case DeclSort::Field:
+            case DeclSort::Bitfield:    return OutlineKind::Field;
+            case DeclSort::Enumerator:  return OutlineKind::Enumerator;
+            default:                    return OutlineKind::Other;
+            }
+        }
+
+        // Scope of the members of a namespace, a complete class or a class template, null otherwise.
+        ifc::ScopeIndex member_scope(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            if (decl.sort() == DeclSort::Template)
+                decl = file.template_declarations()[decl].entity.decl;
+            if (decl.sort() != DeclSort::Scope)
+                return {};
+            return file.scope_declarations()[decl].initializer;
+        }
+    }
+
+    Outline::Outline(Module module)
+        : ifc_(module.global_namespace().containing_file())
+    {
+        const auto global = ifc_->header().global_scope;
+        nodes_.push_back({ .decl = {}, .parent = Root, .scope = global,
+            .child_count = ifc::is_null(global) ? 0 : static_cast<uint32_t>(raw_count(ifc_->scope_descriptors()[global].cardinality)) });
+    }
+
+    Declaration Outline::declaration(NodeId node) const
+    {
+        return Declaration(ifc_, nodes_[node].decl);
+    }
+
+    OutlineKind Outline::kind(NodeId node) const
+    {
+        return node == Root ? OutlineKind::Namespace : kind_of(*ifc_, nodes_[node].decl);
+    }
+
+    std::string_view Outline::name(NodeId node) const
+    {
+        if (node == Root)
+            return {};
+        if (const auto identifier = ifc::declaration_identifier(*ifc_, nodes_[node].decl))
+            return ifc_->get_string_view(*identifier);
+        return "(unnamed)";
+    }
+
+    template<typename F>
+    void Outline::for_each_group(Node const& node, OutlineKind kind, F f) const
+    {
+        if (ifc::is_null(node.scope))
+            return;
+
+        auto const & index = ifc_->get_index<ScopeSortIndex>();
+        auto sorts = [&](std::initializer_list<DeclSort> sorts) {
+            for (auto sort : sorts)
+                f(index.members(*ifc_, node.scope, sort));
+        };
+        switch (kind)
+        {
+        case OutlineKind::Namespace:   f(index.scope_members(*ifc_, node.scope, TypeBasis::Namespace)); break;
+        case OutlineKind::Class:       f(index.scope_members(*ifc_, node.scope, TypeBasis::Class, TypeBasis::Union)); break;
+        case OutlineKind::Enumeration: sorts({ DeclSort::Enumeration }); break;
+        case OutlineKind::Template:    sorts({ DeclSort::Template }); break;
+        case OutlineKind::Concept:     sorts({ DeclSort::Concept }); break;
+        case OutlineKind::Alias:       sorts({ DeclSort::Alias }); break;
+        case OutlineKind::Function:    sorts({ DeclSort::Function, DeclSort::Method, DeclSort::Constructor, DeclSort::Destructor }); break;
+        case OutlineKind::Variable:    sorts({ DeclSort::Variable }); break;
+        case OutlineKind::Field:       sorts({ DeclSort::Field, DeclSort::Bitfield }); break;
+        case OutlineKind::Enumerator:  sorts({ DeclSort::Enumerator }); break;
+        case OutlineKind::Other:
+            // Scopes of other kinds (TypeBasis::Enum, Interface...), then the other sorts.
+            f(index.scope_members(*ifc_, node.scope, TypeBasis{}, TypeBasis::SegmentType));
+            f(index.scope_members(*ifc_, node.scope, TypeBasis::Enum, TypeBasis::Typename));
+            f(index.scope_members(*ifc_, node.scope, TypeBasis::Interface, static_cast<TypeBasis>(UINT8_MAX)));
+            for (uint32_t sort = 0; sort != ifc::DeclIndex::SortCount; ++sort)
+            {
+                if (is_other_sort(static_cast<DeclSort>(sort)))
+                    f(index.members(*ifc_, node.scope, static_cast<DeclSort>(sort)));
+            }
+            break;
+        case OutlineKind::Count:
+            break;
+        }
+    }
+
+    uint32_t Outline::child_count(NodeId node, OutlineKind kind) const
+    {
+        auto const & n = nodes_[node];
+        if (n.decl.sort() == DeclSort::Enumeration)
+            return kind == OutlineKind::Enumerator ? n.child_count : 0;
+
+        uint32_t count = 0;
+        for_each_group(n, kind, [&count](std::span<ifc::DeclIndex const> members) { count += static_cast<uint32_t>(members.size()); });
+        return count;
+    }
+
+    std::span<Outline::NodeId const> Outline::children(NodeId node)
+    {
+        if (!is_expanded(node))
+        {
+            std::vector<ifc::DeclIndex> members;
+            members.reserve(nodes_[node].child_count);
+            if (const auto decl = nodes_[node].decl; decl.sort() == DeclSort::Enumeration)
+            {
+                const auto enumerators = ifc_->enumerations()[decl].initializer;
+                for (uint32_t i = 0; i != raw_count(enumerators.cardinality); ++i)
+                    members.push_back({ .tag = static_cast<uint32_t>(DeclSort::Enumerator), .index = static_cast<uint32_t>(enumerators.start) + i });
+            }
+            else
+            {
+                for (size_t kind = 0; kind != static_cast<size_t>(OutlineKind::Count); ++kind)
+                    for_each_group(nodes_[node], static_cast<OutlineKind>(kind), [&members](std::span<ifc::DeclIndex const> group) {
+                        members.insert(members.end(), group.begin(), group.end());
+                    });
+            }
+
+            const auto first = static_cast<uint32_t>(children_.size());
+            for (auto member : members)
+                children_.push_back(add(member, node));
+            nodes_[node].first_child = first;
+            nodes_[node].child_count = static_cast<uint32_t>(members.size());
+        }
+        auto const & n = nodes_[node];
+        return std::span(children_).subspan(n.first_child, n.child_count);
+    }
+
+    Outline::NodeId Outline::add(ifc::DeclIndex decl, NodeId parent)
+    {
+        uint32_t child_count = 0;
+        const auto scope = member_scope(*ifc_, decl);
+        if (!ifc::is_null(scope))
+            child_count = static_cast<uint32_t>(raw_count(ifc_->scope_descriptors()[scope].cardinality));
+        else if (decl.sort() == DeclSort::Enumeration)
+            child_count = static_cast<uint32_t>(raw_count(ifc_->enumerations()[decl].initializer.cardinality));
+
+        nodes_.push_back({ .decl = decl, .parent = parent, .scope = scope, .child_count = child_count });
+        return static_cast<NodeId>(nodes_.size() - 1);
+    }
+}
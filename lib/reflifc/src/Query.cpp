@@ -0,0 +1,332 @@
+#include "reflifc/Query.h"
+
+#include "reflifc/Attribute.h"
+#include "reflifc/Word.h"
+#include "reflifc/index/AliasResolution.h"
+#include "reflifc/index/BaseLinearization.h"
+#include "reflifc/index/IdentifierIndex.h"
+#include "reflifc/index/ParentIndex.h"
+#include "reflifc/index/QualifiedNameResolver.h"
+#include "reflifc/index/ScopeNameIndex.h"
+#include "reflifc/index/TemplateArgumentIndex.h"
+#include "reflifc/index/TypeHashIndex.h"
+#include "reflifc/index/TypeStripTable.h"
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+
+namespace reflifc
+{
+    namespace
+    {
+        bool is_identifier(Attribute attribute, std::string_view identifier)
+        {
+            return attribute.is_basic() && attribute.as_basic().is_identifier() && attribute.as_basic().as_identifier() == identifier;
+        }
+
+        // Of `[[deprecated("message")]]`.
+        std::string_view deprecation_message(Declaration declaration)
+        {
+            for (auto attribute : declaration.attributes())
+            {
+                if (!attribute.is_called())
+                    continue;
+                const auto called = attribute.as_called();
+                if (is_identifier(called.function(), "deprecated") && called.arguments().is_basic() && called.arguments().as_basic().is_identifier())
+                    return called.arguments().as_basic().as_identifier();
+            }
+            return {};
+        }
+
+        bool same_arguments(ifc::File const* a_file, ifc::ExprIndex a, ifc::File const* b_file, ifc::ExprIndex b)
+        {
+            if (a_file != b_file)
+                return a_file->get_index<TemplateArgumentIndex>().hash(*a_file, a) == b_file->get_index<TemplateArgumentIndex>().hash(*b_file, b);
+
+            auto const & index = a_file->get_index<TemplateArgumentIndex>();
+            return index.canonical_id(*a_file, a) == index.canonical_id(*a_file, b);
+        }
+    }
+
+    size_t collect_declarations(Scope scope, std::span<Declaration> out)
+    {
+        auto const & file = *scope.containing_file();
+        const auto members = ifc::get_declarations(file, file.scope_descriptors()[scope.index()]);
+        const auto count = std::min(members.size(), out.size());
+        for (size_t i = 0; i != count; ++i)
+            out[i] = Declaration(&file, members.begin()[i].index);
+        return members.size();
+    }
+
+    size_t collect_types(TupleTypeView types, std::span<Type> out)
+    {
+        const auto count = std::min(types.size(), out.size());
+        std::ranges::copy(types | std::views::take(count), out.begin());
+        return types.size();
+    }
+
+    std::optional<Declaration> resolve(Module module, std::string_view qualified_name)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        const auto decl = file.get_index<QualifiedNameResolver>().resolve(file, qualified_name);
+        if (decl.is_null())
+            return std::nullopt;
+        return Declaration(&file, decl);
+    }
+
+    Location location(Declaration declaration)
+    {
+        auto const & file = *declaration.containing_file();
+        return file.get_index<LineTable>().locate(file, declaration.index());
+    }
+
+    std::vector<Declaration> find_declarations(Module module, std::string_view pattern, ifc::TextMatch match)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        std::vector<ifc::TextRange> ranges;
+        ifc::find_text_ranges(file, pattern, match, ranges);
+
+        std::vector<ifc::DeclIndex> decls;
+        if (!ranges.empty())
+            file.get_index<IdentifierIndex>().find(ranges, decls);
+
+        std::vector<Declaration> result;
+        result.reserve(decls.size());
+        for (auto decl : decls)
+            result.emplace_back(&file, decl);
+        return result;
+    }
+
+    std::string_view qualified_name(Declaration declaration, std::string & buffer)
+    {
+        auto const & file = *declaration.containing_file();
+        return file.get_index<ParentIndex>().qualified_name(file, declaration.index(), buffer);
+    }
+
+    std::string_view qualified_name(Declaration declaration, NameArena & arena)
+    {
+        auto const & file = *declaration.containing_file();
+        return file.get_index<ParentIndex>().qualified_name(file, declaration.index(), arena);
+    }
+
+    std::vector<Deprecation> get_deprecations(Module module, NameArena & arena)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        auto const & parents = file.get_index<ParentIndex>();
+        const auto traits = file.deprecation_traits();
+
+        std::vector<Deprecation> result;
+        result.reserve(traits.size());
+        std::unordered_set<ifc::DeclIndex> with_trait;
+        for (auto const & [decl, text] : traits)
+        {
+            result.push_back({ Declaration(&file, decl), parents.qualified_name(file, decl, arena), file.get_string_view(text) });
+            with_trait.insert(decl);
+        }
+
+        for (auto decl : file.get_index<AttributeIndex>().find(file, "deprecated"))
+        {
+            if (with_trait.contains(decl))
+                continue;
+            const Declaration declaration(&file, decl);
+            result.push_back({ declaration, parents.qualified_name(file, decl, arena), deprecation_message(declaration) });
+        }
+        return result;
+    }
+
+    std::vector<Declaration> lookup_member(ClassOrStruct class_or_struct, std::string_view name, ifc::Environment& environment)
+    {
+        auto const & file = *class_or_struct.containing_file();
+        const auto linearization = file.get_index<BaseLinearization>().find(file, class_or_struct.index(), environment);
+        if (!linearization)
+            return {};
+
+        std::vector<Declaration> result;
+        auto const & bases = linearization->bases;
+        for (size_t i = 0; i != bases.size();)
+        {
+            auto const * base_file = environment.file(bases[i].id.file);
+            const ClassOrStruct base(base_file, base_file->scope_declarations()[bases[i].id.decl]);
+            const auto found = result.size();
+            // Members brought in by using-declarations are found as the members they name.
+            const auto identifier = base_file->find_text(name);
+            if (base.is_complete() && identifier)
+            {
+                for (auto member : base_file->get_index<ScopeNameIndex>().find_resolved(*base_file, base.scope().index(), *identifier))
+                    result.emplace_back(base_file, member);
+            }
+            i = result.size() != found ? bases[i].end : i + 1;
+        }
+        return result;
+    }
+
+    Type resolve_underlying(Type type)
+    {
+        auto const & file = *type.containing_file();
+        return Type(&file, file.get_index<AliasResolution>().underlying(file, type.index()));
+    }
+
+    Type resolve_underlying(Type type, ifc::Environment& environment)
+    {
+        for (;;)
+        {
+            type = resolve_underlying(type);
+            auto const * file = type.containing_file();
+            if (type.sort() != ifc::TypeSort::Designated)
+                return type;
+            const auto decl = file->designated_types()[type.index()].decl;
+            if (decl.sort() != ifc::DeclSort::Reference)
+                return type;
+            const auto resolved = environment.resolve_all_references(*file)[decl.index];
+            if (resolved.file == nullptr || resolved.decl.sort() != ifc::DeclSort::Alias)
+                return type;
+            type = Type(resolved.file, resolved.file->alias_declarations()[resolved.decl].aliasee);
+        }
+    }
+
+    Type strip_cvref(Type type)
+    {
+        auto const & file = *type.containing_file();
+        return Type(&file, file.get_index<TypeStripTable>().strip_cvref(type.index()));
+    }
+
+    Type decay(Type type)
+    {
+        auto const & file = *type.containing_file();
+        return Type(&file, file.get_index<TypeStripTable>().decay(type.index()));
+    }
+
+    std::vector<Declaration> find_callables(Module module, std::span<Type const> arguments)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        auto const & uses = file.get_index<TypeUseIndex>();
+        auto const & strip = file.get_index<TypeStripTable>();
+        auto const & hashes = file.get_index<TypeHashIndex>();
+
+        std::vector<uint32_t> argument_ids;
+        std::vector<std::span<ifc::DeclIndex const>> users;
+        argument_ids.reserve(arguments.size());
+        users.reserve(arguments.size());
+        for (auto argument : arguments)
+        {
+            const auto decayed = strip.decay(argument.index());
+            argument_ids.push_back(hashes.canonical_id(file, decayed));
+            users.push_back(uses.users(file, decayed));
+        }
+        if (users.empty())
+            return {};
+        std::ranges::sort(users, {}, &std::span<ifc::DeclIndex const>::size);
+
+        std::vector<Declaration> result;
+        std::vector<ifc::TypeIndex> parameters;
+        for (auto decl : users.front())
+        {
+            ifc::TypeIndex source;
+            switch (decl.sort())
+            {
+            case ifc::DeclSort::Function:
+            {
+                const auto type = file.functions()[decl].type;
+                if (type.sort() != ifc::TypeSort::Function)
+                    continue;
+                source = file.function_types()[type].source;
+                break;
+            }
+            case ifc::DeclSort::Method:
+            {
+                const auto type = file.methods()[decl].type;
+                if (type.sort() != ifc::TypeSort::Method)
+                    continue;
+                source = file.method_types()[type].source;
+                break;
+            }
+            default:
+                continue;
+            }
+
+            const auto used_by_all = std::ranges::all_of(users | std::views::drop(1), [decl] (std::span<ifc::DeclIndex const> others) {
+                return std::ranges::binary_search(others, decl);
+            });
+            if (!used_by_all)
+                continue;
+
+            parameters.clear();
+            if (source.sort() == ifc::TypeSort::Tuple)
+                std::ranges::copy(file.type_heap().slice(file.tuple_types()[source].seq), std::back_inserter(parameters));
+            else if (!source.is_null())
+                parameters.push_back(source);
+            if (parameters.size() != argument_ids.size())
+                continue;
+
+            const auto accepts = std::ranges::equal(parameters, argument_ids, {}, [&] (ifc::TypeIndex parameter) {
+                return hashes.canonical_id(file, strip.decay(parameter));
+            });
+            if (accepts)
+                result.emplace_back(&file, decl);
+        }
+        return result;
+    }
+
+    std::optional<Constant> evaluate(Expression expression)
+    {
+        auto const & file = *expression.containing_file();
+        return file.get_index<ConstantEvaluator>().evaluate(file, expression.index());
+    }
+
+    NormalizedConstraint const& normalized_constraint(Expression constraint)
+    {
+        auto const & file = *constraint.containing_file();
+        return file.get_index<ConstraintIndex>().normalized(file, constraint.index());
+    }
+
+    std::span<FlatExpressionCache::Node const> flattened(Expression expression)
+    {
+        auto const & file = *expression.containing_file();
+        return file.get_index<FlatExpressionCache>().flatten(file, expression.index());
+    }
+
+    std::span<EnumerationTable::Entry const> enumerator_values(Enumeration enumeration)
+    {
+        auto const & file = *enumeration.containing_file();
+        return file.get_index<EnumerationTable>().enumerators(enumeration.enumerators_sequence());
+    }
+
+    uint64_t structural_hash(Type type)
+    {
+        auto const & file = *type.containing_file();
+        return file.get_index<TypeHashIndex>().hash(file, type.index());
+    }
+
+    bool same_type(Type a, Type b)
+    {
+        if (a.containing_file() != b.containing_file())
+            return structural_hash(a) == structural_hash(b);
+
+        auto const & file = *a.containing_file();
+        auto const & index = file.get_index<TypeHashIndex>();
+        return index.canonical_id(file, a.index()) == index.canonical_id(file, b.index());
+    }
+
+    uint64_t arguments_hash(SpecializationForm form)
+    {
+        auto const & file = *form.containing_file();
+        return file.get_index<TemplateArgumentIndex>().hash(file, form.arguments_index());
+    }
+
+    uint64_t arguments_hash(SpecializationName name)
+    {
+        auto const & file = *name.containing_file();
+        return file.get_index<TemplateArgumentIndex>().hash(file, name.template_arguments_index());
+    }
+
+    bool same_arguments(SpecializationForm a, SpecializationForm b)
+    {
+        return same_arguments(a.containing_file(), a.arguments_index(), b.containing_file(), b.arguments_index());
+    }
+
+    bool same_arguments(SpecializationName a, SpecializationName b)
+    {
+        return same_arguments(a.containing_file(), a.template_arguments_index(), b.containing_file(), b.template_arguments_index());
+    }
+}
@@ -0,0 +1,36 @@
+﻿#include "reflifc/Sentence.h"
+
+#include "reflifc/index/SentenceTextIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/Word.h>
+
+namespace reflifc
+{
+    void decode_word_sorts(std::span<ifc::Word const> words, std::vector<ifc::WordSort>& buffer)
+    {
+        buffer.resize(words.size());
+        auto * out = buffer.data();
+        for (size_t i = 0; i != words.size(); ++i)
+            out[i] = words[i].sort;
+    }
+
+    std::span<ifc::Word const> Sentence::words() const
+    {
+        if (ifc::is_null(index_))
+            return {};
+
+        auto const & sentence = ifc_->sentences()[static_cast<ifc::Index>(static_cast<uint32_t>(index_) - 1)];
+        return std::span(ifc_->words().data() + static_cast<size_t>(sentence.start), ifc::raw_count(sentence.cardinality));
+    }
+
+    void Sentence::sorts(std::vector<ifc::WordSort>& buffer) const
+    {
+        decode_word_sorts(words(), buffer);
+    }
+
+    std::string_view Sentence::text() const
+    {
+        return ifc_->get_index<SentenceTextIndex>().text(*ifc_, index_);
+    }
+}
@@ -0,0 +1,66 @@
+#include "reflifc/SideTable.h"
+
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Expression.h>
+#include <ifc/Type.h>
+
+#include <string_view>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Counts of the partitions of the records in the table of contents, by the sorts of the records.
+        template<typename Index, typename... Records>
+        std::array<uint32_t, Index::SortCount> cardinalities_of(ifc::File const& file)
+        {
+            struct Partition
+            {
+                std::string_view name;
+                typename Index::Sort sort;
+            };
+            static constexpr Partition partitions[] = { { Records::PartitionName, Records::Sort }... };
+
+            std::array<uint32_t, Index::SortCount> counts{};
+            for (auto const & summary : file.table_of_contents())
+            {
+                const auto name = file.get_string_view(summary.name);
+                for (auto const & partition : partitions)
+                {
+                    if (partition.name == name)
+                        counts[static_cast<size_t>(partition.sort)] = static_cast<uint32_t>(raw_count(summary.cardinality));
+                }
+            }
+            return counts;
+        }
+    }
+
+    std::array<uint32_t, ifc::DeclIndex::SortCount> sort_cardinalities(ifc::File const& file, ifc::DeclSort)
+    {
+        return cardinalities_of<ifc::DeclIndex,
+            ifc::UsingDeclaration, ifc::TemplateDeclaration, ifc::PartialSpecialization, ifc::Specialization, ifc::Enumeration,
+            ifc::Enumerator, ifc::AliasDeclaration, ifc::ScopeDeclaration, ifc::FunctionDeclaration, ifc::MethodDeclaration,
+            ifc::Constructor, ifc::Destructor, ifc::VariableDeclaration, ifc::FieldDeclaration, ifc::BitfieldDeclaration,
+            ifc::ParameterDeclaration, ifc::FriendDeclaration, ifc::Concept, ifc::IntrinsicDeclaration, ifc::DeclReference>(file);
+    }
+
+    std::array<uint32_t, ifc::TypeIndex::SortCount> sort_cardinalities(ifc::File const& file, ifc::TypeSort)
+    {
+        return cardinalities_of<ifc::TypeIndex,
+            ifc::FundamentalType, ifc::DesignatedType, ifc::SyntacticType, ifc::ExpansionType, ifc::PointerType,
+            ifc::FunctionType, ifc::MethodType, ifc::TorType, ifc::BaseType, ifc::TupleType, ifc::LvalueReference,
+            ifc::RvalueReference, ifc::ArrayType, ifc::QualifiedType, ifc::ForallType, ifc::SyntaxType,
+            ifc::PlaceholderType, ifc::TypenameType, ifc::DecltypeType>(file);
+    }
+
+    std::array<uint32_t, ifc::ExprIndex::SortCount> sort_cardinalities(ifc::File const& file, ifc::ExprSort)
+    {
+        return cardinalities_of<ifc::ExprIndex,
+            ifc::LiteralExpression, ifc::NamedDecl, ifc::UnqualifiedId, ifc::TemplateId, ifc::TemplateReference,
+            ifc::TupleExpression, ifc::ExpressionListExpression, ifc::TypeExpression, ifc::PackedTemplateArguments,
+            ifc::MonadExpression, ifc::DyadExpression, ifc::StringExpression, ifc::CallExpression, ifc::SizeofExpression,
+            ifc::AlignofExpression, ifc::RequiresExpression, ifc::QualifiedNameExpression, ifc::PathExpression,
+            ifc::ReadExpression, ifc::SyntaxTreeExpression, ifc::ProductValueTypeExpression, ifc::SubobjectValueExpression>(file);
+    }
+}
@@ -0,0 +1,142 @@
+#include "reflifc/Signatures.h"
+
+#include <ifc/Chart.h>
+#include <ifc/File.h>
+#include <ifc/Type.h>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Function and method types, or the subject of a function template's `type.forall`.
+        ifc::TypeIndex without_forall(ifc::File const& file, ifc::TypeIndex type)
+        {
+            while (type.sort() == ifc::TypeSort::Forall)
+                type = file.forall_types()[type].subject;
+            return type;
+        }
+
+        class Extractor
+        {
+        public:
+            Extractor(ifc::File const& file, FunctionSignatures& result)
+                : file_(file)
+                , result_(result)
+            {
+            }
+
+            template<typename T>
+            void add_all(ifc::Partition<T, ifc::DeclIndex> declarations)
+            {
+                result_.functions.reserve(result_.functions.size() + declarations.size());
+                uint32_t index = 0;
+                for (auto const & declaration : declarations)
+                    add({ .tag = static_cast<uint32_t>(T::Sort), .index = index++ }, declaration);
+            }
+
+        private:
+            void add(ifc::DeclIndex decl, ifc::FunctionDeclarationBase const& function)
+            {
+                ifc::TypeIndex target, source;
+                ifc::NoexceptSpecification eh_spec{};
+                auto convention = ifc::CallingConvention{};
+                const auto type = without_forall(file_, function.type);
+                if (type.sort() == ifc::TypeSort::Function)
+                {
+                    auto const & function_type = file_.function_types()[type];
+                    target = function_type.target;
+                    source = function_type.source;
+                    eh_spec = function_type.eh_spec;
+                    convention = function_type.convention;
+                }
+                else if (type.sort() == ifc::TypeSort::Method)
+                {
+                    auto const & method_type = file_.method_types()[type];
+                    target = method_type.target;
+                    source = method_type.source;
+                    eh_spec = method_type.eh_spec;
+                    convention = method_type.convention;
+                }
+                push(decl, function.name, target, source, eh_spec, convention, function.chart);
+            }
+
+            void add(ifc::DeclIndex decl, ifc::Constructor const& constructor)
+            {
+                ifc::TypeIndex source;
+                ifc::NoexceptSpecification eh_spec{};
+                auto convention = ifc::CallingConvention{};
+                if (const auto type = without_forall(file_, constructor.type); type.sort() == ifc::TypeSort::Tor)
+                {
+                    auto const & tor_type = file_.tor_types()[type];
+                    source = tor_type.source;
+                    eh_spec = tor_type.eh_spec;
+                    convention = tor_type.convention;
+                }
+                push(decl, identifier(constructor.name), {}, source, eh_spec, convention, constructor.chart);
+            }
+
+            void add(ifc::DeclIndex decl, ifc::Destructor const& destructor)
+            {
+                push(decl, identifier(destructor.name), {}, {}, destructor.eh_spec, destructor.convention, {});
+            }
+
+            static ifc::NameIndex identifier(ifc::TextOffset text)
+            {
+                return { .tag = static_cast<uint32_t>(ifc::NameSort::Identifier), .index = static_cast<uint32_t>(text) };
+            }
+
+            void push(ifc::DeclIndex decl, ifc::NameIndex name, ifc::TypeIndex target, ifc::TypeIndex source,
+                      ifc::NoexceptSpecification eh_spec, ifc::CallingConvention convention, ifc::ChartIndex chart)
+            {
+                result_.functions.push_back(decl);
+                result_.names.push_back(name);
+                result_.return_types.push_back(target);
+                result_.eh_specs.push_back(eh_spec);
+                result_.conventions.push_back(convention);
+                result_.default_arguments.push_back(default_arguments(chart));
+
+                if (source.sort() == ifc::TypeSort::Tuple)
+                {
+                    const auto elements = file_.type_heap().slice(file_.tuple_types()[source].seq);
+                    result_.parameter_types.insert(result_.parameter_types.end(), elements.begin(), elements.end());
+                }
+                else if (!source.is_null())
+                {
+                    result_.parameter_types.push_back(source);
+                }
+                result_.parameter_offsets.push_back(static_cast<uint32_t>(result_.parameter_types.size()));
+            }
+
+            // Default arguments are the initializers of the function parameters of the chart.
+            uint32_t default_arguments(ifc::ChartIndex chart) const
+            {
+                if (chart.sort() != ifc::ChartSort::Unilevel)
+                    return 0;
+
+                uint32_t count = 0;
+                for (auto const & parameter : file_.parameters().slice(file_.unilevel_charts()[chart]))
+                    count = parameter.initializer.is_null() ? 0 : count + 1;
+                return count;
+            }
+
+            ifc::File const& file_;
+            FunctionSignatures& result_;
+        };
+    }
+
+    FunctionSignatures extract_signatures(Module module)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        FunctionSignatures result;
+        Extractor extractor(file, result);
+        if (file.has_partition(ifc::FunctionDeclaration::PartitionName))
+            extractor.add_all(file.functions());
+        if (file.has_partition(ifc::MethodDeclaration::PartitionName))
+            extractor.add_all(file.methods());
+        if (file.has_partition(ifc::Constructor::PartitionName))
+            extractor.add_all(file.constructors());
+        if (file.has_partition(ifc::Destructor::PartitionName))
+            extractor.add_all(file.destructors());
+        return result;
+    }
+}
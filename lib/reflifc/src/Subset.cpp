@@ -0,0 +1,487 @@
+#include "reflifc/Subset.h"
+
+#include <ifc/Attribute.h>
+#include <ifc/Chart.h>
+#include <ifc/File.h>
+#include <ifc/FileWriter.h>
+#include <ifc/Declaration.h>
+#include <ifc/Expression.h>
+#include <ifc/Literal.h>
+#include <ifc/Name.h>
+#include <ifc/SyntaxTree.h>
+#include <ifc/Trait.h>
+#include <ifc/Type.h>
+#include <ifc/Word.h>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace reflifc
+{
+    namespace
+    {
+        constexpr uint32_t Dropped = UINT32_MAX;
+
+        // New index of each entry of a sort whose partition is renumbered, Dropped if it is not kept.
+        // Sorts without a renumbered partition have no entries, so references to them become null.
+        template<typename Index>
+        using Numbering = std::array<std::vector<uint32_t>, Index::SortCount>;
+
+        class SubsetWriter
+        {
+        public:
+            SubsetWriter(ifc::File const& file, Reachability const& reachability)
+                : file_(file)
+                , reachability_(reachability)
+                , writer_(file.header(), file.string_table())
+            {
+                // Numberings first, every handler below may fix references of any kind.
+                register_declarations();
+                register_types();
+                register_expressions();
+                register_syntax_trees();
+                register_others();
+            }
+
+            std::vector<std::byte> write()
+            {
+                // Partitions keep their order, those without a handler are left out.
+                for (auto const & summary : file_.table_of_contents())
+                {
+                    if (auto handler = handlers_.find(file_.get_string_view(summary.name)); handler != handlers_.end())
+                        handler->second(summary);
+                }
+                return writer_.write();
+            }
+
+        private:
+            using Handler = std::function<void(ifc::PartitionSummary const&)>;
+
+            // Records larger than T, of newer compilers, are read through their stride and written back as T.
+            template<typename T>
+            ifc::Partition<T> entries(ifc::PartitionSummary const& summary) const
+            {
+                const auto entry_size = static_cast<size_t>(summary.entry_size);
+                if (entry_size < sizeof(T))
+                    throw std::runtime_error("unexpected entry size of partition " + std::string(file_.get_string_view(summary.name)));
+                return { reinterpret_cast<T const*>(file_.get_data_pointer(summary)), raw_count(summary.cardinality), entry_size };
+            }
+
+            ifc::PartitionSummary const* find(std::string_view name) const
+            {
+                for (auto const & summary : file_.table_of_contents())
+                {
+                    if (file_.get_string_view(summary.name) == name)
+                        return &summary;
+                }
+                return nullptr;
+            }
+
+            std::vector<uint32_t>& numbering(ifc::DeclSort sort) { return declarations_[static_cast<size_t>(sort)]; }
+            std::vector<uint32_t>& numbering(ifc::TypeSort sort) { return types_[static_cast<size_t>(sort)]; }
+            std::vector<uint32_t>& numbering(ifc::ExprSort sort) { return expressions_[static_cast<size_t>(sort)]; }
+            std::vector<uint32_t>& numbering(ifc::SyntaxSort sort) { return syntax_trees_[static_cast<size_t>(sort)]; }
+
+            template<typename Index>
+            static void fix(Numbering<Index> const& numbering, Index& index)
+            {
+                if (index.is_null())
+                    return;
+                auto const & numbers = numbering[index.tag];
+                const uint32_t renumbered = index.index < numbers.size() ? numbers[index.index] : Dropped;
+                index = renumbered == Dropped ? Index{} : Index{ index.tag, renumbered };
+            }
+
+            void fix(ifc::DeclIndex& decl) const { fix(declarations_, decl); }
+            void fix(ifc::TypeIndex& type) const { fix(types_, type); }
+            void fix(ifc::ExprIndex& expr) const { fix(expressions_, expr); }
+            void fix(ifc::SyntaxIndex& syntax) const { fix(syntax_trees_, syntax); }
+
+            template<typename Index, size_t N>
+            void fix(Index (&indices)[N]) const
+            {
+                for (auto & index : indices)
+                    fix(index);
+            }
+
+            template<typename... Indices>
+                requires (sizeof...(Indices) > 1)
+            void fix(Indices&... indices) const
+            {
+                (fix(indices), ...);
+            }
+
+            // A sequence of declarations of the sort, emptied unless all of them are kept,
+            // in which case they are still contiguous.
+            void fix_sequence(ifc::Sequence& sequence, ifc::DeclSort sort) const
+            {
+                auto const & numbers = declarations_[static_cast<size_t>(sort)];
+                const auto start = static_cast<size_t>(sequence.start);
+                const auto count = raw_count(sequence.cardinality);
+                if (count == 0)
+                    return;
+                for (size_t i = start; i != start + count; ++i)
+                {
+                    if (i >= numbers.size() || numbers[i] == Dropped)
+                    {
+                        sequence = {};
+                        return;
+                    }
+                }
+                sequence.start = ifc::Index{ numbers[start] };
+            }
+
+            // The partition of T keeps its reachable entries, renumbered, with `adjust` fixing their references.
+            template<typename T, typename Index, typename Adjust>
+            void renumbered(Adjust adjust)
+            {
+                auto const * summary = find(T::PartitionName);
+                if (summary == nullptr)
+                    return;
+
+                auto & numbers = numbering(T::Sort);
+                numbers.assign(raw_count(summary->cardinality), Dropped);
+                uint32_t next = 0;
+                for (uint32_t i = 0; i != numbers.size(); ++i)
+                {
+                    if (reachability_.reachable(Index{ static_cast<uint32_t>(T::Sort), i }))
+                        numbers[i] = next++;
+                }
+
+                handlers_.emplace(T::PartitionName, [this, adjust, &numbers](ifc::PartitionSummary const& summary) {
+                    std::vector<T> kept;
+                    const auto all = entries<T>(summary);
+                    for (size_t i = 0; i != all.size(); ++i)
+                    {
+                        if (numbers[i] == Dropped)
+                            continue;
+                        kept.push_back(all[i]);
+                        adjust(kept.back());
+                    }
+                    writer_.add_partition(summary.name, std::span<T const>(kept));
+                });
+            }
+
+            template<typename T, typename Adjust>
+            void declarations(Adjust adjust) { renumbered<T, ifc::DeclIndex>(adjust); }
+
+            template<typename T, typename Adjust>
+            void types(Adjust adjust) { renumbered<T, ifc::TypeIndex>(adjust); }
+
+            // Every expression refers to its type.
+            template<typename T, typename Adjust>
+            void expressions(Adjust adjust)
+            {
+                renumbered<T, ifc::ExprIndex>([this, adjust](T& expression) {
+                    fix(expression.type);
+                    adjust(expression);
+                });
+            }
+
+            template<typename T, typename Adjust>
+            void syntax_trees(Adjust adjust) { renumbered<T, ifc::SyntaxIndex>(adjust); }
+
+            // The partition keeps all its entries, with `adjust` fixing their references.
+            template<typename T, typename Adjust>
+            void fixed(std::string_view name, Adjust adjust)
+            {
+                handlers_.emplace(name, [this, adjust](ifc::PartitionSummary const& summary) {
+                    const auto all = entries<T>(summary);
+                    std::vector<T> result(all.begin(), all.end());
+                    for (auto & entry : result)
+                        adjust(entry);
+                    writer_.add_partition(summary.name, std::span<T const>(result));
+                });
+            }
+
+            template<typename T, typename Adjust>
+            void fixed(Adjust adjust)
+            {
+                fixed<T>(T::PartitionName, adjust);
+            }
+
+            template<typename T>
+            void fixed_heap(std::string_view name)
+            {
+                fixed<T>(name, [this](T& element) { fix(element); });
+            }
+
+            // The partition is copied as is, it refers to nothing that is renumbered.
+            void verbatim(std::string_view name)
+            {
+                handlers_.emplace(name, [this](ifc::PartitionSummary const& summary) {
+                    const std::span bytes(file_.get_data_pointer(summary), summary.size_bytes());
+                    writer_.add_partition(summary.name, bytes, static_cast<size_t>(summary.entry_size));
+                });
+            }
+
+            // Traits of the kept declarations, in their order.
+            template<typename T, typename Adjust>
+            void traits(std::string_view name, Adjust adjust)
+            {
+                handlers_.emplace(name, [this, adjust](ifc::PartitionSummary const& summary) {
+                    std::vector<ifc::AssociatedTrait<T>> kept;
+                    for (auto trait : entries<ifc::AssociatedTrait<T>>(summary))
+                    {
+                        fix(trait.decl);
+                        if (trait.decl.is_null())
+                            continue;
+                        adjust(trait.trait);
+                        kept.push_back(trait);
+                    }
+                    writer_.add_partition(summary.name, std::span<ifc::AssociatedTrait<T> const>(kept));
+                });
+            }
+
+            void register_declarations();
+            void register_types();
+            void register_expressions();
+            void register_syntax_trees();
+            void register_others();
+            void register_scopes();
+
+            // Appends the kept declarations of the sequence of `scope.member` to `members_`.
+            ifc::Sequence keep_members(ifc::Partition<ifc::Declaration> members, ifc::Sequence);
+
+            ifc::File const& file_;
+            Reachability const& reachability_;
+            ifc::FileWriter writer_;
+            std::unordered_map<std::string_view, Handler> handlers_;
+
+            Numbering<ifc::DeclIndex> declarations_;
+            Numbering<ifc::TypeIndex> types_;
+            Numbering<ifc::ExprIndex> expressions_;
+            Numbering<ifc::SyntaxIndex> syntax_trees_;
+
+            // The new `scope.member`, of the scope descriptors and then of the friendship traits,
+            // whose partitions are written before it in the files MSVC writes, or after it.
+            std::vector<ifc::Declaration> members_;
+            std::vector<ifc::Sequence> scopes_;
+            std::vector<ifc::AssociatedTrait<ifc::Sequence>> friendships_;
+            bool members_built_ = false;
+        };
+
+        void SubsetWriter::register_declarations()
+        {
+            declarations<ifc::ScopeDeclaration>([this](auto& decl) { fix(decl.type, decl.base, decl.home_scope, decl.alignment); });
+            declarations<ifc::TemplateDeclaration>([this](auto& decl) { fix(decl.home_scope, decl.entity.decl, decl.type); });
+            declarations<ifc::PartialSpecialization>([this](auto& decl) { fix(decl.home_scope, decl.entity.decl); });
+            declarations<ifc::Specialization>([this](auto& decl) { fix(decl.decl); });
+            declarations<ifc::UsingDeclaration>([this](auto& decl) { fix(decl.home_scope, decl.resolution, decl.parent); });
+            declarations<ifc::Enumeration>([this](auto& decl) {
+                fix(decl.type, decl.base, decl.home_scope, decl.alignment);
+                // Enumerators of a kept enumeration are kept, as its members.
+                fix_sequence(decl.initializer, ifc::DeclSort::Enumerator);
+            });
+            declarations<ifc::Enumerator>([this](auto& decl) { fix(decl.type, decl.initializer); });
+            declarations<ifc::AliasDeclaration>([this](auto& decl) { fix(decl.type, decl.home_scope, decl.aliasee); });
+            // Refers to a declaration of another module, so `local_index` is kept.
+            declarations<ifc::DeclReference>([](auto&) {});
+            declarations<ifc::FunctionDeclaration>([this](auto& decl) { fix(decl.type, decl.home_scope); });
+            declarations<ifc::MethodDeclaration>([this](auto& decl) { fix(decl.type, decl.home_scope); });
+            declarations<ifc::Constructor>([this](auto& decl) { fix(decl.type, decl.home_scope); });
+            declarations<ifc::Destructor>([this](auto& decl) { fix(decl.home_scope); });
+            declarations<ifc::VariableDeclaration>([this](auto& decl) { fix(decl.type, decl.home_scope, decl.initializer, decl.alignment); });
+            declarations<ifc::ParameterDeclaration>([this](auto& decl) { fix(decl.type, decl.constraint, decl.initializer); });
+            declarations<ifc::FieldDeclaration>([this](auto& decl) { fix(decl.type, decl.home_scope, decl.initializer, decl.alignment); });
+            declarations<ifc::BitfieldDeclaration>([this](auto& decl) { fix(decl.type, decl.home_scope, decl.width, decl.initializer); });
+            declarations<ifc::FriendDeclaration>([this](auto& decl) { fix(decl.entity); });
+            declarations<ifc::Concept>([this](auto& decl) { fix(decl.home_scope, decl.type, decl.constraint); });
+            declarations<ifc::IntrinsicDeclaration>([this](auto& decl) { fix(decl.type, decl.home_scope); });
+        }
+
+        void SubsetWriter::register_types()
+        {
+            types<ifc::FundamentalType>([](auto&) {});
+            types<ifc::DesignatedType>([this](auto& type) { fix(type.decl); });
+            types<ifc::TorType>([this](auto& type) { fix(type.source); });
+            types<ifc::SyntacticType>([this](auto& type) { fix(type.expr); });
+            types<ifc::ExpansionType>([this](auto& type) { fix(type.pack); });
+            types<ifc::PointerType>([this](auto& type) { fix(type.pointee); });
+            types<ifc::FunctionType>([this](auto& type) { fix(type.target, type.source); });
+            types<ifc::MethodType>([this](auto& type) { fix(type.target, type.source, type.scope); });
+            types<ifc::ArrayType>([this](auto& type) { fix(type.element, type.extent); });
+            types<ifc::BaseType>([this](auto& type) { fix(type.type); });
+            // Its elements are in `heap.type`.
+            types<ifc::TupleType>([](auto&) {});
+            types<ifc::LvalueReference>([this](auto& type) { fix(type.referee); });
+            types<ifc::RvalueReference>([this](auto& type) { fix(type.referee); });
+            types<ifc::QualifiedType>([this](auto& type) { fix(type.unqualified); });
+            types<ifc::ForallType>([this](auto& type) { fix(type.subject); });
+            types<ifc::SyntaxType>([this](auto& type) { fix(type.syntax); });
+            types<ifc::PlaceholderType>([this](auto& type) { fix(type.constraint, type.elaboration); });
+            types<ifc::TypenameType>([this](auto& type) { fix(type.path); });
+            types<ifc::DecltypeType>([this](auto& type) { fix(type.argument); });
+        }
+
+        void SubsetWriter::register_expressions()
+        {
+            expressions<ifc::LiteralExpression>([](auto&) {});
+            expressions<ifc::TypeExpression>([this](auto& expr) { fix(expr.denotation); });
+            expressions<ifc::NamedDecl>([this](auto& expr) { fix(expr.resolution); });
+            expressions<ifc::UnqualifiedId>([this](auto& expr) { fix(expr.resolution); });
+            expressions<ifc::TemplateId>([this](auto& expr) { fix(expr.primary, expr.arguments); });
+            expressions<ifc::TemplateReference>([this](auto& expr) { fix(expr.member, expr.scope, expr.arguments); });
+            expressions<ifc::MonadExpression>([this](auto& expr) { fix(expr.impl, expr.argument); });
+            expressions<ifc::DyadExpression>([this](auto& expr) { fix(expr.impl, expr.arguments); });
+            expressions<ifc::StringExpression>([](auto&) {});
+            expressions<ifc::CallExpression>([this](auto& expr) { fix(expr.operation, expr.arguments); });
+            expressions<ifc::SizeofExpression>([this](auto& expr) { fix(expr.operand); });
+            expressions<ifc::AlignofExpression>([this](auto& expr) { fix(expr.operand); });
+            expressions<ifc::RequiresExpression>([this](auto& expr) { fix(expr.parameters, expr.body); });
+            // Its elements are in `heap.expr`.
+            expressions<ifc::TupleExpression>([](auto&) {});
+            expressions<ifc::PathExpression>([this](auto& expr) { fix(expr.scope, expr.member); });
+            expressions<ifc::ReadExpression>([this](auto& expr) { fix(expr.address); });
+            expressions<ifc::QualifiedNameExpression>([this](auto& expr) { fix(expr.elements); });
+            expressions<ifc::PackedTemplateArguments>([this](auto& expr) { fix(expr.arguments); });
+            expressions<ifc::ProductValueTypeExpression>([this](auto& expr) { fix(expr.structure, expr.members, expr.base_subobjects); });
+
+            // No type to fix.
+            renumbered<ifc::SyntaxTreeExpression, ifc::ExprIndex>([this](auto& expr) { fix(expr.syntax); });
+            renumbered<ifc::ExpressionListExpression, ifc::ExprIndex>([this](auto& expr) { fix(expr.contents); });
+            renumbered<ifc::SubobjectValueExpression, ifc::ExprIndex>([this](auto& expr) { fix(expr.value); });
+        }
+
+        void SubsetWriter::register_syntax_trees()
+        {
+            syntax_trees<ifc::SimpleTypeSpecifier>([this](auto& syntax) { fix(syntax.type, syntax.expr); });
+            syntax_trees<ifc::DecltypeSpecifier>([this](auto& syntax) { fix(syntax.argument); });
+            syntax_trees<ifc::TypeSpecifierSeq>([this](auto& syntax) { fix(syntax.typename_, syntax.type); });
+            syntax_trees<ifc::DeclSpecifierSeq>([this](auto& syntax) { fix(syntax.type, syntax.typename_, syntax.explicit_); });
+            syntax_trees<ifc::TypeIdSyntax>([this](auto& syntax) { fix(syntax.type_specifier, syntax.abstract_declarator); });
+            syntax_trees<ifc::DeclaratorSyntax>([this](auto& syntax) {
+                fix(syntax.pointer, syntax.parenthesized, syntax.array_or_function, syntax.trailing_target, syntax.virtual_specifiers, syntax.name);
+            });
+            syntax_trees<ifc::PointerDeclaratorSyntax>([this](auto& syntax) { fix(syntax.whole, syntax.next); });
+            syntax_trees<ifc::FunctionDeclaratorSyntax>([this](auto& syntax) { fix(syntax.parameters, syntax.eh_spec); });
+            syntax_trees<ifc::ParameterDeclaratorSyntax>([this](auto& syntax) { fix(syntax.decl_specifiers, syntax.declarator, syntax.default_); });
+            syntax_trees<ifc::ExpressionSyntax>([this](auto& syntax) { fix(syntax.expression); });
+            syntax_trees<ifc::RequiresClauseSyntax>([this](auto& syntax) { fix(syntax.condition); });
+            syntax_trees<ifc::SimpleRequirementSyntax>([this](auto& syntax) { fix(syntax.condition); });
+            syntax_trees<ifc::TypeRequirementSyntax>([this](auto& syntax) { fix(syntax.type); });
+            syntax_trees<ifc::NestedRequirementSyntax>([this](auto& syntax) { fix(syntax.condition); });
+            syntax_trees<ifc::CompoundRequirementSyntax>([this](auto& syntax) { fix(syntax.condition, syntax.constraint); });
+            syntax_trees<ifc::RequirementBodySyntax>([this](auto& syntax) { fix(syntax.requirements); });
+            syntax_trees<ifc::TypeTemplateArgumentSyntax>([this](auto& syntax) { fix(syntax.argument); });
+            syntax_trees<ifc::TemplateArgumentListSyntax>([this](auto& syntax) { fix(syntax.arguments); });
+            syntax_trees<ifc::TemplateIdSyntax>([this](auto& syntax) { fix(syntax.name, syntax.symbol, syntax.arguments); });
+            syntax_trees<ifc::TypeTraitIntrinsicSyntax>([this](auto& syntax) { fix(syntax.arguments); });
+            // Its elements are in `heap.syn`.
+            syntax_trees<ifc::TupleSyntax>([](auto&) {});
+        }
+
+        void SubsetWriter::register_others()
+        {
+            fixed<ifc::SpecializationForm>([this](auto& form) { fix(form.primary, form.arguments); });
+            fixed<ifc::ChartUnilevel>([this](auto& chart) {
+                fix_sequence(chart, ifc::DeclSort::Parameter);
+                fix(chart.constraint);
+            });
+            verbatim(ifc::ChartMultilevel::PartitionName);
+
+            fixed_heap<ifc::TypeIndex>("heap.type");
+            fixed_heap<ifc::ExprIndex>("heap.expr");
+            fixed_heap<ifc::SyntaxIndex>("heap.syn");
+            verbatim("heap.attr");
+            verbatim("heap.chart");
+
+            verbatim(ifc::OperatorFunctionName::PartitionName);
+            fixed<ifc::ConversionFunctionName>([this](auto& name) { fix(name.target); });
+            verbatim(ifc::LiteralName::PartitionName);
+            verbatim(ifc::TemplateName::PartitionName);
+            fixed<ifc::SpecializationName>([this](auto& name) { fix(name.arguments); });
+            verbatim(ifc::SourceFileName::PartitionName);
+            fixed<ifc::DeductionGuideName>([this](auto& name) { fix(name.primary_template); });
+
+            verbatim(ifc::AttrBasic::PartitionName);
+            verbatim(ifc::AttrScoped::PartitionName);
+            verbatim(ifc::AttrLabeled::PartitionName);
+            verbatim(ifc::AttrCalled::PartitionName);
+            verbatim(ifc::AttrExpanded::PartitionName);
+            verbatim(ifc::AttrFactored::PartitionName);
+            fixed<ifc::AttrElaborated>([this](auto& attribute) { fix(attribute.expression); });
+            verbatim(ifc::AttrTuple::PartitionName);
+
+            verbatim(ifc::IntegerLiteral::PartitionName);
+            verbatim(ifc::FPLiteral::PartitionName);
+            verbatim(ifc::StringLiteral::PartitionName);
+            verbatim(ifc::Word::PartitionName);
+            verbatim(ifc::Sentence::PartitionName);
+            verbatim(ifc::FileAndLine::PartitionName);
+            verbatim("module.imported");
+            verbatim("module.exported");
+
+            traits<ifc::AttrIndex>("trait.attribute", [](auto&) {});
+            traits<ifc::AttrIndex>(".msvc.trait.decl-attrs", [](auto&) {});
+            traits<ifc::TextOffset>("trait.deprecated", [](auto&) {});
+
+            register_scopes();
+        }
+
+        ifc::Sequence SubsetWriter::keep_members(ifc::Partition<ifc::Declaration> members, ifc::Sequence sequence)
+        {
+            const auto start = members_.size();
+            for (auto member : members.slice(sequence))
+            {
+                fix(member.index);
+                if (!member.index.is_null())
+                    members_.push_back(member);
+            }
+            return { ifc::Index{ static_cast<uint32_t>(start) }, static_cast<ifc::Cardinality>(members_.size() - start) };
+        }
+
+        // Scope descriptors (1-based `ScopeIndex`, so kept in place) and friendship traits index into
+        // `scope.member`: all three are rebuilt together, before the first of them is written.
+        void SubsetWriter::register_scopes()
+        {
+            auto build = [this] {
+                if (members_built_)
+                    return;
+                members_built_ = true;
+
+                ifc::Partition<ifc::Declaration> members(nullptr, 0);
+                if (auto const * summary = find(ifc::Declaration::PartitionName))
+                    members = entries<ifc::Declaration>(*summary);
+                if (auto const * summary = find("scope.desc"))
+                {
+                    for (auto scope : entries<ifc::Sequence>(*summary))
+                        scopes_.push_back(keep_members(members, scope));
+                }
+                if (auto const * summary = find("trait.friend"))
+                {
+                    for (auto friendship : entries<ifc::AssociatedTrait<ifc::Sequence>>(*summary))
+                    {
+                        fix(friendship.decl);
+                        if (friendship.decl.is_null())
+                            continue;
+                        friendship.trait = keep_members(members, friendship.trait);
+                        friendships_.push_back(friendship);
+                    }
+                }
+            };
+
+            handlers_.emplace(ifc::Declaration::PartitionName, [this, build](ifc::PartitionSummary const& summary) {
+                build();
+                writer_.add_partition(summary.name, std::span<ifc::Declaration const>(members_));
+            });
+            handlers_.emplace("scope.desc", [this, build](ifc::PartitionSummary const& summary) {
+                build();
+                writer_.add_partition(summary.name, std::span<ifc::Sequence const>(scopes_));
+            });
+            handlers_.emplace("trait.friend", [this, build](ifc::PartitionSummary const& summary) {
+                build();
+                writer_.add_partition(summary.name, std::span<ifc::AssociatedTrait<ifc::Sequence> const>(friendships_));
+            });
+        }
+    }
+
+    std::vector<std::byte> write_subset(ifc::File const& file, Reachability const& reachability)
+    {
+        return SubsetWriter(file, reachability).write();
+    }
+}
@@ -0,0 +1,117 @@
+﻿#include "reflifc/SyntaxWalker.h"
+
+#include <ifc/File.h>
+#include <ifc/SyntaxTree.h>
+
+#include <ranges>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Sorts with SyntaxIndex fields, see SyntaxWalker::push_children.
+        constexpr SyntaxSortSet inner_sorts = {
+            ifc::SyntaxSort::TypeSpecifierSeq,
+            ifc::SyntaxSort::DeclSpecifierSeq,
+            ifc::SyntaxSort::TypeId,
+            ifc::SyntaxSort::Declarator,
+            ifc::SyntaxSort::PointerDeclarator,
+            ifc::SyntaxSort::FunctionDeclarator,
+            ifc::SyntaxSort::ParameterDeclarator,
+            ifc::SyntaxSort::RequirementBody,
+            ifc::SyntaxSort::TypeTemplateArgument,
+            ifc::SyntaxSort::TemplateArgumentList,
+            ifc::SyntaxSort::TemplateId,
+            ifc::SyntaxSort::TypeTraitIntrinsic,
+            ifc::SyntaxSort::Tuple,
+        };
+    }
+
+    void SyntaxWalker::push(ifc::SyntaxIndex node)
+    {
+        if (node.is_null())
+            return;
+        const auto sort = node.sort();
+        if (interest_.contains(sort) || (descend_.contains(sort) && inner_sorts.contains(sort)))
+            stack_.push_back(node);
+    }
+
+    void SyntaxWalker::push_children(ifc::File const& file, ifc::SyntaxIndex node)
+    {
+        // Pushed last to first, so that children are visited in source order.
+        auto push_all = [this] (std::initializer_list<ifc::SyntaxIndex> children) {
+            for (auto child : children | std::views::reverse)
+                push(child);
+        };
+
+        switch (node.sort())
+        {
+        case ifc::SyntaxSort::TypeSpecifierSeq:
+            push(file.type_specifier_seq_syntax_trees()[node].typename_);
+            break;
+        case ifc::SyntaxSort::DeclSpecifierSeq:
+        {
+            auto const & specifiers = file.decl_specifier_seq_syntax_trees()[node];
+            push_all({ specifiers.typename_, specifiers.explicit_ });
+            break;
+        }
+        case ifc::SyntaxSort::TypeId:
+        {
+            auto const & type_id = file.typeid_syntax_trees()[node];
+            push_all({ type_id.type_specifier, type_id.abstract_declarator });
+            break;
+        }
+        case ifc::SyntaxSort::Declarator:
+        {
+            auto const & declarator = file.declarator_syntax_trees()[node];
+            push_all({ declarator.pointer, declarator.parenthesized, declarator.array_or_function,
+                       declarator.trailing_target, declarator.virtual_specifiers });
+            break;
+        }
+        case ifc::SyntaxSort::PointerDeclarator:
+            // Not `whole`, which refers back to the enclosing declarator.
+            push(file.pointer_declarator_syntax_trees()[node].next);
+            break;
+        case ifc::SyntaxSort::FunctionDeclarator:
+        {
+            auto const & declarator = file.function_declarator_syntax_trees()[node];
+            push_all({ declarator.parameters, declarator.eh_spec });
+            break;
+        }
+        case ifc::SyntaxSort::ParameterDeclarator:
+        {
+            auto const & declarator = file.parameter_declarator_syntax_trees()[node];
+            push_all({ declarator.decl_specifiers, declarator.declarator });
+            break;
+        }
+        case ifc::SyntaxSort::RequirementBody:
+            push(file.requirement_body_syntax_trees()[node].requirements);
+            break;
+        case ifc::SyntaxSort::TypeTemplateArgument:
+            push(file.type_template_argument_syntax_trees()[node].argument);
+            break;
+        case ifc::SyntaxSort::TemplateArgumentList:
+            push(file.template_argument_list_syntax_trees()[node].arguments);
+            break;
+        case ifc::SyntaxSort::TemplateId:
+        {
+            auto const & template_id = file.templateid_syntax_trees()[node];
+            push_all({ template_id.name, template_id.arguments });
+            break;
+        }
+        case ifc::SyntaxSort::TypeTraitIntrinsic:
+            push(file.type_trait_intrinsic_syntax_trees()[node].arguments);
+            break;
+        case ifc::SyntaxSort::Tuple:
+        {
+            const auto elements = file.tuple_syntax_trees()[node].seq;
+            const auto heap = file.syntax_heap();
+            for (auto i = raw_count(elements.cardinality); i != 0; --i)
+                push(heap[elements.start + (i - 1)]);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
@@ -1,5 +1,6 @@
 ﻿#include "reflifc/TupleView.h"
 
+#include "reflifc/Attribute.h"
 #include "reflifc/Expression.h"
 #include "reflifc/Syntax.h"
 #include "reflifc/Type.h"
@@ -7,6 +8,7 @@
 #include "reflifc/ViewOf.h"
 
 #include <ifc/File.h>
+#include <ifc/Attribute.h>
 #include <ifc/Expression.h>
 #include <ifc/SyntaxTree.h>
 #include <ifc/Type.h>
@@ -21,74 +23,26 @@ namespace reflifc
         return { ifc_, *index_ };
     }
 
-    template<typename Traits>
-    typename TupleView<Traits>::Iterator TupleView<Traits>::begin() const
-    {
-        if (index_->sort() == Sort::Tuple)
-        {
-            const auto tuple_elements = get_tuple_elements();
-            return get_tuple_element(tuple_elements.start);
-        }
-
-        return { index_, ifc_ };
-    }
-
-    template<typename Traits>
-    typename TupleView<Traits>::Iterator TupleView<Traits>::end() const
-    {
-        if (index_->is_null())
-            return { index_, ifc_ };
-
-        if (index_->sort() == Sort::Tuple)
-        {
-            const auto tuple_elements = get_tuple_elements();
-            return get_tuple_element(tuple_elements.start + raw_count(tuple_elements.cardinality));
-        }
-
-        return { index_ + 1, ifc_ };
-    }
-
     template<typename Traits>
     typename Traits::Element TupleView<Traits>::operator[](size_t index) const
     {
-        if (index_->sort() == Sort::Tuple)
-        {
-            const auto tuple_elements = get_tuple_elements();
-            const auto cardinality = raw_count(tuple_elements.cardinality);
-            if (index >= cardinality)
-                throw std::out_of_range("index (= " + std::to_string(index) + ") >= size (= " + std::to_string(cardinality) + ")");
-
-            return *get_tuple_element(tuple_elements.start + index);
-        }
-
-        if (index_->is_null())
+        if (empty())
             throw std::out_of_range("empty TupleView");
 
-        if (index > 0)
-            throw std::out_of_range("single element TupleView");
+        if (index >= size())
+            throw std::out_of_range("index (= " + std::to_string(index) + ") >= size (= " + std::to_string(size()) + ")");
 
-        return { ifc_, *index_ };
+        return begin()[static_cast<std::ptrdiff_t>(index)];
     }
 
-    template<typename Traits>
-    size_t TupleView<Traits>::size() const
-    {
-        if (index_->is_null())
-            return 0;
-
-        if (index_->sort() == Sort::Tuple)
-            return raw_count(get_tuple_elements().cardinality);
-
-        return 1;
-    }
+    template<typename> struct FuncGetter;
 
-    template<typename Traits>
-    bool TupleView<Traits>::empty() const
+    template<>
+    struct FuncGetter<Attribute>
     {
-        return index_->is_null();
-    }
-
-    template<typename> struct FuncGetter;
+        static constexpr auto heap = &ifc::File::attr_heap;
+        static constexpr auto element = &ifc::File::tuple_attributes;
+    };
 
     template<>
     struct FuncGetter<Expression>
@@ -112,24 +66,38 @@ namespace reflifc
     };
 
     template<typename Traits>
-    ifc::Sequence TupleView<Traits>::get_tuple_elements() const
+    TupleView<Traits>::TupleView(ifc::File const* ifc, Index const& index)
+        : first_(&index)
+        , last_(&index)
+        , ifc_(ifc)
     {
-        auto fptr = FuncGetter<Element>::element;
-        return (ifc_->*fptr)()[*index_].seq;
-    }
+        if (index.is_null())
+            return;
 
-    template<typename Traits>
-    typename TupleView<Traits>::Iterator TupleView<Traits>::get_tuple_element(ifc::Index index) const
-    {
-        auto fptr = FuncGetter<Element>::heap;
-        return { &(ifc_->*fptr)()[index], ifc_ };
+        if (index.sort() != Sort::Tuple)
+        {
+            last_ = first_ + 1;
+            return;
+        }
+
+        auto const & tuple = (ifc->*FuncGetter<Element>::element)()[index];
+        ifc::Sequence elements;
+        if constexpr (requires { tuple.seq; })
+            elements = tuple.seq;
+        else
+            elements = { tuple.start, tuple.cardinality };
+        first_ = (ifc->*FuncGetter<Element>::heap)().data() + static_cast<size_t>(elements.start);
+        last_ = first_ + raw_count(elements.cardinality);
     }
 
+    template struct TupleView<TupleAttributeTraits>;
     template struct TupleView<TupleExpressionTraits>;
     template struct TupleView<TupleSyntaxTraits>;
     template struct TupleView<TupleTypeTraits>;
 
+    static_assert(ViewOf<TupleAttributeView,   Attribute>);
     static_assert(ViewOf<TupleExpressionView,  Expression>);
     static_assert(ViewOf<TupleSyntaxView,      Syntax>);
     static_assert(ViewOf<TupleTypeView,        Type>);
+    static_assert(std::ranges::random_access_range<TupleExpressionView> && std::ranges::sized_range<TupleExpressionView>);
 }
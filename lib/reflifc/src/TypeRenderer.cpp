@@ -0,0 +1,429 @@
+#include "reflifc/TypeRenderer.h"
+
+#include "reflifc/index/ParentIndex.h"
+
+#include <ifc/Environment.h>
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Expression.h>
+#include <ifc/Literal.h>
+#include <ifc/Name.h>
+#include <ifc/Type.h>
+
+#include <charconv>
+#include <type_traits>
+
+namespace reflifc
+{
+    namespace
+    {
+        template<typename T>
+        void append_number(std::string & out, T value)
+        {
+            char digits[32];
+            const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+            out.append(digits, result.ptr);
+        }
+
+        void render_fundamental(ifc::FundamentalType type, std::string & out)
+        {
+            switch (type.sign)
+            {
+            case ifc::TypeSign::Plain:
+                break;
+            case ifc::TypeSign::Signed:
+                out += "signed ";
+                break;
+            case ifc::TypeSign::Unsigned:
+                out += "unsigned ";
+                break;
+            }
+
+            const bool is_char = type.basis == ifc::TypeBasis::Char;
+            switch (type.precision)
+            {
+            case ifc::TypePrecision::Default:
+                break;
+            case ifc::TypePrecision::Short:
+                out += "short";
+                return;
+            case ifc::TypePrecision::Long:
+                out += "long ";
+                break;
+            case ifc::TypePrecision::Bit64:
+                out += "long long";
+                return;
+            case ifc::TypePrecision::Bit8:
+                if (is_char)
+                {
+                    out += "char8_t";
+                    return;
+                }
+                break;
+            case ifc::TypePrecision::Bit16:
+                if (is_char)
+                {
+                    out += "char16_t";
+                    return;
+                }
+                break;
+            case ifc::TypePrecision::Bit32:
+                if (is_char)
+                {
+                    out += "char32_t";
+                    return;
+                }
+                break;
+            case ifc::TypePrecision::Bit128:
+                out += "__int128";
+                return;
+            }
+
+            switch (type.basis)
+            {
+            case ifc::TypeBasis::Void:     out += "void"; break;
+            case ifc::TypeBasis::Bool:     out += "bool"; break;
+            case ifc::TypeBasis::Char:     out += "char"; break;
+            case ifc::TypeBasis::Wchar_t:  out += "wchar_t"; break;
+            case ifc::TypeBasis::Int:      out += "int"; break;
+            case ifc::TypeBasis::Float:    out += "float"; break;
+            case ifc::TypeBasis::Double:   out += "double"; break;
+            case ifc::TypeBasis::Nullptr:  out += "decltype(nullptr)"; break;
+            case ifc::TypeBasis::Ellipsis: out += "..."; break;
+            case ifc::TypeBasis::Class:    out += "class"; break;
+            case ifc::TypeBasis::Struct:   out += "struct"; break;
+            case ifc::TypeBasis::Union:    out += "union"; break;
+            case ifc::TypeBasis::Enum:     out += "enum"; break;
+            case ifc::TypeBasis::Typename: out += "typename"; break;
+            case ifc::TypeBasis::Auto:     out += "auto"; break;
+            case ifc::TypeBasis::DecltypeAuto: out += "decltype(auto)"; break;
+            default:                       out += "(fundamental type)";
+            }
+        }
+
+        void render_traits(ifc::FunctionTypeTraits traits, std::string & out)
+        {
+            if (has_trait(traits, ifc::FunctionTypeTraits::Const))
+                out += " const";
+            if (has_trait(traits, ifc::FunctionTypeTraits::Volatile))
+                out += " volatile";
+            if (has_trait(traits, ifc::FunctionTypeTraits::Lvalue))
+                out += " &";
+            if (has_trait(traits, ifc::FunctionTypeTraits::Rvalue))
+                out += " &&";
+        }
+
+        void render_qualifiers(ifc::Qualifiers qualifiers, std::string & out)
+        {
+            if (has_qualifier(qualifiers, ifc::Qualifiers::Const))
+                out += " const";
+            if (has_qualifier(qualifiers, ifc::Qualifiers::Volatile))
+                out += " volatile";
+            if (has_qualifier(qualifiers, ifc::Qualifiers::Restrict))
+                out += " __restrict";
+        }
+    }
+
+    TypeRenderer::TypeRenderer(ifc::File const& file, ifc::Environment* environment)
+        : file_(file)
+        , environment_(environment)
+    {
+    }
+
+    template<typename Index>
+    std::string_view TypeRenderer::memoized(std::vector<std::string_view> & spellings, Index index)
+    {
+        if (index.index < spellings.size() && spellings[index.index].data() != nullptr)
+            return spellings[index.index];
+
+        // Operands are rendered (and stored) first, by nested calls, each into a buffer of its own.
+        if (depth_ == buffers_.size())
+            buffers_.emplace_back();
+        auto & buffer = buffers_[depth_++];
+        buffer.clear();
+        try
+        {
+            if constexpr (std::is_same_v<Index, ifc::TypeIndex>)
+                render(index, buffer);
+            else
+                render_name(index, buffer);
+        }
+        catch (...)
+        {
+            --depth_;
+            throw;
+        }
+        --depth_;
+
+        // Views of the arena are never null, even for empty spellings.
+        const auto result = arena_.store(buffer);
+        if (index.index >= spellings.size())
+            spellings.resize(index.index + 1);
+        spellings[index.index] = result;
+        return result;
+    }
+
+    std::string_view TypeRenderer::spelling(ifc::TypeIndex type)
+    {
+        if (type.is_null())
+            return {};
+        return memoized(spellings_[static_cast<size_t>(type.sort())], type);
+    }
+
+    void TypeRenderer::append(ifc::TypeIndex type, std::string & out)
+    {
+        out += spelling(type);
+    }
+
+    std::string_view TypeRenderer::spelling(ifc::NameIndex name)
+    {
+        if (name.is_null())
+            return {};
+        if (name.sort() == ifc::NameSort::Identifier)
+            return file_.get_string_view(ifc::TextOffset{ name.index });
+        return memoized(name_spellings_[static_cast<size_t>(name.sort())], name);
+    }
+
+    void TypeRenderer::render_name(ifc::NameIndex name, std::string & out)
+    {
+        switch (name.sort())
+        {
+        case ifc::NameSort::Operator:
+            out += "operator";
+            out += file_.get_string_view(file_.operator_names()[name].encoded);
+            break;
+        case ifc::NameSort::Conversion:
+            out += "operator ";
+            out += spelling(file_.conversion_function_names()[name].target);
+            break;
+        case ifc::NameSort::Literal:
+            out += "operator\"\"";
+            out += file_.get_string_view(file_.literal_names()[name].encoded);
+            break;
+        case ifc::NameSort::Template:
+            out += spelling(file_.template_names()[name].name);
+            break;
+        case ifc::NameSort::Specialization:
+        {
+            const auto specialization = file_.specialization_names()[name];
+            out += spelling(specialization.primary);
+            out += '<';
+            render_list(specialization.arguments, out);
+            out += '>';
+            break;
+        }
+        default:
+            out += "(name)";
+        }
+    }
+
+    void TypeRenderer::render(ifc::TypeIndex type, std::string & out)
+    {
+        switch (type.sort())
+        {
+        case ifc::TypeSort::Fundamental:
+            render_fundamental(file_.fundamental_types()[type], out);
+            break;
+        case ifc::TypeSort::Designated:
+            render_declaration(file_.designated_types()[type].decl, out);
+            break;
+        case ifc::TypeSort::Syntactic:
+            render(file_.syntactic_types()[type].expr, out);
+            break;
+        case ifc::TypeSort::Expansion:
+            out += spelling(file_.expansion_types()[type].pack);
+            out += "...";
+            break;
+        case ifc::TypeSort::Pointer:
+            out += spelling(file_.pointer_types()[type].pointee);
+            out += '*';
+            break;
+        case ifc::TypeSort::LvalueReference:
+            out += spelling(file_.lvalue_references()[type].referee);
+            out += '&';
+            break;
+        case ifc::TypeSort::RvalueReference:
+            out += spelling(file_.rvalue_references()[type].referee);
+            out += "&&";
+            break;
+        case ifc::TypeSort::Function:
+        {
+            const auto function = file_.function_types()[type];
+            out += spelling(function.target);
+            out += '(';
+            render_list(function.source, out);
+            out += ')';
+            render_traits(function.traits, out);
+            break;
+        }
+        case ifc::TypeSort::Method:
+        {
+            const auto method = file_.method_types()[type];
+            out += spelling(method.target);
+            out += '(';
+            render_list(method.source, out);
+            out += ')';
+            render_traits(method.traits, out);
+            break;
+        }
+        case ifc::TypeSort::Tor:
+            out += '(';
+            render_list(file_.tor_types()[type].source, out);
+            out += ')';
+            break;
+        case ifc::TypeSort::Array:
+        {
+            const auto array = file_.array_types()[type];
+            out += spelling(array.element);
+            out += '[';
+            if (!array.extent.is_null())
+                render(array.extent, out);
+            out += ']';
+            break;
+        }
+        case ifc::TypeSort::Typename:
+            out += "typename ";
+            render(file_.typename_types()[type].path, out);
+            break;
+        case ifc::TypeSort::Qualified:
+        {
+            const auto qualified = file_.qualified_types()[type];
+            out += spelling(qualified.unqualified);
+            render_qualifiers(qualified.qualifiers, out);
+            break;
+        }
+        case ifc::TypeSort::Base:
+            out += spelling(file_.base_types()[type].type);
+            break;
+        case ifc::TypeSort::Decltype:
+            out += "decltype(...)";
+            break;
+        case ifc::TypeSort::Placeholder:
+            switch (file_.placeholder_types()[type].basis)
+            {
+            case ifc::TypeBasis::DecltypeAuto:
+                out += "decltype(auto)";
+                break;
+            default:
+                out += "auto";
+            }
+            break;
+        case ifc::TypeSort::Tuple:
+            render_list(type, out);
+            break;
+        case ifc::TypeSort::Forall:
+            out += spelling(file_.forall_types()[type].subject);
+            break;
+        default:
+            out += "(type)";
+        }
+    }
+
+    void TypeRenderer::render_list(ifc::TypeIndex type, std::string & out)
+    {
+        if (type.is_null())
+            return;
+        if (type.sort() != ifc::TypeSort::Tuple)
+        {
+            out += spelling(type);
+            return;
+        }
+
+        bool first = true;
+        for (auto element : file_.type_heap().slice(file_.tuple_types()[type].seq))
+        {
+            if (!first)
+                out += ',';
+            first = false;
+            out += spelling(element);
+        }
+    }
+
+    void TypeRenderer::render(ifc::ExprIndex expr, std::string & out)
+    {
+        switch (expr.sort())
+        {
+        case ifc::ExprSort::Type:
+            out += spelling(file_.type_expressions()[expr].denotation);
+            break;
+        case ifc::ExprSort::NamedDecl:
+            render_declaration(file_.decl_expressions()[expr].resolution, out);
+            break;
+        case ifc::ExprSort::UnqualifiedId:
+            out += spelling(file_.unqualified_id_expressions()[expr].name);
+            break;
+        case ifc::ExprSort::Literal:
+        {
+            const auto literal = file_.literal_expressions()[expr].value;
+            switch (literal.sort())
+            {
+            case ifc::LiteralSort::Immediate:
+                append_number(out, literal.index);
+                break;
+            case ifc::LiteralSort::Integer:
+                append_number(out, file_.integer_literals()[literal].value);
+                break;
+            case ifc::LiteralSort::FloatingPoint:
+                append_number(out, file_.fp_literals()[literal].value());
+                break;
+            }
+            break;
+        }
+        case ifc::ExprSort::TemplateId:
+        {
+            const auto template_id = file_.template_ids()[expr];
+            render(template_id.primary, out);
+            out += '<';
+            render_list(template_id.arguments, out);
+            out += '>';
+            break;
+        }
+        case ifc::ExprSort::PackedTemplateArguments:
+            render_list(file_.packed_template_arguments()[expr].arguments, out);
+            break;
+        case ifc::ExprSort::Tuple:
+            render_list(expr, out);
+            break;
+        default:
+            out += "(expression)";
+        }
+    }
+
+    void TypeRenderer::render_list(ifc::ExprIndex expr, std::string & out)
+    {
+        if (expr.is_null())
+            return;
+        if (expr.sort() != ifc::ExprSort::Tuple)
+        {
+            render(expr, out);
+            return;
+        }
+
+        bool first = true;
+        for (auto element : file_.expr_heap().slice(file_.tuple_expressions()[expr].seq))
+        {
+            if (!first)
+                out += ',';
+            first = false;
+            render(element, out);
+        }
+    }
+
+    void TypeRenderer::render_declaration(ifc::DeclIndex decl, std::string & out)
+    {
+        const ifc::File* file = &file_;
+        if (decl.sort() == ifc::DeclSort::Reference)
+        {
+            if (!environment_)
+            {
+                out += "(imported)";
+                return;
+            }
+            const auto resolved = environment_->resolve_reference(file_, decl);
+            file = resolved.file;
+            decl = resolved.decl;
+        }
+
+        out += file->get_index<ParentIndex>().qualified_name(*file, decl, name_buffer_);
+    }
+}
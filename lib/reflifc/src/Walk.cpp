@@ -0,0 +1,154 @@
+#include "reflifc/Walk.h"
+
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Scope.h>
+#include <ifc/Type.h>
+
+#include <ranges>
+#include <vector>
+
+namespace reflifc
+{
+    namespace
+    {
+        struct Frame
+        {
+            ifc::DeclIndex decl;
+            ifc::DeclIndex parent;
+            uint32_t depth;
+        };
+
+        bool is_namespace(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            return decl.sort() == ifc::DeclSort::Scope && get_kind(file.scope_declarations()[decl], file) == ifc::TypeBasis::Namespace;
+        }
+
+        // Members of the scope, or of the global scope if null, pushed last to first, so that they are
+        // visited in declaration order.
+        void push_members(ifc::File const& file, WalkOptions const& options, ifc::DeclIndex parent, uint32_t depth, std::vector<Frame>& stack)
+        {
+            auto scope = parent.is_null() ? file.header().global_scope : ifc::ScopeIndex{};
+            auto entity = parent;
+            if (entity.sort() == ifc::DeclSort::Template && options.template_members)
+                entity = file.template_declarations()[entity].entity.decl;
+
+            if (entity.sort() == ifc::DeclSort::Scope)
+            {
+                scope = file.scope_declarations()[entity].initializer;
+            }
+            else if (entity.sort() == ifc::DeclSort::Enumeration && options.enumerators)
+            {
+                const auto enumerators = file.enumerations()[entity].initializer;
+                for (auto i = static_cast<uint32_t>(raw_count(enumerators.cardinality)); i-- != 0;)
+                    stack.push_back({ { .tag = static_cast<uint32_t>(ifc::DeclSort::Enumerator), .index = static_cast<uint32_t>(enumerators.start) + i }, parent, depth });
+                return;
+            }
+
+            if (ifc::is_null(scope))
+                return;
+            for (auto const& member : ifc::get_declarations(file, file.scope_descriptors()[scope]) | std::views::reverse)
+                stack.push_back({ member.index, parent, depth });
+        }
+
+        class Walker
+        {
+        public:
+            Walker(ifc::File const& file, std::function<bool(WalkEntry const&)> const& visit, WalkOptions const& options)
+                : file_(file)
+                , visit_(visit)
+                , options_(options)
+                , cancellation_(options.cancellation ? options.cancellation : ifc::current_cancellation())
+            {
+            }
+
+            void push_members(ifc::DeclIndex parent, uint32_t depth, std::vector<Frame>& stack) const
+            {
+                reflifc::push_members(file_, options_, parent, depth, stack);
+            }
+
+            bool visit(Frame const& frame) const
+            {
+                return visit_({ Declaration(&file_, frame.decl), Declaration(&file_, frame.parent), frame.depth });
+            }
+
+            // Visits the frames of the stack and all their members.
+            void walk(std::vector<Frame>& stack) const
+            {
+                const ifc::CancellationScope scope(cancellation_);
+                for (size_t visited = 0; !stack.empty(); ++visited)
+                {
+                    ifc::poll_cancellation(cancellation_, visited);
+                    const auto frame = stack.back();
+                    stack.pop_back();
+                    if (visit(frame))
+                        push_members(frame.decl, frame.depth + 1, stack);
+                }
+            }
+
+            void walk_parallel(ifc::Executor& executor) const
+            {
+                // Namespaces whose other members are walked by the tasks, the global one first.
+                std::vector<Frame> namespaces{ { {}, {}, 0 } };
+                std::vector<Frame> stack;
+                const ifc::CancellationScope scope(cancellation_);
+                for (size_t i = 0; i != namespaces.size(); ++i)
+                {
+                    ifc::poll_cancellation(cancellation_, i);
+                    const auto parent = namespaces[i];
+                    push_members(parent.decl, parent.decl.is_null() ? 0 : parent.depth + 1, stack);
+                    for (auto const& member : stack | std::views::reverse)
+                    {
+                        if (is_namespace(file_, member.decl) && visit(member))
+                            namespaces.push_back(member);
+                    }
+                    stack.clear();
+                }
+
+                executor.run(namespaces.size(), [&](size_t i) {
+                    const auto parent = namespaces[i];
+                    std::vector<Frame> members;
+                    push_members(parent.decl, parent.decl.is_null() ? 0 : parent.depth + 1, members);
+                    std::erase_if(members, [this] (Frame const& member) { return is_namespace(file_, member.decl); });
+                    walk(members);
+                });
+            }
+
+        private:
+            ifc::File const& file_;
+            std::function<bool(WalkEntry const&)> const& visit_;
+            WalkOptions const& options_;
+            ifc::CancellationToken const* cancellation_;
+        };
+    }
+
+    void walk_declarations(Module module, std::function<bool(WalkEntry const&)> const& visit, WalkOptions options)
+    {
+        const Walker walker(*module.global_namespace().containing_file(), visit, options);
+        if (options.executor)
+        {
+            walker.walk_parallel(*options.executor);
+            return;
+        }
+
+        std::vector<Frame> stack;
+        walker.push_members({}, 0, stack);
+        walker.walk(stack);
+    }
+
+    Generator<WalkEntry> walk_generator(Module module, WalkOptions options)
+    {
+        auto const & file = *module.global_namespace().containing_file();
+        const auto cancellation = options.cancellation ? options.cancellation : ifc::current_cancellation();
+        std::vector<Frame> stack;
+        push_members(file, options, {}, 0, stack);
+        for (size_t visited = 0; !stack.empty(); ++visited)
+        {
+            ifc::poll_cancellation(cancellation, visited);
+            const auto frame = stack.back();
+            stack.pop_back();
+            co_yield WalkEntry{ Declaration(&file, frame.decl), Declaration(&file, frame.parent), frame.depth };
+            push_members(file, options, frame.decl, frame.depth + 1, stack);
+        }
+    }
+}
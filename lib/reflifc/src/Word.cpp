@@ -3,8 +3,58 @@
 #include <ifc/File.h>
 #include <ifc/Word.h>
 
+#include <iterator>
+
 namespace reflifc
 {
+    namespace
+    {
+        constexpr std::string_view punctuators[] = {
+            "", "(", ")", "[", "]", "{", "}", ":", "?", ";", "::",
+        };
+        static_assert(std::size(punctuators) == static_cast<size_t>(ifc::SourcePunctuator::ColonColon) + 1);
+
+        constexpr std::string_view operators[] = {
+            "", "=", ",", "!", "+", "-", "*", "/", "%", "<<", ">>", "~", "^", "|", "&", "++", "--",
+            "<", "<=", ">", ">=", "==", "!=", "<=>", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=",
+            "<<=", ">>=", "&&", "||", "...", ".", "->", ".*", "->*",
+        };
+        static_assert(std::size(operators) == static_cast<size_t>(ifc::SourceOperator::ArrowStar) + 1);
+
+        constexpr std::string_view keywords[] = {
+            "", "alignas", "alignof", "asm", "auto", "bool", "break", "case", "catch", "char", "char8_t",
+            "char16_t", "char32_t", "class", "concept", "const", "consteval", "constexpr", "constinit",
+            "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete",
+            "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float",
+            "for", "friend", "_Generic", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new",
+            "noexcept", "nullptr", "operator", "_Pragma", "private", "protected", "public", "register",
+            "reinterpret_cast", "requires", "restrict", "return", "short", "signed", "sizeof", "static",
+            "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw",
+            "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void",
+            "volatile", "wchar_t", "while",
+        };
+        static_assert(std::size(keywords) == static_cast<size_t>(ifc::SourceKeyword::While) + 1);
+
+        // Starting at SourceKeyword::MsvcAsm.
+        constexpr std::string_view msvc_keywords[] = {
+            "__asm", "__assume", "__alignof", "__based", "__cdecl", "__clrcall", "__declspec", "__eabi",
+            "__event", "__except", "__fastcall", "__finally", "__forceinline", "__hook", "__identifier",
+            "__if_exists", "__if_not_exists", "__int8", "__int16", "__int32", "__int64", "__int128",
+            "__interface", "__leave", "__multiple_inheritance", "__nullptr", "__novtordisp", "__pragma",
+            "__ptr32", "__ptr64", "__restrict", "__single_inheritance", "__sptr", "__stdcall", "__super",
+            "__thiscall", "__try", "__uptr", "__uuidof", "__unaligned", "__unhook", "__vectorcall",
+            "__virtual_inheritance", "__w64",
+        };
+        static_assert(std::size(msvc_keywords) ==
+            static_cast<size_t>(ifc::SourceKeyword::MsvcW64) - static_cast<size_t>(ifc::SourceKeyword::MsvcAsm) + 1);
+
+        template<size_t N>
+        std::string_view lookup(std::string_view const (&table)[N], size_t value)
+        {
+            return value < N ? table[value] : std::string_view();
+        }
+    }
+
     bool Word::is_identifier() const
     {
         return word_->sort == ifc::WordSort::Identifier;
@@ -14,4 +64,33 @@ namespace reflifc
     {
         return ifc_->get_string(static_cast<ifc::TextOffset>(word_->index));
     }
+
+    std::string_view Word::spelling() const
+    {
+        switch (word_->sort)
+        {
+        case ifc::WordSort::Identifier:
+            return ifc_->get_string(static_cast<ifc::TextOffset>(word_->index));
+        case ifc::WordSort::Keyword:
+            if (word_->value >= static_cast<uint16_t>(ifc::SourceKeyword::MsvcAsm))
+                return lookup(msvc_keywords, word_->value - static_cast<uint16_t>(ifc::SourceKeyword::MsvcAsm));
+            return lookup(keywords, word_->value);
+        case ifc::WordSort::Punctuator:
+            return lookup(punctuators, word_->value);
+        case ifc::WordSort::Operator:
+            return lookup(operators, word_->value);
+        case ifc::WordSort::Literal:
+            switch (static_cast<ifc::SourceLiteral>(word_->value))
+            {
+            case ifc::SourceLiteral::Scalar:
+            case ifc::SourceLiteral::String:
+            case ifc::SourceLiteral::DefinedString:
+                return ifc_->get_string(static_cast<ifc::TextOffset>(word_->index));
+            default:
+                return {};
+            }
+        default:
+            return {};
+        }
+    }
 }
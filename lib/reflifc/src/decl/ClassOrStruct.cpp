@@ -23,4 +23,10 @@ namespace reflifc
     {
         return { ifc_, scope_->home_scope };
     }
+
+    ifc::DeclIndex ClassOrStruct::index() const
+    {
+        const auto position = ifc_->scope_declarations().index_of(*scope_);
+        return { .tag = static_cast<uint32_t>(ifc::DeclSort::Scope), .index = static_cast<uint32_t>(position) };
+    }
 }
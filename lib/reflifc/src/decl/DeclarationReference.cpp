@@ -12,7 +12,11 @@ namespace reflifc
 
 	reflifc::Declaration DeclarationReference::referenced_declaration(ifc::Environment& environment) const
 	{
-		const auto& other_ifc = environment.get_referenced_module(decl_reference_->unit, *ifc_);
-		return reflifc::Declaration(&other_ifc, decl_reference_->local_index);
+		const auto reference = ifc::DeclIndex{
+			.tag = static_cast<uint32_t>(ifc::DeclSort::Reference),
+			.index = static_cast<uint32_t>(ifc_->decl_references().index_of(*decl_reference_)),
+		};
+		const auto [file, decl] = environment.resolve_reference(*ifc_, reference);
+		return reflifc::Declaration(file, decl);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "reflifc/decl/Scope.h"
+
+#include "reflifc/index/OverloadSetIndex.h"
+#include "reflifc/index/ScopeNameIndex.h"
+
+namespace reflifc
+{
+    std::optional<Declaration> Scope::find(std::string_view name) const
+    {
+        const auto members = members_named(name);
+        if (members.empty())
+            return std::nullopt;
+        return Declaration(ifc_, members.front());
+    }
+
+    std::span<ifc::DeclIndex const> Scope::members_named(std::string_view name) const
+    {
+        const auto identifier = ifc_->find_text(name);
+        if (!identifier)
+            return {};
+        return ifc_->get_index<ScopeNameIndex>().find(*ifc_, scope_, *identifier);
+    }
+
+    std::span<ifc::DeclIndex const> Scope::overloads_named(std::string_view name) const
+    {
+        const auto identifier = ifc_->find_text(name);
+        if (!identifier)
+            return {};
+        return ifc_->get_index<OverloadSetIndex>().find(*ifc_, scope_, *identifier);
+    }
+
+    std::span<ifc::DeclIndex const> Scope::overloads_of(ifc::Operator op) const
+    {
+        return ifc_->get_index<OverloadSetIndex>().find(*ifc_, scope_, op);
+    }
+}
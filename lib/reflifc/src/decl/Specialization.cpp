@@ -18,6 +18,11 @@ namespace reflifc
         return { ifc_, form_->arguments };
     }
 
+    ifc::ExprIndex SpecializationForm::arguments_index() const
+    {
+        return form_->arguments;
+    }
+
     Name PartialSpecialization::name() const
     {
         return { ifc_, spec_->name };
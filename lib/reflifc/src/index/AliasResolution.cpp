@@ -0,0 +1,60 @@
+#include "reflifc/index/AliasResolution.h"
+
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+
+#include <bit>
+#include <vector>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Aliasee of the alias designated by the type, null if it does not designate one of the file.
+        ifc::TypeIndex aliasee(ifc::File const& file, ifc::TypeIndex type)
+        {
+            if (type.sort() != ifc::TypeSort::Designated)
+                return {};
+            const auto decl = file.designated_types()[type].decl;
+            if (decl.sort() != ifc::DeclSort::Alias)
+                return {};
+            return file.alias_declarations()[decl].aliasee;
+        }
+    }
+
+    AliasResolution::AliasResolution(ifc::File const& file)
+        : count_(file.has_partition(ifc::DesignatedType::PartitionName) ? static_cast<uint32_t>(file.designated_types().size()) : 0)
+        , designated_(std::make_unique<std::atomic<uint32_t>[]>(count_))
+    {
+    }
+
+    ifc::TypeIndex AliasResolution::underlying(ifc::File const& file, ifc::TypeIndex type) const
+    {
+        // Designated types of the chain, not resolved yet.
+        std::vector<uint32_t> chain;
+        while (type.sort() == ifc::TypeSort::Designated && type.index < count_)
+        {
+            if (const auto resolved = designated_[type.index].load(std::memory_order_relaxed))
+            {
+                type = std::bit_cast<ifc::TypeIndex>(resolved);
+                break;
+            }
+            const auto next = aliasee(file, type);
+            if (next.is_null())
+                break;
+            chain.push_back(type.index);
+            type = next;
+        }
+
+        // Resolved concurrently by other threads alike, to the same type.
+        for (auto index : chain)
+            designated_[index].store(std::bit_cast<uint32_t>(type), std::memory_order_relaxed);
+        return type;
+    }
+
+    size_t AliasResolution::heap_bytes() const
+    {
+        return count_ * sizeof(std::atomic<uint32_t>);
+    }
+}
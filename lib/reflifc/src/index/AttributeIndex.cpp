@@ -0,0 +1,128 @@
+#include "reflifc/index/AttributeIndex.h"
+
+#include <ifc/Attribute.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+namespace reflifc
+{
+    namespace
+    {
+        using Entry = std::pair<uint64_t, ifc::DeclIndex>;
+
+        uint64_t make_key(uint32_t scope, uint32_t identifier)
+        {
+            return static_cast<uint64_t>(scope) << 32 | identifier;
+        }
+
+        // Offset of the first string with the text, so that equal names get equal keys.
+        std::optional<uint32_t> word_text(ifc::File const& file, ifc::Word const& word)
+        {
+            if (word.sort != ifc::WordSort::Identifier)
+                return std::nullopt;
+            const auto offset = static_cast<ifc::TextOffset>(word.index);
+            return static_cast<uint32_t>(file.find_text(file.get_string_view(offset)).value_or(offset));
+        }
+
+        void add_names(ifc::File const& file, ifc::DeclIndex decl, ifc::AttrIndex attr, std::optional<uint32_t> factor, std::vector<Entry>& out)
+        {
+            switch (attr.sort())
+            {
+            case ifc::AttrSort::Basic:
+                if (auto identifier = word_text(file, file.basic_attributes()[attr].word))
+                    out.emplace_back(make_key(factor.value_or(0), *identifier), decl);
+                break;
+            case ifc::AttrSort::Scoped:
+            {
+                auto const & scoped = file.scoped_attributes()[attr];
+                const auto scope = word_text(file, scoped.scope);
+                const auto member = word_text(file, scoped.member);
+                if (scope && member)
+                    out.emplace_back(make_key(*scope, *member), decl);
+                break;
+            }
+            case ifc::AttrSort::Labeled:
+                add_names(file, decl, file.labeled_attributes()[attr].attribute, factor, out);
+                break;
+            case ifc::AttrSort::Called:
+                add_names(file, decl, file.called_attributes()[attr].function, factor, out);
+                break;
+            case ifc::AttrSort::Expanded:
+                add_names(file, decl, file.expanded_attributes()[attr].operand, factor, out);
+                break;
+            case ifc::AttrSort::Factored:
+            {
+                auto const & factored = file.factored_attributes()[attr];
+                if (auto scope = word_text(file, factored.factor))
+                    add_names(file, decl, factored.terms, scope, out);
+                break;
+            }
+            case ifc::AttrSort::Tuple:
+            {
+                auto const & tuple = file.tuple_attributes()[attr];
+                const auto heap = file.attr_heap();
+                for (uint32_t i = 0; i != raw_count(tuple.cardinality); ++i)
+                    add_names(file, decl, heap[tuple.start + i], factor, out);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        void add_traits(ifc::File const& file, ifc::Partition<ifc::AssociatedTrait<ifc::AttrIndex>, ifc::Index> traits, std::vector<Entry>& out)
+        {
+            for (auto const & [decl, attr] : traits)
+                add_names(file, decl, attr, std::nullopt, out);
+        }
+    }
+
+    AttributeIndex::AttributeIndex(ifc::File const& file)
+        : keys_(file.memory_resource())
+        , decls_(file.memory_resource())
+    {
+        std::vector<Entry> entries;
+        add_traits(file, file.attribute_traits(), entries);
+        add_traits(file, file.msvc_declaration_attribute_traits(), entries);
+        std::ranges::sort(entries);
+        const auto [last, end] = std::ranges::unique(entries);
+        entries.erase(last, end);
+
+        keys_.reserve(entries.size());
+        decls_.reserve(entries.size());
+        for (auto [key, decl] : entries)
+        {
+            keys_.push_back(key);
+            decls_.push_back(decl);
+        }
+    }
+
+    std::span<ifc::DeclIndex const> AttributeIndex::find(ifc::File const& file, std::string_view name) const
+    {
+        uint32_t scope = 0;
+        if (const auto separator = name.find("::"); separator != std::string_view::npos)
+        {
+            const auto scope_text = file.find_text(name.substr(0, separator));
+            if (!scope_text)
+                return {};
+            scope = static_cast<uint32_t>(*scope_text);
+            name.remove_prefix(separator + 2);
+        }
+
+        const auto identifier = file.find_text(name);
+        if (!identifier)
+            return {};
+
+        const auto [first, last] = std::ranges::equal_range(keys_, make_key(scope, static_cast<uint32_t>(*identifier)));
+        return std::span(decls_).subspan(first - keys_.begin(), last - first);
+    }
+
+    size_t AttributeIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(keys_) + ifc::heap_bytes(decls_);
+    }
+}
@@ -0,0 +1,135 @@
+#include "reflifc/index/BaseLinearization.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+
+#include <unordered_set>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Class named by a base of the scope, if it names one by declaration.
+        std::optional<ifc::Environment::ResolvedDeclaration> resolve_base(ifc::File const& file, ifc::TypeIndex base, ifc::Environment& environment)
+        {
+            if (base.sort() == ifc::TypeSort::Base)
+                base = file.base_types()[base].type;
+            if (base.sort() != ifc::TypeSort::Designated)
+                return std::nullopt;
+
+            const auto decl = file.designated_types()[base].decl;
+            if (decl.sort() == ifc::DeclSort::Scope)
+                return ifc::Environment::ResolvedDeclaration{ &file, decl };
+            if (decl.sort() != ifc::DeclSort::Reference)
+                return std::nullopt;
+            const auto resolved = environment.resolve_reference(file, decl);
+            if (resolved.decl.sort() != ifc::DeclSort::Scope)
+                return std::nullopt;
+            return resolved;
+        }
+
+        bool still_loaded(BaseLinearization::Linearization const& linearization, ifc::Environment const& environment)
+        {
+            if (linearization.environment != &environment)
+                return false;
+            for (auto const & base : linearization.bases)
+            {
+                if (environment.file(base.id.file) == nullptr)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    std::vector<ifc::Environment::ResolvedDeclaration> BaseLinearization::direct_bases(ifc::File const& file, ifc::DeclIndex decl, ifc::Environment& environment)
+    {
+        std::vector<ifc::Environment::ResolvedDeclaration> result;
+        auto const & scope = file.scope_declarations()[decl];
+        if (scope.base.is_null())
+            return result;
+        const auto add = [&](ifc::TypeIndex base) {
+            if (const auto resolved = resolve_base(file, base, environment))
+                result.push_back(*resolved);
+        };
+        if (scope.base.sort() == ifc::TypeSort::Tuple)
+        {
+            for (auto base : file.type_heap().slice(file.tuple_types()[scope.base].seq))
+                add(base);
+        }
+        else
+        {
+            add(scope.base);
+        }
+        return result;
+    }
+
+    BaseLinearization::BaseLinearization(ifc::File const& file)
+        : classes_(file.has_partition(ifc::ScopeDeclaration::PartitionName) ? file.scope_declarations().size() : 0, file.memory_resource())
+    {
+    }
+
+    std::shared_ptr<BaseLinearization::Linearization const> BaseLinearization::find(ifc::File const& file, ifc::DeclIndex decl, ifc::Environment& environment) const
+    {
+        if (decl.sort() != ifc::DeclSort::Scope || decl.index >= classes_.size())
+            return nullptr;
+
+        auto & slot = classes_[decl.index];
+        if (auto cached = slot.load(std::memory_order_acquire); cached && still_loaded(*cached, environment))
+            return cached;
+
+        // Linearized concurrently by other threads alike, the last one is kept.
+        auto linearization = linearize(file, decl, environment);
+        slot.store(linearization, std::memory_order_release);
+        return linearization;
+    }
+
+    std::shared_ptr<BaseLinearization::Linearization const> BaseLinearization::linearize(ifc::File const& file, ifc::DeclIndex decl, ifc::Environment& environment) const
+    {
+        auto result = std::make_shared<Linearization>();
+        result->environment = &environment;
+        auto & bases = result->bases;
+        bases.push_back({ environment.declaration_id(file, decl), 1 });
+
+        std::unordered_set<ifc::DeclarationId> seen{ bases.front().id };
+        std::vector<uint32_t> positions;
+        std::vector<uint32_t> kept;
+        for (auto [base_file, base_decl] : direct_bases(file, decl, environment))
+        {
+            const auto inherited = base_file->get_index<BaseLinearization>().find(*base_file, base_decl, environment);
+            if (!inherited)
+                continue;
+
+            // Classes seen through an earlier base (virtual or repeated bases) are left out,
+            // the ends of the others move to the positions of the classes kept.
+            auto const & more = inherited->bases;
+            positions.resize(more.size() + 1);
+            kept.clear();
+            for (uint32_t i = 0; i != more.size(); ++i)
+            {
+                positions[i] = static_cast<uint32_t>(bases.size());
+                if (!seen.insert(more[i].id).second)
+                    continue;
+                kept.push_back(i);
+                bases.push_back(more[i]);
+            }
+            positions[more.size()] = static_cast<uint32_t>(bases.size());
+            for (auto i : kept)
+                bases[positions[i]].end = positions[more[i].end];
+        }
+        bases.front().end = static_cast<uint32_t>(bases.size());
+        return result;
+    }
+
+    size_t BaseLinearization::heap_bytes() const
+    {
+        size_t result = ifc::heap_bytes(classes_);
+        for (auto const & slot : classes_)
+        {
+            if (const auto linearization = slot.load(std::memory_order_acquire))
+                result += sizeof(Linearization) + ifc::heap_bytes(linearization->bases);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,63 @@
+#include "reflifc/index/ChartParameterIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Chart.h>
+#include <ifc/Declaration.h>
+
+namespace reflifc
+{
+    ChartParameterIndex::ChartParameterIndex(ifc::File const& file)
+    {
+        // Explicit specializations have charts without parameters, possibly in a file without `decl.parameter`.
+        auto parameters = file.has_partition(ifc::ParameterDeclaration::PartitionName)
+            ? file.parameters() : ifc::Partition<ifc::ParameterDeclaration, ifc::DeclIndex>(nullptr, 0);
+        auto add_unilevel = [&](ifc::Sequence unilevel) {
+            for (auto const & parameter : parameters.slice(unilevel))
+                parameters_.push_back(&parameter);
+        };
+
+        if (file.has_partition(ifc::ChartUnilevel::PartitionName))
+        {
+            for (auto const & unilevel : file.unilevel_charts())
+            {
+                add_unilevel(unilevel);
+                unilevel_offsets_.push_back(static_cast<uint32_t>(parameters_.size()));
+            }
+        }
+
+        if (file.has_partition(ifc::ChartMultilevel::PartitionName))
+        {
+            const auto unilevels = file.unilevel_charts();
+            for (auto const & multilevel : file.multilevel_charts())
+            {
+                for (auto level : file.chart_heap().slice(multilevel))
+                    if (level.sort() == ifc::ChartSort::Unilevel)
+                        add_unilevel(unilevels[level]);
+                multilevel_offsets_.push_back(static_cast<uint32_t>(parameters_.size()));
+            }
+        }
+    }
+
+    std::span<ifc::ParameterDeclaration const* const> ChartParameterIndex::parameters(ifc::ChartIndex chart) const
+    {
+        auto subspan = [this](std::vector<uint32_t> const& offsets, uint32_t index) {
+            return std::span(parameters_).subspan(offsets[index], offsets[index + 1] - offsets[index]);
+        };
+
+        switch (chart.sort())
+        {
+        case ifc::ChartSort::Unilevel:
+            return subspan(unilevel_offsets_, chart.index);
+        case ifc::ChartSort::Multilevel:
+            return subspan(multilevel_offsets_, chart.index);
+        default:
+            return {};
+        }
+    }
+
+    size_t ChartParameterIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(unilevel_offsets_) + ifc::heap_bytes(multilevel_offsets_) + ifc::heap_bytes(parameters_);
+    }
+}
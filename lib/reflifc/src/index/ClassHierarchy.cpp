@@ -0,0 +1,258 @@
+#include "reflifc/index/ClassHierarchy.h"
+
+#include <ifc/Environment.h>
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/ModuleGraph.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace reflifc
+{
+    namespace
+    {
+        struct FileScan
+        {
+            std::vector<ifc::DeclIndex> classes;
+            // Class (by position in `classes`) and the declaration of its base.
+            std::vector<std::pair<uint32_t, ClassHierarchy::Class>> bases;
+        };
+
+        bool is_class(ifc::File const& file, ifc::ScopeDeclaration const& scope)
+        {
+            switch (get_kind(scope, file))
+            {
+            case ifc::TypeBasis::Class:
+            case ifc::TypeBasis::Struct:
+            case ifc::TypeBasis::Union:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        void add_base(ifc::File const& file, ifc::Environment* environment, uint32_t derived, ifc::TypeIndex base, FileScan& scan)
+        {
+            if (base.sort() == ifc::TypeSort::Base)
+                base = file.base_types()[base].type;
+            if (base.sort() != ifc::TypeSort::Designated)
+                return;
+
+            const auto decl = file.designated_types()[base].decl;
+            if (decl.sort() == ifc::DeclSort::Scope)
+            {
+                scan.bases.push_back({ derived, { &file, decl } });
+            }
+            else if (decl.sort() == ifc::DeclSort::Reference && environment)
+            {
+                const auto resolved = environment->resolve_reference(file, decl);
+                if (resolved.decl.sort() == ifc::DeclSort::Scope)
+                    scan.bases.push_back({ derived, { resolved.file, resolved.decl } });
+            }
+        }
+
+        FileScan scan(ifc::File const& file, ifc::Environment* environment)
+        {
+            FileScan result;
+            if (!file.has_partition(ifc::ScopeDeclaration::PartitionName))
+                return result;
+
+            uint32_t index = 0;
+            for (auto const& scope : file.scope_declarations())
+            {
+                const ifc::DeclIndex decl{ .tag = static_cast<uint32_t>(ifc::DeclSort::Scope), .index = index++ };
+                if (!is_class(file, scope))
+                    continue;
+
+                const auto position = static_cast<uint32_t>(result.classes.size());
+                result.classes.push_back(decl);
+                if (scope.base.is_null())
+                    continue;
+                if (scope.base.sort() == ifc::TypeSort::Tuple)
+                {
+                    for (auto base : file.type_heap().slice(file.tuple_types()[scope.base].seq))
+                        add_base(file, environment, position, base, result);
+                }
+                else
+                {
+                    add_base(file, environment, position, scope.base, result);
+                }
+            }
+            return result;
+        }
+
+        // Compressed adjacency from (from, to) pairs.
+        void build_adjacency(size_t size, std::vector<std::pair<uint32_t, uint32_t>> edges, std::vector<uint32_t>& offsets, std::vector<uint32_t>& targets)
+        {
+            std::ranges::sort(edges);
+            edges.erase(std::ranges::unique(edges).begin(), edges.end());
+
+            offsets.assign(size + 1, 0);
+            for (auto [from, to] : edges)
+                ++offsets[from + 1];
+            for (size_t i = 0; i != size; ++i)
+                offsets[i + 1] += offsets[i];
+
+            targets.reserve(edges.size());
+            for (auto [from, to] : edges)
+                targets.push_back(to);
+        }
+
+        std::vector<ifc::File const*> graph_files(ifc::ModuleGraph const& graph)
+        {
+            std::vector<ifc::File const*> files(graph.size());
+            for (ifc::ModuleGraph::NodeId node = 0; node != graph.size(); ++node)
+                files[node] = &graph.file(node);
+            return files;
+        }
+    }
+
+    ClassHierarchy::ClassHierarchy(std::span<ifc::File const* const> files, ifc::Environment* environment, ifc::Executor& executor)
+    {
+        std::vector<FileScan> scans(files.size());
+        executor.run(files.size(), [&](size_t i) { scans[i] = scan(*files[i], environment); });
+
+        for (size_t i = 0; i != files.size(); ++i)
+        {
+            auto & ids = ids_[files[i]];
+            if (!ids.empty())
+                continue; // the same file twice
+            if (files[i]->has_partition(ifc::ScopeDeclaration::PartitionName))
+                ids.assign(files[i]->scope_declarations().size(), NoClass);
+            for (auto decl : scans[i].classes)
+            {
+                ids[decl.index] = static_cast<ClassId>(classes_.size());
+                classes_.push_back({ files[i], decl });
+            }
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> derived_to_base;
+        for (size_t i = 0; i != files.size(); ++i)
+        {
+            for (auto const& [position, base] : scans[i].bases)
+            {
+                const auto derived = find(*files[i], scans[i].classes[position]);
+                const auto base_id = find(*base.file, base.decl);
+                if (derived && base_id)
+                    derived_to_base.emplace_back(*derived, *base_id);
+            }
+        }
+
+        std::vector<std::pair<uint32_t, uint32_t>> base_to_derived(derived_to_base.size());
+        std::ranges::transform(derived_to_base, base_to_derived.begin(), [](auto edge) { return std::pair(edge.second, edge.first); });
+        build_adjacency(classes_.size(), std::move(derived_to_base), base_offsets_, bases_);
+        build_adjacency(classes_.size(), std::move(base_to_derived), derived_offsets_, derived_);
+
+        base_closures_.resize(classes_.size());
+    }
+
+    ClassHierarchy::ClassHierarchy(ifc::ModuleGraph const& graph, ifc::Environment& environment, ifc::Executor& executor)
+        : ClassHierarchy(graph_files(graph), &environment, executor)
+    {
+    }
+
+    ClassHierarchy::~ClassHierarchy() = default;
+
+    std::optional<ClassHierarchy::ClassId> ClassHierarchy::find(ifc::File const& file, ifc::DeclIndex decl) const
+    {
+        if (decl.sort() != ifc::DeclSort::Scope)
+            return std::nullopt;
+        const auto it = ids_.find(&file);
+        if (it == ids_.end() || decl.index >= it->second.size() || it->second[decl.index] == NoClass)
+            return std::nullopt;
+        return it->second[decl.index];
+    }
+
+    bool ClassHierarchy::derives_from(ClassId derived, ClassId base) const
+    {
+        const auto closure = base_closure(derived);
+        return (closure[base / 64] >> (base % 64) & 1) != 0;
+    }
+
+    std::vector<ClassHierarchy::ClassId> ClassHierarchy::all_bases(ClassId id) const
+    {
+        std::vector<ClassId> result;
+        const auto closure = base_closure(id);
+        for (size_t word = 0; word != closure.size(); ++word)
+            for (auto bits = closure[word]; bits != 0; bits &= bits - 1)
+                result.push_back(static_cast<ClassId>(word * 64 + std::countr_zero(bits)));
+        return result;
+    }
+
+    std::vector<ClassHierarchy::ClassId> ClassHierarchy::all_derived(ClassId id) const
+    {
+        std::vector<bool> seen(classes_.size());
+        std::vector<ClassId> result;
+        std::vector<ClassId> stack{ id };
+        while (!stack.empty())
+        {
+            const auto current = stack.back();
+            stack.pop_back();
+            for (auto derived : direct_derived(current))
+                if (!seen[derived])
+                {
+                    seen[derived] = true;
+                    result.push_back(derived);
+                    stack.push_back(derived);
+                }
+        }
+        std::ranges::sort(result);
+        return result;
+    }
+
+    std::span<uint64_t const> ClassHierarchy::base_closure(ClassId root) const
+    {
+        const size_t words = (classes_.size() + 63) / 64;
+
+        std::scoped_lock lock(closures_mutex_);
+        if (!base_closures_[root])
+        {
+            // Post-order with an explicit stack, each frame walking the bases of its class: a class is gray while
+            // on the stack and black once its closure is built, which is only done when all of its bases are
+            // black. Classes with a closure from earlier calls are black already. A gray base is only reached
+            // again in (invalid) cyclic hierarchies, it is then left out of the inherited bases.
+            enum class Mark : uint8_t { White, Gray, Black };
+            std::vector<Mark> marks(classes_.size(), Mark::White);
+            const auto mark = [&](ClassId id) { return base_closures_[id] ? Mark::Black : marks[id]; };
+
+            struct Frame
+            {
+                ClassId id;
+                uint32_t next_base;
+            };
+            std::vector<Frame> stack{ { root, 0 } };
+            marks[root] = Mark::Gray;
+            while (!stack.empty())
+            {
+                auto & frame = stack.back();
+                const auto bases = direct_bases(frame.id);
+                if (frame.next_base != bases.size())
+                {
+                    const auto base = bases[frame.next_base++];
+                    if (mark(base) == Mark::White)
+                    {
+                        marks[base] = Mark::Gray;
+                        stack.push_back({ base, 0 });
+                    }
+                    continue;
+                }
+
+                const auto current = frame.id;
+                stack.pop_back();
+                auto closure = std::make_unique<uint64_t[]>(words);
+                for (auto base : bases)
+                {
+                    closure[base / 64] |= uint64_t{ 1 } << (base % 64);
+                    if (auto const& inherited = base_closures_[base])
+                        for (size_t word = 0; word != words; ++word)
+                            closure[word] |= inherited[word];
+                }
+                base_closures_[current] = std::move(closure);
+                marks[current] = Mark::Black;
+            }
+        }
+        return { base_closures_[root].get(), words };
+    }
+}
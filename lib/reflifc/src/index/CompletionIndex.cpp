@@ -0,0 +1,108 @@
+#include "reflifc/index/CompletionIndex.h"
+#include "reflifc/index/QualifiedNameList.h"
+
+#include <ifc/File.h>
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+namespace reflifc
+{
+    CompletionIndex::CompletionIndex(std::span<ifc::File const* const> files, ifc::Executor& executor)
+    {
+        entries_.resize(files.size());
+        executor.run(files.size(), [&](size_t i) {
+            // Aliasing a list owned by the file.
+            entries_[i] = { files[i], { std::shared_ptr<void>(), &files[i]->get_index<QualifiedNameList>() } };
+        });
+    }
+
+    void CompletionIndex::add(ifc::File const& file)
+    {
+        add(file, { std::shared_ptr<void>(), &file.get_index<QualifiedNameList>() });
+    }
+
+    void CompletionIndex::add(ifc::File const& file, std::shared_ptr<QualifiedNameList const> names)
+    {
+        std::unique_lock lock(mutex_);
+        if (std::ranges::find(entries_, &file, &Entry::file) == entries_.end())
+            entries_.push_back({ &file, std::move(names) });
+    }
+
+    void CompletionIndex::replace(ifc::File const& old_file, ifc::File const& new_file)
+    {
+        // Built before taking the lock, so that searches go on meanwhile.
+        std::shared_ptr<QualifiedNameList const> names(std::shared_ptr<void>(), &new_file.get_index<QualifiedNameList>());
+        std::unique_lock lock(mutex_);
+        const auto entry = std::ranges::find(entries_, &old_file, &Entry::file);
+        if (entry != entries_.end())
+            *entry = { &new_file, std::move(names) };
+        else
+            entries_.push_back({ &new_file, std::move(names) });
+    }
+
+    void CompletionIndex::remove(ifc::File const& file)
+    {
+        std::unique_lock lock(mutex_);
+        std::erase_if(entries_, [&](Entry const & entry) { return entry.file == &file; });
+    }
+
+    size_t CompletionIndex::file_count() const
+    {
+        std::shared_lock lock(mutex_);
+        return entries_.size();
+    }
+
+    void CompletionIndex::complete(std::string_view prefix, size_t limit, std::vector<Completion> & out) const
+    {
+        if (prefix.starts_with("::"))
+            prefix.remove_prefix(2);
+        search(prefix, std::string_view::npos, limit, out);
+    }
+
+    void CompletionIndex::complete_members(std::string_view scope, std::string_view prefix, size_t limit, std::vector<Completion> & out) const
+    {
+        if (scope.starts_with("::"))
+            scope.remove_prefix(2);
+        std::string qualified;
+        if (!scope.empty())
+        {
+            qualified = scope;
+            qualified += "::";
+        }
+        const auto members_from = qualified.size();
+        qualified += prefix;
+        search(qualified, members_from, limit, out);
+    }
+
+    void CompletionIndex::search(std::string_view prefix, size_t members_from, size_t limit, std::vector<Completion> & out) const
+    {
+        const auto first_out = out.size();
+        std::shared_lock lock(mutex_);
+        for (auto const & [file, names] : entries_)
+        {
+            // Each file contributes at most `limit` names, the smallest ones.
+            auto [i, last] = names->prefix_range(prefix);
+            for (size_t found = 0; i != last && found != limit; )
+            {
+                const auto name = names->name(i);
+                const auto nested = members_from == std::string_view::npos ? std::string_view::npos : name.find("::", members_from);
+                if (nested != std::string_view::npos)
+                {
+                    // Past the members of the member.
+                    i = names->prefix_range(name.substr(0, nested + 2)).second;
+                    continue;
+                }
+                out.push_back({ name, file, names->decl(i) });
+                ++found;
+                ++i;
+            }
+        }
+
+        const auto completions = out.begin() + static_cast<std::ptrdiff_t>(first_out);
+        std::stable_sort(completions, out.end(), [](Completion const & a, Completion const & b) { return a.qualified_name < b.qualified_name; });
+        if (static_cast<size_t>(out.end() - completions) > limit)
+            out.erase(completions + static_cast<std::ptrdiff_t>(limit), out.end());
+    }
+}
@@ -0,0 +1,626 @@
+#include "reflifc/index/ConceptChecker.h"
+
+#include "reflifc/Chart.h"
+#include "reflifc/Declaration.h"
+#include "reflifc/Expression.h"
+#include "reflifc/Name.h"
+#include "reflifc/Syntax.h"
+#include "reflifc/TupleView.h"
+#include "reflifc/decl/ClassOrStruct.h"
+#include "reflifc/decl/ScopeDeclaration.h"
+#include "reflifc/index/AliasResolution.h"
+#include "reflifc/index/ConstantEvaluator.h"
+#include "reflifc/index/ConstraintIndex.h"
+#include "reflifc/syntax/TypeTraitIntrinsic.h"
+
+#include <ifc/Environment.h>
+#include <ifc/Expression.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/SyntaxTree.h>
+#include <ifc/Type.h>
+
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Concept-ids and type compositions nested deeper than that are Unknown.
+        constexpr unsigned MaxDepth = 64;
+
+        Satisfaction decided(bool value)
+        {
+            return value ? Satisfaction::Satisfied : Satisfaction::Unsatisfied;
+        }
+
+        Satisfaction negate(Satisfaction value)
+        {
+            switch (value)
+            {
+            case Satisfaction::Satisfied:   return Satisfaction::Unsatisfied;
+            case Satisfaction::Unsatisfied: return Satisfaction::Satisfied;
+            default:                        return Satisfaction::Unknown;
+            }
+        }
+
+        // Of a conjunction (`decisive` Unsatisfied) or a disjunction (`decisive` Satisfied): an operand of the
+        // decisive value decides it, whatever the others are.
+        struct Combination
+        {
+            Satisfaction decisive;
+            Satisfaction result = negate(decisive);
+
+            // Whether the combination is decided.
+            bool add(Satisfaction operand)
+            {
+                if (operand == decisive)
+                    result = decisive;
+                else if (operand == Satisfaction::Unknown)
+                    result = Satisfaction::Unknown;
+                return result == decisive;
+            }
+        };
+
+        // Concept-ids name the concept through a declaration or an unqualified-id resolved to one.
+        std::optional<ifc::DeclIndex> named_declaration(ifc::File const& file, ifc::ExprIndex expr)
+        {
+            for (unsigned depth = 0; depth != MaxDepth; ++depth)
+            {
+                switch (expr.sort())
+                {
+                case ifc::ExprSort::NamedDecl:
+                    return file.decl_expressions()[expr].resolution;
+                case ifc::ExprSort::UnqualifiedId:
+                    expr = file.unqualified_id_expressions()[expr].resolution;
+                    break;
+                default:
+                    return std::nullopt;
+                }
+            }
+            return std::nullopt;
+        }
+
+        bool is_std_same_as(Concept concept_)
+        {
+            if (std::string_view(concept_.name()) != "same_as")
+                return false;
+            const auto home = concept_.home_scope();
+            return home.is_scope() && home.as_scope().is_namespace() && is_identifier(home.as_scope().name(), "std");
+        }
+    }
+
+    size_t ConceptChecker::ArgumentListHash::operator()(ArgumentList const& list) const noexcept
+    {
+        auto result = std::hash<uint32_t>{}(static_cast<uint32_t>(list.level));
+        for (auto const & argument : list.arguments)
+            result = hash_combine(result, argument.type, argument.bindings);
+        return result;
+    }
+
+    size_t ConceptChecker::AtomKeyHash::operator()(AtomKey const& key) const noexcept
+    {
+        return hash_combine(hash_handle(key.file, key.atom), key.bindings);
+    }
+
+    ConceptChecker::ConceptChecker(ifc::Environment* environment)
+        : environment_(environment)
+    {
+    }
+
+    Satisfaction ConceptChecker::check(Concept concept_, std::span<Type const> arguments) const
+    {
+        std::scoped_lock lock(mutex_);
+        std::vector<Argument> canonical_arguments;
+        canonical_arguments.reserve(arguments.size());
+        for (auto type : arguments)
+            canonical_arguments.push_back(canonical({ type, Unbound }));
+        return check_concept(concept_, canonical_arguments, 0);
+    }
+
+    size_t ConceptChecker::size() const
+    {
+        std::scoped_lock lock(mutex_);
+        return atoms_.size();
+    }
+
+    size_t ConceptChecker::heap_bytes() const
+    {
+        std::scoped_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(list_ids_) + ifc::heap_bytes(lists_) + ifc::heap_bytes(atoms_);
+        for (auto list : lists_)
+            result += ifc::heap_bytes(list->arguments);
+        return result;
+    }
+
+    uint32_t ConceptChecker::intern(ArgumentList list) const
+    {
+        const auto [position, inserted] = list_ids_.emplace(std::move(list), static_cast<uint32_t>(lists_.size()));
+        if (inserted)
+            lists_.push_back(&position->first);
+        return position->second;
+    }
+
+    ConceptChecker::Argument ConceptChecker::canonical(Argument argument) const
+    {
+        if (!argument.type)
+            return argument;
+
+        auto const & file = *argument.type.containing_file();
+        argument.type = Type(&file, file.get_index<AliasResolution>().underlying(file, argument.type.index()));
+        switch (argument.type.sort())
+        {
+        case ifc::TypeSort::Fundamental:
+            argument.bindings = Unbound;
+            return argument;
+        case ifc::TypeSort::Designated:
+        {
+            const auto decl = file.designated_types()[argument.type.index()].decl;
+            if (decl.sort() != ifc::DeclSort::Parameter)
+            {
+                argument.bindings = Unbound;
+                return argument;
+            }
+            if (argument.bindings == Unbound)
+                return argument;
+
+            // Arguments of a list are canonical already. Parameters of other levels stay as they are.
+            auto const & parameter = file.parameters()[decl];
+            auto const & list = *lists_[argument.bindings];
+            const auto position = static_cast<size_t>(parameter.position);
+            if (parameter.level != list.level || position == 0 || position > list.arguments.size())
+                return argument;
+            return list.arguments[position - 1];
+        }
+        default:
+            return argument;
+        }
+    }
+
+    std::optional<ConceptChecker::Argument> ConceptChecker::type_argument(ifc::File const& file, ifc::ExprIndex expr, uint32_t bindings) const
+    {
+        if (expr.sort() != ifc::ExprSort::Type)
+            return std::nullopt;
+        return canonical({ Type(&file, file.type_expressions()[expr].denotation), bindings });
+    }
+
+    std::optional<ConceptChecker::Argument> ConceptChecker::type_argument(ifc::File const& file, ifc::SyntaxIndex syntax, uint32_t bindings) const
+    {
+        // Only type-ids made of a type specifier without declarators and qualifiers, like `T` or `S`.
+        ifc::TypeIndex type{};
+        switch (syntax.sort())
+        {
+        case ifc::SyntaxSort::TypeTemplateArgument:
+            return type_argument(file, file.type_template_argument_syntax_trees()[syntax].argument, bindings);
+        case ifc::SyntaxSort::TypeId:
+        {
+            auto const & type_id = file.typeid_syntax_trees()[syntax];
+            if (!type_id.abstract_declarator.is_null())
+                return std::nullopt;
+            return type_argument(file, type_id.type_specifier, bindings);
+        }
+        case ifc::SyntaxSort::TypeSpecifierSeq:
+        {
+            auto const & specifiers = file.type_specifier_seq_syntax_trees()[syntax];
+            if (specifiers.qualifiers != ifc::Qualifiers::None)
+                return std::nullopt;
+            type = specifiers.type;
+            break;
+        }
+        case ifc::SyntaxSort::SimpleTypeSpecifier:
+            type = file.simple_type_specifiers()[syntax].type;
+            break;
+        default:
+            return std::nullopt;
+        }
+        if (type.is_null())
+            return std::nullopt;
+        return canonical({ Type(&file, type), bindings });
+    }
+
+    ConceptChecker::Resolved ConceptChecker::resolve(ifc::File const& file, ifc::DeclIndex decl) const
+    {
+        if (decl.sort() != ifc::DeclSort::Reference)
+            return { &file, decl };
+        if (!environment_)
+            return {};
+
+        try
+        {
+            const auto resolved = environment_->resolve_reference(file, decl);
+            return { resolved.file, resolved.decl };
+        }
+        catch (std::out_of_range const&)
+        {
+            // Its module is not in the environment.
+            return {};
+        }
+    }
+
+    ConceptChecker::Resolved ConceptChecker::designation(Argument argument) const
+    {
+        auto const & file = *argument.type.containing_file();
+        const auto decl = file.designated_types()[argument.type.index()].decl;
+        if (decl.sort() == ifc::DeclSort::Parameter)
+            return {};
+        const auto resolved = resolve(file, decl);
+        if (!resolved.file || (resolved.decl.sort() != ifc::DeclSort::Scope && resolved.decl.sort() != ifc::DeclSort::Enumeration))
+            return {};
+        return resolved;
+    }
+
+    std::optional<ConceptChecker::TypeKind> ConceptChecker::kind(Argument argument) const
+    {
+        for (unsigned depth = 0; argument.type && depth != MaxDepth; ++depth)
+        {
+            auto const & file = *argument.type.containing_file();
+            switch (argument.type.sort())
+            {
+            case ifc::TypeSort::Fundamental:
+            case ifc::TypeSort::Pointer:
+            case ifc::TypeSort::PointerToMember:
+            case ifc::TypeSort::LvalueReference:
+            case ifc::TypeSort::RvalueReference:
+            case ifc::TypeSort::Function:
+            case ifc::TypeSort::Method:
+            case ifc::TypeSort::Array:
+                return TypeKind::Other;
+            case ifc::TypeSort::Qualified:
+                argument = canonical({ Type(&file, file.qualified_types()[argument.type.index()].unqualified), argument.bindings });
+                break;
+            case ifc::TypeSort::Designated:
+            {
+                const auto resolved = designation(argument);
+                if (!resolved.file)
+                    return std::nullopt;
+                if (resolved.decl.sort() == ifc::DeclSort::Enumeration)
+                    return TypeKind::Enumeration;
+                switch (get_kind(resolved.file->scope_declarations()[resolved.decl], *resolved.file))
+                {
+                case ifc::TypeBasis::Class:
+                case ifc::TypeBasis::Struct: return TypeKind::Class;
+                case ifc::TypeBasis::Union:  return TypeKind::Union;
+                default:                     return std::nullopt;
+                }
+            }
+            default:
+                return std::nullopt;
+            }
+        }
+        return std::nullopt;
+    }
+
+    Satisfaction ConceptChecker::check_concept(Concept concept_, std::vector<Argument> const& arguments, unsigned depth) const
+    {
+        if (depth > MaxDepth)
+            return Satisfaction::Unknown;
+
+        // The parameters of the concept are the innermost level of its chart.
+        std::optional<ifc::ParameterLevel> level;
+        size_t count = 0;
+        for (auto parameter : concept_.chart().parameters())
+        {
+            if (level != parameter.level())
+                count = 0;
+            level = parameter.level();
+            ++count;
+        }
+        if (!level || count != arguments.size())
+            return Satisfaction::Unknown;
+
+        // Defined through implementation details that are not decidable here.
+        if (is_std_same_as(concept_) && arguments.size() == 2)
+            return same_type(arguments[0], arguments[1], 0);
+
+        const auto definition = concept_.definition();
+        if (!definition)
+            return Satisfaction::Unknown;
+        auto const & file = *definition.containing_file();
+        auto const & normalized = file.get_index<ConstraintIndex>().normalized(file, definition.index());
+        const auto bindings = intern({ *level, arguments });
+        return evaluate(file, normalized, 0, bindings, depth);
+    }
+
+    Satisfaction ConceptChecker::evaluate(ifc::File const& file, NormalizedConstraint const& constraint, uint32_t node, uint32_t bindings, unsigned depth) const
+    {
+        if (constraint.nodes.empty())
+            return Satisfaction::Unknown;
+
+        auto const & current = constraint.nodes[node];
+        if (current.kind == NormalizedConstraint::Kind::Atomic)
+            return atom(file, current.atom, bindings, depth);
+
+        Combination combination{ current.kind == NormalizedConstraint::Kind::Conjunction ? Satisfaction::Unsatisfied : Satisfaction::Satisfied };
+        for (uint32_t operand = current.first; operand != current.first + current.count; ++operand)
+        {
+            if (combination.add(evaluate(file, constraint, operand, bindings, depth)))
+                break;
+        }
+        return combination.result;
+    }
+
+    Satisfaction ConceptChecker::atom(ifc::File const& file, ifc::ExprIndex expr, uint32_t bindings, unsigned depth) const
+    {
+        const AtomKey key{ &file, expr, bindings };
+        if (auto found = atoms_.find(key); found != atoms_.end())
+            return found->second;
+        const auto result = compute(file, expr, bindings, depth);
+        atoms_.emplace(key, result);
+        return result;
+    }
+
+    Satisfaction ConceptChecker::compute(ifc::File const& file, ifc::ExprIndex expr, uint32_t bindings, unsigned depth) const
+    {
+        if (depth > MaxDepth)
+            return Satisfaction::Unknown;
+
+        switch (expr.sort())
+        {
+        case ifc::ExprSort::Monad:
+        {
+            auto const & monad = file.monad_expressions()[expr];
+            switch (monad.op)
+            {
+            case ifc::MonadicOperator::Paren:
+                return compute(file, monad.argument, bindings, depth + 1);
+            case ifc::MonadicOperator::Not:
+                return negate(compute(file, monad.argument, bindings, depth + 1));
+            case ifc::MonadicOperator::MsvcIsClass:
+            case ifc::MonadicOperator::MsvcIsUnion:
+            case ifc::MonadicOperator::MsvcIsEnum:
+                return unary_trait(monad.op, type_argument(file, monad.argument, bindings));
+            default:
+                break;
+            }
+            break;
+        }
+        case ifc::ExprSort::Dyad:
+        {
+            auto const & dyad = file.dyad_expressions()[expr];
+            switch (dyad.op)
+            {
+            case ifc::DyadicOperator::LogicAnd:
+            case ifc::DyadicOperator::LogicOr:
+            {
+                Combination combination{ dyad.op == ifc::DyadicOperator::LogicAnd ? Satisfaction::Unsatisfied : Satisfaction::Satisfied };
+                for (auto argument : dyad.arguments)
+                {
+                    if (combination.add(compute(file, argument, bindings, depth + 1)))
+                        break;
+                }
+                return combination.result;
+            }
+            case ifc::DyadicOperator::MsvcIsBaseOf:
+                return binary_trait(dyad.op, type_argument(file, dyad.arguments[0], bindings), type_argument(file, dyad.arguments[1], bindings));
+            default:
+                break;
+            }
+            break;
+        }
+        case ifc::ExprSort::TemplateId:
+            return concept_id(file, expr, bindings, depth);
+        case ifc::ExprSort::SyntaxTree:
+        {
+            const Syntax syntax(&file, file.syntax_tree_expressions()[expr].syntax);
+            if (syntax.sort() != ifc::SyntaxSort::TypeTraitIntrinsic)
+                return Satisfaction::Unknown;
+
+            const auto intrinsic = syntax.as_type_trait_intrinsic();
+            std::vector<std::optional<Argument>> arguments;
+            for (auto argument : intrinsic.arguments())
+                arguments.push_back(type_argument(file, argument.index(), bindings));
+            const auto op = intrinsic.intrinsic();
+            if (op.sort() == ifc::OperatorSort::Monadic && arguments.size() == 1)
+                return unary_trait(op.value<ifc::MonadicOperator>(), arguments[0]);
+            if (op.sort() == ifc::OperatorSort::Dyadic && arguments.size() == 2)
+                return binary_trait(op.value<ifc::DyadicOperator>(), arguments[0], arguments[1]);
+            return Satisfaction::Unknown;
+        }
+        default:
+            break;
+        }
+
+        // Expressions of parameters have no value.
+        const auto value = file.get_index<ConstantEvaluator>().evaluate(file, expr);
+        if (!value)
+            return Satisfaction::Unknown;
+        return decided(std::visit([](auto constant) { return constant != 0; }, *value));
+    }
+
+    Satisfaction ConceptChecker::concept_id(ifc::File const& file, ifc::ExprIndex template_id, uint32_t bindings, unsigned depth) const
+    {
+        auto const & id = file.template_ids()[template_id];
+        const auto decl = named_declaration(file, id.primary);
+        if (!decl)
+            return Satisfaction::Unknown;
+        const auto resolved = resolve(file, *decl);
+        if (!resolved.file || resolved.decl.sort() != ifc::DeclSort::Concept)
+            return Satisfaction::Unknown;
+
+        std::vector<Argument> arguments;
+        auto add = [&](ifc::ExprIndex expr) {
+            const auto argument = type_argument(file, expr, bindings);
+            if (argument)
+                arguments.push_back(*argument);
+            return argument.has_value();
+        };
+        if (id.arguments.sort() == ifc::ExprSort::Tuple)
+        {
+            for (auto element : file.expr_heap().slice(file.tuple_expressions()[id.arguments].seq))
+            {
+                if (!add(element))
+                    return Satisfaction::Unknown;
+            }
+        }
+        else if (!id.arguments.is_null() && !add(id.arguments))
+        {
+            return Satisfaction::Unknown;
+        }
+
+        return check_concept(Concept(resolved.file, resolved.file->concepts()[resolved.decl]), arguments, depth + 1);
+    }
+
+    Satisfaction ConceptChecker::unary_trait(ifc::MonadicOperator op, std::optional<Argument> argument) const
+    {
+        const auto type_kind = argument ? kind(*argument) : std::nullopt;
+        if (!type_kind)
+            return Satisfaction::Unknown;
+
+        switch (op)
+        {
+        case ifc::MonadicOperator::MsvcIsClass: return decided(*type_kind == TypeKind::Class);
+        case ifc::MonadicOperator::MsvcIsUnion: return decided(*type_kind == TypeKind::Union);
+        case ifc::MonadicOperator::MsvcIsEnum:  return decided(*type_kind == TypeKind::Enumeration);
+        default:                                return Satisfaction::Unknown;
+        }
+    }
+
+    Satisfaction ConceptChecker::binary_trait(ifc::DyadicOperator op, std::optional<Argument> first, std::optional<Argument> second) const
+    {
+        if (op != ifc::DyadicOperator::MsvcIsBaseOf || !first || !second)
+            return Satisfaction::Unknown;
+        return base_of(*first, *second);
+    }
+
+    Satisfaction ConceptChecker::same_type(Argument first, Argument second, unsigned depth) const
+    {
+        first = canonical(first);
+        second = canonical(second);
+        if (!first.type || !second.type || depth > MaxDepth)
+            return Satisfaction::Unknown;
+        if (first == second)
+            return Satisfaction::Satisfied;
+
+        // Sorts whose types are distinct from the types of the other sorts (aliases being followed already).
+        auto distinct_sort = [&](Argument argument) {
+            switch (argument.type.sort())
+            {
+            case ifc::TypeSort::Fundamental:
+            case ifc::TypeSort::Pointer:
+            case ifc::TypeSort::LvalueReference:
+            case ifc::TypeSort::RvalueReference:
+                return true;
+            case ifc::TypeSort::Designated:
+                return designation(argument).file != nullptr;
+            default:
+                return false;
+            }
+        };
+
+        // Qualifiers of a parameter bound to a qualified type would add up, those are left undecided.
+        auto unqualified = [&](Argument argument) -> std::optional<std::pair<ifc::Qualifiers, Argument>> {
+            if (argument.type.sort() != ifc::TypeSort::Qualified)
+                return std::pair(ifc::Qualifiers::None, argument);
+            auto const & file = *argument.type.containing_file();
+            auto const & qualified = file.qualified_types()[argument.type.index()];
+            const auto inner = canonical({ Type(&file, qualified.unqualified), argument.bindings });
+            if (!inner.type || inner.type.sort() == ifc::TypeSort::Qualified)
+                return std::nullopt;
+            return std::pair(qualified.qualifiers, inner);
+        };
+
+        const auto first_unqualified = unqualified(first);
+        const auto second_unqualified = unqualified(second);
+        if (!first_unqualified || !second_unqualified)
+            return Satisfaction::Unknown;
+        if (first.type.sort() == ifc::TypeSort::Qualified || second.type.sort() == ifc::TypeSort::Qualified)
+        {
+            const auto [first_qualifiers, first_inner] = *first_unqualified;
+            const auto [second_qualifiers, second_inner] = *second_unqualified;
+            if (first_qualifiers == second_qualifiers)
+                return same_type(first_inner, second_inner, depth + 1);
+            return distinct_sort(first_inner) && distinct_sort(second_inner) ? Satisfaction::Unsatisfied : Satisfaction::Unknown;
+        }
+
+        if (!distinct_sort(first) || !distinct_sort(second))
+            return Satisfaction::Unknown;
+        if (first.type.sort() != second.type.sort())
+            return Satisfaction::Unsatisfied;
+
+        auto const & first_file = *first.type.containing_file();
+        auto const & second_file = *second.type.containing_file();
+        switch (first.type.sort())
+        {
+        case ifc::TypeSort::Fundamental:
+        {
+            auto const & a = first_file.fundamental_types()[first.type.index()];
+            auto const & b = second_file.fundamental_types()[second.type.index()];
+            return decided(a.basis == b.basis && a.precision == b.precision && a.sign == b.sign);
+        }
+        case ifc::TypeSort::Designated:
+        {
+            const auto a = designation(first);
+            const auto b = designation(second);
+            return decided(a.file == b.file && a.decl == b.decl);
+        }
+        case ifc::TypeSort::Pointer:
+            return same_type({ Type(&first_file, first_file.pointer_types()[first.type.index()].pointee), first.bindings },
+                             { Type(&second_file, second_file.pointer_types()[second.type.index()].pointee), second.bindings }, depth + 1);
+        case ifc::TypeSort::LvalueReference:
+            return same_type({ Type(&first_file, first_file.lvalue_references()[first.type.index()].referee), first.bindings },
+                             { Type(&second_file, second_file.lvalue_references()[second.type.index()].referee), second.bindings }, depth + 1);
+        case ifc::TypeSort::RvalueReference:
+            return same_type({ Type(&first_file, first_file.rvalue_references()[first.type.index()].referee), first.bindings },
+                             { Type(&second_file, second_file.rvalue_references()[second.type.index()].referee), second.bindings }, depth + 1);
+        default:
+            return Satisfaction::Unknown;
+        }
+    }
+
+    Satisfaction ConceptChecker::base_of(Argument base, Argument derived) const
+    {
+        const auto base_kind = kind(base);
+        const auto derived_kind = kind(derived);
+        // Only classes have bases and are bases, unions being neither.
+        if ((base_kind && base_kind != TypeKind::Class) || (derived_kind && derived_kind != TypeKind::Class))
+            return Satisfaction::Unsatisfied;
+        if (!base_kind || !derived_kind)
+            return Satisfaction::Unknown;
+
+        // Both designate classes, possibly through qualifiers.
+        auto strip = [&](Argument argument) {
+            while (argument.type.sort() == ifc::TypeSort::Qualified)
+            {
+                auto const & file = *argument.type.containing_file();
+                argument = canonical({ Type(&file, file.qualified_types()[argument.type.index()].unqualified), argument.bindings });
+            }
+            return designation(argument);
+        };
+        const auto target = strip(canonical(base));
+        std::vector<Resolved> pending{ strip(canonical(derived)) };
+        std::set<std::pair<ifc::File const*, ifc::DeclIndex>> visited;
+        bool incomplete = false;
+        while (!pending.empty())
+        {
+            const auto current = pending.back();
+            pending.pop_back();
+            if (current.file == target.file && current.decl == target.decl)
+                return Satisfaction::Satisfied;
+            if (!visited.emplace(current.file, current.decl).second)
+                continue;
+
+            const ClassOrStruct class_(current.file, current.file->scope_declarations()[current.decl]);
+            if (!class_.is_complete())
+            {
+                incomplete = true;
+                continue;
+            }
+            for (auto base_type : class_.bases())
+            {
+                const auto base_class = canonical({ base_type.type, Unbound });
+                if (base_class.type.sort() != ifc::TypeSort::Designated || !designation(base_class).file
+                    || designation(base_class).decl.sort() != ifc::DeclSort::Scope)
+                {
+                    // Dependent bases and specializations, which may be the class.
+                    incomplete = true;
+                    continue;
+                }
+                pending.push_back(designation(base_class));
+            }
+        }
+        return incomplete ? Satisfaction::Unknown : Satisfaction::Unsatisfied;
+    }
+}
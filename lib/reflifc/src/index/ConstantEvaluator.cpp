@@ -0,0 +1,415 @@
+#include "reflifc/index/ConstantEvaluator.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Expression.h>
+#include <ifc/Literal.h>
+#include <ifc/Operator.h>
+#include <ifc/Type.h>
+
+#include <limits>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Deeper expressions are left unevaluated rather than overflowing the stack.
+        constexpr unsigned MaxDepth = 1024;
+
+        std::optional<ifc::FundamentalType> fundamental_type(ifc::File const& file, ifc::TypeIndex type)
+        {
+            while (!type.is_null())
+            {
+                switch (type.sort())
+                {
+                case ifc::TypeSort::Fundamental:
+                    return file.fundamental_types()[type];
+                case ifc::TypeSort::Qualified:
+                    type = file.qualified_types()[type].unqualified;
+                    break;
+                default:
+                    return std::nullopt;
+                }
+            }
+            return std::nullopt;
+        }
+
+        // Width of the integral types as laid out by MSVC.
+        unsigned bit_width(ifc::FundamentalType type)
+        {
+            switch (type.basis)
+            {
+            case ifc::TypeBasis::Bool:
+                return 1;
+            case ifc::TypeBasis::Char:
+                return type.precision == ifc::TypePrecision::Bit16 ? 16 : type.precision == ifc::TypePrecision::Bit32 ? 32 : 8;
+            case ifc::TypeBasis::Wchar_t:
+                return 16;
+            default:
+                break;
+            }
+
+            switch (type.precision)
+            {
+            case ifc::TypePrecision::Bit8:  return 8;
+            case ifc::TypePrecision::Short:
+            case ifc::TypePrecision::Bit16: return 16;
+            case ifc::TypePrecision::Bit64: return 64;
+            default:                        return 32;
+            }
+        }
+
+        template<typename T>
+        T as(Constant value)
+        {
+            return std::visit([](auto v) { return static_cast<T>(v); }, value);
+        }
+
+        bool is_true(Constant value)
+        {
+            return std::visit([](auto v) { return v != 0; }, value);
+        }
+
+        // Conversion to the type of an expression, unchanged when it is not a fundamental type.
+        Constant convert(ifc::File const& file, Constant value, ifc::TypeIndex type)
+        {
+            const auto fundamental = fundamental_type(file, type);
+            if (!fundamental)
+                return value;
+
+            switch (fundamental->basis)
+            {
+            case ifc::TypeBasis::Float:
+            case ifc::TypeBasis::Double:
+                return as<double>(value);
+            case ifc::TypeBasis::Bool:
+                return uint64_t{ is_true(value) };
+            case ifc::TypeBasis::Char:
+            case ifc::TypeBasis::Wchar_t:
+            case ifc::TypeBasis::Int:
+                break;
+            default:
+                return value;
+            }
+
+            const auto width = bit_width(*fundamental);
+            // Through a signed integer, converting a negative double straight to an unsigned one is undefined.
+            auto bits = std::holds_alternative<double>(value) ? static_cast<uint64_t>(as<int64_t>(value)) : as<uint64_t>(value);
+            if (width < 64)
+                bits &= (uint64_t{ 1 } << width) - 1;
+
+            const bool is_unsigned = fundamental->sign == ifc::TypeSign::Unsigned
+                || fundamental->basis == ifc::TypeBasis::Wchar_t
+                || (fundamental->basis == ifc::TypeBasis::Char && fundamental->precision != ifc::TypePrecision::Default);
+            if (is_unsigned)
+                return bits;
+
+            // Sign extension.
+            if (width < 64 && (bits >> (width - 1)) != 0)
+                bits |= ~uint64_t{ 0 } << width;
+            return static_cast<int64_t>(bits);
+        }
+
+        std::optional<Constant> apply(ifc::MonadicOperator op, Constant operand)
+        {
+            switch (op)
+            {
+            case ifc::MonadicOperator::Plus:
+            case ifc::MonadicOperator::Paren:
+            case ifc::MonadicOperator::Brace:
+                return operand;
+            case ifc::MonadicOperator::Not:
+                return int64_t{ !is_true(operand) };
+            case ifc::MonadicOperator::Negate:
+                if (std::holds_alternative<double>(operand))
+                    return -std::get<double>(operand);
+                if (std::holds_alternative<uint64_t>(operand))
+                    return 0 - std::get<uint64_t>(operand);
+                return static_cast<int64_t>(0 - as<uint64_t>(operand));
+            case ifc::MonadicOperator::Complement:
+                if (std::holds_alternative<double>(operand))
+                    return std::nullopt;
+                if (std::holds_alternative<uint64_t>(operand))
+                    return ~std::get<uint64_t>(operand);
+                return ~std::get<int64_t>(operand);
+            default:
+                return std::nullopt;
+            }
+        }
+
+        template<typename T>
+        std::optional<Constant> apply(ifc::DyadicOperator op, T a, T b)
+        {
+            using ifc::DyadicOperator;
+            constexpr bool is_integral = std::is_integral_v<T>;
+            switch (op)
+            {
+            case DyadicOperator::Equal:         return int64_t{ a == b };
+            case DyadicOperator::NotEqual:      return int64_t{ a != b };
+            case DyadicOperator::Less:          return int64_t{ a < b };
+            case DyadicOperator::LessEqual:     return int64_t{ a <= b };
+            case DyadicOperator::Greater:       return int64_t{ a > b };
+            case DyadicOperator::GreaterEqual:  return int64_t{ a >= b };
+            default:
+                break;
+            }
+
+            if constexpr (is_integral)
+            {
+                // Wrapping arithmetic, the result is then converted to the type of the expression.
+                const auto ua = static_cast<uint64_t>(a);
+                const auto ub = static_cast<uint64_t>(b);
+                switch (op)
+                {
+                case DyadicOperator::Plus:      return static_cast<T>(ua + ub);
+                case DyadicOperator::Minus:     return static_cast<T>(ua - ub);
+                case DyadicOperator::Mult:      return static_cast<T>(ua * ub);
+                case DyadicOperator::Bitand:    return static_cast<T>(ua & ub);
+                case DyadicOperator::Bitor:     return static_cast<T>(ua | ub);
+                case DyadicOperator::Bitxor:    return static_cast<T>(ua ^ ub);
+                case DyadicOperator::Slash:
+                case DyadicOperator::Modulo:
+                case DyadicOperator::Remainder:
+                    if (b == 0 || (std::is_signed_v<T> && a == std::numeric_limits<T>::min() && b == static_cast<T>(-1)))
+                        return std::nullopt;
+                    return op == DyadicOperator::Slash ? a / b : a % b;
+                case DyadicOperator::Lshift:
+                    if (ub >= 64) // negative counts included
+                        return std::nullopt;
+                    return static_cast<T>(ua << ub);
+                case DyadicOperator::Rshift:
+                    if (ub >= 64)
+                        return std::nullopt;
+                    return static_cast<T>(a >> b);
+                default:
+                    return std::nullopt;
+                }
+            }
+            else
+            {
+                switch (op)
+                {
+                case DyadicOperator::Plus:      return a + b;
+                case DyadicOperator::Minus:     return a - b;
+                case DyadicOperator::Mult:      return a * b;
+                case DyadicOperator::Slash:     return a / b;
+                default:                        return std::nullopt;
+                }
+            }
+        }
+
+        std::optional<Constant> apply(ifc::DyadicOperator op, Constant a, Constant b)
+        {
+            // Usual arithmetic conversions, with every integral type widened to 64 bits.
+            if (std::holds_alternative<double>(a) || std::holds_alternative<double>(b))
+                return apply(op, as<double>(a), as<double>(b));
+            if (std::holds_alternative<uint64_t>(a) || std::holds_alternative<uint64_t>(b))
+            {
+                // Shift counts do not take part in the conversions.
+                if ((op == ifc::DyadicOperator::Lshift || op == ifc::DyadicOperator::Rshift) && std::holds_alternative<int64_t>(a))
+                    return apply(op, std::get<int64_t>(a), as<int64_t>(b));
+                return apply(op, as<uint64_t>(a), as<uint64_t>(b));
+            }
+            return apply(op, std::get<int64_t>(a), std::get<int64_t>(b));
+        }
+
+        bool is_conversion(ifc::DyadicOperator op)
+        {
+            switch (op)
+            {
+            case ifc::DyadicOperator::Promote:
+            case ifc::DyadicOperator::Demote:
+            case ifc::DyadicOperator::Coerce:
+            case ifc::DyadicOperator::Narrow:
+            case ifc::DyadicOperator::Cast:
+            case ifc::DyadicOperator::ExplicitConversion:
+            case ifc::DyadicOperator::StaticCast:
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
+    ConstantEvaluator::ConstantEvaluator(ifc::File const&)
+    {
+    }
+
+    std::optional<Constant> ConstantEvaluator::evaluate(ifc::File const& file, ifc::ExprIndex expr, ifc::CancellationToken const* cancellation) const
+    {
+        std::scoped_lock lock(mutex_);
+        cancellation_ = cancellation ? cancellation : ifc::current_cancellation();
+        return evaluate_locked(file, expr, 0);
+    }
+
+    std::optional<Constant> ConstantEvaluator::value(ifc::File const& file, ifc::DeclIndex decl, ifc::CancellationToken const* cancellation) const
+    {
+        std::scoped_lock lock(mutex_);
+        cancellation_ = cancellation ? cancellation : ifc::current_cancellation();
+        return value_locked(file, decl, 0);
+    }
+
+    ConstantEvaluator::Entry& ConstantEvaluator::slot(ifc::ExprIndex expr) const
+    {
+        auto & entries = entries_[expr.tag];
+        if (expr.index >= entries.size())
+            entries.resize(expr.index + 1);
+        return entries[expr.index];
+    }
+
+    std::optional<Constant> ConstantEvaluator::evaluate_locked(ifc::File const& file, ifc::ExprIndex expr, unsigned depth) const
+    {
+        if (expr.is_null() || depth > MaxDepth)
+            return std::nullopt;
+
+        switch (const auto entry = slot(expr); entry.state)
+        {
+        case State::Constant:
+            return entry.value;
+        case State::Evaluating: // depends on itself
+        case State::NotConstant:
+            return std::nullopt;
+        case State::Unevaluated:
+            break;
+        }
+
+        ifc::poll_cancellation(cancellation_, steps_++);
+        slot(expr).state = State::Evaluating;
+        std::optional<Constant> result;
+        try
+        {
+            result = compute(file, expr, depth + 1);
+        }
+        catch (...)
+        {
+            slot(expr).state = State::Unevaluated;
+            throw;
+        }
+        // Not a reference kept across `compute`, which may grow the entries.
+        auto & entry = slot(expr);
+        if (result)
+        {
+            entry.state = State::Constant;
+            entry.value = *result;
+        }
+        else
+        {
+            entry.state = State::NotConstant;
+        }
+        return result;
+    }
+
+    std::optional<Constant> ConstantEvaluator::value_locked(ifc::File const& file, ifc::DeclIndex decl, unsigned depth) const
+    {
+        switch (decl.sort())
+        {
+        case ifc::DeclSort::Enumerator:
+            return evaluate_locked(file, file.enumerators()[decl].initializer, depth);
+        case ifc::DeclSort::Variable:
+        {
+            auto const & variable = file.variables()[decl];
+            if ((static_cast<uint8_t>(variable.traits) & static_cast<uint8_t>(ifc::ObjectTraits::Constexpr)) == 0)
+                return std::nullopt;
+            const auto value = evaluate_locked(file, variable.initializer, depth);
+            if (!value)
+                return std::nullopt;
+            return convert(file, *value, variable.type);
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Constant> ConstantEvaluator::compute(ifc::File const& file, ifc::ExprIndex expr, unsigned depth) const
+    {
+        switch (expr.sort())
+        {
+        case ifc::ExprSort::Literal:
+        {
+            auto const & literal = file.literal_expressions()[expr];
+            switch (literal.value.sort())
+            {
+            case ifc::LiteralSort::Immediate:
+                return convert(file, uint64_t{ literal.value.index }, literal.type);
+            case ifc::LiteralSort::Integer:
+                return convert(file, file.integer_literals()[literal.value].value, literal.type);
+            case ifc::LiteralSort::FloatingPoint:
+                return convert(file, file.fp_literals()[literal.value].value(), literal.type);
+            }
+            return std::nullopt;
+        }
+        case ifc::ExprSort::NamedDecl:
+            return value_locked(file, file.decl_expressions()[expr].resolution, depth);
+        case ifc::ExprSort::Read:
+            return evaluate_locked(file, file.read_expressions()[expr].address, depth);
+        case ifc::ExprSort::Monad:
+        {
+            auto const & monad = file.monad_expressions()[expr];
+            const auto operand = evaluate_locked(file, monad.argument, depth);
+            if (!operand)
+                return std::nullopt;
+            const auto result = apply(monad.op, *operand);
+            if (!result)
+                return std::nullopt;
+            return convert(file, *result, monad.type);
+        }
+        case ifc::ExprSort::Dyad:
+        {
+            auto const & dyad = file.dyad_expressions()[expr];
+            const auto [lhs, rhs] = dyad.arguments;
+
+            if (is_conversion(dyad.op))
+            {
+                // The target type is the type of the expression, one of the operands may spell it out.
+                const auto operand = lhs.sort() == ifc::ExprSort::Type ? rhs : lhs;
+                const auto value = evaluate_locked(file, operand, depth);
+                if (!value)
+                    return std::nullopt;
+                return convert(file, *value, dyad.type);
+            }
+
+            const auto first = evaluate_locked(file, lhs, depth);
+            switch (dyad.op)
+            {
+            case ifc::DyadicOperator::LogicAnd:
+            case ifc::DyadicOperator::LogicOr:
+            {
+                if (!first)
+                    return std::nullopt;
+                const bool is_and = dyad.op == ifc::DyadicOperator::LogicAnd;
+                if (is_true(*first) != is_and)
+                    return convert(file, int64_t{ !is_and }, dyad.type);
+                const auto second = evaluate_locked(file, rhs, depth);
+                if (!second)
+                    return std::nullopt;
+                return convert(file, int64_t{ is_true(*second) }, dyad.type);
+            }
+            case ifc::DyadicOperator::Comma:
+                return evaluate_locked(file, rhs, depth);
+            default:
+                break;
+            }
+
+            const auto second = evaluate_locked(file, rhs, depth);
+            if (!first || !second)
+                return std::nullopt;
+            const auto result = apply(dyad.op, *first, *second);
+            if (!result)
+                return std::nullopt;
+            return convert(file, *result, dyad.type);
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    size_t ConstantEvaluator::heap_bytes() const
+    {
+        std::scoped_lock lock(mutex_);
+        size_t result = 0;
+        for (auto const & entries : entries_)
+            result += ifc::heap_bytes(entries);
+        return result;
+    }
+}
@@ -0,0 +1,272 @@
+#include "reflifc/index/ConstraintIndex.h"
+
+#include <ifc/Chart.h>
+#include <ifc/Declaration.h>
+#include <ifc/Expression.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Operator.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+namespace reflifc
+{
+    namespace
+    {
+        using Kind = NormalizedConstraint::Kind;
+
+        ifc::ExprIndex strip_parentheses(ifc::File const& file, ifc::ExprIndex expr)
+        {
+            while (expr.sort() == ifc::ExprSort::Monad)
+            {
+                auto const & monad = file.monad_expressions()[expr];
+                if (monad.op != ifc::MonadicOperator::Paren)
+                    break;
+                expr = monad.argument;
+            }
+            return expr;
+        }
+
+        // Conjunction or disjunction of the expression, empty for an atomic constraint.
+        std::optional<Kind> logical_kind(ifc::File const& file, ifc::ExprIndex expr)
+        {
+            if (expr.sort() != ifc::ExprSort::Dyad)
+                return std::nullopt;
+
+            switch (file.dyad_expressions()[expr].op)
+            {
+            case ifc::DyadicOperator::LogicAnd: return Kind::Conjunction;
+            case ifc::DyadicOperator::LogicOr:  return Kind::Disjunction;
+            default:                            return std::nullopt;
+            }
+        }
+
+        // Concepts an expression names, as the resolution of a declaration reference, mostly the primary of a
+        // template-id (`C<T>`). Unsorted, possibly repeated.
+        void add_named_concepts(ifc::File const& file, ifc::ExprIndex root, std::vector<ifc::DeclIndex>& out)
+        {
+            std::vector<ifc::ExprIndex> stack{ root };
+            auto push = [&](ifc::ExprIndex expr) {
+                if (!expr.is_null())
+                    stack.push_back(expr);
+            };
+
+            while (!stack.empty())
+            {
+                const auto expr = stack.back();
+                stack.pop_back();
+
+                switch (expr.sort())
+                {
+                case ifc::ExprSort::NamedDecl:
+                    if (const auto decl = file.decl_expressions()[expr].resolution; decl.sort() == ifc::DeclSort::Concept)
+                        out.push_back(decl);
+                    break;
+                case ifc::ExprSort::TemplateId:
+                {
+                    auto const & template_id = file.template_ids()[expr];
+                    push(template_id.primary);
+                    push(template_id.arguments);
+                    break;
+                }
+                case ifc::ExprSort::UnqualifiedId:
+                    push(file.unqualified_id_expressions()[expr].resolution);
+                    break;
+                case ifc::ExprSort::Monad:
+                    push(file.monad_expressions()[expr].argument);
+                    break;
+                case ifc::ExprSort::Dyad:
+                    for (auto argument : file.dyad_expressions()[expr].arguments)
+                        push(argument);
+                    break;
+                case ifc::ExprSort::Read:
+                    push(file.read_expressions()[expr].address);
+                    break;
+                case ifc::ExprSort::Path:
+                {
+                    auto const & path = file.path_expressions()[expr];
+                    push(path.scope);
+                    push(path.member);
+                    break;
+                }
+                case ifc::ExprSort::Call:
+                {
+                    auto const & call = file.call_expressions()[expr];
+                    push(call.operation);
+                    push(call.arguments);
+                    break;
+                }
+                case ifc::ExprSort::QualifiedName:
+                    push(file.qualified_name_expressions()[expr].elements);
+                    break;
+                case ifc::ExprSort::PackedTemplateArguments:
+                    push(file.packed_template_arguments()[expr].arguments);
+                    break;
+                case ifc::ExprSort::ExpressionList:
+                    push(file.expression_lists()[expr].contents);
+                    break;
+                case ifc::ExprSort::Tuple:
+                    for (auto element : file.expr_heap().slice(file.tuple_expressions()[expr].seq))
+                        push(element);
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        // Constraints of the chart, for each level of a multilevel one.
+        void add_chart_constraints(ifc::File const& file, ifc::ChartIndex chart, std::vector<ifc::ExprIndex>& out)
+        {
+            auto add_unilevel = [&](ifc::ChartIndex unilevel) {
+                if (const auto constraint = file.unilevel_charts()[unilevel].constraint; !constraint.is_null())
+                    out.push_back(constraint);
+            };
+
+            switch (chart.sort())
+            {
+            case ifc::ChartSort::Unilevel:
+                add_unilevel(chart);
+                break;
+            case ifc::ChartSort::Multilevel:
+                for (auto level : file.chart_heap().slice(file.multilevel_charts()[chart]))
+                    if (level.sort() == ifc::ChartSort::Unilevel)
+                        add_unilevel(level);
+                break;
+            default:
+                break;
+            }
+        }
+
+        NormalizedConstraint normalize(ifc::File const& file, ifc::ExprIndex constraint)
+        {
+            NormalizedConstraint result;
+            if (constraint.is_null())
+                return result;
+
+            // Breadth first, so that the operands of each node are adjacent.
+            std::vector<std::pair<uint32_t, ifc::ExprIndex>> worklist{ { 0, constraint } };
+            std::vector<ifc::ExprIndex> pending, operands;
+            result.nodes.emplace_back();
+            for (size_t next = 0; next != worklist.size(); ++next)
+            {
+                const auto [position, root] = worklist[next];
+                const auto expr = strip_parentheses(file, root);
+                const auto kind = logical_kind(file, expr);
+                if (!kind)
+                {
+                    result.nodes[position] = { Kind::Atomic, 0, 0, expr };
+                    add_named_concepts(file, expr, result.concepts);
+                    continue;
+                }
+
+                // Operands in source order, through the nested nodes of the same operator.
+                operands.clear();
+                pending.assign({ file.dyad_expressions()[expr].arguments[1], file.dyad_expressions()[expr].arguments[0] });
+                while (!pending.empty())
+                {
+                    const auto operand = strip_parentheses(file, pending.back());
+                    pending.pop_back();
+                    if (logical_kind(file, operand) == kind)
+                    {
+                        auto const & dyad = file.dyad_expressions()[operand];
+                        pending.push_back(dyad.arguments[1]);
+                        pending.push_back(dyad.arguments[0]);
+                    }
+                    else
+                    {
+                        operands.push_back(operand);
+                    }
+                }
+
+                const auto first = static_cast<uint32_t>(result.nodes.size());
+                result.nodes[position] = { *kind, first, static_cast<uint32_t>(operands.size()), {} };
+                for (uint32_t i = 0; i != operands.size(); ++i)
+                {
+                    result.nodes.emplace_back();
+                    worklist.emplace_back(first + i, operands[i]);
+                }
+            }
+
+            std::ranges::sort(result.concepts);
+            const auto [last, end] = std::ranges::unique(result.concepts);
+            result.concepts.erase(last, end);
+            return result;
+        }
+
+        template<typename T>
+        void add_constrained(ifc::File const& file, ifc::DeclSort sort, ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const,
+                             std::vector<std::pair<ifc::DeclIndex, ifc::DeclIndex>>& out)
+        {
+            if (!file.has_partition(T::PartitionName))
+                return;
+
+            std::vector<ifc::ExprIndex> constraints;
+            std::vector<ifc::DeclIndex> concepts;
+            const auto decls = (file.*partition)();
+            for (uint32_t i = 0; i != decls.size(); ++i)
+            {
+                auto const & decl = decls[ifc::DeclIndex{ static_cast<uint32_t>(sort), i }];
+                constraints.clear();
+                add_chart_constraints(file, decl.chart, constraints);
+                if constexpr (std::is_same_v<T, ifc::Concept>)
+                {
+                    if (!decl.constraint.is_null())
+                        constraints.push_back(decl.constraint);
+                }
+
+                concepts.clear();
+                for (auto constraint : constraints)
+                    add_named_concepts(file, constraint, concepts);
+                for (auto concept_decl : concepts)
+                    out.emplace_back(concept_decl, ifc::DeclIndex{ static_cast<uint32_t>(sort), i });
+            }
+        }
+    }
+
+    ConstraintIndex::ConstraintIndex(ifc::File const& file)
+        : concepts_(file.memory_resource())
+        , templates_(file.memory_resource())
+    {
+        std::vector<std::pair<ifc::DeclIndex, ifc::DeclIndex>> entries;
+        add_constrained(file, ifc::DeclSort::Template,              &ifc::File::template_declarations,   entries);
+        add_constrained(file, ifc::DeclSort::PartialSpecialization, &ifc::File::partial_specializations, entries);
+        add_constrained(file, ifc::DeclSort::Concept,               &ifc::File::concepts,                entries);
+        std::ranges::sort(entries);
+        const auto [last, end] = std::ranges::unique(entries);
+        entries.erase(last, end);
+
+        concepts_.reserve(entries.size());
+        templates_.reserve(entries.size());
+        for (auto [concept_decl, template_decl] : entries)
+        {
+            concepts_.push_back(concept_decl);
+            templates_.push_back(template_decl);
+        }
+    }
+
+    std::span<ifc::DeclIndex const> ConstraintIndex::constrained_by(ifc::DeclIndex concept_decl) const
+    {
+        const auto [first, last] = std::ranges::equal_range(concepts_, concept_decl);
+        return std::span(templates_).subspan(first - concepts_.begin(), last - first);
+    }
+
+    NormalizedConstraint const& ConstraintIndex::normalized(ifc::File const& file, ifc::ExprIndex constraint) const
+    {
+        std::scoped_lock lock(mutex_);
+        if (auto found = normalized_.find(constraint); found != normalized_.end())
+            return found->second;
+        return normalized_.emplace(constraint, normalize(file, constraint)).first->second;
+    }
+
+    size_t ConstraintIndex::heap_bytes() const
+    {
+        std::scoped_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(concepts_) + ifc::heap_bytes(templates_) + ifc::heap_bytes(normalized_);
+        for (auto const & [_, constraint] : normalized_)
+            result += ifc::heap_bytes(constraint.nodes) + ifc::heap_bytes(constraint.concepts);
+        return result;
+    }
+}
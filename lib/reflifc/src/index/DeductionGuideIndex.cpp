@@ -0,0 +1,72 @@
+#include "reflifc/index/DeductionGuideIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Name.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace reflifc
+{
+    namespace
+    {
+        template<typename T>
+        void add_guides(ifc::File const& file, ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const,
+                        std::unordered_set<ifc::DeclIndex> const& skipped, std::vector<std::pair<ifc::DeclIndex, ifc::DeclIndex>>& out)
+        {
+            if (!file.has_partition(T::PartitionName))
+                return;
+
+            const auto decls = (file.*partition)();
+            for (uint32_t i = 0; i != decls.size(); ++i)
+            {
+                const ifc::DeclIndex index{ static_cast<uint32_t>(T::Sort), i };
+                const auto name = decls[index].name;
+                if (name.sort() != ifc::NameSort::Guide || skipped.contains(index))
+                    continue;
+                out.emplace_back(file.deduction_guide_names()[name].primary_template, index);
+            }
+        }
+    }
+
+    DeductionGuideIndex::DeductionGuideIndex(ifc::File const& file)
+        : primary_templates_(file.memory_resource())
+        , guides_(file.memory_resource())
+    {
+        if (!file.has_partition(ifc::DeductionGuideName::PartitionName))
+            return;
+
+        std::vector<std::pair<ifc::DeclIndex, ifc::DeclIndex>> entries;
+        add_guides(file, &ifc::File::template_declarations, {}, entries);
+
+        // Functions parameterized by guide templates are the same guides.
+        std::unordered_set<ifc::DeclIndex> entities;
+        for (auto [primary_template, guide] : entries)
+            entities.insert(file.template_declarations()[guide].entity.decl);
+        add_guides(file, &ifc::File::functions, entities, entries);
+        std::ranges::sort(entries);
+
+        primary_templates_.reserve(entries.size());
+        guides_.reserve(entries.size());
+        for (auto [primary_template, guide] : entries)
+        {
+            primary_templates_.push_back(primary_template);
+            guides_.push_back(guide);
+        }
+    }
+
+    std::span<ifc::DeclIndex const> DeductionGuideIndex::guides(ifc::DeclIndex primary_template) const
+    {
+        const auto [first, last] = std::ranges::equal_range(primary_templates_, primary_template);
+        return std::span(guides_).subspan(first - primary_templates_.begin(), last - first);
+    }
+
+    size_t DeductionGuideIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(primary_templates_) + ifc::heap_bytes(guides_);
+    }
+}
@@ -0,0 +1,77 @@
+#include "reflifc/index/EnclosingScopeIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+
+#include <algorithm>
+
+namespace reflifc
+{
+    EnclosingScopeIndex::EnclosingScopeIndex(ifc::File const& file)
+        : intervals_(file.memory_resource())
+        , owners_(file.memory_resource())
+    {
+        const auto scopes = file.scope_descriptors();
+        intervals_.reserve(scopes.size());
+        uint32_t scope = 0;
+        for (auto const & members : scopes)
+        {
+            ++scope;
+            if (const auto count = raw_count(members.cardinality); count != 0)
+            {
+                const auto start = static_cast<uint32_t>(members.start);
+                intervals_.push_back({ start, start + static_cast<uint32_t>(count), ifc::ScopeIndex{ scope } });
+            }
+        }
+        // Usually already in order, scopes being written along with their members.
+        if (!std::ranges::is_sorted(intervals_, {}, &Interval::start))
+            std::ranges::sort(intervals_, {}, &Interval::start);
+
+        owners_.resize(scopes.size());
+        const auto own = [&](ifc::ScopeIndex scope, ifc::DeclIndex owner) {
+            const auto slot = static_cast<uint32_t>(scope) - 1;
+            if (!ifc::is_null(scope) && slot < owners_.size())
+                owners_[slot] = owner;
+        };
+        if (file.has_partition(ifc::ScopeDeclaration::PartitionName))
+        {
+            uint32_t i = 0;
+            for (auto const & declaration : file.scope_declarations())
+                own(declaration.initializer, { static_cast<uint32_t>(ifc::DeclSort::Scope), i++ });
+        }
+        // After the classes, so that the members of a class template are owned by the template.
+        if (file.has_partition(ifc::TemplateDeclaration::PartitionName))
+        {
+            uint32_t i = 0;
+            for (auto const & declaration : file.template_declarations())
+            {
+                const ifc::DeclIndex template_decl{ static_cast<uint32_t>(ifc::DeclSort::Template), i++ };
+                if (const auto entity = declaration.entity.decl; entity.sort() == ifc::DeclSort::Scope)
+                    own(file.scope_declarations()[entity].initializer, template_decl);
+            }
+        }
+    }
+
+    ifc::ScopeIndex EnclosingScopeIndex::owning_scope(ifc::Index member) const
+    {
+        const auto position = static_cast<uint32_t>(member);
+        const auto next = std::ranges::upper_bound(intervals_, position, {}, &Interval::start);
+        if (next == intervals_.begin() || position >= std::prev(next)->end)
+            return {};
+        return std::prev(next)->scope;
+    }
+
+    ifc::DeclIndex EnclosingScopeIndex::owner(ifc::ScopeIndex scope) const
+    {
+        const auto slot = static_cast<uint32_t>(scope) - 1;
+        if (ifc::is_null(scope) || slot >= owners_.size())
+            return {};
+        return owners_[slot];
+    }
+
+    size_t EnclosingScopeIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(intervals_) + ifc::heap_bytes(owners_);
+    }
+}
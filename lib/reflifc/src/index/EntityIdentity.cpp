@@ -0,0 +1,180 @@
+#include "reflifc/index/EntityIdentity.h"
+
+#include "reflifc/HashCombine.h"
+#include "reflifc/TypeRenderer.h"
+
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Scope.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace reflifc
+{
+    namespace
+    {
+        struct Identified
+        {
+            uint64_t identity;
+            // The declaration of the file and, for references, the declaration it resolves to.
+            ifc::DeclIndex decl;
+            EntityIdentity::Entity target;
+        };
+
+        class Identifier
+        {
+        public:
+            Identifier(ifc::Environment& environment, ifc::File const& file)
+                : environment_(environment)
+                , file_(file)
+            {
+            }
+
+            void collect(ifc::ScopeIndex scope, std::vector<Identified>& out)
+            {
+                if (ifc::is_null(scope))
+                    return;
+
+                for (auto const& member : ifc::get_declarations(file_, file_.scope_descriptors()[scope]))
+                {
+                    EntityIdentity::Entity target{ &file_, member.index };
+                    if (member.index.sort() == ifc::DeclSort::Reference)
+                    {
+                        try
+                        {
+                            target = environment_.resolve_reference(file_, member.index);
+                        }
+                        catch (std::out_of_range const&)
+                        {
+                            continue;
+                        }
+                    }
+
+                    const auto identifier = ifc::declaration_identifier(*target.file, target.decl);
+                    if (!identifier)
+                        continue;
+
+                    const auto prefix_size = prefix_.size();
+                    prefix_ += target.file->get_string_view(*identifier);
+                    out.push_back({ identity(target), member.index, target });
+
+                    // Members of a class template are members of its parameterized entity.
+                    auto nested = member.index;
+                    if (nested.sort() == ifc::DeclSort::Template)
+                        nested = file_.template_declarations()[nested].entity.decl;
+                    if (nested.sort() == ifc::DeclSort::Scope)
+                    {
+                        prefix_ += "::";
+                        collect(file_.scope_declarations()[nested].initializer, out);
+                    }
+
+                    prefix_.resize(prefix_size);
+                }
+            }
+
+        private:
+            // Of the qualified name in prefix_, the kind and the signature of the declaration.
+            uint64_t identity(EntityIdentity::Entity entity)
+            {
+                auto const & file = *entity.file;
+                auto decl = entity.decl;
+                size_t kind = static_cast<size_t>(decl.sort());
+                if (decl.sort() == ifc::DeclSort::Scope)
+                    kind = hash_combine(kind, static_cast<int>(get_kind(file.scope_declarations()[decl], file)));
+                else if (decl.sort() == ifc::DeclSort::Template)
+                    decl = file.template_declarations()[decl].entity.decl;
+
+                ifc::TypeIndex signature{};
+                switch (decl.sort())
+                {
+                case ifc::DeclSort::Function:    signature = file.functions()[decl].type;    break;
+                case ifc::DeclSort::Method:      signature = file.methods()[decl].type;      break;
+                case ifc::DeclSort::Constructor: signature = file.constructors()[decl].type; break;
+                default:                         break;
+                }
+
+                const auto spelling = signature.is_null() ? std::string_view() : renderer(file).spelling(signature);
+                return hash_combine(0, std::string_view(prefix_), kind, spelling);
+            }
+
+            // References resolve to declarations of other files, whose types are spelled by renderers of their own.
+            TypeRenderer& renderer(ifc::File const& file)
+            {
+                auto& renderer = renderers_[&file];
+                if (!renderer)
+                    renderer = std::make_unique<TypeRenderer>(file, &environment_);
+                return *renderer;
+            }
+
+            ifc::Environment& environment_;
+            ifc::File const& file_;
+            std::string prefix_;
+            std::unordered_map<ifc::File const*, std::unique_ptr<TypeRenderer>> renderers_;
+        };
+    }
+
+    size_t EntityIdentity::KeyHasher::operator()(Key const& key) const noexcept
+    {
+        return hash_handle(key.file, key.decl);
+    }
+
+    EntityIdentity::EntityIdentity(ifc::Environment& environment, std::span<ifc::File const* const> files, ifc::Executor& executor)
+    {
+        std::vector<std::vector<Identified>> per_file(files.size());
+        executor.run(files.size(), [&](size_t i) {
+            Identifier identifier(environment, *files[i]);
+            identifier.collect(files[i]->header().global_scope, per_file[i]);
+        });
+
+        struct Entry
+        {
+            uint64_t identity;
+            bool reference;
+            uint32_t file;
+            ifc::DeclIndex decl;
+            Entity target;
+        };
+
+        std::vector<Entry> entries;
+        for (uint32_t i = 0; i != files.size(); ++i)
+            for (auto const& identified : per_file[i])
+                entries.push_back({ identified.identity, identified.decl.sort() == ifc::DeclSort::Reference, i, identified.decl, identified.target });
+        std::ranges::sort(entries, [](Entry const& a, Entry const& b) {
+            return std::tie(a.identity, a.reference, a.file, a.decl) < std::tie(b.identity, b.reference, b.file, b.decl);
+        });
+
+        copies_.reserve(entries.size());
+        entities_.reserve(entries.size());
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            if (i == 0 || entries[i].identity != entries[i - 1].identity)
+            {
+                offsets_.push_back(static_cast<uint32_t>(copies_.size()));
+                canonical_.push_back(entries[i].target);
+            }
+            const Entity copy{ files[entries[i].file], entries[i].decl };
+            copies_.push_back(copy);
+            entities_.try_emplace(Key{ copy.file, copy.decl }, static_cast<uint32_t>(canonical_.size() - 1));
+        }
+        offsets_.push_back(static_cast<uint32_t>(copies_.size()));
+    }
+
+    EntityIdentity::Entity EntityIdentity::canonical(ifc::File const& file, ifc::DeclIndex decl) const
+    {
+        const auto found = entities_.find({ &file, decl });
+        return found == nullptr ? Entity{ &file, decl } : canonical_[*found];
+    }
+
+    std::span<EntityIdentity::Entity const> EntityIdentity::copies(ifc::File const& file, ifc::DeclIndex decl) const
+    {
+        const auto found = entities_.find({ &file, decl });
+        if (found == nullptr)
+            return {};
+        return std::span(copies_).subspan(offsets_[*found], offsets_[*found + 1] - offsets_[*found]);
+    }
+}
@@ -0,0 +1,39 @@
+#include "reflifc/index/EnumerationTable.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+
+namespace reflifc
+{
+    EnumerationTable::EnumerationTable(ifc::File const& file)
+    {
+        if (!file.has_partition(ifc::Enumerator::PartitionName))
+            return;
+
+        auto const & evaluator = file.get_index<ConstantEvaluator>();
+        const auto enumerators = file.enumerators();
+        entries_.reserve(enumerators.size());
+        uint32_t index = 0;
+        for (auto const & enumerator : enumerators)
+        {
+            const ifc::DeclIndex decl{ .tag = static_cast<uint32_t>(ifc::DeclSort::Enumerator), .index = index++ };
+            entries_.push_back({ file.get_string_view(enumerator.name), evaluator.value(file, decl) });
+        }
+    }
+
+    std::span<EnumerationTable::Entry const> EnumerationTable::enumerators(ifc::Sequence enumerators) const
+    {
+        return std::span(entries_).subspan(static_cast<size_t>(enumerators.start), raw_count(enumerators.cardinality));
+    }
+
+    std::span<EnumerationTable::Entry const> EnumerationTable::enumerators(ifc::File const& file, ifc::DeclIndex enumeration) const
+    {
+        return enumerators(file.enumerations()[enumeration].initializer);
+    }
+
+    size_t EnumerationTable::heap_bytes() const
+    {
+        return ifc::heap_bytes(entries_);
+    }
+}
@@ -0,0 +1,148 @@
+#include "reflifc/index/FlatExpressionCache.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Expression.h>
+
+#include <ranges>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Non-null child expressions, in source order.
+        void add_children(ifc::File const& file, ifc::ExprIndex expr, std::vector<ifc::ExprIndex>& out)
+        {
+            auto add = [&](ifc::ExprIndex child) {
+                if (!child.is_null())
+                    out.push_back(child);
+            };
+
+            switch (expr.sort())
+            {
+            case ifc::ExprSort::UnqualifiedId:
+                add(file.unqualified_id_expressions()[expr].resolution);
+                break;
+            case ifc::ExprSort::TemplateId:
+            {
+                auto const & template_id = file.template_ids()[expr];
+                add(template_id.primary);
+                add(template_id.arguments);
+                break;
+            }
+            case ifc::ExprSort::TemplateReference:
+                add(file.template_references()[expr].arguments);
+                break;
+            case ifc::ExprSort::Monad:
+                add(file.monad_expressions()[expr].argument);
+                break;
+            case ifc::ExprSort::Dyad:
+                for (auto argument : file.dyad_expressions()[expr].arguments)
+                    add(argument);
+                break;
+            case ifc::ExprSort::Call:
+            {
+                auto const & call = file.call_expressions()[expr];
+                add(call.operation);
+                add(call.arguments);
+                break;
+            }
+            case ifc::ExprSort::Path:
+            {
+                auto const & path = file.path_expressions()[expr];
+                add(path.scope);
+                add(path.member);
+                break;
+            }
+            case ifc::ExprSort::Read:
+                add(file.read_expressions()[expr].address);
+                break;
+            case ifc::ExprSort::QualifiedName:
+                add(file.qualified_name_expressions()[expr].elements);
+                break;
+            case ifc::ExprSort::PackedTemplateArguments:
+                add(file.packed_template_arguments()[expr].arguments);
+                break;
+            case ifc::ExprSort::ExpressionList:
+                add(file.expression_lists()[expr].contents);
+                break;
+            case ifc::ExprSort::Tuple:
+                for (auto element : file.expr_heap().slice(file.tuple_expressions()[expr].seq))
+                    add(element);
+                break;
+            case ifc::ExprSort::ProductTypeValue:
+            {
+                auto const & value = file.product_value_type_expressions()[expr];
+                add(value.members);
+                add(value.base_subobjects);
+                break;
+            }
+            case ifc::ExprSort::SubobjectValue:
+                add(file.suboject_value_expressions()[expr].value);
+                break;
+            default:
+                break;
+            }
+        }
+
+        std::vector<FlatExpressionCache::Node> flatten_tree(ifc::File const& file, ifc::ExprIndex root)
+        {
+            std::vector<FlatExpressionCache::Node> nodes;
+            if (root.is_null())
+                return nodes;
+
+            // A node is pushed twice: to push its children above it, then, once they are all emitted, to emit it.
+            struct Frame
+            {
+                ifc::ExprIndex expr;
+                uint32_t child_count;
+                bool expanded;
+            };
+            std::vector<Frame> stack{ { root, 0, false } };
+            std::vector<ifc::ExprIndex> children;
+            while (!stack.empty())
+            {
+                const auto frame = stack.back();
+                stack.pop_back();
+                if (frame.expanded)
+                {
+                    nodes.push_back({ frame.expr, frame.child_count });
+                    continue;
+                }
+
+                children.clear();
+                add_children(file, frame.expr, children);
+                stack.push_back({ frame.expr, static_cast<uint32_t>(children.size()), true });
+                for (auto child : children | std::views::reverse)
+                    stack.push_back({ child, 0, false });
+            }
+            return nodes;
+        }
+    }
+
+    ifc::ExprSort FlatExpressionCache::Node::sort() const
+    {
+        return expr.sort();
+    }
+
+    FlatExpressionCache::FlatExpressionCache(ifc::File const&)
+    {
+    }
+
+    std::span<FlatExpressionCache::Node const> FlatExpressionCache::flatten(ifc::File const& file, ifc::ExprIndex root) const
+    {
+        std::scoped_lock lock(mutex_);
+        if (auto found = trees_.find(root); found != trees_.end())
+            return found->second;
+        return trees_.emplace(root, flatten_tree(file, root)).first->second;
+    }
+
+    size_t FlatExpressionCache::heap_bytes() const
+    {
+        std::scoped_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(trees_);
+        for (auto const & [_, nodes] : trees_)
+            result += ifc::heap_bytes(nodes);
+        return result;
+    }
+}
@@ -0,0 +1,88 @@
+#include "reflifc/index/FriendshipIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Expression.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace reflifc
+{
+    namespace
+    {
+        // `friend void f();` names the function, `friend class C;` the type designating the class.
+        ifc::DeclIndex befriended_declaration(ifc::File const& file, ifc::ExprIndex entity)
+        {
+            switch (entity.sort())
+            {
+            case ifc::ExprSort::NamedDecl:
+                return file.decl_expressions()[entity].resolution;
+            case ifc::ExprSort::Type:
+            {
+                const auto type = file.type_expressions()[entity].denotation;
+                if (type.sort() != ifc::TypeSort::Designated)
+                    return {};
+                return file.designated_types()[type].decl;
+            }
+            default:
+                return {};
+            }
+        }
+    }
+
+    FriendshipIndex::FriendshipIndex(ifc::File const& file)
+        : friendships_(file.memory_resource())
+        , befriended_(file.memory_resource())
+        , offsets_(file.memory_resource())
+        , classes_(file.memory_resource())
+    {
+        std::vector<std::pair<ifc::DeclIndex, ifc::DeclIndex>> reverse;
+        for (auto const & [befriending, members] : file.friendship_traits())
+        {
+            for (auto member : file.declarations().slice(members))
+            {
+                if (member.index.sort() != ifc::DeclSort::Friend)
+                    continue;
+                const auto entity = file.friends()[member.index].entity;
+                const auto befriended = befriended_declaration(file, entity);
+                friendships_.push_back({ befriending, member.index, entity, befriended });
+                if (!befriended.is_null())
+                    reverse.emplace_back(befriended, befriending);
+            }
+        }
+
+        std::ranges::sort(reverse);
+        const auto [last, end] = std::ranges::unique(reverse);
+        reverse.erase(last, end);
+
+        classes_.reserve(reverse.size());
+        for (auto [befriended, befriending] : reverse)
+        {
+            if (befriended_.empty() || befriended_.back() != befriended)
+            {
+                befriended_.push_back(befriended);
+                offsets_.push_back(static_cast<uint32_t>(classes_.size()));
+            }
+            classes_.push_back(befriending);
+        }
+        offsets_.push_back(static_cast<uint32_t>(classes_.size()));
+    }
+
+    std::span<ifc::DeclIndex const> FriendshipIndex::befriending(ifc::DeclIndex befriended) const
+    {
+        const auto found = std::ranges::lower_bound(befriended_, befriended);
+        if (found == befriended_.end() || *found != befriended)
+            return {};
+        const auto i = found - befriended_.begin();
+        return std::span(classes_).subspan(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+    size_t FriendshipIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(friendships_) + ifc::heap_bytes(befriended_) + ifc::heap_bytes(offsets_) + ifc::heap_bytes(classes_);
+    }
+}
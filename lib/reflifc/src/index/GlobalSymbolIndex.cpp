@@ -0,0 +1,69 @@
+#include "reflifc/index/GlobalSymbolIndex.h"
+#include "reflifc/index/QualifiedNameList.h"
+
+#include <ifc/File.h>
+#include <ifc/ModuleGraph.h>
+
+#include <algorithm>
+#include <ranges>
+
+namespace reflifc
+{
+    GlobalSymbolIndex::GlobalSymbolIndex(std::span<ifc::File const* const> files, ifc::Executor& executor)
+    {
+        std::vector<QualifiedNameList const*> per_file(files.size());
+        executor.run(files.size(), [&](size_t i) {
+            per_file[i] = &files[i]->get_index<QualifiedNameList>();
+        });
+
+        struct Entry
+        {
+            std::string_view name;
+            Symbol symbol;
+        };
+
+        std::vector<Entry> entries;
+        size_t names_size = 0;
+        for (size_t i = 0; i != files.size(); ++i)
+            for (size_t j = 0; j != per_file[i]->size(); ++j)
+            {
+                entries.push_back({ per_file[i]->name(j), { files[i], per_file[i]->decl(j) } });
+                names_size += per_file[i]->name(j).size();
+            }
+        std::ranges::stable_sort(entries, {}, &Entry::name);
+
+        names_.reserve(names_size);
+        name_offsets_.reserve(entries.size() + 1);
+        symbols_.reserve(entries.size());
+        name_offsets_.push_back(0);
+        for (auto const& entry : entries)
+        {
+            names_ += entry.name;
+            name_offsets_.push_back(static_cast<uint32_t>(names_.size()));
+            symbols_.push_back(entry.symbol);
+        }
+    }
+
+    static std::vector<ifc::File const*> graph_files(ifc::ModuleGraph const& graph)
+    {
+        std::vector<ifc::File const*> files(graph.size());
+        for (ifc::ModuleGraph::NodeId node = 0; node != graph.size(); ++node)
+            files[node] = &graph.file(node);
+        return files;
+    }
+
+    GlobalSymbolIndex::GlobalSymbolIndex(ifc::ModuleGraph const& graph, ifc::Executor& executor)
+        : GlobalSymbolIndex(graph_files(graph), executor)
+    {
+    }
+
+    std::span<GlobalSymbolIndex::Symbol const> GlobalSymbolIndex::find(std::string_view qualified_name) const
+    {
+        if (qualified_name.starts_with("::"))
+            qualified_name.remove_prefix(2);
+
+        const auto indices = std::views::iota(size_t{ 0 }, symbols_.size());
+        const auto [first, last] = std::ranges::equal_range(indices, qualified_name, {}, [this](size_t i) { return name(i); });
+        return std::span(symbols_).subspan(first - indices.begin(), last - first);
+    }
+}
@@ -0,0 +1,107 @@
+#include "reflifc/index/IdentifierIndex.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace reflifc
+{
+    namespace
+    {
+        using Entry = std::pair<uint32_t, ifc::DeclIndex>;
+
+        uint32_t canonical_offset(ifc::File const& file, ifc::TextOffset identifier)
+        {
+            // Tails of other strings have no interned text of their own and keep their offset.
+            const auto first = file.find_text(file.get_string_view(identifier));
+            return static_cast<uint32_t>(first.value_or(identifier));
+        }
+
+        template<typename T>
+        void add_named(ifc::File const& file, ifc::DeclSort sort, ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const,
+                       std::vector<Entry>& out)
+        {
+            if (!file.has_partition(T::PartitionName))
+                return;
+
+            const auto count = static_cast<uint32_t>((file.*partition)().size());
+            for (uint32_t i = 0; i != count; ++i)
+            {
+                ifc::poll_cancellation(i);
+                const ifc::DeclIndex decl{ static_cast<uint32_t>(sort), i };
+                if (auto identifier = ifc::declaration_identifier(file, decl))
+                    out.emplace_back(canonical_offset(file, *identifier), decl);
+            }
+        }
+    }
+
+    IdentifierIndex::IdentifierIndex(ifc::File const& file)
+        : offsets_(file.memory_resource())
+        , decls_(file.memory_resource())
+    {
+        // The sorts ifc::declaration_identifier names.
+        std::vector<Entry> entries;
+        add_named(file, ifc::DeclSort::Enumerator,            &ifc::File::enumerators,             entries);
+        add_named(file, ifc::DeclSort::Variable,              &ifc::File::variables,               entries);
+        add_named(file, ifc::DeclSort::Parameter,             &ifc::File::parameters,              entries);
+        add_named(file, ifc::DeclSort::Field,                 &ifc::File::fields,                  entries);
+        add_named(file, ifc::DeclSort::Bitfield,              &ifc::File::bitfields,               entries);
+        add_named(file, ifc::DeclSort::Scope,                 &ifc::File::scope_declarations,      entries);
+        add_named(file, ifc::DeclSort::Enumeration,           &ifc::File::enumerations,            entries);
+        add_named(file, ifc::DeclSort::Alias,                 &ifc::File::alias_declarations,      entries);
+        add_named(file, ifc::DeclSort::Template,              &ifc::File::template_declarations,   entries);
+        add_named(file, ifc::DeclSort::PartialSpecialization, &ifc::File::partial_specializations, entries);
+        add_named(file, ifc::DeclSort::Concept,               &ifc::File::concepts,                entries);
+        add_named(file, ifc::DeclSort::Function,              &ifc::File::functions,               entries);
+        add_named(file, ifc::DeclSort::Method,                &ifc::File::methods,                 entries);
+        add_named(file, ifc::DeclSort::UsingDeclaration,      &ifc::File::using_declarations,      entries);
+        add_named(file, ifc::DeclSort::Intrinsic,             &ifc::File::intrinsic_declarations,  entries);
+        std::ranges::stable_sort(entries, {}, &Entry::first);
+
+        offsets_.reserve(entries.size());
+        decls_.reserve(entries.size());
+        for (auto [offset, decl] : entries)
+        {
+            offsets_.push_back(offset);
+            decls_.push_back(decl);
+        }
+    }
+
+    std::span<ifc::DeclIndex const> IdentifierIndex::find(ifc::File const& file, std::string_view identifier) const
+    {
+        const auto first = file.find_text(identifier);
+        if (!first)
+            return {};
+        return find(static_cast<uint32_t>(*first));
+    }
+
+    std::span<ifc::DeclIndex const> IdentifierIndex::find(ifc::File const& file, ifc::TextOffset identifier) const
+    {
+        return find(canonical_offset(file, identifier));
+    }
+
+    void IdentifierIndex::find(std::span<ifc::TextRange const> ranges, std::vector<ifc::DeclIndex>& out) const
+    {
+        for (auto range : ranges)
+        {
+            const auto first = std::ranges::lower_bound(offsets_, range.start);
+            const auto last = std::lower_bound(first, offsets_.end(), range.end);
+            out.insert(out.end(), decls_.begin() + (first - offsets_.begin()), decls_.begin() + (last - offsets_.begin()));
+        }
+    }
+
+    std::span<ifc::DeclIndex const> IdentifierIndex::find(uint32_t offset) const
+    {
+        const auto [first, last] = std::ranges::equal_range(offsets_, offset);
+        return std::span(decls_).subspan(first - offsets_.begin(), last - first);
+    }
+
+    size_t IdentifierIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(offsets_) + ifc::heap_bytes(decls_);
+    }
+}
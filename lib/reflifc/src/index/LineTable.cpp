@@ -0,0 +1,92 @@
+#include "reflifc/index/LineTable.h"
+
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Name.h>
+
+#include <optional>
+
+namespace reflifc
+{
+    namespace
+    {
+        std::optional<ifc::SourceLocation> declaration_locus(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            switch (decl.sort())
+            {
+            case ifc::DeclSort::UsingDeclaration:      return file.using_declarations()[decl].locus;
+            case ifc::DeclSort::Template:              return file.template_declarations()[decl].locus;
+            case ifc::DeclSort::PartialSpecialization: return file.partial_specializations()[decl].locus;
+            case ifc::DeclSort::Enumeration:           return file.enumerations()[decl].locus;
+            case ifc::DeclSort::Enumerator:            return file.enumerators()[decl].locus;
+            case ifc::DeclSort::Alias:                 return file.alias_declarations()[decl].locus;
+            case ifc::DeclSort::Scope:                 return file.scope_declarations()[decl].locus;
+            case ifc::DeclSort::Function:              return file.functions()[decl].locus;
+            case ifc::DeclSort::Method:                return file.methods()[decl].locus;
+            case ifc::DeclSort::Constructor:           return file.constructors()[decl].locus;
+            case ifc::DeclSort::Destructor:            return file.destructors()[decl].locus;
+            case ifc::DeclSort::Variable:              return file.variables()[decl].locus;
+            case ifc::DeclSort::Field:                 return file.fields()[decl].locus;
+            case ifc::DeclSort::Bitfield:              return file.bitfields()[decl].locus;
+            case ifc::DeclSort::Parameter:             return file.parameters()[decl].locus;
+            case ifc::DeclSort::Concept:               return file.concepts()[decl].locus;
+            case ifc::DeclSort::Intrinsic:             return file.intrinsic_declarations()[decl].locus;
+            default:                                   return std::nullopt;
+            }
+        }
+    }
+
+    LineTable::LineTable(ifc::File const& file)
+        : files_(file.memory_resource())
+        , lines_(file.memory_resource())
+    {
+        files_.push_back({});
+        if (!file.has_partition(ifc::FileAndLine::PartitionName))
+            return;
+
+        if (file.has_partition(ifc::SourceFileName::PartitionName))
+        {
+            const auto source_files = file.source_file_names();
+            files_.reserve(source_files.size() + 1);
+            for (auto const & source_file : source_files)
+                files_.push_back(file.get_string_view(source_file.path));
+        }
+
+        const auto lines = file.lines();
+        lines_.reserve(lines.size());
+        for (auto const & line : lines)
+        {
+            const auto source_file = static_cast<uint32_t>(line.file.index);
+            const bool known = !line.file.is_null() && line.file.sort() == ifc::NameSort::SourceFile
+                && size_t{ source_file } + 1 < files_.size();
+            lines_.push_back({ known ? source_file + 1 : 0u, static_cast<uint32_t>(line.line) });
+        }
+    }
+
+    Location LineTable::locate(ifc::SourceLocation locus) const
+    {
+        const auto index = static_cast<size_t>(locus.line);
+        if (index >= lines_.size())
+            return { .column = static_cast<uint32_t>(locus.column) };
+        const auto line = lines_[index];
+        return { files_[line.file], line.line, static_cast<uint32_t>(locus.column) };
+    }
+
+    uint32_t LineTable::file_position(ifc::SourceLocation locus) const
+    {
+        const auto index = static_cast<size_t>(locus.line);
+        return index < lines_.size() ? lines_[index].file : 0;
+    }
+
+    Location LineTable::locate(ifc::File const& file, ifc::DeclIndex decl) const
+    {
+        const auto locus = declaration_locus(file, decl);
+        return locus ? locate(*locus) : Location{};
+    }
+
+    size_t LineTable::heap_bytes() const
+    {
+        return ifc::heap_bytes(files_) + ifc::heap_bytes(lines_);
+    }
+}
@@ -0,0 +1,98 @@
+#include "reflifc/index/LiteralTable.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Expression.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace reflifc
+{
+    namespace
+    {
+        std::string_view prefix_of(ifc::StringSort encoding)
+        {
+            switch (encoding)
+            {
+            case ifc::StringSort::UTF8:   return "u8";
+            case ifc::StringSort::Char16: return "u";
+            case ifc::StringSort::Char32: return "U";
+            case ifc::StringSort::Wide:   return "L";
+            default:                      return "";
+            }
+        }
+    }
+
+    LiteralTable::LiteralTable(ifc::File const& file)
+        : integers_(file.memory_resource())
+        , floating_points_(file.memory_resource())
+        , strings_(file.memory_resource())
+    {
+        if (file.has_partition(ifc::IntegerLiteral::PartitionName))
+        {
+            const auto literals = file.integer_literals();
+            integers_.resize(literals.size());
+            if (literals.contiguous())
+                std::memcpy(integers_.data(), literals.data(), literals.size() * sizeof(uint64_t));
+            else
+                std::ranges::copy(literals.column(&ifc::IntegerLiteral::value), integers_.begin());
+        }
+
+        if (file.has_partition(ifc::FPLiteral::PartitionName))
+        {
+            // The doubles are 12 bytes apart.
+            const auto literals = file.fp_literals();
+            floating_points_.resize(literals.size());
+            for (size_t i = 0; i != literals.size(); ++i)
+                std::memcpy(&floating_points_[i], literals.begin()[i].raw_data, sizeof(double));
+        }
+
+        if (!file.has_partition(ifc::StringLiteral::PartitionName))
+            return;
+
+        const auto literals = file.string_literal_expressions();
+        strings_.reserve(literals.size());
+        for (auto const & literal : literals)
+        {
+            strings_.push_back({
+                .value = { file.get_string(literal.start), raw_count(literal.length) - 1 },
+                .encoding = ifc::StringSort::Ordinary,
+                .suffix = ifc::is_null(literal.suffix) ? std::string_view() : file.get_string_view(literal.suffix),
+            });
+        }
+
+        if (file.has_partition(ifc::StringExpression::PartitionName))
+        {
+            for (auto const & expression : file.string_expressions())
+            {
+                auto & string = strings_[expression.string_index.index];
+                string.encoding = expression.string_index.sort();
+            }
+        }
+        for (auto & string : strings_)
+            string.prefix = prefix_of(string.encoding);
+    }
+
+    uint64_t LiteralTable::integer(ifc::LitIndex literal) const
+    {
+        switch (literal.sort())
+        {
+        case ifc::LiteralSort::Immediate: return literal.index;
+        case ifc::LiteralSort::Integer:   return integers_[literal.index];
+        default:                          return 0;
+        }
+    }
+
+    double LiteralTable::floating_point(ifc::LitIndex literal) const
+    {
+        if (literal.sort() == ifc::LiteralSort::FloatingPoint)
+            return floating_points_[literal.index];
+        return static_cast<double>(integer(literal));
+    }
+
+    size_t LiteralTable::heap_bytes() const
+    {
+        return ifc::heap_bytes(integers_) + ifc::heap_bytes(floating_points_) + ifc::heap_bytes(strings_);
+    }
+}
@@ -0,0 +1,37 @@
+#include "reflifc/index/MacroTable.h"
+
+#include <ifc/File.h>
+#include <ifc/Macro.h>
+#include <ifc/MemoryUsage.h>
+
+namespace reflifc
+{
+    MacroTable::MacroTable(ifc::File const& file)
+        : macros_(file.memory_resource())
+    {
+        const auto add = [&]<typename T>(ifc::Partition<T, ifc::MacroIndex> (ifc::File::*partition)() const) {
+            if (!file.has_partition(T::PartitionName))
+                return;
+            uint32_t index = 0;
+            for (auto const & macro : (file.*partition)())
+                macros_.insert_or_assign(file.get_string_view(macro.name), ifc::MacroIndex{ static_cast<uint32_t>(T::Sort), index++ });
+        };
+        const auto object_like = file.has_partition(ifc::ObjectLikeMacro::PartitionName) ? file.object_like_macros().size() : 0;
+        const auto function_like = file.has_partition(ifc::FunctionLikeMacro::PartitionName) ? file.function_like_macros().size() : 0;
+        macros_.reserve(object_like + function_like);
+        add(&ifc::File::object_like_macros);
+        add(&ifc::File::function_like_macros);
+    }
+
+    std::optional<ifc::MacroIndex> MacroTable::find(std::string_view name) const
+    {
+        if (const auto found = macros_.find(name); found != macros_.end())
+            return found->second;
+        return std::nullopt;
+    }
+
+    size_t MacroTable::heap_bytes() const
+    {
+        return ifc::heap_bytes(macros_);
+    }
+}
@@ -0,0 +1,135 @@
+#include "reflifc/index/OverloadSetIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Name.h>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+
+namespace reflifc
+{
+    namespace
+    {
+        uint64_t make_key(ifc::NameSort sort, uint32_t value)
+        {
+            return static_cast<uint64_t>(sort) << 32 | value;
+        }
+
+        uint64_t operator_key(ifc::Operator op)
+        {
+            uint16_t value;
+            std::memcpy(&value, &op, sizeof(value));
+            return make_key(ifc::NameSort::Operator, value);
+        }
+
+        // Offset of the first string with the text, as the string table may store a text more than once.
+        uint64_t identifier_key(ifc::File const& file, ifc::TextOffset identifier)
+        {
+            const auto interned = file.find_text(file.get_string_view(identifier)).value_or(identifier);
+            return make_key(ifc::NameSort::Identifier, static_cast<uint32_t>(interned));
+        }
+
+        std::optional<uint64_t> name_key(ifc::File const& file, ifc::NameIndex name)
+        {
+            while (true)
+            {
+                switch (name.sort())
+                {
+                case ifc::NameSort::Identifier:
+                    return identifier_key(file, ifc::TextOffset{ name.index });
+                case ifc::NameSort::Operator:
+                    return operator_key(file.operator_names()[name].operator_);
+                case ifc::NameSort::Template:
+                    name = file.template_names()[name].name;
+                    break;
+                case ifc::NameSort::Specialization:
+                    name = file.specialization_names()[name].primary;
+                    break;
+                default:
+                    return std::nullopt;
+                }
+            }
+        }
+
+        std::optional<uint64_t> overload_key(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            switch (decl.sort())
+            {
+            case ifc::DeclSort::Function:
+                return name_key(file, file.functions()[decl].name);
+            case ifc::DeclSort::Method:
+                return name_key(file, file.methods()[decl].name);
+            case ifc::DeclSort::Template:
+            {
+                auto const & template_ = file.template_declarations()[decl];
+                const auto entity = template_.entity.decl.sort();
+                if (entity != ifc::DeclSort::Function && entity != ifc::DeclSort::Method)
+                    return std::nullopt;
+                return name_key(file, template_.name);
+            }
+            default:
+                return std::nullopt;
+            }
+        }
+    }
+
+    OverloadSetIndex::OverloadSetIndex(ifc::File const& file)
+        : scopes_(file.scope_descriptors().size(), file.memory_resource())
+    {
+    }
+
+    std::span<ifc::DeclIndex const> OverloadSetIndex::find(ifc::File const& file, ifc::ScopeIndex scope, ifc::TextOffset identifier) const
+    {
+        return find(file, scope, identifier_key(file, identifier));
+    }
+
+    std::span<ifc::DeclIndex const> OverloadSetIndex::find(ifc::File const& file, ifc::ScopeIndex scope, ifc::Operator op) const
+    {
+        return find(file, scope, operator_key(op));
+    }
+
+    std::span<ifc::DeclIndex const> OverloadSetIndex::find(ifc::File const& file, ifc::ScopeIndex scope, uint64_t key) const
+    {
+        if (ifc::is_null(scope) || static_cast<size_t>(scope) > scopes_.size())
+            return {};
+
+        auto & lazy = scopes_[static_cast<size_t>(scope) - 1];
+        std::call_once(lazy.once, [&] {
+            std::vector<std::pair<uint64_t, ifc::DeclIndex>> keyed_members;
+            for (auto member : get_declarations(file, file.scope_descriptors()[scope]))
+            {
+                if (auto member_key = overload_key(file, member.index))
+                    keyed_members.emplace_back(*member_key, member.index);
+            }
+            std::ranges::stable_sort(keyed_members, {}, &std::pair<uint64_t, ifc::DeclIndex>::first);
+
+            auto & [keys, members] = lazy.overloads;
+            keys.reserve(keyed_members.size());
+            members.reserve(keyed_members.size());
+            for (auto [member_key, member] : keyed_members)
+            {
+                keys.push_back(member_key);
+                members.push_back(member);
+            }
+            lazy.built.store(true, std::memory_order_release);
+        });
+
+        auto const & [keys, members] = lazy.overloads;
+        const auto [first, last] = std::ranges::equal_range(keys, key);
+        return std::span(members).subspan(first - keys.begin(), last - first);
+    }
+
+    size_t OverloadSetIndex::heap_bytes() const
+    {
+        size_t result = ifc::heap_bytes(scopes_);
+        for (auto const & lazy : scopes_)
+        {
+            if (lazy.built.load(std::memory_order_acquire))
+                result += ifc::heap_bytes(lazy.overloads.keys) + ifc::heap_bytes(lazy.overloads.members);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,122 @@
+#include "reflifc/index/ParentIndex.h"
+
+#include "reflifc/NameArena.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Scope.h>
+
+#include <algorithm>
+
+namespace reflifc
+{
+    namespace
+    {
+        struct Membership
+        {
+            ifc::DeclIndex member;
+            ifc::DeclIndex parent;
+        };
+
+        void collect(ifc::File const& file, ifc::ScopeIndex scope, ifc::DeclIndex parent, std::vector<Membership>& out)
+        {
+            if (ifc::is_null(scope))
+                return;
+
+            for (auto const& member : ifc::get_declarations(file, file.scope_descriptors()[scope]))
+            {
+                ifc::poll_cancellation(out.size());
+                out.push_back({ member.index, parent });
+
+                // Members of a class template are members of its parameterized entity,
+                // but their parent is the template, which is the declaration that has a name.
+                auto nested = member.index;
+                if (nested.sort() == ifc::DeclSort::Template)
+                    nested = file.template_declarations()[nested].entity.decl;
+
+                if (nested.sort() == ifc::DeclSort::Scope)
+                {
+                    collect(file, file.scope_declarations()[nested].initializer, member.index, out);
+                }
+                else if (nested.sort() == ifc::DeclSort::Enumeration)
+                {
+                    const auto enumerators = file.enumerations()[nested].initializer;
+                    for (uint32_t i = 0; i != raw_count(enumerators.cardinality); ++i)
+                        out.push_back({ { .tag = static_cast<uint32_t>(ifc::DeclSort::Enumerator), .index = static_cast<uint32_t>(enumerators.start) + i }, member.index });
+                }
+            }
+        }
+    }
+
+    ParentIndex::ParentIndex(ifc::File const& file)
+    {
+        std::vector<Membership> memberships;
+        collect(file, file.header().global_scope, {}, memberships);
+
+        std::array<uint32_t, 32> counts{};
+        for (auto [member, parent] : memberships)
+            counts[member.tag] = std::max<uint32_t>(counts[member.tag], member.index + 1);
+        for (size_t sort = 0; sort != counts.size(); ++sort)
+            offsets_[sort + 1] = offsets_[sort] + counts[sort];
+
+        parents_.resize(offsets_.back());
+        for (auto [member, parent] : memberships)
+            parents_[offsets_[member.tag] + member.index] = parent;
+    }
+
+    ifc::DeclIndex ParentIndex::parent(ifc::DeclIndex decl) const
+    {
+        const auto slot = offsets_[decl.tag] + decl.index;
+        if (slot >= offsets_[decl.tag + 1])
+            return {};
+        return parents_[slot];
+    }
+
+    template<typename Out>
+    void ParentIndex::write_qualified_name(ifc::File const& file, ifc::DeclIndex decl, Out & out) const
+    {
+        // Scopes rarely nest deeper than this, deeper ones are still handled, just with an allocation.
+        constexpr size_t InlineDepth = 16;
+        std::array<ifc::DeclIndex, InlineDepth> inline_ancestors;
+        std::vector<ifc::DeclIndex> more_ancestors;
+        size_t depth = 0;
+        for (auto ancestor = decl; !ancestor.is_null(); ancestor = parent(ancestor), ++depth)
+        {
+            if (depth < InlineDepth)
+                inline_ancestors[depth] = ancestor;
+            else
+                more_ancestors.push_back(ancestor);
+        }
+
+        for (size_t i = depth; i-- != 0;)
+        {
+            const auto ancestor = i < InlineDepth ? inline_ancestors[i] : more_ancestors[i - InlineDepth];
+            if (const auto identifier = ifc::declaration_identifier(file, ancestor))
+                out.append(file.get_string_view(*identifier));
+            else
+                out.append("(unnamed)");
+            if (i != 0)
+                out.append("::");
+        }
+    }
+
+    std::string_view ParentIndex::qualified_name(ifc::File const& file, ifc::DeclIndex decl, std::string & buffer) const
+    {
+        buffer.clear();
+        write_qualified_name(file, decl, buffer);
+        return buffer;
+    }
+
+    std::string_view ParentIndex::qualified_name(ifc::File const& file, ifc::DeclIndex decl, NameArena & arena) const
+    {
+        write_qualified_name(file, decl, arena);
+        return arena.finish();
+    }
+
+    size_t ParentIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(parents_);
+    }
+}
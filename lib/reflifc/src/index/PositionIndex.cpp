@@ -0,0 +1,175 @@
+#include "reflifc/index/PositionIndex.h"
+#include "reflifc/index/LineTable.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Scope.h>
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace reflifc
+{
+    namespace
+    {
+        struct Node
+        {
+            uint32_t group; // Source file
+            uint64_t start;
+            uint32_t pre; // Position in a preorder walk of the scopes
+            uint32_t post; // Past the preorder positions of its members
+            ifc::DeclIndex decl;
+        };
+
+        // Located declarations reachable from the global scope, with their places in the scope tree.
+        class Collector
+        {
+        public:
+            Collector(ifc::File const& file, LineTable const& lines)
+                : file_(file)
+                , lines_(lines)
+            {
+            }
+
+            void visit(ifc::ScopeIndex scope)
+            {
+                if (ifc::is_null(scope))
+                    return;
+
+                for (auto const & member : ifc::get_declarations(file_, file_.scope_descriptors()[scope]))
+                {
+                    ifc::poll_cancellation(preorder_);
+                    const auto node = enter(member.index);
+
+                    // Members of a class template are members of its parameterized entity, see ParentIndex.
+                    auto nested = member.index;
+                    if (nested.sort() == ifc::DeclSort::Template)
+                        nested = file_.template_declarations()[nested].entity.decl;
+
+                    if (nested.sort() == ifc::DeclSort::Scope)
+                    {
+                        visit(file_.scope_declarations()[nested].initializer);
+                    }
+                    else if (nested.sort() == ifc::DeclSort::Enumeration)
+                    {
+                        const auto enumerators = file_.enumerations()[nested].initializer;
+                        for (uint32_t i = 0; i != raw_count(enumerators.cardinality); ++i)
+                            leave(enter({ .tag = static_cast<uint32_t>(ifc::DeclSort::Enumerator), .index = static_cast<uint32_t>(enumerators.start) + i }));
+                    }
+                    leave(node);
+                }
+            }
+
+            std::vector<Node> nodes;
+            std::vector<std::string_view> paths; // By group
+
+        private:
+            static constexpr uint32_t Unlocated = ~uint32_t{ 0 };
+
+            uint32_t enter(ifc::DeclIndex decl)
+            {
+                const auto pre = preorder_++;
+                const auto location = lines_.locate(file_, decl);
+                if (location.file.empty())
+                    return Unlocated;
+
+                const auto [group, inserted] = groups_.try_emplace(location.file, static_cast<uint32_t>(paths.size()));
+                if (inserted)
+                    paths.push_back(location.file);
+                nodes.push_back({ group->second, uint64_t{ location.line } << 32 | location.column, pre, pre + 1, decl });
+                return static_cast<uint32_t>(nodes.size() - 1);
+            }
+
+            void leave(uint32_t node)
+            {
+                if (node != Unlocated)
+                    nodes[node].post = preorder_;
+            }
+
+            ifc::File const& file_;
+            LineTable const& lines_;
+            std::unordered_map<std::string_view, uint32_t> groups_;
+            uint32_t preorder_ = 0;
+        };
+    }
+
+    PositionIndex::PositionIndex(ifc::File const& file)
+        : files_(file.memory_resource())
+        , intervals_(file.memory_resource())
+    {
+        Collector collector(file, file.get_index<LineTable>());
+        collector.visit(file.header().global_scope);
+
+        auto & nodes = collector.nodes;
+        std::ranges::sort(nodes, {}, [](Node const & node) { return std::tuple(node.group, node.start, node.pre); });
+
+        // Intervals of a source file nest as their declarations do: the next declaration that is not a member
+        // of an open one closes it.
+        intervals_.reserve(nodes.size());
+        std::vector<uint32_t> open;
+        for (size_t i = 0; i != nodes.size(); ++i)
+        {
+            auto const & node = nodes[i];
+            if (i == 0 || nodes[i - 1].group != node.group)
+            {
+                for (auto interval : open)
+                    intervals_[interval].end = std::numeric_limits<uint64_t>::max();
+                open.clear();
+                files_[collector.paths[node.group]] = { static_cast<uint32_t>(i), static_cast<uint32_t>(i) };
+            }
+            files_[collector.paths[node.group]].second = static_cast<uint32_t>(i + 1);
+
+            while (!open.empty() && !(nodes[open.back()].pre <= node.pre && node.pre < nodes[open.back()].post))
+            {
+                intervals_[open.back()].end = node.start;
+                open.pop_back();
+            }
+            intervals_.push_back({ node.start, 0, open.empty() ? None : open.back(), node.decl });
+            open.push_back(static_cast<uint32_t>(i));
+        }
+        for (auto interval : open)
+            intervals_[interval].end = std::numeric_limits<uint64_t>::max();
+    }
+
+    uint32_t PositionIndex::find(std::string_view path, uint64_t at) const
+    {
+        const auto file = files_.find(path);
+        if (file == files_.end())
+            return None;
+
+        const auto [first, last] = file->second;
+        const auto begin = intervals_.begin() + first;
+        const auto after = std::upper_bound(begin, intervals_.begin() + last, at, [](uint64_t p, Interval const & interval) { return p < interval.start; });
+        if (after == begin)
+            return None;
+
+        // The last declaration starting at or before the position, or the innermost of those it is nested in
+        // that extends past the position.
+        auto interval = static_cast<uint32_t>(after - intervals_.begin() - 1);
+        while (interval != None && intervals_[interval].end <= at)
+            interval = intervals_[interval].parent;
+        return interval;
+    }
+
+    ifc::DeclIndex PositionIndex::innermost(std::string_view path, uint32_t line, uint32_t column) const
+    {
+        const auto interval = find(path, position(line, column));
+        return interval == None ? ifc::DeclIndex{} : intervals_[interval].decl;
+    }
+
+    std::vector<ifc::DeclIndex> PositionIndex::enclosing(std::string_view path, uint32_t line, uint32_t column) const
+    {
+        std::vector<ifc::DeclIndex> result;
+        for (auto interval = find(path, position(line, column)); interval != None; interval = intervals_[interval].parent)
+            result.push_back(intervals_[interval].decl);
+        return result;
+    }
+
+    size_t PositionIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(files_) + ifc::heap_bytes(intervals_);
+    }
+}
@@ -0,0 +1,189 @@
+#include "reflifc/index/QualifiedNameList.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Scope.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+namespace reflifc
+{
+    // Layout of a list: the header followed by the arrays of uint32_t name ends, of DeclIndex
+    // and of the characters of the names.
+    struct QualifiedNameList::Header
+    {
+        static constexpr std::array<char, 4> Magic{ 'I', 'F', 'C', 'N' };
+        static constexpr uint32_t CurrentVersion = 1;
+
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint64_t blob_size;
+        ifc::SHA256 checksum;
+        uint32_t count;
+        uint32_t names_bytes;
+        // first[c] is the position of the first name starting with a byte of at least c, first[256] the count.
+        std::array<uint32_t, 257> first;
+    };
+
+    namespace
+    {
+        struct NamedDeclaration
+        {
+            std::string name;
+            ifc::DeclIndex decl;
+        };
+
+        void collect(ifc::File const& file, ifc::ScopeIndex scope, std::string& prefix, std::vector<NamedDeclaration>& out)
+        {
+            if (ifc::is_null(scope))
+                return;
+
+            for (auto const& member : ifc::get_declarations(file, file.scope_descriptors()[scope]))
+            {
+                ifc::poll_cancellation(out.size());
+                const auto identifier = ifc::declaration_identifier(file, member.index);
+                if (!identifier)
+                    continue;
+
+                const auto prefix_size = prefix.size();
+                prefix += file.get_string_view(*identifier);
+                out.push_back({ prefix, member.index });
+
+                // Members of a class template are members of its parameterized entity.
+                auto nested = member.index;
+                if (nested.sort() == ifc::DeclSort::Template)
+                    nested = file.template_declarations()[nested].entity.decl;
+                if (nested.sort() == ifc::DeclSort::Scope)
+                {
+                    prefix += "::";
+                    collect(file, file.scope_declarations()[nested].initializer, prefix, out);
+                }
+
+                prefix.resize(prefix_size);
+            }
+        }
+
+        bool same_checksum(ifc::SHA256 const& a, ifc::SHA256 const& b)
+        {
+            return std::memcmp(a.data.data(), b.data.data(), a.data.size()) == 0;
+        }
+    }
+
+    QualifiedNameList::QualifiedNameList(ifc::File const& file)
+    {
+        std::vector<NamedDeclaration> declarations;
+        std::string prefix;
+        collect(file, file.header().global_scope, prefix, declarations);
+        std::ranges::stable_sort(declarations, {}, &NamedDeclaration::name);
+
+        Header header{ .magic = Header::Magic, .version = Header::CurrentVersion, .blob_size = file.blob().size(), .checksum = file.header().checksum };
+        header.count = static_cast<uint32_t>(declarations.size());
+        size_t names_bytes = 0;
+        for (auto const & declaration : declarations)
+            names_bytes += declaration.name.size();
+        header.names_bytes = static_cast<uint32_t>(names_bytes);
+
+        size_t position = 0;
+        for (size_t c = 0; c != 257; ++c)
+        {
+            while (position != declarations.size() && static_cast<unsigned char>(declarations[position].name.front()) < c)
+                ++position;
+            header.first[c] = static_cast<uint32_t>(position);
+        }
+        header.first[256] = header.count;
+
+        owned_.resize(sizeof(Header) + declarations.size() * (sizeof(uint32_t) + sizeof(ifc::DeclIndex)) + names_bytes);
+        auto out = owned_.data();
+        const auto write = [&out](void const* data, size_t size) {
+            std::memcpy(out, data, size);
+            out += size;
+        };
+        write(&header, sizeof(header));
+        uint32_t end = 0;
+        for (auto const & declaration : declarations)
+        {
+            end += static_cast<uint32_t>(declaration.name.size());
+            write(&end, sizeof(end));
+        }
+        for (auto const & declaration : declarations)
+            write(&declaration.decl, sizeof(declaration.decl));
+        for (auto const & declaration : declarations)
+            write(declaration.name.data(), declaration.name.size());
+
+        contents_ = owned_;
+        attach();
+    }
+
+    QualifiedNameList::QualifiedNameList(ifc::File const& file, std::span<std::byte const> contents)
+        : contents_(contents)
+    {
+        if (contents.size() < sizeof(Header) || reinterpret_cast<uintptr_t>(contents.data()) % alignof(Header) != 0)
+            throw std::runtime_error("corrupted qualified name list");
+        auto const & header = this->header();
+        if (header.magic != Header::Magic || header.version != Header::CurrentVersion)
+            throw std::runtime_error("qualified name list of another version");
+        if (header.blob_size != file.blob().size() || !same_checksum(header.checksum, file.header().checksum))
+            throw std::runtime_error("qualified name list of another file");
+        if (contents.size() != sizeof(Header) + size_t{ header.count } * (sizeof(uint32_t) + sizeof(ifc::DeclIndex)) + header.names_bytes)
+            throw std::runtime_error("corrupted qualified name list");
+        attach();
+        if (header.count != 0 && name_ends_[header.count - 1] != header.names_bytes)
+            throw std::runtime_error("corrupted qualified name list");
+    }
+
+    void QualifiedNameList::attach()
+    {
+        const auto count = header().count;
+        auto data = contents_.data() + sizeof(Header);
+        name_ends_ = reinterpret_cast<uint32_t const*>(data);
+        data += count * sizeof(uint32_t);
+        decls_ = reinterpret_cast<ifc::DeclIndex const*>(data);
+        data += count * sizeof(ifc::DeclIndex);
+        names_ = reinterpret_cast<char const*>(data);
+    }
+
+    QualifiedNameList::Header const& QualifiedNameList::header() const
+    {
+        return *reinterpret_cast<Header const*>(contents_.data());
+    }
+
+    size_t QualifiedNameList::size() const
+    {
+        return header().count;
+    }
+
+    std::string_view QualifiedNameList::name(size_t i) const
+    {
+        const auto start = i == 0 ? 0 : name_ends_[i - 1];
+        return { names_ + start, name_ends_[i] - start };
+    }
+
+    ifc::DeclIndex QualifiedNameList::decl(size_t i) const
+    {
+        return decls_[i];
+    }
+
+    std::pair<size_t, size_t> QualifiedNameList::prefix_range(std::string_view prefix) const
+    {
+        auto const & first = header().first;
+        if (prefix.empty())
+            return { 0, size() };
+
+        const auto c = static_cast<unsigned char>(prefix.front());
+        const auto names = std::views::iota(size_t{ first[c] }, size_t{ first[c + 1] });
+        const auto name_prefix = [&](size_t i) { return name(i).substr(0, prefix.size()); };
+        const auto [begin, end] = std::ranges::equal_range(names, prefix, {}, name_prefix);
+        return { *begin, *begin + (end - begin) };
+    }
+
+    size_t QualifiedNameList::heap_bytes() const
+    {
+        return ifc::heap_bytes(owned_);
+    }
+}
@@ -0,0 +1,83 @@
+#include "reflifc/index/QualifiedNameResolver.h"
+
+#include "reflifc/index/ScopeNameIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Scope.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace reflifc
+{
+    ifc::DeclIndex QualifiedNameResolver::resolve(ifc::File const& file, std::string_view qualified_name) const
+    {
+        if (qualified_name.starts_with("::"))
+            qualified_name.remove_prefix(2);
+
+        {
+            std::shared_lock lock(mutex_);
+            if (auto it = resolved_.find(qualified_name); it != resolved_.end())
+                return it->second;
+        }
+
+        // Resolving is done without the lock: prefixes are resolved (and cached) recursively.
+        const auto result = resolve_uncached(file, qualified_name);
+
+        std::unique_lock lock(mutex_);
+        resolved_.emplace(qualified_name, result);
+        return result;
+    }
+
+    ifc::DeclIndex QualifiedNameResolver::resolve_uncached(ifc::File const& file, std::string_view qualified_name) const
+    {
+        // Modules without declarations (e.g. those only re-exporting others) have no scopes.
+        if (!file.has_partition("scope.desc"))
+            return {};
+
+        auto scope = file.header().global_scope;
+        auto name = qualified_name;
+
+        if (const auto separator = qualified_name.rfind("::"); separator != std::string_view::npos)
+        {
+            auto parent = resolve(file, qualified_name.substr(0, separator));
+            // Members of a class template are members of its parameterized entity.
+            if (parent.sort() == ifc::DeclSort::Template)
+                parent = file.template_declarations()[parent].entity.decl;
+            if (parent.sort() != ifc::DeclSort::Scope)
+                return {};
+
+            scope = file.scope_declarations()[parent].initializer;
+            if (ifc::is_null(scope))
+                return {};
+
+            name = qualified_name.substr(separator + 2);
+        }
+
+        const auto identifier = file.find_text(name);
+        if (!identifier)
+            return {};
+
+        // Through using-declarations and namespace aliases, e.g. `fs::path` with `namespace fs = std::filesystem;`.
+        const auto members = file.get_index<ScopeNameIndex>().find_resolved(file, scope, *identifier);
+        if (members.empty())
+            return {};
+
+        // Prefer scopes and templates, so that the result can be used as a prefix of longer names.
+        const auto scope_member = std::ranges::find_if(members, [](ifc::DeclIndex member) {
+            return member.sort() == ifc::DeclSort::Scope || member.sort() == ifc::DeclSort::Template;
+        });
+        return scope_member != members.end() ? *scope_member : members.front();
+    }
+
+    size_t QualifiedNameResolver::heap_bytes() const
+    {
+        std::shared_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(resolved_);
+        for (auto const & [name, decl] : resolved_)
+            result += ifc::heap_bytes(name);
+        return result;
+    }
+}
@@ -0,0 +1,606 @@
+#include "reflifc/index/Reachability.h"
+#include "reflifc/SyntaxWalker.h"
+#include "reflifc/index/SpecializationIndex.h"
+#include "reflifc/index/SpecifierTable.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/Chart.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Expression.h>
+#include <ifc/Name.h>
+#include <ifc/SyntaxTree.h>
+#include <ifc/Type.h>
+#include <ifc/TypeTraversal.h>
+
+#include <bit>
+
+namespace reflifc
+{
+    class Reachability::Walker
+    {
+    public:
+        Walker(ifc::File const& file, Reachability& result)
+            : file_(file)
+            , result_(result)
+            , syntax_walker_(SyntaxSortSet::all())
+        {
+        }
+
+        void run(std::span<ifc::DeclIndex const> roots)
+        {
+            for (auto root : roots)
+                push(root);
+
+            size_t steps = 0;
+            while (!declarations_.empty() || !types_.empty() || !expressions_.empty() || !syntax_trees_.empty())
+            {
+                ifc::poll_cancellation(++steps);
+                if (!declarations_.empty())
+                {
+                    const auto decl = declarations_.back();
+                    declarations_.pop_back();
+                    expand(decl);
+                }
+                else if (!types_.empty())
+                {
+                    const auto type = types_.back();
+                    types_.pop_back();
+                    expand(type);
+                }
+                else if (!expressions_.empty())
+                {
+                    const auto expr = expressions_.back();
+                    expressions_.pop_back();
+                    expand(expr);
+                }
+                else
+                {
+                    const auto syntax = syntax_trees_.back();
+                    syntax_trees_.pop_back();
+                    expand(syntax);
+                }
+            }
+        }
+
+    private:
+        // False if the entry was already marked.
+        template<typename Index>
+        static bool mark(Bits<Index>& bits, Index index, size_t& count)
+        {
+            auto & words = bits[index.tag];
+            const size_t word = index.index / 64;
+            if (word >= words.size())
+                words.resize(word + 1);
+
+            const auto bit = uint64_t{ 1 } << (index.index % 64);
+            if (words[word] & bit)
+                return false;
+            words[word] |= bit;
+            ++count;
+            return true;
+        }
+
+        void push(ifc::DeclIndex decl)
+        {
+            if (!decl.is_null() && mark(result_.declarations_, decl, result_.declaration_count_))
+                declarations_.push_back(decl);
+        }
+
+        void push(ifc::TypeIndex type)
+        {
+            if (!type.is_null() && mark(result_.types_, type, result_.type_count_))
+                types_.push_back(type);
+        }
+
+        void push(ifc::ExprIndex expr)
+        {
+            if (!expr.is_null() && mark(result_.expressions_, expr, result_.expression_count_))
+                expressions_.push_back(expr);
+        }
+
+        void push(ifc::SyntaxIndex syntax)
+        {
+            if (!syntax.is_null() && !test(result_.syntax_trees_, syntax))
+                syntax_trees_.push_back(syntax);
+        }
+
+        // Conversion, specialization and deduction guide names reach their types, arguments and templates.
+        void push(ifc::NameIndex name)
+        {
+            while (!name.is_null())
+            {
+                switch (name.sort())
+                {
+                case ifc::NameSort::Conversion:
+                    push(file_.conversion_function_names()[name].target);
+                    return;
+                case ifc::NameSort::Template:
+                    name = file_.template_names()[name].name;
+                    break;
+                case ifc::NameSort::Specialization:
+                {
+                    auto const & specialization = file_.specialization_names()[name];
+                    push(specialization.arguments);
+                    name = specialization.primary;
+                    break;
+                }
+                case ifc::NameSort::Guide:
+                    push(file_.deduction_guide_names()[name].primary_template);
+                    return;
+                default:
+                    return;
+                }
+            }
+        }
+
+        void push(ifc::ChartIndex chart)
+        {
+            switch (chart.sort())
+            {
+            case ifc::ChartSort::Unilevel:
+            {
+                auto const & unilevel = file_.unilevel_charts()[chart];
+                for (uint32_t i = 0; i != raw_count(unilevel.cardinality); ++i)
+                    push(ifc::DeclIndex{ static_cast<uint32_t>(ifc::DeclSort::Parameter), static_cast<uint32_t>(unilevel.start) + i });
+                push(unilevel.constraint);
+                break;
+            }
+            case ifc::ChartSort::Multilevel:
+                for (auto level : file_.chart_heap().slice(file_.multilevel_charts()[chart]))
+                    push(level);
+                break;
+            default:
+                break;
+            }
+        }
+
+        void push(ifc::SpecFormIndex form)
+        {
+            auto const & specialization = file_.specialization_forms()[form];
+            push(specialization.primary);
+            push(specialization.arguments);
+        }
+
+        void expand(ifc::DeclIndex decl)
+        {
+            switch (decl.sort())
+            {
+            case ifc::DeclSort::Scope:
+            {
+                auto const & scope = file_.scope_declarations()[decl];
+                push(scope.name);
+                push(scope.type);
+                push(scope.base);
+                push(scope.home_scope);
+                push(scope.alignment);
+                if (!ifc::is_null(scope.initializer) && get_kind(scope, file_) != ifc::TypeBasis::Namespace)
+                {
+                    for (auto const & member : get_declarations(file_, file_.scope_descriptors()[scope.initializer]))
+                        push(member.index);
+                }
+                break;
+            }
+            case ifc::DeclSort::Template:
+            {
+                auto const & template_ = file_.template_declarations()[decl];
+                push(template_.name);
+                push(template_.home_scope);
+                push(template_.chart);
+                push(template_.entity.decl);
+                push(template_.type);
+                for (auto specialization : file_.get_index<SpecializationIndex>().specializations(file_, decl))
+                    push(specialization);
+                break;
+            }
+            case ifc::DeclSort::PartialSpecialization:
+            {
+                auto const & specialization = file_.partial_specializations()[decl];
+                push(specialization.name);
+                push(specialization.home_scope);
+                push(specialization.chart);
+                push(specialization.entity.decl);
+                push(specialization.form);
+                break;
+            }
+            case ifc::DeclSort::Specialization:
+            {
+                auto const & specialization = file_.specializations()[decl];
+                push(specialization.form);
+                push(specialization.decl);
+                break;
+            }
+            case ifc::DeclSort::UsingDeclaration:
+            {
+                auto const & using_ = file_.using_declarations()[decl];
+                push(using_.name);
+                push(using_.home_scope);
+                push(using_.resolution);
+                push(using_.parent);
+                break;
+            }
+            case ifc::DeclSort::Enumeration:
+            {
+                auto const & enumeration = file_.enumerations()[decl];
+                push(enumeration.type);
+                push(enumeration.base);
+                push(enumeration.home_scope);
+                push(enumeration.alignment);
+                for (uint32_t i = 0; i != raw_count(enumeration.initializer.cardinality); ++i)
+                    push(ifc::DeclIndex{ static_cast<uint32_t>(ifc::DeclSort::Enumerator), static_cast<uint32_t>(enumeration.initializer.start) + i });
+                break;
+            }
+            case ifc::DeclSort::Enumerator:
+            {
+                auto const & enumerator = file_.enumerators()[decl];
+                push(enumerator.type);
+                push(enumerator.initializer);
+                break;
+            }
+            case ifc::DeclSort::Alias:
+            {
+                auto const & alias = file_.alias_declarations()[decl];
+                push(alias.type);
+                push(alias.home_scope);
+                push(alias.aliasee);
+                break;
+            }
+            case ifc::DeclSort::Function:
+            {
+                auto const & function = file_.functions()[decl];
+                push(function.name);
+                push(function.type);
+                push(function.home_scope);
+                push(function.chart);
+                break;
+            }
+            case ifc::DeclSort::Method:
+            {
+                auto const & method = file_.methods()[decl];
+                push(method.name);
+                push(method.type);
+                push(method.home_scope);
+                push(method.chart);
+                break;
+            }
+            case ifc::DeclSort::Constructor:
+            {
+                auto const & constructor = file_.constructors()[decl];
+                push(constructor.type);
+                push(constructor.home_scope);
+                push(constructor.chart);
+                break;
+            }
+            case ifc::DeclSort::Destructor:
+                push(file_.destructors()[decl].home_scope);
+                break;
+            case ifc::DeclSort::Variable:
+            {
+                auto const & variable = file_.variables()[decl];
+                push(variable.name);
+                push(variable.type);
+                push(variable.home_scope);
+                push(variable.initializer);
+                push(variable.alignment);
+                break;
+            }
+            case ifc::DeclSort::Field:
+            {
+                auto const & field = file_.fields()[decl];
+                push(field.type);
+                push(field.home_scope);
+                push(field.initializer);
+                push(field.alignment);
+                break;
+            }
+            case ifc::DeclSort::Bitfield:
+            {
+                auto const & bitfield = file_.bitfields()[decl];
+                push(bitfield.type);
+                push(bitfield.home_scope);
+                push(bitfield.width);
+                push(bitfield.initializer);
+                break;
+            }
+            case ifc::DeclSort::Parameter:
+            {
+                auto const & parameter = file_.parameters()[decl];
+                push(parameter.type);
+                push(parameter.constraint);
+                push(parameter.initializer);
+                break;
+            }
+            case ifc::DeclSort::Friend:
+                push(file_.friends()[decl].entity);
+                break;
+            case ifc::DeclSort::Concept:
+            {
+                auto const & concept_ = file_.concepts()[decl];
+                push(concept_.home_scope);
+                push(concept_.type);
+                push(concept_.chart);
+                push(concept_.constraint);
+                break;
+            }
+            case ifc::DeclSort::Intrinsic:
+            {
+                auto const & intrinsic = file_.intrinsic_declarations()[decl];
+                push(intrinsic.type);
+                push(intrinsic.home_scope);
+                break;
+            }
+            default:
+                // References to other modules are not followed.
+                break;
+            }
+        }
+
+        void expand(ifc::TypeIndex type)
+        {
+            ifc::for_each_type_operand(file_, type, [this](ifc::TypeIndex operand) { push(operand); });
+
+            switch (type.sort())
+            {
+            case ifc::TypeSort::Designated:
+                push(file_.designated_types()[type].decl);
+                break;
+            case ifc::TypeSort::Syntactic:
+                push(file_.syntactic_types()[type].expr);
+                break;
+            case ifc::TypeSort::Array:
+                push(file_.array_types()[type].extent);
+                break;
+            case ifc::TypeSort::Forall:
+                push(file_.forall_types()[type].chart);
+                break;
+            case ifc::TypeSort::SyntaxTree:
+                push(file_.syntax_types()[type].syntax);
+                break;
+            case ifc::TypeSort::Placeholder:
+                push(file_.placeholder_types()[type].constraint);
+                break;
+            case ifc::TypeSort::Typename:
+                push(file_.typename_types()[type].path);
+                break;
+            case ifc::TypeSort::Decltype:
+                push(file_.decltype_types()[type].argument);
+                break;
+            default:
+                break;
+            }
+        }
+
+        void expand(ifc::ExprIndex expr)
+        {
+            // Pushes the type of the expression, for the sorts that have one.
+            auto typed = [this](auto const & expression) -> auto const & {
+                if constexpr (requires { expression.type; })
+                    push(expression.type);
+                return expression;
+            };
+
+            switch (expr.sort())
+            {
+            case ifc::ExprSort::Literal:
+                typed(file_.literal_expressions()[expr]);
+                break;
+            case ifc::ExprSort::Type:
+                push(typed(file_.type_expressions()[expr]).denotation);
+                break;
+            case ifc::ExprSort::NamedDecl:
+                push(typed(file_.decl_expressions()[expr]).resolution);
+                break;
+            case ifc::ExprSort::UnqualifiedId:
+            {
+                auto const & id = typed(file_.unqualified_id_expressions()[expr]);
+                push(id.name);
+                push(id.resolution);
+                break;
+            }
+            case ifc::ExprSort::TemplateId:
+            {
+                auto const & template_id = typed(file_.template_ids()[expr]);
+                push(template_id.primary);
+                push(template_id.arguments);
+                break;
+            }
+            case ifc::ExprSort::TemplateReference:
+            {
+                auto const & reference = typed(file_.template_references()[expr]);
+                push(reference.member);
+                push(reference.member_name);
+                push(reference.scope);
+                push(reference.arguments);
+                break;
+            }
+            case ifc::ExprSort::Monad:
+            {
+                auto const & monad = typed(file_.monad_expressions()[expr]);
+                push(monad.impl);
+                push(monad.argument);
+                break;
+            }
+            case ifc::ExprSort::Dyad:
+            {
+                auto const & dyad = typed(file_.dyad_expressions()[expr]);
+                push(dyad.impl);
+                for (auto argument : dyad.arguments)
+                    push(argument);
+                break;
+            }
+            case ifc::ExprSort::String:
+                typed(file_.string_expressions()[expr]);
+                break;
+            case ifc::ExprSort::Call:
+            {
+                auto const & call = typed(file_.call_expressions()[expr]);
+                push(call.operation);
+                push(call.arguments);
+                break;
+            }
+            case ifc::ExprSort::SizeofType:
+                push(typed(file_.sizeof_expressions()[expr]).operand);
+                break;
+            case ifc::ExprSort::Alignof:
+                push(typed(file_.alignof_expressions()[expr]).operand);
+                break;
+            case ifc::ExprSort::Requires:
+            {
+                auto const & requires_ = typed(file_.requires_expressions()[expr]);
+                push(requires_.parameters);
+                push(requires_.body);
+                break;
+            }
+            case ifc::ExprSort::Tuple:
+                for (auto element : file_.expr_heap().slice(typed(file_.tuple_expressions()[expr]).seq))
+                    push(element);
+                break;
+            case ifc::ExprSort::Path:
+            {
+                auto const & path = typed(file_.path_expressions()[expr]);
+                push(path.scope);
+                push(path.member);
+                break;
+            }
+            case ifc::ExprSort::Read:
+                push(typed(file_.read_expressions()[expr]).address);
+                break;
+            case ifc::ExprSort::SyntaxTree:
+                push(typed(file_.syntax_tree_expressions()[expr]).syntax);
+                break;
+            case ifc::ExprSort::ExpressionList:
+                push(typed(file_.expression_lists()[expr]).contents);
+                break;
+            case ifc::ExprSort::QualifiedName:
+                push(typed(file_.qualified_name_expressions()[expr]).elements);
+                break;
+            case ifc::ExprSort::PackedTemplateArguments:
+                push(typed(file_.packed_template_arguments()[expr]).arguments);
+                break;
+            case ifc::ExprSort::ProductTypeValue:
+            {
+                auto const & value = typed(file_.product_value_type_expressions()[expr]);
+                push(value.structure);
+                push(value.members);
+                push(value.base_subobjects);
+                break;
+            }
+            case ifc::ExprSort::SubobjectValue:
+                push(typed(file_.suboject_value_expressions()[expr]).value);
+                break;
+            default:
+                break;
+            }
+        }
+
+        // Marks the tree, and the types and expressions of its nodes. Subtrees marked before are skipped.
+        void expand(ifc::SyntaxIndex root)
+        {
+            syntax_walker_.walk(file_, root, [this](Syntax syntax) {
+                const auto node = syntax.index();
+                if (!mark(result_.syntax_trees_, node, result_.syntax_count_))
+                    return false;
+
+                switch (node.sort())
+                {
+                case ifc::SyntaxSort::SimpleTypeSpecifier:
+                {
+                    auto const & specifier = file_.simple_type_specifiers()[node];
+                    push(specifier.type);
+                    push(specifier.expr);
+                    break;
+                }
+                case ifc::SyntaxSort::DecltypeSpecifier:
+                    push(file_.decltype_specifiers()[node].argument);
+                    break;
+                case ifc::SyntaxSort::TypeSpecifierSeq:
+                    push(file_.type_specifier_seq_syntax_trees()[node].type);
+                    break;
+                case ifc::SyntaxSort::DeclSpecifierSeq:
+                    push(file_.decl_specifier_seq_syntax_trees()[node].type);
+                    break;
+                case ifc::SyntaxSort::Declarator:
+                    push(file_.declarator_syntax_trees()[node].name);
+                    break;
+                case ifc::SyntaxSort::ParameterDeclarator:
+                    push(file_.parameter_declarator_syntax_trees()[node].default_);
+                    break;
+                case ifc::SyntaxSort::Expression:
+                    push(file_.expression_syntax_trees()[node].expression);
+                    break;
+                case ifc::SyntaxSort::RequiresClause:
+                    push(file_.requires_clause_syntax_trees()[node].condition);
+                    break;
+                case ifc::SyntaxSort::SimpleRequirement:
+                    push(file_.simple_requirement_syntax_trees()[node].condition);
+                    break;
+                case ifc::SyntaxSort::TypeRequirement:
+                    push(file_.type_requirement_syntax_trees()[node].type);
+                    break;
+                case ifc::SyntaxSort::CompoundRequirement:
+                {
+                    auto const & requirement = file_.compound_requirement_syntax_trees()[node];
+                    push(requirement.condition);
+                    push(requirement.constraint);
+                    break;
+                }
+                case ifc::SyntaxSort::NestedRequirement:
+                    push(file_.nested_requirement_syntax_trees()[node].condition);
+                    break;
+                case ifc::SyntaxSort::TemplateId:
+                    push(file_.templateid_syntax_trees()[node].symbol);
+                    break;
+                default:
+                    break;
+                }
+                return true;
+            });
+        }
+
+        ifc::File const& file_;
+        Reachability& result_;
+        SyntaxWalker syntax_walker_;
+        std::vector<ifc::DeclIndex> declarations_;
+        std::vector<ifc::TypeIndex> types_;
+        std::vector<ifc::ExprIndex> expressions_;
+        std::vector<ifc::SyntaxIndex> syntax_trees_;
+    };
+
+    Reachability::Reachability(ifc::File const& file)
+        : Reachability(file, file.get_index<SpecifierTable>().select({ DeclarationFlag::Exported }))
+    {
+    }
+
+    Reachability::Reachability(ifc::File const& file, std::span<ifc::DeclIndex const> roots)
+    {
+        Walker(file, *this).run(roots);
+    }
+
+    std::vector<ifc::DeclIndex> Reachability::declarations(ifc::DeclSort sort) const
+    {
+        std::vector<ifc::DeclIndex> result;
+        const auto tag = static_cast<uint32_t>(sort);
+        auto const & words = declarations_[tag];
+        for (size_t word = 0; word != words.size(); ++word)
+        {
+            for (auto bits = words[word]; bits != 0; bits &= bits - 1)
+                result.push_back({ tag, static_cast<uint32_t>(word * 64 + std::countr_zero(bits)) });
+        }
+        return result;
+    }
+
+    size_t Reachability::heap_bytes() const
+    {
+        size_t result = 0;
+        auto add = [&result](auto const & bits) {
+            for (auto const & words : bits)
+                result += ifc::heap_bytes(words);
+        };
+        add(declarations_);
+        add(types_);
+        add(expressions_);
+        add(syntax_trees_);
+        return result;
+    }
+}
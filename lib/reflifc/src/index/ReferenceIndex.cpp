@@ -0,0 +1,271 @@
+#include "reflifc/index/ReferenceIndex.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Chart.h>
+#include <ifc/Declaration.h>
+#include <ifc/Expression.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace reflifc
+{
+    namespace
+    {
+        using Edge = std::pair<ifc::DeclIndex, ifc::DeclIndex>;
+
+        class EdgeCollector
+        {
+        public:
+            explicit EdgeCollector(ifc::File const& file)
+                : file_(file)
+            {
+            }
+
+            // Declarations the expression refers to, with an explicit stack.
+            void add(ifc::DeclIndex from, ifc::ExprIndex root)
+            {
+                push(root);
+                while (!pending_.empty())
+                {
+                    const auto expr = pending_.back();
+                    pending_.pop_back();
+
+                    switch (expr.sort())
+                    {
+                    case ifc::ExprSort::NamedDecl:
+                        refer(from, file_.decl_expressions()[expr].resolution);
+                        break;
+                    case ifc::ExprSort::UnqualifiedId:
+                        push(file_.unqualified_id_expressions()[expr].resolution);
+                        break;
+                    case ifc::ExprSort::TemplateId:
+                    {
+                        auto const & template_id = file_.template_ids()[expr];
+                        push(template_id.primary);
+                        push(template_id.arguments);
+                        break;
+                    }
+                    case ifc::ExprSort::TemplateReference:
+                    {
+                        auto const & reference = file_.template_references()[expr];
+                        refer(from, reference.member);
+                        push(reference.arguments);
+                        break;
+                    }
+                    case ifc::ExprSort::Monad:
+                    {
+                        auto const & monad = file_.monad_expressions()[expr];
+                        refer(from, monad.impl);
+                        push(monad.argument);
+                        break;
+                    }
+                    case ifc::ExprSort::Dyad:
+                    {
+                        auto const & dyad = file_.dyad_expressions()[expr];
+                        refer(from, dyad.impl);
+                        for (auto argument : dyad.arguments)
+                            push(argument);
+                        break;
+                    }
+                    case ifc::ExprSort::Call:
+                    {
+                        auto const & call = file_.call_expressions()[expr];
+                        push(call.operation);
+                        push(call.arguments);
+                        break;
+                    }
+                    case ifc::ExprSort::Path:
+                    {
+                        auto const & path = file_.path_expressions()[expr];
+                        push(path.scope);
+                        push(path.member);
+                        break;
+                    }
+                    case ifc::ExprSort::Read:
+                        push(file_.read_expressions()[expr].address);
+                        break;
+                    case ifc::ExprSort::QualifiedName:
+                        push(file_.qualified_name_expressions()[expr].elements);
+                        break;
+                    case ifc::ExprSort::PackedTemplateArguments:
+                        push(file_.packed_template_arguments()[expr].arguments);
+                        break;
+                    case ifc::ExprSort::ExpressionList:
+                        push(file_.expression_lists()[expr].contents);
+                        break;
+                    case ifc::ExprSort::Tuple:
+                        for (auto element : file_.expr_heap().slice(file_.tuple_expressions()[expr].seq))
+                            push(element);
+                        break;
+                    case ifc::ExprSort::ProductTypeValue:
+                    {
+                        auto const & value = file_.product_value_type_expressions()[expr];
+                        push(value.members);
+                        push(value.base_subobjects);
+                        break;
+                    }
+                    case ifc::ExprSort::SubobjectValue:
+                        push(file_.suboject_value_expressions()[expr].value);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+            }
+
+            // `initializer` is a member of T.
+            template<typename T>
+            void add_initializers(ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const, ifc::ExprIndex T::*initializer)
+            {
+                if (!file_.has_partition(T::PartitionName))
+                    return;
+
+                const auto declarations = (file_.*partition)();
+                for (uint32_t i = 0; i != declarations.size(); ++i)
+                {
+                    ifc::poll_cancellation(i);
+                    const ifc::DeclIndex decl{ static_cast<uint32_t>(T::Sort), i };
+                    add(decl, declarations[decl].*initializer);
+                }
+            }
+
+            // Default arguments of the parameters of the chart of each declaration, as references of the
+            // declaration. `chart` is a member of T or of its base, as for functions and methods.
+            template<typename T, typename Member>
+            void add_default_arguments(ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const, Member chart)
+            {
+                if (!file_.has_partition(T::PartitionName) || !file_.has_partition(ifc::ParameterDeclaration::PartitionName))
+                    return;
+
+                const auto declarations = (file_.*partition)();
+                for (uint32_t i = 0; i != declarations.size(); ++i)
+                {
+                    ifc::poll_cancellation(i);
+                    const ifc::DeclIndex decl{ static_cast<uint32_t>(T::Sort), i };
+                    add_chart(decl, declarations[decl].*chart);
+                }
+            }
+
+            std::vector<Edge> take()
+            {
+                std::ranges::sort(edges_);
+                const auto [last, end] = std::ranges::unique(edges_);
+                edges_.erase(last, end);
+                return std::move(edges_);
+            }
+
+        private:
+            void push(ifc::ExprIndex expr)
+            {
+                if (!expr.is_null())
+                    pending_.push_back(expr);
+            }
+
+            void refer(ifc::DeclIndex from, ifc::DeclIndex to)
+            {
+                if (!to.is_null())
+                    edges_.emplace_back(from, to);
+            }
+
+            void add_chart(ifc::DeclIndex decl, ifc::ChartIndex chart)
+            {
+                auto parameters = file_.parameters();
+                auto add_unilevel = [&](ifc::ChartIndex unilevel) {
+                    for (auto const & parameter : parameters.slice(file_.unilevel_charts()[unilevel]))
+                        add(decl, parameter.initializer);
+                };
+
+                switch (chart.sort())
+                {
+                case ifc::ChartSort::Unilevel:
+                    add_unilevel(chart);
+                    break;
+                case ifc::ChartSort::Multilevel:
+                    for (auto level : file_.chart_heap().slice(file_.multilevel_charts()[chart]))
+                        if (level.sort() == ifc::ChartSort::Unilevel)
+                            add_unilevel(level);
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            ifc::File const& file_;
+            std::vector<ifc::ExprIndex> pending_;
+            std::vector<Edge> edges_;
+        };
+    }
+
+    ReferenceIndex::Rows::Rows(std::pmr::memory_resource* memory)
+        : keys(memory)
+        , offsets(memory)
+    {
+    }
+
+    std::span<ifc::DeclIndex const> ReferenceIndex::Rows::row(std::pmr::vector<ifc::DeclIndex> const& columns, ifc::DeclIndex key) const
+    {
+        const auto found = std::ranges::lower_bound(keys, key);
+        if (found == keys.end() || *found != key)
+            return {};
+
+        const auto i = found - keys.begin();
+        return std::span(columns).subspan(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+    ReferenceIndex::ReferenceIndex(ifc::File const& file)
+        : forward_(file.memory_resource())
+        , targets_(file.memory_resource())
+        , backward_(file.memory_resource())
+        , sources_(file.memory_resource())
+    {
+        EdgeCollector collector(file);
+        collector.add_initializers(&ifc::File::variables,  &ifc::VariableDeclaration::initializer);
+        collector.add_initializers(&ifc::File::fields,     &ifc::FieldDeclaration::initializer);
+        collector.add_initializers(&ifc::File::bitfields,  &ifc::BitfieldDeclaration::initializer);
+        collector.add_initializers(&ifc::File::enumerators, &ifc::Enumerator::initializer);
+        collector.add_default_arguments(&ifc::File::functions,             &ifc::FunctionDeclaration::chart);
+        collector.add_default_arguments(&ifc::File::methods,               &ifc::MethodDeclaration::chart);
+        collector.add_default_arguments(&ifc::File::constructors,          &ifc::Constructor::chart);
+        collector.add_default_arguments(&ifc::File::template_declarations, &ifc::TemplateDeclaration::chart);
+
+        auto edges = collector.take();
+        auto fill = [](std::vector<Edge> const& sorted, Rows& rows, std::pmr::vector<ifc::DeclIndex>& columns) {
+            columns.reserve(sorted.size());
+            for (auto [key, column] : sorted)
+            {
+                if (rows.keys.empty() || rows.keys.back() != key)
+                {
+                    rows.keys.push_back(key);
+                    rows.offsets.push_back(static_cast<uint32_t>(columns.size()));
+                }
+                columns.push_back(column);
+            }
+            rows.offsets.push_back(static_cast<uint32_t>(columns.size()));
+        };
+
+        fill(edges, forward_, targets_);
+        for (auto& [from, to] : edges)
+            std::swap(from, to);
+        std::ranges::sort(edges);
+        fill(edges, backward_, sources_);
+    }
+
+    std::span<ifc::DeclIndex const> ReferenceIndex::references(ifc::DeclIndex decl) const
+    {
+        return forward_.row(targets_, decl);
+    }
+
+    std::span<ifc::DeclIndex const> ReferenceIndex::referrers(ifc::DeclIndex decl) const
+    {
+        return backward_.row(sources_, decl);
+    }
+
+    size_t ReferenceIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(forward_.keys) + ifc::heap_bytes(forward_.offsets) + ifc::heap_bytes(targets_)
+            + ifc::heap_bytes(backward_.keys) + ifc::heap_bytes(backward_.offsets) + ifc::heap_bytes(sources_);
+    }
+}
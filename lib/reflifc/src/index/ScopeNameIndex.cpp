@@ -0,0 +1,121 @@
+#include "reflifc/index/ScopeNameIndex.h"
+#include "reflifc/index/UsingResolver.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Offset of the first string with the text of the identifier: the string table may store a text more
+        // than once, so that members are grouped and found by their text rather than by where it is stored.
+        ifc::TextOffset interned(ifc::File const& file, ifc::TextOffset identifier)
+        {
+            return file.find_text(file.get_string_view(identifier)).value_or(identifier);
+        }
+
+        template<typename ScopeMembers>
+        std::span<ifc::DeclIndex const> members_named(ScopeMembers const& grouped, ifc::TextOffset identifier)
+        {
+            auto const & [identifiers, members] = grouped;
+            const auto [first, last] = std::ranges::equal_range(identifiers, identifier);
+            return std::span(members).subspan(first - identifiers.begin(), last - first);
+        }
+    }
+
+    ScopeNameIndex::ScopeNameIndex(ifc::File const& file)
+        : scopes_(file.scope_descriptors().size(), file.memory_resource())
+    {
+    }
+
+    ScopeNameIndex::LazyScopeMembers* ScopeNameIndex::grouped(ifc::File const& file, ifc::ScopeIndex scope) const
+    {
+        if (ifc::is_null(scope) || static_cast<size_t>(scope) > scopes_.size())
+            return nullptr;
+
+        auto & lazy = scopes_[static_cast<size_t>(scope) - 1];
+        std::call_once(lazy.once, [&] {
+            std::vector<std::pair<ifc::TextOffset, ifc::DeclIndex>> named_members;
+            for (auto member : get_declarations(file, file.scope_descriptors()[scope]))
+            {
+                if (auto name = declaration_identifier(file, member.index))
+                    named_members.emplace_back(interned(file, *name), member.index);
+            }
+            std::ranges::stable_sort(named_members, {}, &std::pair<ifc::TextOffset, ifc::DeclIndex>::first);
+
+            auto & [identifiers, members] = lazy.members;
+            identifiers.reserve(named_members.size());
+            members.reserve(named_members.size());
+            for (auto [name, member] : named_members)
+            {
+                identifiers.push_back(name);
+                members.push_back(member);
+                lazy.has_indirections = lazy.has_indirections || UsingResolver::is_indirection(file, member);
+            }
+            lazy.built.store(true, std::memory_order_release);
+        });
+        return &lazy;
+    }
+
+    std::span<ifc::DeclIndex const> ScopeNameIndex::find(ifc::File const& file, ifc::ScopeIndex scope, ifc::TextOffset identifier) const
+    {
+        const auto lazy = grouped(file, scope);
+        if (!lazy)
+            return {};
+        return members_named(lazy->members, interned(file, identifier));
+    }
+
+    std::span<ifc::DeclIndex const> ScopeNameIndex::find_resolved(ifc::File const& file, ifc::ScopeIndex scope, ifc::TextOffset identifier) const
+    {
+        const auto lazy = grouped(file, scope);
+        if (!lazy)
+            return {};
+        identifier = interned(file, identifier);
+        if (!lazy->has_indirections)
+            return members_named(lazy->members, identifier);
+
+        // Targets are looked up in other scopes (or this one, already grouped) by their own ScopeNameIndex::find.
+        std::call_once(lazy->resolved_once, [&] {
+            auto const & resolver = file.get_index<UsingResolver>();
+            auto const & [identifiers, members] = lazy->members;
+            auto & [resolved_identifiers, resolved_members] = lazy->resolved;
+            // Start of the targets of the current identifier, which are kept without duplicates.
+            size_t group = 0;
+            for (size_t i = 0; i != members.size(); ++i)
+            {
+                if (i == 0 || identifiers[i] != identifiers[i - 1])
+                    group = resolved_members.size();
+                const auto add = [&](ifc::DeclIndex member) {
+                    if (std::find(resolved_members.begin() + group, resolved_members.end(), member) != resolved_members.end())
+                        return;
+                    resolved_identifiers.push_back(identifiers[i]);
+                    resolved_members.push_back(member);
+                };
+                if (UsingResolver::is_indirection(file, members[i]))
+                    std::ranges::for_each(resolver.targets(file, members[i]), add);
+                else
+                    add(members[i]);
+            }
+            lazy->resolved_built.store(true, std::memory_order_release);
+        });
+        return members_named(lazy->resolved, identifier);
+    }
+
+    size_t ScopeNameIndex::heap_bytes() const
+    {
+        size_t result = ifc::heap_bytes(scopes_);
+        for (auto const & lazy : scopes_)
+        {
+            if (lazy.built.load(std::memory_order_acquire))
+                result += ifc::heap_bytes(lazy.members.identifiers) + ifc::heap_bytes(lazy.members.members);
+            if (lazy.resolved_built.load(std::memory_order_acquire))
+                result += ifc::heap_bytes(lazy.resolved.identifiers) + ifc::heap_bytes(lazy.resolved.members);
+        }
+        return result;
+    }
+}
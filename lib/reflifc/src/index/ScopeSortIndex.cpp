@@ -0,0 +1,94 @@
+#include "reflifc/index/ScopeSortIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Sorted by key, keeping the declaration order of the members with the same key.
+        template<typename Grouped>
+        void group(Grouped& group, std::vector<std::pair<uint8_t, ifc::DeclIndex>> keyed_members)
+        {
+            std::ranges::stable_sort(keyed_members, {}, &std::pair<uint8_t, ifc::DeclIndex>::first);
+            group.keys.reserve(keyed_members.size());
+            group.members.reserve(keyed_members.size());
+            for (auto [key, member] : keyed_members)
+            {
+                group.keys.push_back(key);
+                group.members.push_back(member);
+            }
+        }
+    }
+
+    ScopeSortIndex::ScopeSortIndex(ifc::File const& file)
+        : scopes_(file.scope_descriptors().size(), file.memory_resource())
+    {
+    }
+
+    std::span<ifc::DeclIndex const> ScopeSortIndex::members(ifc::File const& file, ifc::ScopeIndex scope, ifc::DeclSort sort) const
+    {
+        const auto key = static_cast<uint8_t>(sort);
+        return members_with_keys(get_members(file, scope).by_sort, key, key);
+    }
+
+    std::span<ifc::DeclIndex const> ScopeSortIndex::scope_members(ifc::File const& file, ifc::ScopeIndex scope, ifc::TypeBasis first, ifc::TypeBasis last) const
+    {
+        return members_with_keys(get_members(file, scope).scopes_by_kind, static_cast<uint8_t>(first), static_cast<uint8_t>(last));
+    }
+
+    ScopeSortIndex::ScopeMembers const& ScopeSortIndex::get_members(ifc::File const& file, ifc::ScopeIndex scope) const
+    {
+        static const ScopeMembers no_members{ Group({}), Group({}) };
+        if (ifc::is_null(scope) || static_cast<size_t>(scope) > scopes_.size())
+            return no_members;
+
+        auto & lazy = scopes_[static_cast<size_t>(scope) - 1];
+        std::call_once(lazy.once, [&] {
+            std::vector<std::pair<uint8_t, ifc::DeclIndex>> by_sort;
+            std::vector<std::pair<uint8_t, ifc::DeclIndex>> scopes_by_kind;
+            for (auto member : get_declarations(file, file.scope_descriptors()[scope]))
+            {
+                const auto decl = member.index;
+                by_sort.emplace_back(static_cast<uint8_t>(decl.sort()), decl);
+                if (decl.sort() == ifc::DeclSort::Scope)
+                    scopes_by_kind.emplace_back(static_cast<uint8_t>(get_kind(file.scope_declarations()[decl], file)), decl);
+            }
+            group(lazy.members.by_sort, std::move(by_sort));
+            group(lazy.members.scopes_by_kind, std::move(scopes_by_kind));
+            lazy.built.store(true, std::memory_order_release);
+        });
+        return lazy.members;
+    }
+
+    std::span<ifc::DeclIndex const> ScopeSortIndex::members_with_keys(Group const& group, uint8_t first, uint8_t last)
+    {
+        auto const & [keys, members] = group;
+        const auto begin = std::ranges::lower_bound(keys, first);
+        const auto end = std::ranges::upper_bound(keys, last);
+        if (begin >= end)
+            return {};
+        return std::span(members).subspan(begin - keys.begin(), end - begin);
+    }
+
+    size_t ScopeSortIndex::heap_bytes() const
+    {
+        size_t result = ifc::heap_bytes(scopes_);
+        for (auto const & lazy : scopes_)
+        {
+            if (!lazy.built.load(std::memory_order_acquire))
+                continue;
+            for (auto const * group : { &lazy.members.by_sort, &lazy.members.scopes_by_kind })
+                result += ifc::heap_bytes(group->keys) + ifc::heap_bytes(group->members);
+        }
+        return result;
+    }
+}
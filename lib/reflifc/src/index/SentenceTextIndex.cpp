@@ -0,0 +1,68 @@
+#include "reflifc/index/SentenceTextIndex.h"
+
+#include "reflifc/Sentence.h"
+#include "reflifc/Word.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Word.h>
+
+#include <cctype>
+
+namespace reflifc
+{
+    namespace
+    {
+        bool is_word_character(char c)
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+        // Whether a space must separate the spellings, or is conventional after them.
+        bool needs_space(std::string_view previous, std::string_view next)
+        {
+            if (previous == ",")
+                return true;
+            return is_word_character(previous.back()) && is_word_character(next.front());
+        }
+    }
+
+    SentenceTextIndex::SentenceTextIndex(ifc::File const& file)
+        : sentences_(file.has_partition(ifc::Sentence::PartitionName) ? file.sentences().size() : 0, file.memory_resource())
+    {
+    }
+
+    std::string_view SentenceTextIndex::text(ifc::File const& file, ifc::SentenceIndex sentence) const
+    {
+        if (ifc::is_null(sentence) || static_cast<size_t>(sentence) > sentences_.size())
+            return {};
+
+        auto & lazy = sentences_[static_cast<size_t>(sentence) - 1];
+        std::call_once(lazy.once, [&] {
+            std::string_view previous;
+            for (auto const & word : Sentence(&file, sentence).words())
+            {
+                const auto spelling = Word(&file, word).spelling();
+                if (spelling.empty())
+                    continue;
+                if (!previous.empty() && needs_space(previous, spelling))
+                    lazy.text.push_back(' ');
+                lazy.text.append(spelling);
+                previous = spelling;
+            }
+            lazy.built.store(true, std::memory_order_release);
+        });
+        return lazy.text;
+    }
+
+    size_t SentenceTextIndex::heap_bytes() const
+    {
+        size_t result = ifc::heap_bytes(sentences_);
+        for (auto const & lazy : sentences_)
+        {
+            if (lazy.built.load(std::memory_order_acquire))
+                result += ifc::heap_bytes(lazy.text);
+        }
+        return result;
+    }
+}
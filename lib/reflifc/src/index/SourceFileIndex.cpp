@@ -0,0 +1,94 @@
+#include "reflifc/index/SourceFileIndex.h"
+#include "reflifc/index/LineTable.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+
+#include <utility>
+#include <vector>
+
+namespace reflifc
+{
+    SourceFileIndex::SourceFileIndex(ifc::File const& file)
+        : paths_(file.memory_resource())
+        , groups_(file.memory_resource())
+        , starts_(file.memory_resource())
+        , declarations_(file.memory_resource())
+    {
+        auto const & lines = file.get_index<LineTable>();
+        const auto files = lines.files();
+
+        // Group of each position in the line table's files, assigned as declarations show up.
+        constexpr uint32_t none = ~uint32_t{ 0 };
+        std::vector<uint32_t> group_of_file(files.size(), none);
+        std::vector<std::pair<uint32_t, ifc::DeclIndex>> located;
+        std::vector<uint32_t> counts;
+
+        const auto add = [&]<typename T>(ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const) {
+            if (!file.has_partition(T::PartitionName))
+                return;
+
+            uint32_t i = 0;
+            for (auto const & declaration : (file.*partition)())
+            {
+                ifc::poll_cancellation(i);
+                auto & group = group_of_file[lines.file_position(declaration.locus)];
+                if (group == none)
+                {
+                    const auto path = files[&group - group_of_file.data()];
+                    const auto [it, inserted] = groups_.try_emplace(path, static_cast<uint32_t>(paths_.size()));
+                    if (inserted)
+                    {
+                        paths_.push_back(path);
+                        counts.push_back(0);
+                    }
+                    group = it->second;
+                }
+                ++counts[group];
+                located.emplace_back(group, ifc::DeclIndex{ static_cast<uint32_t>(T::Sort), i++ });
+            }
+        };
+
+        add(&ifc::File::scope_declarations);
+        add(&ifc::File::template_declarations);
+        add(&ifc::File::partial_specializations);
+        add(&ifc::File::using_declarations);
+        add(&ifc::File::enumerations);
+        add(&ifc::File::enumerators);
+        add(&ifc::File::alias_declarations);
+        add(&ifc::File::functions);
+        add(&ifc::File::methods);
+        add(&ifc::File::constructors);
+        add(&ifc::File::destructors);
+        add(&ifc::File::variables);
+        add(&ifc::File::fields);
+        add(&ifc::File::bitfields);
+        add(&ifc::File::parameters);
+        add(&ifc::File::concepts);
+        add(&ifc::File::intrinsic_declarations);
+
+        // Counting sort by group, stable so that the declarations of a group stay in the order they were added.
+        starts_.resize(paths_.size() + 1);
+        for (size_t group = 0; group != counts.size(); ++group)
+            starts_[group + 1] = starts_[group] + counts[group];
+        declarations_.resize(located.size());
+        std::vector<uint32_t> next(starts_.begin(), starts_.end() - 1);
+        for (auto [group, decl] : located)
+            declarations_[next[group]++] = decl;
+    }
+
+    std::span<ifc::DeclIndex const> SourceFileIndex::declarations(std::string_view path) const
+    {
+        const auto group = groups_.find(path);
+        if (group == groups_.end())
+            return {};
+        return std::span(declarations_).subspan(starts_[group->second], starts_[group->second + 1] - starts_[group->second]);
+    }
+
+    size_t SourceFileIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(paths_) + ifc::heap_bytes(groups_) + ifc::heap_bytes(starts_) + ifc::heap_bytes(declarations_);
+    }
+}
@@ -0,0 +1,88 @@
+#include "reflifc/index/SpecializationIndex.h"
+
+#include "reflifc/HashCombine.h"
+#include "reflifc/index/TemplateArgumentIndex.h"
+#include "reflifc/index/TypeHashIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+
+#include <algorithm>
+
+namespace reflifc
+{
+    namespace
+    {
+        using Keyed = std::pair<uint64_t, ifc::DeclIndex>;
+
+        void group(std::vector<Keyed> keyed, std::vector<ifc::DeclIndex>& specializations, auto& ranges)
+        {
+            std::ranges::stable_sort(keyed, {}, &Keyed::first);
+            specializations.reserve(keyed.size());
+            for (auto const & [key, decl] : keyed)
+            {
+                auto [it, inserted] = ranges.try_emplace(key, static_cast<uint32_t>(specializations.size()), 0u);
+                ++it->second.count;
+                specializations.push_back(decl);
+            }
+        }
+    }
+
+    SpecializationIndex::SpecializationIndex(ifc::File const& file)
+    {
+        if (!file.has_partition(ifc::SpecializationForm::PartitionName))
+            return;
+
+        auto const & types = file.get_index<TypeHashIndex>();
+        auto const & arguments = file.get_index<TemplateArgumentIndex>();
+        const auto forms = file.specialization_forms();
+        std::vector<Keyed> by_primary;
+        std::vector<Keyed> by_arguments;
+        auto add = [&](ifc::DeclIndex decl, ifc::SpecFormIndex index) {
+            auto const & form = forms[index];
+            const auto primary = types.declaration_hash(file, form.primary);
+            by_primary.emplace_back(primary, decl);
+            by_arguments.emplace_back(hash_combine(primary, arguments.hash(file, form.arguments)), decl);
+        };
+
+        if (file.has_partition(ifc::Specialization::PartitionName))
+        {
+            uint32_t index = 0;
+            for (auto const & specialization : file.specializations())
+                add({ .tag = static_cast<uint32_t>(ifc::DeclSort::Specialization), .index = index++ }, specialization.form);
+        }
+        if (file.has_partition(ifc::PartialSpecialization::PartitionName))
+        {
+            uint32_t index = 0;
+            for (auto const & specialization : file.partial_specializations())
+                add({ .tag = static_cast<uint32_t>(ifc::DeclSort::PartialSpecialization), .index = index++ }, specialization.form);
+        }
+
+        group(std::move(by_primary), primary_specializations_, primaries_);
+        group(std::move(by_arguments), argument_specializations_, arguments_);
+    }
+
+    std::span<ifc::DeclIndex const> SpecializationIndex::specializations(ifc::File const& file, ifc::DeclIndex primary) const
+    {
+        const auto it = primaries_.find(file.get_index<TypeHashIndex>().declaration_hash(file, primary));
+        if (it == primaries_.end())
+            return {};
+        return std::span(primary_specializations_).subspan(it->second.offset, it->second.count);
+    }
+
+    std::span<ifc::DeclIndex const> SpecializationIndex::find(ifc::File const& file, ifc::DeclIndex primary, uint64_t arguments_hash) const
+    {
+        const auto key = hash_combine(file.get_index<TypeHashIndex>().declaration_hash(file, primary), arguments_hash);
+        const auto it = arguments_.find(key);
+        if (it == arguments_.end())
+            return {};
+        return std::span(argument_specializations_).subspan(it->second.offset, it->second.count);
+    }
+
+    size_t SpecializationIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(primary_specializations_) + ifc::heap_bytes(primaries_)
+             + ifc::heap_bytes(argument_specializations_) + ifc::heap_bytes(arguments_);
+    }
+}
@@ -0,0 +1,144 @@
+#include "reflifc/index/SpecifierTable.h"
+#include "reflifc/SideTable.h"
+#include "reflifc/index/AttributeIndex.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+
+#include <bit>
+
+namespace reflifc
+{
+    namespace
+    {
+        bool has_specifier(ifc::BasicSpecifiers specifiers, ifc::BasicSpecifiers specifier)
+        {
+            return (static_cast<uint8_t>(specifiers) & static_cast<uint8_t>(specifier)) != 0;
+        }
+
+        // Bit f is DeclarationFlag f.
+        template<typename T>
+        uint8_t flags_of(T const& declaration)
+        {
+            uint8_t flags = 0;
+            if constexpr (requires { declaration.specifiers; })
+            {
+                const auto specifiers = declaration.specifiers;
+                if (!has_specifier(specifiers, ifc::BasicSpecifiers::NonExported))
+                    flags |= 1 << static_cast<int>(DeclarationFlag::Exported);
+                if (has_specifier(specifiers, ifc::BasicSpecifiers::Deprecated))
+                    flags |= 1 << static_cast<int>(DeclarationFlag::Deprecated);
+                if (has_specifier(specifiers, ifc::BasicSpecifiers::IsMemberOfGlobalModule))
+                    flags |= 1 << static_cast<int>(DeclarationFlag::GlobalModule);
+            }
+            if constexpr (requires { declaration.access; })
+            {
+                if (declaration.access == ifc::Access::Public || declaration.access == ifc::Access::None)
+                    flags |= 1 << static_cast<int>(DeclarationFlag::Public);
+            }
+            return flags;
+        }
+    }
+
+    SpecifierTable::SpecifierTable(ifc::File const& file)
+        : counts_(sort_cardinalities(file, ifc::DeclSort{}))
+        , words_(file.memory_resource())
+    {
+        size_t total = 0;
+        for (size_t sort = 0; sort != counts_.size(); ++sort)
+        {
+            starts_[sort] = static_cast<uint32_t>(total);
+            total += word_count(sort) * DeclarationFlagCount;
+        }
+        words_.assign(total, 0);
+
+        auto set = [this](size_t sort, size_t flag, uint32_t i) {
+            words_[starts_[sort] + flag * word_count(sort) + i / 64] |= uint64_t{ 1 } << (i % 64);
+        };
+
+        auto add = [&]<typename T>(ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const) {
+            if (!file.has_partition(T::PartitionName))
+                return;
+
+            uint32_t i = 0;
+            for (auto const & declaration : (file.*partition)())
+            {
+                ifc::poll_cancellation(i);
+                const auto flags = flags_of(declaration);
+                for (size_t flag = 0; flag != DeclarationFlagCount; ++flag)
+                {
+                    if (flags & (1 << flag))
+                        set(static_cast<size_t>(T::Sort), flag, i);
+                }
+                ++i;
+            }
+        };
+
+        add(&ifc::File::scope_declarations);
+        add(&ifc::File::template_declarations);
+        add(&ifc::File::partial_specializations);
+        add(&ifc::File::using_declarations);
+        add(&ifc::File::enumerations);
+        add(&ifc::File::enumerators);
+        add(&ifc::File::alias_declarations);
+        add(&ifc::File::functions);
+        add(&ifc::File::methods);
+        add(&ifc::File::constructors);
+        add(&ifc::File::destructors);
+        add(&ifc::File::variables);
+        add(&ifc::File::fields);
+        add(&ifc::File::bitfields);
+        add(&ifc::File::concepts);
+        add(&ifc::File::intrinsic_declarations);
+
+        // MSVC records [[deprecated]] as an attribute rather than a specifier.
+        for (auto decl : file.get_index<AttributeIndex>().find(file, "deprecated"))
+        {
+            if (decl.index < counts_[decl.tag])
+                set(decl.tag, static_cast<size_t>(DeclarationFlag::Deprecated), decl.index);
+        }
+    }
+
+    bool SpecifierTable::has(ifc::DeclIndex decl, DeclarationFlag flag) const
+    {
+        if (decl.index >= counts_[decl.tag])
+            return false;
+        return (column(decl.sort(), flag)[decl.index / 64] >> (decl.index % 64) & 1) != 0;
+    }
+
+    std::span<uint64_t const> SpecifierTable::column(ifc::DeclSort sort, DeclarationFlag flag) const
+    {
+        const auto s = static_cast<size_t>(sort);
+        const auto words = word_count(s);
+        return std::span(words_).subspan(starts_[s] + static_cast<size_t>(flag) * words, words);
+    }
+
+    std::vector<ifc::DeclIndex> SpecifierTable::select(std::initializer_list<DeclarationFlag> required,
+        std::initializer_list<DeclarationFlag> excluded) const
+    {
+        std::vector<ifc::DeclIndex> result;
+        for (uint32_t sort = 0; sort != ifc::DeclIndex::SortCount; ++sort)
+        {
+            for (size_t word = 0; word != word_count(sort); ++word)
+            {
+                const auto remaining = counts_[sort] - word * 64;
+                uint64_t bits = remaining >= 64 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << remaining) - 1;
+                for (auto flag : required)
+                    bits &= column(static_cast<ifc::DeclSort>(sort), flag)[word];
+                for (auto flag : excluded)
+                    bits &= ~column(static_cast<ifc::DeclSort>(sort), flag)[word];
+
+                for (; bits != 0; bits &= bits - 1)
+                    result.push_back({ sort, static_cast<uint32_t>(word * 64 + std::countr_zero(bits)) });
+            }
+        }
+        return result;
+    }
+
+    size_t SpecifierTable::heap_bytes() const
+    {
+        return ifc::heap_bytes(words_);
+    }
+}
@@ -0,0 +1,157 @@
+#include "reflifc/index/TemplateArgumentIndex.h"
+
+#include "reflifc/HashCombine.h"
+#include "reflifc/index/ConstantEvaluator.h"
+#include "reflifc/index/TypeHashIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Expression.h>
+
+#include <cstring>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Leads the key of every argument, so that e.g. a type and a declaration with the same id differ.
+        enum class ArgumentKind : uint8_t
+        {
+            Type,
+            Declaration,
+            Constant,
+            Pack,
+            Other,
+        };
+
+        template<typename T>
+        uint64_t raw(T const& value)
+        {
+            static_assert(sizeof(T) <= sizeof(uint64_t));
+            uint64_t result = 0;
+            std::memcpy(&result, &value, sizeof(T));
+            return result;
+        }
+    }
+
+    size_t TemplateArgumentIndex::KeyHash::operator()(std::vector<uint64_t> const& key) const noexcept
+    {
+        size_t seed = 0;
+        for (auto word : key)
+            seed = hash_combine(seed, word);
+        return seed;
+    }
+
+    TemplateArgumentIndex::TemplateArgumentIndex(ifc::File const&)
+    {
+    }
+
+    uint64_t TemplateArgumentIndex::hash(ifc::File const& file, ifc::ExprIndex arguments) const
+    {
+        return entry(file, arguments).hash;
+    }
+
+    uint32_t TemplateArgumentIndex::canonical_id(ifc::File const& file, ifc::ExprIndex arguments) const
+    {
+        return entry(file, arguments).id;
+    }
+
+    uint64_t TemplateArgumentIndex::combine(std::span<uint64_t const> argument_hashes)
+    {
+        size_t seed = argument_hashes.size();
+        for (auto hash : argument_hashes)
+            seed = hash_combine(seed, hash);
+        return seed;
+    }
+
+    TemplateArgumentIndex::Entry TemplateArgumentIndex::entry(ifc::File const& file, ifc::ExprIndex arguments) const
+    {
+        std::scoped_lock lock(mutex_);
+        return entry_locked(file, arguments);
+    }
+
+    TemplateArgumentIndex::Entry TemplateArgumentIndex::entry_locked(ifc::File const& file, ifc::ExprIndex arguments) const
+    {
+        if (arguments.is_null())
+            return intern({}, {});
+
+        auto & entries = entries_[arguments.tag];
+        if (arguments.index < entries.size() && entries[arguments.index].id != 0)
+            return entries[arguments.index];
+
+        auto const & types = file.get_index<TypeHashIndex>();
+        auto const & evaluator = file.get_index<ConstantEvaluator>();
+
+        const auto elements = arguments.sort() == ifc::ExprSort::Tuple
+            ? file.expr_heap().slice(file.tuple_expressions()[arguments].seq)
+            : ifc::Partition<ifc::ExprIndex, ifc::Index>(&arguments, 1);
+
+        std::vector<uint64_t> key;
+        std::vector<uint64_t> hashes;
+        hashes.reserve(elements.size());
+        for (auto element : elements)
+        {
+            switch (element.sort())
+            {
+            case ifc::ExprSort::Type:
+            {
+                const auto type = file.type_expressions()[element].denotation;
+                key.insert(key.end(), { raw(ArgumentKind::Type), types.canonical_id(file, type) });
+                hashes.push_back(types.hash(file, type));
+                break;
+            }
+            case ifc::ExprSort::NamedDecl:
+            {
+                const auto decl = file.decl_expressions()[element].resolution;
+                key.insert(key.end(), { raw(ArgumentKind::Declaration), raw(decl) });
+                hashes.push_back(hash_combine(raw(ArgumentKind::Declaration), types.declaration_hash(file, decl)));
+                break;
+            }
+            case ifc::ExprSort::PackedTemplateArguments:
+            {
+                // May resize `entries` (a pack of a tuple), which is only indexed again below.
+                const auto pack = entry_locked(file, file.packed_template_arguments()[element].arguments);
+                key.insert(key.end(), { raw(ArgumentKind::Pack), pack.id });
+                hashes.push_back(hash_combine(raw(ArgumentKind::Pack), pack.hash));
+                break;
+            }
+            default:
+                if (const auto value = evaluator.evaluate(file, element))
+                {
+                    const auto bits = std::visit([](auto v) { return raw(v); }, *value);
+                    key.insert(key.end(), { raw(ArgumentKind::Constant), value->index(), bits });
+                    hashes.push_back(hash_combine(raw(ArgumentKind::Constant), *value));
+                }
+                else
+                {
+                    key.insert(key.end(), { raw(ArgumentKind::Other), raw(element) });
+                    hashes.push_back(hash_combine(raw(ArgumentKind::Other), &file, raw(element)));
+                }
+                break;
+            }
+        }
+
+        const auto result = intern(key, hashes);
+        if (arguments.index >= entries.size())
+            entries.resize(arguments.index + 1);
+        entries[arguments.index] = result;
+        return result;
+    }
+
+    TemplateArgumentIndex::Entry TemplateArgumentIndex::intern(std::vector<uint64_t> const& key, std::span<uint64_t const> hashes) const
+    {
+        const auto [id, inserted] = ids_.try_emplace(key, static_cast<uint32_t>(ids_.size() + 1));
+        return { combine(hashes), id->second };
+    }
+
+    size_t TemplateArgumentIndex::heap_bytes() const
+    {
+        std::scoped_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(ids_);
+        for (auto const & entries : entries_)
+            result += ifc::heap_bytes(entries);
+        for (auto const & [key, id] : ids_)
+            result += ifc::heap_bytes(key);
+        return result;
+    }
+}
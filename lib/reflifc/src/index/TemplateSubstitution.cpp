@@ -0,0 +1,174 @@
+#include "reflifc/index/TemplateSubstitution.h"
+
+#include "reflifc/Chart.h"
+#include "reflifc/TupleView.h"
+#include "reflifc/decl/AliasDeclaration.h"
+#include "reflifc/decl/ClassOrStruct.h"
+#include "reflifc/decl/Field.h"
+#include "reflifc/decl/Parameter.h"
+#include "reflifc/decl/ScopeDeclaration.h"
+#include "reflifc/decl/TemplateDeclaration.h"
+#include "reflifc/index/AliasResolution.h"
+#include "reflifc/index/TemplateArgumentIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+
+#include <mutex>
+#include <stdexcept>
+
+namespace reflifc
+{
+    Expression const* TemplateSubstitution::Bindings::argument(ifc::ParameterLevel level, ifc::ParameterPosition position) const
+    {
+        const auto raw_position = static_cast<size_t>(position);
+        if (level != level_ || raw_position == 0 || raw_position > arguments_.size())
+            return nullptr;
+        return &arguments_[raw_position - 1];
+    }
+
+    size_t TemplateSubstitution::KeyHash::operator()(Key const& key) const noexcept
+    {
+        return hash_combine(0, key.file, key.primary, key.arguments);
+    }
+
+    TemplateSubstitution::TemplateSubstitution(ifc::Environment* environment)
+        : environment_(environment)
+    {
+    }
+
+    std::span<TemplateSubstitution::MemberType const> TemplateSubstitution::member_types(SpecializationForm form) const
+    {
+        return instantiation(form).members;
+    }
+
+    std::optional<TemplateSubstitution::BoundType> TemplateSubstitution::member_type(SpecializationForm form, std::string_view name) const
+    {
+        for (auto const & member : member_types(form))
+        {
+            const char* member_name = member.member.is_field() ? member.member.as_field().name() : member.member.as_alias().name();
+            if (name == member_name)
+                return member.type;
+        }
+        return std::nullopt;
+    }
+
+    TemplateSubstitution::Bindings const* TemplateSubstitution::bindings(SpecializationForm form) const
+    {
+        auto const & result = instantiation(form);
+        return result.bound ? &result.bindings : nullptr;
+    }
+
+    TemplateSubstitution::BoundType TemplateSubstitution::substitute(BoundType bound) const
+    {
+        if (!bound.type)
+            return bound;
+
+        auto const & file = *bound.type.containing_file();
+        bound.type = Type(&file, file.get_index<AliasResolution>().underlying(file, bound.type.index()));
+        if (!bound.bindings || !bound.type.is_designated())
+            return bound;
+
+        const auto designation = bound.type.designation();
+        if (!designation.is_parameter())
+            return bound;
+        const auto parameter = designation.as_parameter();
+        const auto argument = bound.bindings->argument(parameter.level(), parameter.position());
+        if (!argument || !argument->is_type())
+            return bound;
+
+        // Arguments are types of the form's file, which are not bound to anything.
+        return substitute({ argument->as_type(), nullptr });
+    }
+
+    size_t TemplateSubstitution::size() const
+    {
+        std::shared_lock lock(mutex_);
+        return instantiations_.size();
+    }
+
+    size_t TemplateSubstitution::heap_bytes() const
+    {
+        std::shared_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(instantiations_);
+        for (auto const & [key, instantiation] : instantiations_)
+            result += sizeof(Instantiation) + ifc::heap_bytes(instantiation->bindings.arguments_) + ifc::heap_bytes(instantiation->members);
+        return result;
+    }
+
+    TemplateSubstitution::Instantiation const& TemplateSubstitution::instantiation(SpecializationForm form) const
+    {
+        auto const & file = *form.containing_file();
+        const Key key{ &file, form.primary_template().index(), file.get_index<TemplateArgumentIndex>().canonical_id(file, form.arguments_index()) };
+        {
+            std::shared_lock lock(mutex_);
+            if (auto it = instantiations_.find(key); it != instantiations_.end())
+                return *it->second;
+        }
+
+        // Bound outside of the lock, the first one stored wins if another thread bound it meanwhile.
+        auto result = std::make_unique<Instantiation>();
+        instantiate(form, *result);
+
+        std::unique_lock lock(mutex_);
+        return *instantiations_.try_emplace(key, std::move(result)).first->second;
+    }
+
+    void TemplateSubstitution::instantiate(SpecializationForm form, Instantiation& result) const
+    {
+        auto primary = form.primary_template();
+        if (primary.is_reference())
+        {
+            if (!environment_)
+                return;
+            try
+            {
+                const auto resolved = environment_->resolve_reference(*form.containing_file(), primary.index());
+                primary = Declaration(resolved.file, resolved.decl);
+            }
+            catch (std::out_of_range const&)
+            {
+                // Its module is not in the environment.
+                return;
+            }
+        }
+        if (!primary.is_template())
+            return;
+
+        const auto template_ = primary.as_template();
+        const auto chart = template_.chart();
+        if (chart.index().is_null())
+            return;
+
+        // The arguments are those of the innermost level, the last of the chart.
+        const auto parameters = primary.containing_file()->get_index<ChartParameterIndex>().parameters(chart.index());
+        if (!parameters.empty())
+            result.bindings.level_ = parameters.back()->level;
+        for (auto argument : form.arguments())
+            result.bindings.arguments_.push_back(argument);
+        result.bound = true;
+
+        const auto bind = [&](Declaration member, Type type) {
+            result.members.push_back({ member, substitute({ type, &result.bindings }) });
+        };
+
+        const auto entity = template_.entity();
+        if (entity.is_alias())
+        {
+            bind(entity, entity.as_alias().aliasee());
+            return;
+        }
+        if (!entity.is_scope() || !entity.as_scope().is_class_or_struct())
+            return;
+        const auto class_ = entity.as_scope().as_class_or_struct();
+        if (!class_.is_complete())
+            return;
+        for (auto member : class_.members())
+        {
+            if (member.is_alias())
+                bind(member, member.as_alias().aliasee());
+            else if (member.is_field())
+                bind(member, member.as_field().type());
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#include "reflifc/index/TranslationUnitLookup.h"
+#include "reflifc/index/QualifiedNameResolver.h"
+
+#include <ifc/MemoryUsage.h>
+
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+
+namespace reflifc
+{
+    TranslationUnitLookup::TranslationUnitLookup(ifc::Environment& environment, ifc::Environment::Config const& translation_unit)
+        : environment_(&environment)
+    {
+        // Every BMI is started before any is waited for.
+        std::vector<std::future<ifc::File const&>> loads;
+        for (auto const & header_unit : translation_unit.imported_header_units)
+            loads.push_back(environment.load_module_by_bmi_path(header_unit.bmi));
+        for (auto const & module : translation_unit.imported_modules)
+            loads.push_back(environment.load_module_by_bmi_path(module.bmi));
+
+        ifc::FileIdSet visible;
+        for (auto & load : loads)
+        {
+            auto const & imported = load.get();
+            environment.transitive_exports(imported).for_each([&](ifc::FileId id) {
+                if (visible.contains(id))
+                    return;
+                visible.insert(id);
+                visible_modules_.push_back(environment.file(id));
+            });
+        }
+    }
+
+    bool TranslationUnitLookup::is_visible(ifc::File const& file) const
+    {
+        return std::ranges::find(visible_modules_, &file) != visible_modules_.end();
+    }
+
+    std::span<Declaration const> TranslationUnitLookup::resolve(std::string_view qualified_name) const
+    {
+        if (qualified_name.starts_with("::"))
+            qualified_name.remove_prefix(2);
+
+        {
+            std::shared_lock lock(mutex_);
+            if (auto it = resolved_.find(qualified_name); it != resolved_.end())
+                return it->second;
+        }
+
+        auto result = resolve_uncached(qualified_name);
+
+        // The first result stored wins if another thread resolved the name meanwhile.
+        std::unique_lock lock(mutex_);
+        return resolved_.try_emplace(std::string(qualified_name), std::move(result)).first->second;
+    }
+
+    std::vector<Declaration> TranslationUnitLookup::resolve_uncached(std::string_view qualified_name) const
+    {
+        const auto separator = qualified_name.rfind("::");
+        const auto last = separator == std::string_view::npos ? qualified_name : qualified_name.substr(separator + 2);
+
+        std::vector<Declaration> result;
+        for (auto file : visible_modules_)
+        {
+            if (!file->may_contain_text(last))
+                continue;
+
+            ifc::Environment::ResolvedDeclaration found{ file, file->get_index<QualifiedNameResolver>().resolve(*file, qualified_name) };
+            if (found.decl.is_null())
+                continue;
+            if (found.decl.sort() == ifc::DeclSort::Reference)
+            {
+                try
+                {
+                    found = environment_->resolve_reference(*file, found.decl);
+                }
+                catch (std::out_of_range const&)
+                {
+                    // Kept as the reference, its module is not in the environment.
+                }
+            }
+
+            const auto duplicate = std::ranges::any_of(result, [&](Declaration const & declaration) {
+                return declaration.containing_file() == found.file && declaration.index() == found.decl;
+            });
+            if (!duplicate)
+                result.emplace_back(found.file, found.decl);
+        }
+        return result;
+    }
+
+    size_t TranslationUnitLookup::heap_bytes() const
+    {
+        std::shared_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(visible_modules_) + ifc::heap_bytes(resolved_);
+        for (auto const & [name, declarations] : resolved_)
+            result += ifc::heap_bytes(name) + ifc::heap_bytes(declarations);
+        return result;
+    }
+}
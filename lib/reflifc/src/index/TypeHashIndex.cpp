@@ -0,0 +1,260 @@
+#include "reflifc/index/TypeHashIndex.h"
+
+#include "reflifc/HashCombine.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+#include <ifc/TypeTraversal.h>
+
+#include <cstring>
+#include <string_view>
+
+namespace reflifc
+{
+    namespace
+    {
+        template<typename T>
+        uint64_t raw(T const& value)
+        {
+            static_assert(sizeof(T) <= sizeof(uint64_t));
+            uint64_t result = 0;
+            std::memcpy(&result, &value, sizeof(T));
+            return result;
+        }
+
+        uint64_t module_name_hash(ifc::File const& file, ifc::ModuleReference module)
+        {
+            // Hashed like the joined "owner:partition" name of a unit, see unit_name_hash.
+            const auto owner = ifc::is_null(module.owner) ? std::string_view() : file.get_string_view(module.owner);
+            const auto partition = ifc::is_null(module.partition) ? std::string_view() : file.get_string_view(module.partition);
+            if (owner.empty())
+                return std::hash<std::string_view>{}(partition);
+            if (partition.empty())
+                return std::hash<std::string_view>{}(owner);
+            return std::hash<std::string>{}(std::string(owner).append(":").append(partition));
+        }
+
+        uint64_t unit_name_hash(ifc::File const& file)
+        {
+            const auto unit = file.header().unit;
+            switch (unit.sort())
+            {
+            case ifc::UnitSort::Primary:
+            case ifc::UnitSort::Partition:
+            case ifc::UnitSort::Header:
+                return std::hash<std::string_view>{}(file.get_string_view(ifc::TextOffset{ unit.index }));
+            default:
+                return std::hash<std::string_view>{}({});
+            }
+        }
+
+        // Parts of a type other than its type operands: `key` identifies them within the file,
+        // `hash` across files.
+        struct Part
+        {
+            uint64_t key;
+            uint64_t hash;
+        };
+    }
+
+    size_t TypeHashIndex::KeyHash::operator()(std::vector<uint64_t> const& key) const noexcept
+    {
+        size_t seed = 0;
+        for (auto word : key)
+            seed = hash_combine(seed, word);
+        return seed;
+    }
+
+    TypeHashIndex::TypeHashIndex(ifc::File const& file)
+        : module_hash_(unit_name_hash(file))
+    {
+    }
+
+    uint64_t TypeHashIndex::hash(ifc::File const& file, ifc::TypeIndex type) const
+    {
+        return entry(file, type).hash;
+    }
+
+    uint32_t TypeHashIndex::canonical_id(ifc::File const& file, ifc::TypeIndex type) const
+    {
+        return entry(file, type).id;
+    }
+
+    uint64_t TypeHashIndex::declaration_hash(ifc::File const& file, ifc::DeclIndex decl) const
+    {
+        if (decl.sort() == ifc::DeclSort::Reference)
+        {
+            auto const & reference = file.decl_references()[decl];
+            return hash_combine(module_name_hash(file, reference.unit), raw(reference.local_index));
+        }
+        return hash_combine(module_hash_, raw(decl));
+    }
+
+    TypeHashIndex::Entry TypeHashIndex::entry(ifc::File const& file, ifc::TypeIndex type) const
+    {
+        if (type.is_null())
+            return {};
+
+        std::scoped_lock lock(mutex_);
+        if (slot(type).id == 0)
+            compute(file, type);
+        return slot(type);
+    }
+
+    TypeHashIndex::Entry& TypeHashIndex::slot(ifc::TypeIndex type) const
+    {
+        auto & entries = entries_[type.tag];
+        if (type.index >= entries.size())
+            entries.resize(type.index + 1);
+        return entries[type.index];
+    }
+
+    void TypeHashIndex::compute(ifc::File const& file, ifc::TypeIndex root) const
+    {
+        // Post-order with an explicit stack: a type is computed once all of its operands are.
+        std::vector<std::pair<ifc::TypeIndex, bool>> stack{ { root, false } };
+        std::vector<uint64_t> key;
+        while (!stack.empty())
+        {
+            auto & [type, expanded] = stack.back();
+            if (slot(type).id != 0)
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            if (!expanded)
+            {
+                expanded = true;
+                const auto current = type;
+                ifc::for_each_type_operand(file, current, [&](ifc::TypeIndex operand) {
+                    if (!operand.is_null() && slot(operand).id == 0)
+                        stack.emplace_back(operand, false);
+                });
+                continue;
+            }
+
+            const auto current = type;
+            stack.pop_back();
+
+            key.clear();
+            key.push_back(static_cast<uint64_t>(current.sort()));
+            uint64_t hash = hash_combine(0, key.back());
+            auto add = [&](Part part) {
+                key.push_back(part.key);
+                hash = hash_combine(hash, part.hash);
+            };
+
+            switch (current.sort())
+            {
+            case ifc::TypeSort::Fundamental:
+            {
+                const auto value = raw(file.fundamental_types()[current]);
+                add({ value, value });
+                break;
+            }
+            case ifc::TypeSort::Designated:
+            {
+                const auto decl = file.designated_types()[current].decl;
+                add({ raw(decl), declaration_hash(file, decl) });
+                break;
+            }
+            case ifc::TypeSort::Expansion:
+            {
+                const auto mode = static_cast<uint64_t>(file.expansion_types()[current].mode);
+                add({ mode, mode });
+                break;
+            }
+            case ifc::TypeSort::Function:
+            {
+                auto const & function = file.function_types()[current];
+                const auto value = raw(function.eh_spec.sort) | raw(function.convention) << 8 | raw(function.traits) << 16;
+                add({ value, value });
+                add({ raw(function.eh_spec.words), raw(function.eh_spec.words) });
+                break;
+            }
+            case ifc::TypeSort::Method:
+            {
+                auto const & method = file.method_types()[current];
+                const auto value = raw(method.eh_spec.sort) | raw(method.convention) << 8 | raw(method.traits) << 16;
+                add({ value, value });
+                add({ raw(method.eh_spec.words), raw(method.eh_spec.words) });
+                break;
+            }
+            case ifc::TypeSort::Tor:
+            {
+                auto const & tor = file.tor_types()[current];
+                const auto value = raw(tor.eh_spec.sort) | raw(tor.convention) << 8;
+                add({ value, value });
+                break;
+            }
+            case ifc::TypeSort::Base:
+            {
+                auto const & base = file.base_types()[current];
+                const auto value = raw(base.access) | raw(base.specifiers) << 8;
+                add({ value, value });
+                break;
+            }
+            case ifc::TypeSort::Array:
+            {
+                const auto extent = raw(file.array_types()[current].extent);
+                add({ extent, extent });
+                break;
+            }
+            case ifc::TypeSort::Qualified:
+            {
+                const auto qualifiers = raw(file.qualified_types()[current].qualifiers);
+                add({ qualifiers, qualifiers });
+                break;
+            }
+            case ifc::TypeSort::Forall:
+            {
+                const auto chart = raw(file.forall_types()[current].chart);
+                add({ chart, chart });
+                break;
+            }
+            case ifc::TypeSort::Placeholder:
+            {
+                auto const & placeholder = file.placeholder_types()[current];
+                const auto value = raw(placeholder.constraint) | raw(placeholder.basis) << 32;
+                add({ value, value });
+                break;
+            }
+            case ifc::TypeSort::Tuple:
+            case ifc::TypeSort::Pointer:
+            case ifc::TypeSort::LvalueReference:
+            case ifc::TypeSort::RvalueReference:
+                break;
+            default:
+                // Other types are identified by their index.
+                add({ raw(current), raw(current) });
+                break;
+            }
+
+            ifc::for_each_type_operand(file, current, [&](ifc::TypeIndex operand) {
+                if (operand.is_null())
+                    return add({ 0, 0 });
+                auto const & operand_entry = slot(operand);
+                add({ operand_entry.id, operand_entry.hash });
+            });
+
+            const auto [id, inserted] = ids_.try_emplace(key, static_cast<uint32_t>(ids_.size() + 1));
+            auto & result = slot(current);
+            result.id = id->second;
+            result.hash = hash;
+        }
+    }
+
+    size_t TypeHashIndex::heap_bytes() const
+    {
+        std::scoped_lock lock(mutex_);
+        size_t result = ifc::heap_bytes(ids_);
+        for (auto const & entries : entries_)
+            result += ifc::heap_bytes(entries);
+        for (auto const & [key, id] : ids_)
+            result += ifc::heap_bytes(key);
+        return result;
+    }
+}
@@ -0,0 +1,484 @@
+#include "reflifc/index/TypeLayoutIndex.h"
+#include "reflifc/index/ConstantEvaluator.h"
+
+#include <ifc/Environment.h>
+#include <ifc/File.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+#include <bit>
+#include <variant>
+
+namespace reflifc
+{
+    namespace
+    {
+        // Packed layouts: bit 0 - computed, bit 1 - has a layout, bit 2 - polymorphic class, bit 3 - empty class,
+        // bits 4-9 - log2 of the alignment, bits 10-63 - the size.
+        constexpr uint64_t Computed = 1 << 0;
+        constexpr uint64_t HasLayout = 1 << 1;
+        constexpr uint64_t Polymorphic = 1 << 2;
+        constexpr uint64_t Empty = 1 << 3;
+        constexpr unsigned AlignmentShift = 4;
+        constexpr unsigned SizeShift = 10;
+
+        uint64_t pack(std::optional<TypeLayout> layout, uint64_t flags = 0)
+        {
+            if (!layout)
+                return Computed;
+            return Computed | HasLayout | flags
+                | uint64_t{ static_cast<unsigned>(std::countr_zero(layout->alignment)) } << AlignmentShift
+                | layout->size << SizeShift;
+        }
+
+        std::optional<TypeLayout> unpack(uint64_t packed)
+        {
+            if ((packed & HasLayout) == 0)
+                return std::nullopt;
+            return TypeLayout{ packed >> SizeShift, uint32_t{ 1 } << ((packed >> AlignmentShift) & 63) };
+        }
+
+        TypeLayout scalar(uint32_t size)
+        {
+            return { size, size };
+        }
+
+        uint64_t align_up(uint64_t offset, uint32_t alignment)
+        {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        uint32_t pointer_size(ifc::Architecture arch)
+        {
+            switch (arch)
+            {
+            case ifc::Architecture::X86:
+            case ifc::Architecture::ARM32:
+                return 4;
+            default:
+                return 8;
+            }
+        }
+
+        std::optional<uint32_t> precision_size(ifc::TypePrecision precision)
+        {
+            switch (precision)
+            {
+            case ifc::TypePrecision::Bit8:   return 1;
+            case ifc::TypePrecision::Bit16:  return 2;
+            case ifc::TypePrecision::Bit32:  return 4;
+            case ifc::TypePrecision::Bit64:  return 8;
+            case ifc::TypePrecision::Bit128: return 16;
+            default:                         return std::nullopt;
+            }
+        }
+
+        // MSVC: `long` and `long double` are the size of `int` and `double`.
+        std::optional<TypeLayout> fundamental(ifc::FundamentalType type, uint32_t pointer)
+        {
+            switch (type.basis)
+            {
+            case ifc::TypeBasis::Bool:
+                return scalar(1);
+            case ifc::TypeBasis::Char:
+                return scalar(precision_size(type.precision).value_or(1));
+            case ifc::TypeBasis::Wchar_t:
+                return scalar(2);
+            case ifc::TypeBasis::Int:
+                if (type.precision == ifc::TypePrecision::Short)
+                    return scalar(2);
+                return scalar(precision_size(type.precision).value_or(4));
+            case ifc::TypeBasis::Float:
+                return scalar(precision_size(type.precision).value_or(4));
+            case ifc::TypeBasis::Double:
+                return scalar(precision_size(type.precision).value_or(8));
+            case ifc::TypeBasis::Nullptr:
+                return scalar(pointer);
+            default:
+                return std::nullopt;
+            }
+        }
+
+        std::optional<uint64_t> constant(ifc::File const& file, ifc::ExprIndex expr)
+        {
+            if (expr.is_null())
+                return std::nullopt;
+            const auto value = file.get_index<ConstantEvaluator>().evaluate(file, expr);
+            if (!value || std::holds_alternative<double>(*value))
+                return std::nullopt;
+            if (const auto signed_value = std::get_if<int64_t>(&*value))
+                return *signed_value < 0 ? std::nullopt : std::optional<uint64_t>(*signed_value);
+            return std::get<uint64_t>(*value);
+        }
+
+        bool has_flag(ifc::FunctionTraits traits, ifc::FunctionTraits flag)
+        {
+            return (static_cast<uint16_t>(traits) & static_cast<uint16_t>(flag)) != 0;
+        }
+
+        bool is_memoized(ifc::TypeSort sort)
+        {
+            switch (sort)
+            {
+            case ifc::TypeSort::Fundamental:
+            case ifc::TypeSort::Designated:
+            case ifc::TypeSort::Pointer:
+            case ifc::TypeSort::LvalueReference:
+            case ifc::TypeSort::RvalueReference:
+            case ifc::TypeSort::Array:
+            case ifc::TypeSort::Qualified:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        size_t type_count(ifc::File const& file, ifc::TypeSort sort)
+        {
+            const auto count = [&file]<typename T>(ifc::Partition<T, ifc::TypeIndex> (ifc::File::*partition)() const) -> size_t {
+                return file.has_partition(T::PartitionName) ? (file.*partition)().size() : 0;
+            };
+            switch (sort)
+            {
+            case ifc::TypeSort::Fundamental:     return count(&ifc::File::fundamental_types);
+            case ifc::TypeSort::Designated:      return count(&ifc::File::designated_types);
+            case ifc::TypeSort::Pointer:         return count(&ifc::File::pointer_types);
+            case ifc::TypeSort::LvalueReference: return count(&ifc::File::lvalue_references);
+            case ifc::TypeSort::RvalueReference: return count(&ifc::File::rvalue_references);
+            case ifc::TypeSort::Array:           return count(&ifc::File::array_types);
+            case ifc::TypeSort::Qualified:       return count(&ifc::File::qualified_types);
+            default:                             return 0;
+            }
+        }
+
+        // Base types of a class, single or in a tuple.
+        std::vector<ifc::TypeIndex> base_types(ifc::File const& file, ifc::TypeIndex base)
+        {
+            if (base.is_null())
+                return {};
+            if (base.sort() != ifc::TypeSort::Tuple)
+                return { base };
+            const auto bases = file.type_heap().slice(file.tuple_types()[base].seq);
+            return { bases.begin(), bases.end() };
+        }
+    }
+
+    TypeLayoutIndex::TypeLayoutIndex(ifc::File const& file)
+        : pointer_size_(pointer_size(file.header().arch))
+    {
+        for (size_t sort = 0; sort != ifc::TypeIndex::SortCount; ++sort)
+        {
+            if (!is_memoized(static_cast<ifc::TypeSort>(sort)))
+                continue;
+            type_counts_[sort] = static_cast<uint32_t>(type_count(file, static_cast<ifc::TypeSort>(sort)));
+            types_[sort] = std::make_unique<Packed[]>(type_counts_[sort]);
+        }
+        if (file.has_partition(ifc::ScopeDeclaration::PartitionName))
+        {
+            class_count_ = static_cast<uint32_t>(file.scope_declarations().size());
+            classes_ = std::make_unique<Packed[]>(class_count_);
+        }
+    }
+
+    std::optional<TypeLayout> TypeLayoutIndex::layout(ifc::File const& file, ifc::TypeIndex type, ifc::Environment* environment) const
+    {
+        bool memoizable = true;
+        return lookup(file, type, environment, memoizable);
+    }
+
+    std::optional<TypeLayoutIndex::ClassLayout> TypeLayoutIndex::class_layout(ifc::File const& file, ifc::DeclIndex decl, ifc::Environment* environment) const
+    {
+        bool memoizable = true;
+        bool polymorphic = false;
+        return lay_out_class(file, decl, environment, memoizable, polymorphic);
+    }
+
+    std::optional<TypeLayout> TypeLayoutIndex::lookup(ifc::File const& file, ifc::TypeIndex type, ifc::Environment* environment, bool& memoizable) const
+    {
+        if (type.is_null())
+            return std::nullopt;
+
+        const auto sort = static_cast<size_t>(type.sort());
+        Packed* slot = type.index < type_counts_[sort] ? &types_[sort][type.index] : nullptr;
+        if (slot)
+        {
+            if (const auto packed = slot->load(std::memory_order_relaxed))
+                return unpack(packed);
+        }
+
+        // Laid out concurrently by other threads alike.
+        bool own_memoizable = true;
+        const auto result = compute(file, type, environment, own_memoizable);
+        if (slot && own_memoizable)
+            slot->store(pack(result), std::memory_order_relaxed);
+        memoizable = memoizable && own_memoizable;
+        return result;
+    }
+
+    std::optional<TypeLayout> TypeLayoutIndex::compute(ifc::File const& file, ifc::TypeIndex type, ifc::Environment* environment, bool& memoizable) const
+    {
+        switch (type.sort())
+        {
+        case ifc::TypeSort::Fundamental:
+            return fundamental(file.fundamental_types()[type], pointer_size_);
+        case ifc::TypeSort::Designated:
+            return declaration_layout(file, file.designated_types()[type].decl, environment, memoizable);
+        case ifc::TypeSort::Pointer:
+        case ifc::TypeSort::LvalueReference:
+        case ifc::TypeSort::RvalueReference:
+            return scalar(pointer_size_);
+        case ifc::TypeSort::Qualified:
+            return lookup(file, file.qualified_types()[type].unqualified, environment, memoizable);
+        case ifc::TypeSort::Array:
+        {
+            auto const & array = file.array_types()[type];
+            const auto element = lookup(file, array.element, environment, memoizable);
+            const auto extent = constant(file, array.extent);
+            if (!element || !extent)
+                return std::nullopt;
+            return TypeLayout{ element->size * *extent, element->alignment };
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    std::optional<TypeLayout> TypeLayoutIndex::declaration_layout(ifc::File const& file, ifc::DeclIndex decl, ifc::Environment* environment, bool& memoizable) const
+    {
+        switch (decl.sort())
+        {
+        case ifc::DeclSort::Scope:
+        {
+            const auto info = class_info(file, decl, environment, memoizable);
+            return info ? std::optional(info->layout) : std::nullopt;
+        }
+        case ifc::DeclSort::Enumeration:
+        {
+            // Enumerations without a fixed underlying type are `int`-sized.
+            const auto underlying = file.enumerations()[decl].base;
+            return underlying.is_null() ? scalar(4) : lookup(file, underlying, environment, memoizable);
+        }
+        case ifc::DeclSort::Alias:
+            return lookup(file, file.alias_declarations()[decl].aliasee, environment, memoizable);
+        case ifc::DeclSort::Reference:
+        {
+            if (!environment)
+            {
+                memoizable = false;
+                return std::nullopt;
+            }
+            // Every designation of another module's type goes through here, see Environment::resolve_all_references.
+            const auto resolved = environment->resolve_all_references(file)[decl.index];
+            if (resolved.file == nullptr)
+            {
+                memoizable = false;
+                return std::nullopt;
+            }
+            return resolved.file->get_index<TypeLayoutIndex>().declaration_layout(*resolved.file, resolved.decl, environment, memoizable);
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    std::optional<TypeLayoutIndex::ClassInfo> TypeLayoutIndex::class_info(ifc::File const& file, ifc::DeclIndex decl, ifc::Environment* environment, bool& memoizable) const
+    {
+        if (decl.index >= class_count_)
+            return std::nullopt;
+
+        auto & slot = classes_[decl.index];
+        if (const auto packed = slot.load(std::memory_order_relaxed))
+        {
+            const auto layout = unpack(packed);
+            if (!layout)
+                return std::nullopt;
+            return ClassInfo{ *layout, (packed & Polymorphic) != 0, (packed & Empty) != 0 };
+        }
+
+        bool own_memoizable = true;
+        bool polymorphic = false;
+        const auto laid_out = lay_out_class(file, decl, environment, own_memoizable, polymorphic);
+        std::optional<ClassInfo> result;
+        if (laid_out)
+        {
+            const bool empty = !laid_out->has_vtable_pointer && laid_out->members.empty() && laid_out->layout.size == 1
+                && std::ranges::all_of(laid_out->bases, [](Base const& base) { return base.offset == 0; });
+            result = ClassInfo{ laid_out->layout, polymorphic, empty };
+        }
+        if (own_memoizable)
+            slot.store(pack(laid_out ? std::optional(laid_out->layout) : std::nullopt,
+                (polymorphic ? Polymorphic : 0) | (result && result->empty ? Empty : 0)), std::memory_order_relaxed);
+        memoizable = memoizable && own_memoizable;
+        return result;
+    }
+
+    std::optional<TypeLayoutIndex::ClassLayout> TypeLayoutIndex::lay_out_class(ifc::File const& file, ifc::DeclIndex decl, ifc::Environment* environment, bool& memoizable, bool& polymorphic) const
+    {
+        if (decl.sort() != ifc::DeclSort::Scope || decl.index >= class_count_)
+            return std::nullopt;
+        auto const & scope = file.scope_declarations()[decl];
+        const auto kind = get_kind(scope, file);
+        if (kind != ifc::TypeBasis::Class && kind != ifc::TypeBasis::Struct && kind != ifc::TypeBasis::Union)
+            return std::nullopt;
+        if (ifc::is_null(scope.initializer))
+            return std::nullopt;
+
+        const auto pack_size = static_cast<uint32_t>(scope.pack_size);
+        const auto member_alignment = [pack_size](uint32_t natural) {
+            return pack_size != 0 ? std::min(natural, pack_size) : natural;
+        };
+        const bool is_union = kind == ifc::TypeBasis::Union;
+        const auto members = ifc::get_declarations(file, file.scope_descriptors()[scope.initializer]);
+
+        ClassLayout result;
+        uint64_t offset = 0;
+        uint32_t alignment = 1;
+
+        // The pointer to the virtual table comes first, unless a base brings one.
+        bool introduces_virtuals = false;
+        for (auto const & member : members)
+        {
+            if (member.index.sort() == ifc::DeclSort::Method)
+                introduces_virtuals |= has_flag(file.methods()[member.index].traits, ifc::FunctionTraits::Virtual);
+            else if (member.index.sort() == ifc::DeclSort::Destructor)
+                introduces_virtuals |= has_flag(file.destructors()[member.index].traits, ifc::FunctionTraits::Virtual);
+        }
+
+        struct LaidOutBase
+        {
+            ifc::TypeIndex type;
+            ClassInfo info;
+        };
+        std::vector<LaidOutBase> bases;
+        bool polymorphic_base = false;
+        for (auto base : base_types(file, scope.base))
+        {
+            if (base.sort() != ifc::TypeSort::Base)
+                return std::nullopt;
+            auto const & base_type = file.base_types()[base];
+            if (base_type.specifiers != 0)
+                return std::nullopt; // Virtual bases and pack expansions
+            if (base_type.type.sort() != ifc::TypeSort::Designated)
+                return std::nullopt;
+
+            auto base_file = &file;
+            auto base_decl = file.designated_types()[base_type.type].decl;
+            if (base_decl.sort() == ifc::DeclSort::Reference)
+            {
+                if (!environment)
+                {
+                    memoizable = false;
+                    return std::nullopt;
+                }
+                const auto resolved = environment->resolve_all_references(file)[base_decl.index];
+                if (resolved.file == nullptr)
+                {
+                    memoizable = false;
+                    return std::nullopt;
+                }
+                base_file = resolved.file;
+                base_decl = resolved.decl;
+            }
+            if (base_decl.sort() != ifc::DeclSort::Scope)
+                return std::nullopt;
+            const auto info = base_file->get_index<TypeLayoutIndex>().class_info(*base_file, base_decl, environment, memoizable);
+            if (!info)
+                return std::nullopt;
+            polymorphic_base |= info->polymorphic;
+            bases.push_back({ base_type.type, *info });
+        }
+
+        polymorphic = introduces_virtuals || polymorphic_base;
+        if (introduces_virtuals && !polymorphic_base)
+        {
+            result.has_vtable_pointer = true;
+            offset = pointer_size_;
+            alignment = member_alignment(pointer_size_);
+        }
+
+        for (auto const & [type, info] : bases)
+        {
+            const auto base_alignment = member_alignment(info.layout.alignment);
+            alignment = std::max(alignment, base_alignment);
+            // Empty bases take no space.
+            if (info.empty)
+            {
+                result.bases.push_back({ type, offset });
+                continue;
+            }
+            offset = align_up(offset, base_alignment);
+            result.bases.push_back({ type, offset });
+            offset += info.layout.size;
+        }
+
+        // Bitfields share a storage unit of their type while they fit in it.
+        uint64_t unit_offset = 0;
+        uint32_t unit_size = 0;
+        uint32_t unit_bits_used = 0;
+        uint64_t size = offset;
+        for (auto const & member : members)
+        {
+            if (member.index.sort() == ifc::DeclSort::Field)
+            {
+                auto const & field = file.fields()[member.index];
+                const auto layout = lookup(file, field.type, environment, memoizable);
+                if (!layout)
+                    return std::nullopt;
+                auto field_alignment = member_alignment(layout->alignment);
+                if (const auto aligned_as = constant(file, field.alignment))
+                    field_alignment = std::max(field_alignment, static_cast<uint32_t>(*aligned_as));
+                alignment = std::max(alignment, field_alignment);
+                unit_size = 0;
+
+                const auto field_offset = is_union ? 0 : align_up(offset, field_alignment);
+                result.members.push_back({ member.index, field_offset, 0 });
+                offset = field_offset + layout->size;
+                size = std::max(size, offset);
+            }
+            else if (member.index.sort() == ifc::DeclSort::Bitfield)
+            {
+                auto const & bitfield = file.bitfields()[member.index];
+                const auto layout = lookup(file, bitfield.type, environment, memoizable);
+                const auto width = constant(file, bitfield.width);
+                if (!layout || !width)
+                    return std::nullopt;
+                const auto unit_alignment = member_alignment(layout->alignment);
+                alignment = std::max(alignment, unit_alignment);
+
+                const auto bits = static_cast<uint32_t>(*width);
+                if (bits == 0)
+                {
+                    unit_size = 0;
+                    continue;
+                }
+                if (is_union || unit_size != layout->size || unit_bits_used + bits > unit_size * 8)
+                {
+                    unit_offset = is_union ? 0 : align_up(offset, unit_alignment);
+                    unit_size = static_cast<uint32_t>(layout->size);
+                    unit_bits_used = 0;
+                    offset = unit_offset + unit_size;
+                    size = std::max(size, offset);
+                }
+                result.members.push_back({ member.index, unit_offset, unit_bits_used });
+                unit_bits_used += bits;
+            }
+        }
+
+        if (const auto aligned_as = constant(file, scope.alignment))
+            alignment = std::max(alignment, static_cast<uint32_t>(*aligned_as));
+        if (!std::has_single_bit(alignment))
+            return std::nullopt;
+        // Empty classes still take a byte.
+        result.layout = { std::max<uint64_t>(align_up(size, alignment), 1), alignment };
+        return result;
+    }
+
+    size_t TypeLayoutIndex::heap_bytes() const
+    {
+        size_t result = class_count_ * sizeof(Packed);
+        for (auto count : type_counts_)
+            result += count * sizeof(Packed);
+        return result;
+    }
+}
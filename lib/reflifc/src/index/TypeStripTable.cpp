@@ -0,0 +1,94 @@
+#include "reflifc/index/TypeStripTable.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Type.h>
+
+#include <unordered_map>
+
+namespace reflifc
+{
+    namespace
+    {
+        template<typename T>
+        size_t type_count(ifc::File const& file, ifc::Partition<T, ifc::TypeIndex> (ifc::File::*partition)() const)
+        {
+            return file.has_partition(T::PartitionName) ? (file.*partition)().size() : 0;
+        }
+    }
+
+    TypeStripTable::TypeStripTable(ifc::File const& file)
+    {
+        const auto allocate = [&]<typename T>(ifc::Partition<T, ifc::TypeIndex> (ifc::File::*partition)() const) {
+            entries_[static_cast<size_t>(T::Sort)].resize(type_count(file, partition));
+        };
+        allocate(&ifc::File::qualified_types);
+        allocate(&ifc::File::lvalue_references);
+        allocate(&ifc::File::rvalue_references);
+        allocate(&ifc::File::array_types);
+        allocate(&ifc::File::function_types);
+
+        // Operand of a qualified or reference type, null for other types.
+        const auto operand = [&](ifc::TypeIndex type) -> ifc::TypeIndex {
+            switch (type.sort())
+            {
+            case ifc::TypeSort::Qualified:       return file.qualified_types()[type].unqualified;
+            case ifc::TypeSort::LvalueReference: return file.lvalue_references()[type].referee;
+            case ifc::TypeSort::RvalueReference: return file.rvalue_references()[type].referee;
+            default:                             return {};
+            }
+        };
+        // Layers already stripped end the walk, in whatever order the partitions list the types.
+        std::vector<ifc::TypeIndex> layers;
+        const auto strip = [&](ifc::TypeIndex type) {
+            layers.clear();
+            ifc::TypeIndex stripped = type;
+            for (auto next = operand(stripped); !next.is_null(); next = operand(stripped))
+            {
+                if (const auto known = entries_[static_cast<size_t>(stripped.sort())][stripped.index].stripped; !known.is_null())
+                {
+                    stripped = known;
+                    break;
+                }
+                layers.push_back(stripped);
+                stripped = next;
+            }
+            for (auto layer : layers)
+                entries_[static_cast<size_t>(layer.sort())][layer.index].stripped = stripped;
+            return stripped;
+        };
+
+        std::unordered_map<ifc::TypeIndex, ifc::TypeIndex> pointers;
+        for (uint32_t i = 0; i != type_count(file, &ifc::File::pointer_types); ++i)
+        {
+            const ifc::TypeIndex pointer{ static_cast<uint32_t>(ifc::TypeSort::Pointer), i };
+            pointers.emplace(file.pointer_types()[pointer].pointee, pointer);
+        }
+        const auto decay = [&](ifc::TypeIndex stripped) {
+            ifc::TypeIndex pointee = stripped;
+            if (stripped.sort() == ifc::TypeSort::Array)
+                pointee = file.array_types()[stripped].element;
+            else if (stripped.sort() != ifc::TypeSort::Function)
+                return stripped;
+            const auto pointer = pointers.find(pointee);
+            return pointer != pointers.end() ? pointer->second : stripped;
+        };
+
+        for (size_t sort = 0; sort != entries_.size(); ++sort)
+        {
+            for (uint32_t i = 0; i != entries_[sort].size(); ++i)
+            {
+                const auto stripped = strip(ifc::TypeIndex{ static_cast<uint32_t>(sort), i });
+                entries_[sort][i] = { stripped, decay(stripped) };
+            }
+        }
+    }
+
+    size_t TypeStripTable::heap_bytes() const
+    {
+        size_t result = 0;
+        for (auto const & entries : entries_)
+            result += ifc::heap_bytes(entries);
+        return result;
+    }
+}
@@ -0,0 +1,165 @@
+#include "reflifc/index/TypeUseIndex.h"
+
+#include <ifc/Cancellation.h>
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace reflifc
+{
+    namespace
+    {
+        using Entry = std::pair<ifc::TypeIndex, ifc::DeclIndex>;
+
+        class UseCollector
+        {
+        public:
+            explicit UseCollector(ifc::File const& file)
+                : file_(file)
+            {
+            }
+
+            // Core types used by the type, through tuples, bases and function types.
+            void add(ifc::DeclIndex decl, ifc::TypeIndex type)
+            {
+                pending_.push_back(type);
+                while (!pending_.empty())
+                {
+                    const auto core = TypeUseIndex::core_type(file_, pending_.back());
+                    pending_.pop_back();
+                    if (core.is_null())
+                        continue;
+
+                    switch (core.sort())
+                    {
+                    case ifc::TypeSort::Tuple:
+                    {
+                        const auto heap = file_.type_heap();
+                        const auto seq = file_.tuple_types()[core].seq;
+                        for (auto i = raw_count(seq.cardinality); i-- != 0;)
+                            pending_.push_back(heap[ifc::Index{ static_cast<uint32_t>(seq.start) + static_cast<uint32_t>(i) }]);
+                        continue;
+                    }
+                    case ifc::TypeSort::Base:
+                        pending_.push_back(file_.base_types()[core].type);
+                        continue;
+                    case ifc::TypeSort::Tor:
+                        pending_.push_back(file_.tor_types()[core].source);
+                        continue;
+                    case ifc::TypeSort::Function:
+                    {
+                        auto const & function = file_.function_types()[core];
+                        pending_.push_back(function.target);
+                        pending_.push_back(function.source);
+                        break;
+                    }
+                    case ifc::TypeSort::Method:
+                    {
+                        auto const & method = file_.method_types()[core];
+                        pending_.push_back(method.target);
+                        pending_.push_back(method.source);
+                        break;
+                    }
+                    default:
+                        break;
+                    }
+                    entries_.emplace_back(core, decl);
+                }
+            }
+
+            // `type` is a member of T or of its base, as for functions and methods.
+            template<typename T, typename Member>
+            void add_all(ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const, Member type)
+            {
+                if (!file_.has_partition(T::PartitionName))
+                    return;
+
+                const auto declarations = (file_.*partition)();
+                for (uint32_t i = 0; i != declarations.size(); ++i)
+                {
+                    ifc::poll_cancellation(i);
+                    const ifc::DeclIndex decl{ static_cast<uint32_t>(T::Sort), i };
+                    add(decl, declarations[decl].*type);
+                }
+            }
+
+            std::vector<Entry> take()
+            {
+                std::ranges::sort(entries_);
+                const auto [last, end] = std::ranges::unique(entries_);
+                entries_.erase(last, end);
+                return std::move(entries_);
+            }
+
+        private:
+            ifc::File const& file_;
+            std::vector<ifc::TypeIndex> pending_;
+            std::vector<Entry> entries_;
+        };
+    }
+
+    TypeUseIndex::TypeUseIndex(ifc::File const& file)
+        : types_(file.memory_resource())
+        , decls_(file.memory_resource())
+    {
+        UseCollector collector(file);
+        collector.add_all(&ifc::File::variables,          &ifc::VariableDeclaration::type);
+        collector.add_all(&ifc::File::fields,             &ifc::FieldDeclaration::type);
+        collector.add_all(&ifc::File::bitfields,          &ifc::BitfieldDeclaration::type);
+        collector.add_all(&ifc::File::parameters,         &ifc::ParameterDeclaration::type);
+        collector.add_all(&ifc::File::alias_declarations, &ifc::AliasDeclaration::aliasee);
+        collector.add_all(&ifc::File::functions,          &ifc::FunctionDeclaration::type);
+        collector.add_all(&ifc::File::methods,            &ifc::MethodDeclaration::type);
+        collector.add_all(&ifc::File::constructors,       &ifc::Constructor::type);
+        collector.add_all(&ifc::File::scope_declarations, &ifc::ScopeDeclaration::base);
+
+        const auto entries = collector.take();
+        types_.reserve(entries.size());
+        decls_.reserve(entries.size());
+        for (auto [type, decl] : entries)
+        {
+            types_.push_back(type);
+            decls_.push_back(decl);
+        }
+    }
+
+    ifc::TypeIndex TypeUseIndex::core_type(ifc::File const& file, ifc::TypeIndex type)
+    {
+        while (true)
+        {
+            switch (type.sort())
+            {
+            case ifc::TypeSort::Qualified:
+                type = file.qualified_types()[type].unqualified;
+                break;
+            case ifc::TypeSort::LvalueReference:
+                type = file.lvalue_references()[type].referee;
+                break;
+            case ifc::TypeSort::RvalueReference:
+                type = file.rvalue_references()[type].referee;
+                break;
+            case ifc::TypeSort::Pointer:
+                type = file.pointer_types()[type].pointee;
+                break;
+            default:
+                return type;
+            }
+        }
+    }
+
+    std::span<ifc::DeclIndex const> TypeUseIndex::users(ifc::File const& file, ifc::TypeIndex type) const
+    {
+        const auto core = core_type(file, type);
+        const auto [first, last] = std::ranges::equal_range(types_, core);
+        return std::span(decls_).subspan(first - types_.begin(), last - first);
+    }
+
+    size_t TypeUseIndex::heap_bytes() const
+    {
+        return ifc::heap_bytes(types_) + ifc::heap_bytes(decls_);
+    }
+}
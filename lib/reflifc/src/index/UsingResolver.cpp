@@ -0,0 +1,159 @@
+#include "reflifc/index/UsingResolver.h"
+
+#include "reflifc/index/ParentIndex.h"
+#include "reflifc/index/ScopeNameIndex.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+
+namespace reflifc
+{
+    namespace
+    {
+        template<typename T>
+        size_t declaration_count(ifc::File const& file, ifc::Partition<T, ifc::DeclIndex> (ifc::File::*partition)() const)
+        {
+            return file.has_partition(T::PartitionName) ? (file.*partition)().size() : 0;
+        }
+
+        // Declaration designated by the aliasee of the alias, null for aliases of other types.
+        ifc::DeclIndex designated_by_alias(ifc::File const& file, ifc::DeclIndex alias)
+        {
+            const auto aliasee = file.alias_declarations()[alias].aliasee;
+            if (aliasee.sort() != ifc::TypeSort::Designated)
+                return {};
+            return file.designated_types()[aliasee].decl;
+        }
+
+        ifc::ScopeIndex members_scope(ifc::File const& file, ifc::DeclIndex decl)
+        {
+            if (decl.is_null())
+                return file.header().global_scope;
+            if (decl.sort() == ifc::DeclSort::Template)
+                decl = file.template_declarations()[decl].entity.decl;
+            if (decl.sort() != ifc::DeclSort::Scope)
+                return {};
+            return file.scope_declarations()[decl].initializer;
+        }
+    }
+
+    UsingResolver::UsingResolver(ifc::File const& file)
+        : usings_(declaration_count(file, &ifc::File::using_declarations), file.memory_resource())
+        , aliases_(declaration_count(file, &ifc::File::alias_declarations), file.memory_resource())
+    {
+    }
+
+    bool UsingResolver::is_indirection(ifc::File const& file, ifc::DeclIndex decl)
+    {
+        if (decl.sort() == ifc::DeclSort::UsingDeclaration)
+            return true;
+        // Aliases of namespace aliases are namespace aliases too.
+        for (size_t depth = 0; decl.sort() == ifc::DeclSort::Alias; ++depth)
+        {
+            if (depth == file.alias_declarations().size())
+                return false;
+            decl = designated_by_alias(file, decl);
+        }
+        return decl.sort() == ifc::DeclSort::Scope
+            && get_kind(file.scope_declarations()[decl], file) == ifc::TypeBasis::Namespace;
+    }
+
+    std::span<ifc::DeclIndex const> UsingResolver::targets(ifc::File const& file, ifc::DeclIndex decl) const
+    {
+        if (!slot(decl) || !is_indirection(file, decl))
+            return {};
+        std::vector<ifc::DeclIndex> visiting;
+        return *resolve(file, decl, visiting);
+    }
+
+    UsingResolver::Slot* UsingResolver::slot(ifc::DeclIndex decl) const
+    {
+        if (decl.sort() == ifc::DeclSort::UsingDeclaration && decl.index < usings_.size())
+            return &usings_[decl.index];
+        if (decl.sort() == ifc::DeclSort::Alias && decl.index < aliases_.size())
+            return &aliases_[decl.index];
+        return nullptr;
+    }
+
+    std::shared_ptr<UsingResolver::Targets const> UsingResolver::resolve(ifc::File const& file, ifc::DeclIndex decl, std::vector<ifc::DeclIndex> & visiting) const
+    {
+        auto & slot = *this->slot(decl);
+        if (auto cached = slot.load(std::memory_order_acquire))
+            return cached;
+
+        visiting.push_back(decl);
+        auto built = std::make_shared<Targets const>(build(file, decl, visiting));
+        visiting.pop_back();
+
+        // Resolved concurrently by other threads alike, the first one is kept so that returned spans stay valid.
+        std::shared_ptr<Targets const> expected;
+        if (!slot.compare_exchange_strong(expected, built, std::memory_order_acq_rel))
+            return expected;
+        return built;
+    }
+
+    UsingResolver::Targets UsingResolver::build(ifc::File const& file, ifc::DeclIndex decl, std::vector<ifc::DeclIndex> & visiting) const
+    {
+        Targets result;
+        const auto add = [&](ifc::DeclIndex target) {
+            if (!is_indirection(file, target))
+            {
+                if (std::ranges::find(result, target) == result.end())
+                    result.push_back(target);
+                return;
+            }
+            // Ill-formed cycles of using-declarations are cut.
+            if (!slot(target) || std::ranges::find(visiting, target) != visiting.end())
+                return;
+            for (auto indirect : *resolve(file, target, visiting))
+            {
+                if (std::ranges::find(result, indirect) == result.end())
+                    result.push_back(indirect);
+            }
+        };
+
+        if (decl.sort() == ifc::DeclSort::Alias)
+        {
+            add(designated_by_alias(file, decl));
+            return result;
+        }
+
+        const auto resolution = file.using_declarations()[decl].resolution;
+        if (resolution.is_null())
+            return result;
+
+        // The whole overload set of the resolution, if it is a member of a scope of the file.
+        const auto identifier = ifc::declaration_identifier(file, resolution);
+        const auto scope = resolution.sort() == ifc::DeclSort::Reference
+            ? ifc::ScopeIndex{}
+            : members_scope(file, file.get_index<ParentIndex>().parent(resolution));
+        if (!identifier || ifc::is_null(scope))
+        {
+            add(resolution);
+            return result;
+        }
+        for (auto member : file.get_index<ScopeNameIndex>().find(file, scope, *identifier))
+            add(member);
+        if (result.empty())
+            add(resolution);
+        return result;
+    }
+
+    size_t UsingResolver::heap_bytes() const
+    {
+        size_t result = ifc::heap_bytes(usings_) + ifc::heap_bytes(aliases_);
+        for (auto const * slots : { &usings_, &aliases_ })
+        {
+            for (auto const & slot : *slots)
+            {
+                if (const auto targets = slot.load(std::memory_order_acquire))
+                    result += sizeof(Targets) + ifc::heap_bytes(*targets);
+            }
+        }
+        return result;
+    }
+}
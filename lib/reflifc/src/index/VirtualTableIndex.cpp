@@ -0,0 +1,165 @@
+#include "reflifc/index/VirtualTableIndex.h"
+#include "reflifc/index/BaseLinearization.h"
+#include "reflifc/index/TypeHashIndex.h"
+#include "reflifc/HashCombine.h"
+
+#include <ifc/File.h>
+#include <ifc/MemoryUsage.h>
+#include <ifc/Declaration.h>
+#include <ifc/Name.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+
+namespace reflifc
+{
+    namespace
+    {
+        bool has_flag(ifc::FunctionTraits traits, ifc::FunctionTraits flag)
+        {
+            return (static_cast<uint16_t>(traits) & static_cast<uint16_t>(flag)) != 0;
+        }
+
+        bool is_polymorphic_candidate(ifc::File const& file, ifc::ScopeDeclaration const& scope)
+        {
+            const auto kind = get_kind(scope, file);
+            return (kind == ifc::TypeBasis::Class || kind == ifc::TypeBasis::Struct) && !ifc::is_null(scope.initializer);
+        }
+
+        // Text naming the method for overriding, empty for conversion functions and other names.
+        std::optional<ifc::TextOffset> method_name(ifc::File const& file, ifc::NameIndex name)
+        {
+            switch (name.sort())
+            {
+            case ifc::NameSort::Identifier:
+                return ifc::TextOffset{ name.index };
+            case ifc::NameSort::Operator:
+                return file.operator_names()[name].encoded;
+            default:
+                return std::nullopt;
+            }
+        }
+
+        uint64_t method_signature(ifc::File const& file, ifc::TypeIndex type)
+        {
+            if (type.sort() != ifc::TypeSort::Method)
+                return 0;
+            auto const & method = file.method_types()[type];
+            const auto parameters = file.get_index<TypeHashIndex>().hash(file, method.source);
+            return hash_combine(0, parameters, static_cast<uint8_t>(method.traits));
+        }
+
+        bool still_loaded(VirtualTableIndex::Table const& table, ifc::Environment const& environment)
+        {
+            if (table.environment != &environment)
+                return false;
+            return std::ranges::all_of(table.files, [&](ifc::FileId id) { return environment.file(id) != nullptr; });
+        }
+    }
+
+    VirtualTableIndex::VirtualTableIndex(ifc::File const& file)
+        : classes_(file.has_partition(ifc::ScopeDeclaration::PartitionName) ? file.scope_declarations().size() : 0, file.memory_resource())
+    {
+    }
+
+    std::shared_ptr<VirtualTableIndex::Table const> VirtualTableIndex::find(ifc::File const& file, ifc::DeclIndex decl, ifc::Environment& environment) const
+    {
+        if (decl.sort() != ifc::DeclSort::Scope || decl.index >= classes_.size())
+            return nullptr;
+        if (!is_polymorphic_candidate(file, file.scope_declarations()[decl]))
+            return nullptr;
+
+        auto & slot = classes_[decl.index];
+        if (auto cached = slot.load(std::memory_order_acquire); cached && still_loaded(*cached, environment))
+            return cached;
+
+        // Built concurrently by other threads alike, the last one is kept.
+        auto table = build(file, decl, environment);
+        slot.store(table, std::memory_order_release);
+        return table;
+    }
+
+    std::shared_ptr<VirtualTableIndex::Table const> VirtualTableIndex::build(ifc::File const& file, ifc::DeclIndex decl, ifc::Environment& environment) const
+    {
+        auto result = std::make_shared<Table>();
+        result->environment = &environment;
+        auto & slots = result->slots;
+
+        for (auto [base_file, base_decl] : BaseLinearization::direct_bases(file, decl, environment))
+        {
+            const auto base = base_file->get_index<VirtualTableIndex>().find(*base_file, base_decl, environment);
+            if (!base)
+                continue;
+            // A virtual base reached through several bases has its slots once.
+            for (auto const & inherited : base->slots)
+            {
+                if (std::ranges::none_of(slots, [&](Slot const& slot) { return slot.introducer == inherited.introducer; }))
+                    slots.push_back(inherited);
+            }
+        }
+
+        // Conversion functions and the like are not matched, they only ever introduce slots.
+        const auto override_or_add = [&](Slot candidate, bool is_virtual, bool matched_by_name) {
+            bool overrides = false;
+            for (auto & slot : slots)
+            {
+                if (!matched_by_name || slot.name != candidate.name || slot.signature != candidate.signature)
+                    continue;
+                slot.overrider = candidate.overrider;
+                slot.pure = candidate.pure;
+                overrides = true;
+            }
+            if (!overrides && is_virtual)
+                slots.push_back(candidate);
+        };
+
+        auto const & scope = file.scope_declarations()[decl];
+        for (auto const & member : ifc::get_declarations(file, file.scope_descriptors()[scope.initializer]))
+        {
+            const auto id = environment.declaration_id(file, member.index);
+            if (member.index.sort() == ifc::DeclSort::Method)
+            {
+                auto const & method = file.methods()[member.index];
+                const auto name = method_name(file, method.name);
+                Slot candidate{
+                    .introducer = id,
+                    .overrider = id,
+                    .name = name ? environment.symbols().symbol(file, *name) : std::nullopt,
+                    .signature = method_signature(file, method.type),
+                    .pure = has_flag(method.traits, ifc::FunctionTraits::PureVirtual),
+                };
+                override_or_add(candidate, has_flag(method.traits, ifc::FunctionTraits::Virtual), candidate.name.has_value());
+            }
+            else if (member.index.sort() == ifc::DeclSort::Destructor)
+            {
+                auto const & destructor = file.destructors()[member.index];
+                override_or_add({
+                    .introducer = id,
+                    .overrider = id,
+                    .pure = has_flag(destructor.traits, ifc::FunctionTraits::PureVirtual),
+                }, has_flag(destructor.traits, ifc::FunctionTraits::Virtual), true);
+            }
+        }
+
+        for (auto const & slot : slots)
+        {
+            for (auto id : { slot.introducer.file, slot.overrider.file })
+            {
+                if (std::ranges::find(result->files, id) == result->files.end())
+                    result->files.push_back(id);
+            }
+        }
+        return result;
+    }
+
+    size_t VirtualTableIndex::heap_bytes() const
+    {
+        size_t result = ifc::heap_bytes(classes_);
+        for (auto const & slot : classes_)
+        {
+            if (const auto table = slot.load(std::memory_order_acquire))
+                result += sizeof(Table) + ifc::heap_bytes(table->files) + ifc::heap_bytes(table->slots);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <ifc/Declaration.h>
+#include <ifc/Expression.h>
+#include <ifc/File.h>
+#include <ifc/FileWriter.h>
+#include <ifc/Name.h>
+#include <ifc/Type.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// A BMI of hand-written records, written with the header and the string table of an existing file, so that
+// the records can name its strings as well as the ones added. The partitions of the original file are left
+// out unless copied.
+class SyntheticFile
+{
+public:
+    explicit SyntheticFile(ifc::File const& original)
+        : original_(original)
+        , writer_(original.header(), original.string_table())
+    {}
+
+    // Adds the partitions of the original file, in their order. The records of the `padded` ones get `padding`
+    // more bytes, as if a newer compiler had appended fields to them.
+    void copy_partitions(std::initializer_list<std::string_view> padded = {}, size_t padding = 0)
+    {
+        for (auto const& summary : original_.table_of_contents())
+        {
+            const auto entry_size = static_cast<size_t>(summary.entry_size);
+            const std::span<std::byte const> entries{ original_.get_data_pointer(summary), summary.size_bytes() };
+            if (std::ranges::find(padded, original_.get_string_view(summary.name)) == padded.end())
+            {
+                writer_.add_partition(summary.name, entries, entry_size);
+                continue;
+            }
+            std::vector<std::byte> padded_entries;
+            for (size_t i = 0; i != raw_count(summary.cardinality); ++i)
+            {
+                const auto entry = entries.subspan(i * entry_size, entry_size);
+                padded_entries.insert(padded_entries.end(), entry.begin(), entry.end());
+                padded_entries.insert(padded_entries.end(), padding, std::byte{ 0xAB });
+            }
+            writer_.add_partition(summary.name, padded_entries, entry_size + padding);
+        }
+    }
+
+    ifc::TextOffset text(std::string_view text)
+    {
+        return writer_.add_string(text);
+    }
+
+    ifc::NameIndex identifier(std::string_view text)
+    {
+        return { static_cast<uint32_t>(ifc::NameSort::Identifier), static_cast<uint32_t>(writer_.add_string(text)) };
+    }
+
+    // A partition named by the `PartitionName` of its records.
+    template<typename T>
+    void add(std::span<T const> records)
+    {
+        add(T::PartitionName, records);
+    }
+
+    template<typename T, size_t N>
+    void add(T const (&records)[N])
+    {
+        add(std::span<T const>(records));
+    }
+
+    template<typename T>
+    void add(T const& record)
+    {
+        add(std::span(&record, 1));
+    }
+
+    // A partition of records without a name of their own, like the heaps.
+    template<typename T>
+    void add(std::string_view name, std::span<T const> records)
+    {
+        writer_.add_partition(writer_.add_string(name), records);
+    }
+
+    template<typename T, size_t N>
+    void add(std::string_view name, T const (&records)[N])
+    {
+        add(name, std::span<T const>(records));
+    }
+
+    ifc::FileWriter& writer() { return writer_; }
+
+    std::vector<std::byte> write() const { return writer_.write(); }
+
+private:
+    ifc::File const& original_;
+    ifc::FileWriter writer_;
+};
+
+inline ifc::TypeIndex type(ifc::TypeSort sort, uint32_t index)
+{
+    return { static_cast<uint32_t>(sort), index };
+}
+
+inline ifc::DeclIndex decl(ifc::DeclSort sort, uint32_t index)
+{
+    return { static_cast<uint32_t>(sort), index };
+}
+
+inline ifc::ExprIndex expr(ifc::ExprSort sort, uint32_t index)
+{
+    return { static_cast<uint32_t>(sort), index };
+}
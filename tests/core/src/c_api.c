@@ -0,0 +1,18 @@
+/* Compiled as C, so that the interface stays usable from C. */
+#include <ifc/c_api.h>
+
+uint32_t count_declaration_partitions(const void* data, size_t size)
+{
+    ifc_file* file = ifc_file_open(data, size, 0);
+    uint32_t count = 0;
+    ifc_partition partition;
+    if (file == NULL)
+        return 0;
+    for (uint32_t i = 0; ifc_get_partition(file, i, &partition); ++i)
+    {
+        if (partition.name[0] == 'd' && partition.name[1] == 'e' && partition.name[2] == 'c' && partition.name[3] == 'l')
+            ++count;
+    }
+    ifc_file_close(file);
+    return count;
+}
@@ -1,12 +1,56 @@
-﻿#include <ifc/Attribute.h>
+﻿#include "SyntheticFile.h"
+
+#include <ifc/Attribute.h>
+#include <ifc/c_api.h>
+#include <ifc/Bundle.h>
+#include <ifc/Cancellation.h>
 #include <ifc/Declaration.h>
+#include <ifc/Expression.h>
 #include <ifc/File.h>
+#include <ifc/FileDiff.h>
+#include <ifc/FileWatcher.h>
+#include <ifc/FileWriter.h>
+#include <ifc/MaterializedColumn.h>
+#include <ifc/Parallel.h>
+#include <ifc/PostingLists.h>
+#include <ifc/SortFilter.h>
+#include <ifc/TextSearch.h>
+#include <ifc/Trace.h>
+#include <ifc/TraitIndex.h>
+#include <ifc/TrigramIndex.h>
 #include <ifc/Type.h>
 #include <ifc/blob_reader.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 static std::filesystem::path data_dir;
 
@@ -17,19 +61,19 @@ class FileWrapper
 public:
     ifc::File file;
 
-    FileWrapper(std::filesystem::path const & path_to_ifc)
+    FileWrapper(std::filesystem::path const & path_to_ifc, ifc::FileOptions options)
         : blob_(ifc::read_blob(path_to_ifc))
-        , file(blob_->view())
+        , file(blob_->view(), options)
     {}
 
 public:
-    static FileWrapper create(const char* filepath)
+    static FileWrapper create(const char* filepath, ifc::FileOptions options = {})
     {
         const auto path_to_ifc = data_dir / filepath;
         if (!is_regular_file(path_to_ifc))
             throw std::logic_error("'" + path_to_ifc.string() + "' is not regular file");
 
-        return FileWrapper(path_to_ifc);
+        return FileWrapper(path_to_ifc, options);
     }
 };
 
@@ -116,6 +160,1533 @@ TEST(SimpleTest, attributes)
     }
 }
 
+TEST(SimpleTest, eager_partitions)
+{
+    const auto lazy_wrapper = FileWrapper::create("attributes.ixx.ifc");
+    const auto eager_wrapper = FileWrapper::create("attributes.ixx.ifc", { .eager_partitions = true });
+    auto const& lazy = lazy_wrapper.file;
+    auto const& eager = eager_wrapper.file;
+
+    ASSERT_EQ(eager.declarations().size(), lazy.declarations().size());
+    ASSERT_EQ(eager.functions().size(), lazy.functions().size());
+    ASSERT_EQ(eager.scope_descriptors().size(), lazy.scope_descriptors().size());
+    ASSERT_EQ(get_declarations(eager, eager.global_scope()).size(), 5);
+    ASSERT_EQ(eager.trait_declaration_attributes(get_declarations(eager, eager.global_scope())[ifc::Index{0}].index).size(), 1);
+}
+
+TEST(SimpleTest, string_views)
+{
+    const auto plain_wrapper = FileWrapper::create("attributes.ixx.ifc");
+    const auto indexed_wrapper = FileWrapper::create("attributes.ixx.ifc", { .index_string_lengths = true });
+
+    for (auto const * wrapper : { &plain_wrapper, &indexed_wrapper })
+    {
+        auto const& file = wrapper->file;
+        for (auto const& function : file.functions())
+        {
+            const auto offset = ifc::TextOffset{function.name.index};
+            ASSERT_EQ(file.get_string_view(offset), std::string_view(file.get_string(offset)));
+            // Offsets pointing into the middle of a string share its terminator.
+            const auto suffix = ifc::TextOffset{static_cast<uint32_t>(function.name.index) + 1};
+            ASSERT_EQ(file.get_string_view(suffix).size(), std::strlen(file.get_string(suffix)));
+        }
+        ASSERT_EQ(file.get_string_view(file.header().src_path), std::string_view(file.get_string(file.header().src_path)));
+    }
+}
+
+TEST(SimpleTest, interned_texts)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+
+    auto const& function = file.functions()[get_declarations(file, file.global_scope())[ifc::Index{0}].index];
+    const auto name = ifc::TextOffset{function.name.index};
+    ASSERT_EQ(file.find_text("a"), name);
+    ASSERT_EQ(file.find_text("no such identifier"), std::nullopt);
+
+    const auto symbol = file.text_symbol(name);
+    ASSERT_TRUE(symbol.has_value());
+    ASSERT_NE(file.text_symbol(*file.find_text("b")), symbol);
+    ASSERT_LT(*symbol, file.text_symbol_count());
+    ASSERT_EQ(file.symbol_text(*symbol), name);
+}
+
+TEST(SimpleTest, stats)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+
+    ASSERT_EQ(file.functions().size(), 2);
+    ASSERT_EQ(file.functions().size(), 2);
+    ASSERT_TRUE(file.trait_declaration_attributes(file.declarations()[ifc::Index{0}].index).size() <= 1);
+
+    const auto stats = file.stats();
+#ifdef IFC_FILE_STATS
+    ASSERT_TRUE(stats.enabled);
+    ASSERT_GE(stats.partitions.size(), 2);
+    ASSERT_EQ(stats.partitions[0].name, std::string_view(ifc::FunctionDeclaration::PartitionName));
+    ASSERT_EQ(stats.partitions[0].accesses, 2);
+    ASSERT_EQ(stats.partitions[1].name, std::string_view(ifc::Declaration::PartitionName));
+    ASSERT_LE(stats.partitions[0].first_access, stats.partitions[1].first_access);
+    ASSERT_TRUE(std::ranges::any_of(stats.builds, [](auto const& build) { return build.name == "trait_declaration_attributes"; }));
+#else
+    ASSERT_FALSE(stats.enabled);
+    ASSERT_TRUE(stats.partitions.empty());
+    ASSERT_TRUE(stats.builds.empty());
+#endif
+}
+
+TEST(SimpleTest, trace)
+{
+    struct Recorder : ifc::TraceSink
+    {
+        std::mutex mutex;
+        std::vector<std::string> names;
+
+        void complete(std::string_view name, std::string_view, std::string_view, Clock::time_point, Clock::duration) override
+        {
+            std::scoped_lock lock(mutex);
+            names.emplace_back(name);
+        }
+    } recorder;
+
+    ifc::set_trace_sink(&recorder);
+    {
+        const auto wrapper = FileWrapper::create("attributes.ixx.ifc", { .verify_checksum = true });
+        auto const& file = wrapper.file;
+        (void)file.trait_declaration_attributes(file.declarations()[ifc::Index{0}].index);
+    }
+    ifc::set_trace_sink(nullptr);
+
+    const std::vector<std::string> expected{ "verify_checksum", "File", "trait_declaration_attributes" };
+    ASSERT_EQ(recorder.names, expected);
+
+    std::ostringstream json;
+    {
+        ifc::ChromeTraceWriter writer(json);
+        const auto now = ifc::TraceSink::Clock::now();
+        writer.complete("File", "file", "C:\\module \"a\".ifc", now, std::chrono::microseconds(5));
+    }
+    ASSERT_NE(json.str().find(R"("name":"File","cat":"file","ph":"X")"), std::string::npos);
+    ASSERT_NE(json.str().find(R"("dur":5,"pid":1,"tid":1,"args":{"detail":"C:\\module \"a\".ifc"}})"), std::string::npos);
+    ASSERT_EQ(json.str().substr(json.str().size() - 4), "\n]}\n");
+}
+
+TEST(SimpleTest, memory_usage)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+
+    auto usage = file.memory_usage();
+    ASSERT_EQ(usage.mapped_bytes, file.blob().size());
+    ASSERT_TRUE(usage.heap.empty());
+#ifdef __linux__
+    ASSERT_TRUE(usage.resident_bytes.has_value());
+    ASSERT_LE(*usage.resident_bytes, usage.mapped_bytes);
+#endif
+
+    (void)file.trait_declaration_attributes(file.declarations()[ifc::Index{0}].index);
+    usage = file.memory_usage();
+    ASSERT_EQ(usage.heap.size(), 1);
+    ASSERT_EQ(usage.heap[0].name, "trait_declaration_attributes");
+    ASSERT_EQ(usage.heap_bytes(), usage.heap[0].bytes);
+}
+
+TEST(SimpleTest, access_profile)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+    ASSERT_TRUE(file.accessed_partitions().empty());
+
+    ASSERT_GT(file.functions().size(), 0);
+    ASSERT_EQ(file.accessed_partitions(), std::vector<std::string_view>{ "decl.function" });
+
+    ifc::AccessProfile profile;
+    profile.record(file);
+    profile.record(file);
+    ASSERT_EQ(profile.partitions, std::vector<std::string>{ "decl.function" });
+    const auto ranges = profile.ranges(file);
+    ASSERT_EQ(ranges.size(), 1);
+    ASSERT_EQ(ranges.front().data(), file.partitions_data("decl.function").front().data());
+
+    ASSERT_EQ(profile.serialize(), "decl.function\n");
+    ASSERT_EQ(ifc::AccessProfile::parse("type.base\r\n\ndecl.function\ntype.base").partitions,
+              (std::vector<std::string>{ "decl.function", "type.base" }));
+    ASSERT_TRUE(ifc::AccessProfile::parse("").partitions.empty());
+}
+
+TEST(SimpleTest, trim)
+{
+    struct FunctionNameLengths
+    {
+        explicit FunctionNameLengths(ifc::File const& file)
+        {
+            for (auto const & function : file.functions())
+                lengths.push_back(file.get_string_view(ifc::TextOffset{ function.name.index }).size());
+        }
+
+        size_t heap_bytes() const { return ifc::heap_bytes(lengths); }
+
+        std::vector<size_t> lengths;
+    };
+
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+    const auto decl = file.declarations()[ifc::Index{0}].index;
+    const auto attributes = file.trait_declaration_attributes(decl).size();
+    const auto lengths = file.get_index<FunctionNameLengths>().lengths;
+    ASSERT_TRUE(file.find_text("a"));
+    ASSERT_EQ(file.memory_usage().heap.size(), 4);
+
+    // Everything was used since the File was created, the second trim drops what was not used since the first.
+    ASSERT_EQ(file.trim(ifc::TrimLevel::Cold), 0);
+    (void)file.get_index<FunctionNameLengths>();
+    ASSERT_GT(file.trim(ifc::TrimLevel::Cold), 0);
+    auto usage = file.memory_usage();
+    ASSERT_EQ(usage.heap.size(), 3);
+    ASSERT_TRUE(std::ranges::any_of(usage.heap, [](auto const& heap) { return heap.name == typeid(FunctionNameLengths).name(); }));
+
+    // Rebuilt on next use.
+    ASSERT_GT(file.trim(ifc::TrimLevel::Indexes), 0);
+    ASSERT_EQ(file.memory_usage().heap.size(), 2);
+    ASSERT_EQ(file.trait_declaration_attributes(decl).size(), attributes);
+    ASSERT_EQ(file.get_index<FunctionNameLengths>().lengths, lengths);
+
+    ASSERT_GT(file.trim(ifc::TrimLevel::All), 0);
+    ASSERT_TRUE(file.memory_usage().heap.empty());
+    ASSERT_TRUE(file.find_text("a"));
+}
+
+TEST(SimpleTest, memory_resource)
+{
+    // Counts what is outstanding, for checking that the File returns all of it.
+    struct CountingResource : std::pmr::memory_resource
+    {
+        std::atomic<size_t> allocations = 0;
+        std::atomic<size_t> outstanding = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            outstanding += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    for (const bool arena : { false, true })
+    {
+        CountingResource resource;
+        {
+            const auto wrapper = FileWrapper::create("attributes.ixx.ifc", { .index_string_lengths = true, .memory_resource = &resource, .arena = arena });
+            auto const& file = wrapper.file;
+            ASSERT_EQ(file.memory_resource() == &resource, !arena);
+
+            (void)file.trait_declaration_attributes(file.declarations()[ifc::Index{0}].index);
+            const ifc::TextOffset name{ file.functions().begin()->name.index };
+            ASSERT_EQ(file.get_string_view(name), file.get_string(name));
+            ASSERT_GT(resource.allocations, 0);
+            ASSERT_GT(resource.outstanding, 0);
+        }
+        ASSERT_EQ(resource.outstanding, 0);
+    }
+}
+
+TEST(SortFilter, find_sort)
+{
+    // Longer than a block, with matches at both ends and in the tail.
+    std::vector<ifc::Declaration> members(150);
+    for (size_t i = 0; i != members.size(); ++i)
+    {
+        const auto sort = i % 3 == 0 ? ifc::DeclSort::Field : ifc::DeclSort::Function;
+        members[i].index = { static_cast<uint32_t>(sort), static_cast<uint32_t>(i) };
+    }
+
+    std::vector<uint32_t> positions = { 42 };
+    ifc::find_sort(std::span<ifc::Declaration const>(members), ifc::DeclSort::Field, positions);
+    ASSERT_EQ(positions.size(), 50);
+    for (size_t i = 0; i != positions.size(); ++i)
+        ASSERT_EQ(positions[i], 3 * i);
+
+    std::vector<ifc::DeclIndex> references;
+    for (auto const & member : members)
+        references.push_back(member.index);
+    ifc::find_sort(std::span<ifc::DeclIndex const>(references), ifc::DeclSort::Function, positions);
+    ASSERT_EQ(positions.size(), 100);
+    ASSERT_EQ(positions.front(), 1);
+    ASSERT_EQ(positions.back(), 149);
+
+    ifc::find_sort(std::span<ifc::DeclIndex const>(references), ifc::DeclSort::Variable, positions);
+    ASSERT_TRUE(positions.empty());
+}
+
+TEST(SortFilter, count_sorts)
+{
+    // Not a multiple of the lane count, with a run of equal sorts.
+    std::vector<ifc::DeclIndex> references;
+    for (uint32_t i = 0; i != 103; ++i)
+        references.push_back({ static_cast<uint32_t>(i < 60 ? ifc::DeclSort::Function : i % 2 ? ifc::DeclSort::Field : ifc::DeclSort::Scope), i });
+
+    std::array<size_t, ifc::DeclIndex::SortCount> counts{};
+    counts[static_cast<size_t>(ifc::DeclSort::Field)] = 1;
+    ifc::count_sorts(std::span<ifc::DeclIndex const>(references), std::span(counts));
+    ASSERT_EQ(counts[static_cast<size_t>(ifc::DeclSort::Function)], 60);
+    ASSERT_EQ(counts[static_cast<size_t>(ifc::DeclSort::Field)], 1 + 21);
+    ASSERT_EQ(counts[static_cast<size_t>(ifc::DeclSort::Scope)], 22);
+    ASSERT_EQ(std::accumulate(counts.begin(), counts.end(), size_t{ 0 }), 1 + references.size());
+
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    counts.fill(0);
+    ifc::count_sorts(wrapper.file.declarations(), std::span(counts));
+    std::vector<uint32_t> positions;
+    ifc::find_sort(wrapper.file.declarations(), ifc::DeclSort::Function, positions);
+    ASSERT_EQ(counts[static_cast<size_t>(ifc::DeclSort::Function)], positions.size());
+}
+
+TEST(TextSearch, find_text_ranges)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+    const auto maybe_unused = file.find_text("maybe_unused");
+    const auto noreturn = file.find_text("noreturn");
+    ASSERT_TRUE(maybe_unused && noreturn);
+
+    std::vector<ifc::TextRange> ranges;
+    ifc::find_text_ranges(file, "maybe", ifc::TextMatch::Prefix, ranges);
+    ASSERT_TRUE(ifc::contains(ranges, *maybe_unused));
+    ASSERT_FALSE(ifc::contains(ranges, *noreturn));
+
+    ifc::find_text_ranges(file, "_unused", ifc::TextMatch::Prefix, ranges);
+    ASSERT_FALSE(ifc::contains(ranges, *maybe_unused));
+
+    ifc::find_text_ranges(file, "_unused", ifc::TextMatch::Substring, ranges);
+    ASSERT_TRUE(ifc::contains(ranges, *maybe_unused));
+    ASSERT_FALSE(ifc::contains(ranges, *noreturn));
+    for (size_t i = 1; i < ranges.size(); ++i)
+        ASSERT_LE(ranges[i - 1].end, ranges[i].start);
+
+    ifc::find_text_ranges(file, "no such text", ifc::TextMatch::Substring, ranges);
+    ASSERT_TRUE(ranges.empty());
+}
+
+namespace
+{
+    struct FunctionCount
+    {
+        static constexpr std::string_view Partitions[] = { "decl.function" };
+
+        explicit FunctionCount(ifc::File const& file)
+            : count(file.functions().size())
+        {}
+
+        size_t count;
+    };
+
+    // Without declared partitions, never shared.
+    struct GlobalScopeSize
+    {
+        explicit GlobalScopeSize(ifc::File const& file)
+            : size(raw_count(file.global_scope().cardinality))
+        {}
+
+        size_t size;
+    };
+}
+
+TEST(FileDiff, adopt_indexes)
+{
+    const auto first = FileWrapper::create("attributes.ixx.ifc");
+    const auto second = FileWrapper::create("attributes.ixx.ifc");
+    const auto other = FileWrapper::create("empty.ixx.ifc");
+
+    const auto same = ifc::diff_files(first.file, second.file);
+    ASSERT_TRUE(same.identical);
+    ASSERT_FALSE(same.changed("decl."));
+
+    const auto diff = ifc::diff_files(first.file, other.file);
+    ASSERT_FALSE(diff.identical);
+    ASSERT_TRUE(diff.strings_changed);
+    ASSERT_TRUE(diff.changed("decl."));
+    ASSERT_TRUE(diff.changed("decl.function"));
+    ASSERT_FALSE(diff.changed("decl.missing"));
+    ASSERT_FALSE(diff.changed_declarations.empty());
+    ASSERT_TRUE(std::ranges::is_sorted(diff.changed_declarations));
+
+    auto const& count = first.file.get_index<FunctionCount>();
+    auto const& size = first.file.get_index<GlobalScopeSize>();
+    ASSERT_EQ(other.file.adopt_indexes(first.file, diff), 0);
+    ASSERT_EQ(second.file.adopt_indexes(first.file, same), 1);
+    ASSERT_EQ(&second.file.get_index<FunctionCount>(), &count);
+    ASSERT_NE(&second.file.get_index<GlobalScopeSize>(), &size);
+    ASSERT_EQ(second.file.get_index<GlobalScopeSize>().size, size.size);
+}
+
+TEST(FileWatcher, reports_changes)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "ifc-reader-file-watcher";
+    std::filesystem::create_directories(directory);
+    const auto watched = directory / "watched.ifc";
+    const auto other = directory / "other.ifc";
+    std::ofstream(watched) << "before";
+
+    std::mutex mutex;
+    std::vector<std::filesystem::path> changes;
+    ifc::FileWatcher watcher([&](std::filesystem::path const& path) {
+        std::scoped_lock lock(mutex);
+        changes.push_back(path);
+    }, std::chrono::milliseconds(10));
+    watcher.watch(watched);
+
+    std::ofstream(other) << "unwatched";
+    std::ofstream(watched) << "after, of another size";
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    bool changed = false;
+    while (!changed && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::scoped_lock lock(mutex);
+        changed = !changes.empty();
+    }
+
+    std::scoped_lock lock(mutex);
+    ASSERT_TRUE(changed);
+    for (auto const & path : changes)
+        ASSERT_EQ(path, watched);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(FileWatcher, directory_recreated)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "ifc-reader-file-watcher-recreated";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto watched = directory / "watched.ifc";
+    std::ofstream(watched) << "before";
+
+    std::mutex mutex;
+    std::vector<std::filesystem::path> changes;
+    ifc::FileWatcher watcher([&](std::filesystem::path const& path) {
+        std::scoped_lock lock(mutex);
+        changes.push_back(path);
+    }, std::chrono::milliseconds(10));
+    watcher.watch(watched);
+
+    // Waits for a change, then for the ones reported with it, and forgets them.
+    const auto changed = [&] {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        for (bool found = false; !found && std::chrono::steady_clock::now() < deadline;)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            std::scoped_lock lock(mutex);
+            found = !changes.empty();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::scoped_lock lock(mutex);
+        const bool result = !changes.empty() && std::ranges::all_of(changes, [&](auto const& path) { return path == watched; });
+        changes.clear();
+        return result;
+    };
+
+    std::filesystem::remove_all(directory);
+    ASSERT_TRUE(changed());
+
+    // Only the directory watched again reports the file, then its later changes.
+    std::filesystem::create_directories(directory);
+    std::ofstream(watched) << "after";
+    ASSERT_TRUE(changed());
+    std::ofstream(watched) << "after, of another size";
+    ASSERT_TRUE(changed());
+    std::filesystem::remove_all(directory);
+}
+
+// In c_api.c.
+extern "C" uint32_t count_declaration_partitions(const void* data, size_t size);
+
+TEST(CApi, partitions_in_place)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    const auto blob = wrapper.file.blob();
+
+    const auto file = ifc_file_open(blob.data(), blob.size(), IFC_OPEN_VERIFY_CHECKSUM);
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(ifc_partition_count(file), wrapper.file.table_of_contents().size());
+
+    ifc_partition functions;
+    ASSERT_TRUE(ifc_find_partition(file, "decl.function", &functions));
+    ASSERT_EQ(functions.data, wrapper.file.functions().data());
+    ASSERT_EQ(functions.count, wrapper.file.functions().size());
+    ASSERT_EQ(functions.entry_size, sizeof(ifc::FunctionDeclaration));
+    ifc_partition missing;
+    ASSERT_FALSE(ifc_find_partition(file, "decl.missing", &missing));
+    ASSERT_FALSE(ifc_get_partition(file, ifc_partition_count(file), &missing));
+
+    size_t strings_size;
+    const auto strings = ifc_string_table(file, &strings_size);
+    ASSERT_GT(strings_size, 0);
+    const auto name = wrapper.file.functions()[ifc::DeclIndex{ static_cast<uint32_t>(ifc::DeclSort::Function), 0 }].name;
+    ASSERT_EQ(ifc_get_string(file, name.index), strings + name.index);
+    ASSERT_EQ(ifc_get_string(file, static_cast<uint32_t>(strings_size)), nullptr);
+    ASSERT_EQ(ifc_global_scope(file), static_cast<uint32_t>(wrapper.file.header().global_scope));
+    ifc_file_close(file);
+
+    ASSERT_GT(count_declaration_partitions(blob.data(), blob.size()), 0);
+
+    const char garbage[64] = {};
+    ASSERT_EQ(ifc_file_open(garbage, sizeof(garbage), 0), nullptr);
+    ASSERT_NE(std::string_view(ifc_last_error()), "");
+}
+
+TEST(CApi, partition_fields)
+{
+    {
+        const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+        auto const & file = wrapper.file;
+        size_t described = 0;
+        for (auto const & partition : file.table_of_contents())
+        {
+            // Vendor partitions and those the reader does not model have no layout.
+            uint32_t count = 0, record_size = 0;
+            const auto fields = ifc_partition_fields(file.get_string(partition.name), &count, &record_size);
+            if (fields == nullptr)
+                continue;
+            ++described;
+            ASSERT_LE(record_size, static_cast<size_t>(partition.entry_size));
+
+            // Members in order, without overlaps, within the record.
+            uint32_t end = 0;
+            for (uint32_t i = 0; i != count; ++i)
+            {
+                ASSERT_GE(fields[i].offset, end) << fields[i].name;
+                end = fields[i].offset + fields[i].size * fields[i].count;
+            }
+            ASSERT_LE(end, record_size);
+        }
+        ASSERT_GT(described, file.table_of_contents().size() / 2);
+    }
+
+    uint32_t count = 0, record_size = 0;
+    const auto fields = ifc_partition_fields("decl.function", &count, &record_size);
+    ASSERT_EQ(record_size, sizeof(ifc::FunctionDeclaration));
+    ASSERT_EQ(std::string_view(fields[0].name), "name");
+    ASSERT_EQ(fields[0].kind, IFC_FIELD_REFERENCE);
+    ASSERT_EQ(fields[0].sort_bits, 3);
+    ASSERT_EQ(std::string_view(fields[1].name), "locus.line");
+    ASSERT_EQ(fields[1].offset, offsetof(ifc::FunctionDeclaration, locus));
+    ASSERT_EQ(fields[1].kind, IFC_FIELD_UNSIGNED);
+
+    const auto dyad = ifc_partition_fields("expr.dyad", &count, &record_size);
+    const auto arguments = std::ranges::find(dyad, dyad + count, std::string_view("arguments"), &ifc_field::name);
+    ASSERT_EQ(arguments->count, 2);
+    ASSERT_EQ(ifc_partition_fields(".vendor.unknown", &count, &record_size), nullptr);
+}
+
+TEST(Partition, columns)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const & file = wrapper.file;
+    const auto functions = file.functions();
+    ASSERT_GT(functions.size(), 0);
+
+    const auto names = functions.column(&ifc::FunctionDeclaration::name);
+    static_assert(std::ranges::random_access_range<decltype(names)>);
+    ASSERT_EQ(names.size(), functions.size());
+    ASSERT_EQ(names.end() - names.begin(), static_cast<std::ptrdiff_t>(functions.size()));
+    for (size_t i = 0; i != functions.size(); ++i)
+    {
+        ASSERT_EQ(&names.begin()[static_cast<std::ptrdiff_t>(i)], &functions.data()[i].name);
+        const ifc::DeclIndex decl{ static_cast<uint32_t>(ifc::DeclSort::Function), static_cast<uint32_t>(i) };
+        ASSERT_EQ(&names[decl], &functions.data()[i].name);
+    }
+
+    using FunctionNames = ifc::MaterializedColumn<&ifc::File::functions, &ifc::FunctionDeclaration::name>;
+    auto const & materialized = file.get_index<FunctionNames>();
+    ASSERT_TRUE(std::ranges::equal(materialized.values(), names));
+    ASSERT_EQ(&materialized, &file.get_index<FunctionNames>());
+
+    using ConceptNames = ifc::MaterializedColumn<&ifc::File::concepts, &ifc::Concept::name>;
+    ASSERT_FALSE(file.has_partition(ifc::Concept::PartitionName));
+    ASSERT_TRUE(file.get_index<ConceptNames>().values().empty());
+}
+
+TEST(SimpleTest, concurrent_first_use)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+
+    std::vector<size_t> attributes_counts(8);
+    {
+        std::vector<std::jthread> threads;
+        for (auto & count : attributes_counts)
+        {
+            threads.emplace_back([&file, &count] {
+                for (auto decl : get_declarations(file, file.global_scope()))
+                    count += file.trait_declaration_attributes(decl.index).size();
+            });
+        }
+    }
+
+    for (auto count : attributes_counts)
+        ASSERT_EQ(count, 5);
+}
+
+TEST(SimpleTest, verify_checksum)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc", { .verify_checksum = true });
+
+    const auto view = wrapper.file.blob();
+    std::vector<std::byte> corrupted(view.begin(), view.end());
+    corrupted[corrupted.size() / 2] ^= std::byte{ 1 };
+    ASSERT_NO_THROW(ifc::File{ corrupted });
+    ASSERT_THROW((ifc::File{ corrupted, { .verify_checksum = true } }), std::runtime_error);
+}
+
+TEST(SimpleTest, validate)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const & file = wrapper.file;
+    ASSERT_FALSE(file.trusted());
+    const auto declarations = file.declarations();
+    ASSERT_TRUE(declarations.checked());
+    ASSERT_THROW(declarations.drop(declarations.size() + 1), std::out_of_range);
+
+    // Records hold references the validation does not check, like the home scopes of declarations.
+    file.validate();
+    ASSERT_NO_THROW(file.validation_status().get());
+    ASSERT_FALSE(file.trusted());
+    ASSERT_TRUE(file.declarations().checked());
+    const ifc::DeclIndex scope_out_of_bounds{ static_cast<uint32_t>(ifc::DeclSort::Scope), ~0u >> 5 };
+    ASSERT_THROW(file.scope_declarations()[scope_out_of_bounds], std::out_of_range);
+    ASSERT_FALSE((ifc::File{ file.blob(), { .validate = true } }.trusted()));
+
+    const ifc::File trusted{ file.blob(), { .trusted = true } };
+    ASSERT_TRUE(trusted.trusted());
+    ASSERT_FALSE(trusted.declarations().checked());
+
+    // Corrupted copies, through the table of contents in them.
+    const auto view = file.blob();
+    const auto summary_offset = [&](std::string_view name) {
+        for (auto const & partition : file.table_of_contents())
+        {
+            if (file.get_string_view(partition.name) == name)
+                return static_cast<size_t>(reinterpret_cast<std::byte const*>(&partition) - view.data());
+        }
+        throw std::logic_error("no partition " + std::string(name));
+    };
+
+    // A member out of the partition of its sort.
+    std::vector<std::byte> member_out_of_bounds(view.begin(), view.end());
+    ifc::PartitionSummary members;
+    std::memcpy(&members, member_out_of_bounds.data() + summary_offset(ifc::Declaration::PartitionName), sizeof(members));
+    ASSERT_GT(raw_count(members.cardinality), 0u);
+    ifc::DeclIndex member;
+    std::memcpy(&member, member_out_of_bounds.data() + static_cast<size_t>(members.offset), sizeof(member));
+    member.index = ~0u >> 5;
+    std::memcpy(member_out_of_bounds.data() + static_cast<size_t>(members.offset), &member, sizeof(member));
+    const ifc::File unchecked_member{ member_out_of_bounds };
+    ASSERT_THROW(unchecked_member.validate(), std::runtime_error);
+    ASSERT_FALSE(unchecked_member.validation_status().valid());
+    ASSERT_THROW((ifc::File{ member_out_of_bounds, { .validate = true } }), std::runtime_error);
+
+    // A partition out of the blob, with the sizes still adding up.
+    std::vector<std::byte> partition_out_of_bounds(view.begin(), view.end());
+    const auto offset = summary_offset(ifc::Declaration::PartitionName) + offsetof(ifc::PartitionSummary, offset);
+    const auto outside = static_cast<uint32_t>(view.size());
+    std::memcpy(partition_out_of_bounds.data() + offset, &outside, sizeof(outside));
+    ASSERT_THROW(ifc::File{ partition_out_of_bounds }, std::runtime_error);
+}
+
+TEST(SimpleTest, validate_in_background)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const & file = wrapper.file;
+    ASSERT_FALSE(file.validation_status().valid());
+
+    const ifc::File background{ file.blob(), { .validate_in_background = true } };
+    ASSERT_GT(background.declarations().size(), 0u);
+    const auto status = background.validation_status();
+    ASSERT_TRUE(status.valid());
+    ASSERT_NO_THROW(status.get());
+    ASSERT_TRUE(background.declarations().checked());
+
+    file.validate();
+    ASSERT_NO_THROW(file.validation_status().get());
+
+    // A member out of the partition of its sort, found after construction.
+    const auto view = file.blob();
+    std::vector<std::byte> corrupted(view.begin(), view.end());
+    const auto members = file.partitions_data(ifc::Declaration::PartitionName).front();
+    ifc::DeclIndex member;
+    const auto member_offset = static_cast<size_t>(members.data() - view.data());
+    std::memcpy(&member, corrupted.data() + member_offset, sizeof(member));
+    member.index = ~0u >> 5;
+    std::memcpy(corrupted.data() + member_offset, &member, sizeof(member));
+    const ifc::File unchecked{ corrupted, { .validate_in_background = true } };
+    ASSERT_TRUE(unchecked.declarations().checked());
+    ASSERT_THROW(unchecked.validation_status().get(), std::runtime_error);
+    ASSERT_FALSE(unchecked.trusted());
+}
+
+TEST(SimpleTest, prefetch_partitions)
+{
+    const auto blob = ifc::blob_reader({ .access = ifc::BlobAccess::Random })(data_dir / "attributes.ixx.ifc");
+    const ifc::File file(blob->view());
+
+    const auto declarations = file.partitions_data("decl.");
+    ASSERT_FALSE(declarations.empty());
+    for (auto partition : declarations)
+    {
+        ASSERT_GE(partition.data(), file.blob().data());
+        ASSERT_LE(partition.data() + partition.size(), file.blob().data() + file.blob().size());
+        blob->prefetch(partition);
+    }
+    ASSERT_TRUE(file.partitions_data("no such partition").empty());
+}
+
+TEST(SimpleTest, blob_backings)
+{
+    const auto path = data_dir / "attributes.ixx.ifc";
+    const auto mapped = ifc::read_blob(path);
+    const auto expected = mapped->view();
+
+    for (auto backing : { ifc::BlobBacking::MappedPopulated, ifc::BlobBacking::HugePageBuffer, ifc::BlobBacking::DirectRead })
+    {
+        const auto blob = ifc::blob_reader({ .backing = backing })(path);
+        const auto view = blob->view();
+        ASSERT_TRUE(std::ranges::equal(view, expected));
+        ASSERT_EQ(ifc::File(view).functions().size(), 2);
+    }
+}
+
+TEST(SimpleTest, side_index)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "ifc-side-index-test";
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "attributes.ixx.ifc";
+    std::filesystem::copy_file(data_dir / "attributes.ixx.ifc", path, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::remove(ifc::side_index_path(path));
+
+    const auto reader = ifc::blob_reader({ .side_index = true });
+    {
+        const auto blob = reader(path);
+        ASSERT_TRUE(blob->side_index().empty());
+        const ifc::File file(blob->view(), { .side_index = blob->side_index() });
+        ASSERT_FALSE(file.has_side_index());
+        blob->side_index_missing(file);
+    }
+
+    const auto blob = reader(path);
+    ASSERT_FALSE(blob->side_index().empty());
+    const ifc::File indexed(blob->view(), { .index_string_lengths = true, .side_index = blob->side_index() });
+    ASSERT_TRUE(indexed.has_side_index());
+
+    const auto plain_blob = ifc::read_blob(path);
+    const ifc::File plain(plain_blob->view());
+    ASSERT_TRUE(std::ranges::equal(indexed.side_index(), plain.side_index()));
+    for (auto const& function : plain.functions())
+    {
+        const auto name = ifc::TextOffset{ function.name.index };
+        ASSERT_EQ(indexed.get_string_view(name), plain.get_string_view(name));
+        ASSERT_EQ(indexed.find_text(plain.get_string_view(name)), plain.find_text(plain.get_string_view(name)));
+        ASSERT_EQ(indexed.text_symbol(name), plain.text_symbol(name));
+        ASSERT_TRUE(indexed.may_contain_text(plain.get_string_view(name)));
+        ASSERT_TRUE(plain.may_contain_text(plain.get_string_view(name)));
+    }
+
+    // The text filter rejects most absent texts.
+    int false_positives = 0;
+    for (int i = 0; i != 1000; ++i)
+    {
+        const auto absent = "absent_name_" + std::to_string(i);
+        ASSERT_FALSE(indexed.find_text(absent));
+        false_positives += indexed.may_contain_text(absent);
+    }
+    ASSERT_LT(false_positives, 50);
+
+    // Side indexes of other files are ignored.
+    const auto other_blob = ifc::read_blob(data_dir / "empty.ixx.ifc");
+    ASSERT_FALSE((ifc::File{ other_blob->view(), { .side_index = blob->side_index() } }.has_side_index()));
+
+    std::filesystem::remove_all(directory);
+}
+
+
+TEST(SimpleTest, shared_side_index)
+{
+    const auto path = data_dir / "attributes.ixx.ifc";
+    ifc::remove_shared_side_index(ifc::read_blob(path)->view());
+
+    // Holders of other processes map the segment like holders of the same process.
+    const auto reader = ifc::blob_reader({ .shared_side_index = true });
+    const auto publisher = reader(path);
+    ASSERT_TRUE(publisher->side_index().empty());
+    {
+        const ifc::File file(publisher->view(), { .side_index = publisher->side_index() });
+        publisher->side_index_missing(file);
+    }
+
+    const auto blob = reader(path);
+    ASSERT_FALSE(blob->side_index().empty());
+    const ifc::File indexed(blob->view(), { .side_index = blob->side_index() });
+    ASSERT_TRUE(indexed.has_side_index());
+
+    const auto plain_blob = ifc::read_blob(path);
+    const ifc::File plain(plain_blob->view());
+    ASSERT_TRUE(std::ranges::equal(indexed.side_index(), plain.side_index()));
+#if !defined(_WIN32)
+    ASSERT_TRUE(ifc::remove_shared_side_index(blob->view()));
+#endif
+}
+
+#if !defined(_WIN32)
+TEST(SimpleTest, shared_side_index_stale)
+{
+    const auto path = data_dir / "attributes.ixx.ifc";
+    const auto name = ifc::shared_side_index_name(ifc::read_blob(path)->view());
+    const auto reader = ifc::blob_reader({ .shared_side_index = true });
+    const auto publish = [&] {
+        const auto publisher = reader(path);
+        const ifc::File file(publisher->view(), { .side_index = publisher->side_index() });
+        publisher->side_index_missing(file);
+    };
+    const auto mode = [&] {
+        struct stat status{};
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        fstat(fd, &status);
+        close(fd);
+        return status.st_mode & 0777;
+    };
+
+    // An unpublished segment: its state, creator and size.
+    const auto leave_segment = [&](mode_t mode, pid_t creator) {
+        shm_unlink(name.c_str());
+        const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, mode);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(fchmod(fd, mode), 0); // Past the umask
+        const uint32_t header[4] = { 0, static_cast<uint32_t>(creator), 0, 0 };
+        ASSERT_EQ(ftruncate(fd, sizeof(header)), 0);
+        auto segment = mmap(nullptr, sizeof(header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ASSERT_NE(segment, MAP_FAILED);
+        std::memcpy(segment, header, sizeof(header));
+        munmap(segment, sizeof(header));
+        close(fd);
+    };
+
+    // Left by a process that exited before publishing it.
+    const auto child = fork();
+    if (child == 0)
+        _exit(0);
+    ASSERT_EQ(waitpid(child, nullptr, 0), child);
+    leave_segment(0600, child);
+    ASSERT_TRUE(reader(path)->side_index().empty());
+    publish();
+    ASSERT_FALSE(reader(path)->side_index().empty());
+    ASSERT_EQ(mode(), 0600);
+
+    // Accessible by other users.
+    leave_segment(0666, 0);
+    ASSERT_TRUE(reader(path)->side_index().empty());
+    publish();
+    ASSERT_FALSE(reader(path)->side_index().empty());
+    ASSERT_EQ(mode(), 0600);
+
+    // The creator of an unpublished segment is still running.
+    leave_segment(0600, getpid());
+    publish();
+    ASSERT_TRUE(reader(path)->side_index().empty());
+    ASSERT_TRUE(ifc::remove_shared_side_index(ifc::read_blob(path)->view()));
+}
+#endif
+
+TEST(SimpleTest, zstd_blob)
+{
+    const auto compressed = ifc::read_zstd_blob(data_dir / "attributes.ixx.ifc.zst");
+    const auto uncompressed = ifc::read_blob(data_dir / "attributes.ixx.ifc");
+    ASSERT_TRUE(std::ranges::equal(compressed->view(), uncompressed->view()));
+    ASSERT_NO_THROW((ifc::File{ compressed->view(), { .verify_checksum = true } }));
+
+    ASSERT_ANY_THROW(ifc::read_zstd_blob(data_dir / "attributes.ixx.ifc"));
+}
+
+TEST(SimpleTest, range_read_blob)
+{
+    const auto source = ifc::read_blob(data_dir / "attributes.ixx.ifc");
+    const auto expected = source->view();
+    size_t bytes_read = 0;
+    const auto read_range = [&](uint64_t offset, std::span<std::byte> out) {
+        ASSERT_LE(offset + out.size(), expected.size());
+        std::memcpy(out.data(), expected.data() + offset, out.size());
+        bytes_read += out.size();
+    };
+
+    const auto directory = std::filesystem::temp_directory_path() / "ifc-range-read-test";
+    std::filesystem::remove_all(directory);
+    const ifc::RangeReadOptions options{ .page_size = 256, .cache_directory = directory, .key = "attributes" };
+    {
+        const auto blob = ifc::read_blob_ranges(expected.size(), read_range, options);
+        ASSERT_TRUE(blob->fetches_on_demand());
+        const ifc::File file(blob->view(), { .fetch = [&](ifc::File::BlobView range) { blob->fetch(range); } });
+        ASSERT_LT(bytes_read, expected.size());
+        ASSERT_EQ(file.functions().size(), 2);
+    }
+
+    // Pages read before come from the cache.
+    const auto first_transfer = bytes_read;
+    const auto blob = ifc::read_blob_ranges(expected.size(), read_range, options);
+    const ifc::File file(blob->view(), { .fetch = [&](ifc::File::BlobView range) { blob->fetch(range); } });
+    ASSERT_EQ(file.functions().size(), 2);
+    ASSERT_EQ(bytes_read, first_transfer);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(SimpleTest, read_blob_stream)
+{
+    const auto original = ifc::read_blob(data_dir / "attributes.ixx.ifc");
+    const auto layout = ifc::streaming_layout(ifc::File(original->view()));
+    ASSERT_EQ(layout.size(), original->view().size());
+    ASSERT_EQ(ifc::File(layout, { .verify_checksum = true, .validate = true }).functions().size(), 2);
+
+    // A stream that only goes as far as it is allowed to, in small reads.
+    std::mutex mutex;
+    std::condition_variable allowed_changed;
+    size_t allowed = 0;
+    size_t position = 0;
+    std::span<std::byte const> sent;
+    const auto read = [&](std::span<std::byte> out) -> size_t {
+        std::unique_lock lock(mutex);
+        allowed_changed.wait(lock, [&] { return allowed > position; });
+        const auto count = std::min({ out.size(), allowed - position, size_t{ 64 } });
+        std::memcpy(out.data(), sent.data() + position, count);
+        position += count;
+        return count;
+    };
+    const auto allow = [&](size_t bytes) {
+        std::scoped_lock lock(mutex);
+        allowed = bytes;
+        allowed_changed.notify_all();
+    };
+
+    // The File is constructed from the header, the string table and the table of contents before the partitions arrive.
+    sent = layout;
+    ifc::File const probe(layout);
+    const auto partitions = static_cast<size_t>(probe.header().toc) + raw_count(probe.header().partition_count) * sizeof(ifc::PartitionSummary);
+    allow(partitions);
+    {
+        const auto blob = ifc::read_blob_stream(read);
+        ASSERT_TRUE(blob->fetches_on_demand());
+        ASSERT_EQ(blob->view().size(), layout.size());
+        const ifc::File file(blob->view(), { .fetch = [&](ifc::File::BlobView range) { blob->fetch(range); } });
+        {
+            std::scoped_lock lock(mutex);
+            ASSERT_EQ(position, partitions);
+        }
+        allow(layout.size());
+        ASSERT_EQ(file.functions().size(), 2);
+        ASSERT_TRUE(std::ranges::equal(blob->view(), layout));
+    }
+
+    // A stream ending within the blob.
+    const auto truncated = original->view().first(original->view().size() / 2);
+    {
+        std::scoped_lock lock(mutex);
+        sent = truncated;
+        position = 0;
+        allowed = truncated.size();
+    }
+    const auto ends_early = [&](std::span<std::byte> out) { return position == truncated.size() ? size_t{ 0 } : read(out); };
+    const auto blob = ifc::read_blob_stream(ends_early);
+    ASSERT_THROW((ifc::File(blob->view(), { .fetch = [&](ifc::File::BlobView range) { blob->fetch(range); } })), std::runtime_error);
+
+    // A stream with nothing more to send: destroying the holder does not wait for the blocked read, the thread
+    // drops the reader once that read returns.
+    struct BlockedStream
+    {
+        std::span<std::byte const> sent;
+        size_t position = 0;
+        std::mutex mutex;
+        std::condition_variable released_changed;
+        bool released = false;
+    };
+    auto blocked = std::make_shared<BlockedStream>();
+    blocked->sent = std::span(layout).first(partitions);
+    {
+        const auto stalled = ifc::read_blob_stream([blocked](std::span<std::byte> out) -> size_t {
+            std::unique_lock lock(blocked->mutex);
+            if (blocked->position == blocked->sent.size())
+            {
+                blocked->released_changed.wait(lock, [&] { return blocked->released; });
+                return 0;
+            }
+            const auto count = std::min(out.size(), blocked->sent.size() - blocked->position);
+            std::memcpy(out.data(), blocked->sent.data() + blocked->position, count);
+            blocked->position += count;
+            return count;
+        });
+        ASSERT_EQ(stalled->view().size(), layout.size());
+    }
+    {
+        std::scoped_lock lock(blocked->mutex);
+        blocked->released = true;
+    }
+    blocked->released_changed.notify_all();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (blocked.use_count() != 1 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_EQ(blocked.use_count(), 1);
+}
+
+TEST(SimpleTest, batch_read)
+{
+    const std::vector<std::filesystem::path> paths{
+        data_dir / "attributes.ixx.ifc",
+        data_dir / "missing.ifc",
+        data_dir / "empty.ixx.ifc",
+    };
+
+    std::vector<ifc::Environment::BlobHolderPtr> blobs(paths.size());
+    std::vector<bool> failed(paths.size());
+    ifc::read_blobs(paths, [&](ifc::BatchReadResult result) {
+        blobs[result.index] = std::move(result.blob);
+        failed[result.index] = result.error != nullptr;
+    }, { .queue_depth = 2 });
+
+    ASSERT_TRUE(blobs[0] && blobs[2]);
+    ASSERT_EQ(failed, (std::vector<bool>{ false, true, false }));
+    ASSERT_EQ(ifc::File(blobs[0]->view()).functions().size(), 2);
+}
+
+TEST(Parallel, for_each)
+{
+    std::vector<uint32_t> values(100'000);
+    std::iota(values.begin(), values.end(), 0u);
+    const ifc::Partition<uint32_t> partition(values.data(), values.size());
+
+    ifc::ThreadPool pool(4);
+    for (int run = 0; run != 3; ++run)
+    {
+        std::atomic<uint64_t> sum = 0;
+        ifc::for_each_parallel(partition, [&sum](uint32_t value) { sum += value; }, pool);
+        ASSERT_EQ(sum, uint64_t{ 99'999 } * 100'000 / 2);
+    }
+
+    ASSERT_THROW(ifc::for_each_parallel(partition, [](uint32_t value) {
+        if (value == 50'000)
+            throw std::runtime_error("failed");
+    }, pool), std::runtime_error);
+}
+
+TEST(Parallel, nested_runs_and_stealing)
+{
+    ifc::ThreadPool pool(4);
+
+    // Runs from tasks of the pool run inline instead of waiting for the pool.
+    std::vector<std::atomic<int>> visits(64 * 64);
+    pool.run(64, [&](size_t i) {
+        pool.run(64, [&](size_t j) { ++visits[i * 64 + j]; });
+    });
+    ASSERT_TRUE(std::ranges::all_of(visits, [](auto const& count) { return count == 1; }));
+
+    // The slow tasks are all at the start of the first thread's range, the other threads steal the rest of it.
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    pool.run(400, [&](size_t i) {
+        if (i < 10)
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::scoped_lock lock(mutex);
+        if (i < 100)
+            threads.insert(std::this_thread::get_id());
+    });
+    ASSERT_GT(threads.size(), 1);
+}
+
+TEST(Parallel, worker_start)
+{
+    std::mutex mutex;
+    std::multiset<unsigned> started;
+    std::set<std::thread::id> worker_ids;
+    {
+        ifc::ThreadPool pool(3, [&](unsigned i) {
+            std::scoped_lock lock(mutex);
+            started.insert(i);
+            worker_ids.insert(std::this_thread::get_id());
+        });
+        std::atomic<size_t> done = 0;
+        pool.run(100, [&](size_t) { ++done; });
+        ASSERT_EQ(done, 100);
+    }
+    // Joined by the destructor.
+    ASSERT_EQ(started, (std::multiset<unsigned>{ 1, 2 }));
+    ASSERT_EQ(worker_ids.size(), 2);
+    ASSERT_FALSE(worker_ids.contains(std::this_thread::get_id()));
+}
+
+TEST(Parallel, default_executor)
+{
+    struct CountingExecutor final : ifc::Executor
+    {
+        size_t runs = 0;
+        void run(size_t count, std::function<void(size_t)> const& task) override
+        {
+            ++runs;
+            ifc::InlineExecutor().run(count, task);
+        }
+    } counting;
+
+    std::vector<uint32_t> values(10);
+    const ifc::Partition<uint32_t> partition(values.data(), values.size());
+    ifc::set_default_executor(&counting);
+    ifc::for_each_parallel(partition, [](uint32_t) {});
+    ifc::set_default_executor(nullptr);
+    ifc::for_each_parallel(partition, [](uint32_t) {});
+    ASSERT_EQ(counting.runs, 1);
+}
+
+TEST(Cancellation, tokens_and_scopes)
+{
+    ifc::CancellationToken token;
+    ASSERT_FALSE(token.cancelled());
+    token.cancel();
+    ASSERT_THROW(token.throw_if_cancelled(), ifc::Cancelled);
+
+    const auto expired = ifc::CancellationToken::after(std::chrono::nanoseconds(0));
+    ASSERT_TRUE(expired.cancelled());
+    ASSERT_FALSE(ifc::CancellationToken::after(std::chrono::hours(1)).cancelled());
+
+    ASSERT_EQ(ifc::current_cancellation(), nullptr);
+    {
+        const ifc::CancellationScope scope(&token);
+        ASSERT_EQ(ifc::current_cancellation(), &token);
+        ASSERT_THROW(ifc::check_cancellation(), ifc::Cancelled);
+        {
+            const ifc::CancellationScope inner(nullptr);
+            ASSERT_NO_THROW(ifc::check_cancellation());
+        }
+        ASSERT_EQ(ifc::current_cancellation(), &token);
+    }
+    ASSERT_NO_THROW(ifc::check_cancellation());
+}
+
+TEST(Cancellation, index_builds_and_parallel_loops)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    ifc::CancellationToken token;
+    token.cancel();
+
+    // A cancelled build leaves the index unbuilt, the next request builds it.
+    {
+        const ifc::CancellationScope scope(&token);
+        ASSERT_THROW(wrapper.file.get_index<GlobalScopeSize>(), ifc::Cancelled);
+    }
+    ASSERT_EQ(wrapper.file.get_index<GlobalScopeSize>().size, raw_count(wrapper.file.global_scope().cardinality));
+    {
+        // Built indexes are returned regardless.
+        const ifc::CancellationScope scope(&token);
+        ASSERT_NO_THROW(wrapper.file.get_index<GlobalScopeSize>());
+    }
+
+    // The tasks of the pool's threads check the token of the calling thread.
+    std::vector<uint32_t> values(100'000);
+    const ifc::Partition<uint32_t> partition(values.data(), values.size());
+    ifc::ThreadPool pool(4);
+    std::atomic<size_t> visited = 0;
+    {
+        const ifc::CancellationScope scope(&token);
+        ASSERT_THROW(ifc::for_each_parallel(partition, [&visited](uint32_t) { ++visited; }, pool), ifc::Cancelled);
+    }
+    ASSERT_EQ(visited, 0);
+}
+
+TEST(Parallel, declarations)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+
+    std::atomic<size_t> count = 0;
+    ifc::for_each_declaration_parallel(file, [&count](ifc::Declaration const&) { ++count; });
+    ASSERT_EQ(count, file.declarations().size());
+}
+
+TEST(FileWriter, round_trip)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+
+    SyntheticFile bmi(file);
+    bmi.copy_partitions();
+    const auto blob = bmi.write();
+    ASSERT_EQ(blob.size(), file.blob().size());
+
+    const ifc::File copy(blob, { .verify_checksum = true });
+    ASSERT_EQ(copy.table_of_contents().size(), file.table_of_contents().size());
+    for (size_t i = 0; i != file.table_of_contents().size(); ++i)
+    {
+        auto const& original = file.table_of_contents()[i];
+        auto const& written = copy.table_of_contents()[i];
+        ASSERT_EQ(copy.get_string_view(written.name), file.get_string_view(original.name));
+        ASSERT_EQ(written.size_bytes(), original.size_bytes());
+        ASSERT_EQ(std::memcmp(copy.get_data_pointer(written), file.get_data_pointer(original), original.size_bytes()), 0);
+    }
+
+    ASSERT_THROW(bmi.writer().add_partition(ifc::TextOffset{}, std::span<std::byte const>(blob).first(3), 2), std::invalid_argument);
+}
+
+// Newer compilers may append fields to the records of a partition.
+TEST(Partition, larger_entry_sizes)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    auto const& file = wrapper.file;
+
+    // Entries of the partition resized by `extra` bytes, padded or truncated.
+    const auto resized = [&](std::string_view resized_name, std::ptrdiff_t extra) {
+        SyntheticFile bmi(file);
+        for (auto const& summary : file.table_of_contents())
+        {
+            const auto entry_size = static_cast<size_t>(summary.entry_size);
+            const std::span<std::byte const> entries{ file.get_data_pointer(summary), summary.size_bytes() };
+            if (file.get_string_view(summary.name) != resized_name)
+            {
+                bmi.writer().add_partition(summary.name, entries, entry_size);
+                continue;
+            }
+            const auto new_entry_size = entry_size + extra;
+            std::vector<std::byte> resized_entries;
+            for (size_t i = 0; i != raw_count(summary.cardinality); ++i)
+            {
+                const auto entry = entries.subspan(i * entry_size, std::min(entry_size, new_entry_size));
+                resized_entries.insert(resized_entries.end(), entry.begin(), entry.end());
+                resized_entries.insert(resized_entries.end(), new_entry_size - entry.size(), std::byte{0xAB});
+            }
+            bmi.writer().add_partition(summary.name, resized_entries, new_entry_size);
+        }
+        return bmi.write();
+    };
+
+    const auto functions_blob = resized(ifc::FunctionDeclaration::PartitionName, sizeof(uint32_t));
+    const ifc::File functions_file(functions_blob);
+    const auto functions = functions_file.functions();
+    ASSERT_FALSE(functions.contiguous());
+    ASSERT_EQ(functions.stride(), sizeof(ifc::FunctionDeclaration) + sizeof(uint32_t));
+    ASSERT_EQ(functions.size(), file.functions().size());
+    ASSERT_GT(functions.size(), 1);
+    for (uint32_t i = 0; i != functions.size(); ++i)
+    {
+        const ifc::DeclIndex function{ static_cast<uint32_t>(ifc::DeclSort::Function), i };
+        ASSERT_EQ(functions[function].name, file.functions()[function].name);
+        ASSERT_EQ(functions.index_of(functions[function]), i);
+    }
+    ASSERT_TRUE(std::ranges::equal(functions.column(&ifc::FunctionDeclaration::type), file.functions().column(&ifc::FunctionDeclaration::type)));
+    ASSERT_EQ(std::ranges::distance(functions.drop(1)), functions.size() - 1);
+
+    const auto members_blob = resized(ifc::Declaration::PartitionName, sizeof(uint32_t));
+    const ifc::File members_file(members_blob);
+    std::vector<uint32_t> expected, positions;
+    ifc::find_sort(file.declarations(), ifc::DeclSort::Function, expected);
+    ifc::find_sort(members_file.declarations(), ifc::DeclSort::Function, positions);
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(positions, expected);
+
+    // Records are never shorter than the ones this library reads.
+    ASSERT_THROW(ifc::File(resized(ifc::FunctionDeclaration::PartitionName, -static_cast<std::ptrdiff_t>(sizeof(uint32_t)))), std::runtime_error);
+}
+
+TEST(Bundle, shared_string_tables)
+{
+    const auto attributes = FileWrapper::create("attributes.ixx.ifc");
+    const auto empty = FileWrapper::create("empty.ixx.ifc");
+    const ifc::Bundle::Entry entries[] = {
+        { "b/attributes.ixx.ifc", &attributes.file },
+        { "empty.ixx.ifc", &empty.file },
+        { "a/attributes.ixx.ifc", &attributes.file },
+    };
+    const auto bytes = ifc::Bundle::write(entries);
+    // The two copies of attributes share their string table.
+    ASSERT_LT(bytes.size(), 2 * attributes.file.blob().size() + empty.file.blob().size());
+
+    const auto directory = std::filesystem::temp_directory_path() / "ifc-bundle-test";
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "modules.ifcb";
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+    const ifc::Bundle bundle(ifc::read_blob(path));
+    ASSERT_EQ(bundle.size(), 3);
+    ASSERT_EQ(bundle[0].name, "a/attributes.ixx.ifc");
+    ASSERT_EQ(bundle[2].name, "empty.ixx.ifc");
+    ASSERT_EQ(bundle[0].string_table.data(), bundle[1].string_table.data());
+    ASSERT_FALSE(bundle.find("c/attributes.ixx.ifc"));
+
+    const auto member = bundle.find("b/attributes.ixx.ifc");
+    ASSERT_TRUE(member);
+    const ifc::File file(member->blob, { .verify_checksum = true, .string_table = member->string_table });
+    ASSERT_LE(file.string_table().size(), attributes.file.string_table().size());
+    ASSERT_EQ(file.get_string_view(file.header().src_path), attributes.file.get_string_view(attributes.file.header().src_path));
+    ASSERT_EQ(file.functions().size(), attributes.file.functions().size());
+
+    ifc::Environment environment(ifc::Environment::Config{}, bundle.file_reader());
+    auto const & loaded = environment.get_module_by_bmi_path("a/attributes.ixx.ifc");
+    ASSERT_EQ(loaded.blob().data(), bundle[0].blob.data());
+    ASSERT_EQ(loaded.scope_declarations().size(), attributes.file.scope_declarations().size());
+    ASSERT_THROW(ifc::Bundle(ifc::read_blob(data_dir / "empty.ixx.ifc")), std::runtime_error);
+}
+
+TEST(Bundle, merged_string_table)
+{
+    const auto attributes = FileWrapper::create("attributes.ixx.ifc");
+    const auto empty = FileWrapper::create("empty.ixx.ifc");
+    const ifc::Bundle::Entry entries[] = {
+        { "attributes.ixx.ifc", &attributes.file },
+        { "empty.ixx.ifc", &empty.file },
+    };
+    const auto bytes = ifc::Bundle::write(entries);
+
+    const auto directory = std::filesystem::temp_directory_path() / "ifc-bundle-test";
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "merged.ifcb";
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+    // The strings common to both files are stored once.
+    const ifc::Bundle bundle(ifc::read_blob(path));
+    ASSERT_EQ(bundle[0].string_table.data(), bundle[1].string_table.data());
+    ASSERT_LT(bundle[0].string_table.size(), attributes.file.string_table().size() + empty.file.string_table().size());
+
+    for (size_t i = 0; i != bundle.size(); ++i)
+    {
+        auto const & original = entries[i].file;
+        const ifc::File file(bundle[i].blob, { .verify_checksum = true, .string_table = bundle[i].string_table });
+        ASSERT_EQ(file.get_string_view(file.header().src_path), original->get_string_view(original->header().src_path));
+        ASSERT_EQ(file.get_string_view(ifc::TextOffset{ file.header().unit.index }), original->get_string_view(ifc::TextOffset{ original->header().unit.index }));
+
+        const auto toc = file.table_of_contents();
+        ASSERT_EQ(toc.size(), original->table_of_contents().size());
+        for (size_t p = 0; p != toc.size(); ++p)
+            ASSERT_EQ(file.get_string_view(toc[p].name), original->get_string_view(original->table_of_contents()[p].name));
+    }
+
+    const ifc::File file(bundle[0].blob, { .string_table = bundle[0].string_table });
+    const auto name_in = [](ifc::File const & in) { return [&in](auto const & decl) { return get_identifier(in, decl.name); }; };
+    const auto word_in = [](ifc::File const & in) {
+        return [&in](ifc::AttrBasic const & attribute) { return in.get_string_view(static_cast<ifc::TextOffset>(attribute.word.index)); };
+    };
+    ASSERT_TRUE(std::ranges::equal(attributes.file.scope_declarations(), file.scope_declarations(), {}, name_in(attributes.file), name_in(file)));
+    ASSERT_TRUE(std::ranges::equal(attributes.file.functions(), file.functions(), {}, name_in(attributes.file), name_in(file)));
+    ASSERT_TRUE(std::ranges::equal(attributes.file.basic_attributes(), file.basic_attributes(), {}, word_in(attributes.file), word_in(file)));
+}
+
+// Posting lists long enough to span many blocks, intersected with a short one.
+TEST(TrigramIndex, long_posting_lists)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+
+    SyntheticFile bmi(wrapper.file);
+    for (int i = 0; i != 3000; ++i)
+    {
+        bmi.text("widget" + std::to_string(i));
+        if (i % 150 == 0)
+            bmi.text("Gadget_Widget" + std::to_string(i));
+    }
+    bmi.copy_partitions();
+    const auto blob = bmi.write();
+    const ifc::File widgets(blob);
+
+    ifc::SymbolTable symbols;
+    ifc::File const* files[] = { &widgets };
+    symbols.intern(files);
+    ifc::TrigramIndex index;
+    index.update(symbols);
+
+    const auto gadgets = index.search(symbols, "gadget_wid");
+    ASSERT_EQ(gadgets.size(), 20);
+    for (auto match : gadgets)
+        ASSERT_TRUE(symbols.text(match.symbol).starts_with("Gadget_Widget"));
+    // Shorter identifiers first.
+    ASSERT_EQ(symbols.text(gadgets.front().symbol), "Gadget_Widget0");
+
+    // `widget<i>` shares `wid`, `dge` and `get` of the 8 trigrams of the pattern.
+    const auto widgets_too = index.search(symbols, "gadget_wid", { .limit = 5000, .min_shared = 0.25f });
+    ASSERT_EQ(widgets_too.size(), 3020);
+    ASSERT_TRUE(std::ranges::all_of(widgets_too | std::views::take(20), [&](auto const & m) { return symbols.text(m.symbol).starts_with("Gadget"); }));
+
+    ASSERT_EQ(index.search(symbols, "idget2999").size(), 1);
+    ASSERT_EQ(index.search(symbols, "et2999", { .limit = 10 }).size(), 1);
+}
+
+// Lists within one file, across files and sorts, single postings and many blocks, against their plain vectors.
+TEST(PostingLists, round_trip_and_intersection)
+{
+    std::mt19937 random(42);
+    auto make_list = [&random](uint32_t files, uint32_t per_file, uint32_t spread) {
+        std::set<ifc::DeclarationId> postings;
+        for (uint32_t file = 0; file != files; ++file)
+        {
+            for (uint32_t i = 0; i != per_file; ++i)
+            {
+                const auto sort = random() % 2 == 0 ? ifc::DeclSort::Function : ifc::DeclSort::Variable;
+                postings.insert({ ifc::FileId{ file * 7 }, { .tag = static_cast<uint32_t>(sort), .index = static_cast<uint32_t>(random() % spread) } });
+            }
+        }
+        return std::vector(postings.begin(), postings.end());
+    };
+
+    const std::vector<std::vector<ifc::DeclarationId>> expected = {
+        {},
+        { { ifc::FileId{ 3 }, { .tag = static_cast<uint32_t>(ifc::DeclSort::Field), .index = 1u << 26 } } },
+        make_list(1, 5000, 20000),
+        make_list(40, 100, 500),
+        make_list(300, 2, 1 << 20),
+        make_list(1, 129, 129),
+    };
+    ifc::PostingLists lists;
+    for (auto const & list : expected)
+        lists.add(list);
+    ASSERT_EQ(lists.size(), expected.size());
+
+    size_t raw_bytes = 0;
+    for (ifc::PostingLists::ListId id = 0; id != expected.size(); ++id)
+    {
+        ASSERT_EQ(lists.count(id), expected[id].size());
+        ASSERT_EQ(lists.decode(id), expected[id]);
+        raw_bytes += expected[id].size() * sizeof(ifc::DeclarationId);
+    }
+    ASSERT_LT(lists.heap_bytes() * 3, raw_bytes);
+
+    // Advancing to postings in the list and between them, within a block and across many.
+    const auto & dense = expected[2];
+    for (size_t i = 0; i < dense.size(); i += 97)
+    {
+        ifc::PostingLists::Cursor cursor(lists, 2);
+        ifc::DeclarationId target = dense[i];
+        target.decl.index = target.decl.index + 1;
+        cursor.advance_to(dense[i]);
+        ASSERT_EQ(cursor.value(), dense[i]);
+        cursor.advance_to(target);
+        const auto next = std::ranges::lower_bound(dense, target);
+        ASSERT_EQ(cursor.at_end(), next == dense.end());
+        if (next != dense.end())
+        {
+            ASSERT_EQ(cursor.value(), *next);
+        }
+    }
+    ASSERT_TRUE(lists.contains(3, expected[3][150]));
+    ASSERT_FALSE(lists.contains(1, expected[2].front()));
+
+    for (auto [a, b] : { std::pair{ 2u, 5u }, std::pair{ 3u, 4u }, std::pair{ 2u, 3u }, std::pair{ 0u, 2u } })
+    {
+        std::vector<ifc::DeclarationId> both;
+        std::ranges::set_intersection(expected[a], expected[b], std::back_inserter(both));
+        const ifc::PostingLists::ListId ids[] = { a, b };
+        ASSERT_EQ(lists.intersect(ids), both);
+    }
+
+    const ifc::DeclarationId unsorted[] = { expected[1][0], expected[1][0] };
+    ASSERT_THROW(lists.add(unsorted), std::invalid_argument);
+}
+
+TEST(TraitIndex, named_partitions)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(wrapper.file);
+    bmi.copy_partitions();
+
+    // Unsorted, with two traits of the first function.
+    const auto function = [](uint32_t index) { return decl(ifc::DeclSort::Function, index); };
+    const auto literal = [](uint32_t index) { return expr(ifc::ExprSort::Literal, index); };
+    const ifc::AssociatedTrait<ifc::ExprIndex> alignas_traits[] = { { function(1), literal(0) }, { function(0), literal(1) }, { function(0), literal(2) } };
+    bmi.add("trait.alignas", alignas_traits);
+    const std::byte small[4]{};
+    bmi.writer().add_partition(bmi.text("trait.small"), std::span<std::byte const>(small), 2);
+    const auto blob = bmi.write();
+    const ifc::File file(blob);
+
+    auto const& alignas_index = file.get_index<ifc::NamedTraitIndex<ifc::ExprIndex, "trait.alignas">>();
+    ASSERT_EQ(alignas_index.size(), 3);
+    ASSERT_TRUE(std::ranges::equal(alignas_index.find(function(0)), std::array{ literal(1), literal(2) }));
+    ASSERT_EQ(alignas_index.find_last(function(0)), literal(2));
+    ASSERT_EQ(alignas_index.find_last(function(1)), literal(0));
+    ASSERT_TRUE(alignas_index.find(function(2)).empty());
+    ASSERT_TRUE(std::ranges::is_sorted(alignas_index.declarations()));
+
+    // Absent partitions have no traits, partitions of smaller records are rejected.
+    ASSERT_EQ((file.get_index<ifc::NamedTraitIndex<ifc::ExprIndex, "trait.requires", "trait.alignas">>().size()), 3);
+    ASSERT_TRUE(file.get_partition_by_name<ifc::AssociatedTrait<ifc::ExprIndex>>("trait.requires").size() == 0);
+    ASSERT_THROW((void)file.get_partition_by_name<ifc::AssociatedTrait<ifc::ExprIndex>>("trait.small"), std::runtime_error);
+    ASSERT_EQ(file.get_partition_by_name<ifc::FunctionDeclaration>(ifc::FunctionDeclaration::PartitionName).size(), file.functions().size());
+}
+
+namespace
+{
+    struct VendorRecord
+    {
+        PARTITION_NAME(".vendor.records");
+        uint32_t value;
+        uint32_t flags;
+    };
+
+    struct AbsentVendorRecord
+    {
+        PARTITION_NAME(".vendor.absent");
+        uint64_t value;
+    };
+}
+
+TEST(File, user_partitions)
+{
+    const auto wrapper = FileWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(wrapper.file);
+    bmi.copy_partitions();
+    const VendorRecord records[] = { { 1, 10 }, { 2, 20 }, { 3, 30 } };
+    bmi.add(records);
+    const auto blob = bmi.write();
+
+    for (auto eager : { false, true })
+    {
+        const ifc::File file(blob, { .eager_partitions = eager });
+        for (int access = 0; access != 2; ++access)
+        {
+            const auto partition = file.get_partition<VendorRecord>();
+            ASSERT_EQ(partition.size(), 3);
+            ASSERT_EQ(partition[ifc::Index{ 1 }].value, 2);
+            ASSERT_EQ(partition[ifc::Index{ 2 }].flags, 30);
+            ASSERT_EQ(file.get_partition<AbsentVendorRecord>().size(), 0);
+        }
+        ASSERT_EQ(file.get_partition<ifc::FunctionDeclaration>().size(), file.functions().size());
+    }
+}
+
+namespace
+{
+    template<size_t N>
+    struct NumberedIndex
+    {
+        explicit NumberedIndex(ifc::File const&) {}
+
+        size_t heap_bytes() const { return 0; }
+
+        size_t value = N;
+    };
+}
+
+// Index ids are given out per index type for the whole program, more of them than fit in the first slots.
+TEST(File, many_kinds_of_indexes)
+{
+    const auto wrapper = FileWrapper::create("empty.ixx.ifc");
+    auto const& file = wrapper.file;
+    [&file]<size_t... N>(std::index_sequence<N...>) {
+        ASSERT_TRUE(((file.get_index<NumberedIndex<N>>().value == N) && ...));
+        ASSERT_TRUE(((&file.get_index<NumberedIndex<N>>() == &file.get_index<NumberedIndex<N>>()) && ...));
+    }(std::make_index_sequence<200>{});
+    ASSERT_GE(file.memory_usage().heap.size(), 200);
+}
+
 int main(int argc, char* argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -1,4 +1,14 @@
 ﻿#include <ifc/MSVCEnvironment.h>
+#include <ifc/ModuleGraph.h>
+#include <ifc/ModuleGraphSnapshot.h>
+#include <ifc/QueryCache.h>
+#include <ifc/TrigramIndex.h>
+#include <ifc/TypeTraversal.h>
+#include <reflifc/AbiDiff.h>
+#include <reflifc/Query.h>
+#include <reflifc/Type.h>
+#include <reflifc/TypeRenderer.h>
+#include <reflifc/index/TranslationUnitLookup.h>
 #include <ifc/blob_reader.h>
 #include <ifc/File.h>
 #include <ifc/Declaration.h>
@@ -6,7 +16,15 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 static std::filesystem::path data_dir;
 
@@ -56,6 +74,11 @@ namespace
         {
             return environment.get_referenced_module(module, file);
         }
+
+        ifc::Environment& get_environment()
+        {
+            return environment;
+        }
     };
 
     std::string_view get_identifier(ifc::File const & file, ifc::NameIndex name)
@@ -75,6 +98,18 @@ TEST(SimpleTest, metadata)
     ASSERT_EQ(header.arch, ifc::Architecture::X64);
 }
 
+TEST(SimpleTest, validate)
+{
+    for (auto const & entry : std::filesystem::directory_iterator(data_dir))
+    {
+        if (entry.path().extension() != ".ifc")
+            continue;
+        const auto blob = ifc::read_blob(entry.path());
+        const ifc::File file(blob->view(), { .validate = true });
+        ASSERT_NO_THROW(file.validation_status().get()) << entry.path();
+    }
+}
+
 static void check_class_with_name(ifc::File const& file, ifc::DeclIndex referenced_decl, std::string_view class_name)
 {
     ASSERT_EQ(referenced_decl.sort(), ifc::DeclSort::Scope);
@@ -116,6 +151,103 @@ TEST(SimpleTest, IFC_dependencies)
     }
 }
 
+TEST(SimpleTest, reachable_types)
+{
+    Reader reader("A.ixx.ifc");
+    auto const& file = reader.get_main_ifc();
+    auto const& function = *file.functions().begin();
+
+    // void f(A, B, C): the function type, its return type, the parameter tuple and three designated types.
+    const ifc::TypeIndex roots[] = { function.type, function.type };
+    const auto types = ifc::reachable_types(file, roots);
+    ASSERT_EQ(types.size(), 6);
+    ASSERT_EQ(types[0], function.type);
+    ASSERT_EQ(std::ranges::count(types, ifc::TypeSort::Designated, &ifc::TypeIndex::sort), 3);
+
+    ifc::TypeTraversal traversal(file);
+    traversal.walk(file.function_types()[function.type].source);
+    ASSERT_EQ(traversal.visited_count(), 4);
+    ASSERT_FALSE(traversal.visited(function.type));
+    size_t visited = 0;
+    traversal.walk(function.type, [&visited](ifc::TypeIndex) { ++visited; });
+    ASSERT_EQ(visited, 2);
+}
+
+TEST(SimpleTest, structural_type_hash)
+{
+    Reader a_reader("A.ixx.ifc");
+    Reader transitive_reader("Transitive.ixx.ifc");
+    auto const& a = a_reader.get_main_ifc();
+    auto const& transitive = transitive_reader.get_main_ifc();
+
+    auto const& a_function = a.function_types()[a.functions().begin()->type];
+    const auto params = a.type_heap().slice(a.tuple_types()[a_function.source].seq);
+    const reflifc::Type a_param(&a, params[ifc::Index{0}]);
+    const reflifc::Type b_param(&a, params[ifc::Index{1}]);
+    const reflifc::Type c_param(&a, params[ifc::Index{2}]);
+    ASSERT_TRUE(reflifc::same_type(c_param, c_param));
+    ASSERT_FALSE(reflifc::same_type(a_param, b_param));
+    ASSERT_FALSE(reflifc::same_type(b_param, c_param));
+
+    // C reached through a different chain of imports.
+    const reflifc::Type transitive_c(&transitive, transitive.function_types()[transitive.functions().begin()->type].source);
+    ASSERT_TRUE(reflifc::same_type(c_param, transitive_c));
+    ASSERT_FALSE(reflifc::same_type(b_param, transitive_c));
+
+    const reflifc::Type a_void(&a, a_function.target);
+    const reflifc::Type transitive_void(&transitive, transitive.function_types()[transitive.functions().begin()->type].target);
+    ASSERT_TRUE(reflifc::same_type(a_void, transitive_void));
+}
+
+TEST(SimpleTest, type_spelling)
+{
+    Reader reader("A.ixx.ifc");
+    auto const& file = reader.get_main_ifc();
+    const auto function_type = file.functions().begin()->type;
+
+    reflifc::TypeRenderer renderer(file, &reader.get_environment());
+    const auto spelling = renderer.spelling(function_type);
+    ASSERT_EQ(spelling, "void(A,B,C)");
+    ASSERT_EQ(renderer.spelling(function_type).data(), spelling.data());
+
+    std::string out = "f: ";
+    renderer.append(function_type, out);
+    ASSERT_EQ(out, "f: void(A,B,C)");
+
+    reflifc::TypeRenderer single_file(file);
+    ASSERT_EQ(single_file.spelling(file.function_types()[function_type].target), "void");
+}
+
+TEST(SimpleTest, abi_diff)
+{
+    Reader reader("A.ixx.ifc");
+    const reflifc::Module module(&reader.get_main_ifc());
+
+    // Only `f` is exported, class A is not.
+    const auto fingerprints = reflifc::fingerprint_abi(module, &reader.get_environment());
+    ASSERT_EQ(fingerprints.size(), 1);
+    ASSERT_EQ(fingerprints.decls[0].sort(), ifc::DeclSort::Function);
+    ASSERT_TRUE(reflifc::diff_abi(module, module, &reader.get_environment()).empty());
+
+    Reader empty_reader("empty.ixx.ifc");
+    const reflifc::Module empty(&empty_reader.get_main_ifc());
+    const auto removed = reflifc::diff_abi(module, empty);
+    ASSERT_EQ(removed.size(), 1);
+    ASSERT_EQ(removed[0].kind, reflifc::AbiChange::Kind::Removed);
+    ASSERT_EQ(removed[0].before, fingerprints.decls[0]);
+
+    const auto added = reflifc::diff_abi(empty, module);
+    ASSERT_EQ(added.size(), 1);
+    ASSERT_EQ(added[0].kind, reflifc::AbiChange::Kind::Added);
+
+    // Same key, different fingerprint.
+    auto changed = fingerprints;
+    changed.fingerprints[0] ^= 1;
+    const auto changes = reflifc::diff_abi(fingerprints, changed);
+    ASSERT_EQ(changes.size(), 1);
+    ASSERT_EQ(changes[0].kind, reflifc::AbiChange::Kind::Changed);
+}
+
 TEST(SimpleTest, TransitiveImport)
 {
     Reader reader("Transitive.ixx.ifc");
@@ -133,6 +265,945 @@ TEST(SimpleTest, TransitiveImport)
     check_class_with_name(reader.get_referenced_module(decl_ref.unit, file), decl_ref.local_index, "C");
 }
 
+TEST(Environment, concurrent_loads)
+{
+    std::atomic<int> reads = 0;
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir),
+        [&reads](std::filesystem::path const& path) {
+            ++reads;
+            return ifc::read_blob(path);
+        });
+
+    std::vector<ifc::File const*> files(8);
+    {
+        std::vector<std::jthread> threads;
+        for (auto & file : files)
+            threads.emplace_back([&] { file = &environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc"); });
+    }
+
+    ASSERT_EQ(reads, 1);
+    for (auto file : files)
+        ASSERT_EQ(file, files.front());
+}
+
+TEST(Environment, prefetch_transitive)
+{
+    std::atomic<int> reads = 0;
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "Transitive.ixx.ifc.d.json").string(), data_dir),
+        [&reads](std::filesystem::path const& path) {
+            ++reads;
+            return ifc::read_blob(path);
+        });
+
+    auto const& file = environment.get_module_by_bmi_path(data_dir / "Transitive.ixx.ifc");
+    ifc::ThreadPool pool(4);
+    environment.prefetch_transitive(file, pool);
+    ASSERT_EQ(reads, 3);
+
+    for (auto module : file.imported_modules())
+        environment.get_referenced_module(module, file);
+    ASSERT_EQ(reads, 3);
+}
+
+TEST(Environment, build_global_indexes)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "Transitive.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    ifc::Environment::GlobalIndexOptions options;
+    for (auto name : { "Transitive.ixx.ifc", "A.ixx.ifc", "C.ixx.ifc" })
+        options.bmis.push_back(data_dir / name);
+    std::atomic<int> indexed = 0;
+    options.build_file_indexes = [&indexed](ifc::File const&) { ++indexed; };
+    std::vector<ifc::File const*> merged;
+    options.merge = [&](ifc::File const& file, ifc::FileId id) {
+        merged.push_back(&file);
+        ASSERT_EQ(environment.file(id), &file);
+    };
+    options.queue_capacity = 1;
+
+    ifc::ThreadPool pool(4);
+    options.executor = &pool;
+    const auto stats = environment.build_global_indexes(options);
+    ASSERT_EQ(stats.files.size(), 3);
+    for (size_t i = 0; i != 3; ++i)
+    {
+        ASSERT_EQ(stats.files[i], &environment.get_module_by_bmi_path(options.bmis[i]));
+        ASSERT_EQ(environment.symbols().symbols(*stats.files[i]).size(), stats.files[i]->text_symbol_count());
+    }
+    ASSERT_EQ(indexed, 3);
+    ASSERT_EQ(merged.size(), 3);
+    for (auto stage : { &stats.load, &stats.validate, &stats.index, &stats.merge })
+    {
+        ASSERT_EQ(stage->files, 3);
+        ASSERT_EQ(stage->bytes, stats.load.bytes);
+        ASSERT_LE(stage->elapsed, stats.elapsed);
+    }
+
+    // The first exception stops the pipeline.
+    ifc::Environment failing(ifc::read_msvc_config((data_dir / "Transitive.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    options.bmis.push_back(data_dir / "missing.ifc");
+    options.validate = false;
+    options.merge = {};
+    ASSERT_ANY_THROW(failing.build_global_indexes(options));
+
+    ifc::InlineExecutor inline_executor;
+    options.executor = &inline_executor;
+    options.bmis.pop_back();
+    const auto inline_stats = failing.build_global_indexes(options);
+    ASSERT_EQ(inline_stats.validate.files, 0);
+    ASSERT_EQ(inline_stats.merge.files, 3);
+}
+
+TEST(Environment, load_priorities)
+{
+    std::mutex mutex;
+    std::condition_variable released;
+    bool release = false;
+    std::atomic<bool> reading_a = false;
+    std::atomic<int> reads_c = 0;
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir),
+        [&](std::filesystem::path const& path) {
+            if (path.filename() == "A.ixx.ifc")
+            {
+                reading_a = true;
+                std::unique_lock lock(mutex);
+                released.wait(lock, [&] { return release; });
+            }
+            else if (path.filename() == "C.ixx.ifc")
+            {
+                ++reads_c;
+            }
+            return ifc::read_blob(path);
+        });
+
+    // A foreground load is in progress until released.
+    auto a = std::async(std::launch::async, [&]() -> ifc::File const& { return environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc"); });
+    while (!reading_a)
+        std::this_thread::yield();
+
+    auto speculative = std::async(std::launch::async, [&]() -> ifc::File const& {
+        return environment.get_module_by_bmi_path(data_dir / "C.ixx.ifc", ifc::Environment::LoadPriority::Speculative);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(reads_c, 0);
+
+    // Not queued behind the speculative load of the same BMI.
+    auto const& c = environment.get_module_by_bmi_path(data_dir / "C.ixx.ifc");
+    ASSERT_EQ(reads_c, 1);
+
+    {
+        std::scoped_lock lock(mutex);
+        release = true;
+    }
+    released.notify_all();
+    a.get();
+    ASSERT_EQ(&speculative.get(), &c);
+    ASSERT_EQ(reads_c, 1);
+}
+
+TEST(Environment, async_loads)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob_async);
+
+    auto a = environment.load_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    auto c = environment.load_module_by_bmi_path(data_dir / "C.ixx.ifc");
+    auto const& file_a = a.get();
+    ASSERT_EQ(file_a.functions().size(), 1);
+    ASSERT_EQ(&file_a, &environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc"));
+    ASSERT_EQ(&c.get(), &environment.get_module_by_bmi_path(data_dir / "C.ixx.ifc"));
+
+    ASSERT_THROW(environment.load_module_by_bmi_path(data_dir / "missing.ifc").get(), std::exception);
+}
+
+TEST(Environment, memory_budget)
+{
+    std::atomic<int> reads = 0;
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir),
+        [&reads](std::filesystem::path const& path) {
+            ++reads;
+            return ifc::read_blob(path);
+        });
+    environment.set_memory_budget(0);
+
+    const auto a_size = file_size(data_dir / "A.ixx.ifc");
+    const auto c_size = file_size(data_dir / "C.ixx.ifc");
+
+    auto a = environment.acquire_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    ASSERT_EQ(a->functions().size(), 1);
+    ASSERT_EQ(environment.loaded_bytes(), a_size);
+
+    // A is released, so loading C evicts it.
+    a.reset();
+    auto c = environment.acquire_module_by_bmi_path(data_dir / "C.ixx.ifc");
+    ASSERT_EQ(environment.loaded_bytes(), c_size);
+    ASSERT_EQ(reads, 2);
+
+    a = environment.acquire_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    ASSERT_EQ(reads, 3);
+    ASSERT_EQ(environment.loaded_bytes(), a_size + c_size);
+
+    // Modules returned by reference are pinned.
+    auto const& empty = environment.get_module_by_bmi_path(data_dir / "empty.ixx.ifc");
+    a.reset();
+    c.reset();
+    environment.set_memory_budget(0);
+    ASSERT_EQ(environment.loaded_bytes(), file_size(data_dir / "empty.ixx.ifc"));
+    ASSERT_EQ(&empty, &environment.get_module_by_bmi_path(data_dir / "empty.ixx.ifc"));
+    ASSERT_EQ(reads, 4);
+}
+
+TEST(Environment, snapshot)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    ASSERT_EQ(environment.snapshot()->size(), 0);
+
+    auto a = environment.acquire_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    const auto first = environment.snapshot();
+    ASSERT_EQ(environment.snapshot(), first);
+    ASSERT_EQ(first->find(data_dir / "A.ixx.ifc"), a.get());
+    ASSERT_EQ(first->find(data_dir / "C.ixx.ifc"), nullptr);
+
+    // A is evicted, the first snapshot keeps it alive.
+    a.reset();
+    environment.set_memory_budget(0);
+    auto const& c = environment.get_module_by_bmi_path(data_dir / "C.ixx.ifc");
+    const auto second = environment.snapshot();
+    ASSERT_GT(second->version(), first->version());
+    ASSERT_EQ(second->find(data_dir / "A.ixx.ifc"), nullptr);
+    ASSERT_EQ(second->find(data_dir / "C.ixx.ifc"), &c);
+    ASSERT_EQ(first->size(), 1);
+    ASSERT_EQ(first->find(data_dir / "A.ixx.ifc")->functions().size(), 1);
+
+    for (auto module : c.imported_modules())
+        ASSERT_EQ(second->find_referenced_module(module, c), nullptr);
+}
+
+TEST(Environment, file_ids)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    ASSERT_EQ(environment.file(ifc::FileId{ 0 }), nullptr);
+
+    auto a = environment.acquire_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    auto const& c = environment.get_module_by_bmi_path(data_dir / "C.ixx.ifc");
+    ASSERT_EQ(environment.file_id_count(), 2);
+
+    const auto a_id = environment.file_id(*a);
+    const auto c_id = environment.file_id(c);
+    ASSERT_NE(a_id, c_id);
+    ASSERT_LT(static_cast<uint32_t>(a_id), 2);
+    ASSERT_LT(static_cast<uint32_t>(c_id), 2);
+    ASSERT_EQ(environment.file(a_id), a.get());
+    ASSERT_EQ(environment.file(c_id), &c);
+    ASSERT_EQ(environment.file_id(*a), a_id);
+
+    const auto decl = ifc::DeclIndex{ static_cast<uint32_t>(ifc::DeclSort::Function), 0 };
+    ASSERT_EQ(environment.declaration_id(*a, decl), (ifc::DeclarationId{ a_id, decl }));
+
+    // Ids of evicted files are not reused.
+    a.reset();
+    environment.set_memory_budget(0);
+    ASSERT_EQ(environment.file(a_id), nullptr);
+    ASSERT_EQ(environment.file(c_id), &c);
+    a = environment.acquire_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    ASSERT_EQ(static_cast<uint32_t>(environment.file_id(*a)), 2);
+}
+
+TEST(Environment, symbols)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    auto const& a = environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    auto const& c = environment.get_module_by_bmi_path(data_dir / "C.ixx.ifc");
+
+    auto & symbols = environment.symbols();
+    ifc::File const* files[] = { &a, &c };
+    symbols.intern(files);
+    ASSERT_LE(symbols.size(), a.text_symbol_count() + c.text_symbol_count());
+
+    // Equal texts of both modules are one symbol.
+    size_t shared = 0;
+    for (auto const* file : files)
+    {
+        const auto table = symbols.symbols(*file);
+        ASSERT_EQ(table.size(), file->text_symbol_count());
+        for (uint32_t local = 0; local != table.size(); ++local)
+        {
+            const auto text = file->get_string_view(file->symbol_text(local));
+            ASSERT_EQ(symbols.text(table[local]), text);
+            ASSERT_EQ(symbols.find(text), table[local]);
+            ASSERT_EQ(symbols.symbol(*file, file->symbol_text(local)), table[local]);
+            if (file == &c && a.find_text(text))
+            {
+                ASSERT_EQ(symbols.symbol(a, *a.find_text(text)), table[local]);
+                ++shared;
+            }
+        }
+    }
+    ASSERT_GT(shared, 0);
+    ASSERT_EQ(symbols.size(), a.text_symbol_count() + c.text_symbol_count() - shared);
+    ASSERT_FALSE(symbols.find("no module has this text"));
+}
+
+TEST(TrigramIndex, search)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    auto const& a = environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    auto & symbols = environment.symbols();
+    ifc::File const* files[] = { &a };
+    symbols.intern(files);
+
+    ifc::TrigramIndex index;
+    index.update(symbols);
+    ASSERT_EQ(index.indexed(), symbols.size());
+
+    // Every identifier is found by its own text, and first among the matches of a longer pattern.
+    std::vector<std::string_view> identifiers;
+    for (uint32_t i = 0; i != symbols.size(); ++i)
+    {
+        const auto text = symbols.text(ifc::SymbolId{ i });
+        if (!text.empty() && std::ranges::all_of(text, [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }))
+            identifiers.push_back(text);
+    }
+    ASSERT_FALSE(identifiers.empty());
+    for (auto identifier : identifiers)
+    {
+        const auto matches = index.search(symbols, identifier);
+        ASSERT_FALSE(matches.empty()) << identifier;
+        ASSERT_TRUE(std::ranges::any_of(matches, [&](auto const & m) { return symbols.text(m.symbol) == identifier; })) << identifier;
+        for (auto match : matches)
+        {
+            std::string lower(symbols.text(match.symbol));
+            std::string pattern(identifier);
+            std::ranges::transform(lower, lower.begin(), [](unsigned char c) { return std::tolower(c); });
+            std::ranges::transform(pattern, pattern.begin(), [](unsigned char c) { return std::tolower(c); });
+            if (identifier.size() >= 3)
+                ASSERT_EQ(match.shared, index.search(symbols, identifier).front().shared);
+            else
+                ASSERT_NE(lower.find(pattern), std::string::npos);
+        }
+    }
+
+    // A typo still finds the identifier once a fraction of the trigrams is enough.
+    const auto longest = *std::ranges::max_element(identifiers, {}, &std::string_view::size);
+    ASSERT_GE(longest.size(), 5);
+    std::string typo(longest);
+    typo[typo.size() / 2] = '#';
+    const auto strict = index.search(symbols, typo);
+    const auto tolerant = index.search(symbols, typo, { .min_shared = 0.5f });
+    ASSERT_TRUE(std::ranges::any_of(tolerant, [&](auto const & m) { return symbols.text(m.symbol) == longest; }));
+    ASSERT_LE(strict.size(), tolerant.size());
+    ASSERT_TRUE(index.search(symbols, "no identifier has this text").empty());
+
+    // Symbols interned later are indexed by the next update.
+    auto const& c = environment.get_module_by_bmi_path(data_dir / "C.ixx.ifc");
+    ifc::File const* more[] = { &c };
+    symbols.intern(more);
+    index.update(symbols);
+    ASSERT_EQ(index.indexed(), symbols.size());
+}
+
+TEST(Environment, memory_usage)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    ASSERT_EQ(environment.memory_usage().modules, 0);
+
+    environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    environment.get_module_by_bmi_path(data_dir / "C.ixx.ifc");
+    const auto usage = environment.memory_usage();
+    ASSERT_EQ(usage.modules, 2);
+    ASSERT_EQ(usage.mapped_bytes, environment.loaded_bytes());
+    ASSERT_GT(usage.environment_heap_bytes, 0);
+}
+
+TEST(Environment, trim)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    auto const & a = environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    auto const & c = environment.get_module_by_bmi_path(data_dir / "C.ixx.ifc");
+    ASSERT_TRUE(a.find_text("f"));
+    ASSERT_TRUE(c.find_text("C"));
+    const auto heap_bytes = environment.memory_usage().file_heap_bytes;
+    ASSERT_GT(heap_bytes, 0);
+
+    // Down to what C uses, A being the least recently acquired.
+    const auto c_bytes = c.memory_usage().heap_bytes();
+    ASSERT_EQ(environment.trim(ifc::TrimLevel::All, c_bytes), heap_bytes - c_bytes);
+    ASSERT_TRUE(a.memory_usage().heap.empty());
+    ASSERT_EQ(environment.memory_usage().file_heap_bytes, c_bytes);
+
+    ASSERT_EQ(environment.trim(ifc::TrimLevel::All), c_bytes);
+    ASSERT_EQ(environment.memory_usage().modules, 2);
+    ASSERT_EQ(environment.memory_usage().file_heap_bytes, 0);
+    ASSERT_TRUE(a.find_text("f"));
+}
+
+TEST(Environment, access_profile)
+{
+    const auto config_path = (data_dir / "A.ixx.ifc.d.json").string();
+    const auto a_path = data_dir / "A.ixx.ifc";
+
+    ifc::AccessProfile profile;
+    {
+        ifc::Environment environment(ifc::read_msvc_config(config_path, data_dir), ifc::read_blob);
+        auto const & a = environment.get_module_by_bmi_path(a_path);
+        ASSERT_GT(a.functions().size(), 0);
+        environment.record_access_profile(profile);
+    }
+    ASSERT_TRUE(std::ranges::binary_search(profile.partitions, std::string("decl.function")));
+    ASSERT_EQ(ifc::AccessProfile::parse(profile.serialize()).partitions, profile.partitions);
+
+    // The next run prefetches them as it opens the BMI.
+    class RecordingHolder : public ifc::Environment::BlobHolder
+    {
+    public:
+        RecordingHolder(ifc::Environment::BlobHolderPtr blob, std::vector<ifc::File::BlobView>& prefetched)
+            : blob_(std::move(blob))
+            , prefetched_(prefetched)
+        {
+        }
+
+        ifc::File::BlobView view() const override { return blob_->view(); }
+        void prefetch(ifc::File::BlobView range) const override { prefetched_.push_back(range); }
+
+    private:
+        ifc::Environment::BlobHolderPtr blob_;
+        std::vector<ifc::File::BlobView>& prefetched_;
+    };
+
+    std::vector<ifc::File::BlobView> prefetched;
+    ifc::Environment environment(ifc::read_msvc_config(config_path, data_dir),
+        [&prefetched](std::filesystem::path const& path) -> ifc::Environment::BlobHolderPtr {
+            return std::make_unique<RecordingHolder>(ifc::read_blob(path), prefetched);
+        });
+    environment.set_file_options({ .access_profile = std::make_shared<ifc::AccessProfile>(profile) });
+    auto const & a = environment.get_module_by_bmi_path(a_path);
+    ASSERT_FALSE(prefetched.empty());
+    ASSERT_TRUE(std::ranges::equal(prefetched, profile.ranges(a), [](ifc::File::BlobView x, ifc::File::BlobView y) {
+        return x.data() == y.data() && x.size() == y.size();
+    }));
+
+    const auto functions = a.partitions_data("decl.function").front();
+    ASSERT_TRUE(std::ranges::any_of(prefetched, [&](ifc::File::BlobView range) {
+        return range.data() <= functions.data() && functions.data() + functions.size() <= range.data() + range.size();
+    }));
+}
+
+TEST(Environment, shared_store)
+{
+    std::atomic<int> reads = 0;
+    auto counting_reader = [&reads](std::filesystem::path const& path) {
+        ++reads;
+        return ifc::read_blob(path);
+    };
+    const auto config_path = (data_dir / "A.ixx.ifc.d.json").string();
+
+    auto store = std::make_shared<ifc::SharedBMIStore>();
+    ifc::Environment first(ifc::read_msvc_config(config_path, data_dir), counting_reader, store);
+    ifc::Environment second(ifc::read_msvc_config(config_path, data_dir), counting_reader, store);
+    ifc::Environment unshared(ifc::read_msvc_config(config_path, data_dir), counting_reader);
+
+    auto const& file = first.get_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    ASSERT_EQ(&file, &second.get_module_by_bmi_path(data_dir / "." / "A.ixx.ifc"));
+    ASSERT_EQ(reads, 1);
+
+    ASSERT_NE(&file, &unshared.get_module_by_bmi_path(data_dir / "A.ixx.ifc"));
+    ASSERT_EQ(reads, 2);
+}
+
+TEST(Environment, reload)
+{
+    // The BMI of A "rebuilt" as C.
+    std::atomic<bool> rebuilt = false;
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir),
+        [&rebuilt](std::filesystem::path const& path) {
+            return ifc::read_blob(rebuilt && path.filename() == "A.ixx.ifc" ? data_dir / "C.ixx.ifc" : path);
+        });
+    const auto a_path = data_dir / "A.ixx.ifc";
+
+    auto loaded = environment.reload_module_by_bmi_path(a_path);
+    ASSERT_FALSE(loaded.reloaded);
+    loaded.module.reset();
+
+    auto const& a = environment.get_module_by_bmi_path(a_path);
+    auto unchanged = environment.reload_module_by_bmi_path(a_path);
+    ASSERT_TRUE(unchanged.reloaded);
+    ASSERT_TRUE(unchanged.diff.identical);
+    ASSERT_EQ(unchanged.module.get(), &a);
+    ASSERT_EQ(environment.loaded_bytes(), file_size(a_path));
+
+    rebuilt = true;
+    auto changed = environment.reload_module_by_bmi_path(a_path);
+    ASSERT_TRUE(changed.reloaded);
+    ASSERT_FALSE(changed.diff.identical);
+    ASSERT_FALSE(changed.diff.changed_partitions.empty());
+    ASSERT_NE(changed.module.get(), &a);
+    ASSERT_EQ(&environment.get_module_by_bmi_path(a_path), changed.module.get());
+
+    // The previous version was returned by reference, so it stays loaded.
+    ASSERT_EQ(a.functions().size(), 1);
+    ASSERT_EQ(environment.loaded_bytes(), file_size(a_path) + file_size(data_dir / "C.ixx.ifc"));
+}
+
+TEST(QueryCache, reload_invalidates_dependents)
+{
+    std::atomic<bool> rebuilt = false;
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir),
+        [&rebuilt](std::filesystem::path const& path) {
+            return ifc::read_blob(rebuilt && path.filename() == "A.ixx.ifc" ? data_dir / "C.ixx.ifc" : path);
+        });
+    const auto a_path = data_dir / "A.ixx.ifc";
+    const auto c_path = data_dir / "C.ixx.ifc";
+
+    ifc::QueryCache cache;
+    int computed = 0;
+    const auto partition_count = [&](std::filesystem::path const& path) {
+        return cache.get<size_t>("partition-count", path.string(), [&](ifc::QueryCache::Reads& reads) {
+            ++computed;
+            auto const& file = environment.get_module_by_bmi_path(path);
+            reads.add(file);
+            return file.table_of_contents().size();
+        });
+    };
+
+    ASSERT_EQ(*partition_count(a_path), *partition_count(a_path));
+    partition_count(c_path);
+    ASSERT_EQ(computed, 2);
+
+    ASSERT_EQ(cache.invalidate(environment.reload_module_by_bmi_path(a_path)), 0);
+    rebuilt = true;
+    ASSERT_EQ(cache.invalidate(environment.reload_module_by_bmi_path(a_path)), 1);
+
+    partition_count(c_path);
+    ASSERT_EQ(computed, 2);
+    partition_count(a_path);
+    ASSERT_EQ(computed, 3);
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.stats().invalidated, 1);
+}
+
+TEST(QueryCache, key_cached_as_another_type)
+{
+    ifc::SHA256 checksum{};
+    checksum.data[0] = std::byte{ 1 };
+    ifc::QueryCache cache;
+    int computed = 0;
+    const auto as_size = [&] {
+        return cache.get<size_t>("kind", "key", [&](ifc::QueryCache::Reads& reads) {
+            ++computed;
+            reads.add(checksum);
+            return size_t{ 42 };
+        });
+    };
+    const auto as_string = [&] {
+        return cache.get<std::string>("kind", "key", [&](ifc::QueryCache::Reads& reads) {
+            ++computed;
+            reads.add(checksum);
+            return std::string("answer");
+        });
+    };
+
+    ASSERT_EQ(*as_size(), 42);
+    // Replaces the answer of the other type, which is computed again.
+    ASSERT_EQ(*as_string(), "answer");
+    ASSERT_EQ(*as_string(), "answer");
+    ASSERT_EQ(computed, 2);
+    ASSERT_EQ(cache.size(), 1);
+
+    // The replacing entry read the BMI too.
+    ASSERT_EQ(cache.invalidate(checksum), 1);
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(*as_string(), "answer");
+    ASSERT_EQ(computed, 3);
+}
+
+TEST(Environment, watch_for_changes)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "ifc-reader-watched-bmis";
+    std::filesystem::create_directories(directory);
+    const auto bmi = directory / "A.ixx.ifc";
+    std::filesystem::copy_file(data_dir / "A.ixx.ifc", bmi, std::filesystem::copy_options::overwrite_existing);
+
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    environment.watch_for_changes();
+    auto const& a = environment.get_module_by_bmi_path(bmi);
+    ASSERT_EQ(environment.generation(), 0);
+
+    // Rebuilt as C, replaced by a rename like build tools do.
+    std::filesystem::copy_file(data_dir / "C.ixx.ifc", directory / "A.ixx.ifc.tmp", std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::rename(directory / "A.ixx.ifc.tmp", bmi);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    ifc::File const* reloaded = &a;
+    while (reloaded == &a && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        reloaded = &environment.get_module_by_bmi_path(bmi);
+    }
+
+    ASSERT_NE(reloaded, &a);
+    ASSERT_GE(environment.generation(), 1);
+    ASSERT_EQ(reloaded->blob().size(), file_size(data_dir / "C.ixx.ifc"));
+    // The dropped version was returned by reference, so it stays valid.
+    ASSERT_EQ(a.functions().size(), 1);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(SimpleTest, peek)
+{
+    const auto blob = ifc::read_blob(data_dir / "A.ixx.ifc");
+    const auto peek = ifc::peek_file(blob->view());
+    ASSERT_EQ(peek.header.unit.sort(), ifc::UnitSort::Primary);
+    ASSERT_EQ(peek.unit_name, "A");
+    ASSERT_EQ(peek.imported_modules, (std::vector<std::string>{ "C", "A:B" }));
+    ASSERT_TRUE(peek.exported_modules.empty());
+
+    const auto transitive_b = ifc::read_blob(data_dir / "TransitiveB.ixx.ifc");
+    ASSERT_EQ(ifc::peek_file(transitive_b->view()).exported_modules, std::vector<std::string>{ "C" });
+
+    const auto truncated = blob->view().first(16);
+    ASSERT_THROW(ifc::peek_file(truncated), std::runtime_error);
+}
+
+TEST(Config, read)
+{
+    const auto config = ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir);
+    ASSERT_TRUE(config.imported_header_units.empty());
+    ASSERT_EQ(config.imported_modules.size(), 2);
+    ASSERT_EQ(config.imported_modules[0].name, "A:B");
+    ASSERT_EQ(config.imported_modules[0].bmi, data_dir / "A_B.ixx.ifc");
+    ASSERT_EQ(config.imported_modules[1].name, "C");
+    ASSERT_EQ(config.imported_modules[1].bmi, data_dir / "C.ixx.ifc");
+}
+
+TEST(Config, missing_bmi)
+{
+    const auto path = std::filesystem::temp_directory_path() / "ifc-reader-missing-bmi.d.json";
+    {
+        std::ofstream config(path);
+        config << R"({ "Version": "1.2", "Data": { "Includes": [ { "BMI": "ignored" } ],
+            "ImportedHeaderUnits": [ { "Header": "missing.h", "BMI": "missing.h.ifc" } ],
+            "ImportedModules": [] } })";
+    }
+
+    ASSERT_THROW(ifc::read_msvc_config(path.string(), data_dir), std::runtime_error);
+
+    const auto config = ifc::read_msvc_config(path.string(), data_dir, { .check_bmi_files = false });
+    ASSERT_EQ(config.imported_header_units.size(), 1);
+    ASSERT_EQ(config.imported_header_units[0].header, "missing.h");
+    ASSERT_EQ(config.imported_header_units[0].bmi, data_dir / "missing.h.ifc");
+
+    std::filesystem::remove(path);
+}
+
+TEST(Config, merged)
+{
+    const std::vector<std::string> configs{
+        (data_dir / "A.ixx.ifc.d.json").string(),
+        (data_dir / "empty.ixx.ifc.d.json").string(),
+        (data_dir / "A.ixx.ifc.d.json").string(),
+    };
+    const auto modules = ifc::read_msvc_configs(configs, data_dir);
+    ASSERT_EQ(modules->size(), 2);
+    ASSERT_EQ(*modules->find("A:B"), data_dir / "A_B.ixx.ifc");
+    ASSERT_EQ(modules->find("D"), nullptr);
+    ASSERT_EQ(modules->find(ifc::Environment::ModuleMap::NameParts{ "A", "B" }), modules->find("A:B"));
+    ASSERT_EQ(modules->find(ifc::Environment::ModuleMap::NameParts{ "C", {} }), modules->find("C"));
+    ASSERT_EQ(modules->find(ifc::Environment::ModuleMap::NameParts{ {}, "C" }), modules->find("C"));
+    ASSERT_EQ(modules->find(ifc::Environment::ModuleMap::NameParts{ "A", "C" }), nullptr);
+
+    ifc::Environment first(modules, ifc::read_blob);
+    ifc::Environment second(modules, ifc::read_blob);
+    auto const& file = first.get_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    for (auto module : file.imported_modules())
+        ASSERT_NO_THROW(second.get_referenced_module(module, file));
+
+    // "C" is C.ixx.ifc for A and TransitiveC.ixx.ifc for Transitive.
+    const std::vector<std::string> conflicting{ configs[0], (data_dir / "Transitive.ixx.ifc.d.json").string() };
+    ASSERT_THROW(ifc::read_msvc_configs(conflicting, data_dir), std::invalid_argument);
+}
+
+TEST(Config, binary_cache)
+{
+    const auto path = std::filesystem::temp_directory_path() / "ifc-reader-cached.d.json";
+    std::filesystem::copy_file(data_dir / "A.ixx.ifc.d.json", path, std::filesystem::copy_options::overwrite_existing);
+    const auto cache = ifc::msvc_config_cache_path(path.string());
+    std::filesystem::remove(cache);
+
+    const ifc::MSVCConfigOptions options{ .cache = true };
+    const auto parsed = ifc::read_msvc_config(path.string(), data_dir, options);
+    ASSERT_TRUE(is_regular_file(cache));
+
+    // Read from the cache, even with the config made unparsable behind its back, as long as its size and time are kept.
+    const auto time = std::filesystem::last_write_time(path);
+    const auto size = std::filesystem::file_size(path);
+    {
+        std::ofstream config(path, std::ios::binary);
+        config << std::string(size, ' ');
+    }
+    std::filesystem::last_write_time(path, time);
+    const auto cached = ifc::read_msvc_config(path.string(), data_dir, options);
+    ASSERT_EQ(cached.imported_modules.size(), parsed.imported_modules.size());
+    for (size_t i = 0; i != parsed.imported_modules.size(); ++i)
+    {
+        ASSERT_EQ(cached.imported_modules[i].name, parsed.imported_modules[i].name);
+        ASSERT_EQ(cached.imported_modules[i].bmi, parsed.imported_modules[i].bmi);
+    }
+
+    // Other settings or a changed config are parsed again.
+    ASSERT_THROW(ifc::read_msvc_config(path.string(), std::nullopt, options), std::runtime_error);
+    std::filesystem::last_write_time(path, time - 1s);
+    ASSERT_THROW(ifc::read_msvc_config(path.string(), data_dir, options), std::runtime_error);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(cache);
+}
+
+TEST(Config, discover_bmis)
+{
+    // "C" is the unit of both C.ixx.ifc and TransitiveC.ixx.ifc.
+    const std::vector<std::filesystem::path> data{ data_dir };
+    ASSERT_THROW(ifc::discover_bmis(data), std::invalid_argument);
+
+    const auto first = std::filesystem::temp_directory_path() / "ifc-reader-discover-first";
+    const auto second = std::filesystem::temp_directory_path() / "ifc-reader-discover-second";
+    std::filesystem::remove_all(first);
+    std::filesystem::remove_all(second);
+    create_directories(first / "partitions");
+    create_directories(second);
+    std::filesystem::copy_file(data_dir / "A.ixx.ifc", first / "A.ixx.ifc");
+    std::filesystem::copy_file(data_dir / "A_B.ixx.ifc", first / "partitions" / "A_B.ixx.ifc");
+    std::filesystem::copy_file(data_dir / "C.ixx.ifc", first / "C.ixx.ifc");
+    std::filesystem::copy_file(data_dir / "TransitiveC.ixx.ifc", second / "C.ixx.ifc");
+    std::filesystem::copy_file(data_dir / "A.ixx.ifc.d.json", first / "A.ixx.ifc.d.json");
+
+    // The first directory listing a name wins.
+    const std::vector<std::filesystem::path> directories{ first, second };
+    const auto modules = std::make_shared<ifc::Environment::ModuleMap const>(ifc::discover_bmis(directories));
+    ASSERT_EQ(modules->size(), 3);
+    ASSERT_EQ(*modules->find("A"), first / "A.ixx.ifc");
+    ASSERT_EQ(*modules->find("A:B"), first / "partitions" / "A_B.ixx.ifc");
+    ASSERT_EQ(*modules->find("C"), first / "C.ixx.ifc");
+
+    // Resolves imports like the config of A does.
+    ifc::Environment environment(modules, ifc::read_blob);
+    auto const& file = environment.get_module_by_bmi_path(first / "A.ixx.ifc");
+    for (auto module : file.imported_modules())
+        ASSERT_NO_THROW(environment.get_referenced_module(module, file));
+
+    std::filesystem::remove_all(first);
+    std::filesystem::remove_all(second);
+}
+
+TEST(Environment, resolved_imports)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    auto const& file = environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc");
+
+    const auto imported = environment.imported_files(file);
+    ASSERT_EQ(imported.size(), file.imported_modules().size());
+    for (size_t i = 0; i != imported.size(); ++i)
+        ASSERT_EQ(imported[i], &environment.get_referenced_module(file.imported_modules()[ifc::Index(i)], file));
+    ASSERT_EQ(environment.imported_files(file).data(), imported.data());
+    ASSERT_TRUE(environment.exported_files(file).empty());
+}
+
+TEST(Environment, resolve_all)
+{
+    std::atomic<int> reads = 0;
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "Transitive.ixx.ifc.d.json").string(), data_dir),
+        [&reads](std::filesystem::path const& path) {
+            ++reads;
+            return ifc::read_blob(path);
+        });
+    auto const& file = environment.get_module_by_bmi_path(data_dir / "Transitive.ixx.ifc");
+
+    // Every import twice, each BMI is still read once.
+    std::vector<ifc::ModuleReference> modules(file.imported_modules().begin(), file.imported_modules().end());
+    const auto imports = modules.size();
+    ASSERT_GT(imports, 0);
+    modules.insert(modules.end(), modules.begin(), modules.end());
+
+    std::vector<ifc::File const*> files(modules.size());
+    ifc::ThreadPool pool(4);
+    environment.resolve_all(file, modules, files, pool);
+    ASSERT_EQ(reads, 1 + static_cast<int>(imports));
+    for (size_t i = 0; i != modules.size(); ++i)
+    {
+        ASSERT_EQ(files[i], &environment.get_referenced_module(modules[i], file));
+        ASSERT_EQ(files[i], files[i % imports]);
+    }
+    ASSERT_EQ(reads, 1 + static_cast<int>(imports));
+
+    ifc::Environment unconfigured(ifc::Environment::Config{}, ifc::read_blob);
+    std::vector<ifc::File const*> none(modules.size());
+    ASSERT_THROW(unconfigured.resolve_all(file, modules, none), std::out_of_range);
+    ASSERT_THROW(environment.resolve_all(file, modules, std::span(files).first(1)), std::invalid_argument);
+}
+
+TEST(Environment, transitive_exports)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "Transitive.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    auto const& file = environment.get_module_by_bmi_path(data_dir / "Transitive.ixx.ifc");
+    // Transitive imports B, which export-imports C.
+    auto const& b = *environment.imported_files(file).front();
+    auto const& c = *environment.exported_files(b).front();
+
+    auto const& exports = environment.transitive_exports(b);
+    ASSERT_EQ(exports.size(), 2);
+    ASSERT_TRUE(exports.contains(environment.file_id(b)));
+    ASSERT_TRUE(exports.contains(environment.file_id(c)));
+    ASSERT_EQ(&environment.transitive_exports(b), &exports);
+
+    auto const& own = environment.transitive_exports(file);
+    ASSERT_EQ(own.size(), 1);
+    ASSERT_TRUE(own.contains(environment.file_id(file)));
+    ASSERT_FALSE(own.contains(environment.file_id(c)));
+
+    std::vector<ifc::FileId> ids;
+    exports.for_each([&](ifc::FileId id) { ids.push_back(id); });
+    ASSERT_EQ(ids.size(), 2);
+    ASSERT_TRUE(ids[0] < ids[1]);
+    ASSERT_EQ(environment.transitive_exports(c).size(), 1);
+}
+
+TEST(TranslationUnitLookup, visibility)
+{
+    const auto config = ifc::read_msvc_config((data_dir / "Transitive.ixx.ifc.d.json").string(), data_dir);
+    ifc::Environment environment(config, ifc::read_blob);
+    auto const& a = environment.get_module_by_bmi_path(data_dir / "Transitive.ixx.ifc");
+    auto const& b = environment.get_module_by_bmi_path(data_dir / "TransitiveB.ixx.ifc");
+    auto const& c = environment.get_module_by_bmi_path(data_dir / "TransitiveC.ixx.ifc");
+
+    // Importing B makes C visible, which B export-imports.
+    const reflifc::TranslationUnitLookup importing_b(environment, { .imported_modules = { { "B", data_dir / "TransitiveB.ixx.ifc" } } });
+    ASSERT_EQ(importing_b.visible_modules().size(), 2);
+    ASSERT_TRUE(importing_b.is_visible(b));
+    ASSERT_TRUE(importing_b.is_visible(c));
+    const auto found = importing_b.resolve("::C");
+    ASSERT_EQ(found.size(), 1);
+    ASSERT_EQ(found[0].containing_file(), &c);
+    ASSERT_EQ(importing_b.resolve("C").data(), found.data());
+    ASSERT_TRUE(importing_b.resolve("f").empty());
+
+    // Importing A, which imports B without exporting it, does not.
+    const reflifc::TranslationUnitLookup importing_a(environment, { .imported_modules = { { "A", data_dir / "Transitive.ixx.ifc" } } });
+    ASSERT_EQ(importing_a.visible_modules().size(), 1);
+    ASSERT_FALSE(importing_a.is_visible(c));
+    ASSERT_TRUE(importing_a.resolve("C").empty());
+    ASSERT_EQ(importing_a.resolve("f").size(), 1);
+    ASSERT_EQ(importing_a.resolve("f")[0].containing_file(), &a);
+}
+
+TEST(Environment, resolve_reference)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    auto const& file = environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    auto const& function = *file.functions().begin();
+    auto params_type = file.tuple_types()[file.function_types()[function.type].source].seq;
+    auto params = file.type_heap().slice(params_type);
+
+    const auto referenced_decl = file.designated_types()[params[ifc::Index{2}]].decl;
+    const auto resolved = environment.resolve_reference(file, referenced_decl);
+    ASSERT_EQ(resolved.file, &environment.get_referenced_module(file.decl_references()[referenced_decl].unit, file));
+    check_class_with_name(*resolved.file, resolved.decl, "C");
+
+    const auto again = environment.resolve_reference(file, referenced_decl);
+    ASSERT_EQ(again.file, resolved.file);
+    ASSERT_EQ(again.decl, resolved.decl);
+}
+
+TEST(Environment, resolve_all_references)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "A.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    auto const& file = environment.get_module_by_bmi_path(data_dir / "A.ixx.ifc");
+    const auto all = environment.resolve_all_references(file);
+    ASSERT_EQ(all.size(), file.decl_references().size());
+    ASSERT_FALSE(all.empty());
+    for (uint32_t i = 0; i != all.size(); ++i)
+    {
+        const ifc::DeclIndex reference{ static_cast<uint32_t>(ifc::DeclSort::Reference), i };
+        const auto resolved = environment.resolve_reference(file, reference);
+        ASSERT_EQ(all[i].file, resolved.file);
+        ASSERT_EQ(all[i].decl, resolved.decl);
+    }
+    ASSERT_EQ(environment.resolve_all_references(file).data(), all.data());
+}
+
+TEST(ModuleGraph, transitive)
+{
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "Transitive.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    auto const& root = environment.get_module_by_bmi_path(data_dir / "Transitive.ixx.ifc");
+    auto const& b = environment.get_module_by_bmi_path(data_dir / "TransitiveB.ixx.ifc");
+    auto const& c = environment.get_module_by_bmi_path(data_dir / "TransitiveC.ixx.ifc");
+
+    const ifc::ModuleGraph graph(environment, root);
+    ASSERT_EQ(graph.size(), 3);
+    ASSERT_EQ(&graph.file(0), &root);
+    const auto b_node = graph.find(b);
+    const auto c_node = graph.find(c);
+    ASSERT_TRUE(b_node && c_node);
+    ASSERT_EQ(graph.dependencies(*b_node).size(), 1);
+    ASSERT_EQ(graph.dependencies(*b_node)[0], *c_node);
+    ASSERT_TRUE(graph.dependencies(*c_node).empty());
+
+    const auto order = graph.topological_order();
+    ASSERT_EQ(order.size(), 3);
+    ASSERT_EQ(order[0], *c_node);
+    ASSERT_EQ(order[1], *b_node);
+    ASSERT_EQ(order[2], 0);
+
+    std::mutex mutex;
+    std::vector<ifc::ModuleGraph::NodeId> visited;
+    ifc::ThreadPool pool(4);
+    graph.for_each_parallel([&](ifc::ModuleGraph::NodeId node) {
+        std::scoped_lock lock(mutex);
+        for (auto dependency : graph.dependencies(node))
+            ASSERT_NE(std::ranges::find(visited, dependency), visited.end());
+        visited.push_back(node);
+    }, pool);
+    ASSERT_EQ(visited.size(), 3);
+}
+
+TEST(ModuleGraph, snapshot)
+{
+    const auto directory = std::filesystem::temp_directory_path() / "ifc-reader-graph-snapshot";
+    std::filesystem::create_directories(directory);
+    for (auto name : { "Transitive.ixx.ifc", "TransitiveB.ixx.ifc", "TransitiveC.ixx.ifc" })
+        std::filesystem::copy_file(data_dir / name, directory / name, std::filesystem::copy_options::overwrite_existing);
+
+    ifc::Environment environment(ifc::read_msvc_config((data_dir / "Transitive.ixx.ifc.d.json").string(), data_dir), ifc::read_blob);
+    const ifc::ModuleGraph graph(environment, environment.get_module_by_bmi_path(data_dir / "Transitive.ixx.ifc"));
+    const auto b_node = *graph.find(environment.get_module_by_bmi_path(data_dir / "TransitiveB.ixx.ifc"));
+    const auto c_node = *graph.find(environment.get_module_by_bmi_path(data_dir / "TransitiveC.ixx.ifc"));
+
+    std::vector<std::filesystem::path> paths(graph.size());
+    paths[0] = directory / "Transitive.ixx.ifc";
+    paths[b_node] = directory / "TransitiveB.ixx.ifc";
+    paths[c_node] = directory / "TransitiveC.ixx.ifc";
+    const auto snapshot_path = directory / "graph.snapshot";
+    {
+        const auto blob = ifc::ModuleGraphSnapshot::write(graph, paths);
+        std::ofstream(snapshot_path, std::ios::binary).write(reinterpret_cast<char const*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+    }
+
+    const ifc::ModuleGraphSnapshot snapshot(ifc::read_blob(snapshot_path));
+    ASSERT_EQ(snapshot.size(), 3);
+    ASSERT_EQ(snapshot.path(b_node), paths[b_node].generic_string());
+    ASSERT_EQ(snapshot.unit_name(0), "A");
+    ASSERT_EQ(snapshot.unit_name(c_node), "C");
+    ASSERT_EQ(snapshot.checksum(c_node).data, graph.file(c_node).header().checksum.data);
+    ASSERT_EQ(snapshot.find(paths[c_node].generic_string()), c_node);
+    ASSERT_FALSE(snapshot.find("missing.ifc"));
+    ASSERT_TRUE(std::ranges::equal(snapshot.dependencies(b_node), graph.dependencies(b_node)));
+    ASSERT_TRUE(std::ranges::equal(snapshot.topological_order(), graph.topological_order()));
+
+    // Rebuilt after the snapshot was written.
+    std::filesystem::last_write_time(paths[c_node], std::filesystem::last_write_time(paths[c_node]) + std::chrono::seconds(1));
+    ASSERT_TRUE(snapshot.is_current(b_node));
+    ASSERT_FALSE(snapshot.is_current(c_node));
+    ASSERT_FALSE(snapshot.is_current());
+
+    ASSERT_THROW(ifc::ModuleGraphSnapshot(ifc::read_blob(data_dir / "C.ixx.ifc")), std::runtime_error);
+}
+
 int main(int argc, char* argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -1,9 +1,26 @@
 ﻿#include "reflifc/Module.h"
+#include "reflifc/Chart.h"
+#include "reflifc/Compact.h"
+#include "reflifc/DeclarationQuery.h"
 #include "reflifc/Expression.h"
+#include "reflifc/FlatMap.h"
+#include "reflifc/JsonWriter.h"
+#include "reflifc/Layout.h"
+#include "reflifc/Macro.h"
+#include "reflifc/Mangler.h"
+#include "reflifc/NameArena.h"
+#include "reflifc/Outline.h"
 #include "reflifc/Query.h"
+#include "reflifc/Sentence.h"
+#include "reflifc/Signatures.h"
+#include "reflifc/SideTable.h"
+#include "reflifc/Subset.h"
+#include "reflifc/SyntaxWalker.h"
 #include "reflifc/TemplateId.h"
 #include "reflifc/Type.h"
 #include "reflifc/TupleView.h"
+#include "reflifc/Visit.h"
+#include "reflifc/Walk.h"
 #include "reflifc/Word.h"
 #include "reflifc/decl/Function.h"
 #include "reflifc/decl/Variable.h"
@@ -11,15 +28,55 @@
 #include "reflifc/decl/TemplateDeclaration.h"
 #include "reflifc/decl/Specialization.h"
 #include "reflifc/expr/Call.h"
+#include "reflifc/index/AttributeIndex.h"
+#include "reflifc/index/BaseLinearization.h"
+#include "reflifc/index/ClassHierarchy.h"
+#include "reflifc/index/CompletionIndex.h"
+#include "reflifc/index/ConceptChecker.h"
+#include "reflifc/index/EnclosingScopeIndex.h"
+#include "reflifc/index/EntityIdentity.h"
+#include "reflifc/index/GlobalSymbolIndex.h"
+#include "reflifc/index/IdentifierIndex.h"
+#include "reflifc/index/LiteralTable.h"
+#include "reflifc/index/MacroTable.h"
+#include "reflifc/index/OverloadSetIndex.h"
+#include "reflifc/index/ParentIndex.h"
+#include "reflifc/index/PositionIndex.h"
+#include "reflifc/index/QualifiedNameList.h"
+#include "reflifc/index/Reachability.h"
+#include "reflifc/index/ScopeNameIndex.h"
+#include "reflifc/index/SentenceTextIndex.h"
+#include "reflifc/index/SourceFileIndex.h"
+#include "reflifc/index/SpecializationIndex.h"
+#include "reflifc/index/TemplateArgumentIndex.h"
+#include "reflifc/index/TemplateSubstitution.h"
+#include "reflifc/index/TypeHashIndex.h"
+#include "reflifc/index/TypeLayoutIndex.h"
+#include "reflifc/index/TypeStripTable.h"
+#include "reflifc/index/TypeUseIndex.h"
+#include "reflifc/index/UsingResolver.h"
 #include "reflifc/type/Function.h"
 #include "reflifc/type/Base.h"
 #include "reflifc/type/Pointer.h"
 
+#include <ifc/AllocationCounter.h>
+#include <ifc/Attribute.h>
+#include <ifc/FileWriter.h>
+#include <ifc/Macro.h>
+#include <ifc/Word.h>
 #include <ifc/blob_reader.h>
 
 #include <gtest/gtest.h>
 
+#include "SyntheticFile.h"
+
+#include <cstring>
 #include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 static std::filesystem::path data_dir;
 
@@ -118,209 +175,2559 @@ TEST(SimpleTest, attributes)
     }
 }
 
-TEST(TupleExprView, empty)
+TEST(Scope, find)
 {
-    const auto wrapper = ModuleWrapper::create("tuple-expr-view-empty.ixx.ifc");
-    auto module = wrapper.module;
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
 
-    const auto top_level_declarations = module.global_namespace().get_declarations();
-    ASSERT_EQ(top_level_declarations.size(), 1);
+    const auto a = global.find("a");
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(has_name(a->as_function(), "a"));
 
-    const auto decl = top_level_declarations[0];
-    ASSERT_TRUE(decl.is_template());
+    const auto e = global.find("e");
+    ASSERT_TRUE(e.has_value());
+    ASSERT_TRUE(has_name(e->as_scope(), "e"));
 
-    const auto primary_template = decl.as_template().entity();
-    ASSERT_TRUE(primary_template.is_variable());
+    ASSERT_EQ(std::ranges::distance(global.find_all("c")), 1);
+    ASSERT_FALSE(global.find("f").has_value());
+    ASSERT_TRUE(std::ranges::empty(global.find_all("no such name")));
+}
 
-    const auto variable = primary_template.as_variable();
-    ASSERT_TRUE(is_identifier(variable.name(), "var"));
+TEST(Query, scope_members_by_kind)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
 
-    const auto type = variable.type();
-    ASSERT_TRUE(type.is_decltype());
+    ASSERT_EQ(std::ranges::distance(get_scope_declarations(global)), 2);
 
-    const auto decltype_argument = type.decltype_argument();
-    ASSERT_TRUE(decltype_argument.is_call());
+    // In declaration order.
+    auto classes = get_classes_and_structs(global);
+    auto it = classes.begin();
+    ASSERT_TRUE(is_identifier((*it++).name(), "d"));
+    ASSERT_TRUE(is_identifier((*it++).name(), "e"));
+    ASSERT_TRUE(it == classes.end());
 
-    const auto call_arguments = decltype_argument.as_call().arguments();
-    ASSERT_TRUE(call_arguments.empty());
-    ASSERT_EQ(call_arguments.size(), 0);
-    ASSERT_EQ(call_arguments.begin(), call_arguments.end());
+    // Grouped by kind, classes come before structs.
+    auto const * file = global.containing_file();
+    const auto by_kind = file->get_index<reflifc::ScopeSortIndex>().scope_members(*file, global.index(), ifc::TypeBasis::Class, ifc::TypeBasis::Struct);
+    ASSERT_EQ(by_kind.size(), 2);
+    ASSERT_EQ(by_kind[0], (*std::next(classes.begin())).index());
+    ASSERT_EQ(by_kind[1], (*classes.begin()).index());
 }
 
-TEST(TupleExprView, single_element)
+TEST(Query, resolve)
 {
-    const auto wrapper = ModuleWrapper::create("tuple-expr-view-single-element.ixx.ifc");
-    auto module = wrapper.module;
+    const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
 
-    const auto top_level_declarations = module.global_namespace().get_declarations();
-    ASSERT_EQ(top_level_declarations.size(), 1);
+    const auto x = reflifc::resolve(wrapper.module, "X");
+    ASSERT_TRUE(x.has_value());
+    ASSERT_TRUE(x->is_template());
 
-    const auto decl = top_level_declarations[0];
-    ASSERT_TRUE(decl.is_template());
+    const auto a = reflifc::resolve(wrapper.module, "::X::A");
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(has_name(a->as_scope(), "A"));
+    ASSERT_EQ(reflifc::resolve(wrapper.module, "X::A"), a);
 
-    const auto primary_template = decl.as_template().entity();
-    ASSERT_TRUE(primary_template.is_function());
+    ASSERT_TRUE(reflifc::resolve(wrapper.module, "a").has_value());
+    ASSERT_FALSE(reflifc::resolve(wrapper.module, "X::B").has_value());
+    ASSERT_FALSE(reflifc::resolve(wrapper.module, "Y::A").has_value());
+    ASSERT_FALSE(reflifc::resolve(wrapper.module, "a::A").has_value());
+}
 
-    const auto function = primary_template.as_function();
-    ASSERT_TRUE(is_identifier(function.name(), "f"));
+TEST(Query, qualified_name)
+{
+    const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
+    const auto x = reflifc::resolve(wrapper.module, "X");
+    const auto a = reflifc::resolve(wrapper.module, "X::A");
+    const auto variable = reflifc::resolve(wrapper.module, "a");
+    ASSERT_TRUE(x && a && variable);
 
-    const auto return_type = function.type().return_type();
-    ASSERT_TRUE(return_type.is_decltype());
+    auto const & file = *a->containing_file();
+    auto const & parents = file.get_index<reflifc::ParentIndex>();
+    ASSERT_EQ(parents.parent(a->index()), x->index());
+    ASSERT_TRUE(parents.parent(x->index()).is_null());
 
-    const auto decltype_argument = return_type.decltype_argument();
-    ASSERT_TRUE(decltype_argument.is_call());
+    std::string buffer;
+    ASSERT_EQ(reflifc::qualified_name(*a, buffer), "X::A");
+    ASSERT_EQ(reflifc::qualified_name(*variable, buffer), "a");
+    ASSERT_EQ(buffer, "a");
+}
 
-    const auto call_arguments = decltype_argument.as_call().arguments();
-    ASSERT_EQ(call_arguments.size(), 1);
-    ASSERT_FALSE(call_arguments.begin() == call_arguments.end());
+TEST(EnclosingScopeIndex, matches_parents)
+{
+    for (auto name : { "template-reference.ixx.ifc", "class-specialization.ixx.ifc", "class-bases.ixx.ifc" })
+    {
+        const auto wrapper = ModuleWrapper::create(name);
+        auto const & file = *wrapper.module.global_namespace().containing_file();
+        auto const & index = file.get_index<reflifc::EnclosingScopeIndex>();
+        auto const & parents = file.get_index<reflifc::ParentIndex>();
 
-    const auto argument = call_arguments[0];
-    ASSERT_TRUE(argument.is_unqualified_id());
+        const auto members = file.declarations();
+        for (uint32_t i = 0; i != members.size(); ++i)
+        {
+            const auto scope = reflifc::enclosing_scope(wrapper.module, ifc::Index{ i });
+            if (!scope)
+                continue;
+            const auto member = members.begin()[i].index;
+            ASSERT_EQ(index.parent(ifc::Index{ i }), parents.parent(member)) << name << " " << i;
+            const auto siblings = scope->get_declarations();
+            ASSERT_TRUE(std::ranges::find(siblings, reflifc::Declaration(&file, member)) != siblings.end());
+        }
+        ASSERT_FALSE(reflifc::enclosing_scope(wrapper.module, ifc::Index{ static_cast<uint32_t>(members.size()) }));
+    }
 }
 
-TEST(Class, bases)
+TEST(NameArena, names_outlive_growth)
 {
-    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
-    auto module = wrapper.module;
+    const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
+    const auto a = reflifc::resolve(wrapper.module, "X::A");
+    ASSERT_TRUE(a);
 
-    auto classes = get_classes_and_structs(module);
-    auto it = classes.begin();
+    reflifc::NameArena arena(8);
+    const auto qualified = reflifc::qualified_name(*a, arena);
+    const auto built = arena.append("operator").append('(').append(')').finish();
+    std::vector<std::string_view> many;
+    for (int i = 0; i != 100; ++i)
+        many.push_back(arena.store("name"));
+
+    ASSERT_EQ(qualified, "X::A");
+    ASSERT_EQ(qualified.data()[qualified.size()], '\0');
+    ASSERT_EQ(built, "operator()");
+    ASSERT_EQ(many.back(), "name");
+}
+
+TEST(ConstantEvaluator, non_constant_expressions)
+{
+    const auto wrapper = ModuleWrapper::create("class-specialization.ixx.ifc");
+    const auto x1 = reflifc::resolve(wrapper.module, "x1");
+    ASSERT_TRUE(x1 && x1->is_variable());
 
+    auto const & file = *x1->containing_file();
+    auto const & evaluator = file.get_index<reflifc::ConstantEvaluator>();
+    ASSERT_FALSE(evaluator.value(file, x1->index()));
+    ASSERT_FALSE(evaluator.evaluate(file, {}));
+
+    // The template argument of X<void> is a type, evaluated only once.
+    const auto declarations = wrapper.module.global_namespace().get_declarations();
+    const auto argument = declarations[2].as_specialization().form().arguments().front();
+    ASSERT_TRUE(argument.is_type());
+    ASSERT_FALSE(reflifc::evaluate(argument));
+    ASSERT_FALSE(reflifc::evaluate(argument));
+}
+
+// The test modules have no constant expressions to speak of, one is written with the header and strings of a module:
+// enum { E = 7 }; constexpr unsigned char v = 3 - E * 3; unsigned char w = 3 - E * 3;
+// and a few more expressions over the literals 7, 3, 0, 300 and 2.5.
+TEST(ConstantEvaluator, literals_arithmetic_and_enumerators)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(*wrapper.module.global_namespace().containing_file());
+
+    ifc::FundamentalType fundamentals[4]{};
+    fundamentals[0].basis = ifc::TypeBasis::Int;
+    fundamentals[1].basis = ifc::TypeBasis::Char;
+    fundamentals[1].sign = ifc::TypeSign::Unsigned;
+    fundamentals[2].basis = ifc::TypeBasis::Double;
+    fundamentals[3].basis = ifc::TypeBasis::Bool;
+    const auto int_type = type(ifc::TypeSort::Fundamental, 0);
+    const auto uchar_type = type(ifc::TypeSort::Fundamental, 1);
+    const auto double_type = type(ifc::TypeSort::Fundamental, 2);
+    const auto bool_type = type(ifc::TypeSort::Fundamental, 3);
+
+    const ifc::IntegerLiteral integers[] = { { 300 } };
+    ifc::FPLiteral floating{};
+    const double two_and_a_half = 2.5;
+    std::memcpy(floating.raw_data, &two_and_a_half, sizeof two_and_a_half);
+
+    auto literal = [](ifc::TypeIndex type, ifc::LiteralSort sort, uint32_t index) {
+        ifc::LiteralExpression result{};
+        result.type = type;
+        result.value = { static_cast<uint32_t>(sort), index };
+        return result;
+    };
+    const ifc::LiteralExpression literals[] = {
+        literal(int_type, ifc::LiteralSort::Immediate, 7),
+        literal(int_type, ifc::LiteralSort::Immediate, 3),
+        literal(int_type, ifc::LiteralSort::Immediate, 0),
+        literal(uchar_type, ifc::LiteralSort::Integer, 0),
+        literal(double_type, ifc::LiteralSort::FloatingPoint, 0),
+    };
+    const auto seven = expr(ifc::ExprSort::Literal, 0);
+    const auto three = expr(ifc::ExprSort::Literal, 1);
+    const auto zero = expr(ifc::ExprSort::Literal, 2);
+
+    ifc::Enumerator enumerator{};
+    enumerator.name = bmi.text("E");
+    enumerator.type = int_type;
+    enumerator.initializer = seven;
+    ifc::NamedDecl named{};
+    named.type = int_type;
+    named.resolution = decl(ifc::DeclSort::Enumerator, 0);
+    ifc::ReadExpression read{};
+    read.type = int_type;
+    read.address = expr(ifc::ExprSort::NamedDecl, 0);
+    const auto e = expr(ifc::ExprSort::Read, 0);
+
+    auto dyad = [](ifc::TypeIndex type, ifc::DyadicOperator op, ifc::ExprIndex lhs, ifc::ExprIndex rhs) {
+        ifc::DyadExpression result{};
+        result.type = type;
+        result.op = op;
+        result.arguments[0] = lhs;
+        result.arguments[1] = rhs;
+        return result;
+    };
+    const ifc::DyadExpression dyads[] = {
+        dyad(int_type, ifc::DyadicOperator::Mult, e, three),
+        dyad(int_type, ifc::DyadicOperator::Minus, three, expr(ifc::ExprSort::Dyad, 0)),
+        dyad(double_type, ifc::DyadicOperator::Plus, expr(ifc::ExprSort::Literal, 4), three),
+        dyad(bool_type, ifc::DyadicOperator::Less, three, e),
+        dyad(int_type, ifc::DyadicOperator::Slash, seven, zero),
+        dyad(int_type, ifc::DyadicOperator::Lshift, three, three),
+    };
+    ifc::MonadExpression negate{};
+    negate.type = int_type;
+    negate.op = ifc::MonadicOperator::Negate;
+    negate.argument = e;
+
+    ifc::VariableDeclaration variables[2]{};
+    variables[0].name = bmi.identifier("v");
+    variables[0].type = uchar_type;
+    variables[0].initializer = expr(ifc::ExprSort::Dyad, 1);
+    variables[0].traits = ifc::ObjectTraits::Constexpr;
+    variables[1] = variables[0];
+    variables[1].name = bmi.identifier("w");
+    variables[1].traits = ifc::ObjectTraits::None;
+
+    bmi.add(fundamentals);
+    bmi.add(integers);
+    bmi.add(floating);
+    bmi.add(literals);
+    bmi.add(enumerator);
+    bmi.add(named);
+    bmi.add(read);
+    bmi.add(dyads);
+    bmi.add(negate);
+    bmi.add(variables);
+    const auto blob = bmi.write();
+    const ifc::File file(blob, { .validate = true });
+
+    auto const & evaluator = file.get_index<reflifc::ConstantEvaluator>();
+    ASSERT_EQ(evaluator.evaluate(file, seven), reflifc::Constant{ int64_t{ 7 } });
+    // 300 does not fit an unsigned char.
+    ASSERT_EQ(evaluator.evaluate(file, expr(ifc::ExprSort::Literal, 3)), reflifc::Constant{ uint64_t{ 44 } });
+    ASSERT_EQ(evaluator.evaluate(file, expr(ifc::ExprSort::Literal, 4)), reflifc::Constant{ 2.5 });
+
+    ASSERT_EQ(evaluator.value(file, decl(ifc::DeclSort::Enumerator, 0)), reflifc::Constant{ int64_t{ 7 } });
+    ASSERT_EQ(evaluator.evaluate(file, e), reflifc::Constant{ int64_t{ 7 } });
+    ASSERT_EQ(evaluator.evaluate(file, expr(ifc::ExprSort::Dyad, 0)), reflifc::Constant{ int64_t{ 21 } });
+    ASSERT_EQ(evaluator.evaluate(file, expr(ifc::ExprSort::Dyad, 1)), reflifc::Constant{ int64_t{ -18 } });
+    ASSERT_EQ(evaluator.evaluate(file, expr(ifc::ExprSort::Dyad, 2)), reflifc::Constant{ 5.5 });
+    ASSERT_EQ(evaluator.evaluate(file, expr(ifc::ExprSort::Dyad, 3)), reflifc::Constant{ uint64_t{ 1 } });
+    ASSERT_FALSE(evaluator.evaluate(file, expr(ifc::ExprSort::Dyad, 4)));
+    ASSERT_EQ(evaluator.evaluate(file, expr(ifc::ExprSort::Dyad, 5)), reflifc::Constant{ int64_t{ 24 } });
+    ASSERT_EQ(evaluator.evaluate(file, expr(ifc::ExprSort::Monad, 0)), reflifc::Constant{ int64_t{ -7 } });
+
+    // -18 converted to the type of the variable, only the constexpr one has a value.
+    ASSERT_EQ(evaluator.value(file, decl(ifc::DeclSort::Variable, 0)), reflifc::Constant{ uint64_t{ 238 } });
+    ASSERT_FALSE(evaluator.value(file, decl(ifc::DeclSort::Variable, 1)));
+    ASSERT_GT(evaluator.heap_bytes(), 0);
+}
+
+TEST(EnumerationTable, file_without_enumerations)
+{
+    const auto wrapper = ModuleWrapper::create("class-specialization.ixx.ifc");
+    auto const & file = *wrapper.module.global_namespace().containing_file();
+    ASSERT_FALSE(file.has_partition(ifc::Enumerator::PartitionName));
+    ASSERT_TRUE(file.has_partition(ifc::ScopeDeclaration::PartitionName));
+
+    ASSERT_TRUE(file.get_index<reflifc::EnumerationTable>().entries().empty());
+}
+
+TEST(SpecializationIndex, find_by_arguments)
+{
+    const auto wrapper = ModuleWrapper::create("class-specialization.ixx.ifc");
+    const auto declarations = wrapper.module.global_namespace().get_declarations();
+    const auto X = declarations[0].index();
+    const auto X_void = declarations[2].index();
+    ASSERT_EQ(X_void.sort(), ifc::DeclSort::Specialization);
+
+    auto const & file = *wrapper.module.global_namespace().containing_file();
+    auto const & index = file.get_index<reflifc::SpecializationIndex>();
+
+    const auto specializations = index.specializations(file, X);
+    ASSERT_NE(std::ranges::find(specializations, X_void), specializations.end());
+    ASSERT_NE(std::ranges::find(specializations, declarations[1].index()), specializations.end());
+    ASSERT_TRUE(index.specializations(file, X_void).empty());
+
+    // X<void> from the hash of `void`.
+    const auto form = file.specialization_forms()[file.specializations()[X_void].form];
+    const auto argument = form.arguments.sort() == ifc::ExprSort::Tuple
+        ? *file.expr_heap().slice(file.tuple_expressions()[form.arguments].seq).begin()
+        : form.arguments;
+    const auto void_type = file.type_expressions()[argument].denotation;
+    const uint64_t hashes[] = { file.get_index<reflifc::TypeHashIndex>().hash(file, void_type) };
+    ASSERT_EQ(reflifc::TemplateArgumentIndex::combine(hashes), file.get_index<reflifc::TemplateArgumentIndex>().hash(file, form.arguments));
+
+    const auto found = index.find(file, X, reflifc::TemplateArgumentIndex::combine(hashes));
+    ASSERT_EQ(found.size(), 1);
+    ASSERT_EQ(found[0], X_void);
+}
+
+// The test modules have no class template with members, one is written with the header and strings of a module:
+// template<typename T> struct S { using value_type = T; T* p; using same_type = value_type; };
+// and two uses of S<int>.
+TEST(TemplateSubstitution, member_types)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(*wrapper.module.global_namespace().containing_file());
+
+    ifc::FundamentalType fundamentals[2]{};
+    fundamentals[0].basis = ifc::TypeBasis::Int;
+    fundamentals[1].basis = ifc::TypeBasis::Struct;
+    const ifc::DesignatedType designated[] = { { decl(ifc::DeclSort::Parameter, 0) }, { decl(ifc::DeclSort::Alias, 0) } };
+    const ifc::PointerType pointers[] = { { type(ifc::TypeSort::Designated, 0) } };
+
+    ifc::ParameterDeclaration parameter{};
+    parameter.name = bmi.text("T");
+    parameter.level = ifc::ParameterLevel{ 1 };
+    parameter.position = ifc::ParameterPosition{ 1 };
+    parameter.sort = ifc::ParameterSort::Type;
+    ifc::ChartUnilevel chart{};
+    chart.cardinality = ifc::Cardinality{ 1 };
+    ifc::TemplateDeclaration template_{};
+    template_.name = bmi.identifier("S");
+    template_.chart = ifc::ChartIndex{ static_cast<uint32_t>(ifc::ChartSort::Unilevel), 0 };
+    template_.entity.decl = decl(ifc::DeclSort::Scope, 0);
+    ifc::ScopeDeclaration scope{};
+    scope.name = template_.name;
+    scope.type = type(ifc::TypeSort::Fundamental, 1);
+    scope.initializer = ifc::ScopeIndex{ 1 };
+    const ifc::Sequence scopes[] = { { ifc::Index{ 0 }, ifc::Cardinality{ 3 } } };
+    const ifc::Declaration members[] = { { decl(ifc::DeclSort::Alias, 0) }, { decl(ifc::DeclSort::Field, 0) }, { decl(ifc::DeclSort::Alias, 1) } };
+    ifc::AliasDeclaration aliases[2]{};
+    aliases[0].name = bmi.text("value_type");
+    aliases[0].aliasee = type(ifc::TypeSort::Designated, 0);
+    aliases[1].name = bmi.text("same_type");
+    aliases[1].aliasee = type(ifc::TypeSort::Designated, 1);
+    ifc::FieldDeclaration field{};
+    field.name = bmi.text("p");
+    field.type = type(ifc::TypeSort::Pointer, 0);
+    ifc::TypeExpression argument{};
+    argument.denotation = type(ifc::TypeSort::Fundamental, 0);
+    const ifc::ExprIndex int_argument{ static_cast<uint32_t>(ifc::ExprSort::Type), 0 };
+    const ifc::SpecializationForm forms[] = { { decl(ifc::DeclSort::Template, 0), int_argument }, { decl(ifc::DeclSort::Template, 0), int_argument } };
+
+    bmi.add(fundamentals);
+    bmi.add(designated);
+    bmi.add(pointers);
+    bmi.add(parameter);
+    bmi.add(chart);
+    bmi.add(template_);
+    bmi.add(scope);
+    bmi.add("scope.desc", scopes);
+    bmi.add(members);
+    bmi.add(aliases);
+    bmi.add(field);
+    bmi.add(argument);
+    bmi.add(forms);
+    const auto blob = bmi.write();
+    const ifc::File file(blob, { .validate = true });
+
+    reflifc::TemplateSubstitution substitution;
+    const reflifc::SpecializationForm s_int(&file, file.specialization_forms()[ifc::SpecFormIndex{ 0 }]);
+    const auto member_types = substitution.member_types(s_int);
+    ASSERT_EQ(member_types.size(), 3);
+    ASSERT_EQ(substitution.bindings(s_int)->arguments().size(), 1);
+
+    // `T` and the alias of `T` are the argument, in the file and bound to nothing.
+    for (auto name : { "value_type", "same_type" })
     {
-        auto a = *it++;
-        ASSERT_TRUE(is_identifier(a.name(), "A"));
-        ASSERT_TRUE(a.bases().empty());
+        const auto value_type = substitution.member_type(s_int, name);
+        ASSERT_TRUE(value_type) << name;
+        ASSERT_EQ(value_type->type.index(), type(ifc::TypeSort::Fundamental, 0)) << name;
+        ASSERT_EQ(value_type->bindings, nullptr) << name;
     }
 
+    // `T*` is not in the file, its pointee is substituted on the way down.
+    const auto p = substitution.member_type(s_int, "p");
+    ASSERT_TRUE(p && p->bindings && p->type.is_pointer());
+    const auto pointee = substitution.substitute({ p->type.as_pointer().pointee, p->bindings });
+    ASSERT_EQ(pointee.type.index(), type(ifc::TypeSort::Fundamental, 0));
+    ASSERT_FALSE(substitution.member_type(s_int, "q"));
+
+    // The second S<int> has the same argument list, its members are those of the first.
+    const reflifc::SpecializationForm again(&file, file.specialization_forms()[ifc::SpecFormIndex{ 1 }]);
+    ASSERT_EQ(substitution.member_types(again).data(), member_types.data());
+    ASSERT_EQ(substitution.size(), 1);
+    ASSERT_GT(substitution.heap_bytes(), 0);
+}
+
+TEST(ConceptChecker, type_traits_and_concept_ids)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(*wrapper.module.global_namespace().containing_file());
+
+
+    // template<class T> concept IsClass = __is_class(T);
+    // template<class U> concept Wrapped = IsClass<U> && !__is_enum(U);
+    // struct S;
+    ifc::FundamentalType fundamentals[2]{};
+    fundamentals[0].basis = ifc::TypeBasis::Int;
+    fundamentals[1].basis = ifc::TypeBasis::Struct;
+    const ifc::DesignatedType designated[] = { { decl(ifc::DeclSort::Parameter, 0) }, { decl(ifc::DeclSort::Scope, 0) }, { decl(ifc::DeclSort::Parameter, 1) } };
+
+    ifc::ParameterDeclaration parameters[2]{};
+    for (auto& parameter : parameters)
     {
-        auto b = *it++;
-        auto bases = b.bases();
-        ASSERT_EQ(bases.size(), 1);
-        auto base = *bases.begin();
-        ASSERT_EQ(base.specifiers, ifc::BaseType::Specifiers::Expanded);
-        ASSERT_TRUE(base.type.is_designated());
-        auto base_type = base.type.designation();
-        ASSERT_TRUE(base_type.is_parameter());
-        ASSERT_EQ(base_type.as_parameter().sort(), ifc::ParameterSort::Type);
+        parameter.level = ifc::ParameterLevel{ 1 };
+        parameter.position = ifc::ParameterPosition{ 1 };
+        parameter.sort = ifc::ParameterSort::Type;
+    }
+    parameters[0].name = bmi.text("T");
+    parameters[1].name = bmi.text("U");
+    ifc::ChartUnilevel charts[2]{};
+    charts[0].cardinality = ifc::Cardinality{ 1 };
+    charts[1].start = ifc::Index{ 1 };
+    charts[1].cardinality = ifc::Cardinality{ 1 };
+    ifc::ScopeDeclaration scope{};
+    scope.name = ifc::NameIndex{ static_cast<uint32_t>(ifc::NameSort::Identifier), static_cast<uint32_t>(bmi.text("S")) };
+    scope.type = type(ifc::TypeSort::Fundamental, 1);
+
+    ifc::TypeExpression type_expressions[2]{};
+    type_expressions[0].denotation = type(ifc::TypeSort::Designated, 0);
+    type_expressions[1].denotation = type(ifc::TypeSort::Designated, 2);
+    ifc::MonadExpression monads[3]{};
+    monads[0].op = ifc::MonadicOperator::MsvcIsClass;
+    monads[0].argument = expr(ifc::ExprSort::Type, 0);
+    monads[1].op = ifc::MonadicOperator::MsvcIsEnum;
+    monads[1].argument = expr(ifc::ExprSort::Type, 1);
+    monads[2].op = ifc::MonadicOperator::Not;
+    monads[2].argument = expr(ifc::ExprSort::Monad, 1);
+    ifc::NamedDecl named{};
+    named.resolution = decl(ifc::DeclSort::Concept, 0);
+    ifc::TemplateId template_id{};
+    template_id.primary = expr(ifc::ExprSort::NamedDecl, 0);
+    template_id.arguments = expr(ifc::ExprSort::Type, 1);
+    ifc::DyadExpression conjunction{};
+    conjunction.op = ifc::DyadicOperator::LogicAnd;
+    conjunction.arguments[0] = expr(ifc::ExprSort::TemplateId, 0);
+    conjunction.arguments[1] = expr(ifc::ExprSort::Monad, 2);
+
+    ifc::Concept concepts[2]{};
+    concepts[0].name = bmi.text("IsClass");
+    concepts[0].chart = ifc::ChartIndex{ static_cast<uint32_t>(ifc::ChartSort::Unilevel), 0 };
+    concepts[0].constraint = expr(ifc::ExprSort::Monad, 0);
+    concepts[1].name = bmi.text("Wrapped");
+    concepts[1].chart = ifc::ChartIndex{ static_cast<uint32_t>(ifc::ChartSort::Unilevel), 1 };
+    concepts[1].constraint = expr(ifc::ExprSort::Dyad, 0);
+
+    bmi.add(fundamentals);
+    bmi.add(designated);
+    bmi.add(parameters);
+    bmi.add(charts);
+    bmi.add(scope);
+    bmi.add(type_expressions);
+    bmi.add(monads);
+    bmi.add(named);
+    bmi.add(template_id);
+    bmi.add(conjunction);
+    bmi.add(concepts);
+    const auto blob = bmi.write();
+    const ifc::File file(blob, { .validate = true });
+
+    const reflifc::Concept is_class(&file, file.concepts()[decl(ifc::DeclSort::Concept, 0)]);
+    const reflifc::Concept wrapped(&file, file.concepts()[decl(ifc::DeclSort::Concept, 1)]);
+    const reflifc::Type int_type(&file, type(ifc::TypeSort::Fundamental, 0));
+    const reflifc::Type s(&file, type(ifc::TypeSort::Designated, 1));
+    const reflifc::Type t(&file, type(ifc::TypeSort::Designated, 0));
+
+    reflifc::ConceptChecker checker;
+    ASSERT_EQ(checker.check(is_class, std::array{ s }), reflifc::Satisfaction::Satisfied);
+    ASSERT_EQ(checker.check(is_class, std::array{ int_type }), reflifc::Satisfaction::Unsatisfied);
+    ASSERT_EQ(checker.check(wrapped, std::array{ s }), reflifc::Satisfaction::Satisfied);
+    ASSERT_EQ(checker.check(wrapped, std::array{ int_type }), reflifc::Satisfaction::Unsatisfied);
+
+    // A parameter bound to nothing is not a kind of type, and the chart has one parameter.
+    ASSERT_EQ(checker.check(wrapped, std::array{ t }), reflifc::Satisfaction::Unknown);
+    ASSERT_EQ(checker.check(is_class, std::array{ s, s }), reflifc::Satisfaction::Unknown);
+
+    // Checked again, every atom is memoized, including `__is_class(T)` reached through `IsClass<U>`.
+    const auto memoized = checker.size();
+    ASSERT_GT(memoized, 0);
+    ASSERT_EQ(checker.check(wrapped, std::array{ s }), reflifc::Satisfaction::Satisfied);
+    ASSERT_EQ(checker.check(is_class, std::array{ int_type }), reflifc::Satisfaction::Unsatisfied);
+    ASSERT_EQ(checker.size(), memoized);
+    ASSERT_GT(checker.heap_bytes(), 0);
+}
+
+TEST(Mangler, decorated_names)
+{
+    const auto decorated = [](reflifc::Module module) {
+        auto const & file = *module.global_namespace().containing_file();
+        const auto names = reflifc::decorate_module(module);
+        std::map<std::string, std::string> result;
+        reflifc::Mangler mangler(file);
+        for (size_t i = 0; i != names.size(); ++i)
+        {
+            // Same as one by one.
+            EXPECT_EQ(mangler.decorated_name(names.decls[i]), names.names[i]);
+            std::string buffer;
+            result.emplace(file.get_index<reflifc::ParentIndex>().qualified_name(file, names.decls[i], buffer), names.names[i]);
+        }
+        return result;
+    };
+
+    {
+        const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+        const std::map<std::string, std::string> expected{
+            { "a", "?a@@YAXXZ" },
+            { "b", "?b@@YAHXZ" },
+            { "c", "?c@@3PEAXEA" },
+        };
+        ASSERT_EQ(decorated(wrapper.module), expected);
     }
 
+    // Specializations are not decorated.
     {
-        auto c = *it++;
-        ASSERT_EQ(c.bases().size(), 3);
+        const auto wrapper = ModuleWrapper::create("class-specialization.ixx.ifc");
+        ASSERT_TRUE(decorated(wrapper.module).empty());
     }
 
-    ASSERT_EQ(it, classes.end());
+    // namespace ns { struct S { S(int); ~S(); int get(S const&, S const&) const; private: static bool flag; }; }
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(*wrapper.module.global_namespace().containing_file());
+
+
+    ifc::FundamentalType fundamentals[4]{};
+    fundamentals[0].basis = ifc::TypeBasis::Int;
+    fundamentals[1].basis = ifc::TypeBasis::Struct;
+    fundamentals[2].basis = ifc::TypeBasis::Namespace;
+    fundamentals[3].basis = ifc::TypeBasis::Bool;
+    const ifc::DesignatedType designated[] = { { decl(ifc::DeclSort::Scope, 1) } };
+    const ifc::QualifiedType qualified[] = { { type(ifc::TypeSort::Designated, 0), ifc::Qualifiers::Const } };
+    const ifc::LvalueReference references[] = { { type(ifc::TypeSort::Qualified, 0) } };
+    const ifc::TypeIndex type_heap[] = { type(ifc::TypeSort::LvalueReference, 0), type(ifc::TypeSort::LvalueReference, 0) };
+    const ifc::TupleType tuples[] = { { ifc::Index{ 0 }, ifc::Cardinality{ 2 } } };
+    ifc::MethodType method_type{};
+    method_type.target = type(ifc::TypeSort::Fundamental, 0);
+    method_type.source = type(ifc::TypeSort::Tuple, 0);
+    method_type.traits = ifc::FunctionTypeTraits::Const;
+    ifc::TorType tor_type{};
+    tor_type.source = type(ifc::TypeSort::Fundamental, 0);
+
+    ifc::ScopeDeclaration scopes[2]{};
+    scopes[0].name = bmi.identifier("ns");
+    scopes[0].type = type(ifc::TypeSort::Fundamental, 2);
+    scopes[1].name = bmi.identifier("S");
+    scopes[1].type = type(ifc::TypeSort::Fundamental, 1);
+    scopes[1].home_scope = decl(ifc::DeclSort::Scope, 0);
+    ifc::MethodDeclaration method{};
+    method.name = bmi.identifier("get");
+    method.type = type(ifc::TypeSort::Method, 0);
+    method.home_scope = decl(ifc::DeclSort::Scope, 1);
+    method.access = ifc::Access::Public;
+    ifc::Constructor constructor{};
+    constructor.name = bmi.text("S");
+    constructor.type = type(ifc::TypeSort::Tor, 0);
+    constructor.home_scope = method.home_scope;
+    constructor.access = ifc::Access::Public;
+    ifc::Destructor destructor{};
+    destructor.name = constructor.name;
+    destructor.home_scope = method.home_scope;
+    destructor.access = ifc::Access::Public;
+    ifc::VariableDeclaration variable{};
+    variable.name = bmi.identifier("flag");
+    variable.type = type(ifc::TypeSort::Fundamental, 3);
+    variable.home_scope = method.home_scope;
+    variable.access = ifc::Access::Private;
+
+    bmi.add(fundamentals);
+    bmi.add(designated);
+    bmi.add(qualified);
+    bmi.add(references);
+    bmi.add("heap.type", type_heap);
+    bmi.add(tuples);
+    bmi.add(method_type);
+    bmi.add(tor_type);
+    bmi.add(scopes);
+    bmi.add(method);
+    bmi.add(constructor);
+    bmi.add(destructor);
+    bmi.add(variable);
+    const auto blob = bmi.write();
+    const ifc::File file(blob);
+
+    // `S` and `ns` are back-referenced by the second and third name, `S const&` by the first parameter.
+    reflifc::Mangler mangler(file);
+    EXPECT_EQ(mangler.decorated_name(decl(ifc::DeclSort::Method, 0)), "?get@S@ns@@QEBAHAEBU12@0@Z");
+    EXPECT_EQ(mangler.decorated_name(decl(ifc::DeclSort::Constructor, 0)), "??0S@ns@@QEAA@H@Z");
+    EXPECT_EQ(mangler.decorated_name(decl(ifc::DeclSort::Destructor, 0)), "??1S@ns@@QEAA@XZ");
+    EXPECT_EQ(mangler.decorated_name(decl(ifc::DeclSort::Variable, 0)), "?flag@S@ns@@0_NA");
+    EXPECT_TRUE(mangler.decorated_name(decl(ifc::DeclSort::Scope, 1)).empty());
 }
 
-static void check_is_var_of_instantiation_type(reflifc::Declaration decl, std::string_view var_name, reflifc::Declaration type_primary_template)
+TEST(TemplateArgumentIndex, same_arguments)
 {
-    ASSERT_TRUE(decl.is_variable());
-    auto var = decl.as_variable();
-    ASSERT_TRUE(is_identifier(var.name(), var_name));
-    auto type = var.type();
-    ASSERT_TRUE(type.is_syntactic());
-    auto syntactic_type = type.as_syntactic();
-    ASSERT_TRUE(syntactic_type.is_template_id());
-    ASSERT_EQ(syntactic_type.as_template_id().primary().referenced_decl(), type_primary_template);
-}
+    const auto wrapper = ModuleWrapper::create("class-specialization.ixx.ifc");
+    const auto declarations = wrapper.module.global_namespace().get_declarations();
+    const auto pointer_form = declarations[1].as_partial_specialization().form();
+    const auto void_form = declarations[2].as_specialization().form();
 
-using namespace std::string_view_literals;
+    ASSERT_TRUE(reflifc::same_arguments(void_form, void_form));
+    ASSERT_FALSE(reflifc::same_arguments(void_form, pointer_form));
+    ASSERT_NE(reflifc::arguments_hash(void_form), reflifc::arguments_hash(pointer_form));
 
-TEST(Class, specialization)
+    // Across files, by hash.
+    const auto other = ModuleWrapper::create("class-specialization.ixx.ifc");
+    const auto other_void_form = other.module.global_namespace().get_declarations()[2].as_specialization().form();
+    ASSERT_NE(other_void_form.containing_file(), void_form.containing_file());
+    ASSERT_TRUE(reflifc::same_arguments(void_form, other_void_form));
+    ASSERT_FALSE(reflifc::same_arguments(pointer_form, other_void_form));
+}
+
+TEST(ChartParameterIndex, flat_parameters)
 {
     const auto wrapper = ModuleWrapper::create("class-specialization.ixx.ifc");
-    auto declarations = wrapper.module.global_namespace().get_declarations();
+    const auto declarations = wrapper.module.global_namespace().get_declarations();
 
-    auto it = declarations.begin();
+    const auto primary = declarations[0].as_template().chart();
+    ASSERT_TRUE(primary.is_unilevel());
+    ASSERT_FALSE(primary.is_multilevel());
+    ASSERT_TRUE(std::ranges::equal(primary.parameters(), primary.as_unilevel().parameters()));
+    ASSERT_EQ(std::ranges::distance(primary.parameters()), 1);
 
-    const auto X_primary_template = *it++;
-    ASSERT_TRUE(X_primary_template.is_template());
+    const auto partial = declarations[1].as_partial_specialization().chart();
+    const auto parameters = partial.parameters();
+    ASSERT_EQ(std::ranges::distance(parameters), 1);
+    ASSERT_EQ(std::string_view(parameters.front().name()), "T");
+}
 
+TEST(OverloadSetIndex, functions_and_templates)
+{
     {
-        auto templ = X_primary_template.as_template();
-        ASSERT_TRUE(is_identifier(templ.name(), "X"));
-        ASSERT_TRUE(templ.entity().is_class_or_struct());
+        const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+        const auto global = wrapper.module.global_namespace();
+        const auto a = global.find_overloads("a");
+        ASSERT_EQ(std::ranges::distance(a), 1);
+        ASSERT_TRUE(a.front().is_function());
+        ASSERT_TRUE(std::ranges::empty(global.find_overloads("c")));
+        ASSERT_TRUE(std::ranges::empty(global.find_overloads("e")));
+        ASSERT_TRUE(std::ranges::empty(global.find_overloads("not a name")));
     }
-
     {
-        auto decl = *it++;
-        ASSERT_TRUE(decl.is_partial_specialization());
-        auto spec = decl.as_partial_specialization();
-        auto name = spec.name();
-        ASSERT_TRUE(name.is_identifier());
-        auto form = spec.form();
-        ASSERT_EQ(form.primary_template(), X_primary_template);
-        auto tempargs = form.arguments();
-        ASSERT_EQ(tempargs.size(), 1);
-        auto templarg = tempargs.front();
-        ASSERT_TRUE(templarg.is_type());
-        auto typearg = templarg.as_type();
-        ASSERT_TRUE(typearg.is_pointer());
-        auto pointee = typearg.as_pointer().pointee;
-        ASSERT_TRUE(pointee.is_designated());
-        auto designation = pointee.designation();
-        ASSERT_TRUE(designation.is_parameter());
-        ASSERT_EQ(designation.as_parameter().name(), "T"sv);
-        auto entity = spec.entity();
-        ASSERT_TRUE(entity.is_class_or_struct());
-        ASSERT_TRUE(entity.as_class_or_struct().name() == name);
+        const auto wrapper = ModuleWrapper::create("tuple-expr-view-single-element.ixx.ifc");
+        const auto f = wrapper.module.global_namespace().find_overloads("f");
+        ASSERT_EQ(std::ranges::distance(f), 1);
+        ASSERT_TRUE(f.front().is_template());
     }
+}
 
-    {
-        auto decl = *it++;
-        ASSERT_TRUE(decl.is_specialization());
-        auto spec = decl.as_specialization();
-        auto form = spec.form();
-        ASSERT_EQ(form.primary_template(), X_primary_template);
-        auto tempargs = form.arguments();
-        ASSERT_EQ(tempargs.size(), 1);
-        auto templarg = tempargs.front();
-        ASSERT_TRUE(templarg.is_type());
-        auto typearg = templarg.as_type();
-        ASSERT_TRUE(typearg.is_fundamental());
-        ASSERT_EQ(typearg.as_fundamental().basis, ifc::TypeBasis::Void);
-        ASSERT_TRUE(spec.entity().is_class_or_struct());
-        ASSERT_EQ(spec.sort(), ifc::SpecializationSort::Explicit);
-    }
+TEST(OverloadSetIndex, heap_bytes)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+    auto const& file = *global.containing_file();
 
-    check_is_var_of_instantiation_type(*it++, "x1", X_primary_template);
-    check_is_var_of_instantiation_type(*it++, "x2", X_primary_template);
-    check_is_var_of_instantiation_type(*it++, "x3", X_primary_template);
+    auto const& index = file.get_index<reflifc::OverloadSetIndex>();
+    const auto before = index.heap_bytes();
+    ASSERT_EQ(std::ranges::distance(global.find_overloads("a")), 1);
+    ASSERT_GT(index.heap_bytes(), before);
 
-    ASSERT_EQ(it, declarations.end());
+    const auto usage = file.memory_usage();
+    ASSERT_TRUE(std::ranges::any_of(usage.heap, [&](auto const& heap) {
+        return heap.name == typeid(reflifc::OverloadSetIndex).name() && heap.bytes == sizeof(reflifc::OverloadSetIndex) + index.heap_bytes();
+    }));
 }
 
-TEST(Expression, TemplateReference)
+TEST(JsonWriter, declarations)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+
+    std::string json;
+    reflifc::write_json(wrapper.module, json);
+    ASSERT_TRUE(json.starts_with("{\"module\":"));
+    ASSERT_TRUE(json.ends_with("]}"));
+    ASSERT_NE(json.find("{\"kind\":\"function\",\"name\":\"a\""), std::string::npos);
+    ASSERT_NE(json.find("{\"kind\":\"variable\",\"name\":\"c\""), std::string::npos);
+    ASSERT_NE(json.find("{\"kind\":\"struct\",\"name\":\"d\""), std::string::npos);
+    ASSERT_NE(json.find("{\"kind\":\"class\",\"name\":\"e\""), std::string::npos);
+
+    ifc::ThreadPool pool(2);
+    std::string parallel;
+    reflifc::write_json(wrapper.module, parallel, { .executor = &pool });
+    ASSERT_EQ(parallel, json);
+}
+
+TEST(FileContext, compact_handles)
 {
     const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
-    auto declarations = wrapper.module.global_namespace().get_declarations();
+    const auto declarations = wrapper.module.global_namespace().get_declarations();
+    ASSERT_FALSE(declarations.empty());
 
-    auto it = declarations.begin();
+    const reflifc::FileContext context(declarations[0].containing_file());
+    std::vector<reflifc::CompactDeclaration> compact;
+    for (auto decl : declarations)
+        compact.push_back(context.compact(decl));
 
-    const auto X = *it++;
-    ASSERT_TRUE(X.is_template());
+    ASSERT_EQ(sizeof(compact[0]), 4);
+    for (size_t i = 0; i != compact.size(); ++i)
+        ASSERT_EQ(context[compact[i]], declarations[i]);
+}
 
-    auto templ = X.as_template();
-    ASSERT_TRUE(is_identifier(templ.name(), "X"));
-    ASSERT_TRUE(templ.entity().is_class_or_struct());
+TEST(Sentence, words_and_text)
+{
+    const auto wrapper = ModuleWrapper::create("tuple-expr-view-single-element.ixx.ifc");
+    auto const & file = *wrapper.module.global_namespace().get_declarations()[0].containing_file();
+    ASSERT_EQ(file.sentences().size(), 1);
+    ASSERT_EQ(file.words().size(), 15);
 
-    auto decl = *it++;
-    ASSERT_TRUE(decl.is_variable());
-    auto var = decl.as_variable();
-    ASSERT_TRUE(is_identifier(var.name(), "a"));
-    auto type = var.type();
-    ASSERT_TRUE(type.is_syntactic());
-    auto syntactic_type = type.as_syntactic();
-    ASSERT_TRUE(syntactic_type.is_template_reference());
-    auto template_ref = syntactic_type.as_template_reference();
-    auto member_name = template_ref.member_name();
-    ASSERT_TRUE(is_identifier(member_name, "A"));
-    ASSERT_TRUE(template_ref.arguments().empty());
-    auto member = template_ref.member();
-    ASSERT_TRUE(member.is_class_or_struct());
-    auto member_class = member.as_class_or_struct();
-    ASSERT_EQ(member_class.name(), member_name);
-    ASSERT_EQ(member_class.home_scope(), X);
+    const reflifc::Sentence sentence(&file, ifc::SentenceIndex{1});
+    ASSERT_EQ(sentence.words().size(), 15);
+    ASSERT_TRUE(reflifc::Sentence(&file, ifc::SentenceIndex{0}).words().empty());
+
+    std::vector<ifc::WordSort> sorts;
+    sentence.sorts(sorts);
+    ASSERT_EQ(sorts.size(), 15);
+    ASSERT_EQ(sorts[0], ifc::WordSort::Keyword);
+    ASSERT_EQ(sorts[1], ifc::WordSort::Identifier);
+    ASSERT_EQ(sorts[2], ifc::WordSort::Punctuator);
+    ASSERT_EQ(sorts[6], ifc::WordSort::Operator);
+
+    ASSERT_EQ(reflifc::Word(&file, sentence.words()[7]).spelling(), "decltype");
+    ASSERT_EQ(sentence.text(), "auto f(_T0 x)->decltype(g(x))");
+    ASSERT_EQ(sentence.text().data(), sentence.text().data());
+    ASSERT_GT(file.get_index<reflifc::SentenceTextIndex>().heap_bytes(), 0);
+}
+
+TEST(SortFilter, scope_members_of_sort)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+
+    std::vector<std::string_view> functions;
+    for (auto decl : global.get_declarations(ifc::DeclSort::Function))
+        functions.push_back(decl.as_function().name().as_identifier());
+    ASSERT_EQ(functions, (std::vector<std::string_view>{ "a", "b" }));
+
+    ASSERT_EQ(std::ranges::distance(global.get_declarations(ifc::DeclSort::Scope)), 2);
+    ASSERT_EQ(std::ranges::distance(global.find_all("c", ifc::DeclSort::Variable)), 1);
+    ASSERT_EQ(std::ranges::distance(global.find_all("c", ifc::DeclSort::Function)), 0);
+
+    const auto bases = ModuleWrapper::create("class-bases.ixx.ifc");
+    // The bases of `C`: A, B<Us>... and B<Us...>.
+    ASSERT_EQ(std::ranges::distance(reflifc::get_heap_types(bases.module, ifc::TypeSort::Base)), 3);
+}
+
+TEST(SyntaxWalker, interest_and_descend)
+{
+    constexpr reflifc::SyntaxSortSet sorts = { ifc::SyntaxSort::DecltypeSpecifier, ifc::SyntaxSort::Tuple };
+    static_assert(sorts.contains(ifc::SyntaxSort::Tuple) && !sorts.contains(ifc::SyntaxSort::TypeId));
+    static_assert(reflifc::SyntaxSortSet::all().contains(ifc::SyntaxSort::TypeId));
+
+    const auto wrapper = ModuleWrapper::create("tuple-expr-view-single-element.ixx.ifc");
+    auto const & file = *wrapper.module.global_namespace().containing_file();
+    ASSERT_EQ(file.decltype_specifiers().size(), 1);
+    const ifc::SyntaxIndex decltype_specifier{ static_cast<uint32_t>(ifc::SyntaxSort::DecltypeSpecifier), 0 };
+
+    std::vector<reflifc::Syntax> visited;
+    reflifc::SyntaxWalker walker({ ifc::SyntaxSort::DecltypeSpecifier });
+    walker.walk(file, decltype_specifier, [&] (reflifc::Syntax syntax) { visited.push_back(syntax); });
+    ASSERT_EQ(visited, (std::vector{ reflifc::Syntax(&file, decltype_specifier) }));
+
+    walker.walk(file, {}, [&] (reflifc::Syntax syntax) { visited.push_back(syntax); });
+    ASSERT_EQ(visited.size(), 1);
+
+    reflifc::SyntaxWalker template_ids({ ifc::SyntaxSort::TemplateId });
+    template_ids.walk(file, decltype_specifier, [&] (reflifc::Syntax syntax) { visited.push_back(syntax); return false; });
+    ASSERT_EQ(visited.size(), 1);
+}
+
+TEST(SimpleTest, called_attribute_arguments)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto e = wrapper.module.global_namespace().find("e");
+    ASSERT_TRUE(e);
+
+    const auto attributes = e->attributes();
+    ASSERT_EQ(std::ranges::distance(attributes), 1);
+    const auto attribute = *attributes.begin();
+    ASSERT_TRUE(attribute.is_called());
+    ASSERT_EQ(attribute.sort(), ifc::AttrSort::Called);
+
+    const auto called = attribute.as_called();
+    check_identifier_attribute(called.function(), "deprecated");
+    const auto arguments = called.argument_list();
+    ASSERT_EQ(arguments.size(), 1);
+    ASSERT_EQ(arguments[0], called.arguments());
+    ASSERT_TRUE(arguments[0].is_basic());
+    // A string literal token, spelled without its quotes.
+    ASSERT_EQ(arguments[0].as_basic().spelling(), "use class 'f' instead");
+}
+
+TEST(ConstraintIndex, normalized)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    auto const & file = *wrapper.module.global_namespace().containing_file();
+    auto const & index = file.get_index<reflifc::ConstraintIndex>();
+
+    // The templates of the module are unconstrained.
+    for (uint32_t i = 0; i != file.template_declarations().size(); ++i)
+        ASSERT_TRUE(index.constrained_by(ifc::DeclIndex{ static_cast<uint32_t>(ifc::DeclSort::Template), i }).empty());
+    ASSERT_TRUE(index.normalized(file, {}).nodes.empty());
+
+    // A template-id naming a class template is an atomic constraint without concepts.
+    const ifc::ExprIndex template_id{ static_cast<uint32_t>(ifc::ExprSort::TemplateId), 0 };
+    auto const & normalized = reflifc::normalized_constraint(reflifc::Expression(&file, template_id));
+    ASSERT_EQ(normalized.nodes.size(), 1);
+    ASSERT_EQ(normalized.nodes[0].kind, reflifc::NormalizedConstraint::Kind::Atomic);
+    ASSERT_EQ(normalized.nodes[0].atom, template_id);
+    ASSERT_TRUE(normalized.concepts.empty());
+    ASSERT_EQ(&index.normalized(file, template_id), &normalized);
+}
+
+TEST(LineTable, locations)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+
+    const auto a = location(*global.find("a"));
+    ASSERT_TRUE(a.file.ends_with(".ixx"));
+    ASSERT_EQ(a.line, 4);
+    ASSERT_EQ(a.column, 22);
+    const auto e = location(*global.find("e"));
+    ASSERT_EQ(e.file, a.file);
+    ASSERT_EQ(e.line, 12);
+
+    auto const & file = *global.containing_file();
+    const auto unknown = file.get_index<reflifc::LineTable>().locate(ifc::SourceLocation{ ifc::LineIndex{ 1'000'000 }, ifc::Column{ 3 } });
+    ASSERT_TRUE(unknown.file.empty());
+    ASSERT_EQ(unknown.line, 0);
+    ASSERT_EQ(unknown.column, 3);
+}
+
+TEST(SourceFileIndex, declarations)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+    auto const & file = *global.containing_file();
+    auto const & index = file.get_index<reflifc::SourceFileIndex>();
+
+    const auto a = *global.find("a");
+    const auto path = reflifc::location(a).file;
+    const auto declarations = reflifc::get_source_file_declarations(wrapper.module, path);
+    ASSERT_TRUE(std::ranges::find(declarations, a) != declarations.end());
+    ASSERT_TRUE(std::ranges::find(declarations, *global.find("e")) != declarations.end());
+
+    // Every declaration is in the group of its source file, once.
+    std::set<ifc::DeclIndex> seen;
+    for (auto source_file : index.source_files())
+    {
+        for (auto decl : index.declarations(source_file))
+        {
+            ASSERT_EQ(reflifc::location(reflifc::Declaration(&file, decl)).file, source_file);
+            ASSERT_TRUE(seen.insert(decl).second);
+        }
+    }
+    ASSERT_EQ(seen.size(), file.scope_declarations().size() + file.functions().size() + file.variables().size());
+    ASSERT_TRUE(index.declarations("not-a-source-file.h").empty());
+}
+
+TEST(Outline, lazy_expansion)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    reflifc::Outline outline(wrapper.module);
+    using Kind = reflifc::OutlineKind;
+
+    // Counts come from the scopes, before any child is created.
+    ASSERT_EQ(outline.child_count(reflifc::Outline::Root), 5);
+    ASSERT_EQ(outline.child_count(reflifc::Outline::Root, Kind::Class), 2);
+    ASSERT_EQ(outline.child_count(reflifc::Outline::Root, Kind::Function), 2);
+    ASSERT_EQ(outline.child_count(reflifc::Outline::Root, Kind::Variable), 1);
+    ASSERT_EQ(outline.child_count(reflifc::Outline::Root, Kind::Other), 0);
+    ASSERT_FALSE(outline.is_expanded(reflifc::Outline::Root));
+    ASSERT_EQ(outline.size(), 1);
+
+    // Children are grouped by kind, in declaration order within a kind: classes before structs, as the
+    // ScopeSortIndex groups them.
+    std::vector<std::string_view> names;
+    for (auto child : outline.children(reflifc::Outline::Root))
+    {
+        names.push_back(outline.name(child));
+        ASSERT_EQ(outline.parent(child), reflifc::Outline::Root);
+    }
+    ASSERT_EQ(names, (std::vector<std::string_view>{ "e", "d", "a", "b", "c" }));
+    ASSERT_EQ(outline.size(), 6);
+    ASSERT_EQ(outline.kind(outline.child(reflifc::Outline::Root, 2)), Kind::Function);
+    ASSERT_EQ(outline.declaration(outline.child(reflifc::Outline::Root, 4)), *wrapper.module.global_namespace().find("c"));
+
+    // `e` is an empty class, `d` is only declared.
+    ASSERT_TRUE(outline.children(outline.child(reflifc::Outline::Root, 0)).empty());
+    ASSERT_FALSE(outline.has_children(outline.child(reflifc::Outline::Root, 1)));
+    ASSERT_EQ(outline.size(), 6);
+}
+
+TEST(Outline, class_template_members)
+{
+    const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
+    reflifc::Outline outline(wrapper.module);
+
+    const auto x = outline.child(reflifc::Outline::Root, 0);
+    ASSERT_EQ(outline.kind(x), reflifc::OutlineKind::Template);
+    ASSERT_EQ(outline.name(x), "X");
+    ASSERT_EQ(outline.child_count(x, reflifc::OutlineKind::Class), 1);
+    ASSERT_EQ(outline.size(), 3);
+
+    const auto members = outline.children(x);
+    ASSERT_EQ(members.size(), 1);
+    ASSERT_EQ(outline.name(members[0]), "A");
+    ASSERT_EQ(outline.kind(members[0]), reflifc::OutlineKind::Class);
+    ASSERT_EQ(outline.parent(members[0]), x);
+}
+
+TEST(PositionIndex, innermost)
+{
+    const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+    auto const & file = *global.containing_file();
+    auto const & index = file.get_index<reflifc::PositionIndex>();
+
+    // `X` is a class template with a member class `A`, followed by the variable `a`.
+    const auto x = *global.find("X");
+    const auto a = *global.find("a");
+    const auto member = *x.as_template().entity().as_class_or_struct().scope().find("A");
+    const auto x_at = reflifc::location(x), member_at = reflifc::location(member), a_at = reflifc::location(a);
+    ASSERT_LT(x_at.line, member_at.line);
+    ASSERT_LT(member_at.line, a_at.line);
+
+    ASSERT_EQ(reflifc::declaration_at(wrapper.module, x_at.file, x_at.line, x_at.column), x);
+    ASSERT_EQ(reflifc::declaration_at(wrapper.module, x_at.file, member_at.line, member_at.column + 3), member);
+    ASSERT_EQ(reflifc::declaration_at(wrapper.module, x_at.file, a_at.line + 1, 1), a);
+
+    // Members extend up to the next declaration: `A` up to `a`, as nothing closes it before.
+    const std::vector<ifc::DeclIndex> nested = { member.index(), x.index() };
+    ASSERT_EQ(index.enclosing(x_at.file, a_at.line, a_at.column - 1), nested);
+    ASSERT_EQ(index.enclosing(x_at.file, a_at.line, a_at.column), std::vector{ a.index() });
+
+    ASSERT_FALSE(reflifc::declaration_at(wrapper.module, x_at.file, x_at.line - 1, 1));
+    ASSERT_FALSE(reflifc::declaration_at(wrapper.module, "not-a-source-file.h", a_at.line, a_at.column));
+}
+
+TEST(AttributeIndex, find)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+
+    // `d` has a basic attribute and `e` a called one.
+    std::vector<reflifc::Declaration> deprecated;
+    std::ranges::copy(reflifc::get_declarations_with_attribute(wrapper.module, "deprecated"), std::back_inserter(deprecated));
+    ASSERT_EQ(deprecated.size(), 2);
+    ASSERT_TRUE(std::ranges::find(deprecated, *global.find("d")) != deprecated.end());
+    ASSERT_TRUE(std::ranges::find(deprecated, *global.find("e")) != deprecated.end());
+
+    auto const & file = *global.containing_file();
+    auto const & index = file.get_index<reflifc::AttributeIndex>();
+    const auto noreturn = index.find(file, "noreturn");
+    ASSERT_EQ(noreturn.size(), 1);
+    ASSERT_EQ(noreturn[0], global.find("a")->index());
+    ASSERT_TRUE(index.find(file, "reflect").empty());
+    ASSERT_TRUE(index.find(file, "gnu::noreturn").empty());
+}
+
+TEST(TypeUseIndex, users)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+    auto const & file = *global.containing_file();
+
+    // `void* c` and `void a()` both use `void`, `int b()` does not.
+    const auto c = global.find("c")->index();
+    const auto void_pointer = file.variables()[c].type;
+    const auto void_type = reflifc::TypeUseIndex::core_type(file, void_pointer);
+    ASSERT_NE(void_type, void_pointer);
+
+    auto const & index = file.get_index<reflifc::TypeUseIndex>();
+    const auto users = index.users(file, void_pointer);
+    ASSERT_TRUE(std::ranges::equal(users, index.users(file, void_type)));
+    ASSERT_TRUE(std::ranges::is_sorted(users));
+    ASSERT_TRUE(std::ranges::binary_search(users, c));
+    ASSERT_TRUE(std::ranges::binary_search(users, global.find("a")->index()));
+    ASSERT_FALSE(std::ranges::binary_search(users, global.find("b")->index()));
+
+    std::vector<reflifc::Declaration> declarations;
+    std::ranges::copy(reflifc::get_type_users(reflifc::Type(&file, void_pointer)), std::back_inserter(declarations));
+    ASSERT_EQ(declarations.size(), users.size());
+}
+
+TEST(IdentifierIndex, find)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    auto const & file = *wrapper.module.global_namespace().containing_file();
+    auto const & index = file.get_index<reflifc::IdentifierIndex>();
+
+    const auto a = index.find(file, "A");
+    ASSERT_EQ(a.size(), 1);
+    ASSERT_EQ(a[0].sort(), ifc::DeclSort::Scope);
+    ASSERT_EQ(wrapper.module.global_namespace().find("A")->index(), a[0]);
+
+    // The class templates and their scopes.
+    for (auto name : { "B", "C" })
+    {
+        const auto decls = index.find(file, name);
+        ASSERT_FALSE(decls.empty());
+        ASSERT_TRUE(std::ranges::is_sorted(decls, {}, &ifc::DeclIndex::sort));
+        ASSERT_TRUE(std::ranges::equal(index.find(file, *file.find_text(name)), decls));
+    }
+    ASSERT_TRUE(index.find(file, "no such name").empty());
+}
+
+TEST(Query, find_declarations)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    auto const & file = *wrapper.module.global_namespace().containing_file();
+
+    // Only the template parameter packs have such names.
+    auto names = [&] (std::string_view pattern, ifc::TextMatch match) {
+        std::vector<std::string_view> result;
+        for (auto decl : reflifc::find_declarations(wrapper.module, pattern, match))
+            result.push_back(file.get_string(*ifc::declaration_identifier(file, decl.index())));
+        std::ranges::sort(result);
+        return result;
+    };
+    ASSERT_EQ(names("Ts", ifc::TextMatch::Prefix), (std::vector<std::string_view>{ "Ts" }));
+    ASSERT_EQ(names("s", ifc::TextMatch::Substring), (std::vector<std::string_view>{ "Ts", "Us" }));
+    ASSERT_TRUE(names("no such name", ifc::TextMatch::Substring).empty());
+}
+
+TEST(DeclarationQuery, plans)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+    using Plan = reflifc::DeclarationQuery::Plan;
+
+    reflifc::DeclarationQuery deprecated_classes(wrapper.module);
+    deprecated_classes.with_attribute("deprecated").kind(ifc::TypeBasis::Class);
+    ASSERT_EQ(deprecated_classes.plan(), Plan::AttributeIndex);
+    ASSERT_EQ(deprecated_classes.run(), (std::vector{ *global.find("e") }));
+
+    reflifc::DeclarationQuery functions(wrapper.module);
+    functions.in(global).sort(ifc::DeclSort::Function);
+    ASSERT_EQ(functions.plan(), Plan::ScopeSortIndex);
+    ASSERT_EQ(functions.run(), (std::vector{ *global.find("a"), *global.find("b") }));
+
+    reflifc::DeclarationQuery named_b(wrapper.module);
+    named_b.named("b");
+    ASSERT_EQ(named_b.plan(), Plan::IdentifierIndex);
+    ASSERT_EQ(named_b.run(), (std::vector{ *global.find("b") }));
+
+    // Without an index the partitions are scanned, in partition order.
+    reflifc::DeclarationQuery scopes(wrapper.module);
+    scopes.sort(ifc::DeclSort::Scope).where([](reflifc::Declaration decl) { return decl.as_scope().kind() == ifc::TypeBasis::Struct; });
+    ASSERT_EQ(scopes.plan(), Plan::SortPartition);
+    ASSERT_EQ(scopes.run(), (std::vector{ *global.find("d") }));
+
+    reflifc::DeclarationQuery everything(wrapper.module);
+    ASSERT_EQ(everything.plan(), Plan::ParallelScan);
+    ASSERT_GE(everything.run().size(), 5);
+
+    reflifc::DeclarationQuery members(wrapper.module);
+    members.members_of(deprecated_classes);
+    ASSERT_EQ(members.plan(), Plan::ScopeMembers);
+    ASSERT_TRUE(members.run().empty());
+
+    reflifc::DeclarationQuery missing(wrapper.module);
+    missing.in("no::such::scope");
+    ASSERT_EQ(missing.plan(), Plan::Empty);
+    ASSERT_TRUE(missing.run().empty());
+}
+
+TEST(Visit, declarations_and_types)
+{
+    const auto wrapper = ModuleWrapper::create("tuple-expr-view-single-element.ixx.ifc");
+    const auto decl = wrapper.module.global_namespace().get_declarations()[0];
+
+    auto sort_of = [](auto handle) -> std::string_view {
+        if constexpr (std::is_same_v<decltype(handle), reflifc::TemplateDeclaration>)
+            return "template";
+        else if constexpr (std::is_same_v<decltype(handle), reflifc::Function>)
+            return "function";
+        else if constexpr (std::is_same_v<decltype(handle), reflifc::CallExpression>)
+            return "call";
+        else
+            return "other";
+    };
+    ASSERT_EQ(reflifc::visit(decl, sort_of), "template");
+
+    const auto function = decl.as_template().entity();
+    ASSERT_EQ(reflifc::visit(function, sort_of), "function");
+
+    const auto return_type = function.as_function().type().return_type();
+    ASSERT_EQ(reflifc::visit(return_type, sort_of), "other");
+    ASSERT_EQ(reflifc::visit(return_type.decltype_argument(), sort_of), "call");
+}
+
+TEST(Walk, depth_parent_and_pruning)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+
+    std::vector<reflifc::WalkEntry> entries;
+    reflifc::walk(wrapper.module, [&](reflifc::WalkEntry const& entry) { entries.push_back(entry); });
+    ASSERT_GE(entries.size(), 3);
+    ASSERT_EQ(entries[0].declaration, *global.find("A"));
+    ASSERT_EQ(entries[0].depth, 0);
+    ASSERT_FALSE(entries[0].parent);
+    for (auto const& entry : entries)
+    {
+        ASSERT_EQ(entry.depth == 0, !entry.parent);
+        if (entry.parent)
+        {
+            ASSERT_TRUE(std::ranges::find(entries, entry.parent, &reflifc::WalkEntry::declaration) != entries.end());
+        }
+    }
+
+    // Pruned at the top level, only the members of the global namespace are visited.
+    size_t top_level = 0;
+    reflifc::walk(wrapper.module, [&](reflifc::WalkEntry const&) {
+        ++top_level;
+        return false;
+    });
+    ASSERT_EQ(top_level, std::ranges::count(entries, 0u, &reflifc::WalkEntry::depth));
+
+    ifc::ThreadPool pool(4);
+    std::mutex mutex;
+    std::vector<reflifc::Declaration> parallel;
+    reflifc::walk(wrapper.module, [&](reflifc::WalkEntry const& entry) {
+        std::scoped_lock lock(mutex);
+        parallel.push_back(entry.declaration);
+    }, { .executor = &pool });
+    std::vector<reflifc::Declaration> sequential;
+    std::ranges::transform(entries, std::back_inserter(sequential), &reflifc::WalkEntry::declaration);
+    std::ranges::sort(parallel);
+    std::ranges::sort(sequential);
+    ASSERT_EQ(parallel, sequential);
+}
+
+TEST(Walk, generator_pages)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+
+    std::vector<reflifc::Declaration> walked;
+    reflifc::walk(wrapper.module, [&](reflifc::WalkEntry const& entry) { walked.push_back(entry.declaration); });
+    ASSERT_GE(walked.size(), 3);
+
+    // Pages of 2, resumed where the previous one stopped.
+    auto generator = reflifc::walk_generator(wrapper.module);
+    std::vector<reflifc::Declaration> paged;
+    for (auto page = generator.next_page(2); !page.empty(); page = generator.next_page(2))
+    {
+        ASSERT_LE(page.size(), 2);
+        std::ranges::transform(page, std::back_inserter(paged), &reflifc::WalkEntry::declaration);
+    }
+    ASSERT_EQ(paged, walked);
+    ASSERT_TRUE(generator.done());
+
+    // A loop broken out of resumes at its last element.
+    auto resumed = reflifc::walk_generator(wrapper.module);
+    for (auto const& entry : resumed)
+    {
+        ASSERT_EQ(entry.declaration, walked[0]);
+        break;
+    }
+    ASSERT_EQ((*resumed.begin()).declaration, walked[0]);
+
+    // Scope listings through generate.
+    const auto members = wrapper.module.global_namespace().get_declarations();
+    auto listing = reflifc::generate(members);
+    const auto first = listing.next_page(1);
+    ASSERT_EQ(first.size(), 1);
+    ASSERT_EQ(first[0], *members.begin());
+    ASSERT_EQ(listing.next_page(100).size() + 1, static_cast<size_t>(std::ranges::distance(members)));
+
+    ifc::CancellationToken token;
+    token.cancel();
+    auto cancelled = reflifc::walk_generator(wrapper.module, { .cancellation = &token });
+    ASSERT_THROW(cancelled.next_page(1), ifc::Cancelled);
+    ASSERT_TRUE(cancelled.done());
+}
+
+TEST(Walk, cancellation)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+
+    ifc::CancellationToken token;
+    token.cancel();
+    size_t visited = 0;
+    ASSERT_THROW(reflifc::walk(wrapper.module, [&](reflifc::WalkEntry const&) { ++visited; }, { .cancellation = &token }), ifc::Cancelled);
+    ifc::ThreadPool pool(2);
+    ASSERT_THROW(reflifc::walk(wrapper.module, [&](reflifc::WalkEntry const&) { ++visited; }, { .executor = &pool, .cancellation = &token }), ifc::Cancelled);
+    ASSERT_EQ(visited, 0);
+
+    // Cancelled from the visitor.
+    ifc::CancellationToken superseded;
+    ASSERT_THROW(reflifc::walk(wrapper.module, [&](reflifc::WalkEntry const&) {
+        superseded.cancel();
+        ifc::check_cancellation();
+    }, { .cancellation = &superseded }), ifc::Cancelled);
+}
+
+TEST(GlobalSymbolIndex, find)
+{
+    const auto first = ModuleWrapper::create("template-reference.ixx.ifc");
+    const auto second = ModuleWrapper::create("template-reference.ixx.ifc");
+    const auto a = reflifc::resolve(first.module, "X::A");
+    const auto other_a = reflifc::resolve(second.module, "X::A");
+    ASSERT_TRUE(a && other_a);
+
+    const ifc::File* files[] = { a->containing_file(), other_a->containing_file() };
+    const reflifc::GlobalSymbolIndex index(files);
+
+    const auto symbols = index.find("::X::A");
+    ASSERT_EQ(symbols.size(), 2);
+    ASSERT_EQ(symbols[0].file, files[0]);
+    ASSERT_EQ(symbols[0].decl, a->index());
+    ASSERT_EQ(symbols[1].file, files[1]);
+
+    ASSERT_EQ(index.find("X").size(), 2);
+    ASSERT_EQ(index.find("a").size(), 2);
+    ASSERT_TRUE(index.find("X::B").empty());
+    ASSERT_TRUE(index.find("Y").empty());
+}
+
+TEST(CompletionIndex, prefixes)
+{
+    const auto first = ModuleWrapper::create("template-reference.ixx.ifc");
+    const auto second = ModuleWrapper::create("class-bases.ixx.ifc");
+    auto const & first_file = *first.module.global_namespace().containing_file();
+    auto const & second_file = *second.module.global_namespace().containing_file();
+    const ifc::File* files[] = { &first_file, &second_file };
+    reflifc::CompletionIndex index(files);
+
+    std::vector<reflifc::CompletionIndex::Completion> out;
+    index.complete("::X", 10, out);
+    ASSERT_GE(out.size(), 2);
+    ASSERT_EQ(out[0].qualified_name, "X");
+    ASSERT_EQ(out[0].file, &first_file);
+    ASSERT_TRUE(std::ranges::is_sorted(out, {}, &reflifc::CompletionIndex::Completion::qualified_name));
+    ASSERT_TRUE(std::ranges::all_of(out, [](auto const & c) { return c.qualified_name.starts_with("X"); }));
+    ASSERT_TRUE(std::ranges::any_of(out, [](auto const & c) { return c.qualified_name == "X::A"; }));
+
+    // Members of the global scope only, across both files.
+    out.clear();
+    index.complete_members("", "", 100, out);
+    ASSERT_TRUE(std::ranges::none_of(out, [](auto const & c) { return c.qualified_name.find("::") != std::string_view::npos; }));
+    ASSERT_TRUE(std::ranges::any_of(out, [&](auto const & c) { return c.file == &second_file; }));
+    out.clear();
+    index.complete_members("X", "A", 100, out);
+    ASSERT_EQ(out.size(), 1);
+    ASSERT_EQ(out[0].qualified_name, "X::A");
+
+    out.clear();
+    index.complete("", 1, out);
+    ASSERT_EQ(out.size(), 1);
+
+    // A reloaded module is swapped in alone, from a written list here.
+    const auto reloaded = ModuleWrapper::create("template-reference.ixx.ifc");
+    auto const & reloaded_file = *reloaded.module.global_namespace().containing_file();
+    const auto written = first_file.get_index<reflifc::QualifiedNameList>().contents();
+    std::vector<uint64_t> aligned((written.size() + 7) / 8);
+    std::memcpy(aligned.data(), written.data(), written.size());
+    const auto contents = std::as_bytes(std::span(aligned)).first(written.size());
+    index.remove(first_file);
+    index.add(reloaded_file, std::make_shared<reflifc::QualifiedNameList const>(reloaded_file, contents));
+    ASSERT_EQ(index.file_count(), 2);
+    out.clear();
+    index.complete("X::", 10, out);
+    ASSERT_FALSE(out.empty());
+    ASSERT_TRUE(std::ranges::all_of(out, [&](auto const & c) { return c.file == &reloaded_file; }));
+
+    index.replace(reloaded_file, first_file);
+    out.clear();
+    index.complete("X::", 10, out);
+    ASSERT_EQ(out[0].file, &first_file);
+
+    // Lists of other files are rejected.
+    ASSERT_THROW(reflifc::QualifiedNameList(second_file, contents), std::runtime_error);
+}
+
+TEST(TupleExprView, empty)
+{
+    const auto wrapper = ModuleWrapper::create("tuple-expr-view-empty.ixx.ifc");
+    auto module = wrapper.module;
+
+    const auto top_level_declarations = module.global_namespace().get_declarations();
+    ASSERT_EQ(top_level_declarations.size(), 1);
+
+    const auto decl = top_level_declarations[0];
+    ASSERT_TRUE(decl.is_template());
+
+    const auto primary_template = decl.as_template().entity();
+    ASSERT_TRUE(primary_template.is_variable());
+
+    const auto variable = primary_template.as_variable();
+    ASSERT_TRUE(is_identifier(variable.name(), "var"));
+
+    const auto type = variable.type();
+    ASSERT_TRUE(type.is_decltype());
+
+    const auto decltype_argument = type.decltype_argument();
+    ASSERT_TRUE(decltype_argument.is_call());
+
+    const auto call_arguments = decltype_argument.as_call().arguments();
+    ASSERT_TRUE(call_arguments.empty());
+    ASSERT_EQ(call_arguments.size(), 0);
+    ASSERT_EQ(call_arguments.begin(), call_arguments.end());
+}
+
+TEST(TupleExprView, single_element)
+{
+    const auto wrapper = ModuleWrapper::create("tuple-expr-view-single-element.ixx.ifc");
+    auto module = wrapper.module;
+
+    const auto top_level_declarations = module.global_namespace().get_declarations();
+    ASSERT_EQ(top_level_declarations.size(), 1);
+
+    const auto decl = top_level_declarations[0];
+    ASSERT_TRUE(decl.is_template());
+
+    const auto primary_template = decl.as_template().entity();
+    ASSERT_TRUE(primary_template.is_function());
+
+    const auto function = primary_template.as_function();
+    ASSERT_TRUE(is_identifier(function.name(), "f"));
+
+    const auto return_type = function.type().return_type();
+    ASSERT_TRUE(return_type.is_decltype());
+
+    const auto decltype_argument = return_type.decltype_argument();
+    ASSERT_TRUE(decltype_argument.is_call());
+
+    const auto call_arguments = decltype_argument.as_call().arguments();
+    ASSERT_EQ(call_arguments.size(), 1);
+    ASSERT_FALSE(call_arguments.begin() == call_arguments.end());
+
+    const auto argument = call_arguments[0];
+    ASSERT_TRUE(argument.is_unqualified_id());
+}
+
+TEST(Class, bases)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    auto module = wrapper.module;
+
+    auto classes = get_classes_and_structs(module);
+    auto it = classes.begin();
+
+    {
+        auto a = *it++;
+        ASSERT_TRUE(is_identifier(a.name(), "A"));
+        ASSERT_TRUE(a.bases().empty());
+    }
+
+    {
+        auto b = *it++;
+        auto bases = b.bases();
+        ASSERT_EQ(bases.size(), 1);
+        auto base = *bases.begin();
+        ASSERT_EQ(base.specifiers, ifc::BaseType::Specifiers::Expanded);
+        ASSERT_TRUE(base.type.is_designated());
+        auto base_type = base.type.designation();
+        ASSERT_TRUE(base_type.is_parameter());
+        ASSERT_EQ(base_type.as_parameter().sort(), ifc::ParameterSort::Type);
+    }
+
+    {
+        auto c = *it++;
+        ASSERT_EQ(c.bases().size(), 3);
+    }
+
+    ASSERT_EQ(it, classes.end());
+}
+
+TEST(Query, classes_and_structs_view)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    const auto classes = get_classes_and_structs(wrapper.module);
+    static_assert(std::ranges::forward_range<decltype(classes)>);
+    static_assert(std::ranges::common_range<decltype(classes)>);
+
+    std::vector<reflifc::ClassOrStruct> all(classes.begin(), classes.end());
+    ASSERT_EQ(all.size(), 3);
+    ASSERT_TRUE(std::ranges::equal(classes, all));
+
+    // Chunks of the scope declarations hold the classes in order, whichever chunks they fall in.
+    for (size_t count : { 1, 2, 3, 7 })
+    {
+        std::vector<reflifc::ClassOrStruct> chunked;
+        for (size_t i = 0; i != count; ++i)
+            std::ranges::copy(classes.chunk(i, count), std::back_inserter(chunked));
+        ASSERT_EQ(chunked, all) << count;
+    }
+}
+
+TEST(TupleTypeView, random_access)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    auto classes = get_classes_and_structs(wrapper.module);
+    auto it = classes.begin();
+    ++it;
+    ++it;
+    auto c = *it;
+
+    auto bases = c.bases();
+    static_assert(std::ranges::random_access_range<decltype(bases)>);
+    ASSERT_EQ(std::ranges::size(bases), 3);
+    ASSERT_EQ(bases.end() - bases.begin(), 3);
+    ASSERT_EQ(std::ranges::distance(bases | std::views::drop(1)), 2);
+    ASSERT_TRUE(bases[0].type.is_designated());
+    ASSERT_EQ(bases.begin()[2].specifiers, (*std::ranges::prev(bases.end())).specifiers);
+    ASSERT_TRUE(bases.begin() < bases.end());
+}
+
+TEST(Query, collect_into_buffers)
+{
+    {
+        const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+        const auto global = wrapper.module.global_namespace();
+
+        const auto count = collect_declarations(global, {});
+        ASSERT_EQ(count, static_cast<size_t>(std::ranges::distance(global.get_declarations())));
+        std::vector<reflifc::Declaration> declarations(count);
+        ASSERT_EQ(collect_declarations(global, declarations), count);
+        ASSERT_TRUE(std::ranges::equal(declarations, global.get_declarations()));
+
+        // A smaller buffer gets the first members.
+        std::vector<reflifc::Declaration> first(1);
+        ASSERT_EQ(collect_declarations(global, first), count);
+        ASSERT_EQ(first[0], declarations[0]);
+    }
+    {
+        const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+        const auto file = wrapper.module.global_namespace().containing_file();
+        const auto scopes = file->scope_declarations();
+        auto const & c = *std::find_if(scopes.begin(), scopes.end(), [file] (ifc::ScopeDeclaration const & scope) {
+            return reflifc::TupleTypeView(file, scope.base).size() == 3;
+        });
+        const reflifc::TupleTypeView bases(file, c.base);
+
+        std::vector<reflifc::Type> types(bases.size());
+        ASSERT_EQ(collect_types(bases, types), 3);
+        ASSERT_TRUE(std::ranges::equal(types, bases));
+        ASSERT_EQ(collect_types(reflifc::TupleTypeView(), types), 0);
+    }
+}
+
+TEST(ClassHierarchy, derived_classes)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    const auto a = reflifc::resolve(wrapper.module, "A");
+    ASSERT_TRUE(a);
+
+    auto const * file = a->containing_file();
+    const reflifc::ClassHierarchy hierarchy(std::span(&file, 1));
+    ASSERT_EQ(hierarchy.size(), 3);
+
+    const auto a_id = hierarchy.find(*file, a->index());
+    ASSERT_TRUE(a_id);
+    ASSERT_TRUE(hierarchy.direct_bases(*a_id).empty());
+
+    // Only C has A for a base, its other bases are dependent.
+    const auto derived = hierarchy.all_derived(*a_id);
+    ASSERT_EQ(derived.size(), 1);
+    const auto c_id = derived.front();
+    ASSERT_TRUE(hierarchy.derives_from(c_id, *a_id));
+    ASSERT_FALSE(hierarchy.derives_from(*a_id, c_id));
+    ASSERT_EQ(hierarchy.all_bases(c_id), std::vector{ *a_id });
+    ASSERT_EQ(hierarchy.get(c_id).file, file);
+}
+
+TEST(ClassHierarchy, diamond)
+{
+    // struct Z; struct A : Z; struct B : A; struct C : A; struct D : A, B, C;
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(*wrapper.module.global_namespace().containing_file());
+
+    ifc::FundamentalType fundamentals[1]{};
+    fundamentals[0].basis = ifc::TypeBasis::Struct;
+    ifc::DesignatedType designated[4]{};
+    for (uint32_t i = 0; i != 4; ++i)
+        designated[i].decl = decl(ifc::DeclSort::Scope, i);
+    const ifc::TypeIndex heap[] = { type(ifc::TypeSort::Designated, 1), type(ifc::TypeSort::Designated, 2), type(ifc::TypeSort::Designated, 3) };
+    const ifc::TupleType tuples[] = { { { ifc::Index{ 0 }, ifc::Cardinality{ 3 } } } };
+    const ifc::TypeIndex bases[] = { {}, type(ifc::TypeSort::Designated, 0), type(ifc::TypeSort::Designated, 1), type(ifc::TypeSort::Designated, 1), type(ifc::TypeSort::Tuple, 0) };
+    ifc::ScopeDeclaration scopes[5]{};
+    for (uint32_t i = 0; i != 5; ++i)
+    {
+        scopes[i].name = bmi.identifier(std::string(1, "ZABCD"[i]));
+        scopes[i].type = type(ifc::TypeSort::Fundamental, 0);
+        scopes[i].base = bases[i];
+    }
+
+    bmi.add(fundamentals);
+    bmi.add(designated);
+    bmi.add("heap.type", heap);
+    bmi.add(tuples);
+    bmi.add(scopes);
+    const auto blob = bmi.write();
+    const ifc::File file(blob, { .validate = true });
+    auto const * files = &file;
+    const reflifc::ClassHierarchy hierarchy(std::span(&files, 1));
+    ASSERT_EQ(hierarchy.size(), 5);
+
+    // Ids follow the declarations. A is reached from D while its own bases are not done yet, the closures of
+    // B and C must still wait for it.
+    ASSERT_EQ(hierarchy.all_bases(4), (std::vector<reflifc::ClassHierarchy::ClassId>{ 0, 1, 2, 3 }));
+    ASSERT_EQ(hierarchy.all_bases(3), (std::vector<reflifc::ClassHierarchy::ClassId>{ 0, 1 }));
+    ASSERT_EQ(hierarchy.all_bases(2), (std::vector<reflifc::ClassHierarchy::ClassId>{ 0, 1 }));
+    ASSERT_EQ(hierarchy.all_bases(1), std::vector<reflifc::ClassHierarchy::ClassId>{ 0 });
+    ASSERT_TRUE(hierarchy.all_bases(0).empty());
+    ASSERT_TRUE(hierarchy.derives_from(3, 0));
+    ASSERT_FALSE(hierarchy.derives_from(3, 2));
+    ASSERT_EQ(hierarchy.all_derived(1), (std::vector<reflifc::ClassHierarchy::ClassId>{ 2, 3, 4 }));
+}
+
+TEST(Query, lookup_member)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    const auto a = reflifc::resolve(wrapper.module, "A");
+    ASSERT_TRUE(a);
+    auto const * file = a->containing_file();
+    const reflifc::ClassHierarchy hierarchy(std::span(&file, 1));
+    const auto c_decl = hierarchy.get(hierarchy.all_derived(*hierarchy.find(*file, a->index())).front()).decl;
+    const auto c = reflifc::Declaration(file, c_decl).as_scope().as_class_or_struct();
+    ASSERT_EQ(c.index(), c_decl);
+
+    ifc::Environment environment(ifc::Environment::Config{}, ifc::read_blob);
+    auto const & linearizations = file->get_index<reflifc::BaseLinearization>();
+    const auto linearization = linearizations.find(*file, c_decl, environment);
+    ASSERT_TRUE(linearization);
+
+    // C and A, the dependent bases are left out.
+    ASSERT_EQ(linearization->bases.size(), 2);
+    ASSERT_EQ(linearization->bases[0].id, environment.declaration_id(*file, c_decl));
+    ASSERT_EQ(linearization->bases[0].end, 2);
+    ASSERT_EQ(linearization->bases[1].id, environment.declaration_id(*file, a->index()));
+    ASSERT_EQ(linearization->bases[1].end, 2);
+    ASSERT_EQ(linearizations.find(*file, c_decl, environment), linearization);
+
+    // Another Environment numbers the files anew.
+    ifc::Environment other(ifc::Environment::Config{}, ifc::read_blob);
+    ASSERT_NE(linearizations.find(*file, c_decl, other), linearization);
+
+    ASSERT_TRUE(reflifc::lookup_member(c, "missing", environment).empty());
+}
+
+TEST(Query, deduction_guides_of_templates_without_guides)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    const auto b = reflifc::resolve(wrapper.module, "B");
+    ASSERT_TRUE(b.has_value());
+    ASSERT_TRUE(std::ranges::empty(reflifc::get_deduction_guides(*b)));
+}
+
+TEST(Query, friendships_of_classes_without_friends)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    ASSERT_TRUE(reflifc::get_friendships(wrapper.module).empty());
+
+    const auto a = reflifc::resolve(wrapper.module, "A");
+    ASSERT_TRUE(std::ranges::empty(a->friends()));
+    ASSERT_TRUE(std::ranges::empty(reflifc::get_befriending_classes(*a)));
+}
+
+TEST(Query, deprecations)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    reflifc::NameArena arena;
+    const auto deprecations = reflifc::get_deprecations(wrapper.module, arena);
+
+    // Without `trait.deprecated`, both come from their `[[deprecated]]` attributes.
+    ASSERT_EQ(deprecations.size(), 2);
+    const auto find = [&](std::string_view name) {
+        return std::ranges::find(deprecations, name, &reflifc::Deprecation::qualified_name);
+    };
+    ASSERT_NE(find("d"), deprecations.end());
+    ASSERT_EQ(find("d")->message, "");
+    ASSERT_NE(find("e"), deprecations.end());
+    ASSERT_EQ(find("e")->message, "use class 'f' instead");
+    ASSERT_EQ(find("e")->declaration, *wrapper.module.global_namespace().find("e"));
+}
+
+TEST(ScopeNameIndex, find_resolved_without_indirections)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+    auto const & file = *global.containing_file();
+    const auto identifier = file.find_text("e");
+    ASSERT_TRUE(identifier.has_value());
+
+    // Scopes without using-declarations or namespace aliases answer from the members grouped by identifier.
+    auto const & index = file.get_index<reflifc::ScopeNameIndex>();
+    const auto members = index.find(file, global.index(), *identifier);
+    const auto resolved = index.find_resolved(file, global.index(), *identifier);
+    ASSERT_EQ(members.size(), 1);
+    ASSERT_EQ(resolved.data(), members.data());
+
+    const auto e = global.find("e")->index();
+    ASSERT_FALSE(reflifc::UsingResolver::is_indirection(file, e));
+    ASSERT_TRUE(file.get_index<reflifc::UsingResolver>().targets(file, e).empty());
+}
+
+// The string table may store a text more than once, members are found by the text of their names.
+TEST(ScopeNameIndex, texts_stored_twice)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    auto const & original = *wrapper.module.global_namespace().containing_file();
+    SyntheticFile bmi(original);
+
+    // namespace ns {} void f(); void f(int); with names stored after strings of the same text.
+    bmi.text("ns");
+    bmi.text("f");
+    ifc::FundamentalType fundamentals[2]{};
+    fundamentals[0].basis = ifc::TypeBasis::Namespace;
+    fundamentals[1].basis = ifc::TypeBasis::Int;
+    ifc::FunctionType function_types[2]{};
+    function_types[1].source = type(ifc::TypeSort::Fundamental, 1);
+    ifc::FunctionDeclaration functions[2]{};
+    for (uint32_t i = 0; i != 2; ++i)
+    {
+        functions[i].name = bmi.identifier("f");
+        functions[i].type = type(ifc::TypeSort::Function, i);
+    }
+    ifc::ScopeDeclaration scope{};
+    scope.name = bmi.identifier("ns");
+    scope.type = type(ifc::TypeSort::Fundamental, 0);
+    const ifc::Declaration members[] = { { decl(ifc::DeclSort::Scope, 0) }, { decl(ifc::DeclSort::Function, 0) }, { decl(ifc::DeclSort::Function, 1) } };
+    std::vector<ifc::Sequence> scopes(static_cast<size_t>(original.header().global_scope));
+    scopes.back() = { ifc::Index{ 0 }, ifc::Cardinality{ 3 } };
+
+    bmi.add(fundamentals);
+    bmi.add(function_types);
+    bmi.add(functions);
+    bmi.add(scope);
+    bmi.add(members);
+    bmi.add("scope.desc", std::span<ifc::Sequence const>(scopes));
+    const auto blob = bmi.write();
+    const ifc::File file(blob, { .validate = true });
+    const auto global = reflifc::Module(&file).global_namespace();
+
+    ASSERT_NE(file.find_text("f"), ifc::TextOffset{ functions[0].name.index });
+    ASSERT_TRUE(reflifc::find_namespace_by_name(global, "ns"));
+    ASSERT_EQ(std::ranges::distance(global.find_all("f")), 2);
+    ASSERT_EQ(std::ranges::distance(global.find_overloads("f")), 2);
+
+    // Looked up by the offset of either name, too.
+    auto const & index = file.get_index<reflifc::ScopeNameIndex>();
+    ASSERT_EQ(index.find(file, global.index(), ifc::TextOffset{ functions[1].name.index }).size(), 2);
+    ASSERT_EQ(index.find_resolved(file, global.index(), ifc::TextOffset{ functions[0].name.index }).size(), 2);
+}
+
+TEST(Query, find_callables)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(*wrapper.module.global_namespace().containing_file());
+
+
+    // struct S; void f(S const&, int); void g(S const&); void h(S*); void k(int);
+    ifc::FundamentalType fundamentals[2]{};
+    fundamentals[0].basis = ifc::TypeBasis::Int;
+    fundamentals[1].basis = ifc::TypeBasis::Struct;
+    const ifc::DesignatedType designated[] = { { decl(ifc::DeclSort::Scope, 0) } };
+    const ifc::QualifiedType qualified[] = { { type(ifc::TypeSort::Designated, 0), ifc::Qualifiers::Const } };
+    const ifc::LvalueReference references[] = { { type(ifc::TypeSort::Qualified, 0) } };
+    const ifc::PointerType pointers[] = { { type(ifc::TypeSort::Designated, 0) } };
+    const ifc::TypeIndex heap[] = { type(ifc::TypeSort::LvalueReference, 0), type(ifc::TypeSort::Fundamental, 0) };
+    const ifc::TupleType tuples[] = { { { ifc::Index{ 0 }, ifc::Cardinality{ 2 } } } };
+    const ifc::TypeIndex sources[] = { type(ifc::TypeSort::Tuple, 0), type(ifc::TypeSort::LvalueReference, 0), type(ifc::TypeSort::Pointer, 0), type(ifc::TypeSort::Fundamental, 0) };
+    ifc::FunctionType function_types[4]{};
+    ifc::FunctionDeclaration functions[4]{};
+    for (uint32_t i = 0; i != 4; ++i)
+    {
+        function_types[i].source = sources[i];
+        functions[i].name = bmi.identifier(std::string(1, "fghk"[i]));
+        functions[i].type = type(ifc::TypeSort::Function, i);
+    }
+    ifc::ScopeDeclaration scope{};
+    scope.name = bmi.identifier("S");
+    scope.type = type(ifc::TypeSort::Fundamental, 1);
+
+    bmi.add(fundamentals);
+    bmi.add(designated);
+    bmi.add(qualified);
+    bmi.add(references);
+    bmi.add(pointers);
+    bmi.add("heap.type", heap);
+    bmi.add(tuples);
+    bmi.add(function_types);
+    bmi.add(functions);
+    bmi.add(scope);
+    const auto blob = bmi.write();
+    const ifc::File file(blob, { .validate = true });
+    const reflifc::Module module(&file);
+
+    const reflifc::Type s(&file, type(ifc::TypeSort::Designated, 0));
+    const reflifc::Type s_pointer(&file, type(ifc::TypeSort::Pointer, 0));
+    const reflifc::Type int_type(&file, type(ifc::TypeSort::Fundamental, 0));
+    const auto callables = [&](std::initializer_list<reflifc::Type> arguments) {
+        std::vector<std::string> names;
+        for (auto declaration : reflifc::find_callables(module, std::span(arguments.begin(), arguments.size())))
+            names.emplace_back(declaration.as_function().name().as_identifier());
+        return names;
+    };
+
+    // `S const&` accepts an S, `S*` does not, and arguments are matched by position.
+    ASSERT_EQ(callables({ s }), std::vector<std::string>{ "g" });
+    ASSERT_EQ(callables({ s, int_type }), std::vector<std::string>{ "f" });
+    ASSERT_TRUE(callables({ int_type, s }).empty());
+    ASSERT_EQ(callables({ int_type }), std::vector<std::string>{ "k" });
+    ASSERT_EQ(callables({ s_pointer }), std::vector<std::string>{ "h" });
+    ASSERT_TRUE(callables({}).empty());
+}
+
+TEST(Query, resolve_underlying_of_types_without_aliases)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+    ifc::Environment environment(ifc::Environment::Config{}, ifc::read_blob);
+
+    const auto c = global.find("c")->as_variable().type();
+    ASSERT_EQ(reflifc::resolve_underlying(c), c);
+    ASSERT_EQ(reflifc::resolve_underlying(c, environment), c);
+
+    // `void*` names `void` by a fundamental type, not through an alias.
+    const auto pointee = c.as_pointer().pointee;
+    ASSERT_EQ(reflifc::resolve_underlying(pointee), pointee);
+}
+
+TEST(ClassLayouts, empty_classes)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    const auto layouts = reflifc::extract_layouts(wrapper.module);
+
+    // A and the entities of the class templates B and C.
+    ASSERT_EQ(layouts.size(), 3);
+    ASSERT_EQ(layouts.member_offsets.size(), 4);
+    for (size_t i = 0; i != layouts.size(); ++i)
+        ASSERT_TRUE(layouts.member_types(i).empty());
+
+    const auto a = reflifc::resolve(wrapper.module, "A");
+    ASSERT_TRUE(a);
+    ASSERT_EQ(layouts.classes.front(), a->index());
+}
+
+TEST(ClassLayouts, virtual_tables_of_classes_without_virtuals)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    ifc::Environment environment(ifc::Environment::Config{}, ifc::read_blob);
+    ASSERT_TRUE(reflifc::extract_virtual_tables(wrapper.module, environment).empty());
+
+    // Tables are still built (empty) and memoized for every class, not for other declarations.
+    const auto a = reflifc::resolve(wrapper.module, "A");
+    auto const * file = a->containing_file();
+    auto const & index = file->get_index<reflifc::VirtualTableIndex>();
+    const auto table = index.find(*file, a->index(), environment);
+    ASSERT_TRUE(table);
+    ASSERT_TRUE(table->slots.empty());
+    ASSERT_EQ(index.find(*file, a->index(), environment), table);
+    ASSERT_FALSE(index.find(*file, ifc::DeclIndex{}, environment));
+}
+
+// The test modules have no virtual functions, one is written with the header and strings of a module:
+// struct A { virtual void f(int); virtual void g(); virtual ~A(); };
+// struct B : A { void g(); void f(int) const; ~B(); virtual void h() = 0; };
+TEST(ClassLayouts, virtual_tables_with_overriders)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(*wrapper.module.global_namespace().containing_file());
+
+    ifc::FundamentalType fundamentals[2]{};
+    fundamentals[0].basis = ifc::TypeBasis::Int;
+    fundamentals[1].basis = ifc::TypeBasis::Struct;
+    const ifc::DesignatedType designated[] = { { decl(ifc::DeclSort::Scope, 0) } };
+    // f(int), g() and f(int) const.
+    ifc::MethodType method_types[3]{};
+    method_types[0].source = type(ifc::TypeSort::Fundamental, 0);
+    method_types[2].source = type(ifc::TypeSort::Fundamental, 0);
+    method_types[2].traits = ifc::FunctionTypeTraits::Const;
+
+    ifc::ScopeDeclaration scopes[2]{};
+    scopes[0].name = bmi.identifier("A");
+    scopes[0].type = type(ifc::TypeSort::Fundamental, 1);
+    scopes[0].initializer = ifc::ScopeIndex{ 1 };
+    scopes[1].name = bmi.identifier("B");
+    scopes[1].type = type(ifc::TypeSort::Fundamental, 1);
+    scopes[1].base = type(ifc::TypeSort::Designated, 0);
+    scopes[1].initializer = ifc::ScopeIndex{ 2 };
+    const ifc::Sequence descriptors[] = { { ifc::Index{ 0 }, ifc::Cardinality{ 3 } }, { ifc::Index{ 3 }, ifc::Cardinality{ 4 } } };
+    const ifc::Declaration members[] = {
+        { decl(ifc::DeclSort::Method, 0) }, { decl(ifc::DeclSort::Method, 1) }, { decl(ifc::DeclSort::Destructor, 0) },
+        { decl(ifc::DeclSort::Method, 2) }, { decl(ifc::DeclSort::Method, 3) }, { decl(ifc::DeclSort::Destructor, 1) }, { decl(ifc::DeclSort::Method, 4) },
+    };
+
+    auto method = [](ifc::NameIndex name, uint32_t method_type, uint32_t home_scope, ifc::FunctionTraits traits) {
+        ifc::MethodDeclaration result{};
+        result.name = name;
+        result.type = type(ifc::TypeSort::Method, method_type);
+        result.home_scope = decl(ifc::DeclSort::Scope, home_scope);
+        result.traits = traits;
+        return result;
+    };
+    const auto f = bmi.identifier("f");
+    const auto g = bmi.identifier("g");
+    const ifc::MethodDeclaration methods[] = {
+        method(f, 0, 0, ifc::FunctionTraits::Virtual),
+        method(g, 1, 0, ifc::FunctionTraits::Virtual),
+        method(g, 1, 1, ifc::FunctionTraits::None),
+        method(f, 2, 1, ifc::FunctionTraits::None),
+        method(bmi.identifier("h"), 1, 1, ifc::FunctionTraits(static_cast<uint16_t>(ifc::FunctionTraits::Virtual) | static_cast<uint16_t>(ifc::FunctionTraits::PureVirtual))),
+    };
+    ifc::Destructor destructors[2]{};
+    destructors[0].home_scope = decl(ifc::DeclSort::Scope, 0);
+    destructors[0].traits = ifc::FunctionTraits::Virtual;
+    destructors[1].home_scope = decl(ifc::DeclSort::Scope, 1);
+
+    bmi.add(fundamentals);
+    bmi.add(designated);
+    bmi.add(method_types);
+    bmi.add(scopes);
+    bmi.add("scope.desc", descriptors);
+    bmi.add(members);
+    bmi.add(methods);
+    bmi.add(destructors);
+    const auto blob = bmi.write();
+    const ifc::File file(blob, { .validate = true });
+
+    ifc::Environment environment(ifc::Environment::Config{}, ifc::read_blob);
+    auto const & index = file.get_index<reflifc::VirtualTableIndex>();
+    const auto id = [&](ifc::DeclSort sort, uint32_t i) { return environment.declaration_id(file, decl(sort, i)); };
+
+    const auto a = index.find(file, decl(ifc::DeclSort::Scope, 0), environment);
+    ASSERT_TRUE(a);
+    ASSERT_EQ(a->slots.size(), 3);
+    const ifc::DeclarationId a_slots[] = { id(ifc::DeclSort::Method, 0), id(ifc::DeclSort::Method, 1), id(ifc::DeclSort::Destructor, 0) };
+    for (size_t i = 0; i != a->slots.size(); ++i)
+    {
+        ASSERT_EQ(a->slots[i].introducer, a_slots[i]) << i;
+        ASSERT_EQ(a->slots[i].overrider, a_slots[i]) << i;
+    }
+
+    // The slots of A in their order, B::g and ~B override theirs, f(int) const overrides nothing and is not
+    // virtual, h comes last.
+    const auto b = index.find(file, decl(ifc::DeclSort::Scope, 1), environment);
+    ASSERT_TRUE(b);
+    ASSERT_EQ(b->slots.size(), 4);
+    const ifc::DeclarationId b_overriders[] = { id(ifc::DeclSort::Method, 0), id(ifc::DeclSort::Method, 2), id(ifc::DeclSort::Destructor, 1), id(ifc::DeclSort::Method, 4) };
+    for (size_t i = 0; i != 3; ++i)
+        ASSERT_EQ(b->slots[i].introducer, a_slots[i]) << i;
+    for (size_t i = 0; i != b->slots.size(); ++i)
+        ASSERT_EQ(b->slots[i].overrider, b_overriders[i]) << i;
+    ASSERT_EQ(b->slots[3].introducer, id(ifc::DeclSort::Method, 4));
+    ASSERT_TRUE(b->slots[0].name && b->slots[1].name);
+    ASSERT_NE(b->slots[0].name, b->slots[1].name);
+    ASSERT_NE(b->slots[0].signature, b->slots[1].signature);
+    ASSERT_FALSE(b->slots[2].name);
+    ASSERT_TRUE(b->slots[3].pure);
+    ASSERT_FALSE(b->slots[1].pure);
+
+    // The table of A was built once, for itself and for B.
+    ASSERT_EQ(index.find(file, decl(ifc::DeclSort::Scope, 0), environment), a);
+    ASSERT_GT(index.heap_bytes(), 0);
+}
+
+TEST(FunctionSignatures, columns)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    SyntheticFile bmi(*wrapper.module.global_namespace().containing_file());
+
+
+    // int f(int, int = 0) noexcept; template<...> void h(int); struct S { S(); ~S(); void g(int); };
+    ifc::FundamentalType fundamentals[2]{};
+    fundamentals[0].basis = ifc::TypeBasis::Int;
+    fundamentals[1].basis = ifc::TypeBasis::Void;
+    const ifc::TypeIndex heap[] = { type(ifc::TypeSort::Fundamental, 0), type(ifc::TypeSort::Fundamental, 0) };
+    const ifc::TupleType tuples[] = { { { ifc::Index{ 0 }, ifc::Cardinality{ 2 } } } };
+    ifc::FunctionType function_types[2]{};
+    function_types[0] = { type(ifc::TypeSort::Fundamental, 0), type(ifc::TypeSort::Tuple, 0), { {}, ifc::NoexceptSort::True } };
+    function_types[1] = { type(ifc::TypeSort::Fundamental, 1), type(ifc::TypeSort::Fundamental, 0) };
+    const ifc::ForallType foralls[] = { { {}, type(ifc::TypeSort::Function, 1) } };
+    ifc::MethodType method_types[1]{};
+    method_types[0].target = type(ifc::TypeSort::Fundamental, 1);
+    method_types[0].source = type(ifc::TypeSort::Fundamental, 0);
+    method_types[0].convention = ifc::CallingConvention::This;
+    const ifc::TorType tor_types[1]{};
+
+    ifc::ParameterDeclaration parameters[2]{};
+    parameters[0].type = parameters[1].type = type(ifc::TypeSort::Fundamental, 0);
+    parameters[1].initializer = ifc::ExprIndex{ static_cast<uint32_t>(ifc::ExprSort::Literal), 0 };
+    const ifc::ChartUnilevel charts[] = { { { ifc::Index{ 0 }, ifc::Cardinality{ 2 } } } };
+    const ifc::LiteralExpression literals[1]{};
+
+    ifc::FunctionDeclaration functions[2]{};
+    functions[0].name = bmi.identifier("f");
+    functions[0].type = type(ifc::TypeSort::Function, 0);
+    functions[0].chart = ifc::ChartIndex{ static_cast<uint32_t>(ifc::ChartSort::Unilevel), 0 };
+    functions[1].name = bmi.identifier("h");
+    functions[1].type = type(ifc::TypeSort::Forall, 0);
+    ifc::MethodDeclaration methods[1]{};
+    methods[0].name = bmi.identifier("g");
+    methods[0].type = type(ifc::TypeSort::Method, 0);
+    ifc::Constructor constructors[1]{};
+    constructors[0].name = bmi.text("S");
+    constructors[0].type = type(ifc::TypeSort::Tor, 0);
+    ifc::Destructor destructors[1]{};
+    destructors[0].name = bmi.text("S");
+    destructors[0].eh_spec.sort = ifc::NoexceptSort::True;
+    destructors[0].convention = ifc::CallingConvention::This;
+
+    bmi.add(fundamentals);
+    bmi.add("heap.type", heap);
+    bmi.add(tuples);
+    bmi.add(function_types);
+    bmi.add(foralls);
+    bmi.add(method_types);
+    bmi.add(tor_types);
+    bmi.add(parameters);
+    bmi.add(charts);
+    bmi.add(literals);
+    bmi.add(functions);
+    bmi.add(methods);
+    bmi.add(constructors);
+    bmi.add(destructors);
+    const auto blob = bmi.write();
+    const ifc::File file(blob, { .validate = true });
+
+    const auto signatures = reflifc::extract_signatures(reflifc::Module(&file));
+    ASSERT_EQ(signatures.size(), 5);
+    ASSERT_EQ(signatures.parameter_offsets.size(), 6);
+    const auto name = [&](size_t i) { return std::string_view(file.get_string(ifc::TextOffset{ signatures.names[i].index })); };
+    ASSERT_EQ(name(0), "f");
+    ASSERT_EQ(name(1), "h");
+    ASSERT_EQ(name(2), "g");
+    ASSERT_EQ(name(3), "S");
+    ASSERT_EQ(signatures.functions[2], (ifc::DeclIndex{ static_cast<uint32_t>(ifc::DeclSort::Method), 0 }));
+    ASSERT_EQ(signatures.functions[4], (ifc::DeclIndex{ static_cast<uint32_t>(ifc::DeclSort::Destructor), 0 }));
+
+    // f: the tuple of its parameters, the trailing one with a default argument.
+    ASSERT_EQ(signatures.return_types[0], type(ifc::TypeSort::Fundamental, 0));
+    ASSERT_EQ(signatures.parameters(0).size(), 2);
+    ASSERT_EQ(signatures.default_arguments[0], 1);
+    ASSERT_EQ(signatures.eh_specs[0].sort, ifc::NoexceptSort::True);
+    // h: read through its `type.forall`, g: through its method type.
+    ASSERT_EQ(signatures.return_types[1], type(ifc::TypeSort::Fundamental, 1));
+    ASSERT_EQ(signatures.parameters(1).size(), 1);
+    ASSERT_EQ(signatures.parameters(2).size(), 1);
+    ASSERT_EQ(signatures.conventions[2], ifc::CallingConvention::This);
+    // S() and ~S().
+    ASSERT_TRUE(signatures.return_types[3].is_null());
+    ASSERT_TRUE(signatures.parameters(3).empty());
+    ASSERT_TRUE(signatures.parameters(4).empty());
+    ASSERT_EQ(signatures.eh_specs[4].sort, ifc::NoexceptSort::True);
+    ASSERT_EQ(signatures.default_arguments[4], 0);
+}
+
+TEST(TypeStripTable, stripped_types_have_no_cvref)
+{
+    for (auto name : { "attributes.ixx.ifc", "class-bases.ixx.ifc", "class-specialization.ixx.ifc", "template-reference.ixx.ifc" })
+    {
+        const auto wrapper = ModuleWrapper::create(name);
+        auto const & file = *wrapper.module.global_namespace().containing_file();
+        auto const & table = file.get_index<reflifc::TypeStripTable>();
+
+        const auto is_cvref = [](ifc::TypeIndex type) {
+            return type.sort() == ifc::TypeSort::Qualified
+                || type.sort() == ifc::TypeSort::LvalueReference
+                || type.sort() == ifc::TypeSort::RvalueReference;
+        };
+        for (auto sort : { ifc::TypeSort::Qualified, ifc::TypeSort::LvalueReference, ifc::TypeSort::RvalueReference })
+        {
+            const auto count = sort == ifc::TypeSort::Qualified
+                ? (file.has_partition("type.qualified") ? file.qualified_types().size() : 0)
+                : sort == ifc::TypeSort::LvalueReference
+                    ? (file.has_partition("type.lvalue-reference") ? file.lvalue_references().size() : 0)
+                    : (file.has_partition("type.rvalue-reference") ? file.rvalue_references().size() : 0);
+            for (uint32_t i = 0; i != count; ++i)
+            {
+                const ifc::TypeIndex type{ static_cast<uint32_t>(sort), i };
+                ASSERT_FALSE(is_cvref(table.strip_cvref(type)));
+                ASSERT_EQ(table.decay(type), table.decay(table.strip_cvref(type)));
+            }
+        }
+    }
+
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto c = wrapper.module.global_namespace().find("c")->as_variable().type();
+    ASSERT_EQ(reflifc::strip_cvref(c), c);
+    ASSERT_EQ(reflifc::decay(c), c);
+}
+
+TEST(TypeLayoutIndex, empty_classes_and_pointers)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto global = wrapper.module.global_namespace();
+    const auto e = global.find("e");
+    auto const & file = *e->containing_file();
+    auto const & index = file.get_index<reflifc::TypeLayoutIndex>();
+
+    const auto layout = index.class_layout(file, e->index());
+    ASSERT_TRUE(layout.has_value());
+    ASSERT_EQ(layout->layout, (reflifc::TypeLayout{ 1, 1 }));
+    ASSERT_FALSE(layout->has_vtable_pointer);
+    ASSERT_TRUE(layout->bases.empty());
+    ASSERT_TRUE(layout->members.empty());
+
+    // `d` is incomplete.
+    ASSERT_FALSE(index.class_layout(file, global.find("d")->index()).has_value());
+
+    const auto c = global.find("c")->as_variable().type();
+    ASSERT_EQ(index.layout(file, c.index()), (reflifc::TypeLayout{ 8, 8 }));
+    ASSERT_EQ(index.layout(file, c.index()), (reflifc::TypeLayout{ 8, 8 }));
+    ASSERT_FALSE(index.layout(file, ifc::TypeIndex{}).has_value());
+}
+
+TEST(TypeLayoutIndex, expanded_bases_have_no_layout)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    const auto a = reflifc::resolve(wrapper.module, "A");
+    auto const & file = *a->containing_file();
+    auto const & index = file.get_index<reflifc::TypeLayoutIndex>();
+
+    ASSERT_EQ(index.class_layout(file, a->index())->layout, (reflifc::TypeLayout{ 1, 1 }));
+    ASSERT_FALSE(index.class_layout(file, reflifc::resolve(wrapper.module, "C")->index()).has_value());
+}
+
+static void check_is_var_of_instantiation_type(reflifc::Declaration decl, std::string_view var_name, reflifc::Declaration type_primary_template)
+{
+    ASSERT_TRUE(decl.is_variable());
+    auto var = decl.as_variable();
+    ASSERT_TRUE(is_identifier(var.name(), var_name));
+    auto type = var.type();
+    ASSERT_TRUE(type.is_syntactic());
+    auto syntactic_type = type.as_syntactic();
+    ASSERT_TRUE(syntactic_type.is_template_id());
+    ASSERT_EQ(syntactic_type.as_template_id().primary().referenced_decl(), type_primary_template);
+}
+
+using namespace std::string_view_literals;
+
+TEST(Class, specialization)
+{
+    const auto wrapper = ModuleWrapper::create("class-specialization.ixx.ifc");
+    auto declarations = wrapper.module.global_namespace().get_declarations();
+
+    auto it = declarations.begin();
+
+    const auto X_primary_template = *it++;
+    ASSERT_TRUE(X_primary_template.is_template());
+
+    {
+        auto templ = X_primary_template.as_template();
+        ASSERT_TRUE(is_identifier(templ.name(), "X"));
+        ASSERT_TRUE(templ.entity().is_class_or_struct());
+    }
+
+    {
+        auto decl = *it++;
+        ASSERT_TRUE(decl.is_partial_specialization());
+        auto spec = decl.as_partial_specialization();
+        auto name = spec.name();
+        ASSERT_TRUE(name.is_identifier());
+        auto form = spec.form();
+        ASSERT_EQ(form.primary_template(), X_primary_template);
+        auto tempargs = form.arguments();
+        ASSERT_EQ(tempargs.size(), 1);
+        auto templarg = tempargs.front();
+        ASSERT_TRUE(templarg.is_type());
+        auto typearg = templarg.as_type();
+        ASSERT_TRUE(typearg.is_pointer());
+        auto pointee = typearg.as_pointer().pointee;
+        ASSERT_TRUE(pointee.is_designated());
+        auto designation = pointee.designation();
+        ASSERT_TRUE(designation.is_parameter());
+        ASSERT_EQ(designation.as_parameter().name(), "T"sv);
+        auto entity = spec.entity();
+        ASSERT_TRUE(entity.is_class_or_struct());
+        ASSERT_TRUE(entity.as_class_or_struct().name() == name);
+    }
+
+    {
+        auto decl = *it++;
+        ASSERT_TRUE(decl.is_specialization());
+        auto spec = decl.as_specialization();
+        auto form = spec.form();
+        ASSERT_EQ(form.primary_template(), X_primary_template);
+        auto tempargs = form.arguments();
+        ASSERT_EQ(tempargs.size(), 1);
+        auto templarg = tempargs.front();
+        ASSERT_TRUE(templarg.is_type());
+        auto typearg = templarg.as_type();
+        ASSERT_TRUE(typearg.is_fundamental());
+        ASSERT_EQ(typearg.as_fundamental().basis, ifc::TypeBasis::Void);
+        ASSERT_TRUE(spec.entity().is_class_or_struct());
+        ASSERT_EQ(spec.sort(), ifc::SpecializationSort::Explicit);
+    }
+
+    check_is_var_of_instantiation_type(*it++, "x1", X_primary_template);
+    check_is_var_of_instantiation_type(*it++, "x2", X_primary_template);
+    check_is_var_of_instantiation_type(*it++, "x3", X_primary_template);
+
+    ASSERT_EQ(it, declarations.end());
+}
+
+TEST(Expression, TemplateReference)
+{
+    const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
+    auto declarations = wrapper.module.global_namespace().get_declarations();
+
+    auto it = declarations.begin();
+
+    const auto X = *it++;
+    ASSERT_TRUE(X.is_template());
+
+    auto templ = X.as_template();
+    ASSERT_TRUE(is_identifier(templ.name(), "X"));
+    ASSERT_TRUE(templ.entity().is_class_or_struct());
+
+    auto decl = *it++;
+    ASSERT_TRUE(decl.is_variable());
+    auto var = decl.as_variable();
+    ASSERT_TRUE(is_identifier(var.name(), "a"));
+    auto type = var.type();
+    ASSERT_TRUE(type.is_syntactic());
+    auto syntactic_type = type.as_syntactic();
+    ASSERT_TRUE(syntactic_type.is_template_reference());
+    auto template_ref = syntactic_type.as_template_reference();
+    auto member_name = template_ref.member_name();
+    ASSERT_TRUE(is_identifier(member_name, "A"));
+    ASSERT_TRUE(template_ref.arguments().empty());
+    auto member = template_ref.member();
+    ASSERT_TRUE(member.is_class_or_struct());
+    auto member_class = member.as_class_or_struct();
+    ASSERT_EQ(member_class.name(), member_name);
+    ASSERT_EQ(member_class.home_scope(), X);
+}
+
+TEST(ReferenceIndex, declarations_without_initializers)
+{
+    const auto wrapper = ModuleWrapper::create("class-specialization.ixx.ifc");
+    const auto x1 = reflifc::resolve(wrapper.module, "x1");
+    const auto x = reflifc::resolve(wrapper.module, "X");
+    ASSERT_TRUE(x1 && x);
+
+    // The variables are default-initialized, nothing of the module is named by an initializer.
+    auto const & file = *x1->containing_file();
+    auto const & index = file.get_index<reflifc::ReferenceIndex>();
+    ASSERT_EQ(index.edge_count(), 0);
+    ASSERT_TRUE(index.references(x1->index()).empty());
+    ASSERT_TRUE(index.referrers(x->index()).empty());
+    ASSERT_TRUE(std::ranges::empty(reflifc::get_referenced_declarations(*x1)));
+    ASSERT_TRUE(std::ranges::empty(reflifc::get_referencing_declarations(*x)));
+}
+
+TEST(FlatExpressionCache, post_order)
+{
+    const auto wrapper = ModuleWrapper::create("class-specialization.ixx.ifc");
+    auto const & file = *wrapper.module.global_namespace().containing_file();
+    ASSERT_TRUE(file.has_partition("expr.template-id"));
+
+    auto const & cache = file.get_index<reflifc::FlatExpressionCache>();
+    ASSERT_TRUE(cache.flatten(file, {}).empty());
+    for (uint32_t i = 0; i != file.template_ids().size(); ++i)
+    {
+        const ifc::ExprIndex root{ static_cast<uint32_t>(ifc::ExprSort::TemplateId), i };
+        const auto nodes = cache.flatten(file, root);
+        ASSERT_FALSE(nodes.empty());
+        ASSERT_EQ(nodes.back().expr, root);
+        ASSERT_EQ(nodes.back().sort(), ifc::ExprSort::TemplateId);
+
+        // Each node replaces its children on a stack of subtrees, leaving the root alone.
+        size_t subtrees = 0;
+        for (auto node : nodes)
+        {
+            ASSERT_LE(node.child_count, subtrees);
+            subtrees = subtrees - node.child_count + 1;
+        }
+        ASSERT_EQ(subtrees, 1);
+
+        const auto again = reflifc::flattened(reflifc::Expression(&file, root));
+        ASSERT_EQ(again.data(), nodes.data());
+    }
+    ASSERT_GT(cache.heap_bytes(), 0);
+}
+
+TEST(LiteralTable, immediate_literals)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    auto const & file = *wrapper.module.global_namespace().containing_file();
+
+    // The module has no literal partitions, immediates are decoded from the index itself.
+    auto const & table = file.get_index<reflifc::LiteralTable>();
+    ASSERT_TRUE(table.integers().empty());
+    ASSERT_TRUE(table.floating_points().empty());
+    ASSERT_TRUE(table.strings().empty());
+
+    const ifc::LitIndex immediate{ static_cast<uint32_t>(ifc::LiteralSort::Immediate), 42 };
+    ASSERT_EQ(table.integer(immediate), 42);
+    ASSERT_EQ(table.floating_point(immediate), 42.0);
+}
+
+// The test modules are not header units, the macros are added to a copy of one.
+TEST(MacroTable, header_unit_macros)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    auto const & original = *wrapper.module.global_namespace().containing_file();
+    ASSERT_EQ(original.get_index<reflifc::MacroTable>().size(), 0);
+    ASSERT_FALSE(reflifc::find_macro(original, "ONE"));
+
+    SyntheticFile bmi(original);
+    bmi.copy_partitions();
+
+    const auto form = [](ifc::FormSort sort, uint32_t index) { return ifc::FormIndex{ static_cast<uint32_t>(sort), index }; };
+    const auto spelled = [&](std::string_view spelling) { return ifc::SpelledForm{ {}, bmi.text(spelling) }; };
+    // #define ONE 1
+    // #define ADD(a, b) (a)+b
+    const ifc::ObjectLikeMacro one{ {}, bmi.text("ONE"), form(ifc::FormSort::Number, 0) };
+    const ifc::FunctionLikeMacro add{ {}, bmi.text("ADD"), form(ifc::FormSort::Tuple, 0), form(ifc::FormSort::Tuple, 1), 2, 0 };
+    const ifc::NumberForm numbers[] = { { spelled("1") } };
+    const ifc::ParameterForm parameters[] = { { spelled("a") }, { spelled("b") } };
+    const ifc::OperatorForm operators[] = { { spelled("+"), {} } };
+    const ifc::ParenthesizedForm parenthesized[] = { { {}, form(ifc::FormSort::Parameter, 0) } };
+    const ifc::TupleForm tuples[] = { { { ifc::Index{ 0 }, ifc::Cardinality{ 2 } } }, { { ifc::Index{ 2 }, ifc::Cardinality{ 3 } } } };
+    const ifc::FormIndex heap[] = {
+        form(ifc::FormSort::Parameter, 0), form(ifc::FormSort::Parameter, 1),
+        form(ifc::FormSort::Parenthesized, 0), form(ifc::FormSort::Operator, 0), form(ifc::FormSort::Parameter, 1),
+    };
+    bmi.add(one);
+    bmi.add(add);
+    bmi.add(numbers);
+    bmi.add(parameters);
+    bmi.add(operators);
+    bmi.add(parenthesized);
+    bmi.add(tuples);
+    bmi.add("heap.form", heap);
+    const auto blob = bmi.write();
+    const ifc::File file(blob);
+
+    auto const & table = file.get_index<reflifc::MacroTable>();
+    ASSERT_EQ(table.size(), 2);
+    ASSERT_FALSE(table.find("TWO"));
+
+    const auto one_macro = reflifc::find_macro(file, "ONE");
+    ASSERT_TRUE(one_macro);
+    ASSERT_FALSE(one_macro->is_function_like());
+    std::string text;
+    one_macro->definition(text);
+    ASSERT_EQ(text, "ONE 1");
+
+    const auto add_macro = reflifc::find_macro(file, "ADD");
+    ASSERT_TRUE(add_macro);
+    ASSERT_TRUE(add_macro->is_function_like());
+    ASSERT_EQ(add_macro->arity(), 2);
+    std::vector<reflifc::FormToken> tokens;
+    add_macro->body(tokens);
+    ASSERT_EQ(tokens.size(), 5);
+    ASSERT_EQ(tokens[0].spelling, "(");
+    ASSERT_EQ(tokens[1].sort, ifc::FormSort::Parameter);
+    ASSERT_EQ(tokens[3].sort, ifc::FormSort::Operator);
+    text.clear();
+    add_macro->definition(text);
+    ASSERT_EQ(text, "ADD(a, b) (a)+b");
+}
+
+TEST(FlatMap, matches_unordered_map)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    auto const* file = wrapper.module.global_namespace().containing_file();
+
+    // Identity hashes of compact handles collide in their low bits without the extra mixing.
+    reflifc::FlatMap<reflifc::CompactDeclaration, uint32_t> compact;
+    reflifc::FlatMap<reflifc::Declaration, uint32_t> flat;
+    std::unordered_map<reflifc::Declaration, uint32_t> expected;
+    for (uint32_t i = 0; i != 5000; ++i)
+    {
+        const ifc::DeclIndex index{ .tag = i % 32, .index = i * 7 };
+        ASSERT_TRUE(flat.try_emplace(reflifc::Declaration(file, index), i).second);
+        compact[{ index }] = i;
+        expected.emplace(reflifc::Declaration(file, index), i);
+    }
+    ASSERT_FALSE(flat.try_emplace(reflifc::Declaration(file, { .tag = 0, .index = 0 }), 1).second);
+
+    // Erasing every third entry shifts the others back into place.
+    for (uint32_t i = 0; i < 5000; i += 3)
+    {
+        const reflifc::Declaration decl(file, { .tag = i % 32, .index = i * 7 });
+        ASSERT_TRUE(flat.erase(decl));
+        ASSERT_FALSE(flat.erase(decl));
+        expected.erase(decl);
+    }
+
+    ASSERT_EQ(flat.size(), expected.size());
+    size_t visited = 0;
+    for (auto const & [decl, value] : flat)
+    {
+        ASSERT_EQ(expected.at(decl), value);
+        ++visited;
+    }
+    ASSERT_EQ(visited, expected.size());
+    for (auto const & [decl, value] : expected)
+        ASSERT_EQ(*flat.find(decl), value);
+    ASSERT_EQ(*compact.find({ ifc::DeclIndex{ .tag = 3, .index = 21 } }), 3);
+
+    // Handles of neighbouring references spread over the whole hash.
+    std::unordered_set<size_t> top_bytes;
+    for (uint32_t i = 0; i != 256; ++i)
+        top_bytes.insert(std::hash<reflifc::Declaration>{}(reflifc::Declaration(file, { .tag = 1, .index = i })) >> 56);
+    ASSERT_GT(top_bytes.size(), 128);
+}
+
+TEST(SideTable, dense_per_sort)
+{
+    const auto wrapper = ModuleWrapper::create("class-bases.ixx.ifc");
+    auto const& file = *wrapper.module.global_namespace().containing_file();
+
+    reflifc::DeclarationTable<bool> visited(file);
+    ASSERT_EQ(visited.values(ifc::DeclSort::Scope).size(), file.scope_declarations().size());
+    size_t walked = 0;
+    reflifc::walk(wrapper.module, [&](reflifc::WalkEntry const& entry) {
+        ASSERT_TRUE(visited.contains(entry.declaration.index()));
+        ASSERT_FALSE(std::exchange(visited[entry.declaration.index()], true));
+        ++walked;
+    });
+    ptrdiff_t marked = 0;
+    for (uint32_t sort = 0; sort != ifc::DeclIndex::SortCount; ++sort)
+        marked += std::ranges::count(visited.values(static_cast<ifc::DeclSort>(sort)), true);
+    ASSERT_EQ(marked, walked);
+
+    const ifc::DeclIndex past_end{ .tag = static_cast<uint32_t>(ifc::DeclSort::Scope), .index = static_cast<uint32_t>(file.scope_declarations().size()) };
+    ASSERT_EQ(visited.find(past_end), nullptr);
+
+    const reflifc::TypeTable<uint32_t> types(file, 7);
+    ASSERT_EQ(types.values(ifc::TypeSort::Fundamental).size(), file.fundamental_types().size());
+    ASSERT_TRUE(std::ranges::all_of(types.values(ifc::TypeSort::Fundamental), [](uint32_t value) { return value == 7; }));
+}
+
+TEST(SpecifierTable, exported_surface)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    auto const& file = *wrapper.module.global_namespace().containing_file();
+    auto const& table = file.get_index<reflifc::SpecifierTable>();
+
+    std::set<std::string> exported;
+    for (auto declaration : reflifc::exported_declarations(wrapper.module))
+    {
+        if (declaration.is_function())
+            exported.insert(declaration.as_function().name().as_identifier());
+        else if (declaration.is_variable())
+            exported.insert(declaration.as_variable().name().as_identifier());
+        else if (declaration.is_scope())
+            exported.insert(declaration.as_scope().name().as_identifier());
+    }
+    ASSERT_EQ(exported, (std::set<std::string>{ "a", "b", "c", "d", "e" }));
+
+    std::set<std::string> deprecated;
+    for (auto decl : table.select({ reflifc::DeclarationFlag::Exported, reflifc::DeclarationFlag::Deprecated }))
+        deprecated.insert(reflifc::ScopeDeclaration(&file, file.scope_declarations()[decl]).name().as_identifier());
+    ASSERT_EQ(deprecated, (std::set<std::string>{ "d", "e" }));
+
+    // The columns agree with the specifiers of the records.
+    const auto scopes = file.scope_declarations();
+    for (uint32_t i = 0; i != scopes.size(); ++i)
+    {
+        const ifc::DeclIndex decl{ static_cast<uint32_t>(ifc::DeclSort::Scope), i };
+        const auto specifiers = static_cast<uint8_t>(scopes[decl].specifiers);
+        ASSERT_EQ(table.has(decl, reflifc::DeclarationFlag::Exported), (specifiers & static_cast<uint8_t>(ifc::BasicSpecifiers::NonExported)) == 0);
+        ASSERT_EQ(table.has(decl, reflifc::DeclarationFlag::GlobalModule), (specifiers & static_cast<uint8_t>(ifc::BasicSpecifiers::IsMemberOfGlobalModule)) != 0);
+    }
+    ASSERT_EQ(table.select({}).size(), reflifc::DeclarationTable<bool>(file).size());
+    ASSERT_EQ(table.select({ reflifc::DeclarationFlag::Exported }, { reflifc::DeclarationFlag::Deprecated }).size(), exported.size() - 2);
+}
+
+TEST(Reachability, from_exported_declarations)
+{
+    const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
+    auto const& file = *wrapper.module.global_namespace().containing_file();
+    auto const& reachability = file.get_index<reflifc::Reachability>();
+
+    const auto exported = file.get_index<reflifc::SpecifierTable>().select({ reflifc::DeclarationFlag::Exported });
+    ASSERT_FALSE(exported.empty());
+    for (auto decl : exported)
+        ASSERT_TRUE(reachability.reachable(decl));
+    ASSERT_GE(reachability.declaration_count(), exported.size());
+
+    // The variable `a` reaches its type, and through it the class X<void>::A.
+    const auto variables = reachability.declarations(ifc::DeclSort::Variable);
+    ASSERT_EQ(variables.size(), 1);
+    const auto type = file.variables()[variables.front()].type;
+    ASSERT_TRUE(reachability.reachable(type));
+    const reflifc::Reachability from_variable(file, variables);
+    ASSERT_TRUE(from_variable.reachable(type));
+    ASSERT_LE(from_variable.declaration_count(), reachability.declaration_count());
+    ASSERT_LE(from_variable.type_count(), reachability.type_count());
+    for (uint32_t sort = 0; sort != ifc::DeclIndex::SortCount; ++sort)
+    {
+        for (auto decl : from_variable.declarations(static_cast<ifc::DeclSort>(sort)))
+            ASSERT_TRUE(reachability.reachable(decl));
+    }
+
+    const reflifc::Reachability nothing(file, {});
+    ASSERT_EQ(nothing.declaration_count() + nothing.type_count() + nothing.expression_count() + nothing.syntax_count(), 0);
+    ASSERT_FALSE(nothing.reachable(exported.front()));
+}
+
+TEST(Subset, exported_surface)
+{
+    const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
+    auto const& file = *wrapper.module.global_namespace().containing_file();
+    auto const& reachability = file.get_index<reflifc::Reachability>();
+
+    const auto blob = reflifc::write_subset(file, reachability);
+    ASSERT_LE(blob.size(), file.blob().size());
+    const ifc::File subset(blob, { .verify_checksum = true });
+
+    // Only the reachable declarations are left, and the exported ones are still exported.
+    ASSERT_EQ(subset.get_index<reflifc::SpecifierTable>().select({ reflifc::DeclarationFlag::Exported }).size(),
+              file.get_index<reflifc::SpecifierTable>().select({ reflifc::DeclarationFlag::Exported }).size());
+    ASSERT_EQ(subset.variables().size(), reachability.declarations(ifc::DeclSort::Variable).size());
+    const reflifc::Reachability everything(subset);
+    ASSERT_EQ(everything.declaration_count(), reachability.declaration_count());
+    ASSERT_EQ(everything.type_count(), reachability.type_count());
+
+    // The variable `a` keeps its name and a type of the subset.
+    auto const& variable = *subset.variables().begin();
+    ASSERT_EQ(subset.get_string_view(ifc::TextOffset{ variable.name.index }), "a");
+    ASSERT_FALSE(variable.type.is_null());
+
+}
+
+TEST(Subset, from_a_variable)
+{
+    const auto wrapper = ModuleWrapper::create("attributes.ixx.ifc");
+    auto const& file = *wrapper.module.global_namespace().containing_file();
+
+    // The variable `c` does not reach the functions and classes next to it.
+    const ifc::DeclIndex roots[] = { ifc::DeclIndex{ static_cast<uint32_t>(ifc::DeclSort::Variable), 0 } };
+    const auto blob = reflifc::write_subset(file, reflifc::Reachability(file, roots));
+    ASSERT_LT(blob.size(), file.blob().size());
+    const ifc::File subset(blob, { .verify_checksum = true });
+    ASSERT_EQ(subset.variables().size(), 1);
+    ASSERT_FALSE(subset.has_partition(ifc::FunctionDeclaration::PartitionName) && subset.functions().size() != 0);
+    ASSERT_FALSE(subset.has_partition(ifc::ScopeDeclaration::PartitionName) && subset.scope_declarations().size() != 0);
+}
+
+// Records with fields appended by newer compilers are read through their stride and written back without them.
+TEST(Subset, larger_entry_sizes)
+{
+    const auto wrapper = ModuleWrapper::create("template-reference.ixx.ifc");
+    auto const& file = *wrapper.module.global_namespace().containing_file();
+
+    SyntheticFile bmi(file);
+    bmi.copy_partitions({ ifc::Declaration::PartitionName, ifc::ScopeDeclaration::PartitionName, ifc::VariableDeclaration::PartitionName, "scope.desc" }, sizeof(uint32_t));
+    const auto blob = bmi.write();
+    const ifc::File padded(blob);
+    ASSERT_FALSE(padded.variables().contiguous());
+
+    ASSERT_EQ(reflifc::write_subset(padded, padded.get_index<reflifc::Reachability>()),
+              reflifc::write_subset(file, file.get_index<reflifc::Reachability>()));
+}
+
+TEST(EntityIdentity, duplicates_across_files)
+{
+    // Two copies of the same module, as if two header units declared the same entities.
+    const auto first = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto second = ModuleWrapper::create("attributes.ixx.ifc");
+    const auto other = ModuleWrapper::create("class-bases.ixx.ifc");
+    ifc::File const* files[] = {
+        first.module.global_namespace().containing_file(),
+        second.module.global_namespace().containing_file(),
+        other.module.global_namespace().containing_file(),
+    };
+
+    ifc::Environment environment(ifc::Environment::Config{}, ifc::read_blob);
+    const reflifc::EntityIdentity identity(environment, files);
+    ASSERT_LT(identity.entity_count(), identity.declaration_count());
+
+    for (auto name : { "a", "b", "c", "d", "e" })
+    {
+        const auto decl = second.module.global_namespace().find(name)->index();
+        const auto canonical = identity.canonical(*files[1], decl);
+        ASSERT_EQ(canonical.file, files[0]) << name;
+        ASSERT_EQ(canonical.decl, decl) << name;
+        ASSERT_EQ(identity.copies(*files[1], decl).size(), 2) << name;
+    }
+
+    const auto a = other.module.global_namespace().find("A")->index();
+    ASSERT_EQ(identity.canonical(*files[2], a).file, files[2]);
+    ASSERT_EQ(identity.copies(*files[2], a).size(), 1);
+    ASSERT_TRUE(identity.copies(*files[2], ifc::DeclIndex{}).empty());
+}
+
+namespace
+{
+    // Reads names, types and attributes of every declaration, as the hot read paths of a tool would.
+    template<typename Declarations>
+    void read_declarations(Declarations declarations, size_t& reads)
+    {
+        for (auto declaration : declarations)
+        {
+            for (auto attribute : declaration.attributes())
+                reads += attribute.is_basic();
+            if (declaration.is_function())
+            {
+                const auto function = declaration.as_function();
+                if (const auto name = function.name(); name.is_identifier())
+                    reads += name.as_identifier_view().size();
+                const auto type = function.type();
+                for (auto parameter : type.parameters())
+                    reads += parameter.is_fundamental();
+                reads += type.return_type().is_fundamental();
+            }
+            else if (declaration.is_variable())
+            {
+                const auto variable = declaration.as_variable();
+                reads += variable.name().as_identifier_view().size() + variable.type().is_fundamental();
+            }
+            else if (declaration.is_scope())
+            {
+                const auto scope = declaration.as_scope();
+                if (const auto name = scope.name(); name.is_identifier())
+                    reads += std::string_view(name.as_identifier()).size();
+                if (scope.is_namespace())
+                    read_declarations(scope.as_namespace().scope().get_declarations(), reads);
+                else if (scope.is_class_or_struct() && scope.as_class_or_struct().is_complete())
+                    read_declarations(scope.as_class_or_struct().members(), reads);
+            }
+        }
+    }
+}
+
+// Meaningful in builds with IFC_READER_COUNT_ALLOCATIONS, skipped otherwise.
+TEST(Allocations, read_paths)
+{
+    if (!ifc::counts_allocations)
+        GTEST_SKIP() << "allocations are not counted in this build";
+
+    {
+        const ifc::AllocationScope scope;
+        const auto allocated = std::make_unique<int>(0);
+        ASSERT_EQ(scope.count().allocations, 1);
+        ASSERT_EQ(scope.count().bytes, sizeof(int));
+    }
+
+    for (auto name : { "attributes.ixx.ifc", "class-bases.ixx.ifc", "class-specialization.ixx.ifc", "template-reference.ixx.ifc" })
+    {
+        const auto wrapper = ModuleWrapper::create(name);
+        const auto global = wrapper.module.global_namespace();
+
+        // Tables built lazily on first use (e.g. the trait tables behind attributes) are not counted.
+        size_t warm_reads = global.find("a").has_value();
+        read_declarations(global.get_declarations(), warm_reads);
+
+        const ifc::AllocationScope scope;
+        size_t reads = global.find("a").has_value();
+        read_declarations(global.get_declarations(), reads);
+        const auto count = scope.count();
+        ASSERT_NE(reads, 0);
+        ASSERT_EQ(reads, warm_reads);
+        ASSERT_EQ(count.allocations, 0) << name;
+    }
 }
 
 int main(int argc, char* argv[])